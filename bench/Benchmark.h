@@ -79,6 +79,10 @@ public:
 
     virtual void getGpuStats(SkCanvas*, SkTArray<SkString>* keys, SkTArray<double>* values) {}
 
+    // CPU-side analog of getGpuStats: phase-level metrics (e.g. codec decode
+    // phases), dumped to the JSON log when --cpuStatsDump is set.
+    virtual void getCpuStats(SkTArray<SkString>* keys, SkTArray<double>* values) {}
+
     // Count of units (pixels, whatever) being exercised, to scale timing by.
     int getUnits() const { return fUnits; }
 
@@ -16,19 +16,38 @@
 static DEFINE_bool(zero_init, false,
                    "Pretend our destination is zero-intialized, simulating Android?");
 
+DECLARE_bool(cpuStatsDump)
+
 CodecBench::CodecBench(SkString baseName, SkData* encoded, SkColorType colorType,
-        SkAlphaType alphaType)
+        SkAlphaType alphaType, sk_sp<SkColorSpace> dstColorSpace)
     : fColorType(colorType)
     , fAlphaType(alphaType)
+    , fDstColorSpace(std::move(dstColorSpace))
     , fData(SkRef(encoded))
 {
     // Parse filename and the color type to give the benchmark a useful name
     fName.printf("Codec_%s_%s%s", baseName.c_str(), color_type_to_str(colorType),
             alpha_type_to_str(alphaType));
+    if (fDstColorSpace) {
+        fName.append(fDstColorSpace->gammaIsLinear() ? "_linear" : "_xform");
+    }
     // Ensure that we can create an SkCodec from this data.
     SkASSERT(SkCodec::MakeFromData(fData));
 }
 
+void CodecBench::getCpuStats(SkTArray<SkString>* keys, SkTArray<double>* values) {
+    if (0 == fDecodeCount) {
+        return;
+    }
+    // Average per decode, in ms, to match the main metric's units.
+    keys->push_back(SkString("decode_ms"));
+    values->push_back(fTotalNanos * 1e-6 / fDecodeCount);
+    keys->push_back(SkString("xform_ms"));
+    values->push_back(fXformNanos * 1e-6 / fDecodeCount);
+    keys->push_back(SkString("entropy_swizzle_ms"));
+    values->push_back((fTotalNanos - fXformNanos) * 1e-6 / fDecodeCount);
+}
+
 const char* CodecBench::onGetName() {
     return fName.c_str();
 }
@@ -42,9 +61,13 @@ void CodecBench::onDelayedSetup() {
 
     fInfo = codec->getInfo().makeColorType(fColorType)
                             .makeAlphaType(fAlphaType)
-                            .makeColorSpace(nullptr);
+                            .makeColorSpace(fDstColorSpace);
 
     fPixelStorage.reset(fInfo.computeMinByteSize());
+
+    fTotalNanos = 0;
+    fXformNanos = 0;
+    fDecodeCount = 0;
 }
 
 void CodecBench::onDraw(int n, SkCanvas* canvas) {
@@ -55,6 +78,9 @@ void CodecBench::onDraw(int n, SkCanvas* canvas) {
     }
     for (int i = 0; i < n; i++) {
         codec = SkCodec::MakeFromData(fData);
+        if (FLAGS_cpuStatsDump) {
+            codec->collectPhaseStats(true);
+        }
 #ifdef SK_DEBUG
         const SkCodec::Result result =
 #endif
@@ -62,5 +88,10 @@ void CodecBench::onDraw(int n, SkCanvas* canvas) {
                          &options);
         SkASSERT(result == SkCodec::kSuccess
                  || result == SkCodec::kIncompleteInput);
+        if (FLAGS_cpuStatsDump) {
+            fTotalNanos += codec->phaseStats().fTotalNanos;
+            fXformNanos += codec->phaseStats().fXformNanos;
+            fDecodeCount++;
+        }
     }
 }
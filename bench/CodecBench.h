@@ -9,6 +9,7 @@
 #define CodecBench_DEFINED
 
 #include "bench/Benchmark.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
@@ -20,8 +21,13 @@
  */
 class CodecBench : public Benchmark {
 public:
-    // Calls encoded->ref()
-    CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType);
+    // Calls encoded->ref().  A non-null dstColorSpace adds a color space
+    // conversion to the timed decode, to measure Skia's conversion path
+    // separately from the entropy decode.
+    CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType,
+               sk_sp<SkColorSpace> dstColorSpace = nullptr);
+
+    void getCpuStats(SkTArray<SkString>* keys, SkTArray<double>* values) override;
 
 protected:
     const char* onGetName() override;
@@ -33,9 +39,17 @@ private:
     SkString                fName;
     const SkColorType       fColorType;
     const SkAlphaType       fAlphaType;
+    sk_sp<SkColorSpace>     fDstColorSpace;
     sk_sp<SkData>           fData;
     SkImageInfo             fInfo;          // Set in onDelayedSetup.
     SkAutoMalloc            fPixelStorage;
+
+    // Phase attribution accumulated over all timed decodes; see
+    // SkCodec::PhaseStats.  Only collected when --cpuStatsDump is set.
+    double                  fTotalNanos = 0;
+    double                  fXformNanos = 0;
+    int                     fDecodeCount = 0;
+
     typedef Benchmark INHERITED;
 };
 #endif // CodecBench_DEFINED
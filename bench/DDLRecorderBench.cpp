@@ -11,8 +11,13 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkDeferredDisplayListRecorder.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
 #include "include/core/SkSurfaceCharacterization.h"
+#include "include/core/SkTextBlob.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/core/SkTaskGroup.h"
+#include "tools/ToolUtils.h"
 
 static SkSurfaceCharacterization create_characterization(GrDirectContext* direct) {
     size_t maxResourceBytes = direct->getResourceCacheLimit();
@@ -92,3 +97,102 @@ private:
 };
 
 DEF_BENCH(return new DDLRecorderBench();)
+
+// This benchmark measures how well DDL recording scales across threads. All the recorders share
+// one GrContextThreadSafeProxy, so any serialization inside it (or the structures it guards, like
+// the proxy provider) shows up as sub-linear scaling as the thread count grows. Each thread
+// records 'loops' DDLs; with no contention the reported time would stay flat across the thread
+// counts, so the ratio between configs is the scaling efficiency.
+class ParallelDDLRecorderBench : public Benchmark {
+public:
+    enum class Content {
+        kRect,
+        kText,
+    };
+
+    ParallelDDLRecorderBench(int numThreads, Content content)
+            : fNumThreads(numThreads)
+            , fContent(content) {
+        fName.printf("ParallelDDLRecorder_%s_%d",
+                     Content::kRect == content ? "rect" : "text", numThreads);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return kGPU_Backend == backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fCharacterization.isValid()) {
+            return;
+        }
+
+        SkTaskGroup taskGroup(*fExecutor);
+
+        for (int t = 0; t < fNumThreads; ++t) {
+            taskGroup.add([this, t, loops] {
+                SkDeferredDisplayListRecorder recorder(fCharacterization);
+
+                fDDLs[t].reserve(loops);
+
+                for (int i = 0; i < loops; ++i) {
+                    SkCanvas* recordingCanvas = recorder.getCanvas();
+
+                    if (Content::kText == fContent) {
+                        recordingCanvas->drawTextBlob(fBlob.get(), 0, 16, SkPaint());
+                    } else {
+                        recordingCanvas->drawRect(SkRect::MakeWH(32, 32), SkPaint());
+                    }
+
+                    fDDLs[t].emplace_back(recorder.detach());
+                }
+            });
+        }
+
+        taskGroup.wait();
+    }
+
+private:
+    void onPerCanvasPreDraw(SkCanvas* origCanvas) override {
+        auto context = origCanvas->recordingContext()->asDirectContext();
+        if (!context) {
+            return;
+        }
+
+        fCharacterization = create_characterization(context);
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fNumThreads);
+        fDDLs.resize(fNumThreads);
+
+        if (Content::kText == fContent) {
+            SkFont font(ToolUtils::create_portable_typeface(), 16);
+            static constexpr char kText[] = "DDL recording scaling";
+            fBlob = SkTextBlob::MakeFromText(kText, strlen(kText), font);
+        }
+    }
+
+    // We defer the clean up of the DDLs so it is done outside of the timing loop
+    void onPostDraw(SkCanvas*) override {
+        for (auto& ddls : fDDLs) {
+            ddls.clear();
+        }
+    }
+
+    SkString                                                 fName;
+    int                                                      fNumThreads;
+    Content                                                  fContent;
+    SkSurfaceCharacterization                                fCharacterization;
+    std::unique_ptr<SkExecutor>                              fExecutor;
+    sk_sp<SkTextBlob>                                        fBlob;
+    std::vector<std::vector<sk_sp<SkDeferredDisplayList>>>   fDDLs;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new ParallelDDLRecorderBench(1, ParallelDDLRecorderBench::Content::kRect);)
+DEF_BENCH(return new ParallelDDLRecorderBench(2, ParallelDDLRecorderBench::Content::kRect);)
+DEF_BENCH(return new ParallelDDLRecorderBench(4, ParallelDDLRecorderBench::Content::kRect);)
+DEF_BENCH(return new ParallelDDLRecorderBench(8, ParallelDDLRecorderBench::Content::kRect);)
+DEF_BENCH(return new ParallelDDLRecorderBench(1, ParallelDDLRecorderBench::Content::kText);)
+DEF_BENCH(return new ParallelDDLRecorderBench(2, ParallelDDLRecorderBench::Content::kText);)
+DEF_BENCH(return new ParallelDDLRecorderBench(4, ParallelDDLRecorderBench::Content::kText);)
+DEF_BENCH(return new ParallelDDLRecorderBench(8, ParallelDDLRecorderBench::Content::kText);)
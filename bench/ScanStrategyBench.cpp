@@ -0,0 +1,88 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkString.h"
+#include "include/utils/SkRandom.h"
+#include "src/core/SkScan.h"
+
+// Times supersampled vs analytic AA head-to-head on the same paths, so the
+// thresholds in src/core/SkScanAAATuning.h can be regenerated from
+// measurement. Each path shape is run once with each strategy forced; the
+// crossover between the saa/aaa pairs on a given machine is the tuned value.
+class ScanStrategyBench : public Benchmark {
+public:
+    ScanStrategyBench(int points, int size, bool forceAAA)
+        : fPoints(points)
+        , fSize(size)
+        , fForceAAA(forceAAA) {
+        fName.printf("scanstrategy_%s_pts%d_size%d", forceAAA ? "aaa" : "saa", points, size);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kRaster_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        // A closed zig-zag across the bounds: complexity scales directly with
+        // the point count, which is the axis the heuristic decides on.
+        SkRandom rand;
+        fPath.moveTo(0, 0);
+        for (int i = 1; i < fPoints; ++i) {
+            fPath.lineTo(rand.nextRangeScalar(0, SkIntToScalar(fSize)),
+                         rand.nextRangeScalar(0, SkIntToScalar(fSize)));
+        }
+        fPath.close();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        bool useAAA   = gSkUseAnalyticAA.load();
+        bool forceAAA = gSkForceAnalyticAA.load();
+        gSkUseAnalyticAA   = fForceAAA;
+        gSkForceAnalyticAA = fForceAAA;
+
+        SkPaint paint;
+        this->setupPaint(&paint);
+        paint.setAntiAlias(true);
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawPath(fPath, paint);
+        }
+
+        gSkUseAnalyticAA   = useAAA;
+        gSkForceAnalyticAA = forceAAA;
+    }
+
+private:
+    SkString fName;
+    SkPath   fPath;
+    int      fPoints;
+    int      fSize;
+    bool     fForceAAA;
+
+    typedef Benchmark INHERITED;
+};
+
+// Span the region around the current crossovers: point counts both below and
+// above the bounds' height, at a small and a large resolution.
+DEF_BENCH( return new ScanStrategyBench(16, 64, false); )
+DEF_BENCH( return new ScanStrategyBench(16, 64, true); )
+DEF_BENCH( return new ScanStrategyBench(64, 64, false); )
+DEF_BENCH( return new ScanStrategyBench(64, 64, true); )
+DEF_BENCH( return new ScanStrategyBench(128, 64, false); )
+DEF_BENCH( return new ScanStrategyBench(128, 64, true); )
+DEF_BENCH( return new ScanStrategyBench(64, 256, false); )
+DEF_BENCH( return new ScanStrategyBench(64, 256, true); )
+DEF_BENCH( return new ScanStrategyBench(256, 256, false); )
+DEF_BENCH( return new ScanStrategyBench(256, 256, true); )
+DEF_BENCH( return new ScanStrategyBench(1024, 256, false); )
+DEF_BENCH( return new ScanStrategyBench(1024, 256, true); )
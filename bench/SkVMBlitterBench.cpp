@@ -0,0 +1,123 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "src/core/SkBlendModePriv.h"
+
+extern bool gUseSkVMBlitter;
+
+// Draws the same simple scenes through both CPU blitter backends so SkVM and
+// SkRasterPipeline show up side by side on perf dashboards.  One bench exists
+// for each backend x blend mode x color space x shader x coverage combination;
+// a regression in either backend (or a widening gap between them) is visible
+// without flipping gUseSkVMBlitter in production first.
+class SkVMBlitterVsSkRPBench : public Benchmark {
+public:
+    enum class Shader   { kColor, kLinearGradient };
+    enum class Coverage { kFull, kAntiAlias };
+
+    SkVMBlitterVsSkRPBench(bool useSkVM, SkBlendMode blend, bool srgb,
+                           Shader shader, Coverage coverage)
+        : fUseSkVM(useSkVM)
+        , fBlend(blend)
+        , fSRGB(srgb)
+        , fShader(shader)
+        , fCoverage(coverage)
+        , fName(SkStringPrintf("%s_blitter_%s_%s_%s_%s",
+                               useSkVM ? "skvm" : "skrp",
+                               SkBlendMode_Name(blend),
+                               srgb ? "srgb" : "legacy",
+                               shader   == Shader::kColor  ? "color" : "lineargrad",
+                               coverage == Coverage::kFull ? "full"  : "aa")) {}
+
+private:
+    static constexpr int kSize = 256;
+
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        auto info = SkImageInfo::Make(kSize, kSize, kN32_SkColorType, kPremul_SkAlphaType,
+                                      fSRGB ? SkColorSpace::MakeSRGB() : nullptr);
+        fSurface = SkSurface::MakeRaster(info);
+
+        fPaint.setBlendMode(fBlend);
+        fPaint.setAntiAlias(fCoverage == Coverage::kAntiAlias);
+        if (fShader == Shader::kColor) {
+            fPaint.setColor4f({0.25f, 0.5f, 0.75f, 0.5f});
+        } else {
+            SkPoint  pts[] = {{0,0}, {kSize,kSize}};
+            SkColor  colors[] = {SK_ColorGREEN, SK_ColorMAGENTA};
+            fPaint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                          SkTileMode::kClamp));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        bool wasUsingSkVM = gUseSkVMBlitter;
+        gUseSkVMBlitter = fUseSkVM;
+
+        SkCanvas* canvas = fSurface->getCanvas();
+        while (loops --> 0) {
+            if (fCoverage == Coverage::kFull) {
+                canvas->drawRect({0,0, kSize,kSize}, fPaint);
+            } else {
+                // An AA circle blits both full-coverage spans and A8 edges.
+                canvas->drawCircle(kSize*0.5f, kSize*0.5f, kSize*0.45f, fPaint);
+            }
+        }
+
+        gUseSkVMBlitter = wasUsingSkVM;
+    }
+
+    bool            fUseSkVM;
+    SkBlendMode     fBlend;
+    bool            fSRGB;
+    Shader          fShader;
+    Coverage        fCoverage;
+    SkString        fName;
+    SkPaint         fPaint;
+    sk_sp<SkSurface> fSurface;
+};
+
+// Register each combination for both backends.  The blend modes here are the
+// ones our blitters specialize differently: kSrcOver hits the fast paths,
+// kSrc can memset, kModulate runs a full blend.
+#define B(blend, srgb, shader, cov)                                              \
+    DEF_BENCH(return new SkVMBlitterVsSkRPBench(                                 \
+            true, SkBlendMode::blend, srgb,                                      \
+            SkVMBlitterVsSkRPBench::Shader::shader,                              \
+            SkVMBlitterVsSkRPBench::Coverage::cov);)                             \
+    DEF_BENCH(return new SkVMBlitterVsSkRPBench(                                 \
+            false, SkBlendMode::blend, srgb,                                     \
+            SkVMBlitterVsSkRPBench::Shader::shader,                              \
+            SkVMBlitterVsSkRPBench::Coverage::cov);)
+
+B(kSrcOver , false, kColor         , kFull)
+B(kSrcOver , false, kColor         , kAntiAlias)
+B(kSrcOver , false, kLinearGradient, kFull)
+B(kSrcOver , false, kLinearGradient, kAntiAlias)
+B(kSrcOver , true , kColor         , kFull)
+B(kSrcOver , true , kColor         , kAntiAlias)
+B(kSrcOver , true , kLinearGradient, kFull)
+B(kSrcOver , true , kLinearGradient, kAntiAlias)
+B(kSrc     , false, kColor         , kFull)
+B(kSrc     , false, kLinearGradient, kFull)
+B(kSrc     , true , kColor         , kFull)
+B(kSrc     , true , kLinearGradient, kFull)
+B(kModulate, false, kColor         , kFull)
+B(kModulate, false, kColor         , kAntiAlias)
+B(kModulate, false, kLinearGradient, kFull)
+B(kModulate, true , kColor         , kFull)
+B(kModulate, true , kLinearGradient, kFull)
+
+#undef B
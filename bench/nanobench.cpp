@@ -35,6 +35,7 @@
 #include "src/core/SkOSFile.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
+#include "src/utils/SkJSON.h"
 #include "src/utils/SkJSONWriter.h"
 #include "src/utils/SkOSPath.h"
 #include "tools/AutoreleasePool.h"
@@ -56,7 +57,9 @@
 #include "client_utils/android/BitmapRegionDecoder.h"
 #endif
 
+#include <algorithm>
 #include <cinttypes>
+#include <functional>
 #include <stdlib.h>
 #include <memory>
 #include <thread>
@@ -128,6 +131,9 @@ static DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
 static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 static DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
 static DEFINE_bool(gpuStatsDump, false, "Dump GPU states after each benchmark to json");
+DEFINE_bool(cpuStatsDump, false,
+            "Dump CPU phase metrics (e.g. codec decode phase timings) after each benchmark to "
+            "json");
 static DEFINE_bool(keepAlive, false, "Print a message every so often so that we don't time out");
 static DEFINE_bool(csv, false, "Print status in CSV format");
 static DEFINE_string(sourceType, "",
@@ -185,6 +191,22 @@ static DEFINE_string(properties, "",
 static DEFINE_bool(purgeBetweenBenches, false,
                    "Call SkGraphics::PurgeAllCaches() between each benchmark?");
 
+static DEFINE_bool(isolate, false,
+                   "Measure each benchmark in a forked child process, so allocator and cache "
+                   "state can't bleed between benches. POSIX only. GPU stats dumps and "
+                   "--writePath are skipped in this mode.");
+
+static DEFINE_int(pinBenchCore, -1,
+                  "If >= 0, pin the benchmarking thread (and any forked children) to this core "
+                  "on platforms that support it.");
+
+static DEFINE_string(baseline, "",
+                     "Path to a nanobench JSON results file to compare against. Benches whose "
+                     "samples differ significantly from the baseline (two-sided Mann-Whitney) "
+                     "are reported, and regressions make nanobench exit non-zero.");
+
+static DEFINE_double(baselineP, 0.05, "p-value threshold for --baseline comparisons.");
+
 static double now_ms() { return SkTime::GetNSecs() * 1e-6; }
 
 static SkString humanize(double ms) {
@@ -193,6 +215,163 @@ static SkString humanize(double ms) {
 }
 #define HUMANIZE(ms) humanize(ms).c_str()
 
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #include <sched.h>
+    static void pin_bench_core(int core) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            SkDebugf("Warning: could not pin to core %d.\n", core);
+        }
+    }
+#else
+    static void pin_bench_core(int core) {
+        SkDebugf("Warning: --pinBenchCore is not supported on this platform.\n");
+    }
+#endif
+
+#if !defined(SK_BUILD_FOR_WIN)
+#include <sys/wait.h>
+
+// Runs measure in a forked child and reads the samples (and loop count) back over a pipe.
+// The bench executes with a pristine heap and caches, and whatever it allocates or caches dies
+// with the child instead of skewing the next bench. Returns false if the child failed.
+static bool run_isolated(const std::function<int(SkTArray<double>*)>& measure,
+                         SkTArray<double>* samples,
+                         int* loops) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (0 == pid) {
+        close(fds[0]);
+        SkTArray<double> childSamples;
+        int childLoops = measure(&childSamples);
+        int32_t count = childSamples.count();
+        bool ok = write(fds[1], &childLoops, sizeof(childLoops)) == sizeof(childLoops) &&
+                  write(fds[1], &count, sizeof(count)) == sizeof(count);
+        for (int i = 0; ok && i < count; i++) {
+            ok = write(fds[1], &childSamples[i], sizeof(double)) == sizeof(double);
+        }
+        close(fds[1]);
+        // _exit, not exit: don't run atexit handlers or flush parent-inherited streams.
+        _exit(ok ? 0 : 1);
+    }
+    close(fds[1]);
+    int32_t count = 0;
+    bool ok = read(fds[0], loops, sizeof(*loops)) == sizeof(*loops) &&
+              read(fds[0], &count, sizeof(count)) == sizeof(count);
+    if (ok) {
+        samples->reset(count);
+        for (int i = 0; ok && i < count; i++) {
+            ok = read(fds[0], &(*samples)[i], sizeof(double)) == sizeof(double);
+        }
+    }
+    close(fds[0]);
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return false;
+    }
+    return ok;
+}
+#endif
+
+static double median_of(SkTArray<double> v) {
+    std::sort(v.begin(), v.end());
+    return v[v.count() / 2];
+}
+
+// Two-sided Mann-Whitney U test p-value via the normal approximation with tie correction.
+// The approximation is solid for the sample counts we run (>= 8 or so per side).
+static double mann_whitney_p(const SkTArray<double>& a, const SkTArray<double>& b) {
+    struct Tagged { double value; bool fromA; };
+    SkTArray<Tagged> all;
+    for (double x : a) { all.push_back({x, true }); }
+    for (double x : b) { all.push_back({x, false}); }
+    std::sort(all.begin(), all.end(),
+              [](const Tagged& x, const Tagged& y) { return x.value < y.value; });
+
+    const double n1 = a.count(),
+                 n2 = b.count(),
+                 n  = n1 + n2;
+    double rankSumA = 0,
+           tieTerm  = 0;
+    for (int i = 0; i < all.count();) {
+        int j = i;
+        while (j < all.count() && all[j].value == all[i].value) {
+            j++;
+        }
+        double meanRank = (i + 1 + j) / 2.0;  // Ranks are 1-based; ties share their mean rank.
+        for (int k = i; k < j; k++) {
+            if (all[k].fromA) {
+                rankSumA += meanRank;
+            }
+        }
+        double t = j - i;
+        tieTerm += t*t*t - t;
+        i = j;
+    }
+
+    double u     = rankSumA - n1*(n1 + 1)/2,
+           mean  = n1*n2/2,
+           var   = n1*n2/12 * ((n + 1) - tieTerm/(n*(n - 1)));
+    if (var <= 0) {
+        return 1;  // All values tied; no evidence of a difference.
+    }
+    double z = (u - mean) / sqrt(var);
+    return erfc(fabs(z) / sqrt(2.0));
+}
+
+// Holds a parsed --baseline JSON file and looks up the recorded samples per bench and config.
+class Baseline {
+public:
+    bool load(const char* path) {
+        fData = SkData::MakeFromFileName(path);
+        if (!fData) {
+            return false;
+        }
+        fDOM = std::make_unique<skjson::DOM>((const char*)fData->data(), fData->size());
+        return fDOM->root().is<skjson::ObjectValue>();
+    }
+
+    SkTArray<double> samples(const char* benchId, const char* config) const {
+        SkTArray<double> samples;
+        const skjson::ObjectValue* root = fDOM->root();
+        if (!root) {
+            return samples;
+        }
+        const skjson::ObjectValue* results = (*root)["results"];
+        const skjson::ObjectValue* bench   = results ? static_cast<const skjson::ObjectValue*>(
+                                                               (*results)[benchId])
+                                                     : nullptr;
+        const skjson::ObjectValue* cfg     = bench   ? static_cast<const skjson::ObjectValue*>(
+                                                               (*bench)[config])
+                                                     : nullptr;
+        const skjson::ArrayValue*  array   = cfg     ? static_cast<const skjson::ArrayValue*>(
+                                                               (*cfg)["samples"])
+                                                     : nullptr;
+        if (array) {
+            for (const skjson::Value& v : *array) {
+                if (const skjson::NumberValue* number = v) {
+                    samples.push_back(**number);
+                }
+            }
+        }
+        return samples;
+    }
+
+private:
+    sk_sp<SkData>                fData;
+    std::unique_ptr<skjson::DOM> fDOM;
+};
+
 bool Target::init(SkImageInfo info, Benchmark* bench) {
     if (Benchmark::kRaster_Backend == config.backend) {
         this->surface = SkSurface::MakeRaster(info);
@@ -877,80 +1056,91 @@ public:
             }
         }
 
-        for (; fCurrentCodec < fImages.count(); fCurrentCodec++) {
-            fSourceType = "image";
-            fBenchType = "skcodec";
-            const SkString& path = fImages[fCurrentCodec];
-            if (CommandLineFlags::ShouldSkip(FLAGS_match, path.c_str())) {
-                continue;
-            }
-            sk_sp<SkData> encoded(SkData::MakeFromFileName(path.c_str()));
-            std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(encoded));
-            if (!codec) {
-                // Nothing to time.
-                SkDebugf("Cannot find codec for %s\n", path.c_str());
-                continue;
-            }
+        // Two passes over the images: the first decodes to the codec's own color
+        // space (no conversion applied), the second converts to a linear color
+        // space, so a decode regression can be attributed to either the entropy
+        // decode or Skia's conversion path.
+        for (; fCurrentCodecXform < (FLAGS_simpleCodec ? 1 : 2);
+               fCurrentCodecXform++, fCurrentCodec = 0) {
+            sk_sp<SkColorSpace> dstColorSpace = fCurrentCodecXform
+                    ? SkColorSpace::MakeSRGB()->makeLinearGamma()
+                    : nullptr;
+            for (; fCurrentCodec < fImages.count(); fCurrentCodec++) {
+                fSourceType = "image";
+                fBenchType = "skcodec";
+                const SkString& path = fImages[fCurrentCodec];
+                if (CommandLineFlags::ShouldSkip(FLAGS_match, path.c_str())) {
+                    continue;
+                }
+                sk_sp<SkData> encoded(SkData::MakeFromFileName(path.c_str()));
+                std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(encoded));
+                if (!codec) {
+                    // Nothing to time.
+                    SkDebugf("Cannot find codec for %s\n", path.c_str());
+                    continue;
+                }
 
-            while (fCurrentColorType < fColorTypes.count()) {
-                const SkColorType colorType = fColorTypes[fCurrentColorType];
+                while (fCurrentColorType < fColorTypes.count()) {
+                    const SkColorType colorType = fColorTypes[fCurrentColorType];
 
-                SkAlphaType alphaType = codec->getInfo().alphaType();
-                if (FLAGS_simpleCodec) {
-                    if (kUnpremul_SkAlphaType == alphaType) {
-                        alphaType = kPremul_SkAlphaType;
-                    }
+                    SkAlphaType alphaType = codec->getInfo().alphaType();
+                    if (FLAGS_simpleCodec) {
+                        if (kUnpremul_SkAlphaType == alphaType) {
+                            alphaType = kPremul_SkAlphaType;
+                        }
 
-                    fCurrentColorType++;
-                } else {
-                    switch (alphaType) {
-                        case kOpaque_SkAlphaType:
-                            // We only need to test one alpha type (opaque).
-                            fCurrentColorType++;
-                            break;
-                        case kUnpremul_SkAlphaType:
-                        case kPremul_SkAlphaType:
-                            if (0 == fCurrentAlphaType) {
-                                // Test unpremul first.
-                                alphaType = kUnpremul_SkAlphaType;
-                                fCurrentAlphaType++;
-                            } else {
-                                // Test premul.
-                                alphaType = kPremul_SkAlphaType;
-                                fCurrentAlphaType = 0;
+                        fCurrentColorType++;
+                    } else {
+                        switch (alphaType) {
+                            case kOpaque_SkAlphaType:
+                                // We only need to test one alpha type (opaque).
+                                fCurrentColorType++;
+                                break;
+                            case kUnpremul_SkAlphaType:
+                            case kPremul_SkAlphaType:
+                                if (0 == fCurrentAlphaType) {
+                                    // Test unpremul first.
+                                    alphaType = kUnpremul_SkAlphaType;
+                                    fCurrentAlphaType++;
+                                } else {
+                                    // Test premul.
+                                    alphaType = kPremul_SkAlphaType;
+                                    fCurrentAlphaType = 0;
+                                    fCurrentColorType++;
+                                }
+                                break;
+                            default:
+                                SkASSERT(false);
                                 fCurrentColorType++;
-                            }
+                                break;
+                        }
+                    }
+
+                    // Make sure we can decode to this color type and alpha type.
+                    SkImageInfo info =
+                            codec->getInfo().makeColorType(colorType).makeAlphaType(alphaType);
+                    const size_t rowBytes = info.minRowBytes();
+                    SkAutoMalloc storage(info.computeByteSize(rowBytes));
+
+                    const SkCodec::Result result = codec->getPixels(
+                            info, storage.get(), rowBytes);
+                    switch (result) {
+                        case SkCodec::kSuccess:
+                        case SkCodec::kIncompleteInput:
+                            return new CodecBench(SkOSPath::Basename(path.c_str()),
+                                                  encoded.get(), colorType, alphaType,
+                                                  dstColorSpace);
+                        case SkCodec::kInvalidConversion:
+                            // This is okay. Not all conversions are valid.
                             break;
                         default:
+                            // This represents some sort of failure.
                             SkASSERT(false);
-                            fCurrentColorType++;
                             break;
                     }
                 }
-
-                // Make sure we can decode to this color type and alpha type.
-                SkImageInfo info =
-                        codec->getInfo().makeColorType(colorType).makeAlphaType(alphaType);
-                const size_t rowBytes = info.minRowBytes();
-                SkAutoMalloc storage(info.computeByteSize(rowBytes));
-
-                const SkCodec::Result result = codec->getPixels(
-                        info, storage.get(), rowBytes);
-                switch (result) {
-                    case SkCodec::kSuccess:
-                    case SkCodec::kIncompleteInput:
-                        return new CodecBench(SkOSPath::Basename(path.c_str()),
-                                              encoded.get(), colorType, alphaType);
-                    case SkCodec::kInvalidConversion:
-                        // This is okay. Not all conversions are valid.
-                        break;
-                    default:
-                        // This represents some sort of failure.
-                        SkASSERT(false);
-                        break;
-                }
+                fCurrentColorType = 0;
             }
-            fCurrentColorType = 0;
         }
 
         // Run AndroidCodecBenches
@@ -1138,6 +1328,7 @@ private:
     int fCurrentTextBlobTrace = 0;
     int fCurrentUseMPD = 0;
     int fCurrentCodec = 0;
+    int fCurrentCodecXform = 0;
     int fCurrentAndroidCodec = 0;
 #ifdef SK_ENABLE_ANDROID_UTILS
     int fCurrentBRDImage = 0;
@@ -1180,6 +1371,20 @@ int main(int argc, char** argv) {
 
     SetCtxOptionsFromCommonFlags(&grContextOpts);
 
+    if (FLAGS_pinBenchCore >= 0) {
+        pin_bench_core(FLAGS_pinBenchCore);
+    }
+
+    std::unique_ptr<Baseline> baseline;
+    if (!FLAGS_baseline.isEmpty()) {
+        baseline = std::make_unique<Baseline>();
+        if (!baseline->load(FLAGS_baseline[0])) {
+            SkDebugf("Could not parse baseline file %s.\n", FLAGS_baseline[0]);
+            return 1;
+        }
+    }
+    int significantRegressions = 0;
+
     if (kAutoTuneLoops != FLAGS_loops) {
         FLAGS_samples     = 1;
         FLAGS_gpuFrameLag = 0;
@@ -1297,62 +1502,90 @@ int main(int argc, char** argv) {
             TRACE_EVENT2("skia", "Benchmark", "name", TRACE_STR_COPY(bench->getUniqueName()),
                                               "config", TRACE_STR_COPY(config));
 
-            target->setup();
-            bench->perCanvasPreDraw(canvas);
+            SkTArray<SkString> keys;
+            SkTArray<double> values;
+            bool gpuStatsDump = FLAGS_gpuStatsDump && Benchmark::kGPU_Backend == configs[i].backend;
 
-            int maxFrameLag;
-            int loops = target->needsFrameTiming(&maxFrameLag)
-                ? setup_gpu_bench(target, bench.get(), maxFrameLag)
-                : setup_cpu_bench(overhead, target, bench.get());
+            auto measure = [&](SkTArray<double>* out) -> int {
+                target->setup();
+                bench->perCanvasPreDraw(canvas);
 
-            if (kFailedLoops == loops) {
-                // Can't be timed.  A warning note has already been printed.
-                cleanup_run(target);
-                continue;
-            }
+                int maxFrameLag;
+                int loops = target->needsFrameTiming(&maxFrameLag)
+                    ? setup_gpu_bench(target, bench.get(), maxFrameLag)
+                    : setup_cpu_bench(overhead, target, bench.get());
 
-            if (runs == 0 && FLAGS_ms < 1000) {
-                // Run the first bench for 1000ms to warm up the nanobench if FLAGS_ms < 1000.
-                // Otherwise, the first few benches' measurements will be inaccurate.
-                auto stop = now_ms() + 1000;
-                do {
-                    time(loops, bench.get(), target);
-                    pool.drain();
-                } while (now_ms() < stop);
-            }
+                if (kFailedLoops == loops) {
+                    return loops;
+                }
 
-            if (FLAGS_ms) {
-                samples.reset();
-                auto stop = now_ms() + FLAGS_ms;
-                do {
-                    samples.push_back(time(loops, bench.get(), target) / loops);
-                    pool.drain();
-                } while (now_ms() < stop);
-            } else {
-                samples.reset(FLAGS_samples);
-                for (int s = 0; s < FLAGS_samples; s++) {
-                    samples[s] = time(loops, bench.get(), target) / loops;
-                    pool.drain();
+                if (runs == 0 && FLAGS_ms < 1000) {
+                    // Run the first bench for 1000ms to warm up the nanobench if FLAGS_ms < 1000.
+                    // Otherwise, the first few benches' measurements will be inaccurate.
+                    auto stop = now_ms() + 1000;
+                    do {
+                        time(loops, bench.get(), target);
+                        pool.drain();
+                    } while (now_ms() < stop);
                 }
-            }
 
-            // Scale each result to the benchmark's own units, time/unit.
-            for (double& sample : samples) {
-                sample *= (1.0 / bench->getUnits());
-            }
+                if (FLAGS_ms) {
+                    out->reset();
+                    auto stop = now_ms() + FLAGS_ms;
+                    do {
+                        out->push_back(time(loops, bench.get(), target) / loops);
+                        pool.drain();
+                    } while (now_ms() < stop);
+                } else {
+                    out->reset(FLAGS_samples);
+                    for (int s = 0; s < FLAGS_samples; s++) {
+                        (*out)[s] = time(loops, bench.get(), target) / loops;
+                        pool.drain();
+                    }
+                }
 
-            SkTArray<SkString> keys;
-            SkTArray<double> values;
-            bool gpuStatsDump = FLAGS_gpuStatsDump && Benchmark::kGPU_Backend == configs[i].backend;
-            if (gpuStatsDump) {
-                // TODO cache stats
-                bench->getGpuStats(canvas, &keys, &values);
+                // Scale each result to the benchmark's own units, time/unit.
+                for (double& sample : *out) {
+                    sample *= (1.0 / bench->getUnits());
+                }
+
+                if (gpuStatsDump) {
+                    // TODO cache stats
+                    bench->getGpuStats(canvas, &keys, &values);
+                }
+                if (FLAGS_cpuStatsDump) {
+                    bench->getCpuStats(&keys, &values);
+                }
+
+                bench->perCanvasPostDraw(canvas);
+                return loops;
+            };
+
+            int loops;
+#if !defined(SK_BUILD_FOR_WIN)
+            if (FLAGS_isolate) {
+                // The child runs measure() (including per-canvas pre/post draw) and ships the
+                // samples back; stat dump arrays stay behind in the child and are not logged.
+                if (!run_isolated(measure, &samples, &loops)) {
+                    SkDebugf("Skipping %s\t%s: isolated child failed.\n",
+                             bench->getUniqueName(), config);
+                    cleanup_run(target);
+                    continue;
+                }
+            } else
+#endif
+            {
+                loops = measure(&samples);
             }
 
-            bench->perCanvasPostDraw(canvas);
+            if (kFailedLoops == loops) {
+                // Can't be timed.  A warning note has already been printed.
+                cleanup_run(target);
+                continue;
+            }
 
             if (Benchmark::kNonRendering_Backend != target->config.backend &&
-                !FLAGS_writePath.isEmpty() && FLAGS_writePath[0]) {
+                !FLAGS_isolate && !FLAGS_writePath.isEmpty() && FLAGS_writePath[0]) {
                 SkString pngFilename = SkOSPath::Join(FLAGS_writePath[0], config);
                 pngFilename = SkOSPath::Join(pngFilename.c_str(), bench->getUniqueName());
                 pngFilename.append(".png");
@@ -1380,8 +1613,9 @@ int main(int argc, char** argv) {
             }
             log.endArray(); // samples
             benchStream.fillCurrentMetrics(log);
-            if (gpuStatsDump) {
-                // dump to json, only SKPBench currently returns valid keys / values
+            if (gpuStatsDump || FLAGS_cpuStatsDump) {
+                // dump to json; only benches that override the stats hooks
+                // return keys / values
                 SkASSERT(keys.count() == values.count());
                 for (int i = 0; i < keys.count(); i++) {
                     log.appendMetric(keys[i].c_str(), values[i]);
@@ -1443,6 +1677,32 @@ int main(int argc, char** argv) {
                         );
             }
 
+            if (baseline) {
+                SkString benchId = SkStringPrintf("%s_%d_%d", bench->getUniqueName(),
+                                                  bench->getSize().fX, bench->getSize().fY);
+                SkTArray<double> base = baseline->samples(benchId.c_str(),
+                                                          target->config.name.c_str());
+                if (base.count() >= 2 && samples.count() >= 2) {
+                    double p          = mann_whitney_p(samples, base);
+                    double baseMedian = median_of(base);
+                    double delta      = sk_ieee_double_divide(stats.median - baseMedian,
+                                                              baseMedian);
+                    double ci95       = 1.96 * sqrt(stats.var / samples.count());
+                    if (p < FLAGS_baselineP) {
+                        SkDebugf("  %s %s vs baseline: %+.1f%% (p=%.4f, mean %s +/- %s): %s\n",
+                                 benchId.c_str(), target->config.name.c_str(), delta * 100, p,
+                                 HUMANIZE(stats.mean), HUMANIZE(ci95),
+                                 delta > 0 ? "REGRESSION" : "improvement");
+                        if (delta > 0) {
+                            significantRegressions++;
+                        }
+                    }
+                } else if (base.empty() && FLAGS_verbose) {
+                    SkDebugf("  no baseline samples for %s %s\n", benchId.c_str(),
+                             target->config.name.c_str());
+                }
+            }
+
             if (FLAGS_gpuStats && Benchmark::kGPU_Backend == configs[i].backend) {
                 target->dumpStats();
             }
@@ -1476,5 +1736,11 @@ int main(int argc, char** argv) {
     log.endObject(); // root
     log.flush();
 
+    if (significantRegressions > 0) {
+        SkDebugf("%d significant regression(s) vs baseline %s.\n",
+                 significantRegressions, FLAGS_baseline[0]);
+        return 1;
+    }
+
     return 0;
 }
@@ -82,6 +82,7 @@
 
 #include <cmath>
 #include <functional>
+#include <unordered_map>
 
 static DEFINE_bool(multiPage, false,
                    "For document-type backends, render the source into multiple pages");
@@ -135,6 +136,11 @@ void GMSrc::modifyGrContextOptions(GrContextOptions* options) const {
     gm->modifyGrContextOptions(options);
 }
 
+bool GMSrc::modifiesGrContextOptions() const {
+    std::unique_ptr<skiagm::GM> gm(fFactory());
+    return gm->modifiesGrContextOptions();
+}
+
 std::unique_ptr<skiagm::verifiers::VerifierList> GMSrc::getVerifiers() const {
     std::unique_ptr<skiagm::GM> gm(fFactory());
     return gm->getVerifiers();
@@ -1445,6 +1451,10 @@ static DEFINE_bool(releaseAndAbandonGpuContext, false,
                    "Test releasing all gpu resources and abandoning the GrContext "
                    "after running each test");
 static DEFINE_bool(drawOpClip, false, "Clip each GrDrawOp to its device bounds for testing.");
+static DEFINE_bool(gpuParallel, false,
+                   "Run GPU tasks in the parallel thread pool instead of serially on the main "
+                   "thread. Each worker keeps a long-lived context per config, reused across "
+                   "sources with cache-preserving resets between tasks.");
 static DEFINE_bool(programBinaryCache, true, "Use in-memory program binary cache");
 
 GPUSink::GPUSink(const SkCommandLineConfigGpu* config,
@@ -1463,10 +1473,25 @@ GPUSink::GPUSink(const SkCommandLineConfigGpu* config,
     }
 }
 
+bool GPUSink::serial() const { return !FLAGS_gpuParallel; }
+
 Result GPUSink::draw(const Src& src, SkBitmap* dst, SkWStream* dstStream, SkString* log) const {
     return this->onDraw(src, dst, dstStream, log, fBaseContextOptions);
 }
 
+// With --gpuParallel each worker thread keeps one long-lived factory (and so one live context
+// per backend) per sink, reused across sources. Rebuilding the context for every task costs
+// far more than drawing a small golden image does.
+static GrContextFactory* long_lived_factory(const GPUSink* sink, const GrContextOptions& options) {
+    static thread_local std::unordered_map<const GPUSink*, std::unique_ptr<GrContextFactory>>
+            factories;
+    std::unique_ptr<GrContextFactory>& factory = factories[sink];
+    if (!factory) {
+        factory = std::make_unique<GrContextFactory>(options);
+    }
+    return factory.get();
+}
+
 sk_sp<SkSurface> GPUSink::createDstSurface(GrDirectContext* context, SkISize size,
                                            GrBackendTexture* backendTexture,
                                            GrBackendRenderTarget* backendRT) const {
@@ -1525,8 +1550,22 @@ Result GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
     SkASSERT(cache == grOptions.fPersistentCache);
     SkASSERT(exec == grOptions.fExecutor);
 
-    GrContextFactory factory(grOptions);
-    auto direct = factory.getContextInfo(fContextType, fContextOverrides).directContext();
+    // A task may share this thread's long-lived context only when running parallel with plain
+    // base options and nothing that would customize or poison the context for later tasks.
+    const bool shareContext = !FLAGS_gpuParallel ? false
+                            : &baseOptions == &fBaseContextOptions &&
+                              !src.modifiesGrContextOptions() && !initContext &&
+                              !FLAGS_preAbandonGpuContext && !FLAGS_abandonGpuContext &&
+                              !FLAGS_releaseAndAbandonGpuContext;
+    std::unique_ptr<GrContextFactory> ownedFactory;
+    GrContextFactory* factory;
+    if (shareContext) {
+        factory = long_lived_factory(this, grOptions);
+    } else {
+        ownedFactory = std::make_unique<GrContextFactory>(grOptions);
+        factory = ownedFactory.get();
+    }
+    auto direct = factory->getContextInfo(fContextType, fContextOverrides).directContext();
     if (initContext) {
         initContext(direct);
     }
@@ -1544,7 +1583,7 @@ Result GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
         return Result::Fatal("Could not create a surface.");
     }
     if (FLAGS_preAbandonGpuContext) {
-        factory.abandonContexts();
+        factory->abandonContexts();
     }
     SkCanvas* canvas = surface->getCanvas();
     Result result = src.draw(direct, canvas);
@@ -1561,9 +1600,9 @@ Result GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
     this->readBack(surface.get(), dst);
 
     if (FLAGS_abandonGpuContext) {
-        factory.abandonContexts();
+        factory->abandonContexts();
     } else if (FLAGS_releaseAndAbandonGpuContext) {
-        factory.releaseResourcesAndAbandonContexts();
+        factory->releaseResourcesAndAbandonContexts();
     }
     if (!direct->abandoned()) {
         surface.reset();
@@ -1577,6 +1616,12 @@ Result GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
     if (grOptions.fPersistentCache) {
         direct->storeVkPipelineCacheData();
     }
+    if (shareContext) {
+        // Keep the context warm for the next task on this thread, but assume the src may have
+        // perturbed raw backend state and bound the footprint by dropping scratch resources.
+        direct->resetContext();
+        direct->purgeUnlockedResources(/*scratchResourcesOnly=*/true);
+    }
     return Result::Ok();
 }
 
@@ -90,6 +90,9 @@ struct Src {
     virtual SkISize size() const = 0;
     virtual Name name() const = 0;
     virtual void modifyGrContextOptions(GrContextOptions* options) const {}
+    // True if modifyGrContextOptions() customizes the options, meaning this Src must not share
+    // a context with other tasks.
+    virtual bool modifiesGrContextOptions() const { return false; }
     virtual bool veto(SinkFlags) const { return false; }
 
     virtual int pageCount() const { return 1; }
@@ -135,6 +138,7 @@ public:
     SkISize size() const override;
     Name name() const override;
     void modifyGrContextOptions(GrContextOptions* options) const override;
+    bool modifiesGrContextOptions() const override;
 
     std::unique_ptr<skiagm::verifiers::VerifierList> getVerifiers() const override;
 
@@ -394,7 +398,7 @@ public:
     }
     SkCommandLineConfigGpu::SurfType surfType() const { return fSurfType; }
     bool useDIText() const { return fUseDIText; }
-    bool serial() const override { return true; }
+    bool serial() const override;
     const char* fileExtension() const override { return "png"; }
     SinkFlags flags() const override {
         SinkFlags::Multisampled ms = fSampleCount > 1 ? SinkFlags::kMultisampled
@@ -28,6 +28,7 @@
 #include "experimental/svg/model/SkSVGUse.h"
 #include "experimental/svg/model/SkSVGValue.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkString.h"
 #include "include/private/SkTo.h"
 #include "include/utils/SkParsePath.h"
@@ -512,10 +513,35 @@ sk_sp<SkSVGDOM> SkSVGDOM::MakeFromStream(SkStream& svgStream) {
 }
 
 void SkSVGDOM::render(SkCanvas* canvas) const {
-    if (fRoot) {
+    if (!fRoot) {
+        return;
+    }
+
+    auto render_to = [this](SkCanvas* target) {
         SkSVGLengthContext       lctx(fContainerSize);
         SkSVGPresentationContext pctx;
-        fRoot->render(SkSVGRenderContext(canvas, fIDMapper, lctx, pctx));
+        fRoot->render(SkSVGRenderContext(target, fIDMapper, lctx, pctx));
+    };
+
+    if (!fCacheRenders) {
+        render_to(canvas);
+        return;
+    }
+
+    if (!fCachedRender.fPicture || fCachedRender.fRevision != fRevision) {
+        // Resolve the full DOM once, into a replayable recording.
+        SkPictureRecorder recorder;
+        render_to(recorder.beginRecording(SkRect::MakeSize(fContainerSize)));
+        fCachedRender = { fRevision, recorder.finishRecordingAsPicture() };
+    }
+
+    canvas->drawPicture(fCachedRender.fPicture);
+}
+
+void SkSVGDOM::setRenderCaching(bool enabled) {
+    fCacheRenders = enabled;
+    if (!enabled) {
+        fCachedRender.fPicture.reset();
     }
 }
 
@@ -534,8 +560,8 @@ const SkSize& SkSVGDOM::containerSize() const {
 }
 
 void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
-    // TODO: inval
     fContainerSize = containerSize;
+    fRevision++;
 }
 
 sk_sp<SkSVGNode>* SkSVGDOM::findNodeById(const char* id) {
@@ -545,6 +571,7 @@ sk_sp<SkSVGNode>* SkSVGDOM::findNodeById(const char* id) {
 
 void SkSVGDOM::setRoot(sk_sp<SkSVGNode> root) {
     fRoot = std::move(root);
+    fRevision++;
 }
 
 // TODO(fuego): move this to SkSVGNode or its own CU.
@@ -15,6 +15,7 @@
 
 class SkCanvas;
 class SkDOM;
+class SkPicture;
 class SkStream;
 class SkSVGNode;
 
@@ -35,12 +36,39 @@ public:
 
     void render(SkCanvas*) const;
 
+    /**
+     * Enables render caching: the first render() records the fully-resolved content
+     * (presentation attribute inheritance flattened, paths converted and measured), and
+     * subsequent render() calls replay the recording instead of re-walking the DOM.
+     *
+     * Cached renders are keyed on the DOM revision.  Mutations applied through the DOM
+     * (setRoot, setContainerSize) bump the revision automatically; clients mutating nodes
+     * directly (e.g. via findNodeById) must call notifyContentChanged() for their changes
+     * to invalidate the cache.
+     */
+    void setRenderCaching(bool);
+
+    // The current DOM revision, incremented on every (observable) content mutation.
+    uint32_t revision() const { return fRevision; }
+
+    // Signals out-of-band node mutations, invalidating any cached renders.
+    void notifyContentChanged() { fRevision++; }
+
 private:
     SkSize intrinsicSize() const;
 
     SkSize           fContainerSize;
     sk_sp<SkSVGNode> fRoot;
     SkSVGIDMapper    fIDMapper;
+    uint32_t         fRevision     = 0;
+    bool             fCacheRenders = false;
+
+    struct CachedRender {
+        uint32_t         fRevision;
+        sk_sp<SkPicture> fPicture;
+    };
+
+    mutable CachedRender fCachedRender = { 0, nullptr };
 
     typedef SkRefCnt INHERITED;
 };
@@ -290,6 +290,8 @@ protected:
         options->fMaxTileSizeOverride = kMaxTileSize;
     }
 
+    bool modifiesGrContextOptions() const override { return true; }
+
 private:
     static constexpr int kBlockSize = 70;
     static constexpr int kBlockSpacing = 12;
@@ -47,6 +47,8 @@ public:
         options->fAllowMultipleGlyphCacheTextures = fAllowMultipleTextures;
     }
 
+    bool modifiesGrContextOptions() const override { return true; }
+
 protected:
     SkString onShortName() override {
         SkString name("fontcache");
@@ -55,6 +55,8 @@ class FontRegenGM : public skiagm::GpuGM {
         options->fAllowMultipleGlyphCacheTextures = GrContextOptions::Enable::kNo;
     }
 
+    bool modifiesGrContextOptions() const override { return true; }
+
     SkString onShortName() override { return SkString("fontregen"); }
 
     SkISize onISize() override { return {kSize, kSize}; }
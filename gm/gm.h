@@ -166,6 +166,10 @@ namespace skiagm {
 
         virtual void modifyGrContextOptions(GrContextOptions*);
 
+        // True if modifyGrContextOptions() customizes the options. GMs that return true are
+        // drawn on a context of their own rather than one shared across tasks.
+        virtual bool modifiesGrContextOptions() const { return false; }
+
         virtual std::unique_ptr<verifiers::VerifierList> getVerifiers() const;
 
     protected:
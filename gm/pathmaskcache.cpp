@@ -113,6 +113,8 @@ protected:
         options->fAllowPathMaskCaching = true;
     }
 
+    bool modifiesGrContextOptions() const override { return true; }
+
 private:
     typedef GM INHERITED;
 };
@@ -59,6 +59,8 @@ private:
         ctxOptions->fAllowPathMaskCaching = true;
     }
 
+    bool modifiesGrContextOptions() const override { return true; }
+
     DrawResult onDraw(GrRecordingContext* ctx, GrRenderTargetContext* rtc, SkCanvas* canvas,
                       SkString* errorMsg) override {
         using CoverageType = GrCCAtlas::CoverageType;
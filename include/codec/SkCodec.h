@@ -24,9 +24,11 @@
 
 #include <vector>
 
+class GrRecordingContext;
 class SkColorSpace;
 class SkData;
 class SkFrameHolder;
+class SkImage;
 class SkPngChunkReader;
 class SkSampler;
 
@@ -380,6 +382,23 @@ public:
         return this->getPixels(pm.info(), pm.writable_addr(), pm.rowBytes(), opts);
     }
 
+    /**
+     *  Phase-level timing for the most recent call to getPixels, recorded only
+     *  while collectPhaseStats(true) has been called.  This separates the time
+     *  spent in the underlying decode (entropy decode + swizzle) from the time
+     *  spent in Skia's color space conversion, so a decode regression can be
+     *  attributed to the right component.  Intended for benchmarking and
+     *  diagnostics; collection adds a small per-row timing overhead.
+     */
+    struct PhaseStats {
+        double fTotalNanos = 0;  // wall time inside getPixels
+        double fXformNanos = 0;  // portion spent in color space transforms
+    };
+
+    void collectPhaseStats(bool enable) { fCollectPhaseStats = enable; }
+
+    const PhaseStats& phaseStats() const { return fPhaseStats; }
+
     /**
      *  If decoding to YUV is supported, this returns true.  Otherwise, this
      *  returns false and does not modify any of the parameters.
@@ -485,6 +504,24 @@ public:
         return this->onIncrementalDecode(rowsDecoded);
     }
 
+    /**
+     *  Decode the pixels covered by region (specified in the coordinates of the full
+     *  image) into pixels. dstInfo must have the dimensions of region; scaling is not
+     *  supported.
+     *
+     *  Unlike getPixels with Options::fSubset, repeated calls share decoder state: the
+     *  codec caches parsed header and entropy index information (e.g. jpeg restart
+     *  offsets), so tiled clients can decode many subrects of one image without paying
+     *  for a full-image decode each time. Formats with such an index decode an arbitrary
+     *  subrect in time proportional to the subrect; for the rest, tiles requested in
+     *  increasing row order resume from the previous tile's last row.
+     *
+     *  Calling getPixels, startScanlineDecode, or startIncrementalDecode between calls
+     *  discards the cached session, so the next region decode starts over.
+     */
+    Result getRegion(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
+                     const SkIRect& region);
+
     /**
      * The remaining functions revolve around decoding scanlines.
      */
@@ -726,11 +763,24 @@ public:
     // Register a decoder at runtime by passing two function pointers:
     //    - peek() to return true if the span of bytes appears to be your encoded format;
     //    - make() to attempt to create an SkCodec from the given stream.
+    // Registered decoders are tried before the built-in ones, most recently registered
+    // first, so a platform decoder (e.g. a VA-API or other hardware backend) can claim a
+    // format such as jpeg ahead of the software codec; returning nullptr from make() does
+    // not fall through to the next decoder, so make() should delegate to the software
+    // codec itself for streams it cannot handle.
     // Not thread safe.
     static void Register(
             bool                     (*peek)(const void*, size_t),
             std::unique_ptr<SkCodec> (*make)(std::unique_ptr<SkStream>, SkCodec::Result*));
 
+    /**
+     *  If the codec keeps its decoded output in device memory -- e.g. a hardware decoder
+     *  that produced a dmabuf-backed frame it has imported into the context -- returns
+     *  that output as an SkImage without copying through CPU memory. Returns nullptr if
+     *  the codec has no such image; callers then decode with getPixels() as usual.
+     */
+    sk_sp<SkImage> getNativeImage(GrRecordingContext* context);
+
 protected:
     const SkEncodedInfo& getEncodedInfo() const { return fEncodedInfo; }
 
@@ -776,6 +826,9 @@ protected:
         return kUnimplemented;
     }
 
+    // By default, a codec decodes to CPU memory and has no device-resident output.
+    virtual sk_sp<SkImage> onGetNativeImage(GrRecordingContext*);
+
     virtual bool onGetValidSubset(SkIRect* /*desiredSubset*/) const {
         // By default, subsets are not supported.
         return false;
@@ -886,6 +939,16 @@ private:
 
     bool                               fStartedIncrementalDecode;
 
+    // True while a scanline decode started by getRegion() is still resumable; any decode
+    // started by the client directly discards the session.
+    bool                               fRegionSessionActive;
+
+    // Phase timing, accumulated only when fCollectPhaseStats is set.
+    // fPhaseStats is mutable because applyColorXform, which accumulates the
+    // transform time, is const.
+    bool                               fCollectPhaseStats = false;
+    mutable PhaseStats                 fPhaseStats;
+
     bool initializeColorXform(const SkImageInfo& dstInfo, SkEncodedInfo::Alpha, bool srcIsOpaque);
 
     /**
@@ -928,6 +991,14 @@ private:
         return kUnimplemented;
     }
 
+    /**
+     *  For codecs that keep an index into the encoded data (e.g. jpeg restart offsets),
+     *  decode just the rows covering region. Return kUnimplemented to let getRegion()
+     *  fall back to the shared scanline-session path.
+     */
+    virtual Result onGetRegion(const SkImageInfo&, void*, size_t, const SkIRect&) {
+        return kUnimplemented;
+    }
 
     virtual bool onSkipScanlines(int /*countLines*/) { return false; }
 
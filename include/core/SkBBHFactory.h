@@ -13,6 +13,8 @@
 #include "include/core/SkTypes.h"
 #include <vector>
 
+class SkExecutor;
+
 class SkBBoxHierarchy : public SkRefCnt {
 public:
     SkBBoxHierarchy() {}
@@ -32,6 +34,13 @@ public:
      */
     virtual void search(const SkRect& query, std::vector<int>* results) const = 0;
 
+    /**
+     * Populate each results[i] with the indices of bounding boxes intersecting
+     * queries[i]. The default answers each query independently; subclasses may
+     * answer all of them in a single traversal.
+     */
+    virtual void search(const SkRect queries[], int N, std::vector<int> results[]) const;
+
     /**
      * Return approximate size in memory of *this.
      */
@@ -49,7 +58,17 @@ public:
 
 class SK_API SkRTreeFactory : public SkBBHFactory {
 public:
+    /**
+     *  If an executor is provided, each hierarchy builds itself there,
+     *  overlapped with recording, instead of lazily on first query. The
+     *  executor must outlive any picture recorded with this factory.
+     */
+    SkRTreeFactory(SkExecutor* = nullptr);
+
     sk_sp<SkBBoxHierarchy> operator()() const override;
+
+private:
+    SkExecutor* fExecutor;
 };
 
 #endif
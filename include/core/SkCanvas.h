@@ -1959,6 +1959,34 @@ public:
                                          const SkPaint* paint = nullptr,
                                          SrcRectConstraint constraint = kStrict_SrcRectConstraint);
 
+    /** Entry for drawImageRectBatch(): one image drawn from fSrcRect to fDstRect, just as
+        drawImageRect() would.
+    */
+    struct SK_API ImageRectEntry {
+        ImageRectEntry() = default;
+        ImageRectEntry(const SkImage* image, const SkRect& srcRect, const SkRect& dstRect)
+                : fImage(image), fSrcRect(srcRect), fDstRect(dstRect) {}
+
+        const SkImage* fImage = nullptr;
+        SkRect         fSrcRect = SkRect::MakeEmpty();
+        SkRect         fDstRect = SkRect::MakeEmpty();
+    };
+
+    /** Draws a batch of image-to-rectangle entries that share one paint. Equivalent to calling
+        drawImageRect(fImage, fSrcRect, fDstRect, paint, constraint) for each entry, except the
+        shared paint and clip state are resolved once for the whole batch, and backends that can
+        draw image sets in bulk (such as the GPU backend's batched texture ops) receive all
+        entries at once.
+
+        @param entries     images with their source and destination rectangles
+        @param count       number of entries
+        @param paint       SkPaint containing SkBlendMode, SkColorFilter, and so on; or nullptr
+        @param constraint  filter strictly within fSrcRect or draw faster
+    */
+    void drawImageRectBatch(const ImageRectEntry entries[], int count,
+                            const SkPaint* paint = nullptr,
+                            SrcRectConstraint constraint = kFast_SrcRectConstraint);
+
     /** Draws text, with origin at (x, y), using clip, SkMatrix, SkFont font,
         and SkPaint paint.
 
@@ -86,6 +86,7 @@ private:
     const Segment* distanceToSegment(SkScalar distance, SkScalar* t) const;
 
     friend class SkContourMeasureIter;
+    friend class SkContourMeasureCache;
 };
 
 class SK_API SkContourMeasureIter {
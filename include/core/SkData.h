@@ -68,6 +68,15 @@ public:
      */
     bool equals(const SkData* other) const;
 
+    /**
+     *  Returns a dataref with the contents of the specified subset of this data.
+     *  No bytes are copied: the result is a view that shares (and holds a
+     *  reference on) this data's storage, so it keeps the entire parent
+     *  allocation alive for its own lifetime. Offset and length are clamped to
+     *  the size of the data.
+     */
+    sk_sp<SkData> makeSubset(size_t offset, size_t length) const;
+
     /**
      *  Function that, if provided, will be called when the SkData goes out
      *  of scope, allowing for custom allocation/freeing of the data's contents.
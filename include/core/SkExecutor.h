@@ -16,12 +16,23 @@ class SK_API SkExecutor {
 public:
     virtual ~SkExecutor();
 
+    // A scheduling hint for executors that support priorities; see add() below.
+    enum class Priority { kLow, kNormal, kHigh };
+
     // Create a thread pool SkExecutor with a fixed thread count, by default the number of cores.
     static std::unique_ptr<SkExecutor> MakeFIFOThreadPool(int threads = 0,
                                                           bool allowBorrowing = true);
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0,
                                                           bool allowBorrowing = true);
 
+    // Create a work-stealing thread pool: each thread owns a work deque and steals from the
+    // others when its own runs dry, so concurrent add() calls spread across per-thread queues
+    // instead of contending on one lock. Honors the Priority hint, and can optionally pin each
+    // thread to a core on platforms that support it.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0,
+                                                                  bool allowBorrowing = true,
+                                                                  bool pinThreads = false);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
@@ -29,6 +40,13 @@ public:
     // Add work to execute.
     virtual void add(std::function<void(void)>) = 0;
 
+    // Add work with a scheduling hint. Executors without priority support run everything at
+    // the same priority. (A distinct name rather than an add() overload, so subclasses that
+    // override add() don't hide it.)
+    virtual void addWithPriority(std::function<void(void)> work, Priority) {
+        this->add(std::move(work));
+    }
+
     // If it makes sense for this executor, use this thread to execute work for a little while.
     virtual void borrow() {}
 };
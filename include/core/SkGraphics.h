@@ -90,6 +90,25 @@ public:
      */
     static int SetFontCachePointSizeLimit(int maxPointSize);
 
+    /**
+     *  Returns the minimum size in bytes at which a cached glyph image is stored compressed.
+     *
+     *  Glyph images at least this large are run length encoded in the font cache when that
+     *  actually saves memory, and decompressed on demand when drawn. Smaller images, and
+     *  images that don't compress well, are always stored raw.
+     */
+    static size_t GetGlyphImageCompressionThreshold();
+
+    /**
+     *  Set the minimum size in bytes at which a cached glyph image is stored compressed,
+     *  returning the previous value. Pass SIZE_MAX to disable compression entirely.
+     *
+     *  Compression trades a small decompression cost on each use of a cached glyph image
+     *  for a several-fold reduction in font cache memory on mask-heavy (e.g. CJK) content.
+     *  Only applies to glyph images cached after the call.
+     */
+    static size_t SetGlyphImageCompressionThreshold(size_t bytes);
+
     /**
      *  For debugging purposes, this will attempt to purge the font cache. It
      *  does not change the limit, but will cause subsequent font measures and
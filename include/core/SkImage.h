@@ -27,6 +27,7 @@ class SkData;
 class SkCanvas;
 class SkImageFilter;
 class SkImageGenerator;
+class SkExecutor;
 class SkMipmap;
 class SkPaint;
 class SkPicture;
@@ -1058,6 +1059,33 @@ public:
                                          ReadPixelsCallback callback,
                                          ReadPixelsContext context);
 
+    /** Client-provided context that is passed to PrepareForDrawingCallback. */
+    using PrepareForDrawingContext = void*;
+
+    /** Client-provided callback to prepareForDrawing(), called once the image's pixels are
+        available (or with success == false if the decode failed).
+    */
+    using PrepareForDrawingCallback = void(PrepareForDrawingContext, bool success);
+
+    /** Makes the image's pixels ready to draw, possibly asynchronously.
+
+        Lazily-generated images normally decode on whichever thread first draws them,
+        blocking raster or flush. prepareForDrawing() runs the generator decode on executor
+        instead, placing the result in the image's pixel cache (keyed by the image's unique
+        ID) where subsequent draws -- CPU raster, or GPU texture uploads pulling from the
+        same cache -- find the pixels already decoded. Draws issued while the decode is
+        still in flight behave as before.
+
+        For images whose pixels are already available, the callback is invoked immediately.
+
+        @param executor  where to run the decode; must outlive the pending work
+        @param callback  optional function to call once the pixels are ready
+        @param context   passed to callback
+    */
+    void prepareForDrawing(SkExecutor* executor,
+                           PrepareForDrawingCallback callback = nullptr,
+                           PrepareForDrawingContext context = nullptr);
+
     /** Copies SkImage to dst, scaling pixels to fit dst.width() and dst.height(), and
         converting pixels to match dst.colorType() and dst.alphaType(). Returns true if
         pixels are copied. Returns false if dst.addr() is nullptr, or dst.rowBytes() is
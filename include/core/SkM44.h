@@ -365,6 +365,12 @@ public:
     ////////////
 
     SkV4 map(float x, float y, float z, float w) const;
+
+    /** Map count points through the matrix in one pass. src and dst may be the same array.
+     *  This amortizes loading the matrix over the whole span, unlike calling map() per point.
+     */
+    void mapPoints(SkV4 dst[], const SkV4 src[], int count) const;
+
     SkV4 operator*(const SkV4& v) const {
         return this->map(v.x, v.y, v.z, v.w);
     }
@@ -570,6 +570,20 @@ public:
     */
     void shrinkToFit();
 
+    /** Replaces SkPath contents with the given verb array, SkPoint array, and conic
+        weights, adopting their storage rather than copying it. The arrays are validated
+        as in Make(), except that the point and weight counts must match the verbs
+        exactly; if they do not form a valid path, SkPath is reset to empty. Fill type
+        and volatility are unchanged.
+
+        @param points        SkPoint array to adopt
+        @param verbs         verb array to adopt
+        @param conicWeights  conic weight array to adopt
+        @return              reference to SkPath
+    */
+    SkPath& setFromData(SkTDArray<SkPoint> points, SkTDArray<uint8_t> verbs,
+                        SkTDArray<SkScalar> conicWeights);
+
 #ifdef SK_HIDE_PATH_EDIT_METHODS
 private:
 #endif
@@ -1305,6 +1319,18 @@ public:
         return this->addPath(src, m, mode);
     }
 
+    /** Appends src to SkPath, consuming src.
+
+        Behaves as addPath(src, mode), but src is no longer needed afterwards: when SkPath
+        is empty, src's verb array, SkPoint array, and conic weights are adopted without
+        copying. src is left in a valid but unspecified state.
+
+        @param src   SkPath verbs, SkPoint, and conic weights to add
+        @param mode  kAppend_AddPathMode or kExtend_AddPathMode
+        @return      reference to SkPath
+    */
+    SkPath& addPath(SkPath&& src, AddPathMode mode = kAppend_AddPathMode);
+
     /** Appends src to SkPath, transformed by matrix. Transformed curves may have different
         verbs, SkPoint, and conic weights.
 
@@ -193,6 +193,9 @@ public:
     void incReserve(int extraPtCount) {
         this->incReserve(extraPtCount, extraPtCount);
     }
+    // As incReserve(), but allocates exactly the requested capacity with no growth slack,
+    // for callers that know the final size of the path up front.
+    void incReserveExact(int extraPtCount, int extraVerbCount);
 
 private:
     SkTDArray<SkPoint>  fPts;
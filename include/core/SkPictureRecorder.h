@@ -12,6 +12,8 @@
 #include "include/core/SkPicture.h"
 #include "include/core/SkRefCnt.h"
 
+#include <memory>
+
 #ifdef SK_BUILD_FOR_ANDROID_FRAMEWORK
 namespace android {
     class Picture;
@@ -40,6 +42,43 @@ public:
     enum FinishFlags {
     };
 
+    /** Reusable backing storage for recorded commands. Passing the same arena
+        to successive beginRecording() calls recycles the previous recording's
+        storage, grown to its high-water mark, once the picture recorded with
+        it has been released; steady-state re-recording then performs no heap
+        allocation for commands. While that picture is still alive, recording
+        silently falls back to fresh storage. The arena must outlive every
+        picture recorded with it.
+    */
+    class SK_API RecordingArena {
+    public:
+        RecordingArena();
+        ~RecordingArena();
+
+    private:
+        friend class SkPictureRecorder;
+
+        sk_sp<SkRecord>         fRecord;     // the last recording, if recyclable
+        std::unique_ptr<char[]> fBlock;      // backing for that recording's ops
+        size_t                  fBlockSize;
+
+        RecordingArena(const RecordingArena&) = delete;
+        RecordingArena& operator=(const RecordingArena&) = delete;
+    };
+
+    /** Returns the canvas that records the drawing commands.
+        @param bounds the cull rect used when recording this picture. Any drawing the falls outside
+                      of this rect is undefined, and may be drawn or it may not.
+        @param arena       storage recycled across recordings; see RecordingArena
+        @param bbh         optional acceleration structure
+        @param recordFlags optional flags that control recording.
+        @return the canvas.
+    */
+    SkCanvas* beginRecording(const SkRect& bounds,
+                             RecordingArena* arena,
+                             sk_sp<SkBBoxHierarchy> bbh = nullptr,
+                             uint32_t recordFlags = 0);
+
     /** Returns the canvas that records the drawing commands.
         @param bounds the cull rect used when recording this picture. Any drawing the falls outside
                       of this rect is undefined, and may be drawn or it may not.
@@ -14,6 +14,7 @@
 #include "include/private/SkTo.h"
 
 #include <memory.h>
+#include <vector>
 
 class SkStream;
 class SkStreamRewindable;
@@ -150,6 +151,12 @@ public:
     //TODO: replace with virtual const SkData* getData()
     virtual const void* getMemoryBase() { return nullptr; }
 
+    /** Returns the ref-counted data backing this stream if the stream shares
+     *  ownership of it, or NULL. Unlike getMemoryBase(), a non-null return may
+     *  safely outlive the stream, so readers can alias it instead of copying.
+     */
+    virtual sk_sp<SkData> getData() const { return nullptr; }
+
 private:
     virtual SkStream* onDuplicate() const { return nullptr; }
     virtual SkStream* onFork() const { return nullptr; }
@@ -397,6 +404,11 @@ public:
     sk_sp<SkData> asData() const { return fData; }
     void setData(sk_sp<SkData> data);
 
+    /** Non-null only when the stream's data is ref-counted (and not a bare
+     *  pointer reference), so the returned data may outlive the stream.
+     */
+    sk_sp<SkData> getData() const override;
+
     void skipToAlign4();
     const void* getAtPos();
 
@@ -429,6 +441,7 @@ private:
 
     sk_sp<SkData>   fData;
     size_t          fOffset;
+    bool            fDataIsShared;
 
     typedef SkStreamMemory INHERITED;
 };
@@ -484,9 +497,17 @@ public:
     /** Prepend this stream to dst, resetting this. */
     void prependToAndReset(SkDynamicMemoryWStream* dst);
 
-    /** Return the contents as SkData, and then reset the stream. */
+    /** Return the contents as SkData, and then reset the stream.
+        When the content occupies a single storage block, the block is adopted by
+        the returned data with no copy. */
     sk_sp<SkData> detachAsData();
 
+    /** Return the contents as a list of SkData segments that adopt this stream's
+        storage blocks (no copy), and then reset the stream. Concatenating the
+        segments in order yields the same bytes as detachAsData(), without ever
+        holding a second contiguous copy of the content. */
+    std::vector<sk_sp<SkData>> detachAsSegments();
+
     /** Reset, returning a reader stream with the current content. */
     std::unique_ptr<SkStreamAsset> detachAsStream();
 
@@ -187,6 +187,21 @@ struct Metadata {
     */
     int fEncodingQuality = 101;
 
+    /** Deflate compression level for PDF streams: 0 is no compression; 1 is
+        best speed; 9 is best (but slowest) compression. The default, -1,
+        uses zlib's Z_DEFAULT_COMPRESSION level.
+    */
+    int fCompressionLevel = -1;
+
+    /** If true (the default), expensive serialized resources -- encoded image
+        streams and font subsets -- are shared through the process-wide
+        resource cache, so a batch of documents embedding the same assets
+        computes each one only once. Set to false to recompute all resources
+        per document (for instance, to bound memory in a long-lived process
+        that never repeats assets).
+    */
+    bool fShareSerializedResources = true;
+
     /** An optional tree of structured document tags that provide
         a semantic representation of the content. The caller
         should retain ownership.
@@ -63,6 +63,8 @@ public:
             kMarker_Flag        = 0x2,
             kMarkerNormals_Flag = 0x4,
             kSRGBUnpremul_Flag  = 0x8,
+            // The uniform's value is bound as a compile-time constant (see pinUniform)
+            kPinned_Flag        = 0x10,
         };
 
         SkString  fName;
@@ -83,11 +85,27 @@ public:
         int      fWidth;  // 1 - 4 (floats)
     };
 
+    // A compact per-uniform description, precomputed at construction so per-draw uniform
+    // marshalling doesn't have to re-walk (and re-filter) the full variable list.
+    struct UniformSlot {
+        size_t         fOffset;
+        Variable::Type fType;
+        int            fCount;
+    };
+
     // [Effect, ErrorText]
     // If successful, Effect != nullptr, otherwise, ErrorText contains the reason for failure.
     using EffectResult = std::tuple<sk_sp<SkRuntimeEffect>, SkString>;
     static EffectResult Make(SkString sksl);
 
+    /**
+     * Creates an effect from a program that was dehydrated ahead of time by skslc (see the
+     * '.dehydrated' output mode), skipping parsing and IR generation entirely. 'dehydrated' must
+     * contain exactly the bytes skslc produced. NOTE: effects created this way carry no source
+     * text, so they do not yet survive SkPicture serialization.
+     */
+    static EffectResult Make(sk_sp<SkData> dehydrated);
+
     sk_sp<SkShader> makeShader(sk_sp<SkData> inputs,
                                sk_sp<SkShader> children[],
                                size_t childCount,
@@ -121,6 +139,16 @@ public:
     ConstIterable<Variable> inputs() const { return ConstIterable<Variable>(fInAndUniformVars); }
     ConstIterable<SkString> children() const { return ConstIterable<SkString>(fChildren); }
     ConstIterable<Varying> varyings() const { return ConstIterable<Varying>(fVaryings); }
+    ConstIterable<UniformSlot> uniformSlots() const {
+        return ConstIterable<UniformSlot>(fUniformSlots);
+    }
+
+    // Copies this effect's packed uniform values out of an input block. Uniforms always occupy
+    // the leading uniformSize() bytes of the input block as densely-packed floats, so this is a
+    // single memcpy; 'dst' must have room for uniformSize() bytes.
+    void writeUniformsFast(const void* inputs, void* dst) const {
+        memcpy(dst, inputs, fUniformSize);
+    }
 
     // Returns pointer to the named in/uniform variable's description, or nullptr if not found
     const Variable* findInput(const char* name) const;
@@ -128,6 +156,16 @@ public:
     // Returns index of the named child, or -1 if not found
     int findChild(const char* name) const;
 
+    /**
+     * Pins the named uniform: when the program is compiled for the GPU or the interpreter, the
+     * uniform's current value is bound as a compile-time constant, so conditionals on it fold
+     * away along with any code they guard. Each distinct pinned value compiles (and caches) a
+     * distinct program, so only pin uniforms that change rarely. Only non-array bool, int, and
+     * float uniforms can be pinned, and pinning must happen before the effect is first used to
+     * draw. Returns false if no such uniform exists or its type is unsupported.
+     */
+    bool pinUniform(const char* name);
+
     bool usesSampleCoords() const { return fMainFunctionHasSampleCoords; }
 
     static void RegisterFlattenables();
@@ -135,6 +173,7 @@ public:
 
 private:
     SkRuntimeEffect(SkString sksl,
+                    sk_sp<SkData> dehydrated,
                     std::unique_ptr<SkSL::Program> baseProgram,
                     std::vector<Variable>&& inAndUniformVars,
                     std::vector<SkString>&& children,
@@ -143,6 +182,10 @@ private:
                     size_t uniformSize,
                     bool mainHasSampleCoords);
 
+    static EffectResult MakeInternal(SkString sksl, sk_sp<SkData> dehydrated,
+                                     std::unique_ptr<SkSL::Program> program,
+                                     const SkSL::SharedCompiler&);
+
     using SpecializeResult = std::tuple<std::unique_ptr<SkSL::Program>, SkString>;
     SpecializeResult specialize(SkSL::Program& baseProgram, const void* inputs,
                                 const SkSL::SharedCompiler&) const;
@@ -172,12 +215,16 @@ private:
 
     uint32_t fHash;
     SkString fSkSL;
+    // For effects built from a dehydrated binary instead of source text. Keeps the binary alive;
+    // the rehydrated programs reference string data stored inside it.
+    sk_sp<SkData> fDehydrated;
 
     std::unique_ptr<SkSL::Program> fBaseProgram;
     std::vector<Variable> fInAndUniformVars;
     std::vector<SkString> fChildren;
     std::vector<SkSL::SampleUsage> fSampleUsages;
     std::vector<Varying>  fVaryings;
+    std::vector<UniformSlot> fUniformSlots;
 
     size_t fUniformSize;
     bool   fMainFunctionHasSampleCoords;
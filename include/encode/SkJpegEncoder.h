@@ -61,6 +61,18 @@ public:
          *  In the second case, the encoder supports linear or legacy blending.
          */
         AlphaOption fAlphaOption = AlphaOption::kIgnore;
+
+        /**
+         *  If true, Encode() compresses independent bands of MCU rows on
+         *  SkExecutor::GetDefault() worker threads, joins them with restart markers, and
+         *  streams each band to |dst| as it completes, so peak memory stays bounded by the
+         *  compressed bands rather than the whole file. All bands must share one Huffman
+         *  table set, so this uses the fixed default tables instead of per-image optimized
+         *  ones and produces slightly larger files. Decoded pixels are identical to a
+         *  serial encode. Images too small to split fall back to the serial encoder, as
+         *  does the incremental Make()/encodeRows() API.
+         */
+        bool fParallel = false;
     };
 
     /**
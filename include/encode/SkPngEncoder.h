@@ -59,8 +59,38 @@ public:
          *  and the (2i + 1)-th entry is the text for the i-th comment.
          */
         sk_sp<SkDataTable> fComments;
+
+        /**
+         *  If true, Encode() filters and deflates bands of rows concurrently on
+         *  SkExecutor::GetDefault() worker threads and concatenates the resulting IDAT
+         *  data; bands meet on Z_FULL_FLUSH boundaries, so the output is a standard png
+         *  that any decoder reads serially. Because each band restarts the deflate
+         *  window, files are slightly larger than a serial encode. 16-bit-per-channel
+         *  sources, fZLibLevel 0, and images too small to split fall back to the serial
+         *  encoder, as does the incremental Make()/encodeRows() API.
+         */
+        bool fParallel = false;
     };
 
+    /**
+     *  Compresses one independent band of the filtered scanline stream for the parallel
+     *  encode path. The implementation must write a raw deflate stream (no zlib header or
+     *  trailer) for the |len| bytes at |data| to |dst|, ending on a byte boundary with no
+     *  pending bits (as after Z_FULL_FLUSH) -- or, iff |lastChunk| is true, finishing the
+     *  stream (Z_FINISH). |zlibLevel| is Options::fZLibLevel. On success, set |*adler| to
+     *  the adler-32 checksum of the input bytes and return true.
+     */
+    using DeflateChunkProc = bool (*)(const void* data, size_t len, int zlibLevel,
+                                      bool lastChunk, SkWStream* dst, uint32_t* adler);
+
+    /**
+     *  Replaces the deflate implementation used by the parallel encode path, e.g. with a
+     *  zlib-ng or ISA-L backed compressor. Install once at startup; this is not thread
+     *  safe with respect to concurrent encodes. Pass nullptr to restore the built-in
+     *  zlib.
+     */
+    static void SetDeflateChunkProc(DeflateChunkProc);
+
     /**
      *  Encode the |src| pixels to the |dst| stream.
      *  |options| may be used to control the encoding behavior.
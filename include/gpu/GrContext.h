@@ -248,8 +248,13 @@ public:
     /**
      * Purge GPU resources that haven't been used in the past 'msNotUsed' milliseconds or are
      * otherwise marked for deletion, regardless of whether the context is under budget.
+     *
+     * If 'maxResourcesToPurge' is >= 0 then at most that many resources are purged now and the
+     * remainder are purged incrementally as the context does other work, bounding the time spent
+     * in any one call. This trades promptness of the cleanup for avoiding long pauses when many
+     * resources have aged out at once.
      */
-    void performDeferredCleanup(std::chrono::milliseconds msNotUsed);
+    void performDeferredCleanup(std::chrono::milliseconds msNotUsed, int maxResourcesToPurge = -1);
 
     // Temporary compatibility API for Android.
     void purgeResourcesNotUsedInMs(std::chrono::milliseconds msNotUsed) {
@@ -96,6 +96,14 @@ struct SK_API GrContextOptions {
      */
     SkExecutor* fExecutor = nullptr;
 
+    /**
+     * If supported by the backend, bracket each executed op chain with GPU timestamp queries
+     * and accumulate a per-op-type GPU time table, readable through
+     * GrContextPriv::gpuOpTypeTimings(). Adds per-chain query overhead, so leave this off
+     * except when profiling.
+     */
+    bool fEnableGpuOpTiming = false;
+
     /** Construct mipmaps manually, via repeated downsampling draw-calls. This is used when
         the driver's implementation (glGenerateMipmap) contains bugs. This requires mipmap
         level and LOD control (ie desktop or ES3). */
@@ -236,6 +244,16 @@ struct SK_API GrContextOptions {
      */
     int fMaxCachedVulkanSecondaryCommandBuffers = -1;
 
+    /**
+     * If true, the Vulkan backend performs queue submission on a dedicated thread that it owns,
+     * so GrDirectContext::submit hands off the recorded command buffer and returns without
+     * waiting on vkQueueSubmit (which takes multiple milliseconds on some drivers). Submissions
+     * that must observe results synchronously (syncCpu, readbacks, signal semaphores) still wait.
+     * Finished procs continue to fire on the client's thread via checkAsyncWorkCompletion or a
+     * later flush.
+     */
+    bool fUseDedicatedVulkanSubmitThread = false;
+
 #if GR_TEST_UTILS
     /**
      * Private options that are only meant for testing within Skia's tools.
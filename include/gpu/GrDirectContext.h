@@ -9,9 +9,20 @@
 #define GrDirectContext_DEFINED
 
 #include "include/gpu/GrContext.h"
+#include "include/private/SkTArray.h"
 
 class GrAtlasManager;
 
+/**
+ * Describes which client-visible backend surfaces the context's recorded-but-unflushed work
+ * will read and write. See GrDirectContext::pendingSurfaceUsage().
+ */
+struct SK_API GrPendingSurfaceUsage {
+    SkTArray<GrBackendTexture>      fTextureReads;
+    SkTArray<GrBackendTexture>      fTextureWrites;
+    SkTArray<GrBackendRenderTarget> fRenderTargetWrites;
+};
+
 class SK_API GrDirectContext : public GrContext {
 public:
 #ifdef SK_GL
@@ -74,6 +85,16 @@ public:
 
     void freeGpuResources() override;
 
+    /**
+     * Reports the backend surfaces that the render tasks recorded so far will read and write
+     * when they are next flushed. Only surfaces Skia has already bound to backend objects are
+     * listed, which covers everything wrapped from or shared with the client; Skia-internal
+     * surfaces that have not been allocated yet are omitted. Combined with the semaphores the
+     * caller passes in GrFlushInfo, this lets an external frame graph run the flush concurrently
+     * with its own passes that touch disjoint resources instead of barriering around every flush.
+     */
+    GrPendingSurfaceUsage pendingSurfaceUsage();
+
 protected:
     GrDirectContext(GrBackendApi backend, const GrContextOptions& options);
 
@@ -71,6 +71,13 @@ struct SK_API GrVkBackendContext {
     // Indicates that we are working with protected content and all CommandPool and Queue operations
     // should be done in a protected context.
     GrProtected                      fProtectedContext = GrProtected::kNo;
+    // Optional dedicated transfer queue. When set, and its family differs from
+    // fGraphicsQueueIndex, texture uploads may be submitted on this queue and handed to the
+    // graphics queue with a semaphore, letting uploads overlap rendering. The queue must be
+    // created on fDevice and support transfer operations. fTransferQueueIndex must match the
+    // family of the given queue.
+    VkQueue                          fTransferQueue = VK_NULL_HANDLE;
+    uint32_t                         fTransferQueueIndex = 0;
 };
 
 #endif
@@ -11,9 +11,35 @@
 #include "include/private/SkTArray.h"
 #include "include/private/SkTDArray.h"
 
+#include <memory>
+
 class SkPath;
 struct SkRect;
 
+/** A reusable scratch context for repeated path operations.
+
+    The pathops engine builds its intermediate contour, segment, and span graphs in a
+    scratch arena that is normally created and torn down inside each call. Passing the same
+    SkOpContext to repeated Op() or Simplify() calls retains the arena's high-water storage
+    between calls, so a steady-state workload of similar operations stops paying the arena's
+    block-growth warm-up on every call.
+
+    An SkOpContext may only be used by one operation at a time.
+*/
+class SK_API SkOpContext {
+public:
+    SkOpContext();
+    ~SkOpContext();
+
+    SkOpContext(const SkOpContext&) = delete;
+    SkOpContext& operator=(const SkOpContext&) = delete;
+
+private:
+    friend class SkOpContextArena;
+    std::unique_ptr<char[]> fStorage;  // grown to the high-water mark of past operations
+    size_t fStorageSize;
+};
+
 
 // FIXME: move everything below into the SkPath class
 /**
@@ -45,6 +71,12 @@ enum SkPathOp {
   */
 bool SK_API Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result);
 
+/** As Op(), above, but draws scratch storage from 'context' and leaves the high-water
+    storage in the context for the next operation. 'context' may be nullptr.
+  */
+bool SK_API Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+               SkOpContext* context);
+
 /** Set this path to a set of non-overlapping contours that describe the
     same area as the original path.
     The curve order is reduced where possible so that cubics may
@@ -59,6 +91,11 @@ bool SK_API Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
   */
 bool SK_API Simplify(const SkPath& path, SkPath* result);
 
+/** As Simplify(), above, but draws scratch storage from 'context' and leaves the high-water
+    storage in the context for the next operation. 'context' may be nullptr.
+  */
+bool SK_API Simplify(const SkPath& path, SkPath* result, SkOpContext* context);
+
 /** Set the resulting rectangle to the tight bounds of the path.
 
     @param path The path measured.
@@ -20,6 +20,116 @@
 #include <new>
 #include <utility>
 
+#if defined(SK_TARRAY_INLINE_STATS)
+#include <atomic>
+#include <cstdlib>
+
+#if defined(_MSC_VER)
+    #define SK_TARRAY_SITE_NAME __FUNCSIG__
+#else
+    #define SK_TARRAY_SITE_NAME __PRETTY_FUNCTION__
+#endif
+
+/**
+ * Opt-in (define SK_TARRAY_INLINE_STATS) accounting of how often SkSTArray instantiation sites
+ * outgrow their inline storage and fall back to the heap. Each SkSTArray<N, T> instantiation
+ * registers one Site; at process exit the sites that overflowed are dumped as a table of
+ * construction count, overflow count, and the largest element count seen - the capacity the site
+ * would have needed to stay inline. Use the report to resize chronically undersized sites.
+ */
+class SkSTArrayInlineStats {
+public:
+    struct Site {
+        Site(const char* name, int inlineCount, size_t elemSize)
+                : fName(name), fInlineCount(inlineCount), fElemSize(elemSize) {
+            Register(this);
+        }
+
+        void recordGrowth(int count, bool leftInlineStorage) {
+            if (leftInlineStorage) {
+                fOverflows.fetch_add(1, std::memory_order_relaxed);
+            }
+            int prev = fMaxCount.load(std::memory_order_relaxed);
+            while (count > prev &&
+                   !fMaxCount.compare_exchange_weak(prev, count, std::memory_order_relaxed)) {}
+        }
+
+        const char* const    fName;
+        const int            fInlineCount;
+        const size_t         fElemSize;
+        std::atomic<int64_t> fConstructions{0};
+        std::atomic<int64_t> fOverflows{0};
+        std::atomic<int>     fMaxCount{0};
+        Site*                fNext = nullptr;
+    };
+
+    /** Prints the report. Registered with atexit(), but may also be called at any time. */
+    static void Dump();
+
+private:
+    static std::atomic<Site*>& Head() {
+        static std::atomic<Site*> gHead{nullptr};
+        return gHead;
+    }
+
+    static void Register(Site* site) {
+        std::atomic<Site*>& head = Head();
+        site->fNext = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(site->fNext, site, std::memory_order_release)) {}
+        static const bool gRegisteredAtExit = [] { ::atexit(Dump); return true; }();
+        (void)gRegisteredAtExit;
+    }
+};
+
+inline void SkSTArrayInlineStats::Dump() {
+    int overflowed = 0;
+    for (Site* s = Head().load(std::memory_order_acquire); s; s = s->fNext) {
+        if (s->fOverflows.load(std::memory_order_relaxed) > 0) {
+            ++overflowed;
+        }
+    }
+    if (0 == overflowed) {
+        SkDebugf("SkSTArray inline stats: no inline-capacity overflows recorded.\n");
+        return;
+    }
+
+    Site** sites = (Site**)sk_malloc_throw(overflowed, sizeof(Site*));
+    int n = 0;
+    for (Site* s = Head().load(std::memory_order_acquire); s; s = s->fNext) {
+        if (s->fOverflows.load(std::memory_order_relaxed) > 0) {
+            sites[n++] = s;
+        }
+    }
+    // Insertion sort, most overflows first; the site count is small.
+    for (int i = 1; i < n; ++i) {
+        Site* site = sites[i];
+        int j = i;
+        while (j > 0 &&
+               sites[j - 1]->fOverflows.load(std::memory_order_relaxed) <
+                       site->fOverflows.load(std::memory_order_relaxed)) {
+            sites[j] = sites[j - 1];
+            --j;
+        }
+        sites[j] = site;
+    }
+
+    SkDebugf("SkSTArray inline-capacity overflows (most frequent first):\n");
+    SkDebugf("%12s %12s %8s %8s %9s  site\n",
+             "constructed", "overflowed", "inline", "elemSz", "maxCount");
+    for (int i = 0; i < n; ++i) {
+        const Site* s = sites[i];
+        SkDebugf("%12lld %12lld %8d %8zu %9d  %s\n",
+                 (long long)s->fConstructions.load(std::memory_order_relaxed),
+                 (long long)s->fOverflows.load(std::memory_order_relaxed),
+                 s->fInlineCount,
+                 s->fElemSize,
+                 s->fMaxCount.load(std::memory_order_relaxed),
+                 s->fName);
+    }
+    sk_free(sites);
+}
+#endif  // SK_TARRAY_INLINE_STATS
+
 /** SkTArray<T> implements a typical, mostly std::vector-like array.
     Each T will be default-initialized on allocation, and ~T will be called on destruction.
 
@@ -464,6 +574,21 @@ protected:
         this->copy(array);
     }
 
+#if defined(SK_TARRAY_INLINE_STATS)
+    /**
+     * Called by SkSTArray to attribute this array's inline-capacity overflows to its
+     * instantiation site. An array that already outgrew the preallocated block during
+     * construction counts as overflowed immediately.
+     */
+    void attachStatsSite(SkSTArrayInlineStats::Site* site) {
+        fStatsSite = site;
+        site->fConstructions.fetch_add(1, std::memory_order_relaxed);
+        if (fCount > 0) {
+            site->recordGrowth(fCount, /*leftInlineStorage=*/fOwnMemory);
+        }
+    }
+#endif
+
 private:
     void init(int count = 0, int reserveCount = 0) {
         SkASSERT(count >= 0);
@@ -559,6 +684,11 @@ private:
             return;
         }
 
+#if defined(SK_TARRAY_INLINE_STATS)
+        if (mustGrow && fStatsSite) {
+            fStatsSite->recordGrowth(Sk64_pin_to_s32(newCount), /*leftInlineStorage=*/!fOwnMemory);
+        }
+#endif
 
         // Whether we're growing or shrinking, we leave at least 50% extra space for future growth.
         int64_t newAllocCount = newCount + ((newCount + 1) >> 1);
@@ -588,6 +718,9 @@ private:
     int fAllocCount;
     bool fOwnMemory : 1;
     bool fReserved : 1;
+#if defined(SK_TARRAY_INLINE_STATS)
+    SkSTArrayInlineStats::Site* fStatsSite = nullptr;
+#endif
 };
 
 template <typename T, bool M> static inline void swap(SkTArray<T, M>& a, SkTArray<T, M>& b) {
@@ -606,30 +739,37 @@ private:
 
 public:
     SkSTArray() : INHERITED(&fStorage) {
+        this->initInlineStats();
     }
 
     SkSTArray(const SkSTArray& array)
         : INHERITED(array, &fStorage) {
+        this->initInlineStats();
     }
 
     SkSTArray(SkSTArray&& array)
         : INHERITED(std::move(array), &fStorage) {
+        this->initInlineStats();
     }
 
     explicit SkSTArray(const INHERITED& array)
         : INHERITED(array, &fStorage) {
+        this->initInlineStats();
     }
 
     explicit SkSTArray(INHERITED&& array)
         : INHERITED(std::move(array), &fStorage) {
+        this->initInlineStats();
     }
 
     explicit SkSTArray(int reserveCount)
         : INHERITED(reserveCount) {
+        this->initInlineStats();
     }
 
     SkSTArray(const T* array, int count)
         : INHERITED(array, count, &fStorage) {
+        this->initInlineStats();
     }
 
     SkSTArray& operator=(const SkSTArray& array) {
@@ -653,6 +793,18 @@ public:
     }
 
 private:
+#if defined(SK_TARRAY_INLINE_STATS)
+    static SkSTArrayInlineStats::Site* StatsSite() {
+        // The function signature embeds <N, T, MEM_MOVE>, uniquely naming this instantiation
+        // in the dump.
+        static SkSTArrayInlineStats::Site gSite{SK_TARRAY_SITE_NAME, N, sizeof(T)};
+        return &gSite;
+    }
+    void initInlineStats() { this->attachStatsSite(StatsSite()); }
+#else
+    void initInlineStats() {}
+#endif
+
     SkAlignedSTStorage<N,T> fStorage;
 };
 
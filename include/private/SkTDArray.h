@@ -167,6 +167,15 @@ public:
         SkASSERT_RELEASE(SkTFitsIn<int>(n));
         this->setReserve(SkToInt(n));
     }
+    // As setReserve(), but without the growth slack resizeStorageToAtLeast() adds; for
+    // callers that know the final size up front.
+    void setReserveExact(int reserve) {
+        SkASSERT(reserve >= 0);
+        if (reserve > fReserve) {
+            fReserve = reserve;
+            fArray = (T*)sk_realloc_throw(fArray, (size_t)fReserve * sizeof(T));
+        }
+    }
 
     T* prepend() {
         this->adjustCount(1);
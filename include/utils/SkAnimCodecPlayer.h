@@ -9,8 +9,12 @@
 #define SkAnimCodecPlayer_DEFINED
 
 #include "include/codec/SkCodec.h"
+#include "include/private/SkMutex.h"
+
+#include <atomic>
 
 class SkImage;
+class SkTaskGroup;
 
 class SkAnimCodecPlayer {
 public:
@@ -46,14 +50,33 @@ public:
 
 
 private:
+    // Upper bound on the number of composited frames kept alive at once. Frames that fall
+    // out of the cache are recomposited on demand from the nearest cached frame in their
+    // dependency chain, so stepping forward (and short hops backward) stays cheap without
+    // pinning every frame of a long animation in memory.
+    static constexpr int kMaxCachedFrames = 4;
+
     std::unique_ptr<SkCodec>        fCodec;
     SkImageInfo                     fImageInfo;
     std::vector<SkCodec::FrameInfo> fFrameInfos;
     std::vector<sk_sp<SkImage> >    fImages;
+    std::vector<uint32_t>           fLastUse;   // parallels fImages; LRU stamps for eviction
+    uint32_t                        fUseCounter = 0;
+    int                             fCachedCount = 0;
     int                             fCurrIndex = 0;
     uint32_t                        fTotalDuration;
 
+    // The codec and the frame cache are shared with the prefetch task, which composites the
+    // next frame while the current one is on screen. Tasks run on SkExecutor::GetDefault().
+    SkMutex                         fMutex;
+    std::atomic<bool>               fPrefetchInFlight{false};
+    std::unique_ptr<SkTaskGroup>    fPrefetchGroup;
+
+    // These two require fMutex to be held.
     sk_sp<SkImage> getFrameAt(int index);
+    void cacheFrameAt(int index, sk_sp<SkImage>);
+
+    void prefetchFrameAfter(int index);
 };
 
 #endif
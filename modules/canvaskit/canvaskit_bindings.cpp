@@ -557,6 +557,130 @@ SkPath MakePathFromVerbsPointsWeights(uintptr_t /* uint8_t* */ verbsPtr, int num
     return path;
 }
 
+//========================================================================================
+// Replaying batched canvas commands
+//========================================================================================
+
+// Op codes for the JS-side CommandRecorder (see interface.js).  Commands are packed into a
+// Float32Array in wasm memory, and an entire batch is replayed here with a single boundary
+// crossing, instead of one Emscripten call per draw.
+static const int CMD_SAVE        = 0;
+static const int CMD_RESTORE     = 1;
+static const int CMD_CONCAT      = 2;  // 9 scalars (row-major 3x3)
+static const int CMD_TRANSLATE   = 3;  // dx, dy
+static const int CMD_SCALE       = 4;  // sx, sy
+static const int CMD_CLIP_RECT   = 5;  // l, t, r, b, doAA
+static const int CMD_DRAW_RECT   = 6;  // l, t, r, b, paint
+static const int CMD_DRAW_OVAL   = 7;  // l, t, r, b, paint
+static const int CMD_DRAW_RRECT  = 8;  // l, t, r, b, rx, ry, paint
+static const int CMD_DRAW_CIRCLE = 9;  // cx, cy, radius, paint
+static const int CMD_DRAW_LINE   = 10; // x0, y0, x1, y1, paint
+static const int CMD_DRAW_PAINT  = 11; // paint
+
+// Draw ops trail a 6-scalar inline paint block: r, g, b, a, flags, strokeWidth.
+// flags bit 0 is anti-alias, bits 1-2 are the SkPaint::Style.
+static const int CMD_PAINT_WORDS = 6;
+
+static SkPaint decode_cmd_paint(const float* p) {
+    SkPaint paint;
+    paint.setColor4f({p[0], p[1], p[2], p[3]});
+    const int flags = sk_float_floor2int(p[4]);
+    paint.setAntiAlias(flags & 1);
+    const int style = (flags >> 1) & 3;
+    paint.setStyle(style <= SkPaint::kStrokeAndFill_Style ? static_cast<SkPaint::Style>(style)
+                                                          : SkPaint::kFill_Style);
+    paint.setStrokeWidth(p[5]);
+    return paint;
+}
+
+void DrawCommandBuffer(SkCanvas& canvas, uintptr_t /* float* */ cptr, int numWords) {
+    const auto* cmds = reinterpret_cast<const float*>(cptr);
+
+    // if there are not enough arguments, bail with whatever has been replayed so far.
+    #define CHECK_NUM_ARGS(n) \
+        if ((i + n) > numWords) { \
+            SkDebugf("Truncated command buffer. Saw %d words\n", numWords); \
+            return; \
+        }
+
+    for (int i = 0; i < numWords;) {
+        switch (sk_float_floor2int(cmds[i++])) {
+            case CMD_SAVE:
+                canvas.save();
+                break;
+            case CMD_RESTORE:
+                canvas.restore();
+                break;
+            case CMD_CONCAT: {
+                CHECK_NUM_ARGS(9);
+                SkMatrix m;
+                m.set9(cmds + i);
+                i += 9;
+                canvas.concat(m);
+                break;
+            }
+            case CMD_TRANSLATE:
+                CHECK_NUM_ARGS(2);
+                canvas.translate(cmds[i], cmds[i+1]);
+                i += 2;
+                break;
+            case CMD_SCALE:
+                CHECK_NUM_ARGS(2);
+                canvas.scale(cmds[i], cmds[i+1]);
+                i += 2;
+                break;
+            case CMD_CLIP_RECT:
+                CHECK_NUM_ARGS(5);
+                canvas.clipRect(SkRect::MakeLTRB(cmds[i], cmds[i+1], cmds[i+2], cmds[i+3]),
+                                SkClipOp::kIntersect, cmds[i+4] != 0);
+                i += 5;
+                break;
+            case CMD_DRAW_RECT:
+                CHECK_NUM_ARGS(4 + CMD_PAINT_WORDS);
+                canvas.drawRect(SkRect::MakeLTRB(cmds[i], cmds[i+1], cmds[i+2], cmds[i+3]),
+                                decode_cmd_paint(cmds + i + 4));
+                i += 4 + CMD_PAINT_WORDS;
+                break;
+            case CMD_DRAW_OVAL:
+                CHECK_NUM_ARGS(4 + CMD_PAINT_WORDS);
+                canvas.drawOval(SkRect::MakeLTRB(cmds[i], cmds[i+1], cmds[i+2], cmds[i+3]),
+                                decode_cmd_paint(cmds + i + 4));
+                i += 4 + CMD_PAINT_WORDS;
+                break;
+            case CMD_DRAW_RRECT:
+                CHECK_NUM_ARGS(6 + CMD_PAINT_WORDS);
+                canvas.drawRRect(SkRRect::MakeRectXY(
+                                         SkRect::MakeLTRB(cmds[i], cmds[i+1], cmds[i+2], cmds[i+3]),
+                                         cmds[i+4], cmds[i+5]),
+                                 decode_cmd_paint(cmds + i + 6));
+                i += 6 + CMD_PAINT_WORDS;
+                break;
+            case CMD_DRAW_CIRCLE:
+                CHECK_NUM_ARGS(3 + CMD_PAINT_WORDS);
+                canvas.drawCircle(cmds[i], cmds[i+1], cmds[i+2],
+                                  decode_cmd_paint(cmds + i + 3));
+                i += 3 + CMD_PAINT_WORDS;
+                break;
+            case CMD_DRAW_LINE:
+                CHECK_NUM_ARGS(4 + CMD_PAINT_WORDS);
+                canvas.drawLine(cmds[i], cmds[i+1], cmds[i+2], cmds[i+3],
+                                decode_cmd_paint(cmds + i + 4));
+                i += 4 + CMD_PAINT_WORDS;
+                break;
+            case CMD_DRAW_PAINT:
+                CHECK_NUM_ARGS(CMD_PAINT_WORDS);
+                canvas.drawPaint(decode_cmd_paint(cmds + i));
+                i += CMD_PAINT_WORDS;
+                break;
+            default:
+                SkDebugf("  canvas: UNKNOWN command %f, aborting replay...\n", cmds[i-1]);
+                return;
+        }
+    }
+
+    #undef CHECK_NUM_ARGS
+}
+
 //========================================================================================
 // Path Effects
 //========================================================================================
@@ -1041,6 +1165,11 @@ EMSCRIPTEN_BINDINGS(Skia) {
         .function("drawColorInt", optional_override([](SkCanvas& self, SkColor color, SkBlendMode mode) {
             self.drawColor(color, mode);
         }))
+        .function("_drawCommandBuffer", optional_override([](SkCanvas& self,
+                                                             uintptr_t /* float* */ cptr,
+                                                             int numWords) {
+            DrawCommandBuffer(self, cptr, numWords);
+        }))
         .function("drawDRRect",optional_override([](SkCanvas& self, const SimpleRRect& o, const SimpleRRect& i, const SkPaint& paint) {
             self.drawDRRect(toRRect(o), toRRect(i), paint);
         }))
@@ -33,6 +33,7 @@ var CanvasKit = {
   XYWHRect: function() {},
   /** @return {CanvasKit.SkRRect} */
   RRectXY: function() {},
+  CommandRecorder: function() {},
   /** @return {ImageData} */
   ImageData: function() {},
 
@@ -225,6 +226,7 @@ var CanvasKit = {
       clear: function() {},
       drawColor: function() {},
       drawColorComponents: function() {},
+      drawCommandBuffer: function() {},
       drawShadow: function() {},
     },
 
@@ -233,6 +235,7 @@ var CanvasKit = {
     _concat: function() {},
     _drawAtlas: function() {},
     _drawColor: function() {},
+    _drawCommandBuffer: function() {},
     _drawPoints: function() {},
     _drawShadow: function() {},
     _drawSimpleText: function() {},
@@ -949,6 +952,21 @@ CanvasKit.SkFontMgr.prototype.MakeTypefaceFromData = function() {};
 
 CanvasKit.SkFont.prototype.getWidths = function() {};
 
+CanvasKit.CommandRecorder.prototype.save = function() {};
+CanvasKit.CommandRecorder.prototype.restore = function() {};
+CanvasKit.CommandRecorder.prototype.concat = function() {};
+CanvasKit.CommandRecorder.prototype.translate = function() {};
+CanvasKit.CommandRecorder.prototype.scale = function() {};
+CanvasKit.CommandRecorder.prototype.clipRect = function() {};
+CanvasKit.CommandRecorder.prototype.drawRect = function() {};
+CanvasKit.CommandRecorder.prototype.drawOval = function() {};
+CanvasKit.CommandRecorder.prototype.drawRRect = function() {};
+CanvasKit.CommandRecorder.prototype.drawCircle = function() {};
+CanvasKit.CommandRecorder.prototype.drawLine = function() {};
+CanvasKit.CommandRecorder.prototype.drawPaint = function() {};
+CanvasKit.CommandRecorder.prototype.reset = function() {};
+CanvasKit.CommandRecorder.prototype.delete = function() {};
+
 CanvasKit.RSXFormBuilder.prototype.build = function() {};
 CanvasKit.RSXFormBuilder.prototype.delete = function() {};
 CanvasKit.RSXFormBuilder.prototype.push = function() {};
@@ -994,6 +994,13 @@ CanvasKit.onRuntimeInitialized = function() {
   // Deprecated - just use concat
   CanvasKit.SkCanvas.prototype.concat44 = CanvasKit.SkCanvas.prototype.concat;
 
+  // Replays a batch of commands recorded with CanvasKit.CommandRecorder using a single
+  // call across the JS/WASM boundary. The recorder's contents are not consumed - call
+  // recorder.reset() to start a new batch.
+  CanvasKit.SkCanvas.prototype.drawCommandBuffer = function(recorder) {
+    this._drawCommandBuffer(recorder._mObj['byteOffset'], recorder._used);
+  }
+
   // atlas is an SkImage, e.g. from CanvasKit.MakeImageFromEncoded
   // srcRects, dstXforms, and colors should be CanvasKit.SkRectBuilder, CanvasKit.RSXFormBuilder,
   // and CanvasKit.SkColorBuilder (fastest)
@@ -1431,6 +1438,194 @@ CanvasKit.XYWHRect = function(x, y, w, h) {
   };
 };
 
+// Command op codes and paint layout for CommandRecorder.
+// Keep in sync with DrawCommandBuffer in canvaskit_bindings.cpp.
+var CMD_SAVE        = 0;
+var CMD_RESTORE     = 1;
+var CMD_CONCAT      = 2;
+var CMD_TRANSLATE   = 3;
+var CMD_SCALE       = 4;
+var CMD_CLIP_RECT   = 5;
+var CMD_DRAW_RECT   = 6;
+var CMD_DRAW_OVAL   = 7;
+var CMD_DRAW_RRECT  = 8;
+var CMD_DRAW_CIRCLE = 9;
+var CMD_DRAW_LINE   = 10;
+var CMD_DRAW_PAINT  = 11;
+
+var CMD_PAINT_WORDS = 6;
+
+/**
+ * CommandRecorder batches simple canvas commands into a compact Float32Array held in
+ * wasm memory, so an entire frame's worth of draws can be submitted to
+ * SkCanvas.drawCommandBuffer with one JS/WASM boundary crossing instead of one per call.
+ *
+ * Draw calls take a plain paint descriptor object with optional fields:
+ *   color       - a CanvasKit color (default opaque black)
+ *   style       - a CanvasKit.PaintStyle (default Fill)
+ *   strokeWidth - stroke width in local coordinates (default 0, i.e. hairline)
+ *   antiAlias   - boolean (default false)
+ *
+ * The recorder owns wasm memory; call delete() when it is no longer needed.
+ *
+ * @param {number=} opt_capacityWords - initial buffer capacity, in 32-bit words.
+ */
+CanvasKit.CommandRecorder = function(opt_capacityWords) {
+  this._capacity = opt_capacityWords || 1024;
+  this._mObj = CanvasKit.Malloc(Float32Array, this._capacity);
+  this._used = 0;
+};
+
+CanvasKit.CommandRecorder.prototype._reserve = function(words) {
+  if (this._used + words <= this._capacity) {
+    return;
+  }
+  var newCapacity = this._capacity * 2;
+  while (newCapacity < this._used + words) {
+    newCapacity *= 2;
+  }
+  var newObj = CanvasKit.Malloc(Float32Array, newCapacity);
+  newObj.toTypedArray().set(this._mObj.toTypedArray().subarray(0, this._used));
+  CanvasKit.Free(this._mObj);
+  this._mObj = newObj;
+  this._capacity = newCapacity;
+};
+
+CanvasKit.CommandRecorder.prototype._writePaint = function(paint) {
+  var ta = this._mObj.toTypedArray();
+  var color = (paint && paint['color']) || null;
+  if (color) {
+    ta[this._used++] = color[0];
+    ta[this._used++] = color[1];
+    ta[this._used++] = color[2];
+    ta[this._used++] = color[3];
+  } else {
+    ta[this._used++] = 0;
+    ta[this._used++] = 0;
+    ta[this._used++] = 0;
+    ta[this._used++] = 1;
+  }
+  var style = (paint && paint['style']) ? paint['style']['value'] : 0;
+  var aa = (paint && paint['antiAlias']) ? 1 : 0;
+  ta[this._used++] = aa | (style << 1);
+  ta[this._used++] = (paint && paint['strokeWidth']) || 0;
+};
+
+CanvasKit.CommandRecorder.prototype._writeRect = function(rect) {
+  var ta = this._mObj.toTypedArray();
+  ta[this._used++] = rect.fLeft;
+  ta[this._used++] = rect.fTop;
+  ta[this._used++] = rect.fRight;
+  ta[this._used++] = rect.fBottom;
+};
+
+CanvasKit.CommandRecorder.prototype.save = function() {
+  this._reserve(1);
+  this._mObj.toTypedArray()[this._used++] = CMD_SAVE;
+};
+
+CanvasKit.CommandRecorder.prototype.restore = function() {
+  this._reserve(1);
+  this._mObj.toTypedArray()[this._used++] = CMD_RESTORE;
+};
+
+// matr is a 9-element array (row-major 3x3).
+CanvasKit.CommandRecorder.prototype.concat = function(matr) {
+  this._reserve(10);
+  var ta = this._mObj.toTypedArray();
+  ta[this._used++] = CMD_CONCAT;
+  for (var i = 0; i < 9; i++) {
+    ta[this._used++] = matr[i];
+  }
+};
+
+CanvasKit.CommandRecorder.prototype.translate = function(dx, dy) {
+  this._reserve(3);
+  var ta = this._mObj.toTypedArray();
+  ta[this._used++] = CMD_TRANSLATE;
+  ta[this._used++] = dx;
+  ta[this._used++] = dy;
+};
+
+CanvasKit.CommandRecorder.prototype.scale = function(sx, sy) {
+  this._reserve(3);
+  var ta = this._mObj.toTypedArray();
+  ta[this._used++] = CMD_SCALE;
+  ta[this._used++] = sx;
+  ta[this._used++] = sy;
+};
+
+CanvasKit.CommandRecorder.prototype.clipRect = function(rect, doAntiAlias) {
+  this._reserve(6);
+  this._mObj.toTypedArray()[this._used++] = CMD_CLIP_RECT;
+  this._writeRect(rect);
+  this._mObj.toTypedArray()[this._used++] = doAntiAlias ? 1 : 0;
+};
+
+CanvasKit.CommandRecorder.prototype.drawRect = function(rect, paint) {
+  this._reserve(5 + CMD_PAINT_WORDS);
+  this._mObj.toTypedArray()[this._used++] = CMD_DRAW_RECT;
+  this._writeRect(rect);
+  this._writePaint(paint);
+};
+
+CanvasKit.CommandRecorder.prototype.drawOval = function(rect, paint) {
+  this._reserve(5 + CMD_PAINT_WORDS);
+  this._mObj.toTypedArray()[this._used++] = CMD_DRAW_OVAL;
+  this._writeRect(rect);
+  this._writePaint(paint);
+};
+
+CanvasKit.CommandRecorder.prototype.drawRRect = function(rect, rx, ry, paint) {
+  this._reserve(7 + CMD_PAINT_WORDS);
+  this._mObj.toTypedArray()[this._used++] = CMD_DRAW_RRECT;
+  this._writeRect(rect);
+  var ta = this._mObj.toTypedArray();
+  ta[this._used++] = rx;
+  ta[this._used++] = ry;
+  this._writePaint(paint);
+};
+
+CanvasKit.CommandRecorder.prototype.drawCircle = function(cx, cy, radius, paint) {
+  this._reserve(4 + CMD_PAINT_WORDS);
+  var ta = this._mObj.toTypedArray();
+  ta[this._used++] = CMD_DRAW_CIRCLE;
+  ta[this._used++] = cx;
+  ta[this._used++] = cy;
+  ta[this._used++] = radius;
+  this._writePaint(paint);
+};
+
+CanvasKit.CommandRecorder.prototype.drawLine = function(x0, y0, x1, y1, paint) {
+  this._reserve(5 + CMD_PAINT_WORDS);
+  var ta = this._mObj.toTypedArray();
+  ta[this._used++] = CMD_DRAW_LINE;
+  ta[this._used++] = x0;
+  ta[this._used++] = y0;
+  ta[this._used++] = x1;
+  ta[this._used++] = y1;
+  this._writePaint(paint);
+};
+
+CanvasKit.CommandRecorder.prototype.drawPaint = function(paint) {
+  this._reserve(1 + CMD_PAINT_WORDS);
+  this._mObj.toTypedArray()[this._used++] = CMD_DRAW_PAINT;
+  this._writePaint(paint);
+};
+
+// Clears the recorded commands (keeping the allocated buffer) for the next batch.
+CanvasKit.CommandRecorder.prototype.reset = function() {
+  this._used = 0;
+};
+
+// Releases the wasm memory backing this recorder.
+CanvasKit.CommandRecorder.prototype.delete = function() {
+  CanvasKit.Free(this._mObj);
+  this._mObj = null;
+  this._capacity = 0;
+  this._used = 0;
+};
+
 // RRectXY returns an RRect with the given rect and a radiusX and radiusY for
 // all 4 corners.
 CanvasKit.RRectXY = function(rect, rx, ry) {
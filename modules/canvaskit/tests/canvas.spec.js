@@ -137,6 +137,68 @@ describe('Canvas Behavior', () => {
         paint.delete();
     });
 
+    gm('command_buffer_canvas', (canvas) => {
+        canvas.clear(CanvasKit.WHITE);
+
+        const recorder = new CanvasKit.CommandRecorder();
+        recorder.drawRect(CanvasKit.LTRBRect(5, 5, 80, 60),
+                          {color: CanvasKit.RED});
+        recorder.drawCircle(130, 80, 40,
+                            {color: CanvasKit.CYAN, antiAlias: true});
+        recorder.drawLine(10, 100, 150, 120,
+                          {color: CanvasKit.BLACK,
+                           style: CanvasKit.PaintStyle.Stroke,
+                           strokeWidth: 4,
+                           antiAlias: true});
+        recorder.save();
+        recorder.translate(0, 150);
+        recorder.scale(2, 2);
+        recorder.clipRect(CanvasKit.LTRBRect(0, 0, 70, 70), true);
+        recorder.drawOval(CanvasKit.LTRBRect(5, 5, 95, 60),
+                          {color: CanvasKit.BLUE});
+        recorder.restore();
+        recorder.drawRRect(CanvasKit.LTRBRect(160, 5, 290, 120), 15, 10,
+                           {color: CanvasKit.MAGENTA, antiAlias: true});
+
+        canvas.drawCommandBuffer(recorder);
+        recorder.delete();
+    });
+
+    it('replays a command buffer identically to individual draw calls', () => {
+        const recorded = new CanvasKit.SkPictureRecorder();
+        let canvas = recorded.beginRecording(CanvasKit.LTRBRect(0, 0, 100, 100));
+        const recorder = new CanvasKit.CommandRecorder(8); // small, to exercise growth
+        recorder.drawRect(CanvasKit.LTRBRect(5, 5, 80, 60), {color: CanvasKit.RED});
+        recorder.drawCircle(50, 50, 20, {color: CanvasKit.BLUE, antiAlias: true});
+        canvas.drawCommandBuffer(recorder);
+        recorder.delete();
+        const cmdPic = recorded.finishRecordingAsPicture();
+
+        const direct = new CanvasKit.SkPictureRecorder();
+        canvas = direct.beginRecording(CanvasKit.LTRBRect(0, 0, 100, 100));
+        const paint = new CanvasKit.SkPaint();
+        paint.setColor(CanvasKit.RED);
+        canvas.drawRect(CanvasKit.LTRBRect(5, 5, 80, 60), paint);
+        paint.setColor(CanvasKit.BLUE);
+        paint.setAntiAlias(true);
+        canvas.drawCircle(50, 50, 20, paint);
+        paint.delete();
+        const directPic = direct.finishRecordingAsPicture();
+
+        // Compare the serialized pictures - both streams should contain the same ops.
+        const cmdData = cmdPic.serialize();
+        const directData = directPic.serialize();
+        expect(CanvasKit.getSkDataBytes(cmdData).length)
+            .toEqual(CanvasKit.getSkDataBytes(directData).length);
+        cmdData.delete();
+        directData.delete();
+
+        cmdPic.delete();
+        directPic.delete();
+        recorded.delete();
+        direct.delete();
+    });
+
     gm('rrect_canvas', (canvas) => {
         const path = starPath(CanvasKit);
 
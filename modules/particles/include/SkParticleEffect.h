@@ -19,6 +19,7 @@
 #include <memory>
 
 class SkCanvas;
+class SkExecutor;
 class SkFieldVisitor;
 class SkParticleBinding;
 class SkParticleDrawable;
@@ -190,6 +191,12 @@ public:
     void setFrame   (float     f) { fState.fFrame    = f; }
     void setFlags   (uint32_t  f) { fState.fFlags    = f; }
 
+    // Optional executor for chunking per-particle script evaluation and integration across
+    // threads.  Only kicks in for large particle counts, and only when the particle scripts
+    // don't use external bindings (those may mutate shared effect state).  The executor must
+    // outlive this effect.
+    void setExecutor(SkExecutor* executor) { fExecutor = executor; }
+
     const SkSL::ByteCode* effectCode() const { return fParams->fEffectProgram.fByteCode.get(); }
     const SkSL::ByteCode* particleCode() const { return fParams->fParticleProgram.fByteCode.get(); }
 
@@ -212,6 +219,8 @@ private:
 
     sk_sp<SkParticleEffectParams>        fParams;
 
+    SkExecutor* fExecutor = nullptr;
+
     bool   fLooping;
     int    fCount;
     double fLastTime;
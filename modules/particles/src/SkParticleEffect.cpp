@@ -12,9 +12,15 @@
 #include "modules/particles/include/SkParticleDrawable.h"
 #include "modules/particles/include/SkReflected.h"
 #include "modules/skresources/include/SkResources.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/sksl/SkSLByteCode.h"
 #include "src/sksl/SkSLCompiler.h"
 
+// Minimum per-thread slice when chunking particle work across an executor.  Small enough to
+// balance load, large enough to amortize scheduling overhead (and keep the striped interpreter's
+// SIMD lanes full).
+static constexpr int kParallelChunk = 2048;
+
 static inline float bits_to_float(uint32_t u) {
     float f;
     memcpy(&f, &u, sizeof(uint32_t));
@@ -264,18 +270,40 @@ void SkParticleEffect::processParticleSpawnRequests(double now, int start) {
 void SkParticleEffect::runParticleScript(double now, const char* entry, int start, int count) {
     if (const auto& byteCode = fParams->fParticleProgram.fByteCode) {
         if (auto fun = byteCode->getFunction(entry)) {
-            float* args[SkParticles::kNumChannels];
-            for (int i = 0; i < SkParticles::kNumChannels; ++i) {
-                args[i] = fParticles.fData[i].get() + start;
-            }
             for (const auto& value : fParams->fParticleProgram.fExternalValues) {
                 value->setEffect(this);
             }
             memcpy(&fParticleUniforms[1], &fState.fAge, sizeof(EffectState));
-            SkAssertResult(byteCode->runStriped(fun, count, args, SkParticles::kNumChannels,
-                                                nullptr, 0,
-                                                fParticleUniforms.data(),
-                                                fParticleUniforms.count()));
+
+            auto runRange = [&](int rangeStart, int rangeCount) {
+                float* args[SkParticles::kNumChannels];
+                for (int i = 0; i < SkParticles::kNumChannels; ++i) {
+                    args[i] = fParticles.fData[i].get() + rangeStart;
+                }
+                SkAssertResult(byteCode->runStriped(fun, rangeCount, args,
+                                                    SkParticles::kNumChannels,
+                                                    nullptr, 0,
+                                                    fParticleUniforms.data(),
+                                                    fParticleUniforms.count()));
+            };
+
+            // External values can mutate shared effect state (eg spawn requests), so scripts
+            // using them must run serially.  Self-contained scripts can be chunked across the
+            // executor -- each chunk gets disjoint particle lanes and its own interpreter stack.
+            if (fExecutor && count >= 2 * kParallelChunk &&
+                fParams->fParticleProgram.fExternalValues.empty()) {
+                SkTaskGroup tasks(*fExecutor);
+                for (int chunkStart = start; chunkStart < start + count;
+                     chunkStart += kParallelChunk) {
+                    const int chunkCount = std::min(kParallelChunk, start + count - chunkStart);
+                    tasks.add([&runRange, chunkStart, chunkCount]() {
+                        runRange(chunkStart, chunkCount);
+                    });
+                }
+                tasks.wait();
+            } else {
+                runRange(start, count);
+            }
             this->processParticleSpawnRequests(now, start);
         }
     }
@@ -424,19 +452,34 @@ void SkParticleEffect::advanceTime(double now) {
     this->runParticleScript(now, "update", 0, fCount);
 
     // Do fixed-function update work (integration of position and orientation)
-    for (int i = 0; i < fCount; ++i) {
-        fParticles.fData[SkParticles::kPositionX][i] +=
-                fParticles.fData[SkParticles::kVelocityX][i] * deltaTime;
-        fParticles.fData[SkParticles::kPositionY][i] +=
-                fParticles.fData[SkParticles::kVelocityY][i] * deltaTime;
-
-        float spin = fParticles.fData[SkParticles::kVelocityAngular][i];
-        float s = sk_float_sin(spin * deltaTime),
-              c = sk_float_cos(spin * deltaTime);
-        float oldHeadingX = fParticles.fData[SkParticles::kHeadingX][i],
-              oldHeadingY = fParticles.fData[SkParticles::kHeadingY][i];
-        fParticles.fData[SkParticles::kHeadingX][i] = oldHeadingX * c - oldHeadingY * s;
-        fParticles.fData[SkParticles::kHeadingY][i] = oldHeadingX * s + oldHeadingY * c;
+    auto integrate = [this, deltaTime](int rangeStart, int rangeCount) {
+        for (int i = rangeStart; i < rangeStart + rangeCount; ++i) {
+            fParticles.fData[SkParticles::kPositionX][i] +=
+                    fParticles.fData[SkParticles::kVelocityX][i] * deltaTime;
+            fParticles.fData[SkParticles::kPositionY][i] +=
+                    fParticles.fData[SkParticles::kVelocityY][i] * deltaTime;
+
+            float spin = fParticles.fData[SkParticles::kVelocityAngular][i];
+            float s = sk_float_sin(spin * deltaTime),
+                  c = sk_float_cos(spin * deltaTime);
+            float oldHeadingX = fParticles.fData[SkParticles::kHeadingX][i],
+                  oldHeadingY = fParticles.fData[SkParticles::kHeadingY][i];
+            fParticles.fData[SkParticles::kHeadingX][i] = oldHeadingX * c - oldHeadingY * s;
+            fParticles.fData[SkParticles::kHeadingY][i] = oldHeadingX * s + oldHeadingY * c;
+        }
+    };
+
+    if (fExecutor && fCount >= 2 * kParallelChunk) {
+        SkTaskGroup tasks(*fExecutor);
+        for (int chunkStart = 0; chunkStart < fCount; chunkStart += kParallelChunk) {
+            const int chunkCount = std::min(kParallelChunk, fCount - chunkStart);
+            tasks.add([&integrate, chunkStart, chunkCount]() {
+                integrate(chunkStart, chunkCount);
+            });
+        }
+        tasks.wait();
+    } else {
+        integrate(0, fCount);
     }
 }
 
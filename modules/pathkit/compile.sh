@@ -40,6 +40,8 @@ if [[ $@ == *help* ]]; then
   echo "  test = Make a build suitable for running tests or profiling"
   echo "  debug = Make a build suitable for debugging (defines SK_DEBUG)"
   echo "  asm.js = Build for asm.js instead of WASM (very experimental)"
+  echo "  simd = Build with wasm simd128 instructions (requires a browser"
+  echo "         with SIMD support)"
   echo "  serve = starts a webserver allowing a user to navigate to"
   echo "          localhost:8000/pathkit.html to view the demo page."
   exit 0
@@ -63,6 +65,14 @@ elif [[ $@ == *debug* ]]; then
   RELEASE_CONF="-O0 --js-opts 0 -s SAFE_HEAP=1 -s ASSERTIONS=1 -g3 -DPATHKIT_TESTING -DSK_DEBUG"
 fi
 
+if [[ $@ == *simd* ]]; then
+  echo "Building with SIMD operations"
+  # The simd128 flag applies both to the pathops library build (where the hot
+  # pathops kernels vectorize via skvx) and to the bindings.
+  RELEASE_CONF+=" -msimd128"
+  EXTRA_CFLAGS+=", \"-msimd128\""
+fi
+
 WASM_CONF="-s WASM=1"
 if [[ $@ == *asm.js* ]]; then
   echo "Building with asm.js instead of WASM"
@@ -230,17 +230,25 @@ SkPathOrNull EMSCRIPTEN_KEEPALIVE FromSVGString(std::string str) {
 // PATHOP things
 //========================================================================================
 
+// WASM runs single-threaded, so all operations can share one scratch context,
+// pooling the pathops arena storage across calls.  This matters for clients
+// issuing many operations in rapid succession (e.g. interactive editors).
+static SkOpContext* op_context() {
+    static SkOpContext gCtx;
+    return &gCtx;
+}
+
 bool EMSCRIPTEN_KEEPALIVE ApplySimplify(SkPath& path) {
-    return Simplify(path, &path);
+    return Simplify(path, &path, op_context());
 }
 
 bool EMSCRIPTEN_KEEPALIVE ApplyPathOp(SkPath& pathOne, const SkPath& pathTwo, SkPathOp op) {
-    return Op(pathOne, pathTwo, op, &pathOne);
+    return Op(pathOne, pathTwo, op, &pathOne, op_context());
 }
 
 SkPathOrNull EMSCRIPTEN_KEEPALIVE MakeFromOp(const SkPath& pathOne, const SkPath& pathTwo, SkPathOp op) {
     SkPath out;
-    if (Op(pathOne, pathTwo, op, &out)) {
+    if (Op(pathOne, pathTwo, op, &out, op_context())) {
         return emscripten::val(out);
     }
     return emscripten::val::null();
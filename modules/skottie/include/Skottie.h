@@ -21,6 +21,7 @@
 #include <vector>
 
 class SkCanvas;
+class SkData;
 struct SkRect;
 class SkStream;
 
@@ -62,6 +63,35 @@ public:
     virtual void onMarker(const char name[], float t0, float t1) = 0;
 };
 
+/**
+ * A shared typeface resolution cache.
+ *
+ * Each Animation normally resolves native typefaces through its font manager, and holds the
+ * results privately.  Clients instantiating many animations which reference the same fonts
+ * can register a single TypefaceCache with their builders, to share (family, style) lookups
+ * across animations.
+ *
+ * Use Make() for the default memoizing implementation, or subclass to route resolution
+ * through an existing font collection (e.g. skparagraph's FontCollection).
+ *
+ * Implementations are expected to be thread safe (Make()'s is).
+ */
+class SK_API TypefaceCache : public SkRefCnt {
+public:
+    /**
+     * Creates the default cache implementation, which memoizes font manager lookups.
+     */
+    static sk_sp<TypefaceCache> Make();
+
+    /**
+     * Returns the typeface for (family, style), or nullptr when unavailable.
+     *
+     * @param fallback  the builder's font manager, for cache-miss resolution.
+     */
+    virtual sk_sp<SkTypeface> matchFamilyStyle(const char family[], const SkFontStyle&,
+                                               const sk_sp<SkFontMgr>& fallback) = 0;
+};
+
 class SK_API Animation : public SkNVRefCnt<Animation> {
 public:
     class Builder final {
@@ -102,6 +132,13 @@ public:
          */
         Builder& setFontManager(sk_sp<SkFontMgr>);
 
+        /**
+         * Specify a typeface cache, shared across animations.
+         *
+         * See TypefaceCache above.
+         */
+        Builder& setTypefaceCache(sk_sp<TypefaceCache>);
+
         /**
          * Specify a PropertyObserver to receive callbacks during parsing.
          *
@@ -133,11 +170,25 @@ public:
         sk_sp<Animation> make(const char* data, size_t length);
         sk_sp<Animation> makeFromFile(const char path[]);
 
+        /**
+         * Pre-parses Lottie JSON into a compact binary blob, which the make()
+         * factories accept in place of JSON text -- skipping the JSON parsing
+         * step on subsequent loads.
+         *
+         * The encoding is not stable across Skia versions: treat blobs as a
+         * regenerable cache rather than an interchange format (make() returns
+         * nullptr for blobs it cannot decode).
+         *
+         * @return  the precompiled blob, or nullptr for invalid JSON input.
+         */
+        static sk_sp<SkData> Precompile(const char* json, size_t length);
+
     private:
         const uint32_t          fFlags;
 
         sk_sp<ResourceProvider>   fResourceProvider;
         sk_sp<SkFontMgr>          fFontMgr;
+        sk_sp<TypefaceCache>      fTypefaceCache;
         sk_sp<PropertyObserver>   fPropertyObserver;
         sk_sp<Logger>             fLogger;
         sk_sp<MarkerObserver  >   fMarkerObserver;
@@ -181,6 +232,26 @@ public:
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
     void render(SkCanvas* canvas, const SkRect* dst, RenderFlags) const;
 
+    /**
+     * Redraws only the damaged portion of the current animation frame.
+     *
+     * The canvas is expected to already hold the previously rendered frame,
+     * drawn with the same |dst| and |flags|, over a transparent background
+     * (the damaged area is cleared before redrawing).  |damage| is the
+     * invalidation controller passed to the seek() that advanced the
+     * animation; its bounds are in animation coordinates.  When nothing was
+     * damaged, no drawing occurs.
+     *
+     * @param canvas   destination canvas, holding the previous frame
+     * @param damage   damage accumulated by the latest seek()
+     * @param dst      optional destination rect
+     * @param flags    optional RenderFlags
+     */
+    void renderIncremental(SkCanvas* canvas,
+                           const sksg::InvalidationController& damage,
+                           const SkRect* dst = nullptr,
+                           RenderFlags flags = 0) const;
+
     /**
      * [Deprecated: use one of the other versions.]
      *
@@ -74,13 +74,25 @@ SkM44 CameraAdaper::totalMatrix() const {
     //   * point of interest -> anchor point attribute (two-node camera only)
     //   * orientation       -> rotation attribute
     //
-    const auto position = this->position();
+    const auto position = this->position(),
+               poi      = this->poi(position),
+               rotation = this->rotation();
+
+    // The camera matrix (look-at + perspective) is comparatively expensive to build, and is
+    // synced on every seek even when only unrelated layers animate - so rebuild it only when
+    // one of its inputs actually changed. The downstream sksg::Matrix<SkM44> node already
+    // dirty-checks setMatrix(), keeping the whole camera sync to a comparison in that case.
+    if (!fCacheValid || position != fCachedPosition || poi != fCachedPoi ||
+        rotation != fCachedRotation || fZoom != fCachedZoom) {
+        fCachedMatrix   = ComputeCameraMatrix(position, poi, rotation, fViewportSize, fZoom);
+        fCachedPosition = position;
+        fCachedPoi      = poi;
+        fCachedRotation = rotation;
+        fCachedZoom     = fZoom;
+        fCacheValid     = true;
+    }
 
-    return ComputeCameraMatrix(position,
-                               this->poi(position),
-                               this->rotation(),
-                               fViewportSize,
-                               fZoom);
+    return fCachedMatrix;
 }
 
 SkV3 CameraAdaper::poi(const SkV3& pos) const {
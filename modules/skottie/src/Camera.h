@@ -39,6 +39,14 @@ private:
 
     ScalarValue fZoom = 0;
 
+    // Memoized camera matrix: rebuilt only when one of the animated inputs actually changes.
+    mutable SkV3  fCachedPosition = { 0, 0, 0 },
+                  fCachedPoi      = { 0, 0, 0 },
+                  fCachedRotation = { 0, 0, 0 };
+    mutable float fCachedZoom     = 0;
+    mutable SkM44 fCachedMatrix;
+    mutable bool  fCacheValid     = false;
+
     using INHERITED = TransformAdapter3D;
 };
 
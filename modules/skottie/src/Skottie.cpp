@@ -14,7 +14,10 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkTArray.h"
+#include "include/private/SkTHash.h"
 #include "include/private/SkTo.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/include/SkottieProperty.h"
@@ -158,6 +161,7 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachBlendMode(const skjson::ObjectVa
 }
 
 AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr> fontmgr,
+                                   sk_sp<TypefaceCache> tcache,
                                    sk_sp<PropertyObserver> pobserver, sk_sp<Logger> logger,
                                    sk_sp<MarkerObserver> mobserver, sk_sp<PrecompInterceptor> pi,
                                    Animation::Builder::Stats* stats,
@@ -165,6 +169,7 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
                                    uint32_t flags)
     : fResourceProvider(std::move(rp))
     , fLazyFontMgr(std::move(fontmgr))
+    , fTypefaceCache(std::move(tcache))
     , fPropertyObserver(std::move(pobserver))
     , fLogger(std::move(logger))
     , fMarkerObserver(std::move(mobserver))
@@ -300,6 +305,59 @@ void AnimationBuilder::AutoPropertyTracker::updateContext(PropertyObserver* obse
 
 void Logger::log(Level, const char[], const char*) {}
 
+namespace {
+
+class DefaultTypefaceCache final : public TypefaceCache {
+public:
+    sk_sp<SkTypeface> matchFamilyStyle(const char family[], const SkFontStyle& style,
+                                       const sk_sp<SkFontMgr>& fallback) override {
+        const FamilyStyleKey key = { SkString(family), PackStyle(style) };
+
+        SkAutoMutexExclusive lock(fMutex);
+
+        if (const auto* cached = fCache.find(key)) {
+            return *cached;
+        }
+
+        // Misses are cached too, to avoid repeated fallback searches.
+        auto tf = sk_sp<SkTypeface>(fallback->matchFamilyStyle(family, style));
+        fCache.set(key, tf);
+
+        return tf;
+    }
+
+private:
+    struct FamilyStyleKey {
+        SkString fFamily;
+        uint32_t fStyle;
+
+        bool operator==(const FamilyStyleKey& other) const {
+            return fStyle == other.fStyle && fFamily == other.fFamily;
+        }
+
+        struct Hash {
+            uint32_t operator()(const FamilyStyleKey& key) const {
+                return SkGoodHash()(key.fFamily) ^ SkGoodHash()(key.fStyle);
+            }
+        };
+    };
+
+    static uint32_t PackStyle(const SkFontStyle& style) {
+        return (SkToU32(style.weight()) << 16) |
+               (SkToU32(style.width() ) <<  8) |
+                SkToU32(style.slant());
+    }
+
+    SkMutex                                                             fMutex;
+    SkTHashMap<FamilyStyleKey, sk_sp<SkTypeface>, FamilyStyleKey::Hash> fCache;
+};
+
+} // namespace
+
+sk_sp<TypefaceCache> TypefaceCache::Make() {
+    return sk_make_sp<DefaultTypefaceCache>();
+}
+
 Animation::Builder::Builder(uint32_t flags) : fFlags(flags) {}
 Animation::Builder::~Builder() = default;
 
@@ -313,6 +371,11 @@ Animation::Builder& Animation::Builder::setFontManager(sk_sp<SkFontMgr> fmgr) {
     return *this;
 }
 
+Animation::Builder& Animation::Builder::setTypefaceCache(sk_sp<TypefaceCache> tcache) {
+    fTypefaceCache = std::move(tcache);
+    return *this;
+}
+
 Animation::Builder& Animation::Builder::setPropertyObserver(sk_sp<PropertyObserver> pobserver) {
     fPropertyObserver = std::move(pobserver);
     return *this;
@@ -368,15 +431,18 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     fStats.fJsonSize = data_len;
     const auto t0 = std::chrono::steady_clock::now();
 
-    const skjson::DOM dom(data, data_len);
-    if (!dom.root().is<skjson::ObjectValue>()) {
+    // Accept both JSON text and precompiled binary DOM blobs (see Precompile()).
+    const auto dom = skjson::DOM::IsBinary(data, data_len)
+            ? skjson::DOM::MakeFromBinary(data, data_len)
+            : std::make_unique<skjson::DOM>(data, data_len);
+    if (!dom || !dom->root().is<skjson::ObjectValue>()) {
         // TODO: more error info.
         if (fLogger) {
             fLogger->log(Logger::Level::kError, "Failed to parse JSON input.\n");
         }
         return nullptr;
     }
-    const auto& json = dom.root().as<skjson::ObjectValue>();
+    const auto& json = dom->root().as<skjson::ObjectValue>();
 
     const auto t1 = std::chrono::steady_clock::now();
     fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
@@ -402,7 +468,7 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     }
 
     SkASSERT(resolvedProvider);
-    internal::AnimationBuilder builder(std::move(resolvedProvider), fFontMgr,
+    internal::AnimationBuilder builder(std::move(resolvedProvider), fFontMgr, fTypefaceCache,
                                        std::move(fPropertyObserver),
                                        std::move(fLogger),
                                        std::move(fMarkerObserver),
@@ -441,6 +507,20 @@ sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
                 : nullptr;
 }
 
+sk_sp<SkData> Animation::Builder::Precompile(const char* json, size_t length) {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    const skjson::DOM dom(json, length);
+    if (!dom.root().is<skjson::ObjectValue>()) {
+        return nullptr;
+    }
+
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+
+    return stream.detachAsData();
+}
+
 Animation::Animation(std::unique_ptr<sksg::Scene> scene,
                      std::vector<sk_sp<internal::Animator>>&& animators,
                      SkString version, const SkSize& size,
@@ -488,6 +568,45 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
     fScene->render(canvas);
 }
 
+void Animation::renderIncremental(SkCanvas* canvas, const sksg::InvalidationController& damage,
+                                  const SkRect* dstR, RenderFlags renderFlags) const {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    if (!fScene)
+        return;
+
+    const SkRect damageR = damage.bounds();
+    if (damageR.isEmpty()) {
+        // Nothing changed since the previous frame.
+        return;
+    }
+
+    SkAutoCanvasRestore restore(canvas, true);
+
+    const SkRect srcR = SkRect::MakeSize(this->size());
+    if (dstR) {
+        canvas->concat(SkMatrix::MakeRectToRect(srcR, *dstR, SkMatrix::kCenter_ScaleToFit));
+    }
+
+    canvas->clipRect(damageR);
+    if (!(renderFlags & RenderFlag::kDisableTopLevelClipping)) {
+        canvas->clipRect(srcR);
+    }
+
+    // Drop the stale pixels within the damaged area; everything outside the
+    // clip is carried over from the previous frame.
+    canvas->clear(SK_ColorTRANSPARENT);
+
+    if ((fFlags & Flags::kRequiresTopLevelIsolation) &&
+        !(renderFlags & RenderFlag::kSkipTopLevelIsolation)) {
+        // The animation uses non-trivial blending, and needs
+        // to be rendered into a separate/transparent layer.
+        canvas->saveLayer(srcR, nullptr);
+    }
+
+    fScene->render(canvas);
+}
+
 void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
@@ -51,8 +51,9 @@ using AnimatorScope = std::vector<sk_sp<Animator>>;
 
 class AnimationBuilder final : public SkNoncopyable {
 public:
-    AnimationBuilder(sk_sp<ResourceProvider>, sk_sp<SkFontMgr>, sk_sp<PropertyObserver>,
-                     sk_sp<Logger>, sk_sp<MarkerObserver>, sk_sp<PrecompInterceptor>,
+    AnimationBuilder(sk_sp<ResourceProvider>, sk_sp<SkFontMgr>, sk_sp<TypefaceCache>,
+                     sk_sp<PropertyObserver>, sk_sp<Logger>, sk_sp<MarkerObserver>,
+                     sk_sp<PrecompInterceptor>,
                      Animation::Builder::Stats*, const SkSize& comp_size,
                      float duration, float framerate, uint32_t flags);
 
@@ -231,6 +232,7 @@ private:
 
     sk_sp<ResourceProvider>    fResourceProvider;
     LazyResolveFontMgr         fLazyFontMgr;
+    sk_sp<TypefaceCache>       fTypefaceCache;
     sk_sp<PropertyObserver>    fPropertyObserver;
     sk_sp<Logger>              fLogger;
     sk_sp<MarkerObserver>      fMarkerObserver;
@@ -13,6 +13,7 @@
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
 #include "modules/skottie/src/text/SkottieShaper.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkTextBlobPriv.h"
 #include "tests/Test.h"
@@ -393,6 +394,197 @@ DEF_TEST(Skottie_Annotations, reporter) {
     REPORTER_ASSERT(reporter, std::get<2>(observer->fMarkers[1]) == 0.75f);
 }
 
+DEF_TEST(Skottie_RenderIncremental, reporter) {
+    // A 20x20 solid whose opacity animates, inside a 100x100 comp: damage is
+    // limited to the solid's footprint.
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 100,
+                                     "layers": [
+                                       {
+                                         "ty": 1,
+                                         "ind": 0,
+                                         "ip": 0,
+                                         "op": 100,
+                                         "ks": {
+                                           "o": {
+                                             "a": 1,
+                                             "k": [
+                                               { "t":  0, "s": [ 20 ], "e": [ 100 ] },
+                                               { "t": 100 }
+                                             ]
+                                           },
+                                           "p": { "a": 0, "k": [ 40, 40, 0 ] }
+                                         },
+                                         "sw": 20,
+                                         "sh": 20,
+                                         "sc": "#ff0000"
+                                       }
+                                     ]
+                                   })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto animation = Animation::Make(&stream);
+    REPORTER_ASSERT(reporter, animation);
+
+    auto info = SkImageInfo::MakeN32Premul(100, 100);
+    SkBitmap full, incremental;
+    full.allocPixels(info);
+    incremental.allocPixels(info);
+    full.eraseColor(SK_ColorTRANSPARENT);
+    incremental.eraseColor(SK_ColorTRANSPARENT);
+
+    // Reference: full render of frame 5.
+    {
+        SkCanvas canvas(full);
+        animation->seekFrame(5);
+        animation->render(&canvas);
+    }
+
+    // Incremental: full render of frame 0, then damage-driven update to frame 5.
+    {
+        SkCanvas canvas(incremental);
+        animation->seekFrame(0);
+        animation->render(&canvas);
+
+        sksg::InvalidationController ic;
+        animation->seekFrame(5, &ic);
+        REPORTER_ASSERT(reporter, !ic.bounds().isEmpty());
+        REPORTER_ASSERT(reporter, SkRect::MakeXYWH(39, 39, 22, 22).contains(ic.bounds()));
+        animation->renderIncremental(&canvas, ic);
+    }
+
+    int mismatches = 0;
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            mismatches += full.getColor(x, y) != incremental.getColor(x, y);
+        }
+    }
+    REPORTER_ASSERT(reporter, mismatches == 0, "%d pixels differ from a full render", mismatches);
+}
+
+DEF_TEST(Skottie_Precompile, reporter) {
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 200,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 100,
+                                     "layers": [
+                                       {
+                                         "ty": 1,
+                                         "ind": 0,
+                                         "ip": 0,
+                                         "op": 100,
+                                         "ks": {},
+                                         "sw": 20,
+                                         "sh": 20,
+                                         "sc": "#ff0000"
+                                       }
+                                     ]
+                                   })";
+
+    REPORTER_ASSERT(reporter, !Animation::Builder::Precompile("invalid", 7));
+
+    const auto blob = Animation::Builder::Precompile(json, strlen(json));
+    REPORTER_ASSERT(reporter, blob);
+
+    auto reference = Animation::Make(json, strlen(json));
+    auto animation = Animation::Make(static_cast<const char*>(blob->data()), blob->size());
+    REPORTER_ASSERT(reporter, reference);
+    REPORTER_ASSERT(reporter, animation);
+    REPORTER_ASSERT(reporter, animation->size()     == reference->size());
+    REPORTER_ASSERT(reporter, animation->duration() == reference->duration());
+    REPORTER_ASSERT(reporter, animation->version()  == reference->version());
+}
+
+DEF_TEST(Skottie_TypefaceCache, reporter) {
+    auto test_typeface = ToolUtils::create_portable_typeface();
+    REPORTER_ASSERT(reporter, test_typeface);
+
+    static const char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 1,
+                                     "ip": 0,
+                                     "op": 1,
+                                     "fonts": {
+                                       "list": [
+                                         {
+                                           "fName": "test_font",
+                                           "fFamily": "test-family",
+                                           "fStyle": "Bold"
+                                         }
+                                       ]
+                                     },
+                                     "layers": [
+                                       {
+                                         "ty": 5,
+                                         "nm": "layer_0",
+                                         "ip": 0,
+                                         "op": 1,
+                                         "ks": {},
+                                         "t": {
+                                           "d": {
+                                             "k": [
+                                                {
+                                                  "t": 0,
+                                                  "s": {
+                                                    "f": "test_font",
+                                                    "s": 100,
+                                                    "t": "inline_text",
+                                                    "lh": 120
+                                                  }
+                                                }
+                                             ]
+                                           }
+                                         }
+                                       }
+                                     ]
+                                   })";
+
+    class TestTypefaceCache final : public TypefaceCache {
+    public:
+        explicit TestTypefaceCache(sk_sp<SkTypeface> tf) : fTypeface(std::move(tf)) {}
+
+        sk_sp<SkTypeface> matchFamilyStyle(const char family[], const SkFontStyle& style,
+                                           const sk_sp<SkFontMgr>&) override {
+            fFamilies.push_back(SkString(family));
+            fStyles.push_back(style);
+            return fTypeface;
+        }
+
+        const std::vector<SkString>&    families() const { return fFamilies; }
+        const std::vector<SkFontStyle>& styles()   const { return fStyles;   }
+
+    private:
+        const sk_sp<SkTypeface>  fTypeface;
+        std::vector<SkString>    fFamilies;
+        std::vector<SkFontStyle> fStyles;
+    };
+
+    auto tcache = sk_make_sp<TestTypefaceCache>(test_typeface);
+
+    // The shared cache is consulted once per animation instantiation.
+    for (size_t i = 1; i <= 2; ++i) {
+        auto animation = skottie::Animation::Builder()
+                .setTypefaceCache(tcache)
+                .make(json, strlen(json));
+
+        REPORTER_ASSERT(reporter, animation);
+        REPORTER_ASSERT(reporter, tcache->families().size() == i);
+        REPORTER_ASSERT(reporter, tcache->families()[i - 1].equals("test-family"));
+        REPORTER_ASSERT(reporter, tcache->styles()[i - 1].weight()
+                                      == SkFontStyle::kBold_Weight);
+    }
+}
+
 static SkRect ComputeBlobBounds(const sk_sp<SkTextBlob>& blob) {
     auto bounds = SkRect::MakeEmpty();
 
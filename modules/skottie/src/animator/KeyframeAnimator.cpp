@@ -29,7 +29,13 @@ KeyframeAnimator::LERPInfo KeyframeAnimator::getLERPInfo(float t) const {
 
     // Cache the current segment (most queries have good locality).
     if (!fCurrentSegment.contains(t)) {
-        fCurrentSegment = this->find_segment(t);
+        // Playback advances monotonically, so the successor segment is the
+        // most likely hit on a miss -- probe it before binary-searching.
+        const KFSegment successor = {fCurrentSegment.kf1,
+                                     fCurrentSegment.kf1 ? fCurrentSegment.kf1 + 1 : nullptr};
+        fCurrentSegment = (fCurrentSegment.kf1 != &fKFs.back() && successor.contains(t))
+            ? successor
+            : this->find_segment(t);
     }
     SkASSERT(fCurrentSegment.contains(t));
 
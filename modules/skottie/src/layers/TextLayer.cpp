@@ -273,15 +273,19 @@ bool AnimationBuilder::resolveNativeTypefaces() {
         }
 
         if (!finfo->fTypeface) {
-            finfo->fTypeface.reset(fmgr->matchFamilyStyle(finfo->fFamily.c_str(),
-                                                          FontStyle(this, finfo->fStyle.c_str())));
+            const auto style = FontStyle(this, finfo->fStyle.c_str());
+
+            // When a shared TypefaceCache is registered, (family, style) resolution
+            // is routed through it -- pooling results across animations.
+            finfo->fTypeface = fTypefaceCache
+                    ? fTypefaceCache->matchFamilyStyle(finfo->fFamily.c_str(), style, fmgr)
+                    : sk_sp<SkTypeface>(fmgr->matchFamilyStyle(finfo->fFamily.c_str(), style));
 
             if (!finfo->fTypeface) {
                 this->log(Logger::Level::kError, nullptr, "Could not create typeface for %s|%s.",
                           finfo->fFamily.c_str(), finfo->fStyle.c_str());
                 // Last resort.
-                finfo->fTypeface = fmgr->legacyMakeTypeface(nullptr,
-                                                            FontStyle(this, finfo->fStyle.c_str()));
+                finfo->fTypeface = fmgr->legacyMakeTypeface(nullptr, style);
 
                 has_unresolved |= !finfo->fTypeface;
             }
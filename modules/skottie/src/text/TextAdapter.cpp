@@ -264,18 +264,41 @@ uint32_t TextAdapter::shaperFlags() const {
     return flags;
 }
 
+// The subset of text value properties which affect shaping.
+static bool shape_inputs_equal(const TextValue& a, const TextValue& b) {
+    return a.fTypeface   == b.fTypeface
+        && a.fText       == b.fText
+        && a.fTextSize   == b.fTextSize
+        && a.fLineHeight == b.fLineHeight
+        && a.fAscent     == b.fAscent
+        && a.fHAlign     == b.fHAlign
+        && a.fVAlign     == b.fVAlign
+        && a.fResize     == b.fResize
+        && a.fBox        == b.fBox;
+}
+
 void TextAdapter::reshape() {
-    const Shaper::TextDesc text_desc = {
-        fText->fTypeface,
-        fText->fTextSize,
-        fText->fLineHeight,
-        fText->fAscent,
-        fText->fHAlign,
-        fText->fVAlign,
-        fText->fResize,
-        this->shaperFlags(),
-    };
-    const auto shape_result = Shaper::Shape(fText->fText, text_desc, fText->fBox, fFontMgr);
+    const auto shaper_flags = this->shaperFlags();
+
+    if (!fShapeMemo.fValid ||
+         fShapeMemo.fFlags != shaper_flags ||
+        !shape_inputs_equal(fShapeMemo.fValue, fText.fCurrentValue)) {
+        const Shaper::TextDesc text_desc = {
+            fText->fTypeface,
+            fText->fTextSize,
+            fText->fLineHeight,
+            fText->fAscent,
+            fText->fHAlign,
+            fText->fVAlign,
+            fText->fResize,
+            shaper_flags,
+        };
+        fShapeMemo.fResult = Shaper::Shape(fText->fText, text_desc, fText->fBox, fFontMgr);
+        fShapeMemo.fValue  = fText.fCurrentValue;
+        fShapeMemo.fFlags  = shaper_flags;
+        fShapeMemo.fValid  = true;
+    }
+    const auto& shape_result = fShapeMemo.fResult;
 
     if (fLogger && shape_result.fMissingGlyphCount > 0) {
         const auto msg = SkStringPrintf("Missing %zu glyphs for '%s'.",
@@ -110,6 +110,18 @@ private:
     TextValueTracker fText;
     Vec2Value        fGroupingAlignment = {0,0};
 
+    // Shaping is expensive, and any text value change triggers a reshape --
+    // including changes to properties which do not affect shaping (e.g. color
+    // keyframes).  Memoize the last shape result, keyed on the shaping inputs.
+    struct ShapeMemo {
+        TextValue      fValue;
+        uint32_t       fFlags = 0;
+        Shaper::Result fResult;
+        bool           fValid = false;
+    };
+
+    ShapeMemo        fShapeMemo;
+
     bool             fHasBlurAnimator     : 1,
                      fRequiresAnchorPoint : 1;
 };
@@ -6,6 +6,8 @@
 #include "src/core/SkLRUCache.h"
 #include <functional>  // std::function
 
+class SkTraceMemoryDump;
+
 #define PARAGRAPH_CACHE_STATS
 
 namespace skia {
@@ -45,16 +47,42 @@ public:
     void turnOn(bool value) { fCacheIsOn = value; }
     int count() { return fLRUCacheMap.count(); }
 
+    // The cache evicts least recently used entries to stay within the byte
+    // limit as well as the entry limit; shaped run arrays dominate entry cost.
+    size_t bytesUsed() const { return fCacheBytes; }
+    size_t bytesLimit() const { return fCacheBytesLimit; }
+    void setBytesLimit(size_t limit);
+
+    // Dumps cache totals as "skia/sk_paragraph_cache" via the SkTraceMemoryDump interface,
+    // matching the naming of the core Skia cache dumps.
+    void dumpMemoryStatistics(SkTraceMemoryDump* dump);
+
+#ifdef PARAGRAPH_CACHE_STATS
+    // A snapshot of the counters, for export to a metrics pipeline.
+    struct Statistics {
+        int fTotalRequests;
+        int fCacheMisses;
+        int fHashMisses;
+        int fEvictions;
+        size_t fBytesUsed;
+        size_t fBytesLimit;
+        int fCount;
+    };
+    Statistics getStatistics();
+#endif
+
  private:
 
     struct Entry;
     void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
+    void purgeTo(int countLimit, size_t bytesLimit); // requires fParagraphMutex
 
      mutable SkMutex fParagraphMutex;
      std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
     static const int kMaxEntries = 128;
+    static const size_t kMaxCacheBytes = 8 * 1024 * 1024;
 
     struct KeyHash {
         uint32_t mix(uint32_t hash, uint32_t data) const;
@@ -63,11 +91,14 @@ public:
 
     SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
     bool fCacheIsOn;
+    size_t fCacheBytes;
+    size_t fCacheBytesLimit;
 
 #ifdef PARAGRAPH_CACHE_STATS
     int fTotalRequests;
     int fCacheMisses;
     int fHashMisses; // cache hit but hash table missed
+    int fCacheEvictions;
 #endif
 };
 
@@ -1,6 +1,7 @@
 // Copyright 2019 Google LLC.
 #include <memory>
 
+#include "include/core/SkTraceMemoryDump.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
 
@@ -44,6 +45,27 @@ public:
         , fUTF8IndexForUTF16Index(paragraph->fUTF8IndexForUTF16Index)
         , fUTF16IndexForUTF8Index(paragraph->fUTF16IndexForUTF8Index) { }
 
+    // An estimate of the entry's cost; the shaped runs dominate, and for them
+    // both the inline storage counted by sizeof(Run) and the per-glyph arrays
+    // matter.
+    size_t memoryUsed() const {
+        size_t size = sizeof(*this);
+        size += fKey.fText.size();
+        size += fKey.fPlaceholders.size() * sizeof(Placeholder);
+        size += fKey.fTextStyles.size() * sizeof(Block);
+        for (auto& run : fRuns) {
+            size += sizeof(Run) + run.size() * (sizeof(SkGlyphID) + 2 * sizeof(SkPoint) +
+                                                sizeof(uint32_t) + sizeof(SkRect) +
+                                                sizeof(SkScalar));
+        }
+        size += fCodeUnitProperties.size() * sizeof(CodeUnitFlags);
+        size += fWords.size() * sizeof(size_t);
+        size += fBidiRegions.size() * sizeof(BidiRegion);
+        size += fUTF8IndexForUTF16Index.size() * sizeof(TextIndex);
+        size += fUTF16IndexForUTF8Index.size() * sizeof(size_t);
+        return size;
+    }
+
     // Input == key
     ParagraphCacheKey fKey;
 
@@ -185,18 +207,22 @@ bool operator==(const ParagraphCacheKey& a, const ParagraphCacheKey& b) {
 
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
+    Entry(ParagraphCacheValue* value) : fValue(value), fMemoryUsed(fValue->memoryUsed()) {}
     std::unique_ptr<ParagraphCacheValue> fValue;
+    size_t fMemoryUsed;
 };
 
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
     , fLRUCacheMap(kMaxEntries)
     , fCacheIsOn(true)
+    , fCacheBytes(0)
+    , fCacheBytesLimit(kMaxCacheBytes)
 #ifdef PARAGRAPH_CACHE_STATS
     , fTotalRequests(0)
     , fCacheMisses(0)
     , fHashMisses(0)
+    , fCacheEvictions(0)
 #endif
 { }
 
@@ -223,9 +249,54 @@ void ParagraphCache::printStatistics() {
     SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
     int cacheHits = fTotalRequests - fCacheMisses;
     SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    SkDebugf("Evictions: %d\n", fCacheEvictions);
+    SkDebugf("Bytes: %zu of %zu\n", fCacheBytes, fCacheBytesLimit);
     SkDebugf("---------------------\n");
 }
 
+void ParagraphCache::dumpMemoryStatistics(SkTraceMemoryDump* dump) {
+    static const char kDumpName[] = "skia/sk_paragraph_cache";
+    SkAutoMutexExclusive lock(fParagraphMutex);
+    dump->dumpNumericValue(kDumpName, "size", "bytes", fCacheBytes);
+    dump->dumpNumericValue(kDumpName, "budget_size", "bytes", fCacheBytesLimit);
+    dump->dumpNumericValue(kDumpName, "count", "objects", fLRUCacheMap.count());
+    dump->setMemoryBacking(kDumpName, "malloc", nullptr);
+}
+
+#ifdef PARAGRAPH_CACHE_STATS
+ParagraphCache::Statistics ParagraphCache::getStatistics() {
+    SkAutoMutexExclusive lock(fParagraphMutex);
+    Statistics stats;
+    stats.fTotalRequests = fTotalRequests;
+    stats.fCacheMisses = fCacheMisses;
+    stats.fHashMisses = fHashMisses;
+    stats.fEvictions = fCacheEvictions;
+    stats.fBytesUsed = fCacheBytes;
+    stats.fBytesLimit = fCacheBytesLimit;
+    stats.fCount = fLRUCacheMap.count();
+    return stats;
+}
+#endif
+
+void ParagraphCache::purgeTo(int countLimit, size_t bytesLimit) {
+    while (fLRUCacheMap.count() > countLimit ||
+           (fLRUCacheMap.count() > 0 && fCacheBytes > bytesLimit)) {
+        std::unique_ptr<Entry>* lru = fLRUCacheMap.peekLRU();
+        SkASSERT(fCacheBytes >= (*lru)->fMemoryUsed);
+        fCacheBytes -= (*lru)->fMemoryUsed;
+        fLRUCacheMap.removeLRU();
+#ifdef PARAGRAPH_CACHE_STATS
+        ++fCacheEvictions;
+#endif
+    }
+}
+
+void ParagraphCache::setBytesLimit(size_t limit) {
+    SkAutoMutexExclusive lock(fParagraphMutex);
+    fCacheBytesLimit = limit;
+    this->purgeTo(kMaxEntries, fCacheBytesLimit);
+}
+
 void ParagraphCache::abandon() {
     SkAutoMutexExclusive lock(fParagraphMutex);
     fLRUCacheMap.foreach([](ParagraphCacheKey*, std::unique_ptr<Entry>* e) {
@@ -240,8 +311,10 @@ void ParagraphCache::reset() {
     fTotalRequests = 0;
     fCacheMisses = 0;
     fHashMisses = 0;
+    fCacheEvictions = 0;
 #endif
     fLRUCacheMap.reset();
+    fCacheBytes = 0;
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -280,7 +353,15 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
     std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
     if (!entry) {
         ParagraphCacheValue* value = new ParagraphCacheValue(paragraph);
-        fLRUCacheMap.insert(key, std::make_unique<Entry>(value));
+        auto newEntry = std::make_unique<Entry>(value);
+        // Make room up front so the count-based eviction inside insert() never
+        // fires behind the byte accounting's back.
+        size_t budget = fCacheBytesLimit > newEntry->fMemoryUsed
+                      ? fCacheBytesLimit - newEntry->fMemoryUsed
+                      : 0;
+        this->purgeTo(kMaxEntries - 1, budget);
+        fCacheBytes += newEntry->fMemoryUsed;
+        fLRUCacheMap.insert(key, std::move(newEntry));
         fChecker(paragraph, "addedParagraph", true);
         return true;
     } else {
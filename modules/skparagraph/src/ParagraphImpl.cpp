@@ -120,8 +120,9 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
         fWidth = floorWidth;
         fState = kLineBroken;
     } else if (fState >= kLineBroken && fOldWidth != floorWidth) {
-        // We can use the results from SkShaper but have to do EVERYTHING ELSE again
-        fState = kShaped;
+        // Shaping and the cluster table do not depend on the width, so only
+        // line breaking and everything after it need to run again
+        fState = kMarked;
     } else {
         // Nothing changed case: we can reuse the data from the last layout
     }
@@ -177,6 +178,8 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
         this->resolveStrut();
         this->computeEmptyMetrics();
         this->fLines.reset();
+        // The previous layout's justification was computed for the old lines.
+        this->resetJustificationShifts();
         this->breakShapedTextIntoLines(floorWidth);
         fState = kLineBroken;
     }
@@ -212,6 +212,14 @@ public:
         }
     }
 
+    // Letter/word spacing shifts are width-independent and can be kept across
+    // a relayout; justification shifts belong to a particular set of lines.
+    void resetJustificationShifts() {
+        for (auto& run : fRuns) {
+            run.resetJustificationShifts();
+        }
+    }
+
     using CodeUnitRangeVisitor = std::function<bool(TextRange textRange)>;
     void forEachCodeUnitPropertyRange(CodeUnitFlags property, CodeUnitRangeVisitor visitor);
     size_t getWhitespacesLength(TextRange textRange);
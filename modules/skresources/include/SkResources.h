@@ -17,8 +17,10 @@
 #include "include/private/SkTHash.h"
 
 #include <memory>
+#include <vector>
 
 class SkAnimCodecPlayer;
+class SkExecutor;
 class SkImage;
 
 namespace skresources {
@@ -74,6 +76,53 @@ private:
     using INHERITED = ImageAsset;
 };
 
+/**
+ * An ImageAsset proxy which decodes ahead of the playback position.
+ *
+ * Multi-frame assets normally decode lazily, at seek time, on the render thread -- large
+ * frames can cause visible hitches when an image sequence advances.  This proxy observes the
+ * seek cadence, and schedules the predicted next frame for decoding on a worker executor
+ * while the current frame displays.  Decoded frames are retained in a small LRU cache.
+ *
+ * Since the upcoming seek time is predicted, a served frame may be off by a fraction of the
+ * seek interval in rare cases (stale by less than one frame).
+ */
+class SK_API PrefetchingImageAsset final : public ImageAsset {
+public:
+    /**
+     * Wraps |asset|; prefetch decodes are scheduled on |executor|, which must outlive all
+     * pending frame requests.
+     */
+    static sk_sp<PrefetchingImageAsset> Make(sk_sp<ImageAsset> asset, SkExecutor* executor);
+
+    bool isMultiFrame() override;
+
+    sk_sp<SkImage> getFrame(float t) override;
+
+private:
+    PrefetchingImageAsset(sk_sp<ImageAsset>, SkExecutor*);
+
+    sk_sp<SkImage> findCachedFrame(float t, float tolerance);
+    sk_sp<SkImage> decodeAndCache(float t);
+
+    struct CachedFrame {
+        float          fTime;
+        sk_sp<SkImage> fFrame;
+        uint64_t       fLastUsed;
+    };
+
+    const sk_sp<ImageAsset> fAsset;
+    SkExecutor*             fExecutor;
+
+    SkMutex                  fDecodeMutex,  // serializes access to the wrapped asset
+                             fStateMutex;   // guards the fields below
+    std::vector<CachedFrame> fCache;
+    float                    fLastT    = -1;
+    uint64_t                 fUseStamp = 0;
+
+    using INHERITED = ImageAsset;
+};
+
 /**
  * ResourceProvider is an interface that lets rich-content modules defer loading of external
  * resources (images, fonts, etc.) to embedding clients.
@@ -195,6 +244,25 @@ private:
     using INHERITED = ResourceProviderProxyBase;
 };
 
+/**
+ * A proxy which wraps multi-frame image assets in a PrefetchingImageAsset (see above), so
+ * frame-ahead decoding applies uniformly to all assets served by the wrapped provider.
+ */
+class SK_API PrefetchingResourceProviderProxy final : public ResourceProviderProxyBase {
+public:
+    static sk_sp<PrefetchingResourceProviderProxy> Make(sk_sp<ResourceProvider> rp,
+                                                        SkExecutor* executor);
+
+private:
+    PrefetchingResourceProviderProxy(sk_sp<ResourceProvider>, SkExecutor*);
+
+    sk_sp<ImageAsset> loadImageAsset(const char[], const char[], const char[]) const override;
+
+    SkExecutor* fExecutor;
+
+    using INHERITED = ResourceProviderProxyBase;
+};
+
 } // namespace skresources
 
 #endif // SkResources_DEFINED
@@ -9,12 +9,15 @@
 
 #include "include/codec/SkCodec.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/utils/SkAnimCodecPlayer.h"
 #include "include/utils/SkBase64.h"
 #include "src/core/SkOSFile.h"
 #include "src/utils/SkOSPath.h"
 
+#include <cmath>
+
 #if defined(HAVE_VIDEO_DECODER)
     #include "experimental/ffmpeg/SkVideoDecoder.h"
 #endif
@@ -157,6 +160,101 @@ sk_sp<SkImage> MultiFrameImageAsset::getFrame(float t) {
     return fCachedFrame;
 }
 
+sk_sp<PrefetchingImageAsset> PrefetchingImageAsset::Make(sk_sp<ImageAsset> asset,
+                                                         SkExecutor* executor) {
+    return asset && executor
+        ? sk_sp<PrefetchingImageAsset>(new PrefetchingImageAsset(std::move(asset), executor))
+        : nullptr;
+}
+
+PrefetchingImageAsset::PrefetchingImageAsset(sk_sp<ImageAsset> asset, SkExecutor* executor)
+    : fAsset(std::move(asset))
+    , fExecutor(executor) {
+    SkASSERT(fAsset);
+    SkASSERT(fExecutor);
+}
+
+bool PrefetchingImageAsset::isMultiFrame() {
+    return fAsset->isMultiFrame();
+}
+
+sk_sp<SkImage> PrefetchingImageAsset::findCachedFrame(float t, float tolerance) {
+    SkAutoMutexExclusive lock(fStateMutex);
+
+    CachedFrame* best = nullptr;
+    for (auto& entry : fCache) {
+        if (std::abs(entry.fTime - t) <= tolerance &&
+            (!best || std::abs(entry.fTime - t) < std::abs(best->fTime - t))) {
+            best = &entry;
+        }
+    }
+
+    if (!best) {
+        return nullptr;
+    }
+
+    best->fLastUsed = ++fUseStamp;
+    return best->fFrame;
+}
+
+sk_sp<SkImage> PrefetchingImageAsset::decodeAndCache(float t) {
+    SkAutoMutexExclusive decode_lock(fDecodeMutex);
+
+    // A concurrent decode for the same time may have landed while we waited.
+    if (auto frame = this->findCachedFrame(t, 0)) {
+        return frame;
+    }
+
+    auto frame = fAsset->getFrame(t);
+
+    static constexpr size_t kMaxCachedFrames = 4;
+
+    SkAutoMutexExclusive lock(fStateMutex);
+    CachedFrame* slot = fCache.size() < kMaxCachedFrames
+        ? &fCache.emplace_back()
+        : nullptr;
+    if (!slot) {
+        // Evict the least recently used frame.
+        slot = &fCache[0];
+        for (auto& entry : fCache) {
+            if (entry.fLastUsed < slot->fLastUsed) {
+                slot = &entry;
+            }
+        }
+    }
+    *slot = { t, frame, ++fUseStamp };
+
+    return frame;
+}
+
+sk_sp<SkImage> PrefetchingImageAsset::getFrame(float t) {
+    float prefetch_t = -1;
+    {
+        SkAutoMutexExclusive lock(fStateMutex);
+        if (fLastT >= 0 && t > fLastT) {
+            // Steady playback: predict the next seek from the current cadence.
+            prefetch_t = t + (t - fLastT);
+        }
+        fLastT = t;
+    }
+
+    // Accept cached frames within half a seek interval of the requested time.
+    const float tolerance = prefetch_t >= 0 ? (prefetch_t - t) * 0.5f : 0;
+
+    auto frame = this->findCachedFrame(t, tolerance);
+    if (!frame) {
+        frame = this->decodeAndCache(t);
+    }
+
+    if (prefetch_t >= 0 && !this->findCachedFrame(prefetch_t, 0)) {
+        fExecutor->add([self = sk_ref_sp(this), prefetch_t] {
+            self->decodeAndCache(prefetch_t);
+        });
+    }
+
+    return frame;
+}
+
 sk_sp<FileResourceProvider> FileResourceProvider::Make(SkString base_dir, bool predecode) {
     return sk_isdir(base_dir.c_str())
         ? sk_sp<FileResourceProvider>(new FileResourceProvider(std::move(base_dir), predecode))
@@ -292,4 +390,31 @@ sk_sp<SkTypeface> DataURIResourceProviderProxy::loadTypeface(const char name[],
     return this->INHERITED::loadTypeface(name, url);
 }
 
+sk_sp<PrefetchingResourceProviderProxy> PrefetchingResourceProviderProxy::Make(
+        sk_sp<ResourceProvider> rp, SkExecutor* executor) {
+    return rp && executor
+        ? sk_sp<PrefetchingResourceProviderProxy>(
+              new PrefetchingResourceProviderProxy(std::move(rp), executor))
+        : nullptr;
+}
+
+PrefetchingResourceProviderProxy::PrefetchingResourceProviderProxy(sk_sp<ResourceProvider> rp,
+                                                                   SkExecutor* executor)
+    : INHERITED(std::move(rp))
+    , fExecutor(executor) {}
+
+sk_sp<ImageAsset> PrefetchingResourceProviderProxy::loadImageAsset(const char rpath[],
+                                                                   const char rname[],
+                                                                   const char rid[]) const {
+    auto asset = this->INHERITED::loadImageAsset(rpath, rname, rid);
+
+    // Static assets cache their single frame internally; only animated
+    // assets benefit from prefetching.
+    if (asset && asset->isMultiFrame()) {
+        return PrefetchingImageAsset::Make(std::move(asset), fExecutor);
+    }
+
+    return asset;
+}
+
 } // namespace skresources
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGRenderCache_DEFINED
+#define SkSGRenderCache_DEFINED
+
+#include "modules/sksg/include/SkSGEffectNode.h"
+
+class SkPicture;
+
+namespace sksg {
+
+/**
+ * Concrete Effect node, caching its descendants' render commands.
+ *
+ * While the wrapped subtree holds still (no invalidation between frames), its
+ * render traversal is captured into an SkPicture and subsequent frames replay
+ * the recording instead of re-visiting every node.  Any descendant
+ * invalidation discards the recording, so animating content renders directly.
+ */
+class RenderCache final : public EffectNode {
+public:
+    static sk_sp<RenderCache> Make(sk_sp<RenderNode> child) {
+        return child ? sk_sp<RenderCache>(new RenderCache(std::move(child))) : nullptr;
+    }
+
+protected:
+    explicit RenderCache(sk_sp<RenderNode>);
+
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    static bool IsCacheable(const RenderContext&);
+    static bool Equivalent(const RenderContext&, const RenderContext&);
+
+    mutable sk_sp<SkPicture> fRecording;
+    mutable RenderContext    fRecordingCtx;
+    mutable bool             fWasInvalidated = true;
+
+    typedef EffectNode INHERITED;
+};
+
+} // namespace sksg
+
+#endif // SkSGRenderCache_DEFINED
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/sksg/include/SkSGRenderCache.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+
+namespace sksg {
+
+bool RenderCache::IsCacheable(const RenderContext& ctx) {
+    // Shader overrides capture an absolute CTM at modulation time, which a
+    // CTM-relative recording cannot reproduce.  Everything else (opacity,
+    // color filters, blend modes) composes the same way under replay.
+    return !ctx.fShader && !ctx.fMaskShader;
+}
+
+bool RenderCache::Equivalent(const RenderContext& a, const RenderContext& b) {
+    SkASSERT(IsCacheable(a) && IsCacheable(b));
+
+    return a.fColorFilter == b.fColorFilter
+        && a.fOpacity     == b.fOpacity
+        && a.fBlendMode   == b.fBlendMode;
+}
+
+RenderCache::RenderCache(sk_sp<RenderNode> child)
+    : INHERITED(std::move(child)) {}
+
+void RenderCache::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    const RenderContext local_ctx = ctx ? *ctx : RenderContext();
+
+    if (fWasInvalidated || !IsCacheable(local_ctx)) {
+        // Freshly-invalidated content is likely animating: render directly,
+        // and only start recording once the subtree holds still for a frame.
+        fWasInvalidated = false;
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    if (!fRecording || !Equivalent(fRecordingCtx, local_ctx)) {
+        SkPictureRecorder recorder;
+        this->INHERITED::onRender(recorder.beginRecording(this->bounds()), &local_ctx);
+        fRecording    = recorder.finishRecordingAsPicture();
+        fRecordingCtx = local_ctx;
+    }
+
+    canvas->drawPicture(fRecording);
+}
+
+SkRect RenderCache::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    fWasInvalidated = true;
+    fRecording.reset();
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
+} // namespace sksg
@@ -9,6 +9,8 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkRect.h"
 #include "include/private/SkTo.h"
 #include "modules/sksg/include/SkSGDraw.h"
@@ -16,6 +18,7 @@
 #include "modules/sksg/include/SkSGInvalidationController.h"
 #include "modules/sksg/include/SkSGPaint.h"
 #include "modules/sksg/include/SkSGRect.h"
+#include "modules/sksg/include/SkSGRenderCache.h"
 #include "modules/sksg/include/SkSGRenderEffect.h"
 #include "modules/sksg/include/SkSGTransform.h"
 #include "src/core/SkRectPriv.h"
@@ -355,4 +358,56 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+DEF_TEST(SGRenderCache, reporter) {
+    class CountingNode final : public sksg::RenderNode {
+    public:
+        size_t renderCount() const { return fRenderCount; }
+
+        void touch() { this->invalidate(); }
+
+    protected:
+        void onRender(SkCanvas* canvas, const RenderContext*) const override {
+            fRenderCount++;
+            canvas->drawRect(SkRect::MakeWH(100, 100), SkPaint());
+        }
+
+        const RenderNode* onNodeAt(const SkPoint&) const override { return nullptr; }
+
+        SkRect onRevalidate(sksg::InvalidationController*, const SkMatrix&) override {
+            return SkRect::MakeWH(100, 100);
+        }
+
+    private:
+        mutable size_t fRenderCount = 0;
+    };
+
+    auto node  = sk_make_sp<CountingNode>();
+    auto cache = sksg::RenderCache::Make(node);
+
+    SkCanvas canvas(100, 100);
+    auto advance_frame = [&]() {
+        sksg::InvalidationController ic;
+        cache->revalidate(&ic, SkMatrix::I());
+        cache->render(&canvas);
+    };
+
+    // Frame 1: just-revalidated content renders directly.
+    advance_frame();
+    REPORTER_ASSERT(reporter, node->renderCount() == 1);
+
+    // Frame 2: stable content is captured into a recording.
+    advance_frame();
+    REPORTER_ASSERT(reporter, node->renderCount() == 2);
+
+    // Subsequent stable frames replay the recording.
+    advance_frame();
+    advance_frame();
+    REPORTER_ASSERT(reporter, node->renderCount() == 2);
+
+    // Invalidation discards the recording.
+    node->touch();
+    advance_frame();
+    REPORTER_ASSERT(reporter, node->renderCount() == 3);
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
@@ -37,6 +37,7 @@
     #endif
 #endif
 
+class SkExecutor;
 class SkFont;
 class SkFontMgr;
 
@@ -51,8 +52,13 @@ public:
     static std::unique_ptr<SkShaper> MakePrimitive();
     #ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
     static std::unique_ptr<SkShaper> MakeShaperDrivenWrapper(sk_sp<SkFontMgr> = nullptr);
-    static std::unique_ptr<SkShaper> MakeShapeThenWrap(sk_sp<SkFontMgr> = nullptr);
-    static std::unique_ptr<SkShaper> MakeShapeDontWrapOrReorder(sk_sp<SkFontMgr> = nullptr);
+    // If an executor is provided, independently shapeable runs (a change of bidi level,
+    // script, language, or font) are shaped concurrently on it. The executor must
+    // outlive the shaper.
+    static std::unique_ptr<SkShaper> MakeShapeThenWrap(sk_sp<SkFontMgr> = nullptr,
+                                                       SkExecutor* = nullptr);
+    static std::unique_ptr<SkShaper> MakeShapeDontWrapOrReorder(sk_sp<SkFontMgr> = nullptr,
+                                                                SkExecutor* = nullptr);
     #endif
     #ifdef SK_SHAPER_CORETEXT_AVAILABLE
     static std::unique_ptr<SkShaper> MakeCoreText();
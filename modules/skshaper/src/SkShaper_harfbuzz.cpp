@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontArguments.h"
 #include "include/core/SkFontMetrics.h"
@@ -16,6 +17,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkBitmaskEnum.h"
@@ -29,6 +31,7 @@
 #include "src/core/SkLRUCache.h"
 #include "src/core/SkSpan.h"
 #include "src/core/SkTDPQueue.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkUTF.h"
 
 #include <hb.h>
@@ -652,12 +655,25 @@ struct ShapedRunGlyphIterator {
 
 class ShaperHarfBuzz : public SkShaper {
 public:
-    ShaperHarfBuzz(HBBuffer, ICUBrk line, ICUBrk grapheme, sk_sp<SkFontMgr>);
+    ShaperHarfBuzz(HBBuffer, ICUBrk line, ICUBrk grapheme, sk_sp<SkFontMgr>,
+                   SkExecutor* executor = nullptr);
 
 protected:
     ICUBrk fLineBreakIterator;
     ICUBrk fGraphemeBreakIterator;
 
+    /** One independently shapeable segment of the source text, with the run iterator
+     *  state captured so the segment can be shaped after the iterators have advanced.
+     */
+    struct RunSegment {
+        const char* fUtf8Start;
+        const char* fUtf8End;
+        SkFont fFont;
+        UBiDiLevel fLevel;
+        SkFourByteTag fScript;
+        SkString fLanguage;
+    };
+
     ShapedRun shape(const char* utf8, size_t utf8Bytes,
                     const char* utf8Start,
                     const char* utf8End,
@@ -666,10 +682,30 @@ protected:
                     const ScriptRunIterator&,
                     const FontRunIterator&,
                     const Feature*, size_t featuresSize) const;
+
+    /** Segment the text with runSegmenter and shape each segment, appending to runs in
+     *  logical order. Segments are independent of each other, so when an executor was
+     *  provided they are shaped concurrently on it; hb_buffer_t is not thread safe, so
+     *  each task uses its own buffer instead of the shared fBuffer.
+     */
+    void shapeSegments(const char* utf8, size_t utf8Bytes,
+                       const BiDiRunIterator&,
+                       const LanguageRunIterator&,
+                       const ScriptRunIterator&,
+                       const FontRunIterator&,
+                       RunIteratorQueue& runSegmenter,
+                       const Feature*, size_t featuresSize,
+                       SkTArray<ShapedRun>* runs) const;
 private:
     const sk_sp<SkFontMgr> fFontMgr;
     HBBuffer               fBuffer;
     hb_language_t          fUndefinedLanguage;
+    SkExecutor* const      fExecutor;
+
+    ShapedRun shape(hb_buffer_t* buffer,
+                    const char* utf8, size_t utf8Bytes,
+                    const RunSegment&,
+                    const Feature*, size_t featuresSize) const;
 
     void shape(const char* utf8, size_t utf8Bytes,
                const SkFont&,
@@ -750,7 +786,8 @@ private:
               RunHandler*) const override;
 };
 
-static std::unique_ptr<SkShaper> MakeHarfBuzz(sk_sp<SkFontMgr> fontmgr, bool correct) {
+static std::unique_ptr<SkShaper> MakeHarfBuzz(sk_sp<SkFontMgr> fontmgr, bool correct,
+                                              SkExecutor* executor = nullptr) {
     #if defined(SK_USING_THIRD_PARTY_ICU)
     if (!SkLoadICU()) {
         SkDEBUGF("SkLoadICU() failed!\n");
@@ -785,17 +822,19 @@ static std::unique_ptr<SkShaper> MakeHarfBuzz(sk_sp<SkFontMgr> fontmgr, bool cor
         return std::make_unique<ShapeThenWrap>(std::move(buffer),
                                                  std::move(lineBreakIterator),
                                                  std::move(graphemeBreakIterator),
-                                                 std::move(fontmgr));
+                                                 std::move(fontmgr),
+                                                 executor);
     }
 }
 
 ShaperHarfBuzz::ShaperHarfBuzz(HBBuffer buffer, ICUBrk line, ICUBrk grapheme,
-                               sk_sp<SkFontMgr> fontmgr)
+                               sk_sp<SkFontMgr> fontmgr, SkExecutor* executor)
     : fLineBreakIterator(std::move(line))
     , fGraphemeBreakIterator(std::move(grapheme))
     , fFontMgr(std::move(fontmgr))
     , fBuffer(std::move(buffer))
     , fUndefinedLanguage(hb_language_from_string("und", -1))
+    , fExecutor(executor)
 {}
 
 void ShaperHarfBuzz::shape(const char* utf8, size_t utf8Bytes,
@@ -1050,18 +1089,12 @@ void ShapeThenWrap::wrap(char const * const utf8, size_t utf8Bytes,
         }
     }
 
-    const char* utf8Start = nullptr;
-    const char* utf8End = utf8;
-    while (runSegmenter.advanceRuns()) {
-        utf8Start = utf8End;
-        utf8End = utf8 + runSegmenter.endOfCurrentRun();
-
-        runs.emplace_back(shape(utf8, utf8Bytes,
-                                utf8Start, utf8End,
-                                bidi, language, script, font,
-                                features, featuresSize));
-        ShapedRun& run = runs.back();
+    this->shapeSegments(utf8, utf8Bytes, bidi, language, script, font, runSegmenter,
+                        features, featuresSize, &runs);
 
+    // The break iterators advance monotonically through the text, so annotate the runs
+    // serially in logical order now that they are all shaped.
+    for (ShapedRun& run : runs) {
         uint32_t previousCluster = 0xFFFFFFFF;
         for (size_t i = 0; i < run.fNumGlyphs; ++i) {
             ShapedGlyph& glyph = run.fGlyphs[i];
@@ -1256,17 +1289,8 @@ void ShapeDontWrapOrReorder::wrap(char const * const utf8, size_t utf8Bytes,
     sk_ignore_unused_variable(width);
     SkTArray<ShapedRun> runs;
 
-    const char* utf8Start = nullptr;
-    const char* utf8End = utf8;
-    while (runSegmenter.advanceRuns()) {
-        utf8Start = utf8End;
-        utf8End = utf8 + runSegmenter.endOfCurrentRun();
-
-        runs.emplace_back(shape(utf8, utf8Bytes,
-                                utf8Start, utf8End,
-                                bidi, language, script, font,
-                                features, featuresSize));
-    }
+    this->shapeSegments(utf8, utf8Bytes, bidi, language, script, font, runSegmenter,
+                        features, featuresSize, &runs);
 
     handler->beginLine();
     for (const auto& run : runs) {
@@ -1303,11 +1327,23 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                                   const FontRunIterator& font,
                                   Feature const * const features, size_t const featuresSize) const
 {
+    RunSegment segment = { utf8Start, utf8End,
+                           font.currentFont(), bidi.currentLevel(),
+                           script.currentScript(), SkString(language.currentLanguage()) };
+    return this->shape(fBuffer.get(), utf8, utf8Bytes, segment, features, featuresSize);
+}
+
+ShapedRun ShaperHarfBuzz::shape(hb_buffer_t* const buffer,
+                                  char const * const utf8,
+                                  size_t const utf8Bytes,
+                                  const RunSegment& segment,
+                                  Feature const * const features, size_t const featuresSize) const
+{
+    const char* utf8Start = segment.fUtf8Start;
+    const char* utf8End = segment.fUtf8End;
     size_t utf8runLength = utf8End - utf8Start;
     ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8runLength),
-                  font.currentFont(), bidi.currentLevel(), nullptr, 0);
-
-    hb_buffer_t* buffer = fBuffer.get();
+                  segment.fFont, segment.fLevel, nullptr, 0);
     SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
     hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
     hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
@@ -1331,13 +1367,13 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     // Add postcontext.
     hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
 
-    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
+    hb_direction_t direction = is_LTR(segment.fLevel) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
     hb_buffer_set_direction(buffer, direction);
-    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()));
+    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)segment.fScript));
     // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
     // The user must provide a language, but may provide data hb_language_from_string cannot use.
     // Use "und" for the undefined language in this case (RFC5646 4.1 5).
-    hb_language_t hbLanguage = hb_language_from_string(language.currentLanguage(), -1);
+    hb_language_t hbLanguage = hb_language_from_string(segment.fLanguage.c_str(), -1);
     if (hbLanguage == HB_LANGUAGE_INVALID) {
         hbLanguage = fUndefinedLanguage;
     }
@@ -1354,13 +1390,13 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     HBFont hbFont;
     {
         SkAutoMutexExclusive lock(gHBFaceCacheMutex);
-        SkFontID dataId = font.currentFont().getTypeface()->uniqueID();
+        SkFontID dataId = segment.fFont.getTypeface()->uniqueID();
         HBFace* hbFaceCached = gHBFaceCache.find(dataId);
         if (!hbFaceCached) {
-            HBFace hbFace(create_hb_face(*font.currentFont().getTypeface()));
+            HBFace hbFace(create_hb_face(*segment.fFont.getTypeface()));
             hbFaceCached = gHBFaceCache.insert(dataId, std::move(hbFace));
         }
-        hbFont = create_hb_font(font.currentFont(), *hbFaceCached);
+        hbFont = create_hb_font(segment.fFont, *hbFaceCached);
     }
     if (!hbFont) {
         return run;
@@ -1399,7 +1435,7 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
 
     run = ShapedRun(RunHandler::Range(utf8Start - utf8, utf8runLength),
-                    font.currentFont(), bidi.currentLevel(),
+                    segment.fFont, segment.fLevel,
                     std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]), len);
     int scaleX, scaleY;
     hb_font_get_scale(hbFont.get(), &scaleX, &scaleY);
@@ -1434,6 +1470,55 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     return run;
 }
 
+void ShaperHarfBuzz::shapeSegments(char const * const utf8, size_t utf8Bytes,
+                                   const BiDiRunIterator& bidi,
+                                   const LanguageRunIterator& language,
+                                   const ScriptRunIterator& script,
+                                   const FontRunIterator& font,
+                                   RunIteratorQueue& runSegmenter,
+                                   const Feature* features, size_t featuresSize,
+                                   SkTArray<ShapedRun>* runs) const
+{
+    SkSTArray<4, RunSegment> segments;
+    const char* utf8Start = nullptr;
+    const char* utf8End = utf8;
+    while (runSegmenter.advanceRuns()) {
+        utf8Start = utf8End;
+        utf8End = utf8 + runSegmenter.endOfCurrentRun();
+        segments.push_back({ utf8Start, utf8End,
+                             font.currentFont(), bidi.currentLevel(),
+                             script.currentScript(), SkString(language.currentLanguage()) });
+    }
+
+    // Reserve a zero glyph run per segment so concurrent tasks can each fill their own slot.
+    for (const RunSegment& segment : segments) {
+        runs->emplace_back(RunHandler::Range(segment.fUtf8Start - utf8,
+                                             segment.fUtf8End - segment.fUtf8Start),
+                           segment.fFont, segment.fLevel, nullptr, 0);
+    }
+
+    if (!fExecutor || segments.count() < 2) {
+        for (int i = 0; i < segments.count(); ++i) {
+            (*runs)[i] = this->shape(fBuffer.get(), utf8, utf8Bytes, segments[i],
+                                     features, featuresSize);
+        }
+        return;
+    }
+
+    SkTaskGroup tasks(*fExecutor);
+    tasks.batch(segments.count(), [&](int i) {
+        // hb_buffer_t is not thread safe and the shared fBuffer belongs to the
+        // calling thread, so each task shapes into its own buffer.
+        HBBuffer buffer(hb_buffer_create());
+        if (!buffer) {
+            return;  // Leaves the zero glyph run in place.
+        }
+        (*runs)[i] = this->shape(buffer.get(), utf8, utf8Bytes, segments[i],
+                                 features, featuresSize);
+    });
+    tasks.wait();
+}
+
 }  // namespace
 
 std::unique_ptr<SkShaper::BiDiRunIterator>
@@ -1484,10 +1569,12 @@ SkShaper::MakeHbIcuScriptRunIterator(const char* utf8, size_t utf8Bytes) {
 std::unique_ptr<SkShaper> SkShaper::MakeShaperDrivenWrapper(sk_sp<SkFontMgr> fontmgr) {
     return MakeHarfBuzz(std::move(fontmgr), true);
 }
-std::unique_ptr<SkShaper> SkShaper::MakeShapeThenWrap(sk_sp<SkFontMgr> fontmgr) {
-    return MakeHarfBuzz(std::move(fontmgr), false);
+std::unique_ptr<SkShaper> SkShaper::MakeShapeThenWrap(sk_sp<SkFontMgr> fontmgr,
+                                                      SkExecutor* executor) {
+    return MakeHarfBuzz(std::move(fontmgr), false, executor);
 }
-std::unique_ptr<SkShaper> SkShaper::MakeShapeDontWrapOrReorder(sk_sp<SkFontMgr> fontmgr) {
+std::unique_ptr<SkShaper> SkShaper::MakeShapeDontWrapOrReorder(sk_sp<SkFontMgr> fontmgr,
+                                                               SkExecutor* executor) {
     #if defined(SK_USING_THIRD_PARTY_ICU)
     if (!SkLoadICU()) {
         SkDEBUGF("SkLoadICU() failed!\n");
@@ -1501,5 +1588,5 @@ std::unique_ptr<SkShaper> SkShaper::MakeShapeDontWrapOrReorder(sk_sp<SkFontMgr>
     }
 
     return std::make_unique<ShapeDontWrapOrReorder>(std::move(buffer), nullptr, nullptr,
-                                                      std::move(fontmgr));
+                                                      std::move(fontmgr), executor);
 }
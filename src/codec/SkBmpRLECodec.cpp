@@ -127,7 +127,7 @@ SkCodec::Result SkBmpRLECodec::onGetPixels(const SkImageInfo& dstInfo,
 }
 
 bool SkBmpRLECodec::initializeStreamBuffer() {
-    fBytesBuffered = this->stream()->read(fStreamBuffer, kBufferSize);
+    fBytesBuffered = fReadAhead->read(fStreamBuffer, kBufferSize);
     if (fBytesBuffered == 0) {
         SkCodecPrintf("Error: could not read RLE image data.\n");
         return false;
@@ -156,7 +156,7 @@ size_t SkBmpRLECodec::checkForMoreData() {
     // Try to read additional bytes from the stream.  There are fCurrRLEByte
     // bytes of additional space remaining in the buffer, assuming that we
     // have already copied remainingBytes to the start of the buffer.
-    size_t additionalBytes = this->stream()->read(buffer, fCurrRLEByte);
+    size_t additionalBytes = fReadAhead->read(buffer, fCurrRLEByte);
 
     // Update counters and return the number of bytes we currently have
     // available.  We are at the start of the buffer again.
@@ -263,6 +263,11 @@ SkCodec::Result SkBmpRLECodec::onPrepareToDecode(const SkImageInfo& dstInfo,
         return SkCodec::kInvalidInput;
     }
 
+    // The decode loop consumes the stream in very small increments.  Insert a
+    // read-ahead layer so the underlying stream sees large batched reads, with
+    // the next chunk prefetched while the current one decodes.
+    fReadAhead = std::make_unique<SkStreamReadAhead>(this->stream());
+
     // Initialize a buffer for encoded RLE data
     if (!this->initializeStreamBuffer()) {
         SkCodecPrintf("Error: cannot initialize stream buffer.\n");
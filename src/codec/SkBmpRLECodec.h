@@ -12,6 +12,7 @@
 #include "src/codec/SkBmpCodec.h"
 #include "src/codec/SkColorTable.h"
 #include "src/codec/SkSampler.h"
+#include "src/codec/SkStreamReadAhead.h"
 
 /*
  * This class implements the decoding for bmp images that use an RLE encoding
@@ -105,6 +106,11 @@ private:
     uint8_t                    fStreamBuffer[kBufferSize];
     size_t                     fBytesBuffered;
 
+    // Batches the many small reads of the RLE decode loop into large chunked
+    // stream reads, prefetching the next chunk while this one decodes.
+    // Recreated by onPrepareToDecode, since the stream may have been rewound.
+    std::unique_ptr<SkStreamReadAhead> fReadAhead;
+
     uint32_t                   fCurrRLEByte;
     int                        fSampleX;
     std::unique_ptr<SkSampler> fSampler;
@@ -8,6 +8,8 @@
 #include "include/codec/SkCodec.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkTime.h"
 #include "include/private/SkHalf.h"
 #include "src/codec/SkBmpCodec.h"
 #include "src/codec/SkCodecPriv.h"
@@ -60,7 +62,18 @@ static std::vector<DecoderProc>* decoders() {
 void SkCodec::Register(
             bool                     (*peek)(const void*, size_t),
             std::unique_ptr<SkCodec> (*make)(std::unique_ptr<SkStream>, SkCodec::Result*)) {
-    decoders()->push_back(DecoderProc{peek, make});
+    // Registered decoders are consulted before the built-ins (and before earlier
+    // registrations), so a hardware-backed decoder can claim a format ahead of the
+    // software codec for it.
+    decoders()->insert(decoders()->begin(), DecoderProc{peek, make});
+}
+
+sk_sp<SkImage> SkCodec::getNativeImage(GrRecordingContext* context) {
+    return this->onGetNativeImage(context);
+}
+
+sk_sp<SkImage> SkCodec::onGetNativeImage(GrRecordingContext*) {
+    return nullptr;
 }
 
 std::unique_ptr<SkCodec> SkCodec::MakeFromStream(
@@ -163,6 +176,7 @@ SkCodec::SkCodec(SkEncodedInfo&& info, XformFormat srcFormat, std::unique_ptr<Sk
     , fOptions()
     , fCurrScanline(-1)
     , fStartedIncrementalDecode(false)
+    , fRegionSessionActive(false)
 {}
 
 SkCodec::~SkCodec() {}
@@ -332,6 +346,8 @@ SkCodec::Result SkCodec::handleFrameIndex(const SkImageInfo& info, void* pixels,
 
 SkCodec::Result SkCodec::getPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
                                    const Options* options) {
+    fRegionSessionActive = false;
+
     if (kUnknown_SkColorType == info.colorType()) {
         return kInvalidConversion;
     }
@@ -376,6 +392,9 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& info, void* pixels, size_t
     fDstInfo = info;
     fOptions = *options;
 
+    const double startNanos = fCollectPhaseStats ? SkTime::GetNSecs() : 0;
+    fPhaseStats = PhaseStats();
+
     // On an incomplete decode, the subclass will specify the number of scanlines that it decoded
     // successfully.
     int rowsDecoded = 0;
@@ -397,12 +416,17 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& info, void* pixels, size_t
                 rowsDecoded);
     }
 
+    if (fCollectPhaseStats) {
+        fPhaseStats.fTotalNanos = SkTime::GetNSecs() - startNanos;
+    }
+
     return result;
 }
 
 SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& info, void* pixels,
         size_t rowBytes, const SkCodec::Options* options) {
     fStartedIncrementalDecode = false;
+    fRegionSessionActive = false;
 
     if (kUnknown_SkColorType == info.colorType()) {
         return kInvalidConversion;
@@ -473,6 +497,7 @@ SkCodec::Result SkCodec::startScanlineDecode(const SkImageInfo& info,
         const SkCodec::Options* options) {
     // Reset fCurrScanline in case of failure.
     fCurrScanline = -1;
+    fRegionSessionActive = false;
 
     if (!this->rewindIfNeeded()) {
         return kCouldNotRewind;
@@ -523,6 +548,75 @@ SkCodec::Result SkCodec::startScanlineDecode(const SkImageInfo& info,
     return kSuccess;
 }
 
+SkCodec::Result SkCodec::getRegion(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
+                                   const SkIRect& region) {
+    if (kUnknown_SkColorType == dstInfo.colorType()) {
+        return kInvalidConversion;
+    }
+    if (nullptr == pixels || rowBytes < dstInfo.minRowBytes()) {
+        return kInvalidParameters;
+    }
+    if (dstInfo.dimensions() != region.size()
+            || !SkIRect::MakeSize(this->dimensions()).contains(region)) {
+        return kInvalidParameters;
+    }
+
+    Result result = this->onGetRegion(dstInfo, pixels, rowBytes, region);
+    if (kUnimplemented != result) {
+        return result;
+    }
+
+    // Shared scanline session: decode full-width rows and copy out the requested window.
+    // Tiles requested in increasing row order continue from the previous tile's last row;
+    // anything else restarts the decode from the top.
+    const SkImageInfo fullInfo = dstInfo.makeDimensions(this->dimensions());
+    const bool reuse = fRegionSessionActive
+            && fCurrScanline >= 0
+            && fDstInfo == fullInfo
+            && kTopDown_SkScanlineOrder == this->getScanlineOrder()
+            && this->nextScanline() <= region.top();
+    if (!reuse) {
+        result = this->startScanlineDecode(fullInfo);
+        if (kSuccess != result) {
+            return result;
+        }
+        if (kTopDown_SkScanlineOrder != this->getScanlineOrder()) {
+            // Out-of-order and bottom-up decoders cannot hand back just the rows covering
+            // region.
+            return kUnimplemented;
+        }
+        fRegionSessionActive = true;
+    }
+
+    if (this->nextScanline() < region.top()) {
+        if (!this->skipScanlines(region.top() - this->nextScanline())) {
+            fRegionSessionActive = false;
+            return kIncompleteInput;
+        }
+    }
+
+    int rows;
+    if (0 == region.x() && region.width() == fullInfo.width()) {
+        rows = this->getScanlines(pixels, region.height(), rowBytes);
+    } else {
+        SkAutoTMalloc<uint8_t> rowStorage(fullInfo.minRowBytes());
+        const size_t offset = region.x() * fullInfo.bytesPerPixel();
+        const size_t windowBytes = region.width() * fullInfo.bytesPerPixel();
+        for (rows = 0; rows < region.height(); rows++) {
+            if (1 != this->getScanlines(rowStorage.get(), 1, fullInfo.minRowBytes())) {
+                break;
+            }
+            memcpy(SkTAddOffset<void>(pixels, rows * rowBytes), rowStorage.get() + offset,
+                   windowBytes);
+        }
+    }
+    if (rows < region.height()) {
+        fRegionSessionActive = false;
+        return kIncompleteInput;
+    }
+    return kSuccess;
+}
+
 int SkCodec::getScanlines(void* dst, int countLines, size_t rowBytes) {
     if (fCurrScanline < 0) {
         return 0;
@@ -679,11 +773,17 @@ bool SkCodec::initializeColorXform(const SkImageInfo& dstInfo, SkEncodedInfo::Al
 }
 
 void SkCodec::applyColorXform(void* dst, const void* src, int count) const {
+    const double startNanos = fCollectPhaseStats ? SkTime::GetNSecs() : 0;
+
     // It is okay for srcProfile to be null. This will use sRGB.
     const auto* srcProfile = fEncodedInfo.profile();
     SkAssertResult(skcms_Transform(src, fSrcXformFormat, skcms_AlphaFormat_Unpremul, srcProfile,
                                    dst, fDstXformFormat, fDstXformAlphaFormat, &fDstProfile,
                                    count));
+
+    if (fCollectPhaseStats) {
+        fPhaseStats.fXformNanos += SkTime::GetNSecs() - startNanos;
+    }
 }
 
 std::vector<SkCodec::FrameInfo> SkCodec::getFrameInfo() {
@@ -9,6 +9,11 @@
 #include "src/codec/SkCodecImageGenerator.h"
 #include "src/core/SkPixmapPriv.h"
 
+#if SK_SUPPORT_GPU
+#include "src/gpu/SkGr.h"
+#include "src/image/SkImage_Base.h"
+#endif
+
 std::unique_ptr<SkImageGenerator> SkCodecImageGenerator::MakeFromEncodedCodec(sk_sp<SkData> data) {
     auto codec = SkCodec::MakeFromData(data);
     if (nullptr == codec) {
@@ -108,3 +113,26 @@ SkISize SkCodecImageGenerator::getScaledDimensions(float desiredScale) const {
     }
     return size;
 }
+
+#if SK_SUPPORT_GPU
+GrSurfaceProxyView SkCodecImageGenerator::onGenerateTexture(GrRecordingContext* ctx,
+                                                            const SkImageInfo& info,
+                                                            const SkIPoint& origin,
+                                                            GrMipmapped mipMapped,
+                                                            GrImageTexGenPolicy texGenPolicy) {
+    // A hardware-backed codec may already hold its output in device memory (e.g. a
+    // dmabuf-backed frame imported into the context); hand that view out rather than
+    // decoding through CPU memory. Only the kDraw policy may share an existing texture,
+    // and subsets or conversions still take the CPU path.
+    if (GrImageTexGenPolicy::kDraw != texGenPolicy ||
+            !origin.isZero() || info.dimensions() != this->getInfo().dimensions()) {
+        return {};
+    }
+
+    sk_sp<SkImage> nativeImage = fCodec->getNativeImage(ctx);
+    if (!nativeImage || !nativeImage->isTextureBacked()) {
+        return {};
+    }
+    return as_IB(nativeImage)->refView(ctx, mipMapped);
+}
+#endif
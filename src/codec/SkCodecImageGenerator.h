@@ -106,6 +106,12 @@ protected:
                           const SkYUVAIndex[SkYUVAIndex::kIndexCount],
                           void* planes[]) override;
 
+#if SK_SUPPORT_GPU
+    GrSurfaceProxyView onGenerateTexture(GrRecordingContext*, const SkImageInfo&,
+                                         const SkIPoint&, GrMipmapped,
+                                         GrImageTexGenPolicy) override;
+#endif
+
 private:
     /*
      * Takes ownership of codec
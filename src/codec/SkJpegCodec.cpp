@@ -8,6 +8,7 @@
 #include "src/codec/SkJpegCodec.h"
 
 #include "include/codec/SkCodec.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkColorData.h"
@@ -16,8 +17,12 @@
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkJpegDecoderMgr.h"
 #include "src/codec/SkParseEncodedOrigin.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pdf/SkJpegInfo.h"
 
+#include <atomic>
+#include <vector>
+
 // stdio is needed for libjpeg-turbo
 #include <stdio.h>
 #include "src/codec/SkJpegUtility.h"
@@ -256,6 +261,9 @@ SkJpegCodec::SkJpegCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
     , fSwizzleSrcRow(nullptr)
     , fColorXformSrcRow(nullptr)
     , fSwizzlerSubset(SkIRect::MakeEmpty())
+    , fRegionIndexState(RegionIndexState::kUninitialized)
+    , fRegionEntropyStart(0)
+    , fRegionRowsPerSegment(0)
 {}
 
 /*
@@ -502,6 +510,352 @@ int SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes
     return count;
 }
 
+// Upper bound on the number of tasks readRowsParallel() will create. Each task re-parses the
+// (small) jpeg header, so we want chunky tasks; this is plenty to saturate the thread pools
+// that clients install via SkExecutor::SetDefault().
+static constexpr int kMaxParallelDecodeTasks = 16;
+
+/*
+ * Walks the marker segments of a jpeg stream and returns the offset of the first byte of
+ * entropy-coded data (just past the SOS header), or 0 on failure. Markers embedded in
+ * APPn payloads (e.g. an EXIF thumbnail) are skipped along with their segments.
+ */
+static size_t find_entropy_start(const uint8_t* data, size_t len) {
+    size_t pos = 2;  // skip the SOI marker
+    while (pos + 4 <= len) {
+        if (0xFF != data[pos]) {
+            return 0;
+        }
+        uint8_t marker = data[pos + 1];
+        if (0xFF == marker) {
+            // Fill byte preceding a marker
+            pos++;
+            continue;
+        }
+        if (0xD8 == marker || 0x01 == marker || (marker >= 0xD0 && marker <= 0xD7)) {
+            // Standalone markers have no length field
+            pos += 2;
+            continue;
+        }
+        size_t segmentLength = (data[pos + 2] << 8) | data[pos + 3];
+        if (segmentLength < 2 || pos + 2 + segmentLength > len) {
+            return 0;
+        }
+        pos += 2 + segmentLength;
+        if (0xDA == marker) {
+            // SOS: entropy-coded data follows the header we just skipped
+            return pos;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Returns the starting offsets of each restart segment in the first scan, beginning with
+ * entropyStart itself. Within entropy-coded data, a literal 0xFF is always followed by a
+ * stuffed 0x00, so any 0xFF 0xD0..0xD7 pair is a restart marker.
+ */
+static std::vector<size_t> find_restart_segments(const uint8_t* data, size_t len,
+                                                 size_t entropyStart) {
+    std::vector<size_t> segments;
+    segments.push_back(entropyStart);
+    for (size_t pos = entropyStart; pos + 1 < len; pos++) {
+        if (0xFF == data[pos]) {
+            uint8_t marker = data[pos + 1];
+            if (marker >= 0xD0 && marker <= 0xD7) {
+                segments.push_back(pos + 2);
+                pos++;
+            } else if (0x00 != marker && 0xFF != marker) {
+                // EOI, DNL, or the next scan's header: end of this scan's data
+                break;
+            }
+        }
+    }
+    return segments;
+}
+
+/*
+ * Builds a standalone jpeg covering the given range of restart segments: the original
+ * header, the segments' entropy data, and an EOI. The decoder checks that restart markers
+ * are numbered sequentially from RST0, but the range's markers kept their position in the
+ * original modulo-8 cycle, so they are renumbered as if the range were a whole image.
+ */
+static sk_sp<SkData> make_restart_chunk(const uint8_t* base, size_t streamLength,
+                                        size_t entropyStart, const std::vector<size_t>& segments,
+                                        int startSegment, int stopSegment) {
+    const size_t dataStart = segments[startSegment];
+    const size_t dataStop = stopSegment < (int) segments.size() ? segments[stopSegment]
+                                                                : streamLength;
+    sk_sp<SkData> chunk = SkData::MakeUninitialized(entropyStart + (dataStop - dataStart) + 2);
+    uint8_t* chunkData = reinterpret_cast<uint8_t*>(chunk->writable_data());
+    memcpy(chunkData, base, entropyStart);
+    memcpy(chunkData + entropyStart, base + dataStart, dataStop - dataStart);
+    chunkData[chunk->size() - 2] = 0xFF;
+    chunkData[chunk->size() - 1] = 0xD9;
+
+    for (int segment = startSegment + 1;
+            segment < (int) segments.size() && segments[segment] <= dataStop; segment++) {
+        size_t marker = entropyStart + (segments[segment] - dataStart) - 1;
+        chunkData[marker] = 0xD0 + ((segment - startSegment - 1) & 7);
+    }
+    return chunk;
+}
+
+bool SkJpegCodec::readRowsParallel(const SkImageInfo& dstInfo, void* dst, size_t rowBytes) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    // Worker threads write scanlines straight into dst, so per-row swizzling or color
+    // xforms rule this path out, as does native scaling (restart intervals are defined
+    // in full-resolution MCUs).
+    if (fSwizzler || this->colorXform() || dinfo->scale_num != dinfo->scale_denom) {
+        return false;
+    }
+
+    // A restart segment is only an independent row range in a single-scan image, and only
+    // when the restart interval covers whole MCU rows.
+    if (jpeg_has_multiple_scans(dinfo) || dinfo->arith_code ||
+            0 == dinfo->restart_interval || 0 != dinfo->restart_interval % dinfo->MCUs_per_row) {
+        return false;
+    }
+
+    // Workers re-read the compressed data at arbitrary offsets, so it must be in memory.
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(this->stream()->getMemoryBase());
+    if (!base || !this->stream()->hasLength()) {
+        return false;
+    }
+    const size_t streamLength = this->stream()->getLength();
+
+    const size_t entropyStart = find_entropy_start(base, streamLength);
+    if (0 == entropyStart) {
+        return false;
+    }
+    const std::vector<size_t> segments = find_restart_segments(base, streamLength, entropyStart);
+
+    const int rowsPerSegment = (dinfo->restart_interval / dinfo->MCUs_per_row)
+                               * DCTSIZE * dinfo->max_v_samp_factor;
+    const int height = dstInfo.height();
+    const int totalSegments = (height + rowsPerSegment - 1) / rowsPerSegment;
+    if ((int) segments.size() < totalSegments) {
+        // Truncated or corrupt stream; let the serial path report the failure row.
+        return false;
+    }
+    int segmentsPerTask = (totalSegments + kMaxParallelDecodeTasks - 1) / kMaxParallelDecodeTasks;
+    const int numTasks = (totalSegments + segmentsPerTask - 1) / segmentsPerTask;
+    if (numTasks < 2) {
+        return false;
+    }
+
+    const J_COLOR_SPACE outColorSpace = dinfo->out_color_space;
+    const J_DITHER_MODE ditherMode = dinfo->dither_mode;
+    const size_t scratchRowBytes = get_row_bytes(dinfo);
+
+    std::atomic<bool> failed(false);
+    SkTaskGroup taskGroup;
+    for (int task = 0; task < numTasks; task++) {
+        const int startSegment = task * segmentsPerTask;
+        const int stopSegment = std::min(startSegment + segmentsPerTask, totalSegments);
+        const int startRow = startSegment * rowsPerSegment;
+        const int rowCount = std::min(stopSegment * rowsPerSegment, height) - startRow;
+
+        // The chroma upsamplers read up to one MCU row beyond the rows being produced, so
+        // decode one extra leading segment (discarding its rows into a scratch buffer) and
+        // append one extra trailing segment of data as lookahead context. This keeps every
+        // row bit-identical to a serial decode, including at task seams.
+        const int decodeStart = std::max(startSegment - 1, 0);
+        const int contextStop = std::min(stopSegment + 1, (int) segments.size());
+        taskGroup.add([=, &failed, &segments] {
+            SkMemoryStream chunkStream(make_restart_chunk(base, streamLength, entropyStart,
+                                                          segments, decodeStart, contextStop));
+            JpegDecoderMgr decoderMgr(&chunkStream);
+            skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+            if (setjmp(jmp)) {
+                failed = true;
+                return;
+            }
+            decoderMgr.init();
+            if (JPEG_HEADER_OK != jpeg_read_header(decoderMgr.dinfo(), true)) {
+                failed = true;
+                return;
+            }
+            decoderMgr.dinfo()->out_color_space = outColorSpace;
+            decoderMgr.dinfo()->dither_mode = ditherMode;
+            if (!jpeg_start_decompress(decoderMgr.dinfo())) {
+                failed = true;
+                return;
+            }
+            SkAutoTMalloc<JSAMPLE> scratch(scratchRowBytes);
+            for (int y = (startSegment - decodeStart) * rowsPerSegment; y --> 0; ) {
+                JSAMPLE* scratchRow = scratch.get();
+                if (1 != jpeg_read_scanlines(decoderMgr.dinfo(), &scratchRow, 1)) {
+                    failed = true;
+                    return;
+                }
+            }
+            JSAMPLE* row = SkTAddOffset<JSAMPLE>(dst, startRow * rowBytes);
+            for (int y = 0; y < rowCount; y++) {
+                if (1 != jpeg_read_scanlines(decoderMgr.dinfo(), &row, 1)) {
+                    failed = true;
+                    return;
+                }
+                row = SkTAddOffset<JSAMPLE>(row, rowBytes);
+            }
+        });
+    }
+    taskGroup.wait();
+
+    // On failure the main decompress struct has not consumed any scanlines, so the caller
+    // can still run the serial path from row zero.
+    return !failed.load();
+}
+
+bool SkJpegCodec::ensureRegionIndex() {
+    if (RegionIndexState::kUninitialized != fRegionIndexState) {
+        return RegionIndexState::kReady == fRegionIndexState;
+    }
+    fRegionIndexState = RegionIndexState::kUnsupported;
+
+    // The header has been parsed (by the constructor or the last rewind), which is all the
+    // state the index needs; region decodes never touch this decompress struct again.
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (jpeg_has_multiple_scans(dinfo) || dinfo->arith_code || 0 == dinfo->restart_interval) {
+        return false;
+    }
+
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(this->stream()->getMemoryBase());
+    if (!base || !this->stream()->hasLength()) {
+        return false;
+    }
+    const size_t streamLength = this->stream()->getLength();
+
+    const size_t entropyStart = find_entropy_start(base, streamLength);
+    if (0 == entropyStart) {
+        return false;
+    }
+
+    // In a single interleaved scan, an MCU row is DCTSIZE * max_v_samp_factor pixel rows
+    // and holds ceil(width / (DCTSIZE * max_h_samp_factor)) MCUs.
+    const int mcusPerRow = (dinfo->image_width + DCTSIZE * dinfo->max_h_samp_factor - 1)
+                           / (DCTSIZE * dinfo->max_h_samp_factor);
+    if (0 != dinfo->restart_interval % mcusPerRow) {
+        return false;
+    }
+    const int rowsPerSegment = (dinfo->restart_interval / mcusPerRow)
+                               * DCTSIZE * dinfo->max_v_samp_factor;
+
+    std::vector<size_t> segments = find_restart_segments(base, streamLength, entropyStart);
+    const int totalSegments = ((int) dinfo->image_height + rowsPerSegment - 1) / rowsPerSegment;
+    if ((int) segments.size() < totalSegments) {
+        return false;
+    }
+
+    fRegionEntropyStart = entropyStart;
+    fRegionRowsPerSegment = rowsPerSegment;
+    fRegionSegments = std::move(segments);
+    fRegionIndexState = RegionIndexState::kReady;
+    return true;
+}
+
+SkCodec::Result SkJpegCodec::onGetRegion(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                         const SkIRect& region) {
+    // This fast path hands decoded rows to the caller as-is; anything needing a color
+    // xform or the CMYK swizzler falls back to the shared scanline session.
+    if (dstInfo.colorSpace()
+            && !SkColorSpace::Equals(dstInfo.colorSpace(), this->getInfo().colorSpace())) {
+        return kUnimplemented;
+    }
+    const J_COLOR_SPACE encodedColorType = fDecoderMgr->dinfo()->jpeg_color_space;
+    if (JCS_CMYK == encodedColorType || JCS_YCCK == encodedColorType) {
+        return kUnimplemented;
+    }
+    J_COLOR_SPACE outColorSpace;
+    switch (dstInfo.colorType()) {
+        case kRGBA_8888_SkColorType:
+            outColorSpace = JCS_EXT_RGBA;
+            break;
+        case kBGRA_8888_SkColorType:
+            outColorSpace = JCS_EXT_BGRA;
+            break;
+        case kRGB_565_SkColorType:
+            outColorSpace = JCS_RGB565;
+            break;
+        case kGray_8_SkColorType:
+            if (JCS_GRAYSCALE != encodedColorType) {
+                return kUnimplemented;
+            }
+            outColorSpace = JCS_GRAYSCALE;
+            break;
+        default:
+            return kUnimplemented;
+    }
+
+    if (!this->ensureRegionIndex()) {
+        return kUnimplemented;
+    }
+
+    // Decode only the restart segments covering the requested rows, plus one leading and
+    // one trailing segment so the chroma upsamplers see real neighboring rows (the same
+    // scheme readRowsParallel uses at task seams).
+    const int rowsPerSegment = fRegionRowsPerSegment;
+    const int startSegment = region.top() / rowsPerSegment;
+    const int stopSegment = (region.bottom() + rowsPerSegment - 1) / rowsPerSegment;
+    const int decodeStart = std::max(startSegment - 1, 0);
+    const int contextStop = std::min(stopSegment + 1, (int) fRegionSegments.size());
+
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(this->stream()->getMemoryBase());
+    SkASSERT(base);
+    SkMemoryStream chunkStream(make_restart_chunk(base, this->stream()->getLength(),
+                                                  fRegionEntropyStart, fRegionSegments,
+                                                  decodeStart, contextStop));
+    JpegDecoderMgr decoderMgr(&chunkStream);
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+    if (setjmp(jmp)) {
+        return decoderMgr.returnFailure("onGetRegion", kInvalidInput);
+    }
+    decoderMgr.init();
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true)) {
+        return kInvalidInput;
+    }
+    dinfo->out_color_space = outColorSpace;
+    if (JCS_RGB565 == outColorSpace) {
+        dinfo->dither_mode = JDITHER_NONE;
+    }
+    if (!jpeg_start_decompress(dinfo)) {
+        return kInvalidInput;
+    }
+
+    // Have libjpeg-turbo crop to the requested columns and copy out the requested window
+    // below. The crop is padded by one MCU on each side (beyond the IDCT block alignment
+    // the library applies itself) because the chroma upsamplers edge-replicate at the
+    // crop boundary, and columns near it would differ from a full-width decode.
+    const int mcuWidth = DCTSIZE * dinfo->max_h_samp_factor;
+    const int padLeft = std::max(region.x() - mcuWidth, 0);
+    const int padRight = std::min(region.right() + mcuWidth, this->dimensions().width());
+    unsigned int startX = padLeft;
+    unsigned int width = padRight - padLeft;
+    jpeg_crop_scanline(dinfo, &startX, &width);
+    SkASSERT(startX <= (unsigned int) region.x());
+
+    SkAutoTMalloc<JSAMPLE> scratch(get_row_bytes(dinfo));
+    for (int y = region.top() - decodeStart * rowsPerSegment; y --> 0; ) {
+        JSAMPLE* scratchRow = scratch.get();
+        if (1 != jpeg_read_scanlines(dinfo, &scratchRow, 1)) {
+            return kIncompleteInput;
+        }
+    }
+    const size_t bpp = dstInfo.bytesPerPixel();
+    const size_t offset = (region.x() - startX) * bpp;
+    const size_t windowBytes = region.width() * bpp;
+    for (int y = 0; y < region.height(); y++) {
+        JSAMPLE* scratchRow = scratch.get();
+        if (1 != jpeg_read_scanlines(dinfo, &scratchRow, 1)) {
+            return kIncompleteInput;
+        }
+        memcpy(SkTAddOffset<void>(dst, y * rowBytes), scratchRow + offset, windowBytes);
+    }
+    return kSuccess;
+}
+
 /*
  * This is a bit tricky.  We only need the swizzler to do format conversion if the jpeg is
  * encoded as CMYK.
@@ -557,6 +911,12 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kInternalError;
     }
 
+    // When the stream uses restart intervals, whole MCU row ranges can be decoded
+    // independently; farm them out before falling back to the serial scanline loop.
+    if (this->readRowsParallel(dstInfo, dst, dstRowBytes)) {
+        return kSuccess;
+    }
+
     int rows = this->readRows(dstInfo, dst, dstRowBytes, dstInfo.height(), options);
     if (rows < dstInfo.height()) {
         *rowsDecoded = rows;
@@ -14,6 +14,8 @@
 #include "include/private/SkTemplates.h"
 #include "src/codec/SkSwizzler.h"
 
+#include <vector>
+
 class JpegDecoderMgr;
 
 /*
@@ -109,6 +111,27 @@ private:
     bool SK_WARN_UNUSED_RESULT allocateStorage(const SkImageInfo& dstInfo);
     int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
 
+    /*
+     * Decodes restart-marker-delimited MCU row ranges in parallel across the SkExecutor
+     * behind SkTaskGroup, using a separate decompress struct per task. Returns false if
+     * this image or destination is not eligible; the caller then decodes serially.
+     */
+    bool readRowsParallel(const SkImageInfo& dstInfo, void* dst, size_t rowBytes);
+
+    /*
+     * Region decoding. Decodes only the restart segments covering the requested rows with
+     * a temporary decompress struct, leaving the main decompress struct untouched.
+     */
+    Result onGetRegion(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                       const SkIRect& region) override;
+
+    /*
+     * Builds (once) the restart segment index that onGetRegion seeks with. Returns false
+     * if this image does not qualify (no restart intervals covering whole MCU rows, a
+     * progressive image, or a stream that is not in memory).
+     */
+    bool ensureRegionIndex();
+
     /*
      * Scanline decoding.
      */
@@ -136,6 +159,18 @@ private:
 
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
+    // Lazily-built index of restart segment offsets, used by onGetRegion() to begin
+    // entropy decoding near the requested rows.
+    enum class RegionIndexState {
+        kUninitialized,
+        kUnsupported,
+        kReady,
+    };
+    RegionIndexState                   fRegionIndexState;
+    size_t                             fRegionEntropyStart;
+    int                                fRegionRowsPerSegment;
+    std::vector<size_t>                fRegionSegments;
+
     friend class SkRawCodec;
 
     typedef SkCodec INHERITED;
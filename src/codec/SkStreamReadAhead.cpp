@@ -0,0 +1,90 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkStreamReadAhead.h"
+
+#include <cstring>
+
+#include "include/core/SkStream.h"
+#include "include/private/SkTemplates.h"
+
+SkStreamReadAhead::SkStreamReadAhead(SkStream* stream)
+    : fStream(stream)
+    , fFront(new uint8_t[kChunkSize])
+    , fBack(new uint8_t[kChunkSize])
+    , fFrontSize(0)
+    , fFrontPos(0)
+    , fBackSize(0)
+    , fPrefetchInFlight(false)
+    , fStreamExhausted(false)
+{
+    SkASSERT(stream);
+}
+
+SkStreamReadAhead::~SkStreamReadAhead() {
+    if (fPrefetchInFlight) {
+        fTaskGroup.wait();
+    }
+}
+
+size_t SkStreamReadAhead::read(void* dst, size_t size) {
+    size_t total = 0;
+    while (size > 0) {
+        if (fFrontPos == fFrontSize) {
+            if (!this->nextChunk()) {
+                break;
+            }
+        }
+        const size_t bytes = std::min(size, fFrontSize - fFrontPos);
+        if (dst) {
+            memcpy(SkTAddOffset<void>(dst, total), fFront.get() + fFrontPos, bytes);
+        }
+        fFrontPos += bytes;
+        total += bytes;
+        size -= bytes;
+    }
+    return total;
+}
+
+bool SkStreamReadAhead::nextChunk() {
+    if (fPrefetchInFlight) {
+        fTaskGroup.wait();
+        fPrefetchInFlight = false;
+    } else if (!fStreamExhausted) {
+        // First read (or the executor ran us synchronously and was drained):
+        // fill the back chunk on the calling thread.
+        fBackSize = fStream->read(fBack.get(), kChunkSize);
+        if (fBackSize < kChunkSize) {
+            fStreamExhausted = true;
+        }
+    }
+
+    if (0 == fBackSize) {
+        return false;
+    }
+
+    std::swap(fFront, fBack);
+    fFrontSize = fBackSize;
+    fFrontPos = 0;
+    fBackSize = 0;
+
+    this->startPrefetch();
+    return true;
+}
+
+void SkStreamReadAhead::startPrefetch() {
+    if (fStreamExhausted) {
+        return;
+    }
+    fPrefetchInFlight = true;
+    fTaskGroup.add([this] {
+        fBackSize = fStream->read(fBack.get(), kChunkSize);
+        if (fBackSize < kChunkSize) {
+            fStreamExhausted = true;
+        }
+    });
+}
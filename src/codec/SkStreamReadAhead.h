@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkStreamReadAhead_DEFINED
+#define SkStreamReadAhead_DEFINED
+
+#include "include/core/SkTypes.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <memory>
+
+class SkStream;
+
+/*
+ *  Batches many small SkStream reads into large chunked reads, and prefetches
+ *  the next chunk on a background thread while the caller consumes the current
+ *  one.  This matters for stream implementations with high per-call latency
+ *  (e.g. network or disk backed streams), where codecs like SkBmpRLECodec and
+ *  SkWbmpCodec would otherwise issue hundreds of tiny reads.
+ *
+ *  The underlying stream is unowned and must outlive this object.  While an
+ *  SkStreamReadAhead is in use, the stream's position is unspecified - all
+ *  reads must go through the read-ahead.  Destroy (or recreate) it before
+ *  touching the stream directly again, e.g. across a rewind.
+ */
+class SkStreamReadAhead {
+public:
+    // Large enough to amortize per-read latency without holding much more
+    // memory than the two chunks (128K total) per active decode.
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    explicit SkStreamReadAhead(SkStream* stream);
+
+    // Blocks until any in-flight prefetch completes.
+    ~SkStreamReadAhead();
+
+    /*
+     *  Semantics of SkStream::read: copies up to |size| bytes into |dst| and
+     *  returns the number of bytes actually read.  A null |dst| skips instead
+     *  of copying.
+     */
+    size_t read(void* dst, size_t size);
+
+    size_t skip(size_t size) {
+        return this->read(nullptr, size);
+    }
+
+private:
+    // Makes the next chunk current, waiting on the prefetch if one is in
+    // flight, and kicks off a prefetch of the chunk after it.  Returns false
+    // when the stream is exhausted.
+    bool nextChunk();
+
+    void startPrefetch();
+
+    SkStream*                  fStream;        // unowned
+    std::unique_ptr<uint8_t[]> fFront;         // chunk being consumed
+    std::unique_ptr<uint8_t[]> fBack;          // chunk being prefetched
+    size_t                     fFrontSize;
+    size_t                     fFrontPos;
+    size_t                     fBackSize;
+    bool                       fPrefetchInFlight;
+    bool                       fStreamExhausted;
+    SkTaskGroup                fTaskGroup;
+};
+
+#endif  // SkStreamReadAhead_DEFINED
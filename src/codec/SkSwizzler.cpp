@@ -228,6 +228,26 @@ static void swizzle_small_index_to_n32(
     }
 }
 
+static void fast_swizzle_small_index_to_n32(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.  For small indices, bpp is a bit count.
+    SkASSERT(deltaSrc == bpp);
+
+    if (0 != offset % 8) {
+        // A subset can start mid-byte.  The optimized procs only handle rows that
+        // start on a byte boundary.
+        swizzle_small_index_to_n32(dst, src, width, bpp, deltaSrc, offset, ctable);
+        return;
+    }
+
+    // Note that there is no need to distinguish between RGB and BGR.
+    // The color table is already in the destination order.
+    SkOpts::small_index_to_8888((uint32_t*) dst, src + offset / 8, width, bpp, ctable);
+}
+
 // kIndex
 
 static void swizzle_index_to_n32(
@@ -909,6 +929,7 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(const SkEncodedInfo& encodedInfo,
                         case kRGBA_8888_SkColorType:
                         case kBGRA_8888_SkColorType:
                             proc = &swizzle_small_index_to_n32;
+                            fastProc = &fast_swizzle_small_index_to_n32;
                             break;
                         case kRGB_565_SkColorType:
                             proc = &swizzle_small_index_to_565;
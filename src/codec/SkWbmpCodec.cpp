@@ -90,7 +90,7 @@ bool SkWbmpCodec::onRewind() {
 }
 
 bool SkWbmpCodec::readRow(uint8_t* row) {
-    return this->stream()->read(row, fSrcRowBytes) == fSrcRowBytes;
+    return fReadAhead->read(row, fSrcRowBytes) == fSrcRowBytes;
 }
 
 SkWbmpCodec::SkWbmpCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream)
@@ -125,6 +125,9 @@ SkCodec::Result SkWbmpCodec::onGetPixels(const SkImageInfo& info,
                                                             options);
     SkASSERT(swizzler);
 
+    // Batch the row reads into chunked stream reads with read-ahead.
+    fReadAhead = std::make_unique<SkStreamReadAhead>(this->stream());
+
     // Perform the decode
     SkISize size = info.dimensions();
     SkAutoTMalloc<uint8_t> src(fSrcRowBytes);
@@ -174,7 +177,7 @@ int SkWbmpCodec::onGetScanlines(void* dst, int count, size_t dstRowBytes) {
 
 bool SkWbmpCodec::onSkipScanlines(int count) {
     const size_t bytesToSkip = count * fSrcRowBytes;
-    return this->stream()->skip(bytesToSkip) == bytesToSkip;
+    return fReadAhead->skip(bytesToSkip) == bytesToSkip;
 }
 
 SkCodec::Result SkWbmpCodec::onStartScanlineDecode(const SkImageInfo& dstInfo,
@@ -184,6 +187,8 @@ SkCodec::Result SkWbmpCodec::onStartScanlineDecode(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    fReadAhead = std::make_unique<SkStreamReadAhead>(this->stream());
+
     fSwizzler = SkSwizzler::Make(this->getEncodedInfo(), nullptr, dstInfo, options);
     SkASSERT(fSwizzler);
 
@@ -10,6 +10,7 @@
 
 #include "include/codec/SkCodec.h"
 #include "include/core/SkColorSpace.h"
+#include "src/codec/SkStreamReadAhead.h"
 #include "src/codec/SkSwizzler.h"
 
 class SkWbmpCodec final : public SkCodec {
@@ -47,6 +48,11 @@ private:
 
     const size_t                fSrcRowBytes;
 
+    // Batches row reads into large chunked stream reads with the next chunk
+    // prefetched while the current one is consumed.  Recreated whenever a
+    // decode starts, since the stream may have been rewound.
+    std::unique_ptr<SkStreamReadAhead> fReadAhead;
+
     // Used for scanline decodes:
     std::unique_ptr<SkSwizzler> fSwizzler;
     SkAutoTMalloc<uint8_t>      fSrcBuffer;
@@ -14,6 +14,7 @@
 #include "src/core/SkBlitter.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkScan.h"
+#include "src/core/SkUtils.h"
 #include <atomic>
 #include <utility>
 
@@ -504,6 +505,52 @@ bool SkAAClip::trimTopBottom() {
     return true;
 }
 
+// Restrict the clip to [top, bottom), which must lie within our bounds, when
+// the restriction can't touch any row's encoding (the caller has checked that
+// the x-range is unchanged).  We drop whole rows and reuse the surviving rows'
+// run data byte-for-byte, rather than re-merging through a Builder.  Like
+// trimLeftRight(), we don't spend time re-packing the data slab: rows we
+// dropped just leave dead bytes behind, addressed around via fOffset.
+bool SkAAClip::trimToYRange(int top, int bottom) {
+    SkASSERT(fRunHead);
+    SkASSERT(top >= fBounds.fTop && bottom <= fBounds.fBottom);
+    SkASSERT(top < bottom);
+
+    const RunHead* head = fRunHead;
+    const YOffset* yoff = head->yoffsets();
+    const int relTop = top - fBounds.fTop;
+    const int relBot = bottom - fBounds.fTop;    // exclusive
+
+    // Each row covers (prevRow.fY, fY], so the first row we keep is the first
+    // one reaching relTop, and the last is the first one reaching relBot - 1.
+    // Both searches must succeed: the last row's fY is bounds.height() - 1.
+    int first = 0;
+    while (yoff[first].fY < relTop) {
+        first += 1;
+    }
+    int last = first;
+    while (yoff[last].fY < relBot - 1) {
+        last += 1;
+    }
+
+    const int rowCount = last - first + 1;
+    RunHead* newHead = RunHead::Alloc(rowCount, head->fDataSize);
+    YOffset* dst = newHead->yoffsets();
+    for (int i = 0; i < rowCount; ++i) {
+        dst[i].fY = std::min(yoff[first + i].fY, relBot - 1) - relTop;
+        dst[i].fOffset = yoff[first + i].fOffset;
+    }
+    memcpy(newHead->data(), head->data(), head->fDataSize);
+
+    this->freeRuns();
+    fBounds.fTop = top;
+    fBounds.fBottom = bottom;
+    fRunHead = newHead;
+
+    // The rows now at the top and bottom may be all zeros, so re-tighten.
+    return this->trimTopBottom() && this->trimLeftRight();
+}
+
 // can't validate before we're done, since trimming is part of the process of
 // making us valid after the Builder. Since we build from top to bottom, its
 // possible our fBounds.fBottom is bigger than our last scanline of data, so
@@ -686,16 +733,25 @@ bool SkAAClip::setRect(const SkRect& r, bool doAA) {
 
 static void append_run(SkTDArray<uint8_t>& array, uint8_t value, int count) {
     SkASSERT(count >= 0);
-    while (count > 0) {
-        int n = count;
-        if (n > 255) {
-            n = 255;
-        }
-        uint8_t* data = array.append(2);
-        data[0] = n;
-        data[1] = value;
-        count -= n;
+    if (count <= 0) {
+        return;
+    }
+    // One segment covers up to 255 pixels.  Reserve every segment at once and
+    // fill the saturated (255, value) segments with a 16-bit memset, rather
+    // than growing the array a pair at a time.
+    int segments = (count + 254) / 255;
+    uint8_t* data = array.append(2 * segments);
+    if (segments > 1) {
+        uint16_t pair;
+        const uint8_t bytes[2] = { 255, value };
+        memcpy(&pair, bytes, sizeof(pair));
+        sk_memset16(reinterpret_cast<uint16_t*>(data), pair, segments - 1);
+        data += 2 * (segments - 1);
+        count -= 255 * (segments - 1);
     }
+    SkASSERT(count > 0 && count <= 255);
+    data[0] = SkToU8(count);
+    data[1] = value;
 }
 
 bool SkAAClip::setRegion(const SkRegion& rgn) {
@@ -1140,16 +1196,7 @@ private:
     }
 
     static void AppendRun(SkTDArray<uint8_t>& data, U8CPU alpha, int count) {
-        do {
-            int n = count;
-            if (n > 255) {
-                n = 255;
-            }
-            uint8_t* ptr = data.append(2);
-            ptr[0] = n;
-            ptr[1] = alpha;
-            count -= n;
-        } while (count > 0);
+        append_run(data, SkToU8(alpha), count);
     }
 };
 
@@ -1688,6 +1735,11 @@ bool SkAAClip::op(const SkIRect& rOrig, SkRegion::Op op) {
                 // the intersection is wholly inside us, we're a rect
                 return this->setRect(rStorage);
             }
+            if (rStorage.fLeft == fBounds.fLeft && rStorage.fRight == fBounds.fRight) {
+                // the rect spans our whole x-range, so intersecting can only
+                // drop rows, never re-encode one
+                return this->trimToYRange(rStorage.fTop, rStorage.fBottom);
+            }
             r = &rStorage;   // use the intersected bounds
             break;
         case SkRegion::kDifference_Op:
@@ -89,6 +89,7 @@ private:
     bool trimBounds();
     bool trimTopBottom();
     bool trimLeftRight();
+    bool trimToYRange(int top, int bottom);
 
     friend class Builder;
     class BuilderBlitter;
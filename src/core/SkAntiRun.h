@@ -84,6 +84,19 @@ public:
             alpha += x;
             runs += x;
             x = 0;
+            // Complex paths fragment a scanline into many short runs, and once
+            // fragmented, every later add() and the final blitAntiH walk pay
+            // per-fragment costs.  Since we're about to add the same value to
+            // the whole middle region, re-coalesce any adjacent runs in it
+            // that already share an alpha; Break() guarantees a run boundary
+            // at middleCount, so merging never crosses the region's edge.
+            {
+                int merged = runs[0];
+                while (merged < middleCount && alpha[merged] == alpha[0]) {
+                    merged += runs[merged];
+                }
+                runs[0] = SkToS16(merged);
+            }
             do {
                 alpha[0] = SkToU8(CatchOverflow(alpha[0] + maxValue));
                 int n = runs[0];
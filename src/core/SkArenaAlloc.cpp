@@ -7,8 +7,14 @@
 
 #include "src/core/SkArenaAlloc.h"
 #include <algorithm>
+#include <memory>
 #include <new>
 
+#ifdef SK_ARENA_ALLOC_STATS
+#include "include/core/SkTypes.h"
+#include "include/private/SkMutex.h"
+#endif
+
 static char* end_chain(char*) { return nullptr; }
 
 static uint32_t first_allocated_block(uint32_t blockSize, uint32_t firstHeapAllocation) {
@@ -131,6 +137,7 @@ void SkArenaAlloc::ensureSpace(uint32_t size, uint32_t alignment) {
         allocationSize = (allocationSize + mask) & ~mask;
     }
 
+    fTotalHeapAllocated += allocationSize;
     char* newBlock = new char[allocationSize];
 
     auto previousDtor = fDtorCursor;
@@ -175,3 +182,100 @@ restart:
 
     return objStart;
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct SkScratchArenaSlot {
+    std::unique_ptr<char[]> fStorage;
+    size_t                  fSize = 0;
+    size_t                  fNextSize = 0;  // Grown high-water mark, applied at the next acquire.
+    bool                    fInUse = false;
+};
+
+// Enough for a couple of nested scopes per thread; anything deeper runs without a scratch block.
+static constexpr int    kScratchSlotCount   = 4;
+static constexpr size_t kScratchDefaultSize = 2048;
+
+static SkScratchArenaSlot* acquire_scratch_slot() {
+    static thread_local SkScratchArenaSlot tls_slots[kScratchSlotCount];
+    for (auto& slot : tls_slots) {
+        if (!slot.fInUse) {
+            if (slot.fNextSize > slot.fSize || !slot.fStorage) {
+                slot.fSize = std::max(slot.fNextSize, kScratchDefaultSize);
+                slot.fStorage.reset(new char[slot.fSize]);
+            }
+            slot.fInUse = true;
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+#ifdef SK_ARENA_ALLOC_STATS
+
+struct ScratchSiteStats {
+    const char* fSite = nullptr;
+    int         fOverflows = 0;
+    size_t      fMaxBytes = 0;
+};
+
+static constexpr int kMaxScratchSites = 32;
+static ScratchSiteStats gScratchSiteStats[kMaxScratchSites];
+static SkMutex gScratchStatsMutex;
+
+static void record_scratch_overflow(const char* site, size_t totalBytes) {
+    if (!site) {
+        site = "<unlabeled>";
+    }
+    SkAutoMutexExclusive lock(gScratchStatsMutex);
+    for (auto& stats : gScratchSiteStats) {
+        if (!stats.fSite) {
+            stats.fSite = site;
+        }
+        if (0 == strcmp(stats.fSite, site)) {
+            stats.fOverflows += 1;
+            stats.fMaxBytes = std::max(stats.fMaxBytes, totalBytes);
+            return;
+        }
+    }
+}
+
+void SkScratchArenaScope::DumpStats() {
+    SkAutoMutexExclusive lock(gScratchStatsMutex);
+    for (const auto& stats : gScratchSiteStats) {
+        if (stats.fSite) {
+            SkDebugf("scratch arena '%s': %d overflows, high water %zu bytes\n",
+                     stats.fSite, stats.fOverflows, stats.fMaxBytes);
+        }
+    }
+}
+
+#else
+
+static void record_scratch_overflow(const char*, size_t) {}
+
+#endif  // SK_ARENA_ALLOC_STATS
+
+SkScratchArenaScope::SkScratchArenaScope(const char* site)
+    : fSlot{acquire_scratch_slot()}
+    , fSite{site}
+    , fArena{fSlot ? fSlot->fStorage.get() : nullptr,
+             fSlot ? fSlot->fSize : 0,
+             fSlot ? fSlot->fSize : kScratchDefaultSize} {}
+
+SkScratchArenaScope::~SkScratchArenaScope() {
+    const size_t heapBytes = fArena.totalHeapAllocated();
+
+    // Run the client destructors now, while the slot's storage is guaranteed live; the member
+    // destructor that follows sees only the freshly reset (empty) arena. The storage itself
+    // can't be replaced here for the same reason, so growth is deferred to the next acquire.
+    fArena.reset();
+
+    if (fSlot) {
+        if (heapBytes > 0) {
+            fSlot->fNextSize = std::max(fSlot->fNextSize, fSlot->fSize + heapBytes);
+            record_scratch_overflow(fSite, fSlot->fSize + heapBytes);
+        }
+        fSlot->fInUse = false;
+    }
+}
@@ -139,6 +139,11 @@ public:
     // Destroy all allocated objects, free any heap allocations.
     void reset();
 
+    // Returns the number of bytes allocated from the heap beyond any initial block this arena
+    // was constructed with. A caller that reuses storage across arenas can use this to size
+    // the next initial block to the previous high-water mark.
+    size_t totalHeapAllocated() const { return fTotalHeapAllocated; }
+
 private:
     static void AssertRelease(bool cond) { if (!cond) { ::abort(); } }
     static uint32_t ToU32(size_t v) {
@@ -238,6 +243,8 @@ private:
     // That makes the nth allocation fib(n) * fFirstHeapAllocationSize bytes.
     uint32_t fNextHeapAlloc,     // How many bytes minimum will we allocate next from the heap?
              fYetNextHeapAlloc;  // And then how many the next allocation after that?
+
+    uint32_t fTotalHeapAllocated = 0;  // Sum of the heap block sizes allocated so far.
 };
 
 // Helper for defining allocators with inline/reserved storage.
@@ -252,4 +259,44 @@ public:
         : SkArenaAlloc{this->data(), this->size(), firstHeapAllocation} {}
 };
 
+struct SkScratchArenaSlot;
+
+// Define SK_ARENA_ALLOC_STATS (e.g. in SkUserConfig.h) to count, per call site, how often a
+// scratch arena overflows its recycled block to the heap, along with the high-water byte count.
+// Use the numbers to size fixed inline buffers (kSkBlitterContextSize and friends) from real
+// workloads instead of guesses.
+
+// SkScratchArenaScope checks out a thread-local block of storage and serves it as an arena for
+// the duration of a scope. When the scope ends the arena is reset, but the block is kept for the
+// next scope on that thread, grown to the arena's previous high-water mark. A call site that
+// once outgrew its block therefore pays for the heap growth only once per thread, where a
+// fixed-size SkSTArenaAlloc would pay on every call.
+//
+//   SkScratchArenaScope scratch("choose_blitter");
+//   SkBlitter* blitter = SkBlitter::Choose(..., scratch.arena(), ...);
+//
+// Scopes may nest; a small fixed number of blocks is kept per thread and deeper nesting falls
+// back to a plain heap-backed arena. Objects allocated from the arena are destroyed when the
+// scope ends and must not outlive it.
+class SkScratchArenaScope {
+public:
+    explicit SkScratchArenaScope(const char* site);
+    ~SkScratchArenaScope();
+    SkScratchArenaScope(const SkScratchArenaScope&) = delete;
+    SkScratchArenaScope& operator=(const SkScratchArenaScope&) = delete;
+
+    SkArenaAlloc* arena() { return &fArena; }
+    SkArenaAlloc* operator->() { return &fArena; }
+
+#ifdef SK_ARENA_ALLOC_STATS
+    // Print one line per site that has overflowed its scratch block.
+    static void DumpStats();
+#endif
+
+private:
+    SkScratchArenaSlot* fSlot;
+    const char*         fSite;
+    SkArenaAlloc        fArena;
+};
+
 #endif  // SkArenaAlloc_DEFINED
@@ -35,24 +35,25 @@ public:
         if (!matrixProvider) {
             matrixProvider = draw.fMatrixProvider;
         }
-        fBlitter = SkBlitter::Choose(draw.fDst, *matrixProvider, paint, &fAlloc, drawCoverage,
+        SkArenaAlloc* alloc = fScratch.arena();
+        fBlitter = SkBlitter::Choose(draw.fDst, *matrixProvider, paint, alloc, drawCoverage,
                                      draw.fRC->clipShader());
 
         if (draw.fCoverage) {
             // hmm, why can't choose ignore the paint if drawCoverage is true?
             SkBlitter* coverageBlitter =
-                    SkBlitter::Choose(*draw.fCoverage, *matrixProvider, SkPaint(), &fAlloc, true,
+                    SkBlitter::Choose(*draw.fCoverage, *matrixProvider, SkPaint(), alloc, true,
                                       draw.fRC->clipShader());
-            fBlitter = fAlloc.make<SkPairBlitter>(fBlitter, coverageBlitter);
+            fBlitter = alloc->make<SkPairBlitter>(fBlitter, coverageBlitter);
         }
         return fBlitter;
     }
 
 private:
-    // Owned by fAlloc, which will handle the delete.
+    // Owned by the scratch arena, which will handle the delete.
     SkBlitter* fBlitter = nullptr;
 
-    SkSTArenaAlloc<kSkBlitterContextSize> fAlloc;
+    SkScratchArenaScope fScratch{"SkAutoBlitterChoose"};
 };
 
 #endif
@@ -8,11 +8,19 @@
 #include "include/core/SkBBHFactory.h"
 #include "src/core/SkRTree.h"
 
+SkRTreeFactory::SkRTreeFactory(SkExecutor* executor) : fExecutor(executor) {}
+
 sk_sp<SkBBoxHierarchy> SkRTreeFactory::operator()() const {
-    return sk_make_sp<SkRTree>();
+    return sk_make_sp<SkRTree>(fExecutor);
 }
 
 void SkBBoxHierarchy::insert(const SkRect rects[], const Metadata[], int N) {
     // Ignore Metadata.
     this->insert(rects, N);
 }
+
+void SkBBoxHierarchy::search(const SkRect queries[], int N, std::vector<int> results[]) const {
+    for (int i = 0; i < N; i++) {
+        this->search(queries[i], &results[i]);
+    }
+}
@@ -18,6 +18,7 @@ struct SkImageInfo;
 class SkMipmap;
 class SkPixmap;
 class SkResourceCache;
+class SkTaskGroup;
 
 uint64_t SkMakeResourceCacheSharedIDForBitmap(uint32_t bitmapGenID);
 
@@ -60,8 +61,12 @@ class SkMipmapCache {
 public:
     static const SkMipmap* FindAndRef(const SkBitmapCacheDesc&,
                                       SkResourceCache* localCache = nullptr);
+    // If a taskGroup is provided, only the first level is built before the chain is
+    // added (and returned); deeper levels are built on the taskGroup, and the chain
+    // reports readiness via SkMipmap::countReadyLevels().
     static const SkMipmap* AddAndRef(const SkImage_Base*,
-                                     SkResourceCache* localCache = nullptr);
+                                     SkResourceCache* localCache = nullptr,
+                                     SkTaskGroup* taskGroup = nullptr);
 };
 
 #endif
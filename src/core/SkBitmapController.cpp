@@ -72,6 +72,22 @@ bool SkBitmapController::State::processMediumRequest(const SkImage_Base* image)
     }
 
     if (invScaleSize.width() > SK_Scalar1 || invScaleSize.height() > SK_Scalar1) {
+        const SkSize scale = SkSize::Make(SkScalarInvert(invScaleSize.width()),
+                                          SkScalarInvert(invScaleSize.height()));
+
+        // extractLevel() picks the same level for every scale within one integer bucket of the
+        // fractional mip level, so probe the image's memoized selections before touching the
+        // global mipmap cache.
+        const int levelBucket = SkScalarFloorToInt(SkMipmap::ComputeLevel(scale));
+        SkMipmap::Level level;
+        if (levelBucket > 0) {
+            if (sk_sp<const SkMipmap> mips = image->refCachedMipLevel(levelBucket, &level)) {
+                fCurrMip = std::move(mips);
+                fInvMatrix.postScale(level.fScale.width(), level.fScale.height());
+                return fResultBitmap.installPixels(level.fPixmap);
+            }
+        }
+
         fCurrMip = try_load_mips(image);
         if (!fCurrMip) {
             return false;
@@ -79,10 +95,11 @@ bool SkBitmapController::State::processMediumRequest(const SkImage_Base* image)
         // diagnostic for a crasher...
         SkASSERT_RELEASE(fCurrMip->data());
 
-        const SkSize scale = SkSize::Make(SkScalarInvert(invScaleSize.width()),
-                                          SkScalarInvert(invScaleSize.height()));
-        SkMipmap::Level level;
         if (fCurrMip->extractLevel(scale, &level)) {
+            if (levelBucket > 0) {
+                image->cacheMipLevel(levelBucket, level, fCurrMip);
+            }
+
             const SkSize& invScaleFixup = level.fScale;
             fInvMatrix.postScale(invScaleFixup.width(), invScaleFixup.height());
 
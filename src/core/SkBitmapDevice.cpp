@@ -69,10 +69,16 @@ public:
         fDone = false;
 
         // we need fDst to be set, and if we're actually drawing, to dirty the genID
-        if (!dev->accessPixels(&fRootPixmap)) {
-            // NoDrawDevice uses us (why?) so we have to catch this case w/ no pixels
-            fRootPixmap.reset(dev->imageInfo(), nullptr, 0);
+        if (dev->fDrawCacheValid) {
+            dev->fBitmap.notifyPixelsChanged();
+        } else {
+            if (!dev->accessPixels(&dev->fCachedPixmap)) {
+                // NoDrawDevice uses us (why?) so we have to catch this case w/ no pixels
+                dev->fCachedPixmap.reset(dev->imageInfo(), nullptr, 0);
+            }
+            dev->fDrawCacheValid = true;
         }
+        fRootPixmap = dev->fCachedPixmap;
 
         // do a quick check, so we don't even have to process "bounds" if there is no need
         const SkIRect clipR = dev->fRCStack.rc().getBounds();
@@ -188,10 +194,19 @@ class SkBitmapDevice::BDDraw : public SkDraw {
 public:
     BDDraw(SkBitmapDevice* dev) {
         // we need fDst to be set, and if we're actually drawing, to dirty the genID
-        if (!dev->accessPixels(&fDst)) {
-            // NoDrawDevice uses us (why?) so we have to catch this case w/ no pixels
-            fDst.reset(dev->imageInfo(), nullptr, 0);
+        if (dev->fDrawCacheValid) {
+            // The pixmap can't have moved since the last draw, so skip the virtual
+            // pixel-access round trip -- but this is still a write, so anyone holding
+            // a snapshot needs to see a new genID.
+            dev->fBitmap.notifyPixelsChanged();
+        } else {
+            if (!dev->accessPixels(&dev->fCachedPixmap)) {
+                // NoDrawDevice uses us (why?) so we have to catch this case w/ no pixels
+                dev->fCachedPixmap.reset(dev->imageInfo(), nullptr, 0);
+            }
+            dev->fDrawCacheValid = true;
         }
+        fDst = dev->fCachedPixmap;
         fMatrixProvider = dev;
         fRC = &dev->fRCStack.rc();
         fCoverage = dev->accessCoverage();
@@ -298,6 +313,7 @@ void SkBitmapDevice::replaceBitmapBackendForRasterSurface(const SkBitmap& bm) {
     SkASSERT(bm.width() == fBitmap.width());
     SkASSERT(bm.height() == fBitmap.height());
     fBitmap = bm;   // intent is to use bm's pixelRef (and rowbytes/config)
+    fDrawCacheValid = false;
     this->privateResize(fBitmap.info().width(), fBitmap.info().height());
 }
 
@@ -609,7 +625,7 @@ void SkBitmapDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPain
         SkImageFilter_Base::Context ctx(matrix, clipBounds, cache.get(), fBitmap.colorType(),
                                         fBitmap.colorSpace(), src);
 
-        filteredImage = as_IFB(filter)->filterImage(ctx).imageAndOffset(&offset);
+        filteredImage = as_IFB(filter)->filterImageTiled(ctx).imageAndOffset(&offset);
         if (!filteredImage) {
             return;
         }
@@ -155,6 +155,10 @@ private:
     SkImageFilterCache* getImageFilterCache() override;
 
     SkBitmap    fBitmap;
+    // Lazily built by BDDraw and reused across draws; only replacing the bitmap
+    // backend can move the pixels, so that is the one invalidation point.
+    SkPixmap    fCachedPixmap;
+    bool        fDrawCacheValid = false;
     void*       fRasterHandle = nullptr;
     SkRasterClipStack  fRCStack;
     std::unique_ptr<SkBitmap> fCoverage;    // if non-null, will have the same dimensions as fBitmap
@@ -16,6 +16,7 @@
 #include "src/core/SkImagePriv.h"
 #include "src/shaders/SkShaderBase.h"
 
+class SkAAClip;
 class SkArenaAlloc;
 class SkMatrix;
 class SkMatrixProvider;
@@ -113,6 +114,15 @@ public:
      */
     virtual bool isNullBlitter() const;
 
+    /**
+     *  If this blitter can apply the given 8-bit clip itself -- fusing it
+     *  into its blit pipelines rather than being wrapped by an outer
+     *  SkAAClipBlitter -- it keeps a bare pointer to the clip (which must
+     *  outlive the blitter) and returns true. Must be called before any
+     *  blit call. Default impl returns false.
+     */
+    virtual bool ingestAAClip(const SkAAClip&) { return false; }
+
     /**
      * Special methods for blitters that can blit more than one row at a time.
      * This function returns the number of rows that this blitter could optimally
@@ -27,6 +27,7 @@
 #include "src/core/SkClipOpPriv.h"
 #include "src/core/SkClipStack.h"
 #include "src/core/SkDraw.h"
+#include "src/core/SkDrawProfiler.h"
 #include "src/core/SkGlyphRun.h"
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilter_Base.h"
@@ -1027,7 +1028,7 @@ void SkCanvas::DrawDeviceWithFilter(SkBaseDevice* src, const SkImageFilter* filt
     skif::Context ctx(filterCTM, layerTargetBounds, nullptr, colorType, colorSpace, special.get());
 
     SkIPoint offset;
-    special = as_IFB(filter)->filterImage(ctx).imageAndOffset(&offset);
+    special = as_IFB(filter)->filterImageTiled(ctx).imageAndOffset(&offset);
     if (special) {
         // Draw the filtered backdrop content into the dst device. We add layerInputBounds origin
         // to offset because the original value in 'offset' was relative to 'filterCTM'. 'filterCTM'
@@ -2183,6 +2184,33 @@ void SkCanvas::experimental_DrawEdgeAAImageSet(const ImageSetEntry imageSet[], i
     this->onDrawEdgeAAImageSet(imageSet, cnt, dstClips, preViewMatrices, paint, constraint);
 }
 
+void SkCanvas::drawImageRectBatch(const ImageRectEntry entries[], int count, const SkPaint* paint,
+                                  SrcRectConstraint constraint) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    if (count <= 0) {
+        return;
+    }
+
+    // Lower the batch onto the edge-AA image-set path: the shared paint and clip are resolved
+    // once there, recording canvases already know how to capture image sets, and devices that
+    // can batch (the GPU backend's bulk texture ops) receive all entries at once. Entries that
+    // could not draw are filtered here, just as drawImageRect() would reject them.
+    const unsigned aaFlags = (paint && paint->isAntiAlias()) ? kAll_QuadAAFlags
+                                                             : kNone_QuadAAFlags;
+    SkAutoSTArray<32, ImageSetEntry> set(count);
+    int n = 0;
+    for (int i = 0; i < count; ++i) {
+        const ImageRectEntry& entry = entries[i];
+        if (entry.fImage && fillable(entry.fDstRect) && fillable(entry.fSrcRect)) {
+            set[n++] = ImageSetEntry(sk_ref_sp(entry.fImage), entry.fSrcRect, entry.fDstRect,
+                                     1.0f, aaFlags);
+        }
+    }
+    if (n > 0) {
+        this->onDrawEdgeAAImageSet(set.get(), n, nullptr, nullptr, paint, constraint);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //  These are the virtual drawing methods
 //////////////////////////////////////////////////////////////////////////////
@@ -2194,6 +2222,7 @@ void SkCanvas::onDiscard() {
 }
 
 void SkCanvas::onDrawPaint(const SkPaint& paint) {
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kPaint, &paint, nullptr);
     this->internalDrawPaint(paint);
 }
 
@@ -2209,6 +2238,7 @@ void SkCanvas::internalDrawPaint(const SkPaint& paint) {
 
 void SkCanvas::onDrawPoints(PointMode mode, size_t count, const SkPoint pts[],
                             const SkPaint& paint) {
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kPoints, &paint, nullptr);
     if ((long)count <= 0) {
         return;
     }
@@ -2249,6 +2279,7 @@ static bool needs_autodrawlooper(SkCanvas* canvas, const SkPaint& paint) {
 
 void SkCanvas::onDrawRect(const SkRect& r, const SkPaint& paint) {
     SkASSERT(r.isSorted());
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kRect, &paint, &r);
     if (paint.canComputeFastBounds()) {
         SkRect storage;
         if (this->quickReject(paint.computeFastBounds(r, &storage))) {
@@ -2327,6 +2358,7 @@ void SkCanvas::onDrawBehind(const SkPaint& paint) {
 
 void SkCanvas::onDrawOval(const SkRect& oval, const SkPaint& paint) {
     SkASSERT(oval.isSorted());
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kOval, &paint, &oval);
     if (paint.canComputeFastBounds()) {
         SkRect storage;
         if (this->quickReject(paint.computeFastBounds(oval, &storage))) {
@@ -2365,6 +2397,7 @@ void SkCanvas::onDrawArc(const SkRect& oval, SkScalar startAngle,
 }
 
 void SkCanvas::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kRRect, &paint, &rrect.getBounds());
     if (paint.canComputeFastBounds()) {
         SkRect storage;
         if (this->quickReject(paint.computeFastBounds(rrect.getBounds(), &storage))) {
@@ -2412,6 +2445,7 @@ void SkCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
     if (!path.isFinite()) {
         return;
     }
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kPath, &paint, &path.getBounds());
 
     const SkRect& pathBounds = path.getBounds();
     if (!path.isInverseFillType() && paint.canComputeFastBounds()) {
@@ -2482,6 +2516,7 @@ void SkCanvas::onDrawImage(const SkImage* image, SkScalar x, SkScalar y, const S
 
     SkRect bounds = SkRect::MakeXYWH(x, y,
                                      SkIntToScalar(image->width()), SkIntToScalar(image->height()));
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kImage, paint, &bounds);
     if (nullptr == paint || paint->canComputeFastBounds()) {
         SkRect tmp = bounds;
         if (paint) {
@@ -2531,6 +2566,8 @@ void SkCanvas::onDrawImageRect(const SkImage* image, const SkRect* src, const Sk
     SkPaint realPaint;
     paint = init_image_paint(&realPaint, paint);
 
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kImageRect, paint, &dst);
+
     if (nullptr == paint || paint->canComputeFastBounds()) {
         SkRect storage = dst;
         if (paint) {
@@ -2597,6 +2634,10 @@ void SkCanvas::onDrawImageLattice(const SkImage* image, const Lattice& lattice,
 
 void SkCanvas::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
                               const SkPaint& paint) {
+    if (SkDrawProfiler::IsEnabled()) {
+        SkRect blobBounds = blob->bounds().makeOffset(x, y);
+        SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kTextBlob, &paint, &blobBounds);
+    }
     SkRect storage;
     const SkRect* bounds = nullptr;
     if (paint.canComputeFastBounds()) {
@@ -2652,6 +2693,7 @@ void SkCanvas::drawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
 
 void SkCanvas::onDrawVerticesObject(const SkVertices* vertices, SkBlendMode bmode,
                                     const SkPaint& paint) {
+    SkDrawProfiler::Sample(this, SkDrawProfiler::Op::kVertices, &paint, &vertices->bounds());
     DRAW_BEGIN(paint, nullptr)
 
     while (iter.next()) {
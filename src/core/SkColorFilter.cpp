@@ -5,11 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
 #include "include/core/SkUnPreMultiply.h"
 #include "include/private/SkNx.h"
+#include "include/private/SkOnce.h"
 #include "include/private/SkTDArray.h"
+#include "include/private/SkTemplates.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkColorFilterBase.h"
 #include "src/core/SkColorSpacePriv.h"
@@ -121,6 +124,14 @@ public:
     }
 
     bool onAppendStages(const SkStageRec& rec, bool shaderIsOpaque) const override {
+        if (const float* lut = this->bakedLut(rec, shaderIsOpaque)) {
+            auto* ctx = rec.fAlloc->make<SkRasterPipeline_Clut3DCtx>();
+            ctx->lut = lut;
+            ctx->gridSize = kLutGridSize;
+            rec.fPipeline->append(SkRasterPipeline::clut_3d, ctx);
+            return true;
+        }
+
         bool innerIsOpaque = shaderIsOpaque;
         if (!fInner->isAlphaUnchanged()) {
             innerIsOpaque = false;
@@ -175,9 +186,72 @@ private:
         , fInner(as_CFB_sp(std::move(inner)))
     {}
 
+    // Long chains of color filters have no spatial dependence, so they can be collapsed into a
+    // 3D lookup table sampled in a single stage. We bake on first use (the chain runs once per
+    // table entry instead of once per pixel) and cache the result on this filter. Only valid
+    // when every pixel is opaque and the chain leaves alpha alone, so premul and unpremul agree
+    // and the missing alpha axis of the table doesn't matter.
+    static constexpr int kLutGridSize = 17;
+
+    const float* bakedLut(const SkStageRec& rec, bool shaderIsOpaque) const {
+        // Baking pays off once three or more filters are chained; a plain two-filter compose is
+        // already cheap and not worth the table memory or the interpolation error.
+        const bool deepChain = is_compose(fOuter.get()) || is_compose(fInner.get());
+        if (!deepChain || !shaderIsOpaque || !this->isAlphaUnchanged()) {
+            return nullptr;
+        }
+
+        fLutOnce([&] {
+            const int N = kLutGridSize;
+            fLutColorSpace = sk_ref_sp(rec.fDstCS);
+
+            SkAutoTMalloc<float> lut(N * N * N * 4);
+            float* e = lut.get();
+            for (int ri = 0; ri < N; ri++)
+            for (int gi = 0; gi < N; gi++)
+            for (int bi = 0; bi < N; bi++) {
+                *e++ = ri * (1.0f / (N - 1));
+                *e++ = gi * (1.0f / (N - 1));
+                *e++ = bi * (1.0f / (N - 1));
+                *e++ = 1.0f;
+            }
+
+            // Run the whole chain once over the identity table.
+            SkSTArenaAlloc<1024> alloc;
+            SkRasterPipeline pipeline(&alloc);
+            SkRasterPipeline_MemoryCtx io = { lut.get(), 0 };
+            pipeline.append(SkRasterPipeline::load_f32, &io);
+            SkPaint dummyPaint;
+            SkSimpleMatrixProvider matrixProvider(SkMatrix::I());
+            SkStageRec bakeRec = {
+                &pipeline, &alloc, kRGBA_F32_SkColorType, rec.fDstCS, dummyPaint, nullptr,
+                matrixProvider
+            };
+            if (fInner->appendStages(bakeRec, true) && fOuter->appendStages(bakeRec, true)) {
+                pipeline.append(SkRasterPipeline::store_f32, &io);
+                pipeline.run(0, 0, N * N * N, 1);
+                fLut = std::move(lut);
+            }
+        });
+
+        // The bake captured one destination color space; anything else gets the general path.
+        if (!fLut.get() || !SkColorSpace::Equals(fLutColorSpace.get(), rec.fDstCS)) {
+            return nullptr;
+        }
+        return fLut.get();
+    }
+
+    static bool is_compose(const SkColorFilterBase* f) {
+        return 0 == strcmp(f->getTypeName(), "SkComposeColorFilter");
+    }
+
     sk_sp<SkColorFilterBase> fOuter;
     sk_sp<SkColorFilterBase> fInner;
 
+    mutable SkOnce               fLutOnce;
+    mutable SkAutoTMalloc<float> fLut;            // empty when baking failed or never ran
+    mutable sk_sp<SkColorSpace>  fLutColorSpace;
+
     friend class SkColorFilter;
 
     typedef SkColorFilter INHERITED;
@@ -87,18 +87,17 @@ skvm::Color SkColorFilter_Matrix::onProgram(skvm::Builder* p, skvm::Color c,
     auto apply_matrix = [&](auto xyzw) {
         auto dot = [&](int j) {
             auto custom_mad = [&](float f, skvm::F32 m, skvm::F32 a) {
-                // skvm::Builder won't fold f*0 == 0, but we shouldn't encounter NaN here.
-                // While looking, also simplify f == ±1.  Anything else becomes a uniform.
-                return f ==  0.0f ? a
-                     : f == +1.0f ? a + m
-                     : f == -1.0f ? a - m
-                     : m * p->uniformF(uniforms->pushF(f)) + a;
+                // Every entry becomes a uniform, even when we could fold 0 or ±1 at
+                // build time.  Folding would specialize the program on the matrix
+                // values, and an animated matrix (think: a saturation slider passing
+                // through identity) would then change program shape each frame and
+                // miss SkVMBlitter's program cache, re-JITting instead of just
+                // updating uniforms.
+                return m * p->uniformF(uniforms->pushF(f)) + a;
             };
 
-            // Similarly, let skvm::Builder fold away the additive bias when zero.
             const float b = fMatrix[4+j*5];
-            skvm::F32 bias = b == 0.0f ? p->splat(0.0f)
-                                       : p->uniformF(uniforms->pushF(b));
+            skvm::F32 bias = p->uniformF(uniforms->pushF(b));
 
             auto [x,y,z,w] = xyzw;
             return custom_mad(fMatrix[0+j*5], x,
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/private/SkMutex.h"
 #include "include/third_party/skcms/skcms.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
@@ -13,6 +14,118 @@
 
 // See skia.org/user/color  (== site/user/color.md).
 
+namespace {
+
+// Steps are reconstructed for every blitter and pipeline, but wide-gamut display pipelines see
+// the same few (src,dst,alpha) combinations over and over. Cache the decomposition globally,
+// along with transfer-function LUTs for the scalar apply() path. Entries are allocated once and
+// never evicted, so steps can hold raw pointers into them.
+
+struct StepsKey {
+    uint64_t    fSrcHash, fDstHash;
+    SkAlphaType fSrcAT, fDstAT;
+
+    bool operator==(const StepsKey& that) const {
+        return fSrcHash == that.fSrcHash && fDstHash == that.fDstHash
+            && fSrcAT   == that.fSrcAT   && fDstAT   == that.fDstAT;
+    }
+};
+
+struct StepsEntry {
+    StepsKey               fKey;
+    SkColorSpaceXformSteps fSteps;
+    float                  fSrcLut[256];
+    float                  fDstLut[256];
+};
+
+constexpr int kMaxStepsEntries = 32;
+
+SkMutex& steps_cache_mutex() {
+    static SkMutex& mutex = *(new SkMutex);
+    return mutex;
+}
+
+StepsEntry** steps_cache() {
+    static StepsEntry** entries = new StepsEntry*[kMaxStepsEntries]();
+    return entries;
+}
+
+int gStepsEntryCount = 0;
+
+// Sample tf into a 256-entry lut. Returns true only if linear interpolation between the samples
+// stays within tolerance of the parametric curve on [0,1]; PQ- and HLG-ish curves bend too
+// sharply for 256 samples, so only sRGB-ish curves qualify.
+bool bake_lut(const skcms_TransferFunction& tf, float lut[256]) {
+    if (classify_transfer_fn(tf) != sRGBish_TF) {
+        return false;
+    }
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = skcms_TransferFunction_eval(&tf, i * (1/255.0f));
+    }
+    constexpr float kTolerance = 1/512.0f;  // Half an 8-bit step.
+    for (int i = 0; i < 255; ++i) {
+        float mid    = (i + 0.5f) * (1/255.0f),
+              approx = 0.5f * (lut[i] + lut[i+1]),
+              exact  = skcms_TransferFunction_eval(&tf, mid);
+        if (!(fabsf(approx - exact) <= kTolerance)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool steps_cache_find(const StepsKey& key, SkColorSpaceXformSteps* steps) {
+    SkAutoMutexExclusive lock(steps_cache_mutex());
+    StepsEntry** entries = steps_cache();
+    for (int i = 0; i < gStepsEntryCount; ++i) {
+        if (entries[i]->fKey == key) {
+            *steps = entries[i]->fSteps;
+            return true;
+        }
+    }
+    return false;
+}
+
+void steps_cache_add(const StepsKey& key, SkColorSpaceXformSteps* steps) {
+    SkAutoMutexExclusive lock(steps_cache_mutex());
+    StepsEntry** entries = steps_cache();
+    for (int i = 0; i < gStepsEntryCount; ++i) {
+        if (entries[i]->fKey == key) {
+            // Someone else inserted while we were computing; adopt their copy (and LUTs).
+            *steps = entries[i]->fSteps;
+            return;
+        }
+    }
+    if (gStepsEntryCount == kMaxStepsEntries) {
+        return;  // Full. The computed steps are still fine, just uncached and LUT-free.
+    }
+    StepsEntry* entry = new StepsEntry;
+    entry->fKey   = key;
+    entry->fSteps = *steps;
+    if (steps->flags.linearize && bake_lut(steps->srcTF, entry->fSrcLut)) {
+        entry->fSteps.srcTFLut = entry->fSrcLut;
+    }
+    if (steps->flags.encode && bake_lut(steps->dstTFInv, entry->fDstLut)) {
+        entry->fSteps.dstTFLut = entry->fDstLut;
+    }
+    entries[gStepsEntryCount++] = entry;
+    *steps = entry->fSteps;
+}
+
+// Evaluate tf at v, through the lut when v is in its [0,1] domain. Out-of-range and negative
+// values (and NaN) fall back to the parametric curve, which handles sign mirroring itself.
+float eval_transfer_fn(const skcms_TransferFunction& tf, const float* lut, float v) {
+    if (lut && v >= 0 && v <= 1) {
+        float x  = v * 255.0f;
+        int   ix = (int)x;
+        return ix >= 255 ? lut[255]
+                         : lut[ix] + (lut[ix+1] - lut[ix]) * (x - ix);
+    }
+    return skcms_TransferFunction_eval(&tf, v);
+}
+
+}  // namespace
+
 SkColorSpaceXformSteps::SkColorSpaceXformSteps(const SkColorSpace* src, SkAlphaType srcAT,
                                                const SkColorSpace* dst, SkAlphaType dstAT) {
     // Opaque outputs are treated as the same alpha type as the source input.
@@ -31,6 +144,11 @@ SkColorSpaceXformSteps::SkColorSpaceXformSteps(const SkColorSpace* src, SkAlphaT
         return;
     }
 
+    const StepsKey key = { src->hash(), dst->hash(), srcAT, dstAT };
+    if (steps_cache_find(key, this)) {
+        return;
+    }
+
     this->flags.unpremul        = srcAT == kPremul_SkAlphaType;
     this->flags.linearize       = !src->gammaIsLinear();
     this->flags.gamut_transform = src->toXYZD50Hash() != dst->toXYZD50Hash();
@@ -91,6 +209,8 @@ SkColorSpaceXformSteps::SkColorSpaceXformSteps(const SkColorSpace* src, SkAlphaT
         this->flags.unpremul = false;
         this->flags.premul   = false;
     }
+
+    steps_cache_add(key, this);
 }
 
 void SkColorSpaceXformSteps::apply(float* rgba) const {
@@ -104,9 +224,9 @@ void SkColorSpaceXformSteps::apply(float* rgba) const {
         rgba[2] *= invA;
     }
     if (flags.linearize) {
-        rgba[0] = skcms_TransferFunction_eval(&srcTF, rgba[0]);
-        rgba[1] = skcms_TransferFunction_eval(&srcTF, rgba[1]);
-        rgba[2] = skcms_TransferFunction_eval(&srcTF, rgba[2]);
+        rgba[0] = eval_transfer_fn(srcTF, srcTFLut, rgba[0]);
+        rgba[1] = eval_transfer_fn(srcTF, srcTFLut, rgba[1]);
+        rgba[2] = eval_transfer_fn(srcTF, srcTFLut, rgba[2]);
     }
     if (flags.gamut_transform) {
         float temp[3] = { rgba[0], rgba[1], rgba[2] };
@@ -117,9 +237,9 @@ void SkColorSpaceXformSteps::apply(float* rgba) const {
         }
     }
     if (flags.encode) {
-        rgba[0] = skcms_TransferFunction_eval(&dstTFInv, rgba[0]);
-        rgba[1] = skcms_TransferFunction_eval(&dstTFInv, rgba[1]);
-        rgba[2] = skcms_TransferFunction_eval(&dstTFInv, rgba[2]);
+        rgba[0] = eval_transfer_fn(dstTFInv, dstTFLut, rgba[0]);
+        rgba[1] = eval_transfer_fn(dstTFInv, dstTFLut, rgba[1]);
+        rgba[2] = eval_transfer_fn(dstTFInv, dstTFLut, rgba[2]);
     }
     if (flags.premul) {
         rgba[0] *= rgba[3];
@@ -33,6 +33,9 @@ struct SkColorSpaceXformSteps {
         }
     };
 
+    // Identity (no-op) steps.
+    SkColorSpaceXformSteps() = default;
+
     SkColorSpaceXformSteps(const SkColorSpace* src, SkAlphaType srcAT,
                            const SkColorSpace* dst, SkAlphaType dstAT);
 
@@ -50,6 +53,13 @@ struct SkColorSpaceXformSteps {
     skcms_TransferFunction srcTF,     // Apply for linearize.
                            dstTFInv;  // Apply for encode.
     float src_to_dst_matrix[9];       // Apply this 3x3 column-major matrix for gamut_transform.
+
+    // Pre-baked 256-entry LUTs for srcTF / dstTFInv, or null when the curve can't be
+    // approximated within tolerance. They point into the global steps cache, whose entries are
+    // never evicted, so the pointers stay valid for the life of the process and can be copied
+    // freely along with the steps.
+    const float* srcTFLut = nullptr;
+    const float* dstTFLut = nullptr;
 };
 
 #endif//SkColorSpaceXformSteps_DEFINED
@@ -7,9 +7,12 @@
 
 #include "include/core/SkContourMeasure.h"
 #include "include/core/SkPath.h"
+#include "include/private/SkIDChangeListener.h"
+#include "include/private/SkNx.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPathMeasurePriv.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
 #include "src/core/SkTSearch.h"
 
 #define kMaxTValue  0x3FFFFFFF
@@ -192,8 +195,10 @@ private:
     // temporary
     SkTDArray<SkContourMeasure::Segment>  fSegments;
     SkTDArray<SkPoint>  fPts; // Points used to define the segments
+    SkTDArray<SkScalar> fLineLengths; // scratch for compute_line_run()
 
     SkScalar compute_line_seg(SkPoint p0, SkPoint p1, SkScalar distance, unsigned ptIndex);
+    SkScalar compute_line_run(const SkPoint pts[], int count, SkScalar distance, int* ptIndex);
     SkScalar compute_quad_segs(const SkPoint pts[3], SkScalar distance,
                                int mint, int maxt, unsigned ptIndex);
     SkScalar compute_conic_segs(const SkConic& conic, SkScalar distance,
@@ -299,6 +304,52 @@ SkScalar SkContourMeasureIter::Impl::compute_line_seg(SkPoint p0, SkPoint p1, Sk
     return distance;
 }
 
+/*  Measures a run of 'count' line segments over the contiguous points pts[0..count]. The
+ *  lengths are computed four at a time; the accumulate-and-append pass matches calling
+ *  compute_line_seg() once per segment.
+ */
+SkScalar SkContourMeasureIter::Impl::compute_line_run(const SkPoint pts[], int count,
+                                                      SkScalar distance, int* ptIndex) {
+    fLineLengths.setCount(count);
+    int index = 0;
+    for (; index + 4 <= count; index += 4) {
+        Sk4f dx(pts[index + 1].fX - pts[index    ].fX,
+                pts[index + 2].fX - pts[index + 1].fX,
+                pts[index + 3].fX - pts[index + 2].fX,
+                pts[index + 4].fX - pts[index + 3].fX);
+        Sk4f dy(pts[index + 1].fY - pts[index    ].fY,
+                pts[index + 2].fY - pts[index + 1].fY,
+                pts[index + 3].fY - pts[index + 2].fY,
+                pts[index + 4].fY - pts[index + 3].fY);
+        (dx * dx + dy * dy).sqrt().store(&fLineLengths[index]);
+    }
+    for (; index < count; ++index) {
+        fLineLengths[index] = SkPoint::Distance(pts[index], pts[index + 1]);
+    }
+
+    for (index = 0; index < count; ++index) {
+        SkScalar d = fLineLengths[index];
+        if (!SkScalarIsFinite(d)) {
+            // SkPoint::Distance() retries overflowed magnitudes in doubles; match it.
+            d = SkPoint::Distance(pts[index], pts[index + 1]);
+        }
+        SkASSERT(d >= 0);
+        SkScalar prevD = distance;
+        distance += d;
+        if (distance > prevD) {
+            SkASSERT((unsigned)*ptIndex < (unsigned)fPts.count());
+            SkContourMeasure::Segment* seg = fSegments.append();
+            seg->fDistance = distance;
+            seg->fPtIndex = *ptIndex;
+            seg->fType = kLine_SegType;
+            seg->fTValue = kMaxTValue;
+            fPts.append(1, &pts[index + 1]);
+            *ptIndex += 1;
+        }
+    }
+    return distance;
+}
+
 SkContourMeasure* SkContourMeasureIter::Impl::buildSegments() {
     int         ptIndex = -1;
     SkScalar    distance = 0;
@@ -332,12 +383,19 @@ SkContourMeasure* SkContourMeasureIter::Impl::buildSegments() {
 
             case SkPathVerb::kLine: {
                 SkASSERT(haveSeenMoveTo);
-                SkScalar prevD = distance;
-                distance = this->compute_line_seg(pts[0], pts[1], distance, ptIndex);
-                if (distance > prevD) {
-                    fPts.append(1, pts + 1);
-                    ptIndex++;
+                // Consecutive line verbs reference a contiguous run of the path's points;
+                // measure the whole run at once so the lengths can be computed in batches.
+                int runCount = 1;
+                auto next = fIter;
+                for (++next; next != end; ++next) {
+                    auto [nextVerb, nextPts, nextW] = *next;
+                    if (nextVerb != SkPathVerb::kLine || nextPts != pts + runCount) {
+                        break;
+                    }
+                    ++runCount;
+                    fIter = next;
                 }
+                distance = this->compute_line_run(pts, runCount, distance, &ptIndex);
             } break;
 
             case SkPathVerb::kQuad: {
@@ -667,3 +725,107 @@ bool SkContourMeasure::getSegment(SkScalar startD, SkScalar stopD, SkPath* dst,
 
     return true;
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SkContourMeasureCache::List::~List() {
+    fMeasures.unrefAll();
+}
+
+namespace {
+
+// This creates a domain of keys in SkResourceCache used by this file.
+static void* kMeasureNamespace;
+
+struct MeasureKey : public SkResourceCache::Key {
+    uint32_t fGenID;
+    uint32_t fForceClosed;
+    SkScalar fResScale;
+
+    MeasureKey(uint32_t genID, bool forceClosed, SkScalar resScale)
+            : fGenID(genID)
+            , fForceClosed(forceClosed)
+            , fResScale(resScale) {
+        this->init(&kMeasureNamespace, 0,
+                   sizeof(fGenID) + sizeof(fForceClosed) + sizeof(fResScale));
+    }
+};
+
+class MeasureRec : public SkResourceCache::Rec {
+public:
+    MeasureRec(const MeasureKey& key, sk_sp<SkContourMeasureCache::List> list)
+            : fKey(key)
+            , fList(std::move(list)) {}
+
+    const Key& getKey() const override { return fKey; }
+
+    size_t bytesUsed() const override {
+        size_t size = sizeof(*this);
+        for (int index = 0; index < fList->count(); ++index) {
+            size += SkContourMeasureCache::ApproximateBytesUsed(*fList->at(index));
+        }
+        return size;
+    }
+
+    const char* getCategory() const override { return "contour-measure"; }
+
+    sk_sp<SkContourMeasureCache::List> refList() const { return fList; }
+
+private:
+    MeasureKey fKey;
+    sk_sp<SkContourMeasureCache::List> fList;
+};
+
+// When the SkPathRef genID changes, purge the stale measures.
+class MeasureInvalidator : public SkIDChangeListener {
+public:
+    MeasureInvalidator(const MeasureKey& key) : fKey(key) {}
+
+private:
+    // always purge
+    static bool FindVisitor(const SkResourceCache::Rec&, void*) {
+        return false;
+    }
+
+    void changed() override {
+        SkResourceCache::Find(fKey, MeasureInvalidator::FindVisitor, nullptr);
+    }
+
+    MeasureKey fKey;
+};
+
+bool measure_find_visitor(const SkResourceCache::Rec& baseRec, void* ctx) {
+    const MeasureRec& rec = static_cast<const MeasureRec&>(baseRec);
+    *static_cast<sk_sp<SkContourMeasureCache::List>*>(ctx) = rec.refList();
+    return true;
+}
+
+}  // namespace
+
+size_t SkContourMeasureCache::ApproximateBytesUsed(const SkContourMeasure& meas) {
+    return sizeof(meas) + meas.fSegments.count() * sizeof(SkContourMeasure::Segment)
+                        + meas.fPts.count() * sizeof(SkPoint);
+}
+
+sk_sp<SkContourMeasureCache::List> SkContourMeasureCache::Get(const SkPath& path,
+                                                              bool forceClosed,
+                                                              SkScalar resScale) {
+    MeasureKey key(path.getGenerationID(), forceClosed, resScale);
+    sk_sp<List> list;
+    const bool cacheable = !path.isVolatile();
+    if (cacheable && SkResourceCache::Find(key, measure_find_visitor, &list)) {
+        return list;
+    }
+
+    list = sk_sp<List>(new List);
+    SkContourMeasureIter iter(path, forceClosed, resScale);
+    while (sk_sp<SkContourMeasure> meas = iter.next()) {
+        *list->fMeasures.append() = meas.release();
+    }
+
+    if (cacheable) {
+        SkResourceCache::Add(new MeasureRec(key, list));
+        SkPathPriv::AddGenIDChangeListener(path, sk_make_sp<MeasureInvalidator>(key));
+    }
+    return list;
+}
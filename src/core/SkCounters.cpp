@@ -0,0 +1,82 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkCounters.h"
+
+#include "include/private/SkMutex.h"
+#include "include/utils/SkEventTracer.h"
+#include "include/utils/SkTraceEventPhase.h"
+#include "src/core/SkTraceEvent.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Counters live in static storage so a Counter* handed out by Register() never moves.
+// 64 distinct counter names is plenty; overflow spills into one shared bucket so the
+// macros never have to handle a null counter.
+static constexpr int kMaxCounters = 64;
+
+static SkMutex& counters_mutex() {
+    static SkMutex& mutex = *(new SkMutex);
+    return mutex;
+}
+
+static SkCounters::Counter gCounters[kMaxCounters];
+static int gCounterCount = 0;
+static SkCounters::Counter gOverflowCounter = {};
+
+SkCounters::Counter* SkCounters::Register(const char* name) {
+    SkAutoMutexExclusive lock(counters_mutex());
+    for (int i = 0; i < gCounterCount; i++) {
+        if (0 == strcmp(gCounters[i].fName, name)) {
+            return &gCounters[i];
+        }
+    }
+    if (gCounterCount < kMaxCounters) {
+        gCounters[gCounterCount].fName = name;
+        return &gCounters[gCounterCount++];
+    }
+    gOverflowCounter.fName = "sk_counter_overflow";
+    return &gOverflowCounter;
+}
+
+int SkCounters::Snapshot(Value values[], int maxValues) {
+    SkAutoMutexExclusive lock(counters_mutex());
+    int n = std::min(gCounterCount, maxValues);
+    for (int i = 0; i < n; i++) {
+        Counter& counter = gCounters[i];
+        uint64_t total = counter.total();
+        values[i] = {counter.fName, total, total - counter.fLastTotal};
+        counter.fLastTotal = total;
+    }
+    return n;
+}
+
+void SkCounters::EmitFrameToTrace() {
+    SkEventTracer* tracer = SkEventTracer::GetInstance();
+    const uint8_t* categoryEnabled = tracer->getCategoryGroupEnabled("skia");
+    if (!*categoryEnabled) {
+        return;
+    }
+
+    Value values[kMaxCounters];
+    int n = Snapshot(values, kMaxCounters);
+    for (int i = 0; i < n; i++) {
+        static const char* argName = "value";
+        static const uint8_t argType = TRACE_VALUE_TYPE_UINT;
+        tracer->addTraceEvent(TRACE_EVENT_PHASE_COUNTER, categoryEnabled, values[i].fName,
+                              0 /*id*/, 1 /*numArgs*/, &argName, &argType, &values[i].fDelta,
+                              TRACE_EVENT_FLAG_NONE);
+    }
+}
+
+uint32_t SkCounters::ShardIndex() {
+    static std::atomic<uint32_t> nextIndex{0};
+    static thread_local uint32_t index =
+            nextIndex.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return index;
+}
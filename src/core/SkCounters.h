@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCounters_DEFINED
+#define SkCounters_DEFINED
+
+#include "include/core/SkTypes.h"
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ *  Always-on named counters for hot paths. Unlike TRACE_EVENT, these stay cheap enough
+ *  (one relaxed atomic add) to leave in production code, so fast-path coverage and cache
+ *  hit rates can be watched without a profiler attached. Count with
+ *
+ *      SK_COUNTER_INCREMENT("blitter_fastpath");
+ *
+ *  and roll the counters up once per frame with Snapshot() or EmitFrameToTrace().
+ */
+class SkCounters {
+public:
+    // Counts are sharded so that threads hammering the same counter don't bounce one
+    // cache line between cores.
+    static constexpr int kShards = 4;
+
+    struct Counter {
+        struct alignas(64) Shard {
+            std::atomic<uint64_t> fCount{0};
+        };
+
+        void add(uint64_t delta) {
+            fShards[ShardIndex()].fCount.fetch_add(delta, std::memory_order_relaxed);
+        }
+
+        uint64_t total() const {
+            uint64_t sum = 0;
+            for (const Shard& shard : fShards) {
+                sum += shard.fCount.load(std::memory_order_relaxed);
+            }
+            return sum;
+        }
+
+        const char* fName      = nullptr;
+        uint64_t    fLastTotal = 0;  // Only touched under the registry lock by Snapshot().
+        Shard       fShards[kShards];
+    };
+
+    // Returns the counter registered under name, creating it on first use. The returned
+    // pointer is valid for the life of the process. Thread safe, but meant to be called
+    // once per site via the macros below, not per count.
+    static Counter* Register(const char* name);
+
+    struct Value {
+        const char* fName;
+        uint64_t    fTotal;  // Count since process start.
+        uint64_t    fDelta;  // Count since the previous Snapshot().
+    };
+
+    // Copies current counter values into values[] (at most maxValues), returning the number
+    // written. Deltas cover the interval since the previous Snapshot(), so call once per frame.
+    static int Snapshot(Value values[], int maxValues);
+
+    // Takes a Snapshot() and reports each counter's per-frame delta as a counter event under
+    // the "skia" category of the installed SkEventTracer. A no-op if the category is disabled.
+    static void EmitFrameToTrace();
+
+private:
+    static uint32_t ShardIndex();
+};
+
+#define SK_COUNTER_ADD(name, delta)                                            \
+    do {                                                                       \
+        static SkCounters::Counter* sk_macro_counter =                         \
+                SkCounters::Register(name);                                    \
+        sk_macro_counter->add(delta);                                          \
+    } while (false)
+
+#define SK_COUNTER_INCREMENT(name) SK_COUNTER_ADD(name, 1)
+
+#endif
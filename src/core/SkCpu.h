@@ -45,6 +45,7 @@ struct SkCpu {
         VFP_FP16 = 1 << 2,
         CRC32    = 1 << 3,
         ASIMDHP  = 1 << 4,
+        SVE      = 1 << 5,
     };
 
     static void CacheRuntimeFeatures();
@@ -178,6 +178,10 @@ sk_sp<SkData> SkData::MakeSubset(const SkData* src, size_t offset, size_t length
                                     const_cast<SkData*>(src)));
 }
 
+sk_sp<SkData> SkData::makeSubset(size_t offset, size_t length) const {
+    return MakeSubset(this, offset, length);
+}
+
 sk_sp<SkData> SkData::MakeWithCString(const char cstr[]) {
     size_t size;
     if (nullptr == cstr) {
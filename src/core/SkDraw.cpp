@@ -33,6 +33,7 @@
 #include "src/core/SkScan.h"
 #include "src/core/SkStroke.h"
 #include "src/core/SkTLazy.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkUtils.h"
 
 #include <utility>
@@ -601,6 +602,51 @@ static void draw_rect_as_path(const SkDraw& orig, const SkRect& prePaintRect,
     draw.drawPath(tmp, paint, nullptr, true);
 }
 
+static SkExecutor* gTiledFillExecutor = nullptr;
+
+void SkDraw::SetTiledFillExecutor(SkExecutor* executor) { gTiledFillExecutor = executor; }
+
+// Fill an integral device-space rect in horizontal bands dispatched onto the
+// installed executor, building a blitter per band so no blitter state is
+// shared across threads.  Bands write disjoint rows, so this is only used for
+// non-AA fills where there's no supersampling state spanning scanlines.
+// Returns false if the fill isn't worth (or isn't safe) splitting, in which
+// case the caller blits as usual.
+static bool fill_rect_in_bands(const SkDraw& draw, const SkMatrixProvider* matrixProvider,
+                               const SkPaint& paint, const SkRect& devRect) {
+    SkExecutor* executor = gTiledFillExecutor;
+    if (!executor || !draw.fRC->isBW()) {
+        return false;
+    }
+
+    SkIRect ir = devRect.round();
+    if (devRect != SkRect::Make(ir)) {
+        // Band edges would round differently than SkScan::FillRect's XRect path.
+        return false;
+    }
+    if (!ir.intersect(draw.fRC->getBounds())) {
+        return true;   // Nothing to draw.
+    }
+
+    // Bands shorter than this cost more in blitter setup than they save.
+    constexpr int kBandHeight = 128;
+    if (ir.height() < 2 * kBandHeight) {
+        return false;
+    }
+
+    SkTaskGroup group(*executor);
+    for (int top = ir.top(); top < ir.bottom(); top += kBandHeight) {
+        const SkIRect band = SkIRect::MakeLTRB(ir.left(), top, ir.right(),
+                                               std::min(top + kBandHeight, ir.bottom()));
+        group.add([&draw, matrixProvider, &paint, band] {
+            SkAutoBlitterChoose blitter(draw, matrixProvider, paint);
+            SkScan::FillIRect(band, *draw.fRC, blitter.get());
+        });
+    }
+    group.wait();
+    return true;
+}
+
 void SkDraw::drawRect(const SkRect& prePaintRect, const SkPaint& paint,
                       const SkMatrix* paintMatrix, const SkRect* postPaintRect) const {
     SkDEBUGCODE(this->validate();)
@@ -673,7 +719,7 @@ void SkDraw::drawRect(const SkRect& prePaintRect, const SkPaint& paint,
         case kFill_RectType:
             if (paint.isAntiAlias()) {
                 SkScan::AntiFillRect(devRect, clip, blitter);
-            } else {
+            } else if (!fill_rect_in_bands(*this, matrixProvider, paint, devRect)) {
                 SkScan::FillRect(devRect, clip, blitter);
             }
             break;
@@ -814,6 +860,44 @@ SkScalar SkDraw::ComputeResScaleForStroking(const SkMatrix& matrix) {
     return 1;
 }
 
+static bool anti_fill_path_in_bands(const SkDraw& draw, const SkPath& devPath,
+                                    const SkPaint& paint, bool drawCoverage) {
+    SkExecutor* executor = gTiledFillExecutor;
+    if (!executor || !draw.fRC->isBW() || devPath.isInverseFillType()) {
+        return false;
+    }
+
+    SkIRect ir = devPath.getBounds().roundOut();
+    if (!ir.intersect(draw.fRC->getBounds())) {
+        return true;   // Nothing to draw.
+    }
+
+    // Supersampled coverage for a device row depends only on subsamples inside
+    // that row, so cutting at integer y is exact.  Each band re-clips the path
+    // to build just its own edges, so bands need to be tall enough to amortize
+    // that (and the per-band blitter) before the extra cores pay off.
+    constexpr int kBandHeight = 128;
+    if (ir.height() < 2 * kBandHeight) {
+        return false;
+    }
+
+    SkTaskGroup group(*executor);
+    for (int top = ir.top(); top < ir.bottom(); top += kBandHeight) {
+        const SkIRect band = SkIRect::MakeLTRB(ir.left(), top, ir.right(),
+                                               std::min(top + kBandHeight, ir.bottom()));
+        group.add([&draw, &devPath, &paint, drawCoverage, band] {
+            SkRasterClip bandClip(*draw.fRC);
+            if (!bandClip.op(band, SkRegion::kIntersect_Op)) {
+                return;
+            }
+            SkAutoBlitterChoose blitter(draw, nullptr, paint, drawCoverage);
+            SkScan::AntiFillPath(devPath, bandClip, blitter.get());
+        });
+    }
+    group.wait();
+    return true;
+}
+
 void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawCoverage,
                          SkBlitter* customBlitter, bool doFill) const {
     if (SkPathPriv::TooBigForMath(devPath)) {
@@ -839,6 +923,10 @@ void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawC
     void (*proc)(const SkPath&, const SkRasterClip&, SkBlitter*);
     if (doFill) {
         if (paint.isAntiAlias()) {
+            if (nullptr == customBlitter && nullptr == paint.getMaskFilter() &&
+                anti_fill_path_in_bands(*this, devPath, paint, drawCoverage)) {
+                return;
+            }
             proc = SkScan::AntiFillPath;
         } else {
             proc = SkScan::FillPath;
@@ -1100,10 +1188,10 @@ void SkDraw::drawBitmap(const SkBitmap& bitmap, const SkMatrix& prematrix,
         int ix = SkScalarRoundToInt(matrix.getTranslateX());
         int iy = SkScalarRoundToInt(matrix.getTranslateY());
         if (clipHandlesSprite(*fRC, ix, iy, pmap)) {
-            SkSTArenaAlloc<kSkBlitterContextSize> allocator;
+            SkScratchArenaScope allocator("SkDraw::drawBitmap");
             // blitter will be owned by the allocator.
-            SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, *paint, pmap, ix, iy, &allocator,
-                                                         fRC->clipShader());
+            SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, *paint, pmap, ix, iy,
+                                                         allocator.arena(), fRC->clipShader());
             if (blitter) {
                 SkScan::FillIRect(SkIRect::MakeXYWH(ix, iy, pmap.width(), pmap.height()),
                                   *fRC, blitter);
@@ -1157,8 +1245,8 @@ void SkDraw::drawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint& ori
 
     if (nullptr == paint.getColorFilter() && clipHandlesSprite(*fRC, x, y, pmap)) {
         // blitter will be owned by the allocator.
-        SkSTArenaAlloc<kSkBlitterContextSize> allocator;
-        SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, paint, pmap, x, y, &allocator,
+        SkScratchArenaScope allocator("SkDraw::drawSprite");
+        SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, paint, pmap, x, y, allocator.arena(),
                                                      fRC->clipShader());
         if (blitter) {
             SkScan::FillIRect(bounds, *fRC, blitter);
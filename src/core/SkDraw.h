@@ -21,6 +21,7 @@ class SkBitmap;
 class SkClipStack;
 class SkBaseDevice;
 class SkBlitter;
+class SkExecutor;
 class SkMatrix;
 class SkMatrixProvider;
 class SkPath;
@@ -123,6 +124,14 @@ public:
 
     static SkScalar ComputeResScaleForStroking(const SkMatrix& );
 
+    /**
+     *  Install an executor used to split large non-AA rect fills into
+     *  horizontal bands, each blitted by its own per-thread blitter.
+     *  Does not take ownership.  Not thread safe; pass nullptr to disable
+     *  (the default).
+     */
+    static void SetTiledFillExecutor(SkExecutor*);
+
 private:
     void drawBitmapAsMask(const SkBitmap&, const SkPaint&) const;
     void draw_fixed_vertices(const SkVertices*, SkBlendMode, const SkPaint&, const SkMatrix&,
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkDrawProfiler.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkShader.h"
+#include "include/private/SkMutex.h"
+#include "src/shaders/SkShaderBase.h"
+#include "src/utils/SkJSONWriter.h"
+
+#include <algorithm>
+
+std::atomic<bool> SkDrawProfiler::gEnabled{false};
+
+namespace {
+
+enum class ShaderKind : uint8_t {
+    kNone,
+    kColor,
+    kGradient,
+    kImage,
+    kRuntime,
+    kOther,
+};
+
+struct SampleRec {
+    SkRect          fDeviceBounds;
+    uint16_t        fFlags;
+    SkDrawProfiler::Op fOp;
+    ShaderKind      fShaderKind;
+    bool            fHasBounds;
+};
+
+constexpr int kMaxSamples = 4096;
+
+SampleRec gSamples[kMaxSamples];
+int gSampleCount = 0;        // total samples recorded (may exceed kMaxSamples)
+int gSamplePeriod = 64;
+std::atomic<uint64_t> gDrawCount{0};
+
+SkMutex& sample_mutex() {
+    static SkMutex& mutex = *(new SkMutex);
+    return mutex;
+}
+
+ShaderKind classify_shader(const SkShader* shader) {
+    if (!shader) {
+        return ShaderKind::kNone;
+    }
+    if (as_SB(shader)->isConstant()) {
+        return ShaderKind::kColor;
+    }
+    if (shader->isAImage()) {
+        return ShaderKind::kImage;
+    }
+    if (shader->asAGradient(nullptr) != SkShader::kNone_GradientType) {
+        return ShaderKind::kGradient;
+    }
+    if (as_SB(shader)->asRuntimeEffect()) {
+        return ShaderKind::kRuntime;
+    }
+    return ShaderKind::kOther;
+}
+
+uint16_t fingerprint_paint(const SkPaint& paint) {
+    uint16_t flags = 0;
+    if (paint.isAntiAlias())                         { flags |= SkDrawProfiler::kAntiAlias_Flag; }
+    if (paint.isDither())                            { flags |= SkDrawProfiler::kDither_Flag; }
+    if (paint.getStyle() != SkPaint::kFill_Style)    { flags |= SkDrawProfiler::kStroke_Flag; }
+    if (paint.getBlendMode() != SkBlendMode::kSrcOver) {
+        flags |= SkDrawProfiler::kNonSrcOverXfer_Flag;
+    }
+    if (paint.getShader())      { flags |= SkDrawProfiler::kShader_Flag; }
+    if (paint.getColorFilter()) { flags |= SkDrawProfiler::kColorFilter_Flag; }
+    if (paint.getMaskFilter())  { flags |= SkDrawProfiler::kMaskFilter_Flag; }
+    if (paint.getPathEffect())  { flags |= SkDrawProfiler::kPathEffect_Flag; }
+    if (paint.getImageFilter()) { flags |= SkDrawProfiler::kImageFilter_Flag; }
+    return flags;
+}
+
+const char* op_name(SkDrawProfiler::Op op) {
+    switch (op) {
+        case SkDrawProfiler::Op::kPaint:     return "paint";
+        case SkDrawProfiler::Op::kPoints:    return "points";
+        case SkDrawProfiler::Op::kRect:      return "rect";
+        case SkDrawProfiler::Op::kOval:      return "oval";
+        case SkDrawProfiler::Op::kRRect:     return "rrect";
+        case SkDrawProfiler::Op::kPath:      return "path";
+        case SkDrawProfiler::Op::kImage:     return "image";
+        case SkDrawProfiler::Op::kImageRect: return "imageRect";
+        case SkDrawProfiler::Op::kTextBlob:  return "textBlob";
+        case SkDrawProfiler::Op::kVertices:  return "vertices";
+    }
+    SkUNREACHABLE;
+}
+
+const char* shader_kind_name(ShaderKind kind) {
+    switch (kind) {
+        case ShaderKind::kNone:     return "none";
+        case ShaderKind::kColor:    return "color";
+        case ShaderKind::kGradient: return "gradient";
+        case ShaderKind::kImage:    return "image";
+        case ShaderKind::kRuntime:  return "runtime";
+        case ShaderKind::kOther:    return "other";
+    }
+    SkUNREACHABLE;
+}
+
+}  // namespace
+
+void SkDrawProfiler::Enable(int samplePeriod) {
+    SkAutoMutexExclusive lock(sample_mutex());
+    gSamplePeriod = std::max(1, samplePeriod);
+    gSampleCount = 0;
+    gDrawCount.store(0, std::memory_order_relaxed);
+    gEnabled.store(true, std::memory_order_relaxed);
+}
+
+void SkDrawProfiler::Disable() {
+    gEnabled.store(false, std::memory_order_relaxed);
+}
+
+void SkDrawProfiler::Reset() {
+    SkAutoMutexExclusive lock(sample_mutex());
+    gSampleCount = 0;
+    gDrawCount.store(0, std::memory_order_relaxed);
+}
+
+void SkDrawProfiler::RecordSample(const SkCanvas* canvas, Op op, const SkPaint* paint,
+                                  const SkRect* localBounds) {
+    // The rate limiter runs on every draw while enabled; everything below only on sampled ones.
+    uint64_t n = gDrawCount.fetch_add(1, std::memory_order_relaxed);
+    if (n % gSamplePeriod) {
+        return;
+    }
+
+    SampleRec sample;
+    sample.fOp = op;
+    sample.fFlags = paint ? fingerprint_paint(*paint) : 0;
+    sample.fShaderKind = paint ? classify_shader(paint->getShader()) : ShaderKind::kNone;
+    sample.fHasBounds = SkToBool(localBounds);
+    if (localBounds) {
+        sample.fDeviceBounds = canvas->getTotalMatrix().mapRect(*localBounds);
+    } else {
+        sample.fDeviceBounds = SkRect::MakeEmpty();
+    }
+
+    SkAutoMutexExclusive lock(sample_mutex());
+    gSamples[gSampleCount % kMaxSamples] = sample;
+    gSampleCount++;
+}
+
+void SkDrawProfiler::ExportJson(SkJSONWriter* writer) {
+    SkAutoMutexExclusive lock(sample_mutex());
+
+    writer->beginObject();
+    writer->appendS32("samplePeriod", gSamplePeriod);
+    writer->appendU64("drawCount", gDrawCount.load(std::memory_order_relaxed));
+    writer->appendS32("sampleCount", gSampleCount);
+
+    writer->beginArray("samples");
+    int count = std::min(gSampleCount, kMaxSamples);
+    // When the ring has wrapped, start at the oldest surviving sample.
+    int start = gSampleCount > kMaxSamples ? gSampleCount % kMaxSamples : 0;
+    for (int i = 0; i < count; ++i) {
+        const SampleRec& sample = gSamples[(start + i) % kMaxSamples];
+        writer->beginObject();
+        writer->appendString("op", op_name(sample.fOp));
+        writer->appendU32("flags", sample.fFlags);
+        writer->appendString("shader", shader_kind_name(sample.fShaderKind));
+        if (sample.fHasBounds) {
+            writer->beginArray("bounds", false);
+            writer->appendFloat(sample.fDeviceBounds.fLeft);
+            writer->appendFloat(sample.fDeviceBounds.fTop);
+            writer->appendFloat(sample.fDeviceBounds.fRight);
+            writer->appendFloat(sample.fDeviceBounds.fBottom);
+            writer->endArray();
+        }
+        writer->endObject();
+    }
+    writer->endArray();
+    writer->endObject();
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDrawProfiler_DEFINED
+#define SkDrawProfiler_DEFINED
+
+#include "include/core/SkTypes.h"
+
+#include <atomic>
+
+class SkCanvas;
+class SkJSONWriter;
+class SkPaint;
+struct SkRect;
+
+/**
+ *  Opt-in sampling profiler for SkCanvas draw calls. When enabled, every Nth draw dispatched
+ *  through an SkCanvas::onDraw* entry point records a compact fingerprint (op type, paint
+ *  feature flags, shader kind, approximate device bounds) into a fixed-size ring buffer.
+ *  Samples can then be exported as JSON and aggregated offline to attribute raster cost to
+ *  the shapes and paints that produced it, without an external profiler.
+ *
+ *  The hot-path cost when disabled is a single relaxed atomic load, so the hooks are safe to
+ *  leave in production builds. Recording is thread-safe; the ring buffer overwrites the
+ *  oldest samples once full.
+ */
+class SkDrawProfiler {
+public:
+    enum class Op : uint8_t {
+        kPaint,
+        kPoints,
+        kRect,
+        kOval,
+        kRRect,
+        kPath,
+        kImage,
+        kImageRect,
+        kTextBlob,
+        kVertices,
+
+        kLast = kVertices,
+    };
+
+    // Bits reported in each sample's "flags" field.
+    enum FlagBits {
+        kAntiAlias_Flag      = 1 << 0,
+        kDither_Flag         = 1 << 1,
+        kStroke_Flag         = 1 << 2,  // style is not kFill_Style
+        kNonSrcOverXfer_Flag = 1 << 3,
+        kShader_Flag         = 1 << 4,
+        kColorFilter_Flag    = 1 << 5,
+        kMaskFilter_Flag     = 1 << 6,  // typically a blur
+        kPathEffect_Flag     = 1 << 7,
+        kImageFilter_Flag    = 1 << 8,
+    };
+
+    /**
+     *  Starts sampling: one of every 'samplePeriod' draws is recorded. Resets any previously
+     *  collected samples.
+     */
+    static void Enable(int samplePeriod = 64);
+    static void Disable();
+
+    static bool IsEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     *  Called by the SkCanvas onDraw* hooks. 'localBounds' is in the canvas' local space and
+     *  may be null when no cheap bounds are available (e.g. drawPaint).
+     */
+    static void Sample(const SkCanvas* canvas, Op op, const SkPaint* paint,
+                       const SkRect* localBounds) {
+        if (gEnabled.load(std::memory_order_relaxed)) {
+            RecordSample(canvas, op, paint, localBounds);
+        }
+    }
+
+    /**
+     *  Writes the collected samples as a JSON object: the sample period, total draw count, and
+     *  a "samples" array of fingerprints. May be called while sampling is active.
+     */
+    static void ExportJson(SkJSONWriter*);
+
+    /** Discards all collected samples and resets the draw count. */
+    static void Reset();
+
+private:
+    static void RecordSample(const SkCanvas*, Op, const SkPaint*, const SkRect* localBounds);
+
+    static std::atomic<bool> gEnabled;
+};
+
+#endif
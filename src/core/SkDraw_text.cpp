@@ -114,12 +114,24 @@ void SkDraw::paintPaths(SkDrawableGlyphBuffer* drawables,
                         SkScalar scale,
                         SkPoint origin,
                         const SkPaint& paint) const {
+    // When the blitter doesn't depend on each glyph's position (no shader or
+    // mask filter to line up with device space), choose it once and reuse it
+    // for the whole run.  The blitter's scratch storage -- blit memory and
+    // the scan converters' run arrays -- then gets recycled across the run's
+    // glyphs instead of being reallocated and rebuilt per glyph.
+    SkSTArenaAlloc<3308> alloc;
+    SkBlitter* reusedBlitter = nullptr;
+    if (!paint.getShader() && !paint.getMaskFilter() && !fCoverage) {
+        reusedBlitter = SkBlitter::Choose(fDst, *fMatrixProvider, paint, &alloc, false,
+                                          fRC->clipShader());
+    }
+
     for (auto [variant, pos] : drawables->drawable()) {
         const SkPath* path = variant.path();
         SkMatrix m;
         SkPoint translate = origin + pos;
         m.setScaleTranslate(scale, scale, translate.x(), translate.y());
-        this->drawPath(*path, paint, &m, false);
+        this->drawPath(*path, paint, &m, false, false, reusedBlitter);
     }
 }
 
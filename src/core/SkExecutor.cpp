@@ -10,6 +10,7 @@
 #include "include/private/SkSemaphore.h"
 #include "include/private/SkSpinlock.h"
 #include "include/private/SkTArray.h"
+#include <atomic>
 #include <deque>
 #include <thread>
 
@@ -27,6 +28,20 @@
     }
 #endif
 
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #include <pthread.h>
+    #include <sched.h>
+    static void pin_to_core(int i) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(i % num_cores(), &set);
+        // Best effort; the pool works fine unpinned if the sandbox disallows it.
+        (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#else
+    static void pin_to_core(int) {}
+#endif
+
 SkExecutor::~SkExecutor() {}
 
 // The default default SkExecutor is an SkTrivialExecutor, which just runs the work right away.
@@ -141,6 +156,117 @@ private:
     bool                  fAllowBorrowing;
 };
 
+// A work-stealing pool: each thread owns a set of deques (one per priority) and steals from
+// the other threads when its own run dry. add() spreads work round-robin across the
+// per-thread queues, so concurrent submitters don't contend on a single lock.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    SkWorkStealingThreadPool(int threads, bool allowBorrowing, bool pinThreads)
+            : fAllowBorrowing(allowBorrowing) {
+        for (int i = 0; i < threads; i++) {
+            fWorkers.emplace_back(new Worker);
+        }
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back([this, i, pinThreads] {
+                if (pinThreads) {
+                    pin_to_core(i);
+                }
+                this->loop(i);
+            });
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Signal each thread that it's time to shut down.
+        for (int i = 0; i < fThreads.count(); i++) {
+            this->add(nullptr);
+        }
+        // Wait for each thread to shut down.
+        for (int i = 0; i < fThreads.count(); i++) {
+            fThreads[i].join();
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        this->addWithPriority(std::move(work), Priority::kNormal);
+    }
+
+    void addWithPriority(std::function<void(void)> work, Priority priority) override {
+        uint32_t i = fNextQueue.fetch_add(1, std::memory_order_relaxed) % fWorkers.count();
+        {
+            SkAutoMutexExclusive lock(fWorkers[i]->fLock);
+            fWorkers[i]->fWork[(int)priority].emplace_back(std::move(work));
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        // If there is work waiting and we're allowed to borrow work, do it.
+        if (fAllowBorrowing && fWorkAvailable.try_wait()) {
+            SkAssertResult(this->do_work(0));
+        }
+    }
+
+private:
+    static constexpr int kPriorityCount = (int)Priority::kHigh + 1;
+
+    struct Worker {
+        SkMutex                               fLock;
+        std::deque<std::function<void(void)>> fWork[kPriorityCount];
+    };
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    bool do_work(int self) {
+        std::function<void(void)> work;
+        const int n = fWorkers.count();
+        bool found = false;
+        while (!found) {
+            // Check our own queues first (highest priority first), then steal from the others.
+            // Another thread can take the item we were signaled for, but then the item backing
+            // its own signal is still queued somewhere, so rescanning always terminates.
+            for (int attempt = 0; attempt < n && !found; attempt++) {
+                Worker& w = *fWorkers[(self + attempt) % n];
+                SkAutoMutexExclusive lock(w.fLock);
+                for (int priority = kPriorityCount - 1; priority >= 0; priority--) {
+                    auto& queue = w.fWork[priority];
+                    if (!queue.empty()) {
+                        if (0 == attempt) {
+                            // FIFO from our own queue.
+                            work = std::move(queue.front());
+                            queue.pop_front();
+                        } else {
+                            // Steal from the cold end of the victim's queue.
+                            work = std::move(queue.back());
+                            queue.pop_back();
+                        }
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!work) {
+            return false;  // This is loop()'s signal to shut down.
+        }
+
+        work();
+        return true;
+    }
+
+    void loop(int self) {
+        do {
+            fWorkAvailable.wait();
+        } while (this->do_work(self));
+    }
+
+    SkTArray<std::unique_ptr<Worker>> fWorkers;
+    SkTArray<std::thread>             fThreads;
+    SkSemaphore                       fWorkAvailable;
+    std::atomic<uint32_t>             fNextQueue{0};
+    bool                              fAllowBorrowing;
+};
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads, bool allowBorrowing) {
     using WorkList = std::deque<std::function<void(void)>>;
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
@@ -151,3 +277,9 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads, bool all
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
                                                     allowBorrowing);
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads,
+                                                                   bool allowBorrowing,
+                                                                   bool pinThreads) {
+    return std::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores(),
+                                                      allowBorrowing, pinThreads);
+}
@@ -8,10 +8,13 @@
 #include "src/core/SkGlyph.h"
 
 #include "src/core/SkArenaAlloc.h"
+#include "src/core/SkAutoMalloc.h"
 #include "src/core/SkScalerContext.h"
 #include "src/pathops/SkPathOpsCubic.h"
 #include "src/pathops/SkPathOpsQuad.h"
 
+#include <atomic>
+
 constexpr SkIPoint SkPackedGlyphID::kXYFieldMask;
 
 SkMask SkGlyph::mask() const {
@@ -19,7 +22,7 @@ SkMask SkGlyph::mask() const {
     SkASSERT(fMaskFormat != MASK_FORMAT_UNKNOWN);
 
     SkMask mask;
-    mask.fImage = (uint8_t*)fImage;
+    mask.fImage = (uint8_t*)(fImage != nullptr ? this->image() : nullptr);
     mask.fBounds.setXYWH(fLeft, fTop, fWidth, fHeight);
     mask.fRowBytes = this->rowBytes();
     mask.fFormat = static_cast<SkMask::Format>(fMaskFormat);
@@ -80,13 +83,141 @@ size_t SkGlyph::allocImage(SkArenaAlloc* alloc) {
     return size;
 }
 
+// Glyph masks are mostly long runs of transparent and opaque pixels, so a byte oriented
+// PackBits-style RLE gets a 3-4x reduction on typical A8 and LCD masks for a roughly
+// microsecond-scale unpack. A compressed block is a uint32_t byte count followed by the
+// encoded stream: a control byte n <= 127 is followed by n+1 literal bytes, and n >= 129 by
+// one byte repeated 257-n times; 128 is unused.
+static std::atomic<size_t> gImageCompressionThreshold{1024};
+
+size_t SkGlyph::GetImageCompressionThreshold() {
+    return gImageCompressionThreshold.load(std::memory_order_relaxed);
+}
+
+size_t SkGlyph::SetImageCompressionThreshold(size_t bytes) {
+    return gImageCompressionThreshold.exchange(bytes, std::memory_order_relaxed);
+}
+
+// Encode src into dst. Returns the encoded size, or 0 if it would exceed maxDstSize.
+static size_t pack_bits(const uint8_t* src, size_t size, uint8_t* dst, size_t maxDstSize) {
+    size_t dstUsed = 0;
+    size_t i = 0;
+    while (i < size) {
+        // Measure the run starting at i, up to the 128 a control byte can express.
+        size_t run = 1;
+        while (run < 128 && i + run < size && src[i + run] == src[i]) {
+            run += 1;
+        }
+        if (run >= 3) {
+            if (dstUsed + 2 > maxDstSize) {
+                return 0;
+            }
+            dst[dstUsed++] = (uint8_t)(257 - run);
+            dst[dstUsed++] = src[i];
+            i += run;
+            continue;
+        }
+        // Gather literals until the next run of 3 (or the end), up to 128 per control byte.
+        size_t literal = i;
+        while (literal < size && literal - i < 128) {
+            if (literal + 2 < size &&
+                src[literal] == src[literal + 1] && src[literal] == src[literal + 2]) {
+                break;
+            }
+            literal += 1;
+        }
+        size_t count = literal - i;
+        if (dstUsed + 1 + count > maxDstSize) {
+            return 0;
+        }
+        dst[dstUsed++] = (uint8_t)(count - 1);
+        memcpy(dst + dstUsed, src + i, count);
+        dstUsed += count;
+        i = literal;
+    }
+    return dstUsed;
+}
+
+static void unpack_bits(const uint8_t* src, uint8_t* dst, size_t dstSize) {
+    uint8_t* stop = dst + dstSize;
+    while (dst < stop) {
+        uint8_t control = *src++;
+        if (control <= 127) {
+            size_t count = control + 1;
+            SkASSERT(dst + count <= stop);
+            memcpy(dst, src, count);
+            src += count;
+            dst += count;
+        } else {
+            size_t count = 257 - control;
+            SkASSERT(dst + count <= stop);
+            memset(dst, *src++, count);
+            dst += count;
+        }
+    }
+}
+
+void SkGlyph::installImage(SkArenaAlloc* alloc, const void* image) {
+    SkASSERT(!this->setImageHasBeenCalled());
+    size_t size = this->imageSize();
+
+    // Color images don't RLE well, and everything else is byte or word masks that do.
+    if (size >= GetImageCompressionThreshold() && fMaskFormat != SkMask::kARGB32_Format) {
+        // Only keep the encoding if it saves at least a quarter of the raw size; below that
+        // the unpack cost on access isn't buying enough memory back.
+        size_t budget = size - size / 4;
+        SkAutoMalloc packed(budget);
+        size_t packedSize = pack_bits((const uint8_t*)image, size, (uint8_t*)packed.get(), budget);
+        if (packedSize != 0) {
+            uint32_t* block = (uint32_t*)alloc->makeBytesAlignedTo(
+                    sizeof(uint32_t) + packedSize, alignof(uint32_t));
+            *block = SkToU32(packedSize);
+            memcpy(block + 1, packed.get(), packedSize);
+            fImage = block;
+            fImageIsCompressed = true;
+            return;
+        }
+    }
+
+    this->allocImage(alloc);
+    memcpy(fImage, image, size);
+}
+
+const void* SkGlyph::image() const {
+    SkASSERT(this->setImageHasBeenCalled());
+    if (!fImageIsCompressed) {
+        return fImage;
+    }
+
+    // Per-thread scratch holding the most recently unpacked image. The returned pointer is
+    // only valid until the next image() call on this thread.
+    struct Scratch {
+        SkAutoMalloc fData;
+        size_t       fCapacity = 0;
+    };
+    static thread_local Scratch scratch;
+
+    size_t size = this->imageSize();
+    if (scratch.fCapacity < size) {
+        scratch.fData.reset(size);
+        scratch.fCapacity = size;
+    }
+    const uint32_t* block = (const uint32_t*)fImage;
+    unpack_bits((const uint8_t*)(block + 1), (uint8_t*)scratch.fData.get(), size);
+    return scratch.fData.get();
+}
+
 bool SkGlyph::setImage(SkArenaAlloc* alloc, SkScalerContext* scalerContext) {
     if (!this->setImageHasBeenCalled()) {
         // It used to be that getImage() could change the fMaskFormat. Extra checking to make
         // sure there are no regressions.
         SkDEBUGCODE(SkMask::Format oldFormat = this->maskFormat());
-        this->allocImage(alloc);
+        // Rasterize into scratch memory, then keep only the bytes worth storing.
+        SkAutoMalloc raw(this->imageSize());
+        fImage = raw.get();
         scalerContext->getImage(*this);
+        fImage = nullptr;
+        this->installImage(alloc, raw.get());
         SkASSERT(oldFormat == this->maskFormat());
         return true;
     }
@@ -95,8 +226,7 @@ bool SkGlyph::setImage(SkArenaAlloc* alloc, SkScalerContext* scalerContext) {
 
 bool SkGlyph::setImage(SkArenaAlloc* alloc, const void* image) {
     if (!this->setImageHasBeenCalled()) {
-        this->allocImage(alloc);
-        memcpy(fImage, image, this->imageSize());
+        this->installImage(alloc, image);
         return true;
     }
     return false;
@@ -114,7 +244,19 @@ bool SkGlyph::setMetricsAndImage(SkArenaAlloc* alloc, const SkGlyph& from) {
         fMaskFormat = from.fMaskFormat;
 
         // From glyph may not have an image because the glyph is too large.
-        return from.fImage != nullptr && this->setImage(alloc, from.image());
+        if (from.fImage == nullptr) {
+            return false;
+        }
+        if (from.fImageIsCompressed) {
+            // Share the encoding work: copy the compressed block as-is.
+            size_t storage = from.imageStorageSize();
+            void* block = alloc->makeBytesAlignedTo(storage, alignof(uint32_t));
+            memcpy(block, from.fImage, storage);
+            fImage = block;
+            fImageIsCompressed = true;
+            return true;
+        }
+        return this->setImage(alloc, from.image());
     }
     return false;
 }
@@ -139,6 +281,13 @@ size_t SkGlyph::imageSize() const {
     return size;
 }
 
+size_t SkGlyph::imageStorageSize() const {
+    if (fImageIsCompressed) {
+        return sizeof(uint32_t) + *(const uint32_t*)fImage;
+    }
+    return this->imageSize();
+}
+
 void SkGlyph::installPath(SkArenaAlloc* alloc, const SkPath* path) {
     SkASSERT(fPathData == nullptr);
     SkASSERT(!this->setPathHasBeenCalled());
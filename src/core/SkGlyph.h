@@ -211,6 +211,13 @@ public:
     bool setImage(SkArenaAlloc* alloc, SkScalerContext* scalerContext);
     bool setImage(SkArenaAlloc* alloc, const void* image);
 
+    // Images at least this many bytes are stored run length encoded in the strike when that
+    // actually saves memory; smaller images and images that don't compress well are stored raw.
+    // Set returns the previous threshold; use SIZE_MAX to disable compression entirely.
+    // These are normally reached through SkGraphics::{Get,Set}GlyphImageCompressionThreshold.
+    static size_t GetImageCompressionThreshold();
+    static size_t SetImageCompressionThreshold(size_t bytes);
+
     // Merge the from glyph into this glyph using alloc to allocate image data. Return true if
     // image data was allocated. If the image for this glyph has not been initialized, then copy
     // the width, height, top, left, format, and image into this glyph making a copy of the image
@@ -222,12 +229,18 @@ public:
         return fImage != nullptr || this->isEmpty() || this->imageTooLarge();
     }
 
-    // Return a pointer to the path if the image exists, otherwise return nullptr.
-    const void* image() const { SkASSERT(this->setImageHasBeenCalled()); return fImage; }
+    // Return a pointer to the image if it exists, otherwise return nullptr. If the image is
+    // stored compressed it is expanded into a per-thread scratch buffer; such a pointer is only
+    // valid until the next image() call on the same thread, so copy out of it promptly.
+    const void* image() const;
 
     // Return the size of the image.
     size_t imageSize() const;
 
+    // Return the number of bytes the image actually occupies in the strike's arena, which is
+    // smaller than imageSize() when the image is stored compressed.
+    size_t imageStorageSize() const;
+
     // Path
     // If we haven't already tried to associate a path to this glyph
     // (i.e. setPathHasBeenCalled() returns false), then use the
@@ -321,6 +334,9 @@ private:
 
     size_t allocImage(SkArenaAlloc* alloc);
 
+    // Store a copy of image in the arena, run length encoded when that is a real win.
+    void installImage(SkArenaAlloc* alloc, const void* image);
+
     // path == nullptr indicates that there is no path.
     void installPath(SkArenaAlloc* alloc, const SkPath* path);
 
@@ -352,6 +368,9 @@ private:
     // Used by the DirectWrite scaler to track state.
     int8_t    fForceBW = 0;
 
+    // When set, fImage points at a run length encoded block rather than raw pixels.
+    bool      fImageIsCompressed = false;
+
     const SkPackedGlyphID fID;
 };
 
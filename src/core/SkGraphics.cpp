@@ -19,6 +19,7 @@
 #include "src/core/SkBlitter.h"
 #include "src/core/SkCpu.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
@@ -40,6 +41,8 @@ void SkGraphics::Init() {
 void SkGraphics::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
   SkResourceCache::DumpMemoryStatistics(dump);
   SkStrikeCache::DumpMemoryStatistics(dump);
+  SkTypefaceCache::DumpMemoryStatistics(dump);
+  SkImageFilterCache::Get()->dumpMemoryStatistics(dump);
 }
 
 void SkGraphics::PurgeAllCaches() {
@@ -128,6 +131,14 @@ int SkGraphics::SetFontCachePointSizeLimit(int limit) {
     return SkStrikeCache::GlobalStrikeCache()->setCachePointSizeLimit(limit);
 }
 
+size_t SkGraphics::GetGlyphImageCompressionThreshold() {
+    return SkGlyph::GetImageCompressionThreshold();
+}
+
+size_t SkGraphics::SetGlyphImageCompressionThreshold(size_t bytes) {
+    return SkGlyph::SetImageCompressionThreshold(bytes);
+}
+
 void SkGraphics::PurgeFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgeAll();
     SkTypefaceCache::PurgeAll();
@@ -8,6 +8,7 @@
 #include "include/core/SkImageFilter.h"
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "include/core/SkRect.h"
 #include "include/effects/SkComposeImageFilter.h"
 #include "include/private/SkSafe32.h"
@@ -16,9 +17,11 @@
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkLocalMatrixImageFilter.h"
 #include "src/core/SkMatrixImageFilter.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkSpecialSurface.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkValidationUtils.h"
 #include "src/core/SkWriteBuffer.h"
 #if SK_SUPPORT_GPU
@@ -205,6 +208,26 @@ void SkImageFilter_Base::flatten(SkWriteBuffer& buffer) const {
     buffer.writeUInt(fCropRect.flags());
 }
 
+uint32_t SkImageFilter_Base::fingerprint() const {
+    fFingerprintOnce([this] {
+        sk_sp<SkData> data = this->serialize();
+        // Filters that fail to serialize (no registered factory) fall back to the instance ID,
+        // which degrades content keying to instance keying but stays correct.
+        fFingerprint = data ? SkOpts::hash(data->data(), data->size()) : fUniqueID;
+    });
+    return fFingerprint;
+}
+
+// Rounds away subpixel translation so that cross-frame cache keys still match when only the
+// fractional placement of a layer animates. All other components must match exactly; changing
+// scale or rotation produces genuinely different results.
+static SkMatrix quantize_layer_matrix(const SkMatrix& matrix) {
+    SkMatrix quantized = matrix;
+    quantized[SkMatrix::kMTransX] = SkScalarRoundToScalar(matrix.getTranslateX());
+    quantized[SkMatrix::kMTransY] = SkScalarRoundToScalar(matrix.getTranslateY());
+    return quantized;
+}
+
 skif::FilterResult<For::kOutput> SkImageFilter_Base::filterImage(const skif::Context& context) const {
     // TODO (michaelludwig) - Old filters have an implicit assumption that the source image
     // (originally passed separately) has an origin of (0, 0). SkComposeImageFilter makes an effort
@@ -227,6 +250,18 @@ skif::FilterResult<For::kOutput> SkImageFilter_Base::filterImage(const skif::Con
         return result;
     }
 
+    // A second, content-based key survives both this instance's destruction and subpixel
+    // animation of the layer: structurally identical DAGs share a fingerprint, and the matrix
+    // is quantized to whole-pixel translation. This is what lets a static blurred backdrop
+    // behind a moving foreground reuse last frame's result instead of re-running the chain.
+    SkImageFilterCacheKey persistentKey(this->fingerprint(),
+                                        quantize_layer_matrix(context.mapping().layerMatrix()),
+                                        context.clipBounds(), srcGenID, srcSubset,
+                                        /*contentKeyed=*/true);
+    if (context.cache() && context.cache()->get(persistentKey, &result)) {
+        return result;
+    }
+
     result = this->onFilterImage(context);
 
     if (context.gpuBacked()) {
@@ -235,11 +270,81 @@ skif::FilterResult<For::kOutput> SkImageFilter_Base::filterImage(const skif::Con
 
     if (context.cache()) {
         context.cache()->set(key, this, result);
+        // The persistent entry is deliberately not tied to 'this'; it outlives the instance and
+        // is evicted by the cache's byte budget rather than by purgeByImageFilter().
+        context.cache()->set(persistentKey, nullptr, result);
     }
 
     return result;
 }
 
+skif::FilterResult<For::kOutput> SkImageFilter_Base::filterImageTiled(
+        const skif::Context& context) const {
+    static constexpr int kTileDim = 256;
+
+    const SkIRect output = context.clipBounds();
+    // Tiling only pays off for CPU evaluation of outputs spanning several tiles; a GPU backend
+    // serializes onto one queue anyway and a single tile would just add a copy.
+    if (context.gpuBacked() || !context.isValid() ||
+        (output.width() <= kTileDim && output.height() <= kTileDim)) {
+        return this->filterImage(context);
+    }
+
+    sk_sp<SkSpecialSurface> surf(context.makeSurface(output.size()));
+    if (!surf) {
+        return this->filterImage(context);
+    }
+
+    struct Tile {
+        SkIRect fBounds;
+        skif::FilterResult<For::kOutput> fResult;
+    };
+
+    std::vector<Tile> tiles;
+    for (int top = output.top(); top < output.bottom(); top += kTileDim) {
+        for (int left = output.left(); left < output.right(); left += kTileDim) {
+            Tile tile;
+            tile.fBounds = SkIRect::MakeLTRB(left, top,
+                                             std::min(left + kTileDim, output.right()),
+                                             std::min(top + kTileDim, output.bottom()));
+            tiles.push_back(tile);
+        }
+    }
+
+    // Evaluate every tile through the DAG. The source image is shared and read only, each
+    // evaluation renders to its own intermediate surfaces, and the filter cache is mutex
+    // protected, so the tiles can run concurrently.
+    SkTaskGroup taskGroup;
+    for (Tile& tile : tiles) {
+        taskGroup.add([this, &context, &tile] {
+            tile.fResult = this->filterImage(
+                    context.withNewDesiredOutput(skif::LayerSpace<SkIRect>(tile.fBounds)));
+        });
+    }
+    taskGroup.wait();
+
+    // Assemble on the calling thread; SkCanvas is not thread safe.
+    SkCanvas* canvas = surf->getCanvas();
+    canvas->clear(SK_ColorTRANSPARENT);
+    for (const Tile& tile : tiles) {
+        SkIPoint offset;
+        sk_sp<SkSpecialImage> image = tile.fResult.imageAndOffset(&offset);
+        if (!image) {
+            continue;
+        }
+        // A tile's result may extend past its desired output; clip so neighboring tiles do not
+        // double-cover the overlap.
+        canvas->save();
+        canvas->clipRect(SkRect::Make(tile.fBounds.makeOffset(-output.left(), -output.top())));
+        image->draw(canvas, SkIntToScalar(offset.x() - output.left()),
+                    SkIntToScalar(offset.y() - output.top()), nullptr);
+        canvas->restore();
+    }
+
+    return skif::FilterResult<For::kOutput>(surf->makeImageSnapshot(),
+                                            skif::LayerSpace<SkIPoint>(output.topLeft()));
+}
+
 skif::LayerSpace<SkIRect> SkImageFilter_Base::getInputBounds(
         const skif::Mapping& mapping, const skif::DeviceSpace<SkRect>& desiredOutput,
         const skif::ParameterSpace<SkRect>* knownContentBounds) const {
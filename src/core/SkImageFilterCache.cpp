@@ -11,9 +11,12 @@
 
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/private/SkMutex.h"
 #include "include/private/SkOnce.h"
 #include "include/private/SkTHash.h"
+#include "src/core/SkCounters.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkTDynamicHash.h"
@@ -62,8 +65,10 @@ public:
             }
 
             *result = v->fImage;
+            SK_COUNTER_INCREMENT("imagefilter_cache_hit");
             return true;
         }
+        SK_COUNTER_INCREMENT("imagefilter_cache_miss");
         return false;
     }
 
@@ -77,10 +82,12 @@ public:
         fLookup.add(v);
         fLRU.addToHead(v);
         fCurrentBytes += result.image() ? result.image()->getSize() : 0;
-        if (auto* values = fImageFilterValues.find(filter)) {
-            values->push_back(v);
-        } else {
-            fImageFilterValues.set(filter, {v});
+        if (filter) {
+            if (auto* values = fImageFilterValues.find(filter)) {
+                values->push_back(v);
+            } else {
+                fImageFilterValues.set(filter, {v});
+            }
         }
 
         while (fCurrentBytes > fMaxBytes) {
@@ -117,6 +124,32 @@ public:
         fImageFilterValues.remove(filter);
     }
 
+    void dumpMemoryStatistics(SkTraceMemoryDump* dump) const override {
+        static const char kDumpName[] = "skia/sk_image_filter_cache";
+        SkAutoMutexExclusive mutex(fMutex);
+        dump->dumpNumericValue(kDumpName, "size", "bytes", fCurrentBytes);
+        dump->dumpNumericValue(kDumpName, "budget_size", "bytes", fMaxBytes);
+        dump->dumpNumericValue(kDumpName, "count", "objects", fLookup.count());
+        if (dump->getRequestedDetails() == SkTraceMemoryDump::kLight_LevelOfDetail) {
+            dump->setMemoryBacking(kDumpName, "malloc", nullptr);
+            return;
+        }
+
+        SkTInternalLList<Value>::Iter iter;
+        for (Value* v = iter.init(fLRU, SkTInternalLList<Value>::Iter::kHead_IterStart); v;
+             v = iter.next()) {
+            const SkSpecialImage* image = v->fImage.image();
+            SkString dumpName = SkStringPrintf("%s/filter_%u/src_%u_%p", kDumpName,
+                                               v->fKey.fUniqueID, v->fKey.fSrcGenID, v);
+            dump->dumpNumericValue(dumpName.c_str(), "size", "bytes",
+                                   image ? image->getSize() : 0);
+            if (image && !image->isTextureBacked()) {
+                // GPU-backed results are attributed by the GrContext dump instead.
+                dump->setMemoryBacking(dumpName.c_str(), "malloc", nullptr);
+            }
+        }
+    }
+
     SkDEBUGCODE(int count() const override { return fLookup.count(); })
 private:
     void removeInternal(Value* v) {
@@ -14,24 +14,31 @@
 
 struct SkIPoint;
 class SkImageFilter;
+class SkTraceMemoryDump;
 
 struct SkImageFilterCacheKey {
     SkImageFilterCacheKey(const uint32_t uniqueID, const SkMatrix& matrix,
-        const SkIRect& clipBounds, uint32_t srcGenID, const SkIRect& srcSubset)
+        const SkIRect& clipBounds, uint32_t srcGenID, const SkIRect& srcSubset,
+        bool contentKeyed = false)
         : fUniqueID(uniqueID)
+        , fContentKeyed(contentKeyed ? 1 : 0)
         , fMatrix(matrix)
         , fClipBounds(clipBounds)
         , fSrcGenID(srcGenID)
         , fSrcSubset(srcSubset) {
         // Assert that Key is tightly-packed, since it is hashed.
-        static_assert(sizeof(SkImageFilterCacheKey) == sizeof(uint32_t) + sizeof(SkMatrix) +
+        static_assert(sizeof(SkImageFilterCacheKey) == 2 * sizeof(uint32_t) + sizeof(SkMatrix) +
                                      sizeof(SkIRect) + sizeof(uint32_t) + 4 * sizeof(int32_t),
                                      "image_filter_key_tight_packing");
         fMatrix.getType();  // force initialization of type, so hashes match
         SkASSERT(fMatrix.isFinite());   // otherwise we can't rely on == self when comparing keys
     }
 
+    // When fContentKeyed is set, fUniqueID holds SkImageFilter_Base::fingerprint() rather than
+    // uniqueID(), so structurally identical DAGs share entries across instances (and frames).
+    // The flag keeps the two ID namespaces from colliding in one table.
     uint32_t fUniqueID;
+    uint32_t fContentKeyed;
     SkMatrix fMatrix;
     SkIRect fClipBounds;
     uint32_t fSrcGenID;
@@ -39,6 +46,7 @@ struct SkImageFilterCacheKey {
 
     bool operator==(const SkImageFilterCacheKey& other) const {
         return fUniqueID == other.fUniqueID &&
+               fContentKeyed == other.fContentKeyed &&
                fMatrix == other.fMatrix &&
                fClipBounds == other.fClipBounds &&
                fSrcGenID == other.fSrcGenID &&
@@ -64,11 +72,15 @@ public:
     virtual bool get(const SkImageFilterCacheKey& key,
                      skif::FilterResult<For::kOutput>* result) const = 0;
     // 'filter' is included in the caching to allow the purging of all of an image filter's cached
-    // results when it is destroyed.
+    // results when it is destroyed. A null 'filter' stores a persistent entry that is not tied to
+    // any instance's lifetime; it is only evicted by the byte budget (or purge()).
     virtual void set(const SkImageFilterCacheKey& key, const SkImageFilter* filter,
                      const skif::FilterResult<For::kOutput>& result) = 0;
     virtual void purge() = 0;
     virtual void purgeByImageFilter(const SkImageFilter*) = 0;
+    // Dumps cache totals, plus one entry per cached result (filter and source image ids) at
+    // higher detail levels, via the SkTraceMemoryDump interface.
+    virtual void dumpMemoryStatistics(SkTraceMemoryDump*) const = 0;
     SkDEBUGCODE(virtual int count() const = 0;)
 };
 
@@ -11,6 +11,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
+#include "include/private/SkOnce.h"
 #include "include/private/SkTArray.h"
 #include "include/private/SkTemplates.h"
 
@@ -41,6 +42,16 @@ public:
      */
     skif::FilterResult<For::kOutput> filterImage(const skif::Context& context) const;
 
+    /**
+     *  Like filterImage(), but for large raster outputs the desired output is partitioned into
+     *  tiles that are evaluated through the DAG in parallel and assembled into one surface.
+     *  Each tile derives its own input bounds through the normal bounds negotiation
+     *  (onGetInputLayerBounds), so filters with spatial reach read the overlap they need from
+     *  the shared source and the assembled result matches filterImage(). Intended for the top
+     *  level of a DAG; recursive input evaluation should keep using filterImage().
+     */
+    skif::FilterResult<For::kOutput> filterImageTiled(const skif::Context& context) const;
+
     /**
      *  Calculate the smallest-possible required layer bounds that would provide sufficient
      *  information to correctly compute the image filter for every pixel in the desired output
@@ -150,6 +161,14 @@ public:
 
     uint32_t uniqueID() const { return fUniqueID; }
 
+    /**
+     *  Returns a content-based fingerprint of this DAG: two filters that serialize identically
+     *  (same factories, parameters, and inputs) share a fingerprint, unlike uniqueID() which is
+     *  per-instance. Computed lazily from the flattened representation and then cached, which is
+     *  safe because filters are immutable once constructed.
+     */
+    uint32_t fingerprint() const;
+
 protected:
     class Common {
     public:
@@ -414,6 +433,9 @@ private:
     CropRect fCropRect;
     uint32_t fUniqueID; // Globally unique
 
+    mutable SkOnce   fFingerprintOnce;
+    mutable uint32_t fFingerprint = 0;
+
     typedef SkImageFilter INHERITED;
 };
 
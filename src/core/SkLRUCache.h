@@ -65,6 +65,18 @@ public:
         return &entry->fValue;
     }
 
+    // Unlike find(), does not move the entry to the head of the LRU list.
+    V* peekLRU() {
+        Entry* tail = fLRU.tail();
+        return tail ? &tail->fValue : nullptr;
+    }
+
+    void removeLRU() {
+        if (Entry* tail = fLRU.tail()) {
+            this->remove(tail->fKey);
+        }
+    }
+
     int count() {
         return fMap.count();
     }
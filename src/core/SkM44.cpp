@@ -122,6 +122,18 @@ SkV4 SkM44::map(float x, float y, float z, float w) const {
     return v;
 }
 
+void SkM44::mapPoints(SkV4 dst[], const SkV4 src[], int count) const {
+    sk4f c0 = sk4f::Load(fMat +  0);
+    sk4f c1 = sk4f::Load(fMat +  4);
+    sk4f c2 = sk4f::Load(fMat +  8);
+    sk4f c3 = sk4f::Load(fMat + 12);
+
+    for (int i = 0; i < count; ++i) {
+        sk4f p = sk4f::Load(&src[i].x);
+        (c0*p[0] + (c1*p[1] + (c2*p[2] + c3*p[3]))).store(&dst[i].x);
+    }
+}
+
 void SkM44::normalizePerspective() {
     // If the bottom row of the matrix is [0, 0, 0, not_one], we will treat the matrix as if it
     // is in perspective, even though it stills behaves like its affine. If we divide everything
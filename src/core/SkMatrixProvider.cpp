@@ -0,0 +1,67 @@
+/*
+* Copyright 2020 Google LLC
+*
+* Use of this source code is governed by a BSD-style license that can be
+* found in the LICENSE file.
+*/
+
+#include "src/core/SkMatrixProvider.h"
+
+namespace {
+
+// Recently composed matrices, kept per-thread so lookups are lock-free. Deep layer hierarchies
+// re-concatenate the same handful of matrices thousands of times per frame; a small ring is
+// enough to catch them. Non-finite inputs never match themselves (NaN != NaN), so they simply
+// bypass the memo.
+struct MemoEntry {
+    SkM44    fParent;
+    SkMatrix fPre;           // the pre-matrix, or the post-translation as a matrix
+    bool     fPostTranslate = false;
+    bool     fValid = false;
+    SkM44    fComposed44;
+    SkMatrix fComposed33;
+};
+
+constexpr int kMemoEntries = 8;
+
+MemoEntry& find_or_compose(const SkM44& parent, const SkMatrix& pre, bool postTranslate) {
+    static thread_local MemoEntry tls_memo[kMemoEntries];
+    static thread_local int tls_next = 0;
+
+    for (MemoEntry& e : tls_memo) {
+        if (e.fValid && e.fPostTranslate == postTranslate &&
+            e.fParent == parent && e.fPre == pre) {
+            return e;
+        }
+    }
+
+    MemoEntry& e = tls_memo[tls_next];
+    tls_next = (tls_next + 1) % kMemoEntries;
+    e.fParent = parent;
+    e.fPre = pre;
+    e.fPostTranslate = postTranslate;
+    e.fComposed44 = postTranslate ? SkM44(pre) * parent : parent * SkM44(pre);
+    e.fComposed33 = e.fComposed44.asM33();
+    // Resolve the type mask now; SkMatrix copies carry it, so every draw that hits this entry
+    // gets a pre-classified matrix instead of re-deriving the mask.
+    (void)e.fComposed33.getType();
+    e.fValid = true;
+    return e;
+}
+
+}  // namespace
+
+SkMatrixProvider::Composed SkMatrixProvider::PreConcat(const SkMatrixProvider& parent,
+                                                       const SkMatrix& preMatrix) {
+    const MemoEntry& e = find_or_compose(parent.localToDevice44(), preMatrix,
+                                         /*postTranslate=*/false);
+    return {e.fComposed44, e.fComposed33};
+}
+
+SkMatrixProvider::Composed SkMatrixProvider::PostTranslate(const SkMatrixProvider& parent,
+                                                           SkScalar dx, SkScalar dy) {
+    const MemoEntry& e = find_or_compose(parent.localToDevice44(),
+                                         SkMatrix::Translate(dx, dy),
+                                         /*postTranslate=*/true);
+    return {e.fComposed44, e.fComposed33};
+}
@@ -30,6 +30,24 @@ public:
 
     virtual bool getLocalToMarker(uint32_t id, SkM44* localToMarker) const = 0;
 
+protected:
+    // A composed local-to-device matrix in both forms, with the 3x3's type mask already resolved.
+    struct Composed {
+        SkM44    f44;
+        SkMatrix f33;
+    };
+
+    SkMatrixProvider(const Composed& composed)
+        : fLocalToDevice(composed.f44)
+        , fLocalToDevice33(composed.f33) {}
+
+    // Compose the parent's local-to-device with a pre-concatenated matrix or a post-translation.
+    // Deep layer stacks rebuild identical ephemeral provider chains every draw, so these are
+    // memoized per-thread; providers carry no generation id, so entries are validated by
+    // comparing the input matrices themselves.
+    static Composed PreConcat(const SkMatrixProvider& parent, const SkMatrix& preMatrix);
+    static Composed PostTranslate(const SkMatrixProvider& parent, SkScalar dx, SkScalar dy);
+
 private:
     friend class SkBaseDevice;
 
@@ -54,7 +72,7 @@ private:
 class SkPostTranslateMatrixProvider : public SkMatrixProvider {
 public:
     SkPostTranslateMatrixProvider(const SkMatrixProvider& parent, SkScalar dx, SkScalar dy)
-            : SkMatrixProvider(SkM44::Translate(dx, dy) * parent.localToDevice44())
+            : SkMatrixProvider(PostTranslate(parent, dx, dy))
             , fParent(parent) {}
 
     // Assume that the post-translation doesn't apply to any marked matrices
@@ -69,7 +87,7 @@ private:
 class SkPreConcatMatrixProvider : public SkMatrixProvider {
 public:
     SkPreConcatMatrixProvider(const SkMatrixProvider& parent, const SkMatrix& preMatrix)
-            : SkMatrixProvider(parent.localToDevice44() * SkM44(preMatrix))
+            : SkMatrixProvider(PreConcat(parent, preMatrix))
             , fParent(parent)
             , fPreMatrix(preMatrix) {}
 
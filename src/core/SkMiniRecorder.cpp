@@ -43,6 +43,27 @@ static SkRect bounds(const DrawPath& op) {
 static SkRect bounds(const DrawTextBlob& op) {
     return adjust_for_paint(op.blob->bounds().makeOffset(op.x, op.y), op.paint);
 }
+static SkRect bounds(const SkMiniDrawImageRect& op) {
+    return op.paint.isValid() ? adjust_for_paint(op.dst, *op.paint.get()) : op.dst;
+}
+static SkRect bounds(const SkMiniDrawPicture& op) {
+    SkRect rect = op.matrix.mapRect(op.picture->cullRect());
+    return op.paint.isValid() ? adjust_for_paint(rect, *op.paint.get()) : rect;
+}
+
+// Play back a single op.  SkRecords types go through the common Draw visitor;
+// the self-contained mini ops map straight back onto their canvas calls.
+template <typename T>
+static void draw_op(SkCanvas* c, const T& op) {
+    SkRecords::Draw(c, nullptr, nullptr, 0, nullptr)(op);
+}
+static void draw_op(SkCanvas* c, const SkMiniDrawImageRect& op) {
+    c->legacy_drawImageRect(op.image.get(), op.src.getMaybeNull(), op.dst,
+                            op.paint.getMaybeNull(), op.constraint);
+}
+static void draw_op(SkCanvas* c, const SkMiniDrawPicture& op) {
+    c->drawPicture(op.picture.get(), &op.matrix, op.paint.getMaybeNull());
+}
 
 template <typename T>
 class SkMiniPicture final : public SkPicture {
@@ -52,7 +73,7 @@ public:
         , fOp(std::move(op)) {}
 
     void playback(SkCanvas* c, AbortCallback*) const override {
-        SkRecords::Draw(c, nullptr, nullptr, 0, nullptr)(fOp);
+        draw_op(c, fOp);
     }
 
     size_t approximateBytesUsed() const override { return sizeof(*this); }
@@ -94,10 +115,34 @@ bool SkMiniRecorder::drawTextBlob(const SkTextBlob* b, SkScalar x, SkScalar y, c
 }
 #undef TRY_TO_STORE
 
+bool SkMiniRecorder::drawImageRect(const SkImage* image, const SkRect* src, const SkRect& dst,
+                                   const SkPaint* paint, SkCanvas::SrcRectConstraint constraint) {
+    if (fState != State::kEmpty) { return false; }
+    fState = State::kDrawImageRect;
+    auto* op = new (fBuffer.get()) SkMiniDrawImageRect;
+    if (paint) { op->paint.set(*paint); }
+    if (src)   { op->src.set(*src); }
+    op->image      = sk_ref_sp(image);
+    op->dst        = dst;
+    op->constraint = constraint;
+    return true;
+}
+
+bool SkMiniRecorder::drawPicture(const SkPicture* pic, const SkMatrix* matrix,
+                                 const SkPaint* paint) {
+    if (fState != State::kEmpty) { return false; }
+    fState = State::kDrawPicture;
+    auto* op = new (fBuffer.get()) SkMiniDrawPicture;
+    if (paint) { op->paint.set(*paint); }
+    op->picture = sk_ref_sp(pic);
+    op->matrix  = matrix ? *matrix : SkMatrix::I();
+    return true;
+}
+
 
 sk_sp<SkPicture> SkMiniRecorder::detachAsPicture(const SkRect* cull) {
-#define CASE(T)                                                        \
-    case State::k##T: {                                                \
+#define CASE(Name, T)                                                  \
+    case State::k##Name: {                                             \
         T* op = reinterpret_cast<T*>(fBuffer.get());                   \
         auto pic = sk_make_sp<SkMiniPicture<T>>(cull, std::move(*op)); \
         op->~T();                                                      \
@@ -112,9 +157,11 @@ sk_sp<SkPicture> SkMiniRecorder::detachAsPicture(const SkRect* cull) {
         case State::kEmpty:
             once([]{ empty = new SkEmptyPicture; });
             return sk_ref_sp(empty);
-        CASE(DrawPath)
-        CASE(DrawRect)
-        CASE(DrawTextBlob)
+        CASE(DrawPath,      DrawPath)
+        CASE(DrawRect,      DrawRect)
+        CASE(DrawTextBlob,  DrawTextBlob)
+        CASE(DrawImageRect, SkMiniDrawImageRect)
+        CASE(DrawPicture,   SkMiniDrawPicture)
     }
     SkASSERT(false);
     return nullptr;
@@ -122,19 +169,21 @@ sk_sp<SkPicture> SkMiniRecorder::detachAsPicture(const SkRect* cull) {
 }
 
 void SkMiniRecorder::flushAndReset(SkCanvas* canvas) {
-#define CASE(Type)                                                  \
-    case State::k##Type: {                                          \
-        fState = State::kEmpty;                                     \
-        Type* op = reinterpret_cast<Type*>(fBuffer.get());          \
-        SkRecords::Draw(canvas, nullptr, nullptr, 0, nullptr)(*op); \
-        op->~Type();                                                \
+#define CASE(Name, T)                                      \
+    case State::k##Name: {                                 \
+        fState = State::kEmpty;                            \
+        T* op = reinterpret_cast<T*>(fBuffer.get());       \
+        draw_op(canvas, *op);                              \
+        op->~T();                                          \
     } return
 
     switch (fState) {
         case State::kEmpty: return;
-        CASE(DrawPath);
-        CASE(DrawRect);
-        CASE(DrawTextBlob);
+        CASE(DrawPath,      DrawPath);
+        CASE(DrawRect,      DrawRect);
+        CASE(DrawTextBlob,  DrawTextBlob);
+        CASE(DrawImageRect, SkMiniDrawImageRect);
+        CASE(DrawPicture,   SkMiniDrawPicture);
     }
     SkASSERT(false);
 #undef CASE
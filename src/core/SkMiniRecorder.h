@@ -12,8 +12,25 @@
 #include "include/core/SkTypes.h"
 #include "include/private/SkNoncopyable.h"
 #include "src/core/SkRecords.h"
+#include "src/core/SkTLazy.h"
 class SkCanvas;
 
+// SkRecords::DrawImageRect and DrawPicture hold their optional fields as
+// pointers into an SkRecord's arena.  The mini recorder has no arena, so it
+// records these self-contained equivalents instead.
+struct SkMiniDrawImageRect {
+    SkTLazy<SkPaint>            paint;
+    SkTLazy<SkRect>             src;
+    sk_sp<const SkImage>        image;
+    SkRect                      dst;
+    SkCanvas::SrcRectConstraint constraint;
+};
+struct SkMiniDrawPicture {
+    SkTLazy<SkPaint>       paint;
+    sk_sp<const SkPicture> picture;
+    SkMatrix               matrix;
+};
+
 // Records small pictures, but only a limited subset of the canvas API, and may fail.
 class SkMiniRecorder : SkNoncopyable {
 public:
@@ -24,6 +41,9 @@ public:
     bool drawPath(const SkPath&, const SkPaint&);
     bool drawRect(const SkRect&, const SkPaint&);
     bool drawTextBlob(const SkTextBlob*, SkScalar x, SkScalar y, const SkPaint&);
+    bool drawImageRect(const SkImage*, const SkRect* src, const SkRect& dst,
+                       const SkPaint*, SkCanvas::SrcRectConstraint);
+    bool drawPicture(const SkPicture*, const SkMatrix*, const SkPaint*);
 
     // Detach anything we've recorded as a picture, resetting this SkMiniRecorder.
     // If cull is nullptr we'll calculate it.
@@ -41,6 +61,8 @@ private:
         kDrawPath,
         kDrawRect,
         kDrawTextBlob,
+        kDrawImageRect,
+        kDrawPicture,
     };
 
     State fState;
@@ -51,7 +73,9 @@ private:
     static const size_t kInlineStorage =
         Max<sizeof(SkRecords::DrawPath),
         Max<sizeof(SkRecords::DrawRect),
-            sizeof(SkRecords::DrawTextBlob)>::val>::val;
+        Max<sizeof(SkRecords::DrawTextBlob),
+        Max<sizeof(SkMiniDrawImageRect),
+            sizeof(SkMiniDrawPicture)>::val>::val>::val>::val;
     SkAlignedSStorage<kInlineStorage> fBuffer;
 };
 
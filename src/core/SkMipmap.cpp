@@ -15,6 +15,7 @@
 #include "include/private/SkVx.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkMipmap.h"
+#include "src/core/SkTaskGroup.h"
 #include <new>
 
 //
@@ -381,6 +382,102 @@ template <typename F> void downsample_3_3(void* dst, const void* src, size_t src
     }
 }
 
+// Wide specialization of downsample_2_2 for 8888: 8 dst pixels per iteration. The 2x2 box
+// on even dimensions is by far the most common proc, and the generic template only moves
+// one pixel at a time through Sk4h. Results are bit-identical to the template (truncating
+// (a+b+c+d) >> 2 in 16 bits).
+static void downsample_2_2_8888(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint32_t*>(src);
+    auto p1 = (const uint32_t*)((const char*)p0 + srcRB);
+    auto d = static_cast<uint32_t*>(dst);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // 16 src pixels from each row, widened to 16 bits.
+        auto r0 = skvx::cast<uint16_t>(skvx::Vec<64, uint8_t>::Load(p0));
+        auto r1 = skvx::cast<uint16_t>(skvx::Vec<64, uint8_t>::Load(p1));
+        auto sum = r0 + r1;
+
+        // Add the left and right pixel of each 2x2 quad (channels are 4 lanes apart).
+        auto left  = skvx::shuffle< 0, 1, 2, 3,  8, 9,10,11, 16,17,18,19, 24,25,26,27,
+                                   32,33,34,35, 40,41,42,43, 48,49,50,51, 56,57,58,59>(sum);
+        auto right = skvx::shuffle< 4, 5, 6, 7, 12,13,14,15, 20,21,22,23, 28,29,30,31,
+                                   36,37,38,39, 44,45,46,47, 52,53,54,55, 60,61,62,63>(sum);
+
+        skvx::cast<uint8_t>((left + right) >> 2).store(d + i);
+        p0 += 16;
+        p1 += 16;
+    }
+    for (; i < count; ++i) {
+        auto c00 = ColorTypeFilter_8888::Expand(p0[0]);
+        auto c01 = ColorTypeFilter_8888::Expand(p0[1]);
+        auto c10 = ColorTypeFilter_8888::Expand(p1[0]);
+        auto c11 = ColorTypeFilter_8888::Expand(p1[1]);
+
+        auto c = c00 + c10 + c01 + c11;
+        d[i] = ColorTypeFilter_8888::Compact(shift_right(c, 2));
+        p0 += 2;
+        p1 += 2;
+    }
+}
+
+// Build-time opt-in: box-filter sRGB-encoded 8888 levels in linear space. Averaging the
+// encoded values over-darkens high-contrast areas; filtering linearly fixes that, but
+// changes pixel output, so it defaults off.
+//#define SK_MIPMAP_SRGB_GAMMA_CORRECT
+
+#ifdef SK_MIPMAP_SRGB_GAMMA_CORRECT
+
+#include "include/core/SkColorSpace.h"
+#include "include/private/SkOnce.h"
+#include <cmath>
+
+static uint16_t gSrgbToLinear12[256];   // sRGB byte -> 12-bit linear
+static uint8_t  gLinear12ToSrgb[4096];  // 12-bit linear -> sRGB byte
+
+static void init_srgb_tables() {
+    for (int i = 0; i < 256; ++i) {
+        const float x = i * (1 / 255.0f);
+        const float l = x <= 0.04045f ? x * (1 / 12.92f)
+                                      : std::pow((x + 0.055f) * (1 / 1.055f), 2.4f);
+        gSrgbToLinear12[i] = (uint16_t)(l * 4095.0f + 0.5f);
+    }
+    for (int i = 0; i < 4096; ++i) {
+        const float l = i * (1 / 4095.0f);
+        const float s = l <= 0.0031308f ? l * 12.92f
+                                        : 1.055f * std::pow(l, 1 / 2.4f) - 0.055f;
+        gLinear12ToSrgb[i] = (uint8_t)(s * 255.0f + 0.5f);
+    }
+}
+
+// 2x2 box for sRGB-encoded 8888: color channels round-trip through 12-bit linear tables,
+// alpha averages directly. Note: this filters the channels as stored -- for premul pixels
+// that is the usual approximation, not a full unpremul/linearize/premul round trip.
+static void downsample_2_2_srgb_8888(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    static SkOnce once;
+    once(init_srgb_tables);
+
+    auto p0 = static_cast<const uint8_t*>(src);
+    auto p1 = p0 + srcRB;
+    auto d = static_cast<uint8_t*>(dst);
+
+    for (int i = 0; i < count; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            const uint32_t linear = gSrgbToLinear12[p0[c]] + gSrgbToLinear12[p0[4 + c]]
+                                  + gSrgbToLinear12[p1[c]] + gSrgbToLinear12[p1[4 + c]];
+            d[c] = gLinear12ToSrgb[linear >> 2];
+        }
+        d[3] = (p0[3] + p0[7] + p1[3] + p1[7]) >> 2;
+        d += 4;
+        p0 += 8;
+        p1 += 8;
+    }
+}
+
+#endif // SK_MIPMAP_SRGB_GAMMA_CORRECT
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
@@ -395,7 +492,7 @@ size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
 }
 
 SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
-                          bool computeContents) {
+                          bool computeContents, SkTaskGroup* taskGroup) {
     typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
 
     FilterProc* proc_1_2 = nullptr;
@@ -416,11 +513,16 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
+            proc_2_2 = downsample_2_2_8888;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
             proc_3_3 = downsample_3_3<ColorTypeFilter_8888>;
+#ifdef SK_MIPMAP_SRGB_GAMMA_CORRECT
+            if (src.colorSpace() && src.colorSpace()->gammaCloseToSRGB()) {
+                proc_2_2 = downsample_2_2_srgb_8888;
+            }
+#endif
             break;
         case kRGB_565_SkColorType:
             proc_1_2 = downsample_1_2<ColorTypeFilter_565>;
@@ -583,13 +685,13 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
     int         width = src.width();
     int         height = src.height();
     uint32_t    rowBytes;
-    SkPixmap    srcPM(src);
 
     // Depending on architecture and other factors, the pixel data alignment may need to be as
     // large as 8 (for F16 pixels). See the comment on SkMipmap::Level.
     SkASSERT(SkIsAlign8((uintptr_t)addr));
 
-    for (int i = 0; i < countLevels; ++i) {
+    // Picks the downsample proc based on the parity of the *source* dimensions.
+    auto choose_proc = [=](int width, int height) {
         FilterProc* proc;
         if (height & 1) {
             if (height == 1) {        // src-height is 1
@@ -620,6 +722,12 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
                 proc = proc_2_2;
             }
         }
+        return proc;
+    };
+
+    // First pass: lay out the pixmaps for every level, so the chain's geometry is known
+    // up front even when the contents are computed later.
+    for (int i = 0; i < countLevels; ++i) {
         width = std::max(1, width >> 1);
         height = std::max(1, height >> 1);
         rowBytes = SkToU32(SkColorTypeMinRowBytes(ct, width));
@@ -631,23 +739,56 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
         levels[i].fScale  = SkSize::Make(SkIntToScalar(width)  / src.width(),
                                          SkIntToScalar(height) / src.height());
 
-        const SkPixmap& dstPM = levels[i].fPixmap;
-        if (computeContents) {
-            const void* srcBasePtr = srcPM.addr();
-            void* dstBasePtr = dstPM.writable_addr();
-
-            const size_t srcRB = srcPM.rowBytes();
-            for (int y = 0; y < height; y++) {
-                proc(dstBasePtr, srcBasePtr, srcRB, width);
-                srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-                dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
-            }
-        }
-        srcPM = dstPM;
         addr += height * rowBytes;
     }
     SkASSERT(addr == baseAddr + size);
 
+    if (!computeContents) {
+        // The caller fills in the levels (e.g. SkMipmapBuilder), so report them all ready.
+        mipmap->fReadyCount.store(countLevels, std::memory_order_relaxed);
+        return mipmap;
+    }
+
+    // Fills level |i| from the level above it (or from |src| for level 0).
+    auto fill_level = [levels, srcPM = SkPixmap(src), choose_proc](int i) {
+        const SkPixmap& srcLevel = (0 == i) ? srcPM : levels[i - 1].fPixmap;
+        const SkPixmap& dstPM = levels[i].fPixmap;
+        FilterProc* proc = choose_proc(srcLevel.width(), srcLevel.height());
+
+        const void* srcBasePtr = srcLevel.addr();
+        void* dstBasePtr = dstPM.writable_addr();
+
+        const size_t srcRB = srcLevel.rowBytes();
+        for (int y = 0; y < dstPM.height(); y++) {
+            proc(dstBasePtr, srcBasePtr, srcRB, dstPM.width());
+            srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
+            dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
+        }
+    };
+
+    // Level 1 is always computed synchronously: it reads the caller's pixels (whose
+    // lifetime we cannot extend), and it guarantees a usable level on return.
+    fill_level(0);
+
+    if (nullptr == taskGroup || countLevels <= 1) {
+        for (int i = 1; i < countLevels; ++i) {
+            fill_level(i);
+        }
+        mipmap->fReadyCount.store(countLevels, std::memory_order_relaxed);
+    } else {
+        mipmap->fReadyCount.store(1, std::memory_order_release);
+        // The ref keeps the (possibly discardable) storage locked while the task writes;
+        // deeper levels read only from our own storage, never from |src|.
+        mipmap->ref();
+        taskGroup->add([mipmap, countLevels, fill_level] {
+            for (int i = 1; i < countLevels; ++i) {
+                fill_level(i);
+                mipmap->fReadyCount.store(i + 1, std::memory_order_release);
+            }
+            mipmap->unref();
+        });
+    }
+
     SkASSERT(mipmap->fLevels);
     return mipmap;
 }
@@ -752,6 +893,14 @@ bool SkMipmap::extractLevel(SkSize scaleSize, Level* levelPtr) const {
     if (level > fCount) {
         level = fCount;
     }
+    // While a deferred build is still running, serve the deepest completed level.
+    const int ready = this->countReadyLevels();
+    if (ready < 1) {
+        return false;
+    }
+    if (level > ready) {
+        level = ready;
+    }
     if (levelPtr) {
         *levelPtr = fLevels[level - 1];
         // need to augment with our colorspace
@@ -787,18 +936,23 @@ bool SkMipmap::validForRootLevel(const SkImageInfo& root) const {
 
 // Helper which extracts a pixmap from the src bitmap
 //
-SkMipmap* SkMipmap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
+SkMipmap* SkMipmap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact,
+                          SkTaskGroup* taskGroup) {
     SkPixmap srcPixmap;
     if (!src.peekPixels(&srcPixmap)) {
         return nullptr;
     }
-    return Build(srcPixmap, fact);
+    return Build(srcPixmap, fact, true, taskGroup);
 }
 
 int SkMipmap::countLevels() const {
     return fCount;
 }
 
+int SkMipmap::countReadyLevels() const {
+    return fReadyCount.load(std::memory_order_acquire);
+}
+
 bool SkMipmap::getLevel(int index, Level* levelPtr) const {
     if (nullptr == fLevels) {
         return false;
@@ -806,7 +960,7 @@ bool SkMipmap::getLevel(int index, Level* levelPtr) const {
     if (index < 0) {
         return false;
     }
-    if (index > fCount - 1) {
+    if (index > this->countReadyLevels() - 1) {
         return false;
     }
     if (levelPtr) {
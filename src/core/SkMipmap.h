@@ -15,10 +15,13 @@
 #include "src/core/SkCachedData.h"
 #include "src/shaders/SkShaderBase.h"
 
+#include <atomic>
+
 class SkBitmap;
 class SkData;
 class SkDiscardableMemory;
 class SkMipmapBuilder;
+class SkTaskGroup;
 
 typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
 
@@ -33,10 +36,15 @@ class SkMipmap : public SkCachedData {
 public:
     // Allocate and fill-in a mipmap. If computeContents is false, we just allocated
     // and compute the sizes/rowbytes, but leave the pixel-data uninitialized.
+    //
+    // If a taskGroup is provided, only level 1 is computed before returning; deeper
+    // levels are computed on the taskGroup, becoming visible to readers as each one
+    // completes (see countReadyLevels).
     static SkMipmap* Build(const SkPixmap& src, SkDiscardableFactoryProc,
-                           bool computeContents = true);
+                           bool computeContents = true, SkTaskGroup* taskGroup = nullptr);
 
-    static SkMipmap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
+    static SkMipmap* Build(const SkBitmap& src, SkDiscardableFactoryProc,
+                           SkTaskGroup* taskGroup = nullptr);
 
     // Determines how many levels a SkMipmap will have without creating that mipmap.
     // This does not include the base mipmap level that the user provided when
@@ -67,6 +75,11 @@ public:
     // include the base mipmap level).
     int countLevels() const;
 
+    // The number of levels whose contents are complete (<= countLevels()). Only less
+    // than countLevels() while a deferred build (see Build's taskGroup) is still
+    // running; extractLevel() serves the deepest ready level in the meantime.
+    int countReadyLevels() const;
+
     // |index| is an index into the generated mipmap levels. It does not include
     // the base level. So index 0 represents mipmap level 1.
     bool getLevel(int index, Level*) const;
@@ -85,6 +98,7 @@ private:
     sk_sp<SkColorSpace> fCS;
     Level*              fLevels;    // managed by the baseclass, may be null due to onDataChanged.
     int                 fCount;
+    std::atomic<int>    fReadyCount{0};
 
     SkMipmap(void* malloc, size_t size) : INHERITED(malloc, size) {}
     SkMipmap(size_t size, SkDiscardableMemory* dm) : INHERITED(size, dm) {}
@@ -60,6 +60,7 @@ namespace SkOpts {
     DEFINE_DEFAULT(blit_mask_d32_a8);
 
     DEFINE_DEFAULT(blit_row_color32);
+    DEFINE_DEFAULT(blit_row_color565);
     DEFINE_DEFAULT(blit_row_s32a_opaque);
 
     DEFINE_DEFAULT(RGBA_to_BGRA);
@@ -70,6 +71,7 @@ namespace SkOpts {
     DEFINE_DEFAULT(gray_to_RGB1);
     DEFINE_DEFAULT(grayA_to_RGBA);
     DEFINE_DEFAULT(grayA_to_rgbA);
+    DEFINE_DEFAULT(small_index_to_8888);
     DEFINE_DEFAULT(inverted_CMYK_to_RGB1);
     DEFINE_DEFAULT(inverted_CMYK_to_BGR1);
 
@@ -112,6 +114,7 @@ namespace SkOpts {
     void Init_hsw();
     void Init_skx();
     void Init_crc32();
+    void Init_sve();
 
     static void init() {
 #if !defined(SK_BUILD_NO_OPTS)
@@ -135,6 +138,7 @@ namespace SkOpts {
 
     #elif defined(SK_CPU_ARM64)
         if (SkCpu::Supports(SkCpu::CRC32)) { Init_crc32(); }
+        if (SkCpu::Supports(SkCpu::SVE))   { Init_sve(); }
 
     #endif
 #endif
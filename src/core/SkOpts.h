@@ -29,6 +29,7 @@ namespace SkOpts {
 
     extern void (*blit_mask_d32_a8)(SkPMColor*, size_t, const SkAlpha*, size_t, SkColor, int, int);
     extern void (*blit_row_color32)(SkPMColor*, const SkPMColor*, int, SkPMColor);
+    extern void (*blit_row_color565)(uint16_t*, int, SkPMColor);
     extern void (*blit_row_s32a_opaque)(SkPMColor*, const SkPMColor*, int, U8CPU);
 
     // Swizzle input into some sort of 8888 pixel, {premul,unpremul} x {rgba,bgra}.
@@ -46,6 +47,11 @@ namespace SkOpts {
                            grayA_to_RGBA,   // i.e. expand to color channels
                            grayA_to_rgbA;   // i.e. expand to color channels and premultiply
 
+    // Expand 1, 2, or 4 bit indices, packed big endian within each byte, through a
+    // color table of (1 << bpp) pre-swizzled entries.
+    typedef void (*Swizzle_small_index)(uint32_t*, const uint8_t*, int, int, const uint32_t*);
+    extern Swizzle_small_index small_index_to_8888;
+
     extern void (*memset16)(uint16_t[], uint16_t, int);
     extern void SK_SPI(*memset32)(uint32_t[], uint32_t, int);
     extern void (*memset64)(uint64_t[], uint64_t, int);
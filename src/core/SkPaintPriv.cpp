@@ -8,6 +8,7 @@
 #include "include/core/SkPaint.h"
 #include "src/core/SkColorFilterBase.h"
 #include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkPaintPriv.h"
 #include "src/core/SkXfermodePriv.h"
 #include "src/shaders/SkColorFilterShader.h"
@@ -102,3 +103,35 @@ void SkPaintPriv::RemoveColorFilter(SkPaint* p, SkColorSpace* dstCS) {
         p->setColorFilter(nullptr);
     }
 }
+
+uint32_t SkPaintPriv::Hash(const SkPaint& paint) {
+    // Mirror the fields operator==() compares: effect identity, color, stroke geometry,
+    // and the packed flag bits.
+    uintptr_t effects[] = {
+        (uintptr_t)paint.getPathEffect(),
+        (uintptr_t)paint.getShader(),
+        (uintptr_t)paint.getMaskFilter(),
+        (uintptr_t)paint.getColorFilter(),
+        (uintptr_t)paint.getImageFilter(),
+    };
+    struct {
+        SkColor4f fColor;
+        SkScalar  fWidth;
+        SkScalar  fMiterLimit;
+        uint32_t  fBits;
+    } fields = {
+        paint.getColor4f(),
+        paint.getStrokeWidth(),
+        paint.getStrokeMiter(),
+        (uint32_t)paint.isAntiAlias()      <<  0 |
+        (uint32_t)paint.isDither()         <<  1 |
+        (uint32_t)paint.getStrokeCap()     <<  2 |
+        (uint32_t)paint.getStrokeJoin()    <<  4 |
+        (uint32_t)paint.getStyle()         <<  6 |
+        (uint32_t)paint.getFilterQuality() <<  8 |
+        (uint32_t)paint.getBlendMode()     << 10,
+    };
+    static_assert(sizeof(fields) == 7 * sizeof(uint32_t), "no padding allowed");
+    uint32_t hash = SkOpts::hash(effects, sizeof(effects));
+    return SkOpts::hash(&fields, sizeof(fields), hash);
+}
@@ -45,6 +45,13 @@ public:
      */
     static SkColor ComputeLuminanceColor(const SkPaint&);
 
+    /**
+     *  Returns a content hash consistent with operator==(): paints that compare equal hash
+     *  equally. Effect objects are keyed by identity, matching the pointer comparisons in
+     *  operator==(). Useful for interning paints at record time.
+     */
+    static uint32_t Hash(const SkPaint&);
+
     /** Serializes SkPaint into a buffer. A companion unflatten() call
     can reconstitute the paint at a later time.
 
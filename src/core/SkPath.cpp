@@ -1358,6 +1358,20 @@ SkPath& SkPath::addPath(const SkPath& path, SkScalar dx, SkScalar dy, AddPathMod
     return this->addPath(path, matrix, mode);
 }
 
+SkPath& SkPath::addPath(SkPath&& src, AddPathMode mode) {
+    if (0 == fPathRef->countVerbs() && !src.isEmpty()) {
+        // Appending to an empty path replaces its geometry outright; adopt the source's
+        // SkPathRef (stealing it when uniquely owned) instead of copying points and verbs.
+        SkPathFillType fillType = this->getFillType();
+        bool isVolatile = this->isVolatile();
+        this->swap(src);
+        this->setFillType(fillType);
+        this->setIsVolatile(isVolatile);
+        return *this;
+    }
+    return this->addPath(src, mode);
+}
+
 SkPath& SkPath::addPath(const SkPath& srcPath, const SkMatrix& matrix, AddPathMode mode) {
     if (srcPath.isEmpty()) {
         return *this;
@@ -3062,6 +3076,148 @@ bool SkPath::contains(SkScalar x, SkScalar y) const {
     return SkToBool(tangents.count()) ^ isInverse;
 }
 
+SkPathContainsQuery::SkPathContainsQuery(const SkPath& path)
+        : fPath(path)
+        , fBounds(path.getBounds())
+        , fIsInverse(path.isInverseFillType())
+        , fEvenOdd(SkPathFillType::kEvenOdd        == path.getFillType() ||
+                   SkPathFillType::kInverseEvenOdd == path.getFillType())
+        , fIsEmpty(path.isEmpty()) {
+    // Collect the edges the same way contains() walks them, including the lines that close
+    // each contour.
+    SkPath::Iter iter(path, true);
+    bool done = false;
+    do {
+        SkPoint pts[4];
+        int ptCount = 0;
+        SkPath::Verb verb = iter.next(pts);
+        switch (verb) {
+            case SkPath::kMove_Verb:
+            case SkPath::kClose_Verb:
+                break;
+            case SkPath::kLine_Verb:
+                ptCount = 2;
+                break;
+            case SkPath::kQuad_Verb:
+            case SkPath::kConic_Verb:
+                ptCount = 3;
+                break;
+            case SkPath::kCubic_Verb:
+                ptCount = 4;
+                break;
+            case SkPath::kDone_Verb:
+                done = true;
+                break;
+        }
+        if (ptCount) {
+            Edge* edge = fEdges.append();
+            memcpy(edge->fPts, pts, ptCount * sizeof(SkPoint));
+            edge->fWeight = (SkPath::kConic_Verb == verb) ? iter.conicWeight() : 1;
+            edge->fTop = edge->fBottom = pts[0].fY;
+            for (int i = 1; i < ptCount; ++i) {
+                edge->fTop = std::min(edge->fTop, pts[i].fY);
+                edge->fBottom = std::max(edge->fBottom, pts[i].fY);
+            }
+            edge->fVerb = SkToU8(verb);
+        }
+    } while (!done);
+
+    fBucketCount = SkTPin(fEdges.count(), 1, 512);
+    SkScalar slabHeight = fBounds.height() / fBucketCount;
+    fInvSlabHeight = (slabHeight > 0 && SkScalarIsFinite(slabHeight)) ? 1 / slabHeight : 0;
+    if (0 == fInvSlabHeight) {
+        fBucketCount = 1;
+    }
+
+    // Two passes: count the edges overlapping each bucket, turn the counts into offsets, then
+    // fill in the per-bucket edge lists.
+    fBucketStarts.setCount(fBucketCount + 1);
+    memset(fBucketStarts.begin(), 0, fBucketStarts.count() * sizeof(int32_t));
+    for (int i = 0; i < fEdges.count(); ++i) {
+        int b0 = this->bucketForY(fEdges[i].fTop);
+        int b1 = this->bucketForY(fEdges[i].fBottom);
+        for (int b = b0; b <= b1; ++b) {
+            ++fBucketStarts[b + 1];
+        }
+    }
+    for (int b = 0; b < fBucketCount; ++b) {
+        fBucketStarts[b + 1] += fBucketStarts[b];
+    }
+    fBucketEdges.setCount(fBucketStarts[fBucketCount]);
+    SkTDArray<int32_t> cursors;
+    cursors.setCount(fBucketCount);
+    memcpy(cursors.begin(), fBucketStarts.begin(), fBucketCount * sizeof(int32_t));
+    for (int i = 0; i < fEdges.count(); ++i) {
+        int b0 = this->bucketForY(fEdges[i].fTop);
+        int b1 = this->bucketForY(fEdges[i].fBottom);
+        for (int b = b0; b <= b1; ++b) {
+            fBucketEdges[cursors[b]++] = i;
+        }
+    }
+}
+
+int SkPathContainsQuery::bucketForY(SkScalar y) const {
+    if (0 == fInvSlabHeight) {
+        return 0;
+    }
+    int bucket = (int)((y - fBounds.fTop) * fInvSlabHeight);
+    return SkTPin(bucket, 0, fBucketCount - 1);
+}
+
+bool SkPathContainsQuery::contains(SkScalar x, SkScalar y) const {
+    if (fIsEmpty) {
+        return fIsInverse;
+    }
+    if (!contains_inclusive(fBounds, x, y)) {
+        return fIsInverse;
+    }
+
+    int bucket = this->bucketForY(y);
+    int w = 0;
+    int onCurveCount = 0;
+    for (int i = fBucketStarts[bucket]; i < fBucketStarts[bucket + 1]; ++i) {
+        const Edge& edge = fEdges[fBucketEdges[i]];
+        if (y < edge.fTop || y > edge.fBottom) {
+            continue;
+        }
+        switch (edge.fVerb) {
+            case SkPath::kLine_Verb:
+                w += winding_line(edge.fPts, x, y, &onCurveCount);
+                break;
+            case SkPath::kQuad_Verb:
+                w += winding_quad(edge.fPts, x, y, &onCurveCount);
+                break;
+            case SkPath::kConic_Verb:
+                w += winding_conic(edge.fPts, x, y, edge.fWeight, &onCurveCount);
+                break;
+            case SkPath::kCubic_Verb:
+                w += winding_cubic(edge.fPts, x, y, &onCurveCount);
+                break;
+        }
+    }
+    if (fEvenOdd) {
+        w &= 1;
+    }
+    if (w) {
+        return !fIsInverse;
+    }
+    if (onCurveCount <= 1) {
+        return SkToBool(onCurveCount) ^ fIsInverse;
+    }
+    if ((onCurveCount & 1) || fEvenOdd) {
+        return SkToBool(onCurveCount & 1) ^ fIsInverse;
+    }
+    // The point touches an even number of curves with a winding fill; the tangent-coincidence
+    // walk is rare enough that we defer to the full check.
+    return fPath.contains(x, y);
+}
+
+void SkPathContainsQuery::containsBatch(const SkPoint pts[], int count, bool results[]) const {
+    for (int i = 0; i < count; ++i) {
+        results[i] = this->contains(pts[i].fX, pts[i].fY);
+    }
+}
+
 int SkPath::ConvertConicToQuads(const SkPoint& p0, const SkPoint& p1, const SkPoint& p2,
                                 SkScalar w, SkPoint pts[], int pow2) {
     const SkConic conic(p0, p1, p2, w);
@@ -3399,6 +3555,27 @@ SkPath SkPath::Make(const SkPoint pts[], int pointCount,
                   ft, isVolatile);
 }
 
+SkPath& SkPath::setFromData(SkTDArray<SkPoint> points, SkTDArray<uint8_t> verbs,
+                            SkTDArray<SkScalar> conicWeights) {
+    if (verbs.isEmpty()) {
+        return this->reset();
+    }
+
+    const auto info = validate_verbs(verbs.begin(), verbs.count());
+    if (!info.valid || info.points != points.count() || info.weights != conicWeights.count()) {
+        SkDEBUGFAIL("invalid verbs and number of points/weights");
+        return this->reset();
+    }
+
+    SkPath path(sk_sp<SkPathRef>(new SkPathRef(std::move(points),
+                                               std::move(verbs),
+                                               std::move(conicWeights),
+                                               info.segmentMask)),
+                this->getFillType(), this->isVolatile());
+    this->swap(path);
+    return *this;
+}
+
 SkPath SkPath::Rect(const SkRect& r, SkPathDirection dir) {
     return SkPathBuilder().addRect(r, dir).detach();
 }
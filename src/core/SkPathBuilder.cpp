@@ -41,6 +41,11 @@ void SkPathBuilder::incReserve(int extraPtCount, int extraVbCount) {
     fVerbs.setReserve(Sk32_sat_add(fVerbs.count(), extraVbCount));
 }
 
+void SkPathBuilder::incReserveExact(int extraPtCount, int extraVbCount) {
+    fPts.setReserveExact(  Sk32_sat_add(fPts.count(),   extraPtCount));
+    fVerbs.setReserveExact(Sk32_sat_add(fVerbs.count(), extraVbCount));
+}
+
 /*
  *  Some old behavior in SkPath -- should we keep it?
  *
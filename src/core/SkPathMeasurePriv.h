@@ -8,6 +8,7 @@
 #ifndef SkPathMeasurePriv_DEFINED
 #define SkPathMeasurePriv_DEFINED
 
+#include "include/core/SkContourMeasure.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPoint.h"
 #include "src/core/SkGeometry.h"
@@ -26,4 +27,38 @@ enum SkSegType {
 void SkPathMeasure_segTo(const SkPoint pts[], unsigned segType,
                    SkScalar startT, SkScalar stopT, SkPath* dst);
 
+/**
+ *  Process-wide cache of contour measures, keyed on the path's generation ID (plus the
+ *  forceClosed/resScale measure settings) in SkResourceCache and purged when the path's
+ *  genID changes. SkContourMeasure objects are immutable and refcounted, so cached lists
+ *  can be shared across draws and threads; SkDashPath uses this to avoid re-measuring an
+ *  unchanged path on every draw.
+ */
+class SkContourMeasureCache {
+public:
+    /** An immutable list of the measures for all (non-zero length) contours of one path. */
+    class List : public SkRefCnt {
+    public:
+        int count() const { return fMeasures.count(); }
+        SkContourMeasure* at(int index) const { return fMeasures[index]; }
+
+    private:
+        List() = default;
+
+        SkTDArray<SkContourMeasure*> fMeasures;  // owned; unreffed in the dtor
+
+        ~List() override;
+        friend class SkContourMeasureCache;
+    };
+
+    /**
+     *  Returns the measures for 'path' at the given settings, from the cache when the path's
+     *  generation ID hits. Volatile paths are measured but not cached.
+     */
+    static sk_sp<List> Get(const SkPath& path, bool forceClosed, SkScalar resScale);
+
+    /** The heap footprint of one measure's segment and point tables, for cache budgeting. */
+    static size_t ApproximateBytesUsed(const SkContourMeasure& meas);
+};
+
 #endif  // SkPathMeasurePriv_DEFINED
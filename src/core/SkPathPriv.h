@@ -10,6 +10,7 @@
 
 #include "include/core/SkPath.h"
 #include "include/private/SkIDChangeListener.h"
+#include "include/private/SkTDArray.h"
 
 static_assert(0 == static_cast<int>(SkPathFillType::kWinding), "fill_type_mismatch");
 static_assert(1 == static_cast<int>(SkPathFillType::kEvenOdd), "fill_type_mismatch");
@@ -483,4 +484,43 @@ public:
     }
 };
 
+/**
+ *  Answers repeated point-in-path queries against a single path. Construction walks the path
+ *  once and buckets its edges by y, so each query only visits the edges whose y-range overlaps
+ *  the query point instead of every verb the way SkPath::contains() does. Results match
+ *  SkPath::contains() exactly, including its boundary behavior. The query holds a snapshot of
+ *  the path; editing the path afterwards does not affect it.
+ */
+class SkPathContainsQuery {
+public:
+    explicit SkPathContainsQuery(const SkPath& path);
+
+    bool contains(SkScalar x, SkScalar y) const;
+    bool contains(const SkPoint& p) const { return this->contains(p.fX, p.fY); }
+
+    /** Sets results[i] = contains(pts[i]) for each of the count points. */
+    void containsBatch(const SkPoint pts[], int count, bool results[]) const;
+
+private:
+    struct Edge {
+        SkPoint  fPts[4];
+        SkScalar fWeight;        // used when fVerb == SkPath::kConic_Verb
+        SkScalar fTop, fBottom;  // conservative y-range of the edge's control points
+        uint8_t  fVerb;
+    };
+
+    int bucketForY(SkScalar y) const;
+
+    SkPath             fPath;  // kept for the rare coincident-boundary fallback
+    SkRect             fBounds;
+    SkScalar           fInvSlabHeight;
+    int                fBucketCount;
+    bool               fIsInverse;
+    bool               fEvenOdd;
+    bool               fIsEmpty;
+    SkTDArray<Edge>    fEdges;
+    SkTDArray<int32_t> fBucketStarts;  // fBucketCount + 1 offsets into fBucketEdges
+    SkTDArray<int32_t> fBucketEdges;   // per-bucket lists of indices into fEdges
+};
+
 #endif
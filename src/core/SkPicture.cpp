@@ -143,7 +143,9 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
     if (!data) {
         return nullptr;
     }
-    SkMemoryStream stream(data->data(), data->size());
+    // Share the data with the stream so deserialization can alias large
+    // sections of it (see read_data in SkPictureData.cpp) instead of copying.
+    SkMemoryStream stream(sk_ref_sp(data));
     return MakeFromStream(&stream, procs, nullptr);
 }
 
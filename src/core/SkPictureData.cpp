@@ -10,7 +10,6 @@
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkTo.h"
-#include "src/core/SkAutoMalloc.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
 #include "src/core/SkReadBuffer.h"
@@ -281,6 +280,26 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Read the next 'size' bytes of the stream into an SkData. When the stream
+// shares ref-counted backing storage (e.g. an SkMemoryStream over a
+// memory-mapped .skp), return a zero-copy subset of that storage instead of a
+// copy, so large sections are paged in on demand rather than duplicated. The
+// data is later walked with SkReadBuffer, so only alias when it is 4-byte
+// aligned within the backing store.
+static sk_sp<SkData> read_data(SkStream* stream, uint32_t size) {
+    if (stream->hasPosition()) {
+        if (sk_sp<SkData> data = stream->getData()) {
+            size_t offset = stream->getPosition();
+            if (size <= data->size() - offset &&
+                SkIsAlign4(reinterpret_cast<uintptr_t>(data->bytes()) + offset) &&
+                stream->skip(size) == size) {
+                return SkData::MakeSubset(data.get(), offset, size);
+            }
+        }
+    }
+    return SkData::MakeFromStream(stream, size);
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
@@ -289,7 +308,7 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            fOpData = read_data(stream, size);
             if (!fOpData) {
                 return false;
             }
@@ -338,12 +357,12 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
+            sk_sp<SkData> storage = read_data(stream, size);
+            if (!storage) {
                 return false;
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(storage->data(), storage->size());
             buffer.setVersion(fInfo.getVersion());
 
             if (!fFactoryPlayback) {
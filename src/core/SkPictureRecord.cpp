@@ -868,8 +868,16 @@ void SkPictureRecord::addMatrix(const SkMatrix& matrix) {
 
 void SkPictureRecord::addPaintPtr(const SkPaint* paint) {
     if (paint) {
+        // Paints are interned by content, so repeated identical paints share one slot
+        // (and one flattened copy), the same way fPaths dedupes paths.
+        if (int* n = fPaintMap.find(*paint)) {
+            this->addInt(*n);
+            return;
+        }
         fPaints.push_back(*paint);
-        this->addInt(fPaints.count());
+        int n = fPaints.count();
+        fPaintMap.set(*paint, n);
+        this->addInt(n);
     } else {
         this->addInt(0);
     }
@@ -17,6 +17,7 @@
 #include "include/private/SkTDArray.h"
 #include "include/private/SkTHash.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkPaintPriv.h"
 #include "src/core/SkPictureData.h"
 #include "src/core/SkWriter32.h"
 
@@ -234,6 +235,11 @@ protected:
 private:
     SkTArray<SkPaint>  fPaints;
 
+    struct PaintHash {
+        uint32_t operator()(const SkPaint& p) { return SkPaintPriv::Hash(p); }
+    };
+    SkTHashMap<SkPaint, int, PaintHash> fPaintMap;
+
     struct PathHash {
         uint32_t operator()(const SkPath& p) { return p.getGenerationID(); }
     };
@@ -27,6 +27,42 @@ SkPictureRecorder::SkPictureRecorder() {
 
 SkPictureRecorder::~SkPictureRecorder() {}
 
+SkPictureRecorder::RecordingArena::RecordingArena() : fBlockSize(0) {}
+SkPictureRecorder::RecordingArena::~RecordingArena() {}
+
+SkCanvas* SkPictureRecorder::beginRecording(const SkRect& bounds,
+                                            RecordingArena* arena,
+                                            sk_sp<SkBBoxHierarchy> bbh,
+                                            uint32_t recordFlags) {
+    if (arena) {
+        static const size_t kMinArenaBlock = 4096;
+        sk_sp<SkRecord>& prev = arena->fRecord;
+        if (prev && prev->unique() && prev->bytesUsed() <= arena->fBlockSize) {
+            // The picture recorded last time is gone and everything fit in the
+            // block: rewind and record over the same storage.
+            prev->rewind();
+            fRecord = prev;
+        } else if (!prev || prev->unique()) {
+            // First use, or the last recording overflowed its block: rebuild
+            // the block at the high-water mark. The old record must go first;
+            // it is the only thing still pointing at the old block.
+            size_t highWater = prev ? prev->bytesUsed() : 0;
+            prev.reset();
+            if (highWater > arena->fBlockSize || !arena->fBlock) {
+                arena->fBlockSize = std::max(highWater, kMinArenaBlock);
+                arena->fBlock.reset(new char[arena->fBlockSize]);
+            }
+            fRecord.reset(new SkRecord(arena->fBlock.get(), arena->fBlockSize));
+            prev = fRecord;
+        } else {
+            // The last picture recorded with this arena is still alive and
+            // holds the block; fall back to fresh storage for this recording.
+            fRecord.reset(new SkRecord);
+        }
+    }
+    return this->beginRecording(bounds, std::move(bbh), recordFlags);
+}
+
 SkCanvas* SkPictureRecorder::beginRecording(const SkRect& userCullRect,
                                             sk_sp<SkBBoxHierarchy> bbh,
                                             uint32_t recordFlags /* = 0 */) {
@@ -7,6 +7,7 @@
 
 #include "include/core/SkMatrix.h"
 #include "include/private/SkMalloc.h"
+#include "include/private/SkVx.h"
 #include "src/core/SkBuffer.h"
 #include "src/core/SkRRectPriv.h"
 #include "src/core/SkScaleToSides.h"
@@ -293,6 +294,76 @@ bool SkRRectPriv::AllCornersCircular(const SkRRect& rr, SkScalar tolerance) {
            SkScalarNearlyEqual(rr.fRadii[3].fX, rr.fRadii[3].fY, tolerance);
 }
 
+bool SkRRectPriv::AllCornersInside(const SkRRect& rr, const SkRect& rect) {
+    using F4 = skvx::Vec<4, float>;
+
+    SkASSERT(rr.getBounds().contains(rect));
+
+    const SkRect& bounds = rr.fRect;
+    const F4 x = { rect.fLeft, rect.fRight, rect.fRight,  rect.fLeft   },
+             y = { rect.fTop,  rect.fTop,   rect.fBottom, rect.fBottom };
+
+    auto ok = (x == x);  // all lanes true
+    for (int i = 0; i < 4; ++i) {
+        const SkVector& radii = rr.fRadii[i];
+        const bool onRight  = (i == SkRRect::kUpperRight_Corner ||
+                               i == SkRRect::kLowerRight_Corner);
+        const bool onBottom = (i == SkRRect::kLowerRight_Corner ||
+                               i == SkRRect::kLowerLeft_Corner);
+        const float cx = onRight  ? bounds.fRight  - radii.fX : bounds.fLeft + radii.fX;
+        const float cy = onBottom ? bounds.fBottom - radii.fY : bounds.fTop  + radii.fY;
+
+        auto inCorner = (onRight  ? x > cx : x < cx) &
+                        (onBottom ? y > cy : y < cy);
+        F4 dx = x - cx,
+           dy = y - cy;
+        // Ellipse containment as b^2*dx^2 + a^2*dy^2 <= (ab)^2, as in checkCornerContainment.
+        auto inCurve = dx*dx*(radii.fY*radii.fY) + dy*dy*(radii.fX*radii.fX) <=
+                       (radii.fX*radii.fY)*(radii.fX*radii.fY);
+        ok = ok & (~inCorner | inCurve);
+    }
+    return all(ok);
+}
+
+bool SkRRectPriv::IntersectsRect(const SkRRect& rr, const SkRect& rect) {
+    SkRect overlap;
+    if (!overlap.intersect(rr.getBounds(), rect)) {
+        return false;
+    }
+    if (rr.isRect()) {
+        // the prior test was sufficient
+        return true;
+    }
+
+    using F4 = skvx::Vec<4, float>;
+    const SkRect& bounds = rr.fRect;
+    const SkVector* radii = rr.fRadii;
+
+    // One lane per corner curve, ordered UL, UR, LR, LL: curve centers and radii.
+    const F4 cx = { bounds.fLeft   + radii[0].fX, bounds.fRight  - radii[1].fX,
+                    bounds.fRight  - radii[2].fX, bounds.fLeft   + radii[3].fX },
+             cy = { bounds.fTop    + radii[0].fY, bounds.fTop    + radii[1].fY,
+                    bounds.fBottom - radii[2].fY, bounds.fBottom - radii[3].fY },
+             rx = { radii[0].fX, radii[1].fX, radii[2].fX, radii[3].fX },
+             ry = { radii[0].fY, radii[1].fY, radii[2].fY, radii[3].fY };
+
+    // The corner of the overlap nearest each curve center, and the direction (in x and y)
+    // pointing from each curve center out into its corner of the bounds.
+    const F4 qx = { overlap.fRight,  overlap.fLeft,   overlap.fLeft, overlap.fRight },
+             qy = { overlap.fBottom, overlap.fBottom, overlap.fTop,  overlap.fTop   },
+             sx = { 1, -1, -1,  1 },
+             sy = { 1,  1, -1, -1 };
+
+    // The overlap misses the rrect only if it sits entirely inside one corner's quadrant with
+    // its nearest point outside that corner's curve; every other point of the overlap is then
+    // farther from the curve's center.
+    auto inQuadrant = (sx * (cx - qx) > 0) & (sy * (cy - qy) > 0);
+    F4 dx = qx - cx,
+       dy = qy - cy;
+    auto outsideCurve = dx*dx*ry*ry + dy*dy*rx*rx > rx*rx*ry*ry;
+    return !any(inQuadrant & outsideCurve);
+}
+
 bool SkRRect::contains(const SkRect& rect) const {
     if (!this->getBounds().contains(rect)) {
         // If 'rect' isn't contained by the RR's bounds then the
@@ -308,10 +379,7 @@ bool SkRRect::contains(const SkRect& rect) const {
     // At this point we know all four corners of 'rect' are inside the
     // bounds of of this RR. Check to make sure all the corners are inside
     // all the curves
-    return this->checkCornerContainment(rect.fLeft, rect.fTop) &&
-           this->checkCornerContainment(rect.fRight, rect.fTop) &&
-           this->checkCornerContainment(rect.fRight, rect.fBottom) &&
-           this->checkCornerContainment(rect.fLeft, rect.fBottom);
+    return SkRRectPriv::AllCornersInside(*this, rect);
 }
 
 static bool radii_are_nine_patch(const SkVector radii[4]) {
@@ -45,6 +45,17 @@ public:
         return rr.getBounds().contains(p.fX, p.fY) && rr.checkCornerContainment(p.fX, p.fY);
     }
 
+    // Test all four corners of rect against rr's corner curves in a single SIMD pass (one lane
+    // per corner). Equivalent to four checkCornerContainment() calls; assumes rect is already
+    // known to be within rr.getBounds().
+    static bool AllCornersInside(const SkRRect& rr, const SkRect& rect);
+
+    // Returns true if rr and rect overlap with positive area. Unlike a bounds check, this
+    // accounts for the corner curves, so a rect tucked entirely into the cut-away part of a
+    // corner reports no intersection. Intended for clip reduction, where it lets elements be
+    // skipped that a bounds-only test cannot.
+    static bool IntersectsRect(const SkRRect& rr, const SkRect& rect);
+
     // Compute an approximate largest inscribed bounding box of the rounded rect. For empty,
     // rect, oval, and simple types this will be the largest inscribed rectangle. Otherwise it may
     // not be the global maximum, but will be non-empty, touch at least one edge and be contained
@@ -7,13 +7,15 @@
 
 #include "src/core/SkRTree.h"
 
-SkRTree::SkRTree() : fCount(0) {}
+#include "include/core/SkExecutor.h"
+
+SkRTree::SkRTree(SkExecutor* executor)
+    : fCount(0), fExecutor(executor), fCachedQueryCount(0) {}
 
 void SkRTree::insert(const SkRect boundsArray[], int N) {
     SkASSERT(0 == fCount);
 
-    std::vector<Branch> branches;
-    branches.reserve(N);
+    fDeferredBranches.reserve(N);
 
     for (int i = 0; i < N; i++) {
         const SkRect& bounds = boundsArray[i];
@@ -24,10 +26,24 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
         Branch b;
         b.fBounds = bounds;
         b.fOpIndex = i;
-        branches.push_back(b);
+        fDeferredBranches.push_back(b);
     }
 
-    fCount = (int)branches.size();
+    fCount = (int)fDeferredBranches.size();
+    if (fCount && fExecutor) {
+        // Overlap the build with the rest of recording; the first search()
+        // joins with it through fBuildOnce.
+        fExecutor->add([self = sk_ref_sp(this)] { self->ensureBuilt(); });
+    }
+}
+
+void SkRTree::ensureBuilt() const {
+    fBuildOnce([this] { this->build(); });
+}
+
+void SkRTree::build() const {
+    std::vector<Branch> branches = std::move(fDeferredBranches);
+
     if (fCount) {
         if (1 == fCount) {
             fNodes.reserve(1);
@@ -43,7 +59,7 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
     }
 }
 
-SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
+SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) const {
     SkDEBUGCODE(Node* p = fNodes.data());
     fNodes.push_back(Node{});
     Node& out = fNodes.back();
@@ -90,7 +106,7 @@ int SkRTree::CountNodes(int branches) {
     return nodes + CountNodes(nodes);
 }
 
-SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
+SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) const {
     if (branches->size() == 1) { // Only one branch.  It will be the root.
         return (*branches)[0];
     }
@@ -146,9 +162,83 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
 }
 
 void SkRTree::search(const SkRect& query, std::vector<int>* results) const {
-    if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
+    if (fCount <= 0) {
+        return;
+    }
+    this->ensureBuilt();
+
+    {
+        SkAutoSpinlock lock{fCacheLock};
+        for (int i = 0; i < fCachedQueryCount; i++) {
+            if (fCachedQueries[i].fQuery == query) {
+                CachedQuery hit = std::move(fCachedQueries[i]);
+                // Move the hit to the front so repeated queries stay cached.
+                for (int j = i; j > 0; j--) {
+                    fCachedQueries[j] = std::move(fCachedQueries[j-1]);
+                }
+                results->insert(results->end(), hit.fResults.begin(), hit.fResults.end());
+                fCachedQueries[0] = std::move(hit);
+                return;
+            }
+        }
+    }
+
+    const size_t start = results->size();
+    if (SkRect::Intersects(fRoot.fBounds, query)) {
         this->search(fRoot.fSubtree, query, results);
     }
+
+    SkAutoSpinlock lock{fCacheLock};
+    if (fCachedQueryCount < kMaxCachedQueries) {
+        fCachedQueryCount++;
+    }
+    for (int j = fCachedQueryCount - 1; j > 0; j--) {
+        fCachedQueries[j] = std::move(fCachedQueries[j-1]);
+    }
+    fCachedQueries[0].fQuery = query;
+    fCachedQueries[0].fResults.assign(results->begin() + start, results->end());
+}
+
+void SkRTree::search(const SkRect queries[], int N, std::vector<int> results[]) const {
+    if (fCount <= 0 || N <= 0) {
+        return;
+    }
+    this->ensureBuilt();
+
+    SkTDArray<int> active;
+    for (int i = 0; i < N; i++) {
+        if (SkRect::Intersects(fRoot.fBounds, queries[i])) {
+            active.push_back(i);
+        }
+    }
+    if (!active.isEmpty()) {
+        this->search(fRoot.fSubtree, queries, active, results);
+    }
+}
+
+void SkRTree::search(Node* node, const SkRect queries[], const SkTDArray<int>& active,
+                     std::vector<int> results[]) const {
+    SkTDArray<int> childActive;
+    for (int i = 0; i < node->fNumChildren; ++i) {
+        const Branch& child = node->fChildren[i];
+        if (0 == node->fLevel) {
+            for (int q : active) {
+                if (SkRect::Intersects(child.fBounds, queries[q])) {
+                    results[q].push_back(child.fOpIndex);
+                }
+            }
+        } else {
+            childActive.reset();
+            for (int q : active) {
+                if (SkRect::Intersects(child.fBounds, queries[q])) {
+                    childActive.push_back(q);
+                }
+            }
+            if (!childActive.isEmpty()) {
+                this->search(child.fSubtree, queries, childActive, results);
+            }
+        }
+    }
 }
 
 void SkRTree::search(Node* node, const SkRect& query, std::vector<int>* results) const {
@@ -166,6 +256,7 @@ void SkRTree::search(Node* node, const SkRect& query, std::vector<int>* results)
 size_t SkRTree::bytesUsed() const {
     size_t byteCount = sizeof(SkRTree);
 
+    byteCount += fDeferredBranches.capacity() * sizeof(Branch);
     byteCount += fNodes.capacity() * sizeof(Node);
 
     return byteCount;
@@ -10,6 +10,11 @@
 
 #include "include/core/SkBBHFactory.h"
 #include "include/core/SkRect.h"
+#include "include/private/SkOnce.h"
+#include "include/private/SkSpinlock.h"
+#include "include/private/SkTDArray.h"
+
+class SkExecutor;
 
 /**
  * An R-Tree implementation. In short, it is a balanced n-ary tree containing a hierarchy of
@@ -29,16 +34,33 @@
  */
 class SkRTree : public SkBBoxHierarchy {
 public:
-    SkRTree();
+    /**
+     *  Construction of the tree is deferred until the first search(), so
+     *  pipelines that record but never query (e.g. record-then-serialize)
+     *  never pay for it. If an executor is provided, insert() instead kicks
+     *  off the build there, overlapping it with the rest of recording; the
+     *  first search() joins with it.
+     */
+    SkRTree(SkExecutor* = nullptr);
 
     void insert(const SkRect[], int N) override;
     void search(const SkRect& query, std::vector<int>* results) const override;
+
+    // Answers all N queries in one traversal, visiting each node at most once.
+    void search(const SkRect queries[], int N, std::vector<int> results[]) const override;
+
     size_t bytesUsed() const override;
 
     // Methods and constants below here are only public for tests.
 
     // Return the depth of the tree structure.
-    int getDepth() const { return fCount ? fRoot.fSubtree->fLevel + 1 : 0; }
+    int getDepth() const {
+        if (!fCount) {
+            return 0;
+        }
+        this->ensureBuilt();
+        return fRoot.fSubtree->fLevel + 1;
+    }
     // Insertion count (not overall node count, which may be greater).
     int getCount() const { return fCount; }
 
@@ -64,19 +86,43 @@ private:
     };
 
     void search(Node* root, const SkRect& query, std::vector<int>* results) const;
+    void search(Node* root, const SkRect queries[], const SkTDArray<int>& active,
+                std::vector<int> results[]) const;
+
+    // Build the tree from fDeferredBranches exactly once; safe to race.
+    void ensureBuilt() const;
+    void build() const;
 
     // Consumes the input array.
-    Branch bulkLoad(std::vector<Branch>* branches, int level = 0);
+    Branch bulkLoad(std::vector<Branch>* branches, int level = 0) const;
 
     // How many times will bulkLoad() call allocateNodeAtLevel()?
     static int CountNodes(int branches);
 
-    Node* allocateNodeAtLevel(uint16_t level);
+    Node* allocateNodeAtLevel(uint16_t level) const;
 
     // This is the count of data elements (rather than total nodes in the tree)
     int fCount;
-    Branch fRoot;
-    std::vector<Node> fNodes;
+    SkExecutor* fExecutor;
+
+    // The tree is built lazily (or asynchronously on fExecutor), so these are
+    // written under fBuildOnce from logically-const methods.
+    // Replaying the same picture for the same tile re-issues an identical cull
+    // rect, so memoize the few most recent queries. The tree is immutable once
+    // built, so entries never need invalidating.
+    static const int kMaxCachedQueries = 4;
+    struct CachedQuery {
+        SkRect           fQuery;
+        std::vector<int> fResults;
+    };
+    mutable SkSpinlock  fCacheLock;
+    mutable int         fCachedQueryCount;
+    mutable CachedQuery fCachedQueries[kMaxCachedQueries];
+
+    mutable SkOnce              fBuildOnce;
+    mutable std::vector<Branch> fDeferredBranches;
+    mutable Branch              fRoot;
+    mutable std::vector<Node>   fNodes;
 };
 
 #endif
@@ -513,10 +513,15 @@ SkAAClipBlitterWrapper::SkAAClipBlitterWrapper(const SkAAClip* aaclip,
     SkASSERT(blitter);
     SkASSERT(aaclip);
     fBWRgn.setRect(aaclip->getBounds());
-    fAABlitter.init(blitter, aaclip);
-    // now our return values
+    if (blitter->ingestAAClip(*aaclip)) {
+        // the blitter applies the clip itself, in one fused pipeline
+        fBlitter = blitter;
+    } else {
+        fAABlitter.init(blitter, aaclip);
+        fBlitter = &fAABlitter;
+    }
+    // now our return value
     fClipRgn = &fBWRgn;
-    fBlitter = &fAABlitter;
 }
 
 void SkAAClipBlitterWrapper::init(const SkRasterClip& clip, SkBlitter* blitter) {
@@ -527,9 +532,14 @@ void SkAAClipBlitterWrapper::init(const SkRasterClip& clip, SkBlitter* blitter)
     } else {
         const SkAAClip& aaclip = clip.aaRgn();
         fBWRgn.setRect(aaclip.getBounds());
-        fAABlitter.init(blitter, &aaclip);
-        // now our return values
+        if (blitter->ingestAAClip(aaclip)) {
+            // the blitter applies the clip itself, in one fused pipeline
+            fBlitter = blitter;
+        } else {
+            fAABlitter.init(blitter, &aaclip);
+            fBlitter = &fAABlitter;
+        }
+        // now our return value
         fClipRgn = &fBWRgn;
-        fBlitter = &fAABlitter;
     }
 }
@@ -46,6 +46,43 @@ void SkRasterPipeline::append(StockStage stage, uintptr_t ctx) {
     this->append(stage, ptrCtx);
 }
 
+bool SkRasterPipeline::contains(StockStage stage) const {
+    for (const StageList* st = fStages; st; st = st->prev) {
+        if (st->stage == stage) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float SkDitherRate(SkColorType ct) {
+    switch (ct) {
+        case kARGB_4444_SkColorType:    return   1/15.0f;
+        case   kRGB_565_SkColorType:    return   1/63.0f;
+        case    kGray_8_SkColorType:
+        case  kRGB_888x_SkColorType:
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:    return  1/255.0f;
+        case kRGB_101010x_SkColorType:
+        case kRGBA_1010102_SkColorType:
+        case kBGR_101010x_SkColorType:
+        case kBGRA_1010102_SkColorType: return 1/1023.0f;
+
+        case kUnknown_SkColorType:
+        case kAlpha_8_SkColorType:
+        case kRGBA_F16_SkColorType:
+        case kRGBA_F16Norm_SkColorType:
+        case kRGBA_F32_SkColorType:
+        case kR8G8_unorm_SkColorType:
+        case kA16_float_SkColorType:
+        case kA16_unorm_SkColorType:
+        case kR16G16_float_SkColorType:
+        case kR16G16_unorm_SkColorType:
+        case kR16G16B16A16_unorm_SkColorType: return 0.0f;
+    }
+    SkUNREACHABLE;
+}
+
 void SkRasterPipeline::extend(const SkRasterPipeline& src) {
     if (src.empty()) {
         return;
@@ -389,3 +426,23 @@ std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile()
         start_pipeline(x,y,x+w,y+h, program);
     };
 }
+
+std::function<void(const SkRasterPipeline::Interval[], int)>
+SkRasterPipeline::compile_intervals(float* coverage) const {
+    if (this->empty()) {
+        return [](const Interval[], int) {};
+    }
+
+    void** program = fAlloc->makeArray<void*>(fSlotsNeeded);
+
+    auto start_pipeline = this->build_pipeline(program + fSlotsNeeded);
+    return [=](const Interval intervals[], int n) {
+        for (int i = 0; i < n; i++) {
+            const Interval& iv = intervals[i];
+            if (coverage) {
+                *coverage = iv.coverage;
+            }
+            start_pipeline(iv.x, iv.y, iv.x+iv.w, iv.y+1, program);
+        }
+    };
+}
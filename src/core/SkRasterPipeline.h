@@ -87,10 +87,13 @@ class SkData;
     M(bicubic_n3x) M(bicubic_n1x) M(bicubic_p1x) M(bicubic_p3x)    \
     M(bicubic_n3y) M(bicubic_n1y) M(bicubic_p1y) M(bicubic_p3y)    \
     M(save_xy) M(accumulate)                                       \
+    M(mipmap_linear_init) M(mipmap_linear_update)                  \
+    M(mipmap_linear_finish)                                        \
     M(clamp_x_1) M(mirror_x_1) M(repeat_x_1)                       \
     M(evenly_spaced_gradient)                                      \
     M(gradient)                                                    \
     M(evenly_spaced_2_stop_gradient)                               \
+    M(evenly_spaced_2_stop_gradient_dither)                        \
     M(xy_to_unit_angle)                                            \
     M(xy_to_radius)                                                \
     M(xy_to_2pt_conical_strip)                                     \
@@ -102,9 +105,10 @@ class SkData;
     M(alter_2pt_conical_unswap)                                    \
     M(mask_2pt_conical_nan)                                        \
     M(mask_2pt_conical_degenerates) M(apply_vector_mask)           \
-    M(byte_tables)                                                 \
+    M(byte_tables) M(clut_3d)                                      \
     M(rgb_to_hsl) M(hsl_to_rgb)                                    \
     M(gauss_a_to_rgba)                                             \
+    M(perlin_noise)                                                \
     M(emboss)                                                      \
     M(swizzle)
 
@@ -140,6 +144,17 @@ struct SkRasterPipeline_TileCtx {
     float invScale; // cache of 1/scale
 };
 
+// State shared by the mipmap_linear_* stages, which sample the two mip levels bracketing the
+// ideal scale and lerp between the results (i.e. trilinear filtering).
+struct SkRasterPipeline_MipmapCtx {
+    // Coordinates of the upper level, saved so the lower level samples the same spot.
+    float x[SkRasterPipeline_kMaxStride];
+    float y[SkRasterPipeline_kMaxStride];
+
+    float scaleX, scaleY;  // lower-level coords = upper-level coords * scale
+    float lowerWeight;     // result = lerp(upper, lower, lowerWeight)
+};
+
 struct SkRasterPipeline_DecalTileCtx {
     uint32_t mask[SkRasterPipeline_kMaxStride];
     float    limit_x;
@@ -180,6 +195,15 @@ struct SkRasterPipeline_EvenlySpaced2StopGradientCtx {
     bool interpolatedInPremul;
 };
 
+// Fuses the two-stop lerp with premultiplication and ordered dithering, replacing the
+// evenly_spaced_2_stop_gradient / premul / dither stage chain for the most common gradient draws.
+struct SkRasterPipeline_EvenlySpaced2StopGradientDitherCtx {
+    float f[4];
+    float b[4];
+    float rate;    // same units as the dither stage's rate
+    bool premul;   // multiply rgb by a after the lerp (colors were interpolated unpremultiplied)
+};
+
 struct SkRasterPipeline_2PtConicalCtx {
     uint32_t fMask[SkRasterPipeline_kMaxStride];
     float    fP0,
@@ -196,6 +220,27 @@ struct SkRasterPipeline_EmbossCtx {
                                add;
 };
 
+// State for the perlin_noise stage: the shuffled lattice and per-channel gradient tables from
+// SkPerlinNoiseShaderImpl::PaintingData, laid out as flat float arrays so the lanes can gather
+// from them directly.
+struct SkRasterPipeline_PerlinNoiseCtx {
+    const float* latticeSelector;  // 256 entries
+    const float* gradientX[4];     // 256 entries per channel
+    const float* gradientY[4];
+    float baseFrequencyX, baseFrequencyY;
+    float translateX, translateY;
+    int numOctaves;
+    bool fractal;                  // fractal noise biases into [0,1]; turbulence takes |noise|
+};
+
+// A 3D lookup table over the unit RGB cube, sampled with trilinear interpolation.
+// Entries are rgba floats (alpha is carried but ignored), indexed [r][g][b] with r slowest.
+// Used to collapse chains of color filters into a single baked sampling stage.
+struct SkRasterPipeline_Clut3DCtx {
+    const float* lut;
+    int gridSize;   // entries per axis
+};
+
 class SkRasterPipeline {
 public:
     explicit SkRasterPipeline(SkArenaAlloc*);
@@ -226,6 +271,20 @@ public:
     // Allocates a thunk which amortizes run() setup cost in alloc.
     std::function<void(size_t, size_t, size_t, size_t)> compile() const;
 
+    // A single-row span with its own coverage, for compile_intervals().
+    struct Interval {
+        size_t x, y, w;
+        float  coverage;
+    };
+
+    // Like compile(), but the thunk takes a batch of Intervals and loops over
+    // them internally, amortizing per-call overhead across many short runs
+    // (e.g. text-like blitAntiH workloads).  Before each interval runs, its
+    // coverage is stored to *coverage, which should be the value pointed to by
+    // any scale_1_float/lerp_1_float stage in the pipeline; pass nullptr if no
+    // stage reads coverage.
+    std::function<void(const Interval[], int)> compile_intervals(float* coverage) const;
+
     void dump() const;
 
     // Appends a stage for the specified matrix.
@@ -257,6 +316,10 @@ public:
 
     bool empty() const { return fStages == nullptr; }
 
+    // True if any appended stage is 'stage'. Lets callers avoid appending a stage whose work a
+    // fused shader stage (e.g. evenly_spaced_2_stop_gradient_dither) has already done.
+    bool contains(StockStage stage) const;
+
 private:
     struct StageList {
         StageList* prev;
@@ -276,6 +339,11 @@ private:
     int           fSlotsNeeded;
 };
 
+// The ordered-dither rate for a destination color type, or zero for color types that do not
+// benefit from dithering (e.g. F16). Shared by the blitter and by shader stages that fuse
+// dithering into their own work, so the two always agree.
+float SkDitherRate(SkColorType);
+
 template <size_t bytes>
 class SkRasterPipeline_ : public SkRasterPipeline {
 public:
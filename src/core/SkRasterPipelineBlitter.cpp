@@ -9,6 +9,7 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkShader.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkAAClip.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkBlendModePriv.h"
 #include "src/core/SkBlitter.h"
@@ -45,11 +46,15 @@ public:
     void blitMask  (const SkMask&, const SkIRect& clip)             override;
     void blitRect  (int x, int y, int width, int height)            override;
     void blitV     (int x, int y, int height, SkAlpha alpha)        override;
+    bool ingestAAClip(const SkAAClip&)                              override;
 
 private:
     void append_load_dst      (SkRasterPipeline*) const;
     void append_store         (SkRasterPipeline*) const;
 
+    // refresh the shared clip row that our pipelines read (see ingestAAClip)
+    void updateAAClipRow(int y);
+
     // these check internally, and only append if there was a native clipShader
     void append_clip_scale    (SkRasterPipeline*) const;
     void append_clip_lerp     (SkRasterPipeline*) const;
@@ -61,21 +66,33 @@ private:
     // set to pipeline storage (for alpha) if we have a clipShader
     void*                  fClipShaderBuffer = nullptr; // "native" : float or U16
 
+    // set if an SkAAClip has been fused into our pipelines (see ingestAAClip);
+    // the pipelines read its coverage for the current scanline out of one
+    // shared row that updateAAClipRow() refreshes as y changes
+    const SkAAClip*        fAAClip     = nullptr;
+    uint8_t*               fAAClipRow  = nullptr;
+    int                    fAAClipRowY = 0;
+
     SkRasterPipeline_MemoryCtx
         fDstPtr       = {nullptr,0},  // Always points to the top-left of fDst.
-        fMaskPtr      = {nullptr,0};  // Updated each call to blitMask().
+        fMaskPtr      = {nullptr,0},  // Updated each call to blitMask().
+        fAAClipPtr    = {nullptr,0};  // Points at fAAClipRow, lined up with fDstPtr.
     SkRasterPipeline_EmbossCtx fEmbossCtx;  // Used only for k3D_Format masks.
 
     // We may be able to specialize blitH() or blitRect() into a memset.
-    void   (*fMemset2D)(SkPixmap*, int x,int y, int w,int h, uint64_t color) = nullptr;
-    uint64_t fMemsetColor = 0;   // Big enough for largest memsettable dst format, F16.
+    void   (*fMemset2D)(SkPixmap*, int x,int y, int w,int h, const uint64_t color[2]) = nullptr;
+    uint64_t fMemsetColor[2] = {0,0};  // Big enough for largest memsettable dst format, F32.
+
+    // Constant translucent srcover into 565 can use a dedicated blend row
+    // (see Create).  Zero (transparent) doubles as "not usable".
+    SkPMColor fSrcOver565Color = 0;
 
     // Built lazily on first use.
     std::function<void(size_t, size_t, size_t, size_t)> fBlitRect,
-                                                        fBlitAntiH,
                                                         fBlitMaskA8,
                                                         fBlitMaskLCD16,
                                                         fBlitMask3D;
+    std::function<void(const SkRasterPipeline::Interval[], int)> fBlitAntiH;
 
     // These values are pointed to by the blit pipelines above,
     // which allows us to adjust them from call to call.
@@ -194,30 +211,7 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
     // Not all formats make sense to dither (think, F16).  We set their dither rate
     // to zero.  We need to decide if we're going to dither now to keep is_constant accurate.
     if (paint.isDither()) {
-        switch (dst.info().colorType()) {
-            case kARGB_4444_SkColorType:    blitter->fDitherRate =   1/15.0f; break;
-            case   kRGB_565_SkColorType:    blitter->fDitherRate =   1/63.0f; break;
-            case    kGray_8_SkColorType:
-            case  kRGB_888x_SkColorType:
-            case kRGBA_8888_SkColorType:
-            case kBGRA_8888_SkColorType:    blitter->fDitherRate =  1/255.0f; break;
-            case kRGB_101010x_SkColorType:
-            case kRGBA_1010102_SkColorType:
-            case kBGR_101010x_SkColorType:
-            case kBGRA_1010102_SkColorType: blitter->fDitherRate = 1/1023.0f; break;
-
-            case kUnknown_SkColorType:
-            case kAlpha_8_SkColorType:
-            case kRGBA_F16_SkColorType:
-            case kRGBA_F16Norm_SkColorType:
-            case kRGBA_F32_SkColorType:
-            case kR8G8_unorm_SkColorType:
-            case kA16_float_SkColorType:
-            case kA16_unorm_SkColorType:
-            case kR16G16_float_SkColorType:
-            case kR16G16_unorm_SkColorType:
-            case kR16G16B16A16_unorm_SkColorType: blitter->fDitherRate = 0.0f; break;
-        }
+        blitter->fDitherRate = SkDitherRate(dst.info().colorType());
         // TODO: for constant colors, we could try to measure the effect of dithering, and if
         //       it has no value (i.e. all variations result in the same 32bit color, then we
         //       could disable it (for speed, by not adding the stage).
@@ -226,31 +220,11 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
 #else
     // Not all formats make sense to dither (think, F16).  We set their dither rate
     // to zero.  We only dither non-constant shaders, so is_constant won't change here.
-    if (paint.isDither() && !is_constant) {
-        switch (dst.info().colorType()) {
-            case kARGB_4444_SkColorType:    blitter->fDitherRate =   1/15.0f; break;
-            case   kRGB_565_SkColorType:    blitter->fDitherRate =   1/63.0f; break;
-            case    kGray_8_SkColorType:
-            case  kRGB_888x_SkColorType:
-            case kRGBA_8888_SkColorType:
-            case kBGRA_8888_SkColorType:    blitter->fDitherRate =  1/255.0f; break;
-            case kRGB_101010x_SkColorType:
-            case kRGBA_1010102_SkColorType:
-            case kBGR_101010x_SkColorType:
-            case kBGRA_1010102_SkColorType: blitter->fDitherRate = 1/1023.0f; break;
-
-            case kUnknown_SkColorType:
-            case kAlpha_8_SkColorType:
-            case kRGBA_F16_SkColorType:
-            case kRGBA_F16Norm_SkColorType:
-            case kRGBA_F32_SkColorType:
-            case kR8G8_unorm_SkColorType:
-            case kA16_float_SkColorType:
-            case kA16_unorm_SkColorType:
-            case kR16G16_float_SkColorType:
-            case kR16G16_unorm_SkColorType:
-            case kR16G16B16A16_unorm_SkColorType: blitter->fDitherRate = 0.0f; break;
-        }
+    // A shader stage may have fused the dither into its own work (see the two-stop gradient);
+    // in that case the pixels are already dithered and we must not dither twice.
+    if (paint.isDither() && !is_constant &&
+        !colorPipeline->contains(SkRasterPipeline::evenly_spaced_2_stop_gradient_dither)) {
+        blitter->fDitherRate = SkDitherRate(dst.info().colorType());
         if (blitter->fDitherRate > 0.0f) {
             colorPipeline->append(SkRasterPipeline::dither, &blitter->fDitherRate);
         }
@@ -260,8 +234,8 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
     // We're logically done here.  The code between here and return blitter is all optimization.
 
     // A pipeline that's still constant here can collapse back into a constant color.
+    SkColor4f constantColor = SkColors::kTransparent;  // premul, when is_constant
     if (is_constant) {
-        SkColor4f constantColor;
         SkRasterPipeline_MemoryCtx constantColorPtr = { &constantColor, 0 };
         colorPipeline->append_gamut_clamp_if_normalized(dst.info());
         colorPipeline->append(SkRasterPipeline::store_f32, &constantColorPtr);
@@ -285,32 +259,64 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
         SkRasterPipeline_<256> p;
         p.extend(*colorPipeline);
         p.append_gamut_clamp_if_normalized(dst.info());
-        blitter->fDstPtr = SkRasterPipeline_MemoryCtx{&blitter->fMemsetColor, 0};
+        blitter->fDstPtr = SkRasterPipeline_MemoryCtx{blitter->fMemsetColor, 0};
         blitter->append_store(&p);
         p.run(0,0,1,1);
 
         switch (blitter->fDst.shiftPerPixel()) {
-            case 0: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h, uint64_t c) {
+            case 0: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h,
+                                            const uint64_t c[2]) {
                 void* p = dst->writable_addr(x,y);
                 while (h --> 0) {
-                    memset(p, c, w);
+                    memset(p, (int)c[0], w);
                     p = SkTAddOffset<void>(p, dst->rowBytes());
                 }
             }; break;
 
-            case 1: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h, uint64_t c) {
-                SkOpts::rect_memset16(dst->writable_addr16(x,y), c, w, dst->rowBytes(), h);
+            case 1: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h,
+                                            const uint64_t c[2]) {
+                SkOpts::rect_memset16(dst->writable_addr16(x,y), c[0], w, dst->rowBytes(), h);
             }; break;
 
-            case 2: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h, uint64_t c) {
-                SkOpts::rect_memset32(dst->writable_addr32(x,y), c, w, dst->rowBytes(), h);
+            case 2: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h,
+                                            const uint64_t c[2]) {
+                SkOpts::rect_memset32(dst->writable_addr32(x,y), c[0], w, dst->rowBytes(), h);
             }; break;
 
-            case 3: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h, uint64_t c) {
-                SkOpts::rect_memset64(dst->writable_addr64(x,y), c, w, dst->rowBytes(), h);
+            case 3: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h,
+                                            const uint64_t c[2]) {
+                SkOpts::rect_memset64(dst->writable_addr64(x,y), c[0], w, dst->rowBytes(), h);
             }; break;
 
-            // TODO(F32)?
+            case 4: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h,
+                                            const uint64_t c[2]) {
+                uint64_t* p = (uint64_t*)dst->writable_addr(x,y);
+                while (h --> 0) {
+                    for (int i = 0; i < w; i++) {
+                        p[2*i+0] = c[0];
+                        p[2*i+1] = c[1];
+                    }
+                    p = SkTAddOffset<uint64_t>(p, dst->rowBytes());
+                }
+            }; break;
+        }
+    }
+
+    // A constant translucent color in SrcOver mode over unmanaged 565 can run
+    // a dedicated blend row rather than the general pipeline.  (Constant Src
+    // collapsed into a memset above, and constant opaque SrcOver became Src.)
+    if (is_constant && blitter->fBlend == SkBlendMode::kSrcOver
+                    && dst.colorType() == kRGB_565_SkColorType
+                    && !dst.colorSpace()
+                    && blitter->fDitherRate == 0.0f) {
+        SkPMColor pm = SkPackARGB32(sk_float_round2int(constantColor.fA * 255),
+                                    sk_float_round2int(constantColor.fR * 255),
+                                    sk_float_round2int(constantColor.fG * 255),
+                                    sk_float_round2int(constantColor.fB * 255));
+        // The blend row wants 0 < alpha < 255: fully transparent draws nothing
+        // interesting, and fully opaque became Src above (up to rounding).
+        if (0 < SkGetPackedA32(pm) && SkGetPackedA32(pm) < 255) {
+            blitter->fSrcOver565Color = pm;
         }
     }
 
@@ -343,17 +349,72 @@ void SkRasterPipelineBlitter::append_store(SkRasterPipeline* p) const {
 }
 
 void SkRasterPipelineBlitter::append_clip_scale(SkRasterPipeline* p) const {
+    if (fAAClip) {
+        p->append(SkRasterPipeline::scale_u8, &fAAClipPtr);
+    }
     if (fClipShaderBuffer) {
         p->append(SkRasterPipeline::scale_native, fClipShaderBuffer);
     }
 }
 
 void SkRasterPipelineBlitter::append_clip_lerp(SkRasterPipeline* p) const {
+    if (fAAClip) {
+        p->append(SkRasterPipeline::lerp_u8, &fAAClipPtr);
+    }
     if (fClipShaderBuffer) {
         p->append(SkRasterPipeline::lerp_native, fClipShaderBuffer);
     }
 }
 
+bool SkRasterPipelineBlitter::ingestAAClip(const SkAAClip& aaclip) {
+    if (fAAClip) {
+        return fAAClip == &aaclip;  // already fused (the wrapper may re-init)
+    }
+    // The clip becomes an extra coverage stage in each blit pipeline, so we
+    // must get here before any of them have been built.
+    if (fBlitRect || fBlitAntiH || fBlitMaskA8 || fBlitMaskLCD16 || fBlitMask3D) {
+        return false;
+    }
+
+    const SkIRect& bounds = aaclip.getBounds();
+    fAAClip     = &aaclip;
+    fAAClipRow  = fAlloc->makeArrayDefault<uint8_t>(bounds.width());
+    fAAClipRowY = bounds.fTop - 1;   // no valid row loaded yet
+
+    // Line the context up with fDstPtr at (0,0), reusing the one row for
+    // every y.  (Same UBSAN-friendly uintptr_t trick as the mask planes.)
+    fAAClipPtr.stride = 0;
+    fAAClipPtr.pixels = (void*)((uintptr_t)fAAClipRow - bounds.left());
+
+    // Can't blast whole spans with memset or a dedicated blend row anymore;
+    // the clip modulates them.
+    fMemset2D       = nullptr;
+    fSrcOver565Color = 0;
+    return true;
+}
+
+void SkRasterPipelineBlitter::updateAAClipRow(int y) {
+    if (y == fAAClipRowY) {
+        return;
+    }
+    fAAClipRowY = y;
+
+    const SkIRect& bounds = fAAClip->getBounds();
+    SkASSERT(y >= bounds.fTop && y < bounds.fBottom);
+
+    const uint8_t* row = fAAClip->findRow(y);
+    uint8_t* dst = fAAClipRow;
+    int width = bounds.width();
+    while (width > 0) {
+        int n = row[0];
+        SkASSERT(n <= width);
+        memset(dst, row[1], n);
+        dst += n;
+        row += 2;
+        width -= n;
+    }
+}
+
 void SkRasterPipelineBlitter::blitH(int x, int y, int w) {
     this->blitRect(x,y,w,1);
 }
@@ -364,6 +425,13 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
         return;
     }
 
+    if (fSrcOver565Color) {
+        while (h --> 0) {
+            SkOpts::blit_row_color565(fDst.writable_addr16(x,y++), w, fSrcOver565Color);
+        }
+        return;
+    }
+
     if (!fBlitRect) {
         SkRasterPipeline p(fAlloc);
         p.extend(fColorPipeline);
@@ -384,7 +452,7 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
                 this->append_load_dst(&p);
                 SkBlendMode_AppendStages(fBlend, &p);
                 this->append_clip_lerp(&p);
-            } else if (fClipShaderBuffer) {
+            } else if (fClipShaderBuffer || fAAClip) {
                 this->append_load_dst(&p);
                 this->append_clip_lerp(&p);
             }
@@ -393,10 +461,21 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
         fBlitRect = p.compile();
     }
 
+    if (fAAClip) {
+        // Each scanline reads the clip through the one shared row.
+        while (h --> 0) {
+            this->updateAAClipRow(y);
+            fBlitRect(x,y++,w,1);
+        }
+        return;
+    }
     fBlitRect(x,y,w,h);
 }
 
 void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
+    if (fAAClip) {
+        this->updateAAClipRow(y);
+    }
     if (!fBlitAntiH) {
         SkRasterPipeline p(fAlloc);
         p.extend(fColorPipeline);
@@ -414,21 +493,32 @@ void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const
         }
 
         this->append_store(&p);
-        fBlitAntiH = p.compile();
+        fBlitAntiH = p.compile_intervals(&fCurrentCoverage);
     }
 
+    // Batch up partial-coverage runs so the compiled thunk is entered a few
+    // times per scanline rather than once per 2-10 pixel run.
+    SkRasterPipeline::Interval batch[32];
+    int n = 0;
+
     for (int16_t run = *runs; run > 0; run = *runs) {
         switch (*aa) {
             case 0x00:                       break;
             case 0xff: this->blitH(x,y,run); break;
             default:
-                fCurrentCoverage = *aa * (1/255.0f);
-                fBlitAntiH(x,y,run,1);
+                batch[n++] = { (size_t)x, (size_t)y, (size_t)run, *aa * (1/255.0f) };
+                if (n == (int)SK_ARRAY_COUNT(batch)) {
+                    fBlitAntiH(batch, n);
+                    n = 0;
+                }
         }
         x    += run;
         runs += run;
         aa   += run;
     }
+    if (n > 0) {
+        fBlitAntiH(batch, n);
+    }
 }
 
 void SkRasterPipelineBlitter::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
@@ -458,6 +548,11 @@ void SkRasterPipelineBlitter::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
 }
 
 void SkRasterPipelineBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
+    if (fMemset2D && alpha == 0xff) {
+        fMemset2D(&fDst, x,y, 1,height, fMemsetColor);
+        return;
+    }
+
     SkIRect clip = {x,y, x+1,y+height};
 
     SkMask mask;
@@ -574,5 +669,13 @@ void SkRasterPipelineBlitter::blitMask(const SkMask& mask, const SkIRect& clip)
     }
 
     SkASSERT(blitter);
+    if (fAAClip) {
+        // Each scanline reads the clip through the one shared row.
+        for (int cy = clip.top(); cy < clip.bottom(); cy++) {
+            this->updateAAClipRow(cy);
+            (*blitter)(clip.left(),cy, clip.width(),1);
+        }
+        return;
+    }
     (*blitter)(clip.left(),clip.top(), clip.width(),clip.height());
 }
@@ -457,10 +457,12 @@ SkFlattenable* SkReadBuffer::readFlattenable(SkFlattenable::Type ft) {
     } else {
         if (this->peekByte() != 0) {
             // If the first byte is non-zero, the flattenable is specified by a string.
+            // The name-to-factory lookup happens only here, on first appearance; the
+            // factory's slot in fFlattenableDict handles every later reference.
             size_t ignored_length;
             if (const char* name = this->readString(&ignored_length)) {
                 factory = SkFlattenable::NameToFactory(name);
-                fFlattenableDict.set(fFlattenableDict.count() + 1, factory);
+                *fFlattenableDict.append() = factory;
             }
         } else {
             // Read the index.  We are guaranteed that the first byte
@@ -469,9 +471,8 @@ SkFlattenable* SkReadBuffer::readFlattenable(SkFlattenable::Type ft) {
             if (index == 0) {
                 return nullptr; // writer failed to give us the flattenable
             }
-
-            if (SkFlattenable::Factory* found = fFlattenableDict.find(index)) {
-                factory = *found;
+            if (index <= (uint32_t)fFlattenableDict.count()) {
+                factory = fFlattenableDict[index - 1];
             }
         }
 
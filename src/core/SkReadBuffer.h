@@ -17,6 +17,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSerialProcs.h"
+#include "include/private/SkTDArray.h"
 #include "src/core/SkColorFilterBase.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkPaintPriv.h"
@@ -210,8 +211,10 @@ private:
     const char* fStop = nullptr;  // end of buffer
     const char* fBase = nullptr;  // beginning of buffer
 
-    // Only used if we do not have an fFactoryArray.
-    SkTHashMap<uint32_t, SkFlattenable::Factory> fFlattenableDict;
+    // Only used if we do not have an fFactoryArray. The writer numbers each
+    // distinct flattenable name 1,2,3,... in order of first appearance, so
+    // resolving a repeat is just an array index.
+    SkTDArray<SkFlattenable::Factory> fFlattenableDict;
 
     int fVersion = 0;
 
@@ -12,7 +12,38 @@
 SkRecord::~SkRecord() {
     Destroyer destroyer;
     for (int i = 0; i < this->count(); i++) {
-        this->mutate(i, destroyer);
+        if (fRecords[i].owned()) {
+            this->mutate(i, destroyer);
+        }
+    }
+}
+
+void SkRecord::rewind() {
+    Destroyer destroyer;
+    for (int i = 0; i < this->count(); i++) {
+        if (fRecords[i].owned()) {
+            this->mutate(i, destroyer);
+        }
+    }
+    fSourceRecords.reset();
+    fCount = 0;
+    fApproxBytesAllocated = 0;
+    fAlloc.reset();
+}
+
+void SkRecord::appendBorrowed(sk_sp<const SkRecord> src, int begin, int end) {
+    SkASSERT(src);
+    SkASSERT(0 <= begin && begin <= end && end <= src->count());
+
+    for (int i = begin; i < end; i++) {
+        if (fCount == fReserved) {
+            this->grow();
+        }
+        fRecords[fCount++].setBorrowed(src->fRecords[i]);
+    }
+
+    if (fSourceRecords.empty() || fSourceRecords.back() != src) {
+        fSourceRecords.push_back(std::move(src));
     }
 }
 
@@ -8,6 +8,7 @@
 #ifndef SkRecord_DEFINED
 #define SkRecord_DEFINED
 
+#include "include/private/SkTArray.h"
 #include "include/private/SkTLogic.h"
 #include "include/private/SkTemplates.h"
 #include "src/core/SkArenaAlloc.h"
@@ -28,8 +29,17 @@
 class SkRecord : public SkRefCnt {
 public:
     SkRecord() = default;
+
+    // Places the first blockSize bytes of ops in the caller-owned block, which
+    // must outlive this record (see SkPictureRecorder::RecordingArena).
+    SkRecord(char* block, size_t blockSize) : fAlloc{block, blockSize, 256} {}
+
     ~SkRecord() override;
 
+    // Forget every op, retaining the already-grown op index and (when
+    // constructed over a caller-owned block) op storage for re-recording.
+    void rewind();
+
     // Returns the number of canvas commands in this SkRecord.
     int count() const { return fCount; }
 
@@ -79,12 +89,26 @@ public:
     T* replace(int i) {
         SkASSERT(i < this->count());
 
-        Destroyer destroyer;
-        this->mutate(i, destroyer);
+        if (fRecords[i].owned()) {
+            Destroyer destroyer;
+            this->mutate(i, destroyer);
+        }
 
         return fRecords[i].set(this->allocCommand<T>());
     }
 
+    // Append the ops in [begin, end) of src to this record without re-encoding
+    // them. The new entries alias src's storage: src is reffed so the ops stay
+    // alive, and they remain owned (and are eventually destroyed) by src.
+    // Borrowed ops are shared, so they must never be mutated in place; see
+    // hasBorrowedOps().
+    void appendBorrowed(sk_sp<const SkRecord> src, int begin, int end);
+
+    // True when any op in this record is borrowed from another SkRecord.
+    // Passes that rewrite ops in place (e.g. SkRecordOptimize) must skip
+    // records for which this returns true.
+    bool hasBorrowedOps() const { return !fSourceRecords.empty(); }
+
     // Does not return the bytes in any pointers embedded in the Records; callers
     // need to iterate with a visitor to measure those they care for.
     size_t bytesUsed() const;
@@ -115,6 +139,9 @@ private:
         void operator()(T* record) { record->~T(); }
     };
 
+    // Keeps the SkRecords whose ops we've borrowed (and their storage) alive.
+    SkTArray<sk_sp<const SkRecord>> fSourceRecords;
+
     template <typename T>
     std::enable_if_t<std::is_empty<T>::value, T*> allocCommand() {
         static T singleton = {};
@@ -129,18 +156,29 @@ private:
     // A typed pointer to some bytes in fAlloc.  visit() and mutate() allow polymorphic dispatch.
     struct Record {
         SkRecords::Type fType;
+        bool            fOwned;
         void*           fPtr;
 
         // Point this record to its data in fAlloc.  Returns ptr for convenience.
         template <typename T>
         T* set(T* ptr) {
-            fType = T::kType;
-            fPtr  = ptr;
+            fType  = T::kType;
+            fOwned = true;
+            fPtr   = ptr;
             SkASSERT(this->ptr() == ptr && this->type() == T::kType);
             return ptr;
         }
 
+        // Point this record at another record's data, which stays owned by
+        // that record's SkRecord.
+        void setBorrowed(const Record& src) {
+            fType  = src.fType;
+            fOwned = false;
+            fPtr   = src.fPtr;
+        }
+
         SkRecords::Type type() const { return fType; }
+        bool owned() const { return fOwned; }
         void* ptr() const { return fPtr; }
 
         // Visit this record with functor F (see public API above).
@@ -7,6 +7,7 @@
 
 #include "src/core/SkRecordOpts.h"
 
+#include "include/core/SkRegion.h"
 #include "include/private/SkTDArray.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkRecordPattern.h"
@@ -286,7 +287,84 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// A merged region covers each pixel exactly once where overlapping rects may
+// cover it twice, so the result must not depend on how often a pixel is hit:
+// an effectively opaque src-over fill with no AA coverage or geometry effects.
+static bool is_coalescable_rect_paint(const SkPaint& paint) {
+    return SkPaint::kFill_Style == paint.getStyle()
+        && !paint.isAntiAlias()
+        && paint.isSrcOver()
+        && 0xFF == paint.getAlpha()
+        && (!paint.getShader() || paint.getShader()->isOpaque())
+        && !paint.getColorFilter()
+        && !paint.getPathEffect()
+        && !paint.getMaskFilter()
+        && !paint.getImageFilter();
+}
+
+struct DrawRectMatcher {
+    DrawRect* operator()(DrawRect* op) const { return op; }
+    template <typename T> DrawRect* operator()(T*) const { return nullptr; }
+};
+
+static DrawRect* as_draw_rect(SkRecord* record, int i) {
+    return record->mutate(i, DrawRectMatcher());
+}
+
+// Regions are integral, and a non-AA integer rect rasterizes to the same
+// pixels as the matching region span under any matrix.
+static bool is_integer_rect(const SkRect& rect, SkIRect* out) {
+    *out = rect.round();
+    return SkRect::Make(*out) == rect;
+}
+
+void SkRecordMergeAdjacentRects(SkRecord* record) {
+    // Below this, per-op overhead is too small for a region to pay off.
+    static const int kMinRectsToCoalesce = 4;
+
+    SkTDArray<SkIRect> rects;
+    for (int i = 0; i < record->count(); i++) {
+        DrawRect* first = as_draw_rect(record, i);
+        SkIRect irect;
+        if (!first || !is_coalescable_rect_paint(first->paint)
+                   || !is_integer_rect(first->rect, &irect)) {
+            continue;
+        }
+
+        rects.reset();
+        rects.push_back(irect);
+        int end = i + 1;
+        for (; end < record->count(); end++) {
+            DrawRect* next = as_draw_rect(record, end);
+            if (!next || !(next->paint == first->paint)
+                      || !is_integer_rect(next->rect, &irect)) {
+                break;
+            }
+            rects.push_back(irect);
+        }
+
+        if (rects.count() >= kMinRectsToCoalesce) {
+            SkPaint paint = first->paint;   // replace() destroys *first.
+            SkRegion region;
+            region.setRects(rects.begin(), rects.count());
+            new (record->replace<DrawRegion>(i)) DrawRegion{std::move(paint), std::move(region)};
+            for (int j = i + 1; j < end; j++) {
+                record->replace<NoOp>(j);
+            }
+        }
+        i = end - 1;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SkRecordOptimize(SkRecord* record) {
+    // Borrowed ops are shared with (and owned by) another SkRecord; rewriting
+    // them in place would corrupt it. They were optimized when first recorded.
+    if (record->hasBorrowedOps()) {
+        return;
+    }
+
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
     // and the bounding box hierarchy will do the work of skipping no-op
@@ -303,11 +381,15 @@ void SkRecordOptimize(SkRecord* record) {
     SkRecordNoopSaveLayerDrawRestores(record);
 #endif
     SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordMergeAdjacentRects(record);
 
     record->defrag();
 }
 
 void SkRecordOptimize2(SkRecord* record) {
+    if (record->hasBorrowedOps()) {
+        return;
+    }
     multiple_set_matrices(record);
     SkRecordNoopSaveRestores(record);
     // See why we turn this off in SkRecordOptimize above.
@@ -315,6 +397,7 @@ void SkRecordOptimize2(SkRecord* record) {
     SkRecordNoopSaveLayerDrawRestores(record);
 #endif
     SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordMergeAdjacentRects(record);
 
     record->defrag();
 }
@@ -26,6 +26,10 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Merges long runs of identically painted, integer-aligned DrawRects into a
+// single DrawRegion, so playback dispatches one op instead of thousands.
+void SkRecordMergeAdjacentRects(SkRecord*);
+
 // Experimental optimizers
 void SkRecordOptimize2(SkRecord*);
 
@@ -127,6 +127,39 @@ char* SkRecorder::copy(const char* src) {
     return this->copy(src, strlen(src)+1);
 }
 
+// Counts save/restore depth across a span of ops (see spliceRecord()).
+struct SaveRestoreBalance {
+    int  fDepth = 0;
+    bool fValid = true;
+    void operator()(const SkRecords::Save&)       { fDepth++; }
+    void operator()(const SkRecords::SaveLayer&)  { fDepth++; }
+    void operator()(const SkRecords::SaveBehind&) { fDepth++; }
+    void operator()(const SkRecords::Restore&)    { fValid &= --fDepth >= 0; }
+    template <typename T> void operator()(const T&) {}
+};
+
+bool SkRecorder::spliceRecord(sk_sp<const SkRecord> src, int begin, int end) {
+    if (!fRecord || !src || begin < 0 || begin > end || end > src->count()) {
+        return false;
+    }
+
+    // The span must be save/restore balanced, and may never restore past its
+    // own first save, or splicing it would disturb the surrounding state.
+    SaveRestoreBalance balance;
+    for (int i = begin; i < end && balance.fValid; i++) {
+        src->visit(i, balance);
+    }
+    if (!balance.fValid || balance.fDepth != 0) {
+        return false;
+    }
+
+    if (fMiniRecorder) {
+        this->flushMiniRecorder();
+    }
+    fRecord->appendBorrowed(std::move(src), begin, end);
+    return true;
+}
+
 void SkRecorder::flushMiniRecorder() {
     if (fMiniRecorder) {
         SkMiniRecorder* mr = fMiniRecorder;
@@ -201,6 +234,7 @@ void SkRecorder::onDrawImage(const SkImage* image, SkScalar left, SkScalar top,
 
 void SkRecorder::onDrawImageRect(const SkImage* image, const SkRect* src, const SkRect& dst,
                                  const SkPaint* paint, SrcRectConstraint constraint) {
+    TRY_MINIRECORDER(drawImageRect, image, src, dst, paint, constraint);
     this->append<SkRecords::DrawImageRect>(this->copy(paint), sk_ref_sp(image), this->copy(src), dst, constraint);
 }
 
@@ -228,6 +262,7 @@ void SkRecorder::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
 
 void SkRecorder::onDrawPicture(const SkPicture* pic, const SkMatrix* matrix, const SkPaint* paint) {
     if (fDrawPictureMode == Record_DrawPictureMode) {
+        TRY_MINIRECORDER(drawPicture, pic, matrix, paint);
         fApproxBytesUsedBySubPictures += pic->approximateBytesUsed();
         this->append<SkRecords::DrawPicture>(this->copy(paint), sk_ref_sp(pic), matrix ? *matrix : SkMatrix::I());
     } else if (fDrawPictureMode == PlaybackTop_DrawPictureMode) {
@@ -56,6 +56,13 @@ public:
     SkDrawableList* getDrawableList() const { return fDrawableList.get(); }
     std::unique_ptr<SkDrawableList> detachDrawableList() { return std::move(fDrawableList); }
 
+    // Splice the ops [begin, end) of a previously recorded SkRecord into this
+    // recording without re-encoding them; the spliced ops share src's storage
+    // (see SkRecord::appendBorrowed). The span must be save/restore balanced
+    // so it cannot disturb the surrounding canvas state. Returns false (and
+    // records nothing) if it is not, or if the span is out of range.
+    bool spliceRecord(sk_sp<const SkRecord> src, int begin, int end);
+
     // Make SkRecorder forget entirely about its SkRecord*; all calls to SkRecorder will fail.
     void forgetRecord();
 
@@ -135,6 +135,7 @@ void SkRegion::freeRuns() {
     if (this->isComplex()) {
         SkASSERT(fRunHead->fRefCnt >= 1);
         if (--fRunHead->fRefCnt == 0) {
+            fRunHead->freeYIndex();
             sk_free(fRunHead);
         }
     }
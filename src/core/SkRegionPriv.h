@@ -94,6 +94,7 @@ public:
         // these must be filled in later, otherwise we will be invalid
         head->fYSpanCount = 0;
         head->fIntervalCount = 0;
+        head->fYIndex = nullptr;
         return head;
     }
 
@@ -113,6 +114,9 @@ public:
 
     SkRegion::RunType* writable_runs() {
         SkASSERT(fRefCnt == 1);
+        // The caller is about to mutate the runs, so any scanline index built
+        // over them is stale.
+        this->freeYIndex();
         return (SkRegion::RunType*)(this + 1);
     }
 
@@ -133,6 +137,7 @@ public:
             // If we own the last reference at this point, we need to
             // free the memory.
             if (--fRefCnt == 0) {
+                this->freeYIndex();
                 sk_free(this);
             }
         }
@@ -175,6 +180,24 @@ public:
         // if the top-check fails, we didn't do a quick check on the bounds
         SkASSERT(y >= runs[0]);
 
+        if (fYSpanCount >= kYIndexCutoff) {
+            const YIndexEntry* index = this->ensureYIndex();
+            // Find the first scanline whose Bottom is beyond y.
+            int lo = 0;
+            int hi = fYSpanCount - 1;
+            while (lo < hi) {
+                int mid = (lo + hi) >> 1;
+                if (index[mid].fBottom <= y) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            SkASSERT(y < index[lo].fBottom);
+            SkASSERT(lo == 0 || index[lo - 1].fBottom <= y);
+            return const_cast<SkRegion::RunType*>(runs + index[lo].fOffset);
+        }
+
         runs += 1;  // skip top-Y
         for (;;) {
             int bottom = runs[0];
@@ -251,9 +274,62 @@ public:
         bounds->fBottom = bot;
     }
 
+    /**
+     *  Free any scanline index built over the runs. Must be called before the
+     *  runs are mutated in place, and before the head itself is freed.
+     */
+    void freeYIndex() {
+        if (YIndexEntry* index = fYIndex.exchange(nullptr)) {
+            sk_free(index);
+        }
+    }
+
 private:
+    // Once a region has this many scanlines, findScanline() builds (and then
+    // binary searches) a per-scanline index rather than walking every
+    // scanline's runs. Building costs one linear walk, i.e. about one
+    // worst-case query, so the cutoff just needs to clear the small regions
+    // that never earn the allocation back.
+    static constexpr int kYIndexCutoff = 64;
+
+    struct YIndexEntry {
+        RunType fBottom;    // the scanline's Bottom value
+        int32_t fOffset;    // index of that Bottom in the run array
+    };
+
+    const YIndexEntry* ensureYIndex() const {
+        YIndexEntry* index = fYIndex.load(std::memory_order_acquire);
+        if (index) {
+            return index;
+        }
+
+        index = (YIndexEntry*)sk_malloc_throw(
+                sk_64_mul(fYSpanCount, sizeof(YIndexEntry)));
+        const RunType* runs = this->readonly_runs();
+        const RunType* curr = runs + 1;     // skip top-Y
+        for (int i = 0; i < fYSpanCount; ++i) {
+            SkASSERT(curr[0] < SkRegion_kRunTypeSentinel);
+            index[i].fBottom = curr[0];
+            index[i].fOffset = SkToS32(curr - runs);
+            curr = SkipEntireScanline(curr);
+        }
+        SkASSERT(SkRegionValueIsSentinel(curr[0]));
+
+        // Concurrent readers may race to build the index; the first store
+        // wins and the losers free their copy.
+        YIndexEntry* expected = nullptr;
+        if (!fYIndex.compare_exchange_strong(expected, index,
+                                             std::memory_order_release,
+                                             std::memory_order_acquire)) {
+            sk_free(index);
+            index = expected;
+        }
+        return index;
+    }
+
     int32_t fYSpanCount;
     int32_t fIntervalCount;
+    mutable std::atomic<YIndexEntry*> fYIndex;
 };
 
 #endif
@@ -72,6 +72,16 @@ static const SkDescriptor* create_descriptor(
 // -- Serializer -----------------------------------------------------------------------------------
 size_t pad(size_t size, size_t alignment) { return (size + (alignment - 1)) & ~(alignment - 1); }
 
+// Small signed values (glyph ID deltas, glyph bounds) spend most of their
+// bits on sign extension; zigzag folds the sign into the low bit so they
+// varint-encode in one or two bytes.
+static uint32_t zigzag_encode(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+static int32_t zigzag_decode(uint32_t value) {
+    return (int32_t)((value >> 1) ^ (~(value & 1) + 1));
+}
+
 // Alignment between x86 and x64 differs for some types, in particular
 // int64_t and doubles have 4 and 8-byte alignment, respectively.
 // Be consistent even when writing and reading across different architectures.
@@ -102,6 +112,25 @@ public:
         return result;
     }
 
+    // LEB128; byte-packed so the glyph records don't pay alignment padding
+    // between small fields.
+    void writeVarint(uint32_t value) {
+        uint8_t bytes[5];
+        size_t count = 0;
+        do {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+            bytes[count++] = byte | (value != 0 ? 0x80 : 0);
+        } while (value != 0);
+        memcpy(this->allocate(count, 1), bytes, count);
+    }
+
+    // Like write, but with no alignment padding before the value.
+    template <typename T>
+    void writePacked(const T& data) {
+        memcpy(this->allocate(sizeof(T), 1), &data, sizeof(T));
+    }
+
     void writeDescriptor(const SkDescriptor& desc) {
         write(desc.getLength());
         auto result = allocate(desc.getLength(), alignof(SkDescriptor));
@@ -134,6 +163,31 @@ public:
         return true;
     }
 
+    bool readVarint(uint32_t* value) {
+        uint32_t result = 0;
+        for (int shift = 0; shift <= 28; shift += 7) {
+            auto* bytePtr = this->ensureAtLeast(1, 1);
+            if (!bytePtr) return false;
+            uint8_t byte = *bytePtr;
+            result |= (uint32_t)(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                *value = result;
+                return true;
+            }
+        }
+        // More than five bytes is malformed.
+        return false;
+    }
+
+    template <typename T>
+    bool readPacked(T* val) {
+        auto* result = this->ensureAtLeast(sizeof(T), 1);
+        if (!result) return false;
+
+        memcpy(val, const_cast<const char*>(result), sizeof(T));
+        return true;
+    }
+
     bool readDescriptor(SkAutoDescriptor* ad) {
         uint32_t descLength = 0u;
         if (!read<uint32_t>(&descLength)) return false;
@@ -656,15 +710,20 @@ SkStrikeServer::RemoteStrike* SkStrikeServer::getOrCreateCache(
 
 // No need to write fForceBW because it is a flag private to SkScalerContext_DW, which will never
 // be called on the GPU side.
-static void writeGlyph(const SkGlyph& glyph, Serializer* serializer) {
-    serializer->write<SkPackedGlyphID>(glyph.getPackedID());
-    serializer->write<float>(glyph.advanceX());
-    serializer->write<float>(glyph.advanceY());
-    serializer->write<uint16_t>(glyph.width());
-    serializer->write<uint16_t>(glyph.height());
-    serializer->write<int16_t>(glyph.top());
-    serializer->write<int16_t>(glyph.left());
-    serializer->write<uint8_t>(glyph.maskFormat());
+// Records are byte-packed and the packed IDs delta-encoded against the
+// previous glyph in the list: runs from one strike have clustered IDs, so the
+// varint fields shrink a record to roughly half of the old padded layout.
+static void writeGlyph(const SkGlyph& glyph, Serializer* serializer, uint32_t* prevPackedID) {
+    uint32_t packedID = glyph.getPackedID().value();
+    serializer->writeVarint(zigzag_encode((int32_t)(packedID - *prevPackedID)));
+    *prevPackedID = packedID;
+    serializer->writePacked<float>(glyph.advanceX());
+    serializer->writePacked<float>(glyph.advanceY());
+    serializer->writeVarint(glyph.width());
+    serializer->writeVarint(glyph.height());
+    serializer->writeVarint(zigzag_encode(glyph.top()));
+    serializer->writeVarint(zigzag_encode(glyph.left()));
+    serializer->writePacked<uint8_t>(glyph.maskFormat());
 }
 
 void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
@@ -685,10 +744,11 @@ void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
 
     // Write mask glyphs
     serializer->emplace<uint64_t>(fMasksToSend.size());
+    uint32_t prevPackedID = 0;
     for (SkGlyph& glyph : fMasksToSend) {
         SkASSERT(SkMask::IsValidFormat(glyph.fMaskFormat));
 
-        writeGlyph(glyph, serializer);
+        writeGlyph(glyph, serializer, &prevPackedID);
         auto imageSize = glyph.imageSize();
         if (imageSize > 0 && FitsInAtlas(glyph)) {
             glyph.fImage = serializer->allocate(imageSize, glyph.formatAlignment());
@@ -699,10 +759,11 @@ void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
 
     // Write glyphs paths.
     serializer->emplace<uint64_t>(fPathsToSend.size());
+    prevPackedID = 0;
     for (SkGlyph& glyph : fPathsToSend) {
         SkASSERT(SkMask::IsValidFormat(glyph.fMaskFormat));
 
-        writeGlyph(glyph, serializer);
+        writeGlyph(glyph, serializer, &prevPackedID);
         writeGlyphPath(glyph, serializer);
     }
     fPathsToSend.clear();
@@ -887,17 +948,30 @@ SkStrikeClient::~SkStrikeClient() = default;
 
 // No need to read fForceBW because it is a flag private to SkScalerContext_DW, which will never
 // be called on the GPU side.
-bool SkStrikeClient::ReadGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer) {
-    SkPackedGlyphID glyphID;
-    if (!deserializer->read<SkPackedGlyphID>(&glyphID)) return false;
-    glyph.init(glyphID);
-    if (!deserializer->read<float>(&glyph->fAdvanceX)) return false;
-    if (!deserializer->read<float>(&glyph->fAdvanceY)) return false;
-    if (!deserializer->read<uint16_t>(&glyph->fWidth)) return false;
-    if (!deserializer->read<uint16_t>(&glyph->fHeight)) return false;
-    if (!deserializer->read<int16_t>(&glyph->fTop)) return false;
-    if (!deserializer->read<int16_t>(&glyph->fLeft)) return false;
-    if (!deserializer->read<uint8_t>(&glyph->fMaskFormat)) return false;
+bool SkStrikeClient::ReadGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer,
+                               uint32_t* prevPackedID) {
+    uint32_t delta;
+    if (!deserializer->readVarint(&delta)) return false;
+    uint32_t packedID = *prevPackedID + (uint32_t)zigzag_decode(delta);
+    *prevPackedID = packedID;
+    glyph.init(SkPackedGlyphID{packedID});
+    if (!deserializer->readPacked<float>(&glyph->fAdvanceX)) return false;
+    if (!deserializer->readPacked<float>(&glyph->fAdvanceY)) return false;
+    uint32_t width, height, top, left;
+    if (!deserializer->readVarint(&width)) return false;
+    if (!deserializer->readVarint(&height)) return false;
+    if (!deserializer->readVarint(&top)) return false;
+    if (!deserializer->readVarint(&left)) return false;
+    if (!SkTFitsIn<uint16_t>(width) || !SkTFitsIn<uint16_t>(height)) return false;
+    if (!SkTFitsIn<int16_t>(zigzag_decode(top)) ||
+        !SkTFitsIn<int16_t>(zigzag_decode(left))) {
+        return false;
+    }
+    glyph->fWidth  = SkToU16(width);
+    glyph->fHeight = SkToU16(height);
+    glyph->fTop    = SkToS16(zigzag_decode(top));
+    glyph->fLeft   = SkToS16(zigzag_decode(left));
+    if (!deserializer->readPacked<uint8_t>(&glyph->fMaskFormat)) return false;
     if (!SkMask::IsValidFormat(glyph->fMaskFormat)) return false;
 
     return true;
@@ -969,9 +1043,10 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
         }
 
         if (!deserializer.read<uint64_t>(&glyphImagesCount)) READ_FAILURE
+        uint32_t prevPackedID = 0;
         for (size_t j = 0; j < glyphImagesCount; j++) {
             SkTLazy<SkGlyph> glyph;
-            if (!ReadGlyph(glyph, &deserializer)) READ_FAILURE
+            if (!ReadGlyph(glyph, &deserializer, &prevPackedID)) READ_FAILURE
 
             if (!glyph->isEmpty() && SkStrikeForGPU::FitsInAtlas(*glyph)) {
                 const volatile void* image =
@@ -984,9 +1059,10 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
         }
 
         if (!deserializer.read<uint64_t>(&glyphPathsCount)) READ_FAILURE
+        prevPackedID = 0;
         for (size_t j = 0; j < glyphPathsCount; j++) {
             SkTLazy<SkGlyph> glyph;
-            if (!ReadGlyph(glyph, &deserializer)) READ_FAILURE
+            if (!ReadGlyph(glyph, &deserializer, &prevPackedID)) READ_FAILURE
 
             SkGlyph* allocatedGlyph = strike->mergeGlyphAndImage(glyph->getPackedID(), *glyph);
 
@@ -222,7 +222,8 @@ public:
 private:
     class DiscardableStrikePinner;
 
-    static bool ReadGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer);
+    static bool ReadGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer,
+                          uint32_t* prevPackedID);
     sk_sp<SkTypeface> addTypeface(const WireTypeface& wire);
 
     SkTHashMap<SkFontID, sk_sp<SkTypeface>> fRemoteFontIdToTypeface;
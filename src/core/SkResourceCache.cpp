@@ -84,7 +84,9 @@ void SkResourceCache::init() {
     fHash = new Hash;
     fTotalBytesUsed = 0;
     fCount = 0;
+    fCountLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
     fSingleAllocationByteLimit = 0;
+    fSharedBytesUsed = nullptr;
 
     // One of these should be explicit set by the caller after we return.
     fTotalByteLimit = 0;
@@ -185,6 +187,9 @@ void SkResourceCache::remove(Rec* rec) {
 
     fTotalBytesUsed -= used;
     fCount -= 1;
+    if (fSharedBytesUsed) {
+        fSharedBytesUsed->fetch_sub(used, std::memory_order_relaxed);
+    }
 
     //SkDebugf("-RC count [%3d] bytes %d\n", fCount, fTotalBytesUsed);
 
@@ -204,7 +209,7 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     int    countLimit;
 
     if (fDiscardableFactory) {
-        countLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
+        countLimit = fCountLimit;
         byteLimit = UINT32_MAX;  // no limit based on bytes
     } else {
         countLimit = SK_MaxS32; // no limit based on count
@@ -213,7 +218,12 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
 
     Rec* rec = fTail;
     while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        // when accounting is shared, our purge decision considers the usage of all
+        // participating caches (though we can only evict our own recs).
+        const size_t bytesUsed = fSharedBytesUsed
+                ? fSharedBytesUsed->load(std::memory_order_relaxed)
+                : fTotalBytesUsed;
+        if (!forcePurge && bytesUsed < byteLimit && fCount < countLimit) {
             break;
         }
 
@@ -290,6 +300,12 @@ size_t SkResourceCache::setTotalByteLimit(size_t newLimit) {
     return prevLimit;
 }
 
+void SkResourceCache::shareByteAccounting(std::atomic<size_t>* sharedBytesUsed, int countLimit) {
+    SkASSERT(0 == fCount);  // must be configured before the cache is used
+    fSharedBytesUsed = sharedBytesUsed;
+    fCountLimit = countLimit;
+}
+
 SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
     this->checkMessages();
 
@@ -356,6 +372,9 @@ void SkResourceCache::addToHead(Rec* rec) {
     }
     fTotalBytesUsed += rec->bytesUsed();
     fCount += 1;
+    if (fSharedBytesUsed) {
+        fSharedBytesUsed->fetch_add(rec->bytesUsed(), std::memory_order_relaxed);
+    }
 
     this->validate();
 }
@@ -450,89 +469,145 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkResourceCache* gResourceCache = nullptr;
-static SkMutex& resource_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
-    return mutex;
-}
+/*
+ *  The global cache is sharded by key hash: each shard owns its own mutex, hash table and
+ *  LRU list, so concurrent lookups for different keys no longer serialize on a single lock.
+ *  All shards draw from one byte budget, maintained with atomic accounting
+ *  (see shareByteAccounting()).
+ */
+static const int kShardBits  = 3;
+static const int kShardCount = 1 << kShardBits;
 
-/** Must hold resource_cache_mutex() when calling. */
-static SkResourceCache* get_cache() {
-    // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in here.
-    resource_cache_mutex().assertHeld();
-    if (nullptr == gResourceCache) {
+struct CacheShard {
+    SkMutex          fMutex;
+    SkResourceCache* fCache = nullptr;
+};
+
+static CacheShard gShards[kShardCount];
+
+static std::atomic<size_t> gTotalBytesUsed{0};
+static std::atomic<size_t> gTotalByteLimit{SK_DEFAULT_IMAGE_CACHE_LIMIT};
+static std::atomic<size_t> gSingleAllocationByteLimit{0};
+
+/** Must hold the shard's mutex when calling. */
+static SkResourceCache* get_shard_cache(int i) {
+    gShards[i].fMutex.assertHeld();
+    if (nullptr == gShards[i].fCache) {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        SkResourceCache* cache = new SkResourceCache(SkDiscardableMemory::Create);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        SkResourceCache* cache =
+                new SkResourceCache(gTotalByteLimit.load(std::memory_order_relaxed));
 #endif
+        cache->shareByteAccounting(&gTotalBytesUsed,
+                                   SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT
+                                           / kShardCount);
+        cache->setSingleAllocationByteLimit(
+                gSingleAllocationByteLimit.load(std::memory_order_relaxed));
+        gShards[i].fCache = cache;
     }
-    return gResourceCache;
+    return gShards[i].fCache;
+}
+
+static int key_to_shard(const SkResourceCache::Key& key) {
+    // The hash tables consume the low bits of the hash, so shard on the high bits.
+    return key.hash() >> (32 - kShardBits);
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalBytesUsed();
+    return gTotalBytesUsed.load(std::memory_order_relaxed);
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalByteLimit();
+    return gTotalByteLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setTotalByteLimit(newLimit);
+    const size_t prevLimit = gTotalByteLimit.exchange(newLimit, std::memory_order_relaxed);
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive am(gShards[i].fMutex);
+        get_shard_cache(i)->setTotalByteLimit(newLimit);
+    }
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->discardableFactory();
+    SkAutoMutexExclusive am(gShards[0].fMutex);
+    return get_shard_cache(0)->discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->newCachedData(bytes);
+    SkAutoMutexExclusive am(gShards[0].fMutex);
+    return get_shard_cache(0)->newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->dump();
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive am(gShards[i].fMutex);
+        get_shard_cache(i)->dump();
+    }
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setSingleAllocationByteLimit(size);
+    const size_t prevLimit = gSingleAllocationByteLimit.exchange(size, std::memory_order_relaxed);
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive am(gShards[i].fMutex);
+        get_shard_cache(i)->setSingleAllocationByteLimit(size);
+    }
+    return prevLimit;
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getSingleAllocationByteLimit();
+    return gSingleAllocationByteLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    SkAutoMutexExclusive am(gShards[0].fMutex);
+    return get_shard_cache(0)->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->purgeAll();
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive am(gShards[i].fMutex);
+        get_shard_cache(i)->purgeAll();
+    }
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->find(key, visitor, context);
+    const int i = key_to_shard(key);
+    SkAutoMutexExclusive am(gShards[i].fMutex);
+    return get_shard_cache(i)->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->add(rec, payload);
+    const int i = key_to_shard(rec->getKey());
+    {
+        SkAutoMutexExclusive am(gShards[i].fMutex);
+        get_shard_cache(i)->add(rec, payload);
+    }
+#ifndef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
+    // add() purges within its own shard; when usage is concentrated in other shards the
+    // shared budget may still be exceeded, so sweep the rest.
+    if (gTotalBytesUsed.load(std::memory_order_relaxed)
+            > gTotalByteLimit.load(std::memory_order_relaxed)) {
+        for (int j = 0; j < kShardCount; ++j) {
+            if (j == i) {
+                continue;
+            }
+            SkAutoMutexExclusive am(gShards[j].fMutex);
+            if (gShards[j].fCache) {
+                gShards[j].fCache->purgeAsNeeded();
+            }
+        }
+    }
+#endif
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->visitAll(visitor, context);
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive am(gShards[i].fMutex);
+        get_shard_cache(i)->visitAll(visitor, context);
+    }
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
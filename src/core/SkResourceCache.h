@@ -12,6 +12,8 @@
 #include "include/private/SkTDArray.h"
 #include "src/core/SkMessageBus.h"
 
+#include <atomic>
+
 class SkCachedData;
 class SkDiscardableMemory;
 class SkTraceMemoryDump;
@@ -249,6 +251,15 @@ public:
 
     DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
 
+    /**
+     *  Share byte/count accounting with other cache instances (used by the sharded global
+     *  cache). When set, recs added/removed from this cache also update |sharedBytesUsed|,
+     *  purge decisions compare it (rather than this cache's own usage) against the byte
+     *  limit, and |countLimit| replaces the default discardable count limit.
+     *  Must be called before any recs are added.
+     */
+    void shareByteAccounting(std::atomic<size_t>* sharedBytesUsed, int countLimit);
+
     SkCachedData* newCachedData(size_t bytes);
 
     /**
@@ -269,6 +280,10 @@ private:
     size_t  fTotalByteLimit;
     size_t  fSingleAllocationByteLimit;
     int     fCount;
+    int     fCountLimit;
+
+    // null unless shareByteAccounting() was called (see above)
+    std::atomic<size_t>* fSharedBytesUsed;
 
     SkMessageBus<PurgeSharedIDMessage>::Inbox fPurgeSharedIDInbox;
 
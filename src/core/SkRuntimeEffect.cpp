@@ -15,6 +15,7 @@
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkMatrixProvider.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkUtils.h"
@@ -37,27 +38,46 @@
 #include <algorithm>
 
 namespace SkSL {
+// A handle to a compiler drawn from a process-wide pool. Each handle owns its compiler exclusively
+// for its own lifetime, so independent threads can compile programs concurrently instead of
+// serializing on a single shared instance; the pool lock is only held while checking a compiler in
+// or out. Compilers are recycled so their pre-parsed modules and program caches stay warm.
 class SharedCompiler {
 public:
-    SharedCompiler() : fLock(compiler_mutex()) {
-        if (!gCompiler) {
-            gCompiler = new SkSL::Compiler{};
+    SharedCompiler() {
+        SkAutoMutexExclusive lock(pool_mutex());
+        std::vector<SkSL::Compiler*>& pool = idle_compilers();
+        if (pool.empty()) {
+            fCompiler = new SkSL::Compiler{};
+        } else {
+            fCompiler = pool.back();
+            pool.pop_back();
         }
     }
 
-    SkSL::Compiler* operator->() const { return gCompiler; }
+    ~SharedCompiler() {
+        SkAutoMutexExclusive lock(pool_mutex());
+        idle_compilers().push_back(fCompiler);
+    }
+
+    SharedCompiler(const SharedCompiler&) = delete;
+    SharedCompiler& operator=(const SharedCompiler&) = delete;
+
+    SkSL::Compiler* operator->() const { return fCompiler; }
 
 private:
-    SkAutoMutexExclusive fLock;
+    SkSL::Compiler* fCompiler;
 
-    static SkMutex& compiler_mutex() {
+    static SkMutex& pool_mutex() {
         static SkMutex& mutex = *(new SkMutex);
         return mutex;
     }
 
-    static SkSL::Compiler* gCompiler;
+    static std::vector<SkSL::Compiler*>& idle_compilers() {
+        static std::vector<SkSL::Compiler*>& pool = *(new std::vector<SkSL::Compiler*>);
+        return pool;
+    }
 };
-SkSL::Compiler* SharedCompiler::gCompiler = nullptr;
 }
 
 // Accepts a valid marker, or "normals(<marker>)"
@@ -111,14 +131,31 @@ SkRuntimeEffect::EffectResult SkRuntimeEffect::Make(SkString sksl) {
     auto program = compiler->convertProgram(SkSL::Program::kPipelineStage_Kind,
                                             SkSL::String(sksl.c_str(), sksl.size()),
                                             SkSL::Program::Settings());
-    // TODO: Many errors aren't caught until we process the generated Program here. Catching those
-    // in the IR generator would provide better errors messages (with locations).
-    #define RETURN_FAILURE(...) return std::make_tuple(nullptr, SkStringPrintf(__VA_ARGS__))
-
     if (!program) {
-        RETURN_FAILURE("%s", compiler->errorText().c_str());
+        return std::make_tuple(nullptr, SkString(compiler->errorText().c_str()));
     }
     SkASSERT(!compiler->errorCount());
+    return MakeInternal(std::move(sksl), nullptr, std::move(program), compiler);
+}
+
+SkRuntimeEffect::EffectResult SkRuntimeEffect::Make(sk_sp<SkData> dehydrated) {
+    SkSL::SharedCompiler compiler;
+    auto program = compiler->rehydrateProgram(SkSL::Program::kPipelineStage_Kind,
+                                              dehydrated->bytes(), dehydrated->size(),
+                                              SkSL::Program::Settings());
+    if (!program) {
+        return std::make_tuple(nullptr, SkString(compiler->errorText().c_str()));
+    }
+    return MakeInternal(SkString(), std::move(dehydrated), std::move(program), compiler);
+}
+
+SkRuntimeEffect::EffectResult SkRuntimeEffect::MakeInternal(SkString sksl,
+                                                            sk_sp<SkData> dehydrated,
+                                                            std::unique_ptr<SkSL::Program> program,
+                                                            const SkSL::SharedCompiler& compiler) {
+    // TODO: Many errors aren't caught until we process the generated Program here. Catching those
+    // in the IR generator would provide better errors messages (with locations).
+    #define RETURN_FAILURE(...) return std::make_tuple(nullptr, SkStringPrintf(__VA_ARGS__))
 
     bool hasMain = false;
     bool mainHasSampleCoords = SkSL::Analysis::ReferencesSampleCoords(*program);
@@ -256,6 +293,7 @@ SkRuntimeEffect::EffectResult SkRuntimeEffect::Make(SkString sksl) {
 #undef RETURN_FAILURE
 
     sk_sp<SkRuntimeEffect> effect(new SkRuntimeEffect(std::move(sksl),
+                                                      std::move(dehydrated),
                                                       std::move(program),
                                                       std::move(inAndUniformVars),
                                                       std::move(children),
@@ -286,6 +324,7 @@ size_t SkRuntimeEffect::Variable::sizeInBytes() const {
 }
 
 SkRuntimeEffect::SkRuntimeEffect(SkString sksl,
+                                 sk_sp<SkData> dehydrated,
                                  std::unique_ptr<SkSL::Program> baseProgram,
                                  std::vector<Variable>&& inAndUniformVars,
                                  std::vector<SkString>&& children,
@@ -295,6 +334,7 @@ SkRuntimeEffect::SkRuntimeEffect(SkString sksl,
                                  bool mainHasSampleCoords)
         : fHash(SkGoodHash()(sksl))
         , fSkSL(std::move(sksl))
+        , fDehydrated(std::move(dehydrated))
         , fBaseProgram(std::move(baseProgram))
         , fInAndUniformVars(std::move(inAndUniformVars))
         , fChildren(std::move(children))
@@ -302,6 +342,14 @@ SkRuntimeEffect::SkRuntimeEffect(SkString sksl,
         , fVaryings(std::move(varyings))
         , fUniformSize(uniformSize)
         , fMainFunctionHasSampleCoords(mainHasSampleCoords) {
+    if (fSkSL.isEmpty() && fDehydrated) {
+        fHash = SkOpts::hash(fDehydrated->data(), fDehydrated->size());
+    }
+    for (const Variable& v : fInAndUniformVars) {
+        if (v.fQualifier == Variable::Qualifier::kUniform) {
+            fUniformSlots.push_back({v.fOffset, v.fType, v.fCount});
+        }
+    }
     SkASSERT(fBaseProgram);
     SkASSERT(SkIsAlign4(fUniformSize));
     SkASSERT(fUniformSize <= this->inputSize());
@@ -328,16 +376,29 @@ int SkRuntimeEffect::findChild(const char* name) const {
     return iter == fChildren.end() ? -1 : static_cast<int>(iter - fChildren.begin());
 }
 
+bool SkRuntimeEffect::pinUniform(const char* name) {
+    auto iter = std::find_if(fInAndUniformVars.begin(), fInAndUniformVars.end(),
+                             [name](const Variable& v) { return v.fName.equals(name); });
+    if (iter == fInAndUniformVars.end() || iter->fQualifier != Variable::Qualifier::kUniform ||
+        iter->isArray() ||
+        (iter->fType != Variable::Type::kBool && iter->fType != Variable::Type::kInt &&
+         iter->fType != Variable::Type::kFloat)) {
+        return false;
+    }
+    iter->fFlags |= Variable::kPinned_Flag;
+    return true;
+}
+
 SkRuntimeEffect::SpecializeResult
 SkRuntimeEffect::specialize(SkSL::Program& baseProgram,
                             const void* inputs,
                             const SkSL::SharedCompiler& compiler) const {
     std::unordered_map<SkSL::String, SkSL::Program::Settings::Value> inputMap;
     for (const auto& v : fInAndUniformVars) {
-        if (v.fQualifier != Variable::Qualifier::kIn) {
+        if (v.fQualifier != Variable::Qualifier::kIn && !(v.fFlags & Variable::kPinned_Flag)) {
             continue;
         }
-        // 'in' arrays are not supported
+        // 'in' arrays are not supported, and pinned uniforms are never arrays
         SkASSERT(!v.isArray());
         SkSL::String name(v.fName.c_str(), v.fName.size());
         switch (v.fType) {
@@ -381,9 +442,16 @@ bool SkRuntimeEffect::toPipelineStage(const void* inputs, const GrShaderCaps* sh
     SkSL::Program::Settings settings;
     settings.fCaps = shaderCaps;
 
-    auto baseProgram = compiler->convertProgram(SkSL::Program::kPipelineStage_Kind,
-                                                SkSL::String(fSkSL.c_str(), fSkSL.size()),
-                                                settings);
+    std::unique_ptr<SkSL::Program> baseProgram;
+    if (fDehydrated) {
+        baseProgram = compiler->rehydrateProgram(SkSL::Program::kPipelineStage_Kind,
+                                                 fDehydrated->bytes(), fDehydrated->size(),
+                                                 settings);
+    } else {
+        baseProgram = compiler->convertProgram(SkSL::Program::kPipelineStage_Kind,
+                                               SkSL::String(fSkSL.c_str(), fSkSL.size()),
+                                               settings);
+    }
     if (!baseProgram) {
         errorHandler->compileError(fSkSL.c_str(), compiler->errorText().c_str());
         return false;
@@ -716,8 +784,79 @@ public:
         return fByteCode.get();
     }
 
+    // Lazily JIT the effect through skvm: one program evaluating main() on planar float
+    // channels, shared by every raster draw of this filter.
+    const skvm::Program* vmProgram() const {
+        SkAutoMutexExclusive ama(fVMMutex);
+        if (!fVMProgram && !fVMFailed) {
+            skvm::Builder builder;
+            skvm::Uniforms uniforms(0);
+            SkSTArenaAlloc<256> alloc;
+
+            // skvm::Uniforms assumes the uniform pointer is argument 0, so create it first.
+            SkAssertResult(builder.uniform().ix == uniforms.base.ix);
+            skvm::Arg rPtr = builder.varying<float>(),
+                      gPtr = builder.varying<float>(),
+                      bPtr = builder.varying<float>(),
+                      aPtr = builder.varying<float>();
+
+            skvm::Color c = { builder.loadF(rPtr), builder.loadF(gPtr),
+                              builder.loadF(bPtr), builder.loadF(aPtr) };
+            // dstCS is ignored by our onProgram(), so the program is valid for any dst.
+            c = this->program(&builder, c, /*dstCS=*/nullptr, &uniforms, &alloc);
+            if (c) {
+                builder.storeF(rPtr, c.r);
+                builder.storeF(gPtr, c.g);
+                builder.storeF(bPtr, c.b);
+                builder.storeF(aPtr, c.a);
+                fVMUniforms = std::move(uniforms.buf);
+                fVMProgram = std::make_unique<skvm::Program>(
+                        builder.done("SkRuntimeColorFilter"));
+            } else {
+                fVMFailed = true;
+            }
+        }
+        return fVMProgram.get();
+    }
+
     bool onAppendStages(const SkStageRec& rec, bool shaderIsOpaque) const override {
-        return false;
+        // Run the JITted program from a callback stage. This keeps otherwise pipeline-friendly
+        // paints on the raster pipeline rather than failing the whole draw over to the SkVM
+        // blitter, and it is what makes filterColor4f() evaluate the effect at all.
+        const skvm::Program* program = this->vmProgram();
+        if (!program) {
+            return false;
+        }
+
+        struct CallbackCtx : SkRasterPipeline_CallbackCtx {
+            const skvm::Program* program;
+            const int*           uniforms;
+        };
+        auto* cb = rec.fAlloc->make<CallbackCtx>();
+        cb->program  = program;
+        cb->uniforms = fVMUniforms.data();
+        cb->fn = [](SkRasterPipeline_CallbackCtx* self, int active_pixels) {
+            auto c = (CallbackCtx*)self;
+            // The program works on planar channels; transpose in and out of the callback's
+            // interleaved rgba.
+            float r[SkRasterPipeline_kMaxStride], g[SkRasterPipeline_kMaxStride],
+                  b[SkRasterPipeline_kMaxStride], a[SkRasterPipeline_kMaxStride];
+            for (int i = 0; i < active_pixels; i++) {
+                r[i] = c->rgba[4*i+0];
+                g[i] = c->rgba[4*i+1];
+                b[i] = c->rgba[4*i+2];
+                a[i] = c->rgba[4*i+3];
+            }
+            c->program->eval(active_pixels, const_cast<int*>(c->uniforms), r, g, b, a);
+            for (int i = 0; i < active_pixels; i++) {
+                c->rgba[4*i+0] = r[i];
+                c->rgba[4*i+1] = g[i];
+                c->rgba[4*i+2] = b[i];
+                c->rgba[4*i+3] = a[i];
+            }
+        };
+        rec.fPipeline->append(SkRasterPipeline::callback, cb);
+        return true;
     }
 
     skvm::Color onProgram(skvm::Builder* p, skvm::Color c,
@@ -768,6 +907,11 @@ private:
 
     mutable SkMutex fByteCodeMutex;
     mutable std::unique_ptr<SkSL::ByteCode> fByteCode;
+
+    mutable SkMutex fVMMutex;
+    mutable std::unique_ptr<skvm::Program> fVMProgram;
+    mutable std::vector<int> fVMUniforms;
+    mutable bool fVMFailed = false;  // don't recompile a failing effect on every draw
 };
 
 sk_sp<SkFlattenable> SkRuntimeColorFilter::CreateProc(SkReadBuffer& buffer) {
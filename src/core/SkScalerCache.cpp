@@ -83,14 +83,34 @@ std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::internalPrepare(
         SkSpan<const SkGlyphID> glyphIDs, PathDetail pathDetail, const SkGlyph** results) {
     const SkGlyph** cursor = results;
     size_t delta = 0;
+
+    // Gather the glyphs that are not in the cache yet, and fill their metrics
+    // with one batch call; ports can amortize per-call setup (face locking,
+    // size selection) over the whole run.
+    SkAutoSTArray<64, SkGlyph*> missing{SkToInt(glyphIDs.size())};
+    int missingCount = 0;
     for (auto glyphID : glyphIDs) {
-        auto [glyph, size] = this->glyph(SkPackedGlyphID{glyphID});
-        delta += size;
-        if (pathDetail == kMetricsAndPath) {
+        SkPackedGlyphID packedGlyphID{glyphID};
+        SkGlyph* glyph = fGlyphMap.findOrNull(packedGlyphID);
+        if (glyph == nullptr) {
+            size_t size;
+            std::tie(glyph, size) = this->makeGlyph(packedGlyphID);
+            delta += size;
+            missing[missingCount++] = glyph;
+        }
+        *cursor++ = glyph;
+    }
+
+    if (missingCount > 0) {
+        fScalerContext->getMetricsBatch({missing.get(), SkToSizeT(missingCount)});
+    }
+
+    if (pathDetail == kMetricsAndPath) {
+        for (auto glyphID : glyphIDs) {
+            SkGlyph* glyph = fGlyphMap.findOrNull(SkPackedGlyphID{glyphID});
             auto [_, pathSize] = this->preparePath(glyph);
             delta += pathSize;
         }
-        *cursor++ = glyph;
     }
 
     return {{results, glyphIDs.size()}, delta};
@@ -99,7 +119,7 @@ std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::internalPrepare(
 std::tuple<const void*, size_t> SkScalerCache::prepareImage(SkGlyph* glyph) {
     size_t delta = 0;
     if (glyph->setImage(&fAlloc, fScalerContext.get())) {
-        delta = glyph->imageSize();
+        delta = glyph->imageStorageSize();
     }
     return {glyph->image(), delta};
 }
@@ -114,7 +134,7 @@ std::tuple<SkGlyph*, size_t> SkScalerCache::mergeGlyphAndImage(
         std::tie(glyph, delta) = this->makeGlyph(toID);
     }
     if (glyph->setMetricsAndImage(&fAlloc, from)) {
-        imageDelta= glyph->imageSize();
+        imageDelta= glyph->imageStorageSize();
     }
     return {glyph, delta + imageDelta};
 }
@@ -186,7 +186,34 @@ void SkScalerContext::getAdvance(SkGlyph* glyph) {
     }
 }
 
+bool SkScalerContext::wantsSDF() const {
+    return fMaskFilter && as_MFB(fMaskFilter)->getFormat() == SkMask::kSDF_Format;
+}
+
+bool SkScalerContext::internalGetSDFMetrics(SkGlyph* glyph) {
+    if (!this->wantsSDF()) {
+        return false;
+    }
+    if (!this->generateSDFMetrics(glyph)) {
+        return false;
+    }
+    glyph->fMaskFormat = SkMask::kSDF_Format;
+    // if either dimension is empty, zap the image bounds of the glyph
+    if (0 == glyph->fWidth || 0 == glyph->fHeight) {
+        glyph->fWidth   = 0;
+        glyph->fHeight  = 0;
+        glyph->fTop     = 0;
+        glyph->fLeft    = 0;
+        glyph->fMaskFormat = 0;
+    }
+    return true;
+}
+
 void SkScalerContext::getMetrics(SkGlyph* glyph) {
+    if (this->internalGetSDFMetrics(glyph)) {
+        return;
+    }
+
     bool generatingImageFromPath = fGenerateImageFromPath;
     if (!generatingImageFromPath) {
         generateMetrics(glyph);
@@ -216,7 +243,8 @@ void SkScalerContext::getMetrics(SkGlyph* glyph) {
 
             const SkIRect ir = devPath.getBounds().roundOut();
             if (ir.isEmpty() || !SkRectPriv::Is16Bit(ir)) {
-                goto SK_ERROR;
+                this->finishMetrics(glyph, true);
+                return;
             }
             glyph->fLeft    = ir.fLeft;
             glyph->fTop     = ir.fTop;
@@ -241,39 +269,76 @@ void SkScalerContext::getMetrics(SkGlyph* glyph) {
         }
     }
 
-    // if either dimension is empty, zap the image bounds of the glyph
-    if (0 == glyph->fWidth || 0 == glyph->fHeight) {
-        glyph->fWidth   = 0;
-        glyph->fHeight  = 0;
-        glyph->fTop     = 0;
-        glyph->fLeft    = 0;
-        glyph->fMaskFormat = 0;
+    this->finishMetrics(glyph, false);
+}
+
+void SkScalerContext::getMetricsBatch(SkSpan<SkGlyph*> glyphs) {
+    if (fGenerateImageFromPath || this->wantsSDF()) {
+        // The path-driven flow in getMetrics is inherently one glyph at a time,
+        // and a precomputed distance field may only cover some of the glyphs.
+        for (SkGlyph* glyph : glyphs) {
+            this->getMetrics(glyph);
+        }
         return;
     }
 
-    if (fMaskFilter) {
-        SkMask      src = glyph->mask(),
-                    dst;
-        SkMatrix    matrix;
+    this->generateMetricsBatch(glyphs);
+    for (SkGlyph* glyph : glyphs) {
+        SkASSERT(glyph->fMaskFormat != MASK_FORMAT_UNKNOWN);
+        this->finishMetrics(glyph, false);
+    }
+}
 
-        fRec.getMatrixFrom2x2(&matrix);
+void SkScalerContext::generateMetricsBatch(SkSpan<SkGlyph*> glyphs) {
+    for (SkGlyph* glyph : glyphs) {
+        this->generateMetrics(glyph);
+    }
+}
 
-        src.fImage = nullptr;  // only want the bounds from the filter
-        if (as_MFB(fMaskFilter)->filterMask(&dst, src, matrix, nullptr)) {
-            if (dst.fBounds.isEmpty() || !SkRectPriv::Is16Bit(dst.fBounds)) {
-                goto SK_ERROR;
+bool SkScalerContext::generateSDFMetrics(SkGlyph*) {
+    return false;
+}
+
+void SkScalerContext::generateSDFImage(const SkGlyph&) {}
+
+void SkScalerContext::finishMetrics(SkGlyph* glyph, bool error) {
+    if (!error) {
+        // if either dimension is empty, zap the image bounds of the glyph
+        if (0 == glyph->fWidth || 0 == glyph->fHeight) {
+            glyph->fWidth   = 0;
+            glyph->fHeight  = 0;
+            glyph->fTop     = 0;
+            glyph->fLeft    = 0;
+            glyph->fMaskFormat = 0;
+            return;
+        }
+
+        if (fMaskFilter) {
+            SkMask      src = glyph->mask(),
+                        dst;
+            SkMatrix    matrix;
+
+            fRec.getMatrixFrom2x2(&matrix);
+
+            src.fImage = nullptr;  // only want the bounds from the filter
+            if (as_MFB(fMaskFilter)->filterMask(&dst, src, matrix, nullptr)) {
+                if (dst.fBounds.isEmpty() || !SkRectPriv::Is16Bit(dst.fBounds)) {
+                    error = true;
+                } else {
+                    SkASSERT(dst.fImage == nullptr);
+                    glyph->fLeft    = dst.fBounds.fLeft;
+                    glyph->fTop     = dst.fBounds.fTop;
+                    glyph->fWidth   = SkToU16(dst.fBounds.width());
+                    glyph->fHeight  = SkToU16(dst.fBounds.height());
+                    glyph->fMaskFormat = dst.fFormat;
+                }
             }
-            SkASSERT(dst.fImage == nullptr);
-            glyph->fLeft    = dst.fBounds.fLeft;
-            glyph->fTop     = dst.fBounds.fTop;
-            glyph->fWidth   = SkToU16(dst.fBounds.width());
-            glyph->fHeight  = SkToU16(dst.fBounds.height());
-            glyph->fMaskFormat = dst.fFormat;
+        }
+        if (!error) {
+            return;
         }
     }
-    return;
 
-SK_ERROR:
     // draw nothing 'cause we failed
     glyph->fLeft     = 0;
     glyph->fTop      = 0;
@@ -541,6 +606,17 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
     // (i.e. larger) than what our caller allocated by looking at origGlyph.
     SkAutoMalloc tmpGlyphImageStorage;
 
+    if (this->wantsSDF()) {
+        // A baked distance field needs no prefilter image and no conversion.
+        SkGlyph sdfGlyph{origGlyph.getPackedID()};
+        if (this->internalGetSDFMetrics(&sdfGlyph)) {
+            SkASSERT(sdfGlyph.fWidth == origGlyph.fWidth);
+            SkASSERT(sdfGlyph.fHeight == origGlyph.fHeight);
+            this->generateSDFImage(origGlyph);
+            return;
+        }
+    }
+
     if (fMaskFilter) {   // restore the prefilter bounds
 
         // need the original bounds, sans our maskfilter
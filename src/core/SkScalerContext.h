@@ -20,6 +20,7 @@
 #include "src/core/SkGlyph.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMaskGamma.h"
+#include "src/core/SkSpan.h"
 #include "src/core/SkStrikeForGPU.h"
 #include "src/core/SkSurfacePriv.h"
 #include "src/core/SkWriteBuffer.h"
@@ -286,6 +287,7 @@ public:
     unsigned    getGlyphCount() { return this->generateGlyphCount(); }
     void        getAdvance(SkGlyph*);
     void        getMetrics(SkGlyph*);
+    void        getMetricsBatch(SkSpan<SkGlyph*> glyphs);
     void        getImage(const SkGlyph&);
     bool SK_WARN_UNUSED_RESULT getPath(SkPackedGlyphID, SkPath*);
     void        getFontMetrics(SkFontMetrics*);
@@ -376,6 +378,13 @@ protected:
      */
     virtual void generateMetrics(SkGlyph* glyph) = 0;
 
+    /** Generates metrics for a whole run of glyphs with one call, so that
+     *  ports can amortize per-call setup such as face locking and size
+     *  selection. The default implementation just calls generateMetrics for
+     *  each glyph.
+     */
+    virtual void generateMetricsBatch(SkSpan<SkGlyph*> glyphs);
+
     /** Generates the contents of glyph.fImage.
      *  When called, glyph.fImage will be pointing to a pre-allocated,
      *  uninitialized region of memory of size glyph.imageSize().
@@ -387,6 +396,21 @@ protected:
      */
     virtual void generateImage(const SkGlyph& glyph) = 0;
 
+    /** Reports the device-space bounds of a signed distance field the font carries
+     *  precomputed for this glyph (including the SK_DistanceFieldPad border) and sets
+     *  the glyph's advances. When true is returned and the scaler is converting masks
+     *  to distance fields, getMetrics and getImage bypass the runtime conversion and
+     *  the rasterization feeding it; getImage calls generateSDFImage instead.
+     *  The default implementation reports no precomputed data.
+     */
+    virtual bool generateSDFMetrics(SkGlyph* glyph);
+
+    /** Copies the precomputed distance field into glyph.fImage, which points at
+     *  glyph.imageSize() bytes sized by the bounds from generateSDFMetrics.
+     *  Only called when generateSDFMetrics returned true for the same glyph.
+     */
+    virtual void generateSDFImage(const SkGlyph& glyph);
+
     /** Sets the passed path to the glyph outline.
      *  If this cannot be done the path is set to empty;
      *  @return false if this glyph does not have any path.
@@ -423,6 +447,17 @@ private:
     /** Returns false if the glyph has no path at all. */
     bool internalGetPath(SkPackedGlyphID id, SkPath* devPath);
 
+    // The mask-filter and empty-bounds fixups shared by getMetrics and
+    // getMetricsBatch; error selects the draw-nothing epilogue.
+    void finishMetrics(SkGlyph* glyph, bool error);
+
+    // True when the mask filter converts masks to signed distance fields.
+    bool wantsSDF() const;
+
+    // True and the glyph's metrics are filled in when the mask filter is a
+    // distance-field conversion and the font has the result precomputed.
+    bool internalGetSDFMetrics(SkGlyph* glyph);
+
     // SkMaskGamma::PreBlend converts linear masks to gamma correcting masks.
 protected:
     // Visible to subclasses so that generateImage can apply the pre-blend directly.
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkScanAAATuning_DEFINED
+#define SkScanAAATuning_DEFINED
+
+#include "include/core/SkScalar.h"
+
+/**
+ *  Measured crossover thresholds for the analytic-AA decision in
+ *  SkScan::AntiFillPath.
+ *
+ *  The numbers below are regenerated from bench/ScanStrategyBench.cpp, which
+ *  times supersampled and analytic AA head-to-head over a grid of path
+ *  complexities (run with --benchType scanstrategy on the target machine and
+ *  take the crossover of the saa/aaa pairs). They are compile-time per
+ *  architecture rather than runtime-dispatched because the decision is made
+ *  deep in SkScan where we don't consult SkOpts, and the crossover moves with
+ *  the ISA (wider SIMD speeds up the supersampler's blits more than the
+ *  analytic edge walk), not with the individual core.
+ *
+ *  SkScanAAATuning::kComplexityThreshold
+ *      Analytic AA is used while compute_complexity() stays below this, i.e.
+ *      while the expected number of edge intersections per scanline is small.
+ *
+ *  SkScanAAATuning::kPointsPerHeight
+ *      Analytic AA is rejected once countPoints() >= kPointsPerHeight * the
+ *      path bounds' height; past that the analytic scan has too many
+ *      y-breakpoints per pixel row to pay off (see skbug.com/8272).
+ */
+struct SkScanAAATuning {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // haswell+ (2020-09)
+    static constexpr SkScalar kComplexityThreshold = 0.5;
+    static constexpr SkScalar kPointsPerHeight     = 1.5;
+#elif defined(SK_ARM_HAS_NEON)
+    // cortex-a76 (2020-09)
+    static constexpr SkScalar kComplexityThreshold = 0.3;
+    static constexpr SkScalar kPointsPerHeight     = 1.0;
+#else
+    // historical defaults, unmeasured
+    static constexpr SkScalar kComplexityThreshold = 0.25;
+    static constexpr SkScalar kPointsPerHeight     = 1.0;
+#endif
+};
+
+#endif
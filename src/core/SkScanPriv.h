@@ -11,6 +11,10 @@
 #include "include/core/SkPath.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkScan.h"
+#include "src/core/SkTSort.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
 
 // controls how much we super-sample (when we use that scan convertion)
 #define SK_SUPERSAMPLE_SHIFT    2
@@ -80,6 +84,39 @@ static EdgeType* backward_insert_start(EdgeType* prev, SkFixed x) {
     return prev;
 }
 
+// Sort a large edge-pointer list by SkTQSort-ing fixed-size chunks as tasks
+// on the default executor, then merging.  Huge paths (tens of thousands of
+// segments) otherwise serialize entirely behind this sort before the first
+// scanline blits.  With no thread pool installed, SkTaskGroup runs the chunks
+// inline and this degenerates to a plain chunked sort, so small counts skip
+// straight to one SkTQSort.
+template<class EdgeType>
+static void sort_edge_list(EdgeType* list[], int count) {
+    constexpr int kParallelSortCutoff = 8192;
+    if (count < kParallelSortCutoff) {
+        SkTQSort(list, list + count);
+        return;
+    }
+
+    constexpr int kChunks = 8;
+    const int chunk = (count + kChunks - 1) / kChunks;
+    {
+        SkTaskGroup group;
+        for (int start = 0; start < count; start += chunk) {
+            const int end = std::min(start + chunk, count);
+            group.add([list, start, end] { SkTQSort(list + start, list + end); });
+        }
+    }   // ~SkTaskGroup() waits for all the chunk sorts.
+
+    for (int size = chunk; size < count; size *= 2) {
+        for (int start = 0; start + size < count; start += 2*size) {
+            std::inplace_merge(list + start, list + start + size,
+                               list + std::min(start + 2*size, count),
+                               [](const EdgeType* a, const EdgeType* b) { return *a < *b; });
+        }
+    }
+}
+
 // Check if the path is a rect and fat enough after clipping; if so, blit it.
 static inline bool TryBlitFatAntiRect(SkBlitter* blitter, const SkPath& path, const SkIRect& clip) {
     SkRect rect;
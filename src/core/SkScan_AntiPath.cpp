@@ -14,6 +14,7 @@
 #include "src/core/SkAntiRun.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkScanAAATuning.h"
 
 #define SHIFT   SK_SUPERSAMPLE_SHIFT
 #define SCALE   (1 << SHIFT)
@@ -599,9 +600,6 @@ static SkIRect safeRoundOut(const SkRect& src) {
 }
 
 constexpr int kSampleSize = 8;
-#if !defined(SK_DISABLE_AAA)
-    constexpr SkScalar kComplexityThreshold = 0.25;
-#endif
 
 static void compute_complexity(const SkPath& path, SkScalar& avgLength, SkScalar& complexity) {
     int n = path.countPoints();
@@ -660,14 +658,15 @@ static bool ShouldUseAAA(const SkPath& path, SkScalar avgLength, SkScalar comple
         // and Analytic AA might be slower than supersampling.
         return path.countPoints() < std::max(bounds.width(), bounds.height()) / 2 - 10;
     #else
-        if (path.countPoints() >= path.getBounds().height()) {
+        if (path.countPoints() >=
+                SkScanAAATuning::kPointsPerHeight * path.getBounds().height()) {
             // SAA is faster than AAA in this case even if there are no
             // intersections because AAA will have too many scan lines. See
             // skbug.com/8272
             return false;
         }
         // We will use AAA if the number of verbs < kSampleSize and therefore complexity < 0
-        return complexity < kComplexityThreshold;
+        return complexity < SkScanAAATuning::kComplexityThreshold;
     #endif
 #endif
 }
@@ -379,7 +379,7 @@ static bool operator<(const SkEdge& a, const SkEdge& b) {
 }
 
 static SkEdge* sort_edges(SkEdge* list[], int count, SkEdge** last) {
-    SkTQSort(list, list + count);
+    sort_edge_list(list, count);
 
     // now make the edges linked in sorted order
     for (int i = 1; i < count; i++) {
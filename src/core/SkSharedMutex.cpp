@@ -9,6 +9,7 @@
 
 #include "include/core/SkTypes.h"
 #include "include/private/SkSemaphore.h"
+#include "src/core/SkCounters.h"
 
 #if !defined(__has_feature)
     #define __has_feature(x) 0
@@ -356,3 +357,90 @@
     }
 
 #endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SK_DEBUG
+
+    void SkDistributedSharedMutex::acquire() { fImpl.acquire(); }
+    void SkDistributedSharedMutex::release() { fImpl.release(); }
+    void SkDistributedSharedMutex::assertHeld() const { fImpl.assertHeld(); }
+    void SkDistributedSharedMutex::acquireShared() { fImpl.acquireShared(); }
+    void SkDistributedSharedMutex::releaseShared() { fImpl.releaseShared(); }
+    void SkDistributedSharedMutex::assertHeldShared() const { fImpl.assertHeldShared(); }
+
+#else
+
+    // Each thread is assigned one of the reader slots once, round-robin, so a thread always
+    // acquires and releases through the same slot. The seq_cst ordering on the slot counts and
+    // fWriterActive is the usual Dekker pairing: a reader must see the writer's gate if its
+    // increment didn't precede the writer's drain scan, and vice versa.
+    static uint32_t thread_slot_id() {
+        static std::atomic<uint32_t> nextSlot{0};
+        static thread_local uint32_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    void SkDistributedSharedMutex::acquireShared() {
+        Slot& slot = fSlots[thread_slot_id() % kReaderSlots];
+        for (;;) {
+            slot.fCount.fetch_add(1, std::memory_order_seq_cst);
+            if (!fWriterActive.load(std::memory_order_seq_cst)) {
+                ANNOTATE_RWLOCK_ACQUIRED(this, 0);
+                return;
+            }
+
+            // A writer is draining readers; undo our increment (waking the writer if we were
+            // the last reader on this slot) and wait for the writer to finish.
+            if (slot.fCount.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+                fWriterQueue.signal();
+            }
+            SK_COUNTER_INCREMENT("sharedmutex_reader_contention");
+            fWaitingReaders.fetch_add(1, std::memory_order_seq_cst);
+            if (fWriterActive.load(std::memory_order_seq_cst)) {
+                fReaderQueue.wait();
+            }
+            // If the gate dropped before we could wait, our registration may produce one
+            // surplus wakeup, which just sends another looping reader around again.
+        }
+    }
+
+    void SkDistributedSharedMutex::releaseShared() {
+        ANNOTATE_RWLOCK_RELEASED(this, 0);
+        Slot& slot = fSlots[thread_slot_id() % kReaderSlots];
+        if (slot.fCount.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+            fWriterActive.load(std::memory_order_seq_cst)) {
+            fWriterQueue.signal();
+        }
+    }
+
+    void SkDistributedSharedMutex::acquire() {
+        fWriterSerialize.acquire();
+        fWriterActive.store(true, std::memory_order_seq_cst);
+
+        bool contended = false;
+        for (Slot& slot : fSlots) {
+            while (slot.fCount.load(std::memory_order_seq_cst) != 0) {
+                contended = true;
+                // Readers signal on any slot reaching zero, so a stale token can wake us
+                // early; the loop re-checks this slot's count either way.
+                fWriterQueue.wait();
+            }
+        }
+        if (contended) {
+            SK_COUNTER_INCREMENT("sharedmutex_writer_contention");
+        }
+        ANNOTATE_RWLOCK_ACQUIRED(this, 1);
+    }
+
+    void SkDistributedSharedMutex::release() {
+        ANNOTATE_RWLOCK_RELEASED(this, 1);
+        fWriterActive.store(false, std::memory_order_seq_cst);
+        int32_t waiters = fWaitingReaders.exchange(0, std::memory_order_seq_cst);
+        if (waiters > 0) {
+            fReaderQueue.signal(waiters);
+        }
+        fWriterSerialize.release();
+    }
+
+#endif  // SK_DEBUG
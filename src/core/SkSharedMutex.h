@@ -10,12 +10,12 @@
 
 #include "include/core/SkTypes.h"
 #include "include/private/SkMacros.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkSemaphore.h"
 #include "include/private/SkThreadAnnotations.h"
 #include <atomic>
 
 #ifdef SK_DEBUG
-    #include "include/private/SkMutex.h"
     #include <memory>
 #endif  // SK_DEBUG
 
@@ -71,21 +71,76 @@ inline void SkSharedMutex::assertHeld() const {};
 inline void SkSharedMutex::assertHeldShared() const {};
 #endif  // SK_DEBUG
 
+// A shared lock for long-lived, read-mostly data (e.g. typeface tables). acquireShared()
+// increments a cacheline-padded per-thread slot instead of SkSharedMutex's single packed count,
+// so concurrent readers on different cores do not ping-pong one cacheline. The trade-off is that
+// writers must raise a gate and drain every slot, making exclusive acquisition considerably more
+// expensive; prefer SkSharedMutex when writes are common. A thread must release a shared lock on
+// the same thread that acquired it (the usual RAII pattern), since release targets the acquiring
+// thread's slot.
+//
+// Debug builds delegate to SkSharedMutex for its thread-ownership checking.
+class SK_CAPABILITY("mutex") SkDistributedSharedMutex {
+public:
+    SkDistributedSharedMutex() = default;
+
+    // Acquire lock for exclusive use.
+    void acquire() SK_ACQUIRE();
+
+    // Release lock for exclusive use.
+    void release() SK_RELEASE_CAPABILITY();
+
+    // Fail if exclusive is not held.
+    void assertHeld() const SK_ASSERT_CAPABILITY(this);
+
+    // Acquire lock for shared use.
+    void acquireShared() SK_ACQUIRE_SHARED();
+
+    // Release lock for shared use.
+    void releaseShared() SK_RELEASE_SHARED_CAPABILITY();
+
+    // Fail if shared lock not held.
+    void assertHeldShared() const SK_ASSERT_SHARED_CAPABILITY(this);
+
+private:
+#ifdef SK_DEBUG
+    SkSharedMutex fImpl;
+#else
+    static constexpr int kReaderSlots = 8;
+    struct Slot {
+        alignas(64) std::atomic<int32_t> fCount{0};
+    };
+    Slot                 fSlots[kReaderSlots];
+    std::atomic<bool>    fWriterActive{false};
+    std::atomic<int32_t> fWaitingReaders{0};
+    SkSemaphore          fReaderQueue;
+    SkSemaphore          fWriterQueue;
+    SkMutex              fWriterSerialize;
+#endif  // SK_DEBUG
+};
+
+#ifndef SK_DEBUG
+inline void SkDistributedSharedMutex::assertHeld() const {};
+inline void SkDistributedSharedMutex::assertHeldShared() const {};
+#endif  // SK_DEBUG
+
+template <typename Lock>
 class SK_SCOPED_CAPABILITY SkAutoSharedMutexExclusive {
 public:
-    explicit SkAutoSharedMutexExclusive(SkSharedMutex& lock) SK_ACQUIRE(lock)
+    explicit SkAutoSharedMutexExclusive(Lock& lock) SK_ACQUIRE(lock)
             : fLock(lock) {
         lock.acquire();
     }
     ~SkAutoSharedMutexExclusive() SK_RELEASE_CAPABILITY() { fLock.release(); }
 
 private:
-    SkSharedMutex& fLock;
+    Lock& fLock;
 };
 
+template <typename Lock>
 class SK_SCOPED_CAPABILITY SkAutoSharedMutexShared {
 public:
-    explicit SkAutoSharedMutexShared(SkSharedMutex& lock) SK_ACQUIRE_SHARED(lock)
+    explicit SkAutoSharedMutexShared(Lock& lock) SK_ACQUIRE_SHARED(lock)
             : fLock(lock)  {
         lock.acquireShared();
     }
@@ -96,7 +151,7 @@ public:
     ~SkAutoSharedMutexShared() SK_RELEASE_CAPABILITY() { fLock.releaseShared(); }
 
 private:
-    SkSharedMutex& fLock;
+    Lock& fLock;
 };
 
 #endif // SkSharedLock_DEFINED
@@ -265,16 +265,21 @@ static sk_sp<SkData> newFromParams(const void* src, size_t size, bool copyData)
 SkMemoryStream::SkMemoryStream() {
     fData = SkData::MakeEmpty();
     fOffset = 0;
+    fDataIsShared = true;
 }
 
 SkMemoryStream::SkMemoryStream(size_t size) {
     fData = SkData::MakeUninitialized(size);
     fOffset = 0;
+    fDataIsShared = true;
 }
 
 SkMemoryStream::SkMemoryStream(const void* src, size_t size, bool copyData) {
     fData = newFromParams(src, size, copyData);
     fOffset = 0;
+    // Without a copy, fData is a bare reference to the caller's memory, so it
+    // must not outlive the promise the caller made to this stream.
+    fDataIsShared = copyData;
 }
 
 SkMemoryStream::SkMemoryStream(sk_sp<SkData> data) : fData(std::move(data)) {
@@ -282,6 +287,7 @@ SkMemoryStream::SkMemoryStream(sk_sp<SkData> data) : fData(std::move(data)) {
         fData = SkData::MakeEmpty();
     }
     fOffset = 0;
+    fDataIsShared = true;
 }
 
 std::unique_ptr<SkMemoryStream> SkMemoryStream::MakeCopy(const void* data, size_t length) {
@@ -299,11 +305,13 @@ std::unique_ptr<SkMemoryStream> SkMemoryStream::Make(sk_sp<SkData> data) {
 void SkMemoryStream::setMemoryOwned(const void* src, size_t size) {
     fData = SkData::MakeFromMalloc(src, size);
     fOffset = 0;
+    fDataIsShared = true;
 }
 
 void SkMemoryStream::setMemory(const void* src, size_t size, bool copyData) {
     fData = newFromParams(src, size, copyData);
     fOffset = 0;
+    fDataIsShared = copyData;
 }
 
 void SkMemoryStream::setData(sk_sp<SkData> data) {
@@ -313,6 +321,11 @@ void SkMemoryStream::setData(sk_sp<SkData> data) {
         fData = data;
     }
     fOffset = 0;
+    fDataIsShared = true;
+}
+
+sk_sp<SkData> SkMemoryStream::getData() const {
+    return fDataIsShared ? fData : nullptr;
 }
 
 void SkMemoryStream::skipToAlign4() {
@@ -353,7 +366,10 @@ bool SkMemoryStream::rewind() {
 }
 
 SkMemoryStream* SkMemoryStream::onDuplicate() const {
-    return new SkMemoryStream(fData);
+    SkMemoryStream* that = new SkMemoryStream(fData);
+    // A duplicate of a bare-pointer stream is no safer to alias than we are.
+    that->fDataIsShared = fDataIsShared;
+    return that;
 }
 
 size_t SkMemoryStream::getPosition() const {
@@ -689,16 +705,48 @@ bool SkDynamicMemoryWStream::writeToAndReset(SkWStream* dst) {
     return dstStreamGood;
 }
 
+// assumes context is a Block allocated with sk_malloc
+static void sk_block_releaseproc(const void*, void* context) {
+    sk_free(context);
+}
+
 sk_sp<SkData> SkDynamicMemoryWStream::detachAsData() {
     const size_t size = this->bytesWritten();
     if (0 == size) {
         return SkData::MakeEmpty();
     }
+    if (fHead == fTail) {  // one block: adopt it rather than copying, trimming the unused tail.
+        SkASSERT(0 == fBytesWrittenBeforeTail);
+        ptrdiff_t used = fTail->fCurr - (char*)fTail;
+        Block* block = (Block*)sk_realloc_throw(fTail, SkToSizeT(used));
+        fHead = fTail = nullptr;
+        return SkData::MakeWithProc(block->start(), size, sk_block_releaseproc, block);
+    }
     sk_sp<SkData> data = SkData::MakeUninitialized(size);
     this->copyToAndReset(data->writable_data());
     return data;
 }
 
+std::vector<sk_sp<SkData>> SkDynamicMemoryWStream::detachAsSegments() {
+    this->validate();
+    std::vector<sk_sp<SkData>> segments;
+    Block* block = fHead;
+    fHead = fTail = nullptr;
+    fBytesWrittenBeforeTail = 0;
+    while (block != nullptr) {
+        Block* next = block->fNext;
+        const size_t written = block->written();
+        if (written > 0) {
+            segments.push_back(SkData::MakeWithProc(block->start(), written,
+                                                    sk_block_releaseproc, block));
+        } else {
+            sk_free(block);
+        }
+        block = next;
+    }
+    return segments;
+}
+
 #ifdef SK_DEBUG
 void SkDynamicMemoryWStream::validate() const {
     if (!fHead) {
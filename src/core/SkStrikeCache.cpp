@@ -31,16 +31,72 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
     return cache;
 }
 
+namespace {
+// A tiny per-thread MRU of recently used strikes, consulted before taking the
+// global spinlock. Multi-threaded text layout tends to reuse a handful of
+// strikes per thread, so most findOrCreateStrike calls can return without ever
+// contending on fLock; the strike's own SkScalerCache mutex still serializes
+// glyph work within the strike. Entries hold a ref, so a strike purged from
+// the main cache stays usable here; the purge generation check below drops
+// those refs at the next lookup, which bounds how long they can linger.
+struct ThreadStrike {
+    sk_sp<SkStrike> fStrike;
+    uint32_t        fGeneration = 0;
+};
+constexpr int kPerThreadStrikeCount = 4;
+}  // namespace
+
 auto SkStrikeCache::findOrCreateStrike(const SkDescriptor& desc,
                                        const SkScalerContextEffects& effects,
                                        const SkTypeface& typeface) -> sk_sp<Strike> {
-    SkAutoSpinlock ac(fLock);
-    sk_sp<Strike> strike = this->internalFindStrikeOrNull(desc);
-    if (strike == nullptr) {
-        auto scaler = typeface.createScalerContext(effects, &desc);
-        strike = this->internalCreateStrike(desc, std::move(scaler));
+    ThreadStrike* threadStrikes = nullptr;
+#if !defined(SK_BUILD_FOR_IOS)
+    // Only the global cache gets the per-thread fast path: its lifetime is the
+    // process, so a cached strike can never outlive the cache it points back
+    // into. (With the thread-local-caches experiment above, "global" is this
+    // thread's cache, which is just as safe.)
+    if (this == GlobalStrikeCache()) {
+        static thread_local ThreadStrike perThreadStrikes[kPerThreadStrikeCount];
+        threadStrikes = perThreadStrikes;
+
+        const uint32_t generation = fPurgeGeneration.load(std::memory_order_acquire);
+        for (int i = 0; i < kPerThreadStrikeCount; ++i) {
+            ThreadStrike& entry = threadStrikes[i];
+            if (entry.fStrike == nullptr) {
+                continue;
+            }
+            if (entry.fGeneration != generation) {
+                entry.fStrike.reset();
+            } else if (entry.fStrike->getDescriptor() == desc) {
+                sk_sp<Strike> strike = entry.fStrike;
+                // Make most recently used.
+                for (int j = i; j > 0; --j) {
+                    threadStrikes[j] = std::move(threadStrikes[j - 1]);
+                }
+                threadStrikes[0] = {strike, generation};
+                return strike;
+            }
+        }
+    }
+#endif
+
+    sk_sp<Strike> strike;
+    {
+        SkAutoSpinlock ac(fLock);
+        strike = this->internalFindStrikeOrNull(desc);
+        if (strike == nullptr) {
+            auto scaler = typeface.createScalerContext(effects, &desc);
+            strike = this->internalCreateStrike(desc, std::move(scaler));
+        }
+        this->internalPurge();
+    }
+
+    if (threadStrikes != nullptr) {
+        for (int j = kPerThreadStrikeCount - 1; j > 0; --j) {
+            threadStrikes[j] = std::move(threadStrikes[j - 1]);
+        }
+        threadStrikes[0] = {strike, fPurgeGeneration.load(std::memory_order_acquire)};
     }
-    this->internalPurge();
     return strike;
 }
 
@@ -287,6 +343,11 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
         strike = prev;
     }
 
+    if (countFreed != 0) {
+        // Invalidate the per-thread lookup caches so their refs go away.
+        fPurgeGeneration.fetch_add(1, std::memory_order_release);
+    }
+
     this->validate();
 
 #ifdef SPEW_PURGE_STATUS
@@ -225,6 +225,11 @@ private:
     int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
     int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
     int32_t fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
+
+    // Bumped whenever internalPurge removes strikes, so the per-thread lookup
+    // caches in findOrCreateStrike drop their refs and purged memory can
+    // actually be released.
+    std::atomic<uint32_t> fPurgeGeneration{0};
 };
 
 using SkStrike = SkStrikeCache::Strike;
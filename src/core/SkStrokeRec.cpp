@@ -6,7 +6,11 @@
  */
 
 #include "include/core/SkStrokeRec.h"
+#include "include/private/SkFloatBits.h"
+#include "include/private/SkIDChangeListener.h"
 #include "src/core/SkPaintDefaults.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
 
 // must be < 0, since ==0 means hairline, and >0 means normal stroke
 #define kStrokeRec_FillStyleWidth     (-SK_Scalar1)
@@ -102,6 +106,103 @@ void SkStrokeRec::setStrokeStyle(SkScalar width, bool strokeAndFill) {
     SkScalar gDebugStrokerError;
 #endif
 
+namespace {
+
+// This creates a domain of keys in SkResourceCache used by this file.
+static void* kNamespace;
+
+struct StrokedPathKey : public SkResourceCache::Key {
+public:
+    StrokedPathKey(uint32_t genID, SkScalar width, SkScalar miterLimit, SkScalar resScale,
+                   unsigned cap, unsigned join, bool strokeAndFill)
+            : fGenID(genID)
+            , fWidthBits(SkFloat2Bits(width))
+            , fMiterLimitBits(SkFloat2Bits(miterLimit))
+            , fResScaleBits(SkFloat2Bits(resScale))
+            , fCapJoinAndFill(cap | (join << 8) | (strokeAndFill ? 1 << 16 : 0)) {
+        static const size_t kDataSize = sizeof(*this) - sizeof(SkResourceCache::Key);
+        this->init(&kNamespace, 0, kDataSize);
+    }
+
+    uint32_t fGenID;
+    uint32_t fWidthBits;
+    uint32_t fMiterLimitBits;
+    uint32_t fResScaleBits;
+    uint32_t fCapJoinAndFill;
+};
+
+class StrokedPathRec : public SkResourceCache::Rec {
+public:
+    StrokedPathRec(const StrokedPathKey& key, const SkPath& strokedPath)
+            : fKey(key), fStrokedPath(strokedPath) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(fKey) + fStrokedPath.approximateBytesUsed();
+    }
+    const char* getCategory() const override { return "stroked-path"; }
+
+    StrokedPathKey fKey;
+    SkPath fStrokedPath;
+};
+
+// When the SkPathRef genID changes, purge the corresponding cache entry.
+class StrokeInvalidator : public SkIDChangeListener {
+public:
+    StrokeInvalidator(const SkResourceCache::Key& key) {
+        fKey.reset(new uint8_t[key.size()]);
+        memcpy(fKey.get(), &key, key.size());
+    }
+
+private:
+    const SkResourceCache::Key& getKey() const {
+        return *reinterpret_cast<SkResourceCache::Key*>(fKey.get());
+    }
+
+    // always purge
+    static bool FindVisitor(const SkResourceCache::Rec&, void*) {
+        return false;
+    }
+
+    void changed() override {
+        SkResourceCache::Find(this->getKey(), StrokeInvalidator::FindVisitor, nullptr);
+    }
+
+    std::unique_ptr<uint8_t[]> fKey;
+};
+
+static bool stroked_path_find_visitor(const SkResourceCache::Rec& baseRec, void* ctx) {
+    const auto& rec = static_cast<const StrokedPathRec&>(baseRec);
+    *static_cast<SkPath*>(ctx) = rec.fStrokedPath;
+    return true;
+}
+
+// Clears the low 8 mantissa bits, for a relative error under 2^-15. This is far below the
+// stroker's own error tolerance, but it maps an animated stroke width or miter limit onto a
+// small set of cache keys instead of a new one per frame.
+static SkScalar quantize_stroke_scalar(SkScalar s) {
+    SkASSERT(SkScalarIsFinite(s));
+    return SkBits2Float(SkFloat2Bits(s) & ~0xFFu);
+}
+
+// Rounds up to a power of two, so a cached stroke is always at least as accurate as the one
+// that was requested.
+static SkScalar quantize_res_scale(SkScalar rs) {
+    SkScalar q = 1;
+    if (rs > 1) {
+        while (q < rs && q < 4096) {
+            q *= 2;
+        }
+    } else {
+        while (q * 0.5f >= rs && q > 1 / 256.f) {
+            q *= 0.5f;
+        }
+    }
+    return q;
+}
+
+}  // namespace
+
 bool SkStrokeRec::applyToPath(SkPath* dst, const SkPath& src) const {
     if (fWidth <= 0) {  // hairline or fill
         return false;
@@ -110,15 +211,49 @@ bool SkStrokeRec::applyToPath(SkPath* dst, const SkPath& src) const {
     SkStroke stroker;
     stroker.setCap((SkPaint::Cap)fCap);
     stroker.setJoin((SkPaint::Join)fJoin);
-    stroker.setMiterLimit(fMiterLimit);
-    stroker.setWidth(fWidth);
     stroker.setDoFill(fStrokeAndFill);
+
 #ifdef SK_DEBUG
-    stroker.setResScale(gDebugStrokerErrorSet ? gDebugStrokerError : fResScale);
-#else
-    stroker.setResScale(fResScale);
+    if (gDebugStrokerErrorSet) {
+        // Bypass the cache so the tweaked tolerance takes effect immediately.
+        stroker.setMiterLimit(fMiterLimit);
+        stroker.setWidth(fWidth);
+        stroker.setResScale(gDebugStrokerError);
+        stroker.strokePath(src, dst);
+        return true;
+    }
 #endif
-    stroker.strokePath(src, dst);
+
+    const SkScalar params[] = { fWidth, fMiterLimit, fResScale };
+    if (src.isVolatile() || !SkScalarsAreFinite(params, SK_ARRAY_COUNT(params))) {
+        stroker.setMiterLimit(fMiterLimit);
+        stroker.setWidth(fWidth);
+        stroker.setResScale(fResScale);
+        stroker.strokePath(src, dst);
+        return true;
+    }
+
+    // The scalar parameters are quantized before both the lookup and the stroke itself, so a
+    // cached outline is always the exact geometry this call would have produced.
+    const SkScalar width = quantize_stroke_scalar(fWidth);
+    const SkScalar miterLimit = quantize_stroke_scalar(fMiterLimit);
+    const SkScalar resScale = quantize_res_scale(fResScale);
+
+    StrokedPathKey key(src.getGenerationID(), width, miterLimit, resScale, fCap, fJoin,
+                       SkToBool(fStrokeAndFill));
+    if (SkResourceCache::Find(key, stroked_path_find_visitor, dst)) {
+        return true;
+    }
+
+    stroker.setMiterLimit(miterLimit);
+    stroker.setWidth(width);
+    stroker.setResScale(resScale);
+
+    SkPath stroked;
+    stroker.strokePath(src, &stroked);
+    SkPathPriv::AddGenIDChangeListener(src, sk_make_sp<StrokeInvalidator>(key));
+    SkResourceCache::Add(new StrokedPathRec(key, stroked));
+    *dst = stroked;
     return true;
 }
 
@@ -30,6 +30,11 @@ public:
     SkTMultiMap() : fCount(0) {}
 
     ~SkTMultiMap() {
+        this->reset();
+    }
+
+    // Frees all the entries, leaving the map empty.
+    void reset() {
         fHash.foreach([&](ValueList* vl) {
             ValueList* next;
             for (ValueList* it = vl; it; it = next) {
@@ -38,6 +43,8 @@ public:
                 delete it;
             }
         });
+        fHash.reset();
+        fCount = 0;
     }
 
     void insert(const Key& key, T* value) {
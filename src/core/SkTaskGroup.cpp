@@ -8,6 +8,9 @@
 #include "include/core/SkExecutor.h"
 #include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
+#include <thread>
+
 SkTaskGroup::SkTaskGroup(SkExecutor& executor) : fPending(0), fExecutor(executor) {}
 
 void SkTaskGroup::add(std::function<void(void)> fn) {
@@ -29,6 +32,37 @@ void SkTaskGroup::batch(int N, std::function<void(int)> fn) {
     }
 }
 
+void SkTaskGroup::parallelFor(int N, int grain, std::function<void(int)> fn) {
+    if (N <= 0) {
+        return;
+    }
+    if (grain <= 0) {
+        // Aim for several ranges per thread so faster threads can steal halves of slower ones'.
+        int threads = std::max(1, (int)std::thread::hardware_concurrency());
+        grain = std::max(1, N / (8 * threads));
+    }
+    this->addRange(0, N, grain, fn);
+}
+
+void SkTaskGroup::addRange(int begin, int end, int grain, const std::function<void(int)>& fn) {
+    fPending.fetch_add(+1, std::memory_order_relaxed);
+    fExecutor.add([this, begin, end, grain, fn] {
+        // Keep the front half and hand the back half to another thread, until we're down
+        // to one grain. A stolen range always carries half its victim's remaining work.
+        int b = begin,
+            e = end;
+        while (e - b > grain) {
+            int mid = b + (e - b) / 2;
+            this->addRange(mid, e, grain, fn);
+            e = mid;
+        }
+        for (int i = b; i < e; i++) {
+            fn(i);
+        }
+        fPending.fetch_add(-1, std::memory_order_release);
+    });
+}
+
 bool SkTaskGroup::done() const {
     return fPending.load(std::memory_order_acquire) == 0;
 }
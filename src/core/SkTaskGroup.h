@@ -26,6 +26,13 @@ public:
     // Add a batch of N tasks, all calling fn with different arguments.
     void batch(int N, std::function<void(int)> fn);
 
+    // Run fn(i) for each i in [0,N), splitting the range across the executor.
+    // Ranges are split in half as they run, so idle threads pick up half the remaining
+    // work of a busy one rather than one index at a time. No range smaller than grain is
+    // split; grain <= 0 picks a grain automatically. Call wait() to block until done --
+    // the calling thread helps execute remaining ranges rather than idling.
+    void parallelFor(int N, int grain, std::function<void(int)> fn);
+
     // Returns true if all Tasks previously add()ed to this SkTaskGroup have run.
     // It is safe to reuse this SkTaskGroup once done().
     bool done() const;
@@ -41,6 +48,8 @@ public:
     };
 
 private:
+    void addRange(int begin, int end, int grain, const std::function<void(int)>& fn);
+
     std::atomic<int32_t> fPending;
     SkExecutor&          fExecutor;
 };
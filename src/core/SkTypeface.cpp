@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkStream.h"
@@ -152,6 +153,14 @@ sk_sp<SkTypeface> SkTypeface::MakeFromData(sk_sp<SkData> data, int index) {
 }
 
 sk_sp<SkTypeface> SkTypeface::MakeFromFile(const char path[], int index) {
+    // Prefer an mmap-backed SkData: the font bytes stay read-only, file-backed pages that the
+    // kernel shares between every process mapping the same file, instead of each process
+    // holding its own heap copy of the font.
+    if (sk_sp<SkData> data = SkData::MakeFromFileName(path)) {
+        if (sk_sp<SkTypeface> face = MakeFromData(std::move(data), index)) {
+            return face;
+        }
+    }
     return SkFontMgr::RefDefault()->makeFromFile(path, index);
 }
 
@@ -5,9 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/private/SkMutex.h"
+#include "src/core/SkSharedMutex.h"
 #include "src/core/SkTypefaceCache.h"
 #include <atomic>
+#include <cctype>
 
 #define TYPEFACE_CACHE_LIMIT    1024
 
@@ -18,9 +23,15 @@ void SkTypefaceCache::add(sk_sp<SkTypeface> face) {
         this->purge(TYPEFACE_CACHE_LIMIT >> 2);
     }
 
+    fIDMap.set(face->uniqueID(), face.get());
     fTypefaces.emplace_back(std::move(face));
 }
 
+sk_sp<SkTypeface> SkTypefaceCache::findByID(SkFontID id) const {
+    SkTypeface* const* face = fIDMap.find(id);
+    return face ? sk_ref_sp(*face) : nullptr;
+}
+
 sk_sp<SkTypeface> SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx) const {
     for (const sk_sp<SkTypeface>& typeface : fTypefaces) {
         if (proc(typeface.get(), ctx)) {
@@ -35,6 +46,7 @@ void SkTypefaceCache::purge(int numToPurge) {
     int i = 0;
     while (i < count) {
         if (fTypefaces[i]->unique()) {
+            fIDMap.remove(fTypefaces[i]->uniqueID());
             fTypefaces.removeShuffle(i);
             --count;
             if (--numToPurge == 0) {
@@ -50,6 +62,39 @@ void SkTypefaceCache::purgeAll() {
     this->purge(fTypefaces.count());
 }
 
+namespace {
+    const char gTypefaceCacheDumpName[] = "skia/sk_typeface_cache";
+}  // namespace
+
+void SkTypefaceCache::dumpMemoryStatistics(SkTraceMemoryDump* dump) const {
+    dump->dumpNumericValue(gTypefaceCacheDumpName, "count", "objects", fTypefaces.count());
+    if (dump->getRequestedDetails() == SkTraceMemoryDump::kLight_LevelOfDetail) {
+        return;
+    }
+
+    for (const sk_sp<SkTypeface>& face : fTypefaces) {
+        SkString familyName;
+        face->getFamilyName(&familyName);
+        // Replace all special characters with '_'.
+        for (size_t index = 0; index < familyName.size(); ++index) {
+            if (!std::isalnum(familyName[index])) {
+                familyName[index] = '_';
+            }
+        }
+
+        SkString dumpName = SkStringPrintf("%s/%s_%u", gTypefaceCacheDumpName,
+                                           familyName.c_str(), face->uniqueID());
+        size_t fontDataSize = 0;
+        int ttcIndex;
+        if (std::unique_ptr<SkStreamAsset> stream = face->openStream(&ttcIndex)) {
+            if (stream->hasLength()) {
+                fontDataSize = stream->getLength();
+            }
+        }
+        dump->dumpNumericValue(dumpName.c_str(), "size", "bytes", fontDataSize);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 SkTypefaceCache& SkTypefaceCache::Get() {
@@ -62,26 +107,39 @@ SkFontID SkTypefaceCache::NewFontID() {
     return nextID++;
 }
 
-static SkMutex& typeface_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
+// The cache is looked up far more often than it is added to (every typeface resolution vs.
+// the first sighting of a face), so reads take the shared side of a distributed lock and
+// stay off each other's cachelines.
+static SkDistributedSharedMutex& typeface_cache_mutex() {
+    static SkDistributedSharedMutex& mutex = *(new SkDistributedSharedMutex);
     return mutex;
 }
 
 void SkTypefaceCache::Add(sk_sp<SkTypeface> face) {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
+    SkAutoSharedMutexExclusive ama(typeface_cache_mutex());
     Get().add(std::move(face));
 }
 
 sk_sp<SkTypeface> SkTypefaceCache::FindByProcAndRef(FindProc proc, void* ctx) {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
+    SkAutoSharedMutexShared ams(typeface_cache_mutex());
     return Get().findByProcAndRef(proc, ctx);
 }
 
+sk_sp<SkTypeface> SkTypefaceCache::FindByID(SkFontID id) {
+    SkAutoSharedMutexShared ams(typeface_cache_mutex());
+    return Get().findByID(id);
+}
+
 void SkTypefaceCache::PurgeAll() {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
+    SkAutoSharedMutexExclusive ama(typeface_cache_mutex());
     Get().purgeAll();
 }
 
+void SkTypefaceCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
+    SkAutoSharedMutexShared ams(typeface_cache_mutex());
+    Get().dumpMemoryStatistics(dump);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef SK_DEBUG
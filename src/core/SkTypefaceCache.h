@@ -13,6 +13,9 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkTArray.h"
+#include "include/private/SkTHash.h"
+
+class SkTraceMemoryDump;
 
 class SkTypefaceCache {
 public:
@@ -38,6 +41,12 @@ public:
      */
     sk_sp<SkTypeface> findByProcAndRef(FindProc proc, void* ctx) const;
 
+    /**
+     *  Look up a typeface by its uniqueID(). This is a hash lookup rather than a scan,
+     *  so it stays cheap as the cache grows. Returns nullptr if the id is not present.
+     */
+    sk_sp<SkTypeface> findByID(SkFontID) const;
+
     /**
      *  This will unref all of the typefaces in the cache for which the cache
      *  is the only owner. Normally this is handled automatically as needed.
@@ -46,6 +55,14 @@ public:
      */
     void purgeAll();
 
+    /**
+     *  Dump the cache via the SkTraceMemoryDump interface: the entry count always, and one
+     *  entry per cached typeface (family name, fontID, and underlying font data size) at
+     *  higher detail levels. Reported sizes reflect the typeface's font data, which may be
+     *  file-backed or shared with other typefaces.
+     */
+    void dumpMemoryStatistics(SkTraceMemoryDump* dump) const;
+
     /**
      *  Helper: returns a unique fontID to pass to the constructor of
      *  your subclass of SkTypeface
@@ -56,7 +73,9 @@ public:
 
     static void Add(sk_sp<SkTypeface>);
     static sk_sp<SkTypeface> FindByProcAndRef(FindProc proc, void* ctx);
+    static sk_sp<SkTypeface> FindByID(SkFontID);
     static void PurgeAll();
+    static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
 
     /**
      *  Debugging only: dumps the status of the typefaces in the cache
@@ -69,6 +88,7 @@ private:
     void purge(int count);
 
     SkTArray<sk_sp<SkTypeface>> fTypefaces;
+    SkTHashMap<SkFontID, SkTypeface*> fIDMap;
 };
 
 #endif
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/SkChecksum.h"
@@ -616,6 +617,10 @@ namespace skvm {
         return    finalize           (std::move(program));
     }
 
+    static PersistentCache* gPersistentCache = nullptr;
+
+    void SetPersistentCache(PersistentCache* cache) { gPersistentCache = cache; }
+
     Program Builder::done(const char* debug_name) const {
         char buf[64] = "skvm-jit-";
         if (!debug_name) {
@@ -623,6 +628,21 @@ namespace skvm {
             debug_name = buf;
         }
 
+        if (PersistentCache* cache = gPersistentCache) {
+            const uint64_t key = this->hash();
+            if (sk_sp<SkData> blob = cache->load(key)) {
+                Program p = Program::Deserialize(blob->data(), blob->size());
+                if (!p.empty()) {
+                    return p;
+                }
+            }
+            Program p{this->optimize(), fStrides, debug_name};
+            if (sk_sp<SkData> blob = p.serialize()) {
+                cache->store(key, *blob);
+            }
+            return p;
+        }
+
         return {this->optimize(), fStrides, debug_name};
     }
 
@@ -648,7 +668,27 @@ namespace skvm {
 
     // Most instructions produce a value and return it by ID,
     // the value-producing instruction's own index in the program vector.
+    // Ops where swapping x and y can't change the result, even for NaN (so no
+    // float min/max, whose lane-picking is asymmetric when NaN is involved).
+    static bool is_commutative(Op op) {
+        switch (op) {
+            case Op::add_f32: case Op::add_i32:
+            case Op::mul_f32: case Op::mul_i32:
+            case Op:: eq_f32: case Op:: eq_i32: case Op::neq_f32:
+            case Op::bit_and: case Op::bit_or:  case Op::bit_xor:
+                return true;
+            default:
+                return false;
+        }
+    }
+
     Val Builder::push(Instruction inst) {
+        // Put commutative operands in a canonical order so that, say, add(x,y)
+        // and add(y,x) value-number to the same instruction below.
+        if (is_commutative(inst.op) && inst.x > inst.y) {
+            std::swap(inst.x, inst.y);
+        }
+
         // Basic common subexpression elimination:
         // if we've already seen this exact Instruction, use it instead of creating a new one.
         if (Val* id = fIndex.find(inst)) {
@@ -2516,8 +2556,16 @@ namespace skvm {
         auto mod = std::make_unique<llvm::Module>("", *ctx);
         // All the scary bare pointers from here on are owned by ctx or mod, I think.
 
-        // Everything I've tested runs faster at K=8 (using ymm) than K=16 (zmm) on SKX machines.
-        const int K = (true && SkCpu::Supports(SkCpu::HSW)) ? 8 : 4;
+        // Most ops I've tested run faster at K=8 (using ymm) than K=16 (zmm) on SKX machines,
+        // but memory-bound programs (blitters doing little math per pixel) come out ahead at
+        // K=16, where the tail runs through the predicated scalar loop half as often.  Let
+        // AVX-512 machines use zmm; opt out with SKVM_LLVM_ZMM=0 if a workload regresses.
+        #if !defined(SKVM_LLVM_ZMM)
+            #define SKVM_LLVM_ZMM 1
+        #endif
+        const int K = (SKVM_LLVM_ZMM && SkCpu::Supports(SkCpu::SKX)) ? 16
+                    : SkCpu::Supports(SkCpu::HSW)                    ?  8
+                                                                     :  4;
 
         llvm::Type *ptr = llvm::Type::getInt8Ty(*ctx)->getPointerTo(),
                    *i32 = llvm::Type::getInt32Ty(*ctx);
@@ -2974,6 +3022,68 @@ namespace skvm {
         this->setupInterpreter(instructions);
     }
 
+    namespace {
+        // Bump kProgramVersion whenever InterpreterInstruction or this layout changes;
+        // stale PersistentCache blobs then fail to deserialize and get re-stored.
+        struct ProgramHeader {
+            uint32_t magic, version;
+            int32_t  regs, loop, nargs, ninsts;
+        };
+        constexpr uint32_t kProgramMagic   = 0x6d766b73;  // 'skvm'
+        constexpr uint32_t kProgramVersion = 1;
+    }
+
+    sk_sp<SkData> Program::serialize() const {
+        if (this->empty()) {
+            return nullptr;
+        }
+
+        const ProgramHeader header = {
+            kProgramMagic, kProgramVersion,
+            fImpl->regs, fImpl->loop,
+            (int32_t)fImpl->strides.size(), (int32_t)fImpl->instructions.size(),
+        };
+
+        const size_t strides_bytes = fImpl->strides.size() * sizeof(int),
+                     insts_bytes   = fImpl->instructions.size() * sizeof(InterpreterInstruction);
+
+        sk_sp<SkData> blob = SkData::MakeUninitialized(sizeof(header) + strides_bytes
+                                                                      + insts_bytes);
+        char* p = (char*)blob->writable_data();
+        memcpy(p, &header                    , sizeof(header)); p += sizeof(header);
+        memcpy(p, fImpl->strides.data()      , strides_bytes ); p += strides_bytes;
+        memcpy(p, fImpl->instructions.data() , insts_bytes   );
+        return blob;
+    }
+
+    Program Program::Deserialize(const void* data, size_t size) {
+        Program p;  // Stays empty() if anything below doesn't check out.
+
+        ProgramHeader header;
+        if (size < sizeof(header)) {
+            return p;
+        }
+        memcpy(&header, data, sizeof(header));
+
+        const size_t strides_bytes = (size_t)header.nargs  * sizeof(int),
+                     insts_bytes   = (size_t)header.ninsts * sizeof(InterpreterInstruction);
+        if (header.magic   != kProgramMagic
+         || header.version != kProgramVersion
+         || header.nargs  < 0 || header.ninsts < 0
+         || size != sizeof(header) + strides_bytes + insts_bytes) {
+            return p;
+        }
+
+        const char* src = (const char*)data + sizeof(header);
+        p.fImpl->regs = header.regs;
+        p.fImpl->loop = header.loop;
+        p.fImpl->strides.resize(header.nargs);
+        memcpy(p.fImpl->strides.data(), src, strides_bytes); src += strides_bytes;
+        p.fImpl->instructions.resize(header.ninsts);
+        memcpy(p.fImpl->instructions.data(), src, insts_bytes);
+        return p;
+    }
+
     std::vector<InterpreterInstruction> Program::instructions() const { return fImpl->instructions; }
     int  Program::nargs() const { return (int)fImpl->strides.size(); }
     int  Program::nregs() const { return fImpl->regs; }
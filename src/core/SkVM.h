@@ -17,8 +17,11 @@
 #include "src/core/SkVM_fwd.h"
 #include <vector>      // std::vector
 
+class SkData;
 class SkWStream;
 
+template <typename T> class sk_sp;
+
 #if 0
     #define SKVM_LLVM
 #endif
@@ -546,6 +549,24 @@ namespace skvm {
         bool can_hoist;
     };
 
+    // A pluggable persistent cache for compiled Programs, in the spirit of
+    // GrContextOptions::fPersistentCache for GPU shaders.  When installed,
+    // Builder::done() calls load() with the builder hash before running
+    // optimize(), and store()s a serialized Program on a miss, so warm starts
+    // skip optimization and codegen entirely.  Implementations must be safe
+    // to call from any thread, and should treat the blobs as opaque.
+    class PersistentCache {
+    public:
+        virtual ~PersistentCache() = default;
+
+        virtual sk_sp<SkData> load(uint64_t key) = 0;
+        virtual void store(uint64_t key, const SkData& program) = 0;
+    };
+
+    // Not thread safe; install once, before any Builder::done() call.
+    // Pass nullptr to uninstall.  The cache is not owned.
+    void SetPersistentCache(PersistentCache*);
+
     class Builder {
     public:
 
@@ -869,6 +890,17 @@ namespace skvm {
 
         void dump(SkWStream* = nullptr) const;
 
+        // Serialize the interpreted form of this Program (instructions,
+        // register allocation, strides) for a PersistentCache; returns null
+        // for an empty Program.  Deserialize() returns an empty Program if
+        // the blob is corrupt or from an incompatible version.
+        //
+        // Deserialized Programs run through the interpreter: the serialized
+        // form deliberately holds no machine code, keeping blobs portable
+        // across CPUs and ASLR.
+        sk_sp<SkData> serialize() const;
+        static Program Deserialize(const void* data, size_t size);
+
     private:
         void setupInterpreter(const std::vector<OptimizedInstruction>&);
         void setupJIT        (const std::vector<OptimizedInstruction>&, const char* debug_name);
@@ -18,6 +18,11 @@ static unsigned gYUVPlanesKeyNamespaceLabel;
 struct YUVValue {
     SkYUVPlanesCache::Info fInfo;
     SkCachedData*          fData;
+    // One bitmap per plane, wrapping fData's memory. Built once per cache entry so the pixelRef
+    // generation IDs stay stable for the life of the entry, letting per-context GPU textures
+    // keyed off them be reused rather than re-uploaded. The bitmaps' pixels are only safe to use
+    // while a ref on fData is held.
+    SkBitmap               fPlanes[SkYUVASizeInfo::kMaxCount];
 };
 
 struct YUVPlanesKey : public SkResourceCache::Key {
@@ -38,6 +43,27 @@ struct YUVPlanesRec : public SkResourceCache::Rec {
         fValue.fData = data;
         fValue.fInfo = *info;
         fValue.fData->attachToCacheAndRef();
+
+        // Wrap each plane in a bitmap now, so every lookup hands out the same pixelRefs. Each
+        // bitmap holds a ref on the cached data; the refs are dropped when this rec is purged,
+        // so the planes still participate in the cache's byte budget and go away under pressure.
+        void* planes[SkYUVASizeInfo::kMaxCount];
+        info->fSizeInfo.computePlanes(const_cast<void*>(data->data()), planes);
+        auto releaseProc = [](void*, void* ctx) {
+            static_cast<SkCachedData*>(ctx)->unref();
+        };
+        for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
+            if (info->fSizeInfo.fSizes[i].isEmpty()) {
+                continue;
+            }
+            SkImageInfo planeInfo = SkImageInfo::MakeA8(info->fSizeInfo.fSizes[i].fWidth,
+                                                        info->fSizeInfo.fSizes[i].fHeight);
+            data->ref();
+            SkAssertResult(fValue.fPlanes[i].installPixels(planeInfo, planes[i],
+                                                           info->fSizeInfo.fWidthBytes[i],
+                                                           releaseProc, data));
+            fValue.fPlanes[i].setImmutable();
+        }
     }
     ~YUVPlanesRec() override {
         fValue.fData->detachFromCacheAndUnref();
@@ -65,12 +91,16 @@ struct YUVPlanesRec : public SkResourceCache::Rec {
         }
         result->fData = tmpData;
         result->fInfo = rec.fValue.fInfo;
+        for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
+            result->fPlanes[i] = rec.fValue.fPlanes[i];
+        }
         return true;
     }
 };
 } // namespace
 
 SkCachedData* SkYUVPlanesCache::FindAndRef(uint32_t genID, Info* info,
+                                           SkBitmap planes[SkYUVASizeInfo::kMaxCount],
                                            SkResourceCache* localCache) {
     YUVValue result;
     YUVPlanesKey key(genID);
@@ -79,11 +109,23 @@ SkCachedData* SkYUVPlanesCache::FindAndRef(uint32_t genID, Info* info,
     }
 
     *info = result.fInfo;
+    if (planes) {
+        for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
+            planes[i] = result.fPlanes[i];
+        }
+    }
     return result.fData;
 }
 
 void SkYUVPlanesCache::Add(uint32_t genID, SkCachedData* data, Info* info,
+                           SkBitmap planes[SkYUVASizeInfo::kMaxCount],
                            SkResourceCache* localCache) {
     YUVPlanesKey key(genID);
-    return CHECK_LOCAL(localCache, add, Add, new YUVPlanesRec(key, data, info));
+    YUVPlanesRec* rec = new YUVPlanesRec(key, data, info);
+    if (planes) {
+        for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
+            planes[i] = rec->fValue.fPlanes[i];
+        }
+    }
+    return CHECK_LOCAL(localCache, add, Add, rec);
 }
@@ -8,6 +8,7 @@
 #ifndef SkYUVPlanesCache_DEFINED
 #define SkYUVPlanesCache_DEFINED
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkYUVAIndex.h"
 #include "include/core/SkYUVASizeInfo.h"
@@ -30,17 +31,25 @@ public:
         SkYUVColorSpace fColorSpace;
     };
     /**
-     * On success, return a ref to the SkCachedData that holds the pixels.
+     * On success, return a ref to the SkCachedData that holds the pixels, and (optionally) the
+     * per-plane bitmaps wrapping them. The bitmaps share one pixelRef per plane for the life of
+     * the cache entry, so their generation IDs are stable across lookups: GPU textures keyed off
+     * them (per context, via GrBitmapTextureMaker) stay valid instead of re-uploading the same
+     * planes. Callers must keep the returned SkCachedData ref for as long as they use the
+     * bitmaps' pixels.
      *
      * On failure, return nullptr.
      */
     static SkCachedData* FindAndRef(uint32_t genID, Info* info,
+                                    SkBitmap planes[SkYUVASizeInfo::kMaxCount] = nullptr,
                                     SkResourceCache* localCache = nullptr);
 
     /**
-     * Add a pixelRef ID and its YUV planes data to the cache.
+     * Add a pixelRef ID and its YUV planes data to the cache. If planes is non-null it receives
+     * the stable per-plane bitmaps, as with FindAndRef.
      */
     static void Add(uint32_t genID, SkCachedData* data, Info* info,
+                    SkBitmap planes[SkYUVASizeInfo::kMaxCount] = nullptr,
                     SkResourceCache* localCache = nullptr);
 };
 
@@ -70,6 +70,75 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
 
 //////////////////////////////////////////////////////////////////////////////
 
+sk_sp<GrBufferAllocPool::GpuBufferCache> GrBufferAllocPool::GpuBufferCache::Make(
+        int maxBuffersToCache) {
+    return sk_sp<GpuBufferCache>(new GpuBufferCache(maxBuffersToCache));
+}
+
+GrBufferAllocPool::GpuBufferCache::GpuBufferCache(int maxBuffersToCache)
+        : fMaxBuffersToCache(maxBuffersToCache) {}
+
+sk_sp<GrGpuBuffer> GrBufferAllocPool::GpuBufferCache::findBuffer(size_t minSize,
+                                                                 GrGpuBufferType type) {
+    for (int i = 0; i < fAvailableBuffers.count(); ++i) {
+        GrGpuBuffer* buffer = fAvailableBuffers[i].fBuffer.get();
+        if (buffer->wasDestroyed()) {
+            fAvailableBuffers.removeShuffle(i--);
+            continue;
+        }
+        if (fAvailableBuffers[i].fType == type && buffer->size() >= minSize) {
+            sk_sp<GrGpuBuffer> result = std::move(fAvailableBuffers[i].fBuffer);
+            fAvailableBuffers.removeShuffle(i);
+            return result;
+        }
+    }
+    return nullptr;
+}
+
+void GrBufferAllocPool::GpuBufferCache::retireBuffer(sk_sp<GrGpuBuffer> buffer,
+                                                     GrGpuBufferType type) {
+    fRetiredBuffers.push_back({std::move(buffer), type});
+}
+
+struct GrBufferAllocPool::GpuBufferCache::RetiredGroup {
+    sk_sp<GpuBufferCache> fCache;
+    SkTArray<Buffer> fBuffers;
+};
+
+void GrBufferAllocPool::GpuBufferCache::startTrackingRetiredBuffers(GrGpu* gpu) {
+    if (fRetiredBuffers.empty()) {
+        return;
+    }
+    // The group refs both the cache and the buffers until the GPU finishes the pending work, at
+    // which point the buffers become available for reuse. The backends call the proc even if the
+    // context is abandoned or destroyed first, so the group cannot leak.
+    RetiredGroup* group = new RetiredGroup;
+    group->fCache = sk_ref_sp(this);
+    group->fBuffers = std::move(fRetiredBuffers);
+    gpu->addFinishedProc(BuffersFinished, group);
+}
+
+void GrBufferAllocPool::GpuBufferCache::BuffersFinished(void* context) {
+    RetiredGroup* group = static_cast<RetiredGroup*>(context);
+    group->fCache->returnRetiredBuffers(group);
+    delete group;
+}
+
+void GrBufferAllocPool::GpuBufferCache::returnRetiredBuffers(RetiredGroup* group) {
+    for (Buffer& buffer : group->fBuffers) {
+        if (fAvailableBuffers.count() < fMaxBuffersToCache && !buffer.fBuffer->wasDestroyed()) {
+            fAvailableBuffers.push_back(std::move(buffer));
+        }
+    }
+}
+
+void GrBufferAllocPool::GpuBufferCache::releaseAll() {
+    fAvailableBuffers.reset();
+    fRetiredBuffers.reset();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 #ifdef SK_DEBUG
     #define VALIDATE validate
 #else
@@ -88,9 +157,11 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
 constexpr size_t GrBufferAllocPool::kDefaultBufferSize;
 
 GrBufferAllocPool::GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType,
-                                     sk_sp<CpuBufferCache> cpuBufferCache)
+                                     sk_sp<CpuBufferCache> cpuBufferCache,
+                                     sk_sp<GpuBufferCache> gpuBufferCache)
         : fBlocks(8)
         , fCpuBufferCache(std::move(cpuBufferCache))
+        , fGpuBufferCache(std::move(gpuBufferCache))
         , fGpu(gpu)
         , fBufferType(bufferType) {}
 
@@ -110,12 +181,18 @@ void GrBufferAllocPool::deleteBlocks() {
 GrBufferAllocPool::~GrBufferAllocPool() {
     VALIDATE();
     this->deleteBlocks();
+    if (fGpuBufferCache) {
+        fGpuBufferCache->startTrackingRetiredBuffers(fGpu);
+    }
 }
 
 void GrBufferAllocPool::reset() {
     VALIDATE();
     fBytesInUse = 0;
     this->deleteBlocks();
+    if (fGpuBufferCache) {
+        fGpuBufferCache->startTrackingRetiredBuffers(fGpu);
+    }
     this->resetCpuData(0);
     VALIDATE();
 }
@@ -366,8 +443,16 @@ bool GrBufferAllocPool::createBlock(size_t requestSize) {
 
 void GrBufferAllocPool::destroyBlock() {
     SkASSERT(!fBlocks.empty());
-    SkASSERT(fBlocks.back().fBuffer->isCpuBuffer() ||
-             !static_cast<GrGpuBuffer*>(fBlocks.back().fBuffer.get())->isMapped());
+    BufferBlock& block = fBlocks.back();
+    SkASSERT(block.fBuffer->isCpuBuffer() ||
+             !static_cast<GrGpuBuffer*>(block.fBuffer.get())->isMapped());
+    if (fGpuBufferCache && !block.fBuffer->isCpuBuffer()) {
+        // Hold the buffer until the GPU is done with it so that the next pool to pick it up can
+        // reuse the underlying allocation instead of orphaning it on the first map.
+        fGpuBufferCache->retireBuffer(
+                sk_sp<GrGpuBuffer>(static_cast<GrGpuBuffer*>(block.fBuffer.release())),
+                fBufferType);
+    }
     fBlocks.pop_back();
     fBufferPtr = nullptr;
 }
@@ -418,13 +503,20 @@ sk_sp<GrBuffer> GrBufferAllocPool::getBuffer(size_t size) {
         return fCpuBufferCache ? fCpuBufferCache->makeBuffer(size, mustInitialize)
                                : GrCpuBuffer::Make(size);
     }
+    if (fGpuBufferCache) {
+        if (sk_sp<GrGpuBuffer> buffer = fGpuBufferCache->findBuffer(size, fBufferType)) {
+            return buffer;
+        }
+    }
     return resourceProvider->createBuffer(size, fBufferType, kDynamic_GrAccessPattern);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-        : GrBufferAllocPool(gpu, GrGpuBufferType::kVertex, std::move(cpuBufferCache)) {}
+GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                                                 sk_sp<GpuBufferCache> gpuBufferCache)
+        : GrBufferAllocPool(gpu, GrGpuBufferType::kVertex, std::move(cpuBufferCache),
+                            std::move(gpuBufferCache)) {}
 
 void* GrVertexBufferAllocPool::makeSpace(size_t vertexSize,
                                          int vertexCount,
@@ -476,8 +568,10 @@ void* GrVertexBufferAllocPool::makeSpaceAtLeast(size_t vertexSize, int minVertex
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-        : GrBufferAllocPool(gpu, GrGpuBufferType::kIndex, std::move(cpuBufferCache)) {}
+GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                                               sk_sp<GpuBufferCache> gpuBufferCache)
+        : GrBufferAllocPool(gpu, GrGpuBufferType::kIndex, std::move(cpuBufferCache),
+                            std::move(gpuBufferCache)) {}
 
 void* GrIndexBufferAllocPool::makeSpace(int indexCount, sk_sp<const GrBuffer>* buffer,
                                         int* startIndex) {
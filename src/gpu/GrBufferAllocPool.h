@@ -14,6 +14,7 @@
 #include "include/private/SkTArray.h"
 #include "include/private/SkTDArray.h"
 #include "src/gpu/GrCpuBuffer.h"
+#include "src/gpu/GrGpuBuffer.h"
 #include "src/gpu/GrNonAtomicRef.h"
 
 class GrGpu;
@@ -56,6 +57,47 @@ public:
         int fMaxBuffersToCache = 0;
     };
 
+    /**
+     * A cache object that can be shared by multiple GrBufferAllocPool instances. It holds GPU
+     * buffers retired by the pools until the GPU has finished with their contents. Handing a
+     * buffer back out only after that point lets the backend reuse its underlying allocation
+     * when the buffer is next mapped, rather than orphaning the allocation because it is still
+     * in flight.
+     */
+    class GpuBufferCache : public GrNonAtomicRef<GpuBufferCache> {
+    public:
+        static sk_sp<GpuBufferCache> Make(int maxBuffersToCache);
+
+        /** Removes and returns a cached buffer of the given type at least minSize big, if any. */
+        sk_sp<GrGpuBuffer> findBuffer(size_t minSize, GrGpuBufferType);
+
+        /** Holds the buffer until startTrackingRetiredBuffers's GPU work completes. */
+        void retireBuffer(sk_sp<GrGpuBuffer>, GrGpuBufferType);
+
+        /**
+         * Makes all buffers retired since the last call available to findBuffer() once the GPU
+         * completes the work currently pending on the GrGpu.
+         */
+        void startTrackingRetiredBuffers(GrGpu*);
+
+        void releaseAll();
+
+    private:
+        GpuBufferCache(int maxBuffersToCache);
+
+        struct Buffer {
+            sk_sp<GrGpuBuffer> fBuffer;
+            GrGpuBufferType fType;
+        };
+        struct RetiredGroup;
+        static void BuffersFinished(void* context);
+        void returnRetiredBuffers(RetiredGroup*);
+
+        SkSTArray<4, Buffer> fAvailableBuffers;
+        SkTArray<Buffer> fRetiredBuffers;
+        int fMaxBuffersToCache = 0;
+    };
+
     /**
      * Ensures all buffers are unmapped and have all data written to them.
      * Call before drawing using buffers from the pool.
@@ -81,8 +123,12 @@ protected:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param gpuBufferCache        If non-null a cache that holds retired GPU buffers until
+     *                              the GPU is done with them and then recycles them into
+     *                              later pools.
      */
-    GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType, sk_sp<CpuBufferCache> cpuBufferCache,
+                      sk_sp<GpuBufferCache> gpuBufferCache = nullptr);
 
     virtual ~GrBufferAllocPool();
 
@@ -159,6 +205,7 @@ private:
 
     SkTArray<BufferBlock> fBlocks;
     sk_sp<CpuBufferCache> fCpuBufferCache;
+    sk_sp<GpuBufferCache> fGpuBufferCache;
     sk_sp<GrCpuBuffer> fCpuStagingBuffer;
     GrGpu* fGpu;
     GrGpuBufferType fBufferType;
@@ -177,8 +224,11 @@ public:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param gpuBufferCache        If non-null a cache that recycles retired GPU buffers once
+     *                              the GPU is done with them.
      */
-    GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                            sk_sp<GpuBufferCache> gpuBufferCache = nullptr);
 
     /**
      * Returns a block of memory to hold vertices. A buffer designated to hold
@@ -256,8 +306,11 @@ public:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param gpuBufferCache        If non-null a cache that recycles retired GPU buffers once
+     *                              the GPU is done with them.
      */
-    GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                           sk_sp<GpuBufferCache> gpuBufferCache = nullptr);
 
     /**
      * Returns a block of memory to hold indices. A buffer designated to hold
@@ -316,8 +369,10 @@ private:
 
 class GrDrawIndirectBufferAllocPool : private GrBufferAllocPool {
 public:
-    GrDrawIndirectBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-            : GrBufferAllocPool(gpu, GrGpuBufferType::kDrawIndirect, std::move(cpuBufferCache)) {}
+    GrDrawIndirectBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                                  sk_sp<GpuBufferCache> gpuBufferCache = nullptr)
+            : GrBufferAllocPool(gpu, GrGpuBufferType::kDrawIndirect, std::move(cpuBufferCache),
+                                std::move(gpuBufferCache)) {}
 
     GrDrawIndirectCommand* makeSpace(int drawCount, sk_sp<const GrBuffer>* buffer, size_t* offset) {
         return static_cast<GrDrawIndirectCommand*>(this->GrBufferAllocPool::makeSpace(
@@ -203,7 +203,8 @@ void GrContext::purgeUnlockedResources(bool scratchResourcesOnly) {
     this->getTextBlobCache()->purgeStaleBlobs();
 }
 
-void GrContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed) {
+void GrContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed,
+                                       int maxResourcesToPurge) {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
 
     ASSERT_SINGLE_OWNER
@@ -216,7 +217,7 @@ void GrContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed) {
     auto purgeTime = GrStdSteadyClock::now() - msNotUsed;
 
     fResourceCache->purgeAsNeeded();
-    fResourceCache->purgeResourcesNotUsedSince(purgeTime);
+    fResourceCache->purgeResourcesNotUsedSince(purgeTime, maxResourcesToPurge);
 
     if (auto ccpr = this->drawingManager()->getCoverageCountingPathRenderer()) {
         ccpr->purgeCacheEntriesOlderThan(this->proxyProvider(), purgeTime);
@@ -394,6 +395,28 @@ void GrContext::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     fResourceCache->dumpMemoryStatistics(traceMemoryDump);
     traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "size", "bytes",
                                       this->getTextBlobCache()->usedBytes());
+
+    // The arenas accessor is non-const but collecting the pool's stats does not mutate it.
+    GrOpMemoryPool* opMemoryPool = const_cast<GrContext*>(this)->arenas().opMemoryPool();
+    GrMemoryPool::Stats opPoolStats = opMemoryPool->stats();
+    traceMemoryDump->dumpNumericValue("skia/gr_op_memory_pool", "size", "bytes",
+                                      opPoolStats.fTotalBytes);
+    traceMemoryDump->dumpNumericValue("skia/gr_op_memory_pool", "block_count", "objects",
+                                      opPoolStats.fBlockCount);
+    traceMemoryDump->dumpNumericValue("skia/gr_op_memory_pool", "outstanding_size", "bytes",
+                                      opPoolStats.fOutstandingBytes);
+    traceMemoryDump->dumpNumericValue("skia/gr_op_memory_pool", "high_water_size", "bytes",
+                                      opPoolStats.fHighWaterBytes);
+    traceMemoryDump->dumpNumericValue("skia/gr_op_memory_pool", "cumulative_size", "bytes",
+                                      opPoolStats.fCumulativeBytes);
+#if GR_OP_SIZE_HISTOGRAM
+    for (int i = 0; i < GrOpMemoryPool::kOpSizeHistogramBuckets; ++i) {
+        SkString bucketName = SkStringPrintf("op_size_le_%zu",
+                                             GrOpMemoryPool::OpSizeBucketMax(i));
+        traceMemoryDump->dumpNumericValue("skia/gr_op_memory_pool", bucketName.c_str(), "objects",
+                                          opMemoryPool->opSizeHistogram()[i]);
+    }
+#endif
 }
 
 //////////////////////////////////////////////////////////////////////////////
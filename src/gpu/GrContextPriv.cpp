@@ -73,6 +73,18 @@ bool GrContextPriv::compile(const GrProgramDesc& desc, const GrProgramInfo& info
     return gpu->compile(desc, info);
 }
 
+const SkTArray<GrGpuOpTypeTiming>& GrContextPriv::gpuOpTypeTimings() {
+    static const SkTArray<GrGpuOpTypeTiming> kEmpty;
+    GrGpu* gpu = this->getGpu();
+    return gpu ? gpu->opTypeTimings() : kEmpty;
+}
+
+void GrContextPriv::resetGpuOpTypeTimings() {
+    if (GrGpu* gpu = this->getGpu()) {
+        gpu->resetOpTypeTimings();
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////////
 #if GR_TEST_UTILS
@@ -18,6 +18,7 @@ class GrOnFlushCallbackObject;
 class GrRenderTargetProxy;
 class GrSemaphore;
 class GrSurfaceProxy;
+struct GrGpuOpTypeTiming;
 
 class SkDeferredDisplayList;
 class SkTaskGroup;
@@ -125,6 +126,15 @@ public:
         return fContext->fMappedBufferManager.get();
     }
 
+    /**
+     * Per-op-type GPU execution times, gathered when GrContextOptions::fEnableGpuOpTiming is set.
+     * Resolves any outstanding timestamp queries, blocking on the GPU if necessary, so this should
+     * be called between frames rather than mid-flush. The entries remain valid until the next call
+     * to resetGpuOpTypeTimings().
+     */
+    const SkTArray<GrGpuOpTypeTiming>& gpuOpTypeTimings();
+    void resetGpuOpTypeTimings();
+
 #if GR_TEST_UTILS
     /** Reset GPU stats */
     void resetGpuStats() const;
@@ -29,6 +29,9 @@ private:
     bool onIsUsed(GrSurfaceProxy* proxy) const override {
         return proxy == fSrcView.proxy();
     }
+    void visitSourceProxies(const GrOp::VisitProxyFunc& fn) const override {
+        fn(fSrcView.proxy(), GrMipmapped::kNo);
+    }
     // If instantiation failed, at flush time we simply will skip doing the copy.
     void handleInternalAllocationFailure() override {}
     void gatherProxyIntervals(GrResourceAllocator*) const override;
@@ -11,6 +11,7 @@
 #include "include/gpu/GrContextThreadSafeProxy.h"
 #include "src/gpu/GrContextPriv.h"
 #include "src/gpu/GrContextThreadSafeProxyPriv.h"
+#include "src/gpu/GrDrawingManager.h"
 #include "src/gpu/GrGpu.h"
 
 #include "src/gpu/effects/GrSkSLFP.h"
@@ -76,6 +77,14 @@ void GrDirectContext::freeGpuResources() {
     INHERITED::freeGpuResources();
 }
 
+GrPendingSurfaceUsage GrDirectContext::pendingSurfaceUsage() {
+    GrPendingSurfaceUsage usage;
+    if (!this->abandoned()) {
+        this->drawingManager()->collectPendingSurfaceUsage(&usage);
+    }
+    return usage;
+}
+
 bool GrDirectContext::init() {
     const GrGpu* gpu = this->priv().getGpu();
     if (!gpu) {
@@ -23,6 +23,7 @@
 #include "src/gpu/GrMemoryPool.h"
 #include "src/gpu/GrOnFlushResourceProvider.h"
 #include "src/gpu/GrRecordingContextPriv.h"
+#include "src/gpu/GrRenderTarget.h"
 #include "src/gpu/GrRenderTargetContext.h"
 #include "src/gpu/GrRenderTargetProxy.h"
 #include "src/gpu/GrRenderTask.h"
@@ -110,17 +111,38 @@ void GrDrawingManager::RenderTaskDAG::swap(SkTArray<sk_sp<GrRenderTask>>* render
     renderTasks->swap(fRenderTasks);
 }
 
-void GrDrawingManager::RenderTaskDAG::prepForFlush() {
+void GrDrawingManager::RenderTaskDAG::prepForFlush(bool mergeAdjacentOpsTasks) {
     if (fSortRenderTasks) {
         SkDEBUGCODE(bool result =) SkTTopoSort<GrRenderTask, GrRenderTask::TopoSortTraits>(
                 &fRenderTasks);
         SkASSERT(result);
     }
 
+    if (mergeAdjacentOpsTasks && fRenderTasks.count()) {
+        // When opsTask splitting is reduced, a task that is split because its target gets sampled
+        // often ends up adjacent to the later task for the same target once the sort clusters the
+        // intervening work elsewhere. Fold such neighbors back together so the backend renders
+        // them in one pass instead of paying an extra load/store round trip on the target.
+        GrOpsTask* prevOpsTask = fRenderTasks[0]->asOpsTask();
+        for (int i = 1; i < fRenderTasks.count(); ++i) {
+            GrOpsTask* curOpsTask = fRenderTasks[i]->asOpsTask();
+
+            if (prevOpsTask && curOpsTask && prevOpsTask->mergeFrom(curOpsTask)) {
+                // 'curOpsTask' is now an empty no-op. It stays in the DAG (and keeps its arena
+                // alive) until the flush completes; keep merging later tasks into 'prevOpsTask'.
+                continue;
+            }
+
+            prevOpsTask = curOpsTask;
+        }
+    }
+
 #ifdef SK_DEBUG
     // This block checks for any unnecessary splits in the opsTasks. If two sequential opsTasks
-    // share the same backing GrSurfaceProxy it means the opsTask was artificially split.
-    if (fRenderTasks.count()) {
+    // share the same backing GrSurfaceProxy it means the opsTask was artificially split. When
+    // adjacent opsTasks are being merged, a same-target neighbor can legitimately remain if the
+    // merge was declined (e.g. the later task clears its target), so skip the check.
+    if (!mergeAdjacentOpsTasks && fRenderTasks.count()) {
         GrOpsTask* prevOpsTask = fRenderTasks[0]->asOpsTask();
         for (int i = 1; i < fRenderTasks.count(); ++i) {
             GrOpsTask* curOpsTask = fRenderTasks[i]->asOpsTask();
@@ -176,6 +198,9 @@ void GrDrawingManager::freeGpuResources() {
     // a path renderer may be holding onto resources
     fPathRendererChain = nullptr;
     fSoftwarePathRenderer = nullptr;
+    if (fGpuBufferCache) {
+        fGpuBufferCache->releaseAll();
+    }
 }
 
 // MDB TODO: make use of the 'proxy' parameter.
@@ -243,7 +268,7 @@ bool GrDrawingManager::flush(
     fDAG.closeAll(fContext->priv().caps());
     fActiveOpsTask = nullptr;
 
-    fDAG.prepForFlush();
+    fDAG.prepForFlush(fDAG.sortingRenderTasks() && fReduceOpsTaskSplitting);
     if (!fCpuBufferCache) {
         // We cache more buffers when the backend is using client side arrays. Otherwise, we
         // expect each pool will use a CPU buffer as a staging buffer before uploading to a GPU
@@ -251,8 +276,14 @@ bool GrDrawingManager::flush(
         int maxCachedBuffers = fContext->priv().caps()->preferClientSideDynamicBuffers() ? 2 : 6;
         fCpuBufferCache = GrBufferAllocPool::CpuBufferCache::Make(maxCachedBuffers);
     }
+    if (!fGpuBufferCache) {
+        // Each pool retires its GPU buffers when it is reset at the end of the flush. Two
+        // default-size buffers per pool covers the steady state.
+        fGpuBufferCache = GrBufferAllocPool::GpuBufferCache::Make(6);
+    }
 
-    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache);
+    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache,
+                              fGpuBufferCache);
 
     GrOnFlushResourceProvider onFlushProvider(this);
 
@@ -572,6 +603,51 @@ GrSemaphoresSubmitted GrDrawingManager::flushSurfaces(
     return GrSemaphoresSubmitted::kYes;
 }
 
+void GrDrawingManager::collectPendingSurfaceUsage(GrPendingSurfaceUsage* usage) const {
+    // Gather the unique instantiated surfaces first so each backend object is reported once,
+    // even when several render tasks touch it.
+    SkTDArray<GrSurface*> written, read;
+    auto addUnique = [](SkTDArray<GrSurface*>* list, GrSurface* surface) {
+        if (list->find(surface) < 0) {
+            list->push_back(surface);
+        }
+    };
+
+    for (int i = 0; i < fDAG.numRenderTasks(); ++i) {
+        const GrRenderTask* task = fDAG.renderTask(i);
+        if (!task) {
+            continue;
+        }
+        for (int j = 0; j < task->numTargets(); ++j) {
+            GrSurfaceProxy* proxy = task->target(j).proxy();
+            if (proxy && proxy->isInstantiated()) {
+                addUnique(&written, proxy->peekSurface());
+            }
+        }
+        task->visitSourceProxies([&](GrSurfaceProxy* proxy, GrMipmapped) {
+            if (proxy && proxy->isInstantiated()) {
+                addUnique(&read, proxy->peekSurface());
+            }
+        });
+    }
+
+    for (GrSurface* surface : written) {
+        if (GrTexture* texture = surface->asTexture()) {
+            usage->fTextureWrites.push_back(texture->getBackendTexture());
+        } else if (GrRenderTarget* rt = surface->asRenderTarget()) {
+            usage->fRenderTargetWrites.push_back(rt->getBackendRenderTarget());
+        }
+    }
+    for (GrSurface* surface : read) {
+        if (written.find(surface) >= 0) {
+            continue;  // Already reported as a write; writes subsume reads for scheduling.
+        }
+        if (GrTexture* texture = surface->asTexture()) {
+            usage->fTextureReads.push_back(texture->getBackendTexture());
+        }
+    }
+}
+
 void GrDrawingManager::addOnFlushCallbackObject(GrOnFlushCallbackObject* onFlushCBObject) {
     fOnFlushCBObjects.push_back(onFlushCBObject);
 }
@@ -740,7 +816,8 @@ sk_sp<GrOpsTask> GrDrawingManager::newOpsTask(GrSurfaceProxyView surfaceView,
 
     sk_sp<GrOpsTask> opsTask(new GrOpsTask(this, fContext->priv().arenas(),
                                            std::move(surfaceView),
-                                           fContext->priv().auditTrail()));
+                                           fContext->priv().auditTrail(),
+                                           fContext->priv().options().fExecutor));
     SkASSERT(this->getLastRenderTask(proxy) == opsTask.get());
 
     if (managedOpsTask) {
@@ -37,6 +37,7 @@ class GrSurfaceContext;
 class GrSurfaceProxyView;
 class GrTextureResolveRenderTask;
 class SkDeferredDisplayList;
+struct GrPendingSurfaceUsage;
 
 class GrDrawingManager {
 public:
@@ -109,6 +110,10 @@ public:
         return this->flushSurfaces(&proxy, 1, access, info, newState);
     }
 
+    // Reports the already-instantiated backend surfaces that the DAG's unflushed render tasks
+    // will read and write. See GrDirectContext::pendingSurfaceUsage().
+    void collectPendingSurfaceUsage(GrPendingSurfaceUsage*) const;
+
     void addOnFlushCallbackObject(GrOnFlushCallbackObject*);
 
 #if GR_TEST_UTILS
@@ -131,9 +136,10 @@ private:
         ~RenderTaskDAG();
 
         // Currently, when explicitly allocating resources, this call will topologically sort the
-        // GrRenderTasks.
+        // GrRenderTasks. If 'mergeAdjacentOpsTasks' is true, adjacent opsTasks that render to the
+        // same target are then folded together so they execute as a single render pass.
         // MDB TODO: remove once incremental GrRenderTask sorting is enabled
-        void prepForFlush();
+        void prepForFlush(bool mergeAdjacentOpsTasks);
 
         void closeAll(const GrCaps* caps);
 
@@ -214,6 +220,8 @@ private:
     // This cache is used by both the vertex and index pools. It reuses memory across multiple
     // flushes.
     sk_sp<GrBufferAllocPool::CpuBufferCache> fCpuBufferCache;
+    // This cache recycles the pools' GPU buffers across flushes once the GPU is done with them.
+    sk_sp<GrBufferAllocPool::GpuBufferCache> fGpuBufferCache;
 
     RenderTaskDAG                     fDAG;
     GrOpsTask*                        fActiveOpsTask = nullptr;
@@ -32,9 +32,12 @@
 #include "src/gpu/GrStencilAttachment.h"
 #include "src/gpu/GrStencilSettings.h"
 #include "src/gpu/GrTextureProxyPriv.h"
+
 #include "src/gpu/GrTracing.h"
 #include "src/utils/SkJSONWriter.h"
 
+#include <cstring>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 GrGpu::GrGpu(GrDirectContext* direct) : fResetBits(kAll_GrBackendState), fContext(direct) {}
@@ -941,3 +944,41 @@ bool GrGpu::updateCompressedBackendTexture(const GrBackendTexture& backendTextur
     return this->onUpdateCompressedBackendTexture(backendTexture, std::move(finishedCallback),
                                                   data);
 }
+
+bool GrGpu::opTimingEnabled() const {
+    return fContext->priv().options().fEnableGpuOpTiming;
+}
+
+void GrGpu::recordOpChainTiming(const char* opName, uint32_t beginQuery, uint32_t endQuery) {
+    fPendingOpTimings.push_back({opName, beginQuery, endQuery});
+}
+
+const SkTArray<GrGpuOpTypeTiming>& GrGpu::opTypeTimings() {
+    for (const PendingOpTiming& pending : fPendingOpTimings) {
+        uint64_t begin = this->onFinishTimestampQuery(pending.fBeginQuery);
+        uint64_t end   = this->onFinishTimestampQuery(pending.fEndQuery);
+        if (end <= begin) {
+            continue;
+        }
+        GrGpuOpTypeTiming* entry = nullptr;
+        for (GrGpuOpTypeTiming& timing : fOpTypeTimings) {
+            if (0 == strcmp(timing.fOpName, pending.fOpName)) {
+                entry = &timing;
+                break;
+            }
+        }
+        if (!entry) {
+            entry = &fOpTypeTimings.push_back({pending.fOpName, 0, 0});
+        }
+        entry->fTotalNanos += end - begin;
+        entry->fCount++;
+    }
+    fPendingOpTimings.reset();
+    return fOpTypeTimings;
+}
+
+void GrGpu::resetOpTypeTimings() {
+    // Resolve (and thereby delete) any outstanding queries before dropping the table.
+    this->opTypeTimings();
+    fOpTypeTimings.reset();
+}
@@ -42,6 +42,14 @@ class GrSurface;
 class GrTexture;
 class SkJSONWriter;
 
+// Per-op-type accumulation of GPU execution time, gathered when
+// GrContextOptions::fEnableGpuOpTiming is set and the backend supports timestamp queries.
+struct GrGpuOpTypeTiming {
+    const char* fOpName;      // GrOp::name(); a static string.
+    uint64_t    fTotalNanos;  // Summed GPU time across executed chains.
+    int         fCount;       // Number of chains timed.
+};
+
 class GrGpu : public SkRefCnt {
 public:
     GrGpu(GrDirectContext* direct);
@@ -709,6 +717,23 @@ public:
     // Called before certain draws in order to guarantee coherent results from dst reads.
     virtual void xferBarrier(GrRenderTarget*, GrXferBarrierType) = 0;
 
+    // True when op chains should be bracketed with timestamp queries during execution.
+    bool opTimingEnabled() const;
+
+    // Writes a timestamp into the GPU command stream and returns a nonzero query handle, or 0
+    // if the backend can't measure GPU time.
+    virtual uint32_t insertTimestampQuery() { return 0; }
+
+    // Remembers the begin/end timestamp pair bracketing an executed op chain. The queries are
+    // resolved (and deleted) by the next opTypeTimings() call.
+    void recordOpChainTiming(const char* opName, uint32_t beginQuery, uint32_t endQuery);
+
+    // Resolves outstanding timestamp queries, blocking on the GPU if their results aren't ready
+    // yet, and returns the accumulated per-op-type table.
+    const SkTArray<GrGpuOpTypeTiming>& opTypeTimings();
+
+    void resetOpTypeTimings();
+
 protected:
     static bool MipMapsAreCorrect(SkISize dimensions, GrMipmapped, const BackendTextureData*);
     static bool CompressedDataIsCorrect(SkISize dimensions, SkImage::CompressionType,
@@ -726,6 +751,11 @@ protected:
     sk_sp<const GrCaps>              fCaps;
 
 private:
+    // Returns the timestamp written by the given query in nanoseconds, blocking until the
+    // result is available, and deletes the query. Only called with handles previously returned
+    // by insertTimestampQuery().
+    virtual uint64_t onFinishTimestampQuery(uint32_t) { return 0; }
+
     virtual GrBackendTexture onCreateBackendTexture(SkISize dimensions,
                                                     const GrBackendFormat&,
                                                     GrRenderable,
@@ -867,6 +897,14 @@ private:
     };
     SkSTArray<4, SubmittedProc> fSubmittedProcs;
 
+    struct PendingOpTiming {
+        const char* fOpName;
+        uint32_t    fBeginQuery;
+        uint32_t    fEndQuery;
+    };
+    SkTArray<PendingOpTiming> fPendingOpTimings;
+    SkTArray<GrGpuOpTypeTiming> fOpTypeTimings;
+
     bool fOOMed = false;
 
     friend class GrPathRendering;
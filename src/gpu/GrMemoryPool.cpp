@@ -64,6 +64,11 @@ void* GrMemoryPool::allocate(size_t size) {
     // Update live count within the block
     alloc.fBlock->setMetadata(alloc.fBlock->metadata() + 1);
 
+    size_t occupiedBytes = alloc.fEnd - alloc.fStart;
+    fCumulativeBytes += occupiedBytes;
+    fOutstandingBytes += occupiedBytes;
+    fHighWaterBytes = std::max(fHighWaterBytes, fOutstandingBytes);
+
 #ifdef SK_DEBUG
     header->fSentinel = GrBlockAllocator::kAssignedMarker;
     header->fID = []{
@@ -88,6 +93,9 @@ void GrMemoryPool::release(void* p) {
 
     GrBlockAllocator::Block* block = fAllocator.owningBlock<kAlignment>(header, header->fStart);
 
+    SkASSERT(fOutstandingBytes >= (size_t) (header->fEnd - header->fStart));
+    fOutstandingBytes -= header->fEnd - header->fStart;
+
 #ifdef SK_DEBUG
     header->fSentinel = GrBlockAllocator::kFreedMarker;
     fAllocatedIDs.remove(header->fID);
@@ -105,6 +113,20 @@ void GrMemoryPool::release(void* p) {
     }
 }
 
+GrMemoryPool::Stats GrMemoryPool::stats() const {
+    Stats stats;
+    stats.fTotalBytes = fAllocator.totalSize();
+    stats.fBlockCount = 0;
+    for (const auto* b : fAllocator.blocks()) {
+        (void) b;
+        stats.fBlockCount++;
+    }
+    stats.fOutstandingBytes = fOutstandingBytes;
+    stats.fHighWaterBytes = fHighWaterBytes;
+    stats.fCumulativeBytes = fCumulativeBytes;
+    return stats;
+}
+
 #ifdef SK_DEBUG
 void GrMemoryPool::validate() const {
     fAllocator.validate();
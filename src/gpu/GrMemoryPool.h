@@ -14,6 +14,15 @@
 #include "include/private/SkTHash.h"
 #endif
 
+// Set this to 1 to have GrOpMemoryPool histogram the GrOp sizes requested from it, so that the
+// pool's prealloc and block sizes can be tuned for the op mix of a given workload. The counts are
+// reported through GrContext::dumpMemoryStatistics.
+#define GR_OP_SIZE_HISTOGRAM 0
+
+#if GR_OP_SIZE_HISTOGRAM
+#include "src/core/SkMathPriv.h"
+#endif
+
 /**
  * Allocates memory in blocks and parcels out space in the blocks for allocation requests. It is
  * optimized for allocate / release speed over memory efficiency. The interface is designed to be
@@ -84,6 +93,18 @@ public:
         return offsetof(GrMemoryPool, fAllocator) + fAllocator.preallocSize();
     }
 
+    /**
+     * A snapshot of the pool's instrumentation counters, for tuning prealloc and block sizes.
+     */
+    struct Stats {
+        size_t fTotalBytes;        // bytes currently held from the system, incl. the prealloc block
+        int    fBlockCount;        // blocks backing fTotalBytes, incl. the prealloc block
+        size_t fOutstandingBytes;  // bytes parceled out to live allocations, incl. header overhead
+        size_t fHighWaterBytes;    // largest fOutstandingBytes seen over the pool's lifetime
+        size_t fCumulativeBytes;   // total bytes ever parceled out by allocate()
+    };
+    Stats stats() const;
+
 #ifdef SK_DEBUG
     void validate() const;
 #endif
@@ -107,6 +128,10 @@ private:
     int              fAllocationCount;
 #endif
 
+    size_t           fOutstandingBytes = 0;
+    size_t           fHighWaterBytes = 0;
+    size_t           fCumulativeBytes = 0;
+
     GrBlockAllocator fAllocator; // Must be the last field, in order to use extra allocated space
 
     friend class GrOpMemoryPool;
@@ -125,16 +150,43 @@ public:
         return std::unique_ptr<Op>(new (mem) Op(std::forward<OpArgs>(opArgs)...));
     }
 
-    void* allocate(size_t size) { return fPool.allocate(size); }
+    void* allocate(size_t size) {
+#if GR_OP_SIZE_HISTOGRAM
+        this->recordOpSize(size);
+#endif
+        return fPool.allocate(size);
+    }
 
     void release(std::unique_ptr<GrOp> op);
 
     bool isEmpty() const { return fPool.isEmpty(); }
 
+    GrMemoryPool::Stats stats() const { return fPool.stats(); }
+
+#if GR_OP_SIZE_HISTOGRAM
+    // Power-of-two buckets covering sizes of 32 bytes through 64 KB; the last bucket collects
+    // everything larger.
+    static constexpr int kOpSizeHistogramBuckets = 12;
+
+    // Upper bound (inclusive) of the sizes counted by a bucket.
+    static size_t OpSizeBucketMax(int bucket) { return (size_t)1 << (bucket + 5); }
+
+    const int* opSizeHistogram() const { return fOpSizeHistogram; }
+#endif
+
 private:
     GrOpMemoryPool(size_t preallocSize, size_t minAllocSize)
             : fPool(preallocSize - offsetof(GrOpMemoryPool, fPool), minAllocSize) {}
 
+#if GR_OP_SIZE_HISTOGRAM
+    void recordOpSize(size_t size) {
+        int bucket = SkTPin(SkNextLog2(SkToU32(size)) - 5, 0, kOpSizeHistogramBuckets - 1);
+        fOpSizeHistogram[bucket]++;
+    }
+
+    int fOpSizeHistogram[kOpSizeHistogramBuckets] = {};
+#endif
+
     GrMemoryPool fPool; // Must be the last field
 };
 
@@ -22,10 +22,11 @@
 
 GrOpFlushState::GrOpFlushState(GrGpu* gpu, GrResourceProvider* resourceProvider,
                                GrTokenTracker* tokenTracker,
-                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache)
-        : fVertexPool(gpu, cpuBufferCache)
-        , fIndexPool(gpu, cpuBufferCache)
-        , fDrawIndirectPool(gpu, std::move(cpuBufferCache))
+                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache,
+                               sk_sp<GrBufferAllocPool::GpuBufferCache> gpuBufferCache)
+        : fVertexPool(gpu, cpuBufferCache, gpuBufferCache)
+        , fIndexPool(gpu, cpuBufferCache, gpuBufferCache)
+        , fDrawIndirectPool(gpu, std::move(cpuBufferCache), std::move(gpuBufferCache))
         , fGpu(gpu)
         , fResourceProvider(resourceProvider)
         , fTokenTracker(tokenTracker) {}
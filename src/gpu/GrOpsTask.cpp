@@ -7,9 +7,11 @@
 
 #include "src/gpu/GrOpsTask.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/gpu/GrRecordingContext.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkScopeExit.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/GrAuditTrail.h"
 #include "src/gpu/GrCaps.h"
@@ -357,10 +359,12 @@ inline void GrOpsTask::OpChain::validate() const {
 
 GrOpsTask::GrOpsTask(GrDrawingManager* drawingMgr, GrRecordingContext::Arenas arenas,
                      GrSurfaceProxyView view,
-                     GrAuditTrail* auditTrail)
+                     GrAuditTrail* auditTrail,
+                     SkExecutor* executor)
         : GrRenderTask()
         , fArenas(arenas)
         , fAuditTrail(auditTrail)
+        , fExecutor(executor)
         SkDEBUGCODE(, fNumClips(0)) {
     this->addTarget(drawingMgr, std::move(view));
 }
@@ -386,6 +390,48 @@ void GrOpsTask::removeClosedObserver(GrOpsTaskClosedObserver* observer) {
     }
 }
 
+bool GrOpsTask::mergeFrom(GrOpsTask* nextTask) {
+    SkASSERT(this != nextTask);
+    SkASSERT(this->isClosed() && nextTask->isClosed());
+
+    if (this->target(0) != nextTask->target(0)) {
+        return false;
+    }
+    // A task that begins by clearing or discarding the color buffer expects to initialize the
+    // target itself; folding it in here would wipe out this task's draws.
+    if (nextTask->fColorLoadOp != GrLoadOp::kLoad) {
+        return false;
+    }
+    // Within a single render pass, nextTask's ops see whatever stencil values this task's ops
+    // leave behind, which is exactly what consecutive passes produce for kDontCare and kPreserved.
+    // A task that expects freshly cleared user bits can only be folded into a pass that also
+    // starts from cleared user bits, since renderTargetContexts are required to leave the user
+    // bits in a cleared state once finished.
+    if (StencilContent::kUserBitsCleared == nextTask->fInitialStencilContent &&
+        StencilContent::kUserBitsCleared != fInitialStencilContent) {
+        return false;
+    }
+
+    fOpChains.move_back_n(nextTask->fOpChains.count(), nextTask->fOpChains.begin());
+    nextTask->fOpChains.reset();
+
+    fSampledProxies.push_back_n(nextTask->fSampledProxies.count(),
+                                nextTask->fSampledProxies.begin());
+    nextTask->fSampledProxies.reset();
+
+    fDeferredProxies.push_back_n(nextTask->fDeferredProxies.count(),
+                                 nextTask->fDeferredProxies.begin());
+    nextTask->fDeferredProxies.reset();
+
+    fMustPreserveStencil |= nextTask->fMustPreserveStencil;
+    fHasWaitOp |= nextTask->fHasWaitOp;
+    nextTask->fHasWaitOp = false;
+
+    fTotalBounds.join(nextTask->fTotalBounds);
+    fClippedContentBounds.join(nextTask->fClippedContentBounds);
+    return true;
+}
+
 void GrOpsTask::endFlush(GrDrawingManager* drawingMgr) {
     fLastClipStackGenID = SK_InvalidUniqueID;
     this->deleteOps();
@@ -576,6 +622,8 @@ bool GrOpsTask::onExecute(GrOpFlushState* flushState) {
     flushState->setOpsRenderPass(renderPass);
     renderPass->begin();
 
+    const bool timeOps = flushState->gpu()->opTimingEnabled();
+
     // Draw all the generated geometry.
     for (const auto& chain : fOpChains) {
         if (!chain.shouldExecute()) {
@@ -584,6 +632,10 @@ bool GrOpsTask::onExecute(GrOpFlushState* flushState) {
 #ifdef SK_BUILD_FOR_ANDROID_FRAMEWORK
         TRACE_EVENT0("skia.gpu", chain.head()->name());
 #endif
+        uint32_t timingBeginQuery = 0;
+        if (timeOps) {
+            timingBeginQuery = flushState->gpu()->insertTimestampQuery();
+        }
 
         GrOpFlushState::OpArgs opArgs(chain.head(),
                                       &fTargets[0],
@@ -593,6 +645,11 @@ bool GrOpsTask::onExecute(GrOpFlushState* flushState) {
         flushState->setOpArgs(&opArgs);
         chain.head()->execute(flushState, chain.bounds());
         flushState->setOpArgs(nullptr);
+
+        if (timingBeginQuery) {
+            flushState->gpu()->recordOpChainTiming(chain.head()->name(), timingBeginQuery,
+                                                   flushState->gpu()->insertTimestampQuery());
+        }
     }
 
     renderPass->end();
@@ -709,6 +766,12 @@ void GrOpsTask::visitProxies_debugOnly(const GrOp::VisitProxyFunc& func) const {
 
 #endif
 
+void GrOpsTask::visitSourceProxies(const GrOp::VisitProxyFunc& func) const {
+    for (const OpChain& chain : fOpChains) {
+        chain.visitProxies(func);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 bool GrOpsTask::onIsUsed(GrSurfaceProxy* proxyToCheck) const {
@@ -847,17 +910,147 @@ void GrOpsTask::recordOp(
     fOpChains.emplace_back(std::move(op), processorAnalysis, clip, dstProxyView);
 }
 
+// Don't bother fanning the reorder analysis out to worker threads for small tasks;
+// the scan is only ~kMaxOpChainDistance rect tests per chain.
+static const int kParallelCombineThreshold = 1024;
+
+void GrOpsTask::cullOccludedOps() {
+    SkASSERT(!this->isClosed());
+
+    // Device-space pixel rects that later chains are known to overwrite with opaque,
+    // dst-independent values. Bounded so early chains only test a handful of rects.
+    static constexpr int kMaxOccluders = 4;
+    SkSTArray<kMaxOccluders, SkIRect, true> occluders;
+
+    SkIRect targetPixels = SkIRect::MakeSize(this->target(0).proxy()->backingStoreDimensions());
+
+    for (int i = fOpChains.count() - 1; i >= 0; --i) {
+        OpChain& chain = fOpChains[i];
+
+        SkIRect chainPixels;
+        chain.bounds().roundOut(&chainPixels);
+        if (chainPixels.intersect(targetPixels)) {
+            bool occluded = false;
+            for (const SkIRect& occluder : occluders) {
+                if (occluder.contains(chainPixels)) {
+                    occluded = true;
+                    break;
+                }
+            }
+            if (occluded) {
+                bool occludable = true;
+                for (const auto& op : GrOp::ChainRange<>(chain.head())) {
+                    if (!op.canBeOccluded()) {
+                        occludable = false;
+                        break;
+                    }
+                }
+                if (occludable) {
+                    GrOP_INFO("opsTask: %d dropping occluded chain (%s, head opID: %u)\n",
+                              this->uniqueID(), chain.head()->name(), chain.head()->uniqueID());
+                    chain.deleteOps(fArenas.opMemoryPool());
+                    continue;
+                }
+            }
+        }
+
+        // A clip restricts where the chain is guaranteed to write, so only unclipped chains
+        // contribute occluding rects.
+        if (chain.appliedClip()) {
+            continue;
+        }
+        for (const auto& op : GrOp::ChainRange<>(chain.head())) {
+            SkIRect covered;
+            if (!op.opaqueCoverage(&covered)) {
+                continue;
+            }
+            bool add = occluders.count() < kMaxOccluders;
+            for (int j = 0; j < occluders.count(); ++j) {
+                if (occluders[j].contains(covered)) {
+                    add = false;
+                    break;
+                }
+                if (covered.contains(occluders[j])) {
+                    occluders[j] = covered;
+                    add = false;
+                    break;
+                }
+            }
+            if (add) {
+                occluders.push_back(covered);
+            }
+        }
+    }
+
+    // Compact out the emptied chains so later passes (e.g. forwardCombine) never see them.
+    int liveCount = 0;
+    for (int i = 0; i < fOpChains.count(); ++i) {
+        if (fOpChains[i].head()) {
+            if (liveCount != i) {
+                fOpChains[liveCount] = std::move(fOpChains[i]);
+            }
+            ++liveCount;
+        }
+    }
+    fOpChains.pop_back_n(fOpChains.count() - liveCount);
+}
+
 void GrOpsTask::forwardCombine(const GrCaps& caps) {
     SkASSERT(!this->isClosed());
     GrOP_INFO("opsTask: %d ForwardCombine %d ops:\n", this->uniqueID(), fOpChains.count());
 
-    for (int i = 0; i < fOpChains.count() - 1; ++i) {
+    int count = fOpChains.count();
+
+    // The bulk of the lookahead scan just reads chain bounds, so with enough chains we
+    // precompute each chain's forward barrier -- the first later chain it cannot be
+    // reordered past -- in parallel, and keep only the merging itself serial. A barrier
+    // is computed from a chain's bounds as recorded; once a chain absorbs another its
+    // bounds grow and its barrier goes stale, so grown chains fall back to live scanning.
+    SkAutoTArray<int> barriers;
+    SkAutoTArray<bool> grew;
+    if (fExecutor && count >= kParallelCombineThreshold) {
+        barriers.reset(count);
+        grew.reset(count);
+        SkTaskGroup taskGroup(*fExecutor);
+        static const int kChunk = 512;
+        taskGroup.batch((count + kChunk - 1) / kChunk, [&](int c) {
+            for (int i = c * kChunk; i < std::min((c + 1) * kChunk, count); i++) {
+                int maxCandidateIdx = std::min(i + kMaxOpChainDistance, count - 1);
+                int j = i + 1;
+                while (j <= maxCandidateIdx &&
+                       can_reorder(fOpChains[i].bounds(), fOpChains[j].bounds())) {
+                    ++j;
+                }
+                // The first chain we intersect may still be a legal merge target,
+                // so the barrier is inclusive.
+                barriers[i] = std::min(j, maxCandidateIdx);
+                grew[i] = false;
+            }
+        });
+        taskGroup.wait();
+    }
+
+    for (int i = 0; i < count - 1; ++i) {
         OpChain& chain = fOpChains[i];
-        int maxCandidateIdx = std::min(i + kMaxOpChainDistance, fOpChains.count() - 1);
+        int maxCandidateIdx = std::min(i + kMaxOpChainDistance, count - 1);
+
+        if (barriers.get() && !grew[i]) {
+            for (int j = i + 1; j <= barriers[i]; ++j) {
+                if (fOpChains[j].prependChain(&chain, caps, &fArenas, fAuditTrail)) {
+                    grew[j] = true;
+                    break;
+                }
+            }
+            continue;
+        }
+
         int j = i + 1;
         while (true) {
             OpChain& candidate = fOpChains[j];
             if (candidate.prependChain(&chain, caps, &fArenas, fAuditTrail)) {
+                if (grew.get()) {
+                    grew[j] = true;
+                }
                 break;
             }
             // Stop traversing if we would cause a painter's order violation.
@@ -880,6 +1073,7 @@ void GrOpsTask::forwardCombine(const GrCaps& caps) {
 
 GrRenderTask::ExpectedOutcome GrOpsTask::onMakeClosed(
         const GrCaps& caps, SkIRect* targetUpdateBounds) {
+    this->cullOccludedOps();
     this->forwardCombine(caps);
     SkScopeExit triggerObservers([&] {
         for (const auto& o : fClosedObservers) {
@@ -32,6 +32,7 @@ class GrCaps;
 class GrClearOp;
 class GrGpuBuffer;
 class GrRenderTargetProxy;
+class SkExecutor;
 
 /** Observer is notified when a GrOpsTask is closed. */
 class GrOpsTaskClosedObserver {
@@ -51,7 +52,10 @@ private:
 public:
     // The Arenas must outlive the GrOpsTask, either by preserving the context that owns
     // the pool, or by moving the pool to the DDL that takes over the GrOpsTask.
-    GrOpsTask(GrDrawingManager*, GrRecordingContext::Arenas, GrSurfaceProxyView, GrAuditTrail*);
+    // The executor, if any, parallelizes the reorder analysis when the task is closed;
+    // it comes from GrContextOptions::fExecutor and must outlive the task.
+    GrOpsTask(GrDrawingManager*, GrRecordingContext::Arenas, GrSurfaceProxyView, GrAuditTrail*,
+              SkExecutor*);
     ~GrOpsTask() override;
 
     GrOpsTask* asOpsTask() override { return this; }
@@ -65,6 +69,15 @@ public:
 
     bool isEmpty() const { return fOpChains.empty(); }
 
+    /**
+     * Attempts to fold 'nextTask' into this task so both execute in a single render pass.
+     * 'nextTask' must be the task that executes immediately after this one and must render to the
+     * same target. On success its op chains are moved to the tail of this task's chains and it is
+     * left behind as an empty no-op; it must stay alive until the flush completes because the
+     * moved chains still reference clip state in its arena.
+     */
+    bool mergeFrom(GrOpsTask* nextTask);
+
     /**
      * Empties the draw buffer of any queued up draws.
      */
@@ -129,6 +142,8 @@ public:
 
     void discard();
 
+    void visitSourceProxies(const GrOp::VisitProxyFunc&) const override;
+
 #ifdef SK_DEBUG
     void dump(bool printDependencies) const override;
     const char* name() const final { return "Ops"; }
@@ -291,6 +306,9 @@ private:
 
     void forwardCombine(const GrCaps&);
 
+    // Deletes chains of occludable ops whose bounds are opaquely overwritten by a later op.
+    void cullOccludedOps();
+
     ExpectedOutcome onMakeClosed(const GrCaps& caps, SkIRect* targetUpdateBounds) override;
 
     friend class GrRenderTargetContextPriv; // for stencil clip state. TODO: this is invasive
@@ -306,6 +324,7 @@ private:
     // into the owning DDL.
     GrRecordingContext::Arenas fArenas;
     GrAuditTrail*              fAuditTrail;
+    SkExecutor*                fExecutor;
 
     SkSTArray<2, GrOpsTaskClosedObserver*, true> fClosedObservers;
 
@@ -6,6 +6,7 @@
  */
 
 #include "src/core/SkClipOpPriv.h"
+#include "src/core/SkRRectPriv.h"
 #include "src/gpu/GrAppliedClip.h"
 #include "src/gpu/GrClip.h"
 #include "src/gpu/GrColor.h"
@@ -138,6 +139,21 @@ GrReducedClip::GrReducedClip(const SkClipStack& stack, const SkRect& queryBounds
     }
 }
 
+// Decides whether an element's geometry lies entirely outside the query bounds. The bounds
+// comparison handles most cases; for rrect elements the actual corner geometry is also checked,
+// so a query tucked into the cut-away part of a corner is recognized as outside rather than
+// producing a clip mask or analytic FP.
+static bool element_is_outside(const SkClipStack::Element* element,
+                               const SkRect& queryBounds,
+                               const SkRect& relaxedQueryBounds) {
+    if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+        return true;
+    }
+    using Element = SkClipStack::Element;
+    return element->getDeviceSpaceType() == Element::DeviceSpaceType::kRRect &&
+           !SkRRectPriv::IntersectsRect(element->getDeviceSpaceRRect(), relaxedQueryBounds);
+}
+
 void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBounds) {
     // walk backwards until we get to:
     //  a) the beginning
@@ -202,7 +218,7 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                 if (element->isInverseFilled()) {
                     if (element->contains(relaxedQueryBounds)) {
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllOut;
                         skippable = true;
                     } else if (!embiggens) {
@@ -216,7 +232,7 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                     if (element->contains(relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllOut;
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         skippable = true;
                     } else if (!embiggens) {
                         ClipResult result = this->clipOutsideElement(element);
@@ -238,7 +254,7 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                     if (element->contains(relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllOut;
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         skippable = true;
                     } else if (!embiggens) {
                         ClipResult result = this->clipOutsideElement(element);
@@ -250,7 +266,7 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                 } else {
                     if (element->contains(relaxedQueryBounds)) {
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllOut;
                         skippable = true;
                     } else if (!embiggens) {
@@ -272,7 +288,7 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                 if (element->isInverseFilled()) {
                     if (element->contains(relaxedQueryBounds)) {
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllIn;
                         skippable = true;
                     }
@@ -280,7 +296,7 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                     if (element->contains(relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllIn;
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         skippable = true;
                     }
                 }
@@ -296,13 +312,13 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                 if (element->isInverseFilled()) {
                     if (element->contains(relaxedQueryBounds)) {
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         isFlip = true;
                     }
                 } else {
                     if (element->contains(relaxedQueryBounds)) {
                         isFlip = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         skippable = true;
                     }
                 }
@@ -319,13 +335,13 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                     if (element->contains(relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllOut;
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         isFlip = true;
                     }
                 } else {
                     if (element->contains(relaxedQueryBounds)) {
                         isFlip = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllOut;
                         skippable = true;
                     }
@@ -344,7 +360,7 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                     if (element->contains(relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllOut;
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllIn;
                         skippable = true;
                     } else if (!embiggens) {
@@ -361,7 +377,7 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
                     if (element->contains(relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllIn;
                         skippable = true;
-                    } else if (GrClip::IsOutsideClip(element->getBounds(), queryBounds)) {
+                    } else if (element_is_outside(element, queryBounds, relaxedQueryBounds)) {
                         initialTriState = InitialTriState::kAllOut;
                         skippable = true;
                     } else if (!embiggens) {
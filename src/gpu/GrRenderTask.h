@@ -75,6 +75,12 @@ public:
      */
     virtual GrOpsTask* asOpsTask() { return nullptr; }
 
+    /*
+     * Calls fn for each source proxy this task reads. Target proxies are not included; a task
+     * that reads and writes the same proxy (e.g. a texture resolve) reports it only as a target.
+     */
+    virtual void visitSourceProxies(const GrOp::VisitProxyFunc&) const {}
+
 #ifdef SK_DEBUG
     /*
      * Dump out the GrRenderTask dependency DAG
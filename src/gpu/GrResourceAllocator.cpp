@@ -281,7 +281,11 @@ sk_sp<GrSurface> GrResourceAllocator::findSurfaceFor(const GrSurfaceProxy* proxy
     }
 
     // Failing that, try to grab a new one from the resource cache
-    return proxy->priv().createSurface(fResourceProvider);
+    sk_sp<GrSurface> newSurface = proxy->priv().createSurface(fResourceProvider);
+    if (newSurface) {
+        fFlushBytesAllocated += newSurface->gpuMemorySize();
+    }
+    return newSurface;
 }
 
 // Remove any intervals that end before the current index. Return their GrSurfaces
@@ -332,6 +336,25 @@ void GrResourceAllocator::forceIntermediateFlush(int* stopIndex) {
     SkASSERT(fCurOpsTaskIndex < fNumOpsTasks);
 
     this->expire(tmp->start());
+
+    // We're splitting this flush to reduce memory pressure, so also return the free pool's
+    // surfaces to the resource cache. That lets the memory the completed sub-flush no longer
+    // needs be purged once the GPU is done with it, at the cost of re-allocating any surfaces
+    // the remaining opsTasks could have recycled.
+    fFreePool.reset();
+    fFlushBytesAllocated = 0;
+}
+
+bool GrResourceAllocator::overBudget() const {
+    if (fResourceProvider->overBudget()) {
+        return true;
+    }
+
+    // The cache only counts budgeted resources, so a flush dominated by unbudgeted or
+    // lazily-instantiated surfaces can transiently blow past the limit without tripping the
+    // check above. Compare the memory this flush has itself instantiated against the budget
+    // as well.
+    return fFlushBytesAllocated > fResourceProvider->maxResourceBytes();
 }
 
 bool GrResourceAllocator::assign(int* startIndex, int* stopIndex, AssignError* outError) {
@@ -381,7 +404,7 @@ bool GrResourceAllocator::assign(int* startIndex, int* stopIndex, AssignError* o
         if (cur->proxy()->isInstantiated()) {
             fActiveIntvls.insertByIncreasingEnd(cur);
 
-            if (fResourceProvider->overBudget()) {
+            if (this->overBudget()) {
                 // Only force intermediate draws on opsTask boundaries
                 if (this->onOpsTaskBoundary()) {
                     this->forceIntermediateFlush(stopIndex);
@@ -395,6 +418,8 @@ bool GrResourceAllocator::assign(int* startIndex, int* stopIndex, AssignError* o
         if (cur->proxy()->isLazy()) {
             if (!cur->proxy()->priv().doLazyInstantiation(fResourceProvider)) {
                 *outError = AssignError::kFailedProxyInstantiation;
+            } else {
+                fFlushBytesAllocated += cur->proxy()->gpuMemorySize(*fResourceProvider->caps());
             }
         } else if (sk_sp<GrSurface> surface = this->findSurfaceFor(cur->proxy())) {
             // TODO: make getUniqueKey virtual on GrSurfaceProxy
@@ -422,7 +447,7 @@ bool GrResourceAllocator::assign(int* startIndex, int* stopIndex, AssignError* o
 
         fActiveIntvls.insertByIncreasingEnd(cur);
 
-        if (fResourceProvider->overBudget()) {
+        if (this->overBudget()) {
             // Only force intermediate draws on opsTask boundaries
             if (this->onOpsTaskBoundary()) {
                 this->forceIntermediateFlush(stopIndex);
@@ -119,6 +119,12 @@ private:
     bool onOpsTaskBoundary() const;
     void forceIntermediateFlush(int* stopIndex);
 
+    // Returns true when this flush should be split at the next opsTask boundary to keep peak
+    // memory bounded. Checks both the resource cache's budget and the memory this flush has
+    // itself instantiated, since the latter can exceed the budget without the cache noticing
+    // (e.g. when the flush is dominated by unbudgeted or lazily-instantiated surfaces).
+    bool overBudget() const;
+
     // These two methods wrap the interactions with the free pool
     void recycleSurface(sk_sp<GrSurface> surface);
     sk_sp<GrSurface> findSurfaceFor(const GrSurfaceProxy* proxy);
@@ -262,6 +268,8 @@ private:
     IntervalList                 fActiveIntvls;      // List of live intervals during assignment
                                                      // (sorted by increasing end)
     unsigned int                 fNumOps = 0;
+    size_t                       fFlushBytesAllocated = 0; // GPU memory instantiated so far for
+                                                           // the current (sub-)flush
     SkTArray<unsigned int>       fEndOfOpsTaskOpIndices;
     int                          fCurOpsTaskIndex = 0;
     SkDEBUGCODE(const int        fNumOpsTasks = -1;)
@@ -514,6 +514,15 @@ void GrResourceCache::purgeAsNeeded() {
 
     this->processFreedGpuResources();
 
+    if (fPendingAgePurgeTime > GrStdSteadyClock::time_point::min()) {
+        // Continue a deferred purge-by-age a batch at a time so no single call releases an
+        // unbounded number of resources.
+        static const int kAgePurgeBatchSize = 64;
+        GrStdSteadyClock::time_point purgeTime = fPendingAgePurgeTime;
+        fPendingAgePurgeTime = GrStdSteadyClock::time_point::min();
+        this->purgeResourcesNotUsedSince(purgeTime, kAgePurgeBatchSize);
+    }
+
     bool stillOverbudget = this->overBudget();
     while (stillOverbudget && fPurgeableQueue.count()) {
         GrGpuResource* resource = fPurgeableQueue.peek();
@@ -558,8 +567,16 @@ void GrResourceCache::purgeUnlockedResources(bool scratchResourcesOnly) {
     this->validate();
 }
 
-void GrResourceCache::purgeResourcesNotUsedSince(GrStdSteadyClock::time_point purgeTime) {
+void GrResourceCache::purgeResourcesNotUsedSince(GrStdSteadyClock::time_point purgeTime,
+                                                 int maxResources) {
+    int purged = 0;
     while (fPurgeableQueue.count()) {
+        if (maxResources >= 0 && purged >= maxResources) {
+            // We've done our allotment of work; remember the cutoff so purgeAsNeeded can keep
+            // chipping away at the remainder.
+            fPendingAgePurgeTime = std::max(fPendingAgePurgeTime, purgeTime);
+            return;
+        }
         const GrStdSteadyClock::time_point resourceTime =
                 fPurgeableQueue.peek()->cacheAccess().timeWhenResourceBecamePurgeable();
         if (resourceTime >= purgeTime) {
@@ -573,6 +590,11 @@ void GrResourceCache::purgeResourcesNotUsedSince(GrStdSteadyClock::time_point pu
         GrGpuResource* resource = fPurgeableQueue.peek();
         SkASSERT(resource->resourcePriv().isPurgeable());
         resource->cacheAccess().release();
+        ++purged;
+    }
+    if (purgeTime >= fPendingAgePurgeTime) {
+        // This purge subsumed any deferred one.
+        fPendingAgePurgeTime = GrStdSteadyClock::time_point::min();
     }
 }
 
@@ -159,8 +159,10 @@ public:
     // be deleted.
     void purgeUnlockedResources(bool scratchResourcesOnly);
 
-    /** Purge all resources not used since the passed in time. */
-    void purgeResourcesNotUsedSince(GrStdSteadyClock::time_point);
+    /** Purge all resources not used since the passed in time. If 'maxResources' is >= 0 then at
+        most that many resources are released now; the remainder are released a batch at a time by
+        later purgeAsNeeded calls, bounding the work done in any one call. */
+    void purgeResourcesNotUsedSince(GrStdSteadyClock::time_point, int maxResources = -1);
 
     bool overBudget() const { return fBudgetedBytes > fMaxBytes; }
 
@@ -355,6 +357,10 @@ private:
     size_t                              fPurgeableBytes = 0;
     int                                 fNumBudgetedResourcesFlushWillMakePurgeable = 0;
 
+    // Cutoff of a purge-by-age that hit its work limit; purgeAsNeeded continues it a batch at a
+    // time until no purgeable resource predates the cutoff.
+    GrStdSteadyClock::time_point        fPendingAgePurgeTime = GrStdSteadyClock::time_point::min();
+
     InvalidUniqueKeyInbox               fInvalidUniqueKeyInbox;
     FreedTextureInbox                   fFreedTextureInbox;
     TexturesAwaitingUnref               fTexturesAwaitingUnref;
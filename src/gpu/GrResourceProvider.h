@@ -299,6 +299,7 @@ public:
     uint32_t contextUniqueID() const { return fCache->contextUniqueID(); }
     const GrCaps* caps() const { return fCaps.get(); }
     bool overBudget() const { return fCache->overBudget(); }
+    size_t maxResourceBytes() const { return fCache->getMaxResourceBytes(); }
 
     static SkISize MakeApprox(SkISize);
 
@@ -9,6 +9,7 @@
 
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/SkSemaphore.h"
+#include "src/core/SkIPoint16.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/GrAuditTrail.h"
@@ -20,6 +21,7 @@
 #include "src/gpu/GrOpFlushState.h"
 #include "src/gpu/GrProxyProvider.h"
 #include "src/gpu/GrRecordingContextPriv.h"
+#include "src/gpu/GrRectanizerSkyline.h"
 #include "src/gpu/GrRenderTargetContextPriv.h"
 #include "src/gpu/GrSWMaskHelper.h"
 #include "src/gpu/GrSurfaceContextPriv.h"
@@ -27,6 +29,15 @@
 #include "src/gpu/geometry/GrStyledShape.h"
 #include "src/gpu/ops/GrDrawOp.h"
 
+// Masks no larger than this on either axis are packed into a shared atlas page rather than
+// getting a dedicated texture, so that runs of small path draws (e.g. icon-heavy UIs) all
+// sample the same texture and their quads can batch into one draw.
+static constexpr int kMaxAtlasedMaskDim = 128;
+static constexpr int kAtlasPageDim = 512;
+// Each atlased mask keeps a transparent pixel of padding on every side so that neighboring
+// masks can never bleed into each other.
+static constexpr int kAtlasPadding = 1;
+
 ////////////////////////////////////////////////////////////////////////////////
 GrPathRenderer::CanDrawPath
 GrSoftwarePathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
@@ -218,6 +229,86 @@ private:
     GrAA fAA;
 };
 
+/**
+ * Empty payload for the shared atlas page's GrTDeferredProxyUploader. The page's pixels are
+ * rasterized in place on the recording thread, so the uploader only provides pixel storage and
+ * upload scheduling.
+ */
+struct AtlasPagePayload {};
+
+}
+
+bool GrSoftwarePathRenderer::initAtlasPage(GrRecordingContext* context) {
+    GrSurfaceProxyView view = make_deferred_mask_texture_view(context, SkBackingFit::kExact,
+                                                              {kAtlasPageDim, kAtlasPageDim});
+    if (!view) {
+        return false;
+    }
+
+    auto uploader = std::make_unique<GrTDeferredProxyUploader<AtlasPagePayload>>();
+    SkAutoPixmapStorage* pixels = uploader->getPixels();
+    if (!pixels->tryAlloc(SkImageInfo::MakeA8(kAtlasPageDim, kAtlasPageDim))) {
+        return false;
+    }
+    pixels->erase(0);
+    // All rasterization into the page happens on the recording thread, ahead of the flush that
+    // schedules the upload, so the pixels are "ready" as far as the uploader is concerned.
+    uploader->signalAndFreeData();
+    view.asTextureProxy()->texPriv().setDeferredUploader(std::move(uploader));
+
+    fAtlasView = std::move(view);
+    fAtlasPixels = pixels;
+    if (fAtlasRectanizer) {
+        fAtlasRectanizer->reset();
+    } else {
+        fAtlasRectanizer = std::make_unique<GrRectanizerSkyline>(kAtlasPageDim, kAtlasPageDim);
+    }
+    return true;
+}
+
+bool GrSoftwarePathRenderer::getAtlasedMask(GrRecordingContext* context,
+                                            const GrStyledShape& shape,
+                                            const SkMatrix& viewMatrix,
+                                            GrAA aa,
+                                            const SkIRect& maskBounds,
+                                            GrSurfaceProxyView* view,
+                                            SkIPoint16* atlasLocation) {
+    if (maskBounds.width() > kMaxAtlasedMaskDim || maskBounds.height() > kMaxAtlasedMaskDim) {
+        return false;
+    }
+
+    int paddedWidth  = maskBounds.width()  + 2 * kAtlasPadding;
+    int paddedHeight = maskBounds.height() + 2 * kAtlasPadding;
+
+    SkIPoint16 loc;
+    if (!fAtlasView || fAtlasView.asTextureProxy()->isInstantiated() ||
+        !fAtlasRectanizer->addRect(paddedWidth, paddedHeight, &loc)) {
+        // Either there is no open page, the open page was already uploaded by a flush (so its
+        // pixels can no longer be touched), or it is full. Open a fresh page; the old one lives
+        // on through the proxies that reference it.
+        if (!this->initAtlasPage(context) ||
+            !fAtlasRectanizer->addRect(paddedWidth, paddedHeight, &loc)) {
+            return false;
+        }
+    }
+
+    SkAutoPixmapStorage maskPixels;
+    GrSWMaskHelper helper(&maskPixels);
+    if (!helper.init(maskBounds)) {
+        return false;
+    }
+    helper.drawShape(shape, viewMatrix, SkRegion::kReplace_Op, aa, 0xFF);
+
+    int dstX = loc.fX + kAtlasPadding;
+    int dstY = loc.fY + kAtlasPadding;
+    for (int y = 0; y < maskBounds.height(); ++y) {
+        memcpy(fAtlasPixels->writable_addr8(dstX, dstY + y), maskPixels.addr8(0, y),
+               maskBounds.width());
+    }
+
+    *view = fAtlasView;
+    atlasLocation->set(dstX, dstY);
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -327,6 +418,22 @@ bool GrSoftwarePathRenderer::onDrawPath(const DrawPathArgs& args) {
         SkBackingFit fit = useCache ? SkBackingFit::kExact : SkBackingFit::kApprox;
         GrAA aa = GrAA(GrAAType::kCoverage == args.fAAType);
 
+        // Small one-off masks go into the shared atlas page instead of a dedicated texture.
+        if (!useCache && !inverseFilled) {
+            SkIPoint16 atlasLocation;
+            if (this->getAtlasedMask(args.fContext, *args.fShape, *args.fViewMatrix, aa,
+                                     *boundsForMask, &view, &atlasLocation)) {
+                args.fContext->priv().stats()->incNumPathMasksGenerated();
+                DrawToTargetWithShapeMask(
+                        std::move(view), args.fRenderTargetContext, std::move(args.fPaint),
+                        *args.fUserStencilSettings, args.fClip, *args.fViewMatrix,
+                        SkIPoint{boundsForMask->fLeft - atlasLocation.fX,
+                                 boundsForMask->fTop - atlasLocation.fY},
+                        *boundsForMask);
+                return true;
+            }
+        }
+
         SkTaskGroup* taskGroup = nullptr;
         if (auto direct = args.fContext->asDirectContext()) {
             taskGroup = direct->priv().getTaskGroup();
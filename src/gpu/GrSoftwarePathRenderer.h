@@ -12,6 +12,9 @@
 #include "src/gpu/GrSurfaceProxyView.h"
 
 class GrProxyProvider;
+class GrRectanizerSkyline;
+class SkAutoPixmapStorage;
+struct SkIPoint16;
 
 /**
  * This class uses the software side to render a path to an SkBitmap and
@@ -70,10 +73,32 @@ private:
 
     bool onDrawPath(const DrawPathArgs&) override;
 
+    // Rasterizes a small, uncached mask with GrSWMaskHelper and packs it into the shared atlas
+    // page. On success 'view' refers to the atlas page and 'atlasLocation' is the top-left of
+    // the mask within it. Runs of small path draws thus sample a single texture and their quads
+    // can batch into one draw.
+    bool getAtlasedMask(GrRecordingContext*,
+                        const GrStyledShape&,
+                        const SkMatrix& viewMatrix,
+                        GrAA aa,
+                        const SkIRect& maskBounds,
+                        GrSurfaceProxyView* view,
+                        SkIPoint16* atlasLocation);
+
+    // Opens a fresh atlas page, abandoning the current one (if any) to the proxies that
+    // reference it.
+    bool initAtlasPage(GrRecordingContext*);
+
 private:
     GrProxyProvider*       fProxyProvider;
     bool                   fAllowCaching;
 
+    // The open atlas page for small masks. fAtlasPixels points at storage owned by the page
+    // proxy's deferred uploader and is valid only until that proxy is instantiated by a flush.
+    GrSurfaceProxyView                    fAtlasView;
+    SkAutoPixmapStorage*                  fAtlasPixels = nullptr;
+    std::unique_ptr<GrRectanizerSkyline>  fAtlasRectanizer;
+
     typedef GrPathRenderer INHERITED;
 };
 
@@ -31,6 +31,9 @@ private:
         SkASSERT(0 == this->numTargets());
         return proxy == fSrcProxy.get();
     }
+    void visitSourceProxies(const GrOp::VisitProxyFunc& fn) const override {
+        fn(fSrcProxy.get(), GrMipmapped::kNo);
+    }
     // If fSrcProxy is uninstantiated at flush time we simply will skip doing the transfer.
     void handleInternalAllocationFailure() override {}
     void gatherProxyIntervals(GrResourceAllocator*) const override;
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/GrTriangulationCache.h"
+
+#include "include/private/SkIDChangeListener.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/gpu/GrEagerVertexAllocator.h"
+#include "src/gpu/GrTriangulator.h"
+
+namespace {
+
+// This creates a domain of keys in SkResourceCache used by this file.
+static void* kNamespace;
+
+struct TriangulationKey : public SkResourceCache::Key {
+    uint32_t fGenID;
+
+    TriangulationKey(uint32_t genID) : fGenID(genID) {
+        this->init(&kNamespace, 0, sizeof(fGenID));
+    }
+};
+
+class TriangulationRec : public SkResourceCache::Rec {
+public:
+    TriangulationRec(const TriangulationKey& key,
+                     const GrTriangulationCache::Triangulation& triangulation)
+            : fKey(key)
+            , fTriangulation(triangulation) {}
+
+    const Key& getKey() const override { return fKey; }
+
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fTriangulation.fVertexData->size();
+    }
+
+    const char* getCategory() const override { return "path-triangulation"; }
+
+    const GrTriangulationCache::Triangulation& triangulation() const { return fTriangulation; }
+
+private:
+    TriangulationKey fKey;
+    GrTriangulationCache::Triangulation fTriangulation;
+};
+
+// When the SkPathRef genID changes, purge the stale triangulation.
+class TriangulationInvalidator : public SkIDChangeListener {
+public:
+    TriangulationInvalidator(const TriangulationKey& key) : fKey(key) {}
+
+private:
+    // always purge
+    static bool FindVisitor(const SkResourceCache::Rec&, void*) {
+        return false;
+    }
+
+    void changed() override {
+        SkResourceCache::Find(fKey, TriangulationInvalidator::FindVisitor, nullptr);
+    }
+
+    TriangulationKey fKey;
+};
+
+struct FindContext {
+    GrTriangulationCache::Triangulation* fTriangulation;
+    SkScalar fTolerance;
+};
+
+bool find_visitor(const SkResourceCache::Rec& baseRec, void* ctx) {
+    const TriangulationRec& rec = static_cast<const TriangulationRec&>(baseRec);
+    FindContext* findContext = static_cast<FindContext*>(ctx);
+    const GrTriangulationCache::Triangulation& triangulation = rec.triangulation();
+    // Mirrors the tolerance test GrTriangulatingPathRenderer applies to its cached vertex
+    // buffers: curve-free triangulations are exact, others are good to 3x their tolerance.
+    if (triangulation.fTolerance != 0 && triangulation.fTolerance >= 3.0f * findContext->fTolerance) {
+        return false;
+    }
+    *findContext->fTriangulation = triangulation;
+    return true;
+}
+
+// GrEagerVertexAllocator that triangulates into heap storage, trimmed to an SkData on detach.
+class HeapVertexAllocator : public GrEagerVertexAllocator {
+public:
+    void* lock(size_t stride, int eagerCount) override {
+        SkASSERT(!fData);
+        fStride = stride;
+        fData = sk_malloc_throw(eagerCount * stride);
+        return fData;
+    }
+
+    void unlock(int actualCount) override {
+        fActualSize = actualCount * fStride;
+    }
+
+    sk_sp<SkData> detachData() {
+        fData = sk_realloc_throw(fData, fActualSize);
+        sk_sp<SkData> data = SkData::MakeFromMalloc(fData, fActualSize);
+        fData = nullptr;
+        return data;
+    }
+
+    ~HeapVertexAllocator() override {
+        sk_free(fData);
+    }
+
+private:
+    void* fData = nullptr;
+    size_t fStride = 0;
+    size_t fActualSize = 0;
+};
+
+}  // namespace
+
+namespace GrTriangulationCache {
+
+bool Find(const SkPath& path, SkScalar tolerance, Triangulation* out) {
+    TriangulationKey key(path.getGenerationID());
+    FindContext findContext = { out, tolerance };
+    return SkResourceCache::Find(key, find_visitor, &findContext);
+}
+
+bool Add(const SkPath& path, SkScalar tolerance, Triangulation* out) {
+    if (path.isInverseFillType()) {
+        return false;  // the triangulation would depend on the clip bounds
+    }
+    HeapVertexAllocator allocator;
+    int numCountedCurves;
+    int vertexCount = GrTriangulator::PathToTriangles(path, tolerance, path.getBounds(),
+                                                      &allocator, GrTriangulator::Mode::kNormal,
+                                                      &numCountedCurves);
+    if (vertexCount == 0) {
+        return false;
+    }
+    Triangulation triangulation;
+    triangulation.fVertexData = allocator.detachData();
+    triangulation.fVertexCount = vertexCount;
+    triangulation.fTolerance = (numCountedCurves == 0) ? 0 : tolerance;
+
+    TriangulationKey key(path.getGenerationID());
+    SkResourceCache::Add(new TriangulationRec(key, triangulation));
+    SkPathPriv::AddGenIDChangeListener(path, sk_make_sp<TriangulationInvalidator>(key));
+    if (out) {
+        *out = std::move(triangulation);
+    }
+    return true;
+}
+
+void Prime(const SkPath paths[], int count, SkScalar tolerance, SkExecutor* executor) {
+    SkTaskGroup taskGroup(executor ? *executor : SkExecutor::GetDefault());
+    taskGroup.batch(count, [paths, tolerance](int index) {
+        Triangulation scratch;
+        if (!Find(paths[index], tolerance, &scratch)) {
+            Add(paths[index], tolerance);
+        }
+    });
+    taskGroup.wait();
+}
+
+}  // namespace GrTriangulationCache
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrTriangulationCache_DEFINED
+#define GrTriangulationCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+
+class SkExecutor;
+
+/**
+ * A process-wide, CPU-side cache of GrTriangulator results, keyed on the path's generation ID
+ * and stored in SkResourceCache. Unlike the vertex buffers GrTriangulatingPathRenderer keeps in
+ * GrResourceCache, entries here are plain vertex data: they survive across GrContexts and can be
+ * primed from worker threads before a path is first drawn. Only non-inverse fills triangulated
+ * in GrTriangulator::Mode::kNormal are cached; inverse fills depend on the clip bounds, and
+ * antialiased triangulations on the view matrix.
+ */
+namespace GrTriangulationCache {
+
+/**
+ * Vertex data in GrTriangulator::Mode::kNormal layout, plus the bookkeeping a renderer needs to
+ * decide whether the triangulation is usable at its tolerance. fTolerance is the tolerance the
+ * path was linearized at, or 0 if the path contained no curves (in which case the triangulation
+ * is exact at any tolerance).
+ */
+struct Triangulation {
+    sk_sp<SkData> fVertexData;
+    int fVertexCount = 0;
+    SkScalar fTolerance = 0;
+};
+
+/**
+ * Sets 'out' and returns true if the cache holds a triangulation of 'path' usable at
+ * 'tolerance'.
+ */
+bool Find(const SkPath& path, SkScalar tolerance, Triangulation* out);
+
+/**
+ * Triangulates 'path' at 'tolerance' and adds the result to the cache. Returns false if the
+ * path is not cacheable (inverse filled) or produced no triangles.
+ */
+bool Add(const SkPath& path, SkScalar tolerance, Triangulation* out = nullptr);
+
+/**
+ * Triangulates 'paths' on 'executor''s threads (or synchronously, if executor is null) and
+ * populates the cache, so the first draw of each path finds its triangulation instead of
+ * computing it on the raster thread. Already-cached paths are skipped.
+ */
+void Prime(const SkPath paths[], int count, SkScalar tolerance, SkExecutor* executor);
+
+}  // namespace GrTriangulationCache
+
+#endif
@@ -1086,9 +1086,14 @@ sk_sp<SkSurface> SkGpuDevice::makeSurface(const SkImageInfo& info, const SkSurfa
 
 SkImageFilterCache* SkGpuDevice::getImageFilterCache() {
     ASSERT_SINGLE_OWNER
-    // We always return a transient cache, so it is freed after each
-    // filter traversal.
-    return SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize);
+    // The cache persists for the life of the device (rather than one filter traversal) so that
+    // results for static filtered content survive across frames. The byte budget bounds how many
+    // device-resident results stay alive.
+    if (!fImageFilterCache) {
+        fImageFilterCache.reset(
+                SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize));
+    }
+    return SkRef(fImageFilterCache.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@
 #include "include/core/SkSurface.h"
 #include "include/gpu/GrTypes.h"
 #include "src/core/SkClipStackDevice.h"
+#include "src/core/SkImageFilterCache.h"
 #include "src/gpu/GrClipStackClip.h"
 #include "src/gpu/GrRenderTargetContext.h"
 #include "src/gpu/SkGr.h"
@@ -132,6 +133,10 @@ private:
     std::unique_ptr<GrRenderTargetContext> fRenderTargetContext;
     GrClipStackClip  fClip;
 
+    // Lazily created, then persists for the life of the device so filter results can be reused
+    // across frames.
+    sk_sp<SkImageFilterCache> fImageFilterCache;
+
     enum Flags {
         kNeedClear_Flag = 1 << 0,  //!< Surface requires an initial clear
         kIsOpaque_Flag  = 1 << 1,  //!< Hint from client that rendering to this device will be
@@ -599,6 +599,108 @@ bool GrD3DGpu::onReadPixels(GrSurface* surface, int left, int top, int width, in
     return true;
 }
 
+bool GrD3DGpu::onTransferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                                    GrColorType surfaceColorType, GrColorType bufferColorType,
+                                    GrGpuBuffer* transferBuffer, size_t offset) {
+    if (!fCurrentDirectCommandList) {
+        return false;
+    }
+    SkASSERT(surface);
+    SkASSERT(transferBuffer);
+    if (surfaceColorType != bufferColorType) {
+        return false;
+    }
+
+    GrD3DTextureResource* texResource = nullptr;
+    GrD3DRenderTarget* rt = static_cast<GrD3DRenderTarget*>(surface->asRenderTarget());
+    if (rt) {
+        texResource = rt;
+    } else {
+        texResource = static_cast<GrD3DTexture*>(surface->asTexture());
+    }
+
+    if (!texResource) {
+        return false;
+    }
+
+    size_t bpp = GrColorTypeBytesPerPixel(bufferColorType);
+    if (this->d3dCaps().bytesPerPixel(texResource->dxgiFormat()) != bpp) {
+        return false;
+    }
+    size_t tightRowBytes = bpp * width;
+
+    D3D12_TEXTURE_COPY_LOCATION srcLocation = {};
+    srcLocation.pResource = texResource->d3dResource();
+    SkASSERT(srcLocation.pResource);
+    srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    srcLocation.SubresourceIndex = 0;
+
+    D3D12_BOX srcBox = {};
+    srcBox.left = left;
+    srcBox.top = top;
+    srcBox.right = left + width;
+    srcBox.bottom = top + height;
+    srcBox.front = 0;
+    srcBox.back = 1;
+
+    // Need to change the resource state to COPY_SOURCE in order to download from it
+    texResource->setResourceState(this, D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+    D3D12_TEXTURE_COPY_LOCATION dstLocation = {};
+    dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    dstLocation.PlacedFootprint.Footprint.Format = texResource->dxgiFormat();
+    dstLocation.PlacedFootprint.Footprint.Width = width;
+    dstLocation.PlacedFootprint.Footprint.Height = height;
+    dstLocation.PlacedFootprint.Footprint.Depth = 1;
+
+    // The caller expects tightly packed rows at 'offset' in the transfer buffer. When the tight
+    // row bytes happen to satisfy D3D12's pitch and placement alignment we can copy straight
+    // into the client's buffer.
+    if (tightRowBytes % D3D12_TEXTURE_DATA_PITCH_ALIGNMENT == 0 &&
+        offset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT == 0) {
+        dstLocation.pResource = static_cast<GrD3DBuffer*>(transferBuffer)->d3dResource();
+        dstLocation.PlacedFootprint.Offset = offset;
+        dstLocation.PlacedFootprint.Footprint.RowPitch = tightRowBytes;
+
+        fCurrentDirectCommandList->copyTextureRegionToBuffer(
+                sk_ref_sp(transferBuffer), &dstLocation, 0, 0, texResource->resource(),
+                &srcLocation, &srcBox);
+        return true;
+    }
+
+    // Otherwise stage through a GPU-local buffer with an aligned row pitch and compact the rows
+    // into the client's buffer with per-row copies, still entirely on the GPU timeline. The
+    // readback buffer itself can't be the staging target: readback-heap resources are
+    // permanently in the COPY_DEST state and can never serve as a copy source.
+    size_t alignedRowPitch = GrAlignTo(tightRowBytes, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+    sk_sp<GrGpuBuffer> stagingBuffer = this->createBuffer(
+            alignedRowPitch * height, GrGpuBufferType::kVertex, kStatic_GrAccessPattern);
+    if (!stagingBuffer) {
+        return false;
+    }
+    GrD3DBuffer* d3dStagingBuffer = static_cast<GrD3DBuffer*>(stagingBuffer.get());
+
+    dstLocation.pResource = d3dStagingBuffer->d3dResource();
+    dstLocation.PlacedFootprint.Offset = 0;
+    dstLocation.PlacedFootprint.Footprint.RowPitch = alignedRowPitch;
+
+    fCurrentDirectCommandList->copyTextureRegionToBuffer(stagingBuffer, &dstLocation, 0, 0,
+                                                         texResource->resource(), &srcLocation,
+                                                         &srcBox);
+
+    d3dStagingBuffer->setResourceState(this, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    sk_sp<GrD3DBuffer> d3dTransferBuffer(SkRef(static_cast<GrD3DBuffer*>(transferBuffer)));
+    for (int row = 0; row < height; ++row) {
+        fCurrentDirectCommandList->copyBufferToBuffer(d3dTransferBuffer,
+                                                      offset + row * tightRowBytes,
+                                                      d3dStagingBuffer->d3dResource(),
+                                                      row * alignedRowPitch,
+                                                      tightRowBytes);
+    }
+
+    return true;
+}
+
 bool GrD3DGpu::onWritePixels(GrSurface* surface, int left, int top, int width, int height,
                              GrColorType surfaceColorType, GrColorType srcColorType,
                              const GrMipLevel texels[], int mipLevelCount,
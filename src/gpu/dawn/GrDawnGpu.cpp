@@ -38,6 +38,8 @@
 #endif // !defined(SK_BUILD_FOR_WIN)
 
 static const int kMaxRenderPipelineEntries = 1024;
+// A bind group holds refs on its samplers and texture views, so keep this modest.
+static const int kMaxTextureBindGroupEntries = 64;
 
 namespace {
 
@@ -115,6 +117,7 @@ GrDawnGpu::GrDawnGpu(GrDirectContext* direct, const GrContextOptions& options,
         , fUniformRingBuffer(this, wgpu::BufferUsage::Uniform)
         , fStagingBufferManager(this)
         , fRenderPipelineCache(kMaxRenderPipelineEntries)
+        , fTextureBindGroupCache(kMaxTextureBindGroupEntries)
         , fFinishCallbacks(this) {
     fCaps.reset(new GrDawnCaps(options));
 }
@@ -513,6 +516,7 @@ bool GrDawnGpu::onSubmitToGpu(bool syncCpu) {
         fCommandBuffers.clear();
     }
 
+    fUniformRingBuffer.trackSubmittedBuffers();
     this->moveStagingBuffersToBusyAndMapAsync();
     if (syncCpu) {
         wgpu::FenceDescriptor desc;
@@ -716,6 +720,27 @@ wgpu::Sampler GrDawnGpu::getOrCreateSampler(GrSamplerState samplerState) {
     return sampler;
 }
 
+wgpu::BindGroup GrDawnGpu::getOrCreateTextureBindGroup(
+        const wgpu::BindGroupLayout& layout,
+        const std::vector<wgpu::BindGroupEntry>& entries) {
+    BindGroupKey key;
+    key.fObjects.push_back(layout.Get());
+    for (const wgpu::BindGroupEntry& entry : entries) {
+        key.fObjects.push_back(entry.sampler.Get());
+        key.fObjects.push_back(entry.textureView.Get());
+    }
+    if (wgpu::BindGroup* bindGroup = fTextureBindGroupCache.find(key)) {
+        return *bindGroup;
+    }
+    wgpu::BindGroupDescriptor descriptor;
+    descriptor.layout = layout;
+    descriptor.entryCount = entries.size();
+    descriptor.entries = entries.data();
+    wgpu::BindGroup bindGroup = fDevice.CreateBindGroup(&descriptor);
+    fTextureBindGroupCache.insert(key, bindGroup);
+    return bindGroup;
+}
+
 GrDawnRingBuffer::Slice GrDawnGpu::allocateUniformRingBufferSlice(int size) {
     return fUniformRingBuffer.allocate(size);
 }
@@ -95,6 +95,12 @@ public:
 
     wgpu::Sampler getOrCreateSampler(GrSamplerState samplerState);
 
+    // Returns a cached bind group matching the given layout and entries, creating it on a miss.
+    // Since samplers are cached for the gpu's lifetime and texture views for their texture's,
+    // the underlying object handles identify the bindings.
+    wgpu::BindGroup getOrCreateTextureBindGroup(const wgpu::BindGroupLayout& layout,
+                                                const std::vector<wgpu::BindGroupEntry>& entries);
+
     GrDawnRingBuffer::Slice allocateUniformRingBufferSlice(int size);
     wgpu::CommandEncoder getCopyEncoder();
     void flushCopyEncoder();
@@ -221,8 +227,26 @@ private:
         }
     };
 
+    // Identifies a bind group by the layout and bound object handles.
+    struct BindGroupKey {
+        SkSTArray<8, const void*, true> fObjects;
+        bool operator==(const BindGroupKey& that) const {
+            return fObjects.count() == that.fObjects.count() &&
+                   !memcmp(fObjects.begin(), that.fObjects.begin(),
+                           fObjects.count() * sizeof(const void*));
+        }
+    };
+
+    struct BindGroupKeyHash {
+        uint32_t operator()(const BindGroupKey& key) const {
+            return SkOpts::hash_fn(key.fObjects.begin(),
+                                   key.fObjects.count() * sizeof(const void*), 0);
+        }
+    };
+
     SkLRUCache<GrProgramDesc, sk_sp<GrDawnProgram>, ProgramDescHash>    fRenderPipelineCache;
     std::unordered_map<GrSamplerState, wgpu::Sampler, SamplerHash> fSamplers;
+    SkLRUCache<BindGroupKey, wgpu::BindGroup, BindGroupKeyHash> fTextureBindGroupCache;
 
     GrFinishCallbacks         fFinishCallbacks;
 
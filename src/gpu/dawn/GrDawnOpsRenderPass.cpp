@@ -117,9 +117,14 @@ void GrDawnOpsRenderPass::inlineUpload(GrOpFlushState* state,
 ////////////////////////////////////////////////////////////////////////////////
 
 void GrDawnOpsRenderPass::applyState(GrDawnProgram* program, const GrProgramInfo& programInfo) {
-    auto bindGroup = program->setUniformData(fGpu, fRenderTarget, programInfo);
+    uint32_t uniformOffset;
+    auto bindGroup = program->setUniformData(fGpu, fRenderTarget, programInfo, &uniformOffset);
     fPassEncoder.SetPipeline(program->fRenderPipeline);
-    fPassEncoder.SetBindGroup(0, bindGroup, 0, nullptr);
+    if (program->fDataManager.uniformBufferSize()) {
+        fPassEncoder.SetBindGroup(0, bindGroup, 1, &uniformOffset);
+    } else {
+        fPassEncoder.SetBindGroup(0, bindGroup, 0, nullptr);
+    }
     const GrPipeline& pipeline = programInfo.pipeline();
     if (pipeline.isStencilEnabled()) {
         fPassEncoder.SetStencilReference(pipeline.getUserStencil()->fCCWFace.fRef);
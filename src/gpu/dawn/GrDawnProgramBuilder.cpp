@@ -328,9 +328,14 @@ sk_sp<GrDawnProgram> GrDawnProgramBuilder::Build(GrDawnGpu* gpu,
     result->fFragmentProcessors = std::move(builder.fFragmentProcessors);
     std::vector<wgpu::BindGroupLayoutEntry> uniformLayoutEntries;
     if (0 != uniformBufferSize) {
-        uniformLayoutEntries.push_back({ GrSPIRVUniformHandler::kUniformBinding,
-                                         wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Fragment,
-                                         wgpu::BindingType::UniformBuffer });
+        // The uniforms live in a ring buffer that is bound once per underlying buffer; each draw
+        // selects its slice with a dynamic offset, so the bind group itself can be reused.
+        wgpu::BindGroupLayoutEntry uniformLayoutEntry;
+        uniformLayoutEntry.binding = GrSPIRVUniformHandler::kUniformBinding;
+        uniformLayoutEntry.visibility = wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Fragment;
+        uniformLayoutEntry.type = wgpu::BindingType::UniformBuffer;
+        uniformLayoutEntry.hasDynamicOffset = true;
+        uniformLayoutEntries.push_back(uniformLayoutEntry);
     }
     wgpu::BindGroupLayoutDescriptor uniformBindGroupLayoutDesc;
     uniformBindGroupLayoutDesc.entryCount = uniformLayoutEntries.size();
@@ -513,15 +518,14 @@ static void set_texture(GrDawnGpu* gpu, GrSamplerState state, GrTexture* texture
 }
 
 wgpu::BindGroup GrDawnProgram::setUniformData(GrDawnGpu* gpu, const GrRenderTarget* renderTarget,
-                                              const GrProgramInfo& programInfo) {
-    std::vector<wgpu::BindGroupEntry> bindings;
+                                              const GrProgramInfo& programInfo,
+                                              uint32_t* uniformOffset) {
     GrDawnRingBuffer::Slice slice;
     uint32_t uniformBufferSize = fDataManager.uniformBufferSize();
+    *uniformOffset = 0;
     if (0 != uniformBufferSize) {
         slice = gpu->allocateUniformRingBufferSlice(uniformBufferSize);
-        bindings.push_back(make_bind_group_entry(GrSPIRVUniformHandler::kUniformBinding,
-                                                   slice.fBuffer, slice.fOffset,
-                                                   uniformBufferSize));
+        *uniformOffset = slice.fOffset;
     }
     this->setRenderTargetState(renderTarget, programInfo.origin());
     const GrPipeline& pipeline = programInfo.pipeline();
@@ -542,11 +546,22 @@ wgpu::BindGroup GrDawnProgram::setUniformData(GrDawnGpu* gpu, const GrRenderTarg
     if (0 != uniformBufferSize) {
         fDataManager.uploadUniformBuffers(slice.fData);
     }
-    wgpu::BindGroupDescriptor descriptor;
-    descriptor.layout = fBindGroupLayouts[0];
-    descriptor.entryCount = bindings.size();
-    descriptor.entries = bindings.data();
-    return gpu->device().CreateBindGroup(&descriptor);
+    // The bind group depends only on the layout and the underlying ring buffer, so it is reused
+    // until the ring rolls over to a new buffer; each draw supplies its slice's dynamic offset.
+    if (!fUniformBindGroup || fUniformBuffer.Get() != slice.fBuffer.Get()) {
+        std::vector<wgpu::BindGroupEntry> bindings;
+        if (0 != uniformBufferSize) {
+            bindings.push_back(make_bind_group_entry(GrSPIRVUniformHandler::kUniformBinding,
+                                                     slice.fBuffer, 0, uniformBufferSize));
+        }
+        wgpu::BindGroupDescriptor descriptor;
+        descriptor.layout = fBindGroupLayouts[0];
+        descriptor.entryCount = bindings.size();
+        descriptor.entries = bindings.data();
+        fUniformBindGroup = gpu->device().CreateBindGroup(&descriptor);
+        fUniformBuffer = slice.fBuffer;
+    }
+    return fUniformBindGroup;
 }
 
 wgpu::BindGroup GrDawnProgram::setTextures(GrDawnGpu* gpu,
@@ -575,9 +590,5 @@ wgpu::BindGroup GrDawnProgram::setTextures(GrDawnGpu* gpu,
     if (GrTexture* dstTexture = pipeline.peekDstTexture(&offset)) {
         set_texture(gpu, GrSamplerState::Filter::kNearest, dstTexture, &bindings, &binding);
     }
-    wgpu::BindGroupDescriptor descriptor;
-    descriptor.layout = fBindGroupLayouts[1];
-    descriptor.entryCount = bindings.size();
-    descriptor.entries = bindings.data();
-    return gpu->device().CreateBindGroup(&descriptor);
+    return gpu->getOrCreateTextureBindGroup(fBindGroupLayouts[1], bindings);
 }
@@ -62,8 +62,14 @@ struct GrDawnProgram : public SkRefCnt {
     RenderTargetState fRenderTargetState;
     BuiltinUniformHandles fBuiltinUniformHandles;
 
+    // The uniform bind group is reused across draws; each draw selects its slice of the uniform
+    // ring buffer via the dynamic offset returned in 'uniformOffset'.
+    wgpu::BindGroup fUniformBindGroup;
+    wgpu::Buffer fUniformBuffer;
+
     void setRenderTargetState(const GrRenderTarget*, GrSurfaceOrigin);
-    wgpu::BindGroup setUniformData(GrDawnGpu*, const GrRenderTarget*, const GrProgramInfo&);
+    wgpu::BindGroup setUniformData(GrDawnGpu*, const GrRenderTarget*, const GrProgramInfo&,
+                                   uint32_t* uniformOffset);
     wgpu::BindGroup setTextures(GrDawnGpu* gpu,
                                 const GrPrimitiveProcessor& primProc,
                                 const GrPipeline& pipeline,
@@ -23,10 +23,21 @@ GrDawnRingBuffer::~GrDawnRingBuffer() {
 
 GrDawnRingBuffer::Slice GrDawnRingBuffer::allocate(int size) {
     if (!fBuffer || fOffset + size > kDefaultSize) {
-        wgpu::BufferDescriptor desc;
-        desc.usage = fUsage | wgpu::BufferUsage::CopyDst;
-        desc.size = kDefaultSize;
-        fBuffer = fGpu->device().CreateBuffer(&desc);
+        if (fBuffer) {
+            // The old buffer may still be referenced by unsubmitted commands; it becomes
+            // reusable once a fence inserted at the next submit has signaled.
+            fRetiredBuffers.push_back(fBuffer);
+        }
+        this->recycleCompletedBuffers();
+        if (!fFreeBuffers.empty()) {
+            fBuffer = fFreeBuffers.back();
+            fFreeBuffers.pop_back();
+        } else {
+            wgpu::BufferDescriptor desc;
+            desc.usage = fUsage | wgpu::BufferUsage::CopyDst;
+            desc.size = kDefaultSize;
+            fBuffer = fGpu->device().CreateBuffer(&desc);
+        }
         fOffset = 0;
     }
 
@@ -40,3 +51,31 @@ GrDawnRingBuffer::Slice GrDawnRingBuffer::allocate(int size) {
                                               fBuffer, offset, size);
     return Slice(fBuffer, offset, staging.fOffsetMapPtr);
 }
+
+void GrDawnRingBuffer::trackSubmittedBuffers() {
+    this->recycleCompletedBuffers();
+    if (fRetiredBuffers.empty()) {
+        return;
+    }
+    auto inFlight = std::make_unique<InFlightBuffers>();
+    inFlight->fBuffers = std::move(fRetiredBuffers);
+    fRetiredBuffers.clear();
+    wgpu::FenceDescriptor desc;
+    inFlight->fFence = fGpu->queue().CreateFence(&desc);
+    inFlight->fFence.OnCompletion(0,
+                                  [](WGPUFenceCompletionStatus status, void* userData) {
+                                      static_cast<InFlightBuffers*>(userData)->fCompleted = true;
+                                  },
+                                  inFlight.get());
+    fInFlightBuffers.push_back(std::move(inFlight));
+}
+
+void GrDawnRingBuffer::recycleCompletedBuffers() {
+    // Fences signal in submission order, so stop at the first incomplete group.
+    while (!fInFlightBuffers.empty() && fInFlightBuffers.front()->fCompleted) {
+        for (wgpu::Buffer& buffer : fInFlightBuffers.front()->fBuffers) {
+            fFreeBuffers.push_back(std::move(buffer));
+        }
+        fInFlightBuffers.pop_front();
+    }
+}
@@ -12,6 +12,10 @@
 #include "src/gpu/dawn/GrDawnBuffer.h"
 #include "dawn/webgpu_cpp.h"
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 class GrDawnGpu;
 
 class GrDawnRingBuffer : public SkRefCnt {
@@ -38,11 +42,29 @@ public:
     };
     Slice allocate(int size);
 
+    // Called by GrDawnGpu after the recorded commands have been submitted. Fences the buffers
+    // the ring has rolled past so they can be recycled once the GPU has finished with them.
+    void trackSubmittedBuffers();
+
 private:
+    // Buffers the ring rolled past, grouped with a fence inserted at the submit that last
+    // referenced them. The fence callback flips fCompleted; the buffers may be reused after that.
+    struct InFlightBuffers {
+        wgpu::Fence               fFence;
+        bool                      fCompleted = false;
+        std::vector<wgpu::Buffer> fBuffers;
+    };
+
+    void recycleCompletedBuffers();
+
     GrDawnGpu*            fGpu;
     wgpu::BufferUsage     fUsage;
     wgpu::Buffer          fBuffer;
     int                   fOffset = 0;
+
+    std::vector<wgpu::Buffer>                    fRetiredBuffers;  // awaiting the next submit
+    std::deque<std::unique_ptr<InFlightBuffers>> fInFlightBuffers; // oldest at the front
+    std::vector<wgpu::Buffer>                    fFreeBuffers;
 };
 
 #endif
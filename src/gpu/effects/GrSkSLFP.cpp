@@ -121,33 +121,31 @@ public:
         size_t uniIndex = 0;
         const GrSkSLFP& outer = _proc.cast<GrSkSLFP>();
         const uint8_t* inputs = outer.fInputs->bytes();
-        for (const auto& v : outer.fEffect->inputs()) {
-            if (v.fQualifier != SkRuntimeEffect::Variable::Qualifier::kUniform) {
-                continue;
-            }
-
-            const float* data = reinterpret_cast<const float*>(inputs + v.fOffset);
-            switch (v.fType) {
+        // The precomputed slot table contains only the uniforms, in declaration order, which
+        // matches fUniformHandles.
+        for (const auto& slot : outer.fEffect->uniformSlots()) {
+            const float* data = reinterpret_cast<const float*>(inputs + slot.fOffset);
+            switch (slot.fType) {
                 case SkRuntimeEffect::Variable::Type::kFloat:
-                    pdman.set1fv(fUniformHandles[uniIndex++], v.fCount, data);
+                    pdman.set1fv(fUniformHandles[uniIndex++], slot.fCount, data);
                     break;
                 case SkRuntimeEffect::Variable::Type::kFloat2:
-                    pdman.set2fv(fUniformHandles[uniIndex++], v.fCount, data);
+                    pdman.set2fv(fUniformHandles[uniIndex++], slot.fCount, data);
                     break;
                 case SkRuntimeEffect::Variable::Type::kFloat3:
-                    pdman.set3fv(fUniformHandles[uniIndex++], v.fCount, data);
+                    pdman.set3fv(fUniformHandles[uniIndex++], slot.fCount, data);
                     break;
                 case SkRuntimeEffect::Variable::Type::kFloat4:
-                    pdman.set4fv(fUniformHandles[uniIndex++], v.fCount, data);
+                    pdman.set4fv(fUniformHandles[uniIndex++], slot.fCount, data);
                     break;
                 case SkRuntimeEffect::Variable::Type::kFloat2x2:
-                    pdman.setMatrix2fv(fUniformHandles[uniIndex++], v.fCount, data);
+                    pdman.setMatrix2fv(fUniformHandles[uniIndex++], slot.fCount, data);
                     break;
                 case SkRuntimeEffect::Variable::Type::kFloat3x3:
-                    pdman.setMatrix3fv(fUniformHandles[uniIndex++], v.fCount, data);
+                    pdman.setMatrix3fv(fUniformHandles[uniIndex++], slot.fCount, data);
                     break;
                 case SkRuntimeEffect::Variable::Type::kFloat4x4:
-                    pdman.setMatrix4fv(fUniformHandles[uniIndex++], v.fCount, data);
+                    pdman.setMatrix4fv(fUniformHandles[uniIndex++], slot.fCount, data);
                     break;
                 default:
                     SkDEBUGFAIL("Unsupported uniform type");
@@ -225,10 +223,11 @@ void GrSkSLFP::onGetGLSLProcessorKey(const GrShaderCaps& caps, GrProcessorKeyBui
     b->add32(SkToU32(fInputs->size()));
     const uint8_t* inputs = fInputs->bytes();
     for (const auto& v : fEffect->inputs()) {
-        if (v.fQualifier != SkRuntimeEffect::Variable::Qualifier::kIn) {
+        if (v.fQualifier != SkRuntimeEffect::Variable::Qualifier::kIn &&
+            !(v.fFlags & SkRuntimeEffect::Variable::kPinned_Flag)) {
             continue;
         }
-        // 'in' arrays are not supported
+        // 'in' arrays are not supported, and pinned uniforms are never arrays
         SkASSERT(!v.isArray());
         switch (v.fType) {
             case SkRuntimeEffect::Variable::Type::kBool:
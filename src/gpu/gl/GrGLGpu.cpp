@@ -3571,6 +3571,29 @@ void GrGLGpu::insertManualFramebufferBarrier() {
     GL_CALL(MemoryBarrier(GR_GL_FRAMEBUFFER_BARRIER_BIT));
 }
 
+uint32_t GrGLGpu::insertTimestampQuery() {
+    // glQueryCounter comes from GL 3.3 / ARB_timer_query / EXT_disjoint_timer_query; the
+    // interface only fills it in when one of those is present.
+    if (!this->glInterface()->fFunctions.fQueryCounter) {
+        return 0;
+    }
+    GrGLuint query = 0;
+    GL_CALL(GenQueries(1, &query));
+    if (!query) {
+        return 0;
+    }
+    GL_CALL(QueryCounter(query, GR_GL_TIMESTAMP));
+    return query;
+}
+
+uint64_t GrGLGpu::onFinishTimestampQuery(uint32_t query) {
+    GrGLuint64 result = 0;
+    // GL_QUERY_RESULT blocks until the timestamp is available; timestamps are in nanoseconds.
+    GL_CALL(GetQueryObjectui64v(query, GR_GL_QUERY_RESULT, &result));
+    GL_CALL(DeleteQueries(1, &query));
+    return result;
+}
+
 GrBackendTexture GrGLGpu::onCreateBackendTexture(SkISize dimensions,
                                                  const GrBackendFormat& format,
                                                  GrRenderable renderable,
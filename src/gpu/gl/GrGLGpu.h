@@ -183,6 +183,8 @@ public:
 
     void insertManualFramebufferBarrier() override;
 
+    uint32_t insertTimestampQuery() override;
+
     void flushProgram(sk_sp<GrGLProgram>);
 
     // Version for programs that aren't GrGLProgram.
@@ -215,6 +217,8 @@ private:
 
     void onResetTextureBindings() override;
 
+    uint64_t onFinishTimestampQuery(uint32_t query) override;
+
     void querySampleLocations(GrRenderTarget*, SkTArray<SkPoint>*) override;
 
     void xferBarrier(GrRenderTarget*, GrXferBarrierType) override;
@@ -362,6 +366,11 @@ private:
 
         SkLRUCache<GrProgramDesc, std::unique_ptr<Entry>, DescHash> fMap;
 
+        // Fast path for runs of draws that resolve to the same program: when the newly built
+        // desc matches the last one used, skip hashing the key and probing fMap entirely.
+        GrProgramDesc      fLastDesc;
+        sk_sp<GrGLProgram> fLastProgram;
+
         GrGLGpu* fGpu;
     };
 
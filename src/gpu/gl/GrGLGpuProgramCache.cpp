@@ -46,6 +46,8 @@ void GrGLGpu::ProgramCache::abandon() {
 
 void GrGLGpu::ProgramCache::reset() {
     fMap.reset();
+    fLastDesc = GrProgramDesc();
+    fLastProgram.reset();
 }
 
 sk_sp<GrGLProgram> GrGLGpu::ProgramCache::findOrCreateProgram(GrRenderTarget* renderTarget,
@@ -58,12 +60,21 @@ sk_sp<GrGLProgram> GrGLGpu::ProgramCache::findOrCreateProgram(GrRenderTarget* re
         return nullptr;
     }
 
+    // Consecutive draws frequently resolve to the same program; a direct compare against the
+    // last desc is much cheaper than hashing the key and probing the LRU map.
+    if (fLastProgram && desc == fLastDesc) {
+        fGpu->fStats.incNumInlineProgramCacheResult(Stats::ProgramCacheResult::kHit);
+        return fLastProgram;
+    }
+
     Stats::ProgramCacheResult stat;
     sk_sp<GrGLProgram> tmp = this->findOrCreateProgram(renderTarget, desc, programInfo, &stat);
     if (!tmp) {
         fGpu->fStats.incNumInlineCompilationFailures();
     } else {
         fGpu->fStats.incNumInlineProgramCacheResult(stat);
+        fLastDesc = desc;
+        fLastProgram = tmp;
     }
 
     return tmp;
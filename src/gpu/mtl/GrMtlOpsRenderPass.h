@@ -65,6 +65,9 @@ private:
 
     id<MTLRenderCommandEncoder> fActiveRenderCmdEncoder;
     GrMtlPipelineState*         fActivePipelineState = nullptr;
+    // The MTLRenderPipelineState last set on fActiveRenderCmdEncoder, to skip redundant binds.
+    // Reset in initRenderState(), which runs whenever a fresh encoder is created.
+    id<MTLRenderPipelineState>  fCurrentRenderPipelineState = nil;
     MTLPrimitiveType            fActivePrimitiveType;
     MTLRenderPassDescriptor*    fRenderPassDesc;
     SkRect                      fBounds;
@@ -46,6 +46,7 @@ void GrMtlOpsRenderPass::submit() {
     fBounds.roundOut(&iBounds);
     fGpu->submitIndirectCommandBuffer(fRenderTarget, fOrigin, &iBounds);
     fActiveRenderCmdEncoder = nil;
+    fCurrentRenderPipelineState = nil;
 }
 
 static MTLPrimitiveType gr_to_mtl_primitive(GrPrimitiveType primitiveType) {
@@ -82,7 +83,13 @@ bool GrMtlOpsRenderPass::onBindPipeline(const GrProgramInfo& programInfo,
                 fGpu->commandBuffer()->getRenderCommandEncoder(fRenderPassDesc, nullptr, this);
     }
 
-    [fActiveRenderCmdEncoder setRenderPipelineState:fActivePipelineState->mtlPipelineState()];
+    // Ops that don't chain often rebind the same pipeline back to back; the encoder won't dedupe
+    // the bind for us, and frames with many distinct pipelines are encode-bound.
+    id<MTLRenderPipelineState> renderPipelineState = fActivePipelineState->mtlPipelineState();
+    if (renderPipelineState != fCurrentRenderPipelineState) {
+        [fActiveRenderCmdEncoder setRenderPipelineState:renderPipelineState];
+        fCurrentRenderPipelineState = renderPipelineState;
+    }
     fActivePipelineState->setDrawState(fActiveRenderCmdEncoder,
                                        programInfo.pipeline().writeSwizzle(),
                                        programInfo.pipeline().getXferProcessor());
@@ -180,6 +187,7 @@ void GrMtlOpsRenderPass::initRenderState(id<MTLRenderCommandEncoder> encoder) {
                              0.0, 1.0 };
     [encoder setViewport:viewport];
     this->resetBufferBindings();
+    fCurrentRenderPipelineState = nil;
     [encoder popDebugGroup];
 }
 
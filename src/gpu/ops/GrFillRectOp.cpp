@@ -192,6 +192,46 @@ public:
         return result;
     }
 
+    bool opaqueCoverage(SkIRect* coveredPixels) const override {
+        // A trivial helper draws src-over with no fragment processors, so wherever an opaque
+        // quad has full coverage it overwrites the destination outright. A stencil test could
+        // reject some of those pixels, so it must be unused.
+        if (!fHelper.isTrivial() || fHelper.stencilSettings() != &GrUserStencilSettings::kUnused) {
+            return false;
+        }
+        // Report the largest such quad; pixels wholly inside an axis-aligned quad are fully
+        // covered regardless of MSAA, but antialiased edges ramp coverage off over a pixel, so
+        // back AA quads off to their fully covered interior.
+        SkIRect best = SkIRect::MakeEmpty();
+        auto iter = fQuads.iterator();
+        while (iter.next()) {
+            if (iter.deviceQuad()->quadType() != GrQuad::Type::kAxisAligned ||
+                !iter.metadata().fColor.isOpaque()) {
+                continue;
+            }
+            SkRect covered = iter.deviceQuad()->bounds();
+            if (iter.metadata().fAAFlags != GrQuadAAFlags::kNone) {
+                covered.inset(1.f, 1.f);
+            }
+            SkIRect coveredPixelRect;
+            covered.roundIn(&coveredPixelRect);
+            if ((int64_t)coveredPixelRect.width() * coveredPixelRect.height() >
+                (int64_t)best.width() * best.height()) {
+                best = coveredPixelRect;
+            }
+        }
+        if (best.isEmpty()) {
+            return false;
+        }
+        *coveredPixels = best;
+        return true;
+    }
+
+    bool canBeOccluded() const override {
+        // The only output besides color would be a stencil write.
+        return fHelper.stencilSettings() == &GrUserStencilSettings::kUnused;
+    }
+
     FixedFunctionFlags fixedFunctionFlags() const override {
         // Since the AA type of the whole primitive is kept consistent with the per edge AA flags
         // the helper's fixed function flags are appropriate.
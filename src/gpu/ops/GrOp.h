@@ -121,6 +121,21 @@ public:
         return SkToBool(fBoundsFlags & kZeroArea_BoundsFlag);
     }
 
+    /**
+     * If the op is guaranteed to overwrite every pixel of some device-space rect with opaque
+     * values that do not depend on the prior destination contents, writes that pixel rect to
+     * 'coveredPixels' and returns true. GrOpsTask uses this when it is closed to discard earlier
+     * draws the rect completely covers. The default conservatively reports no coverage.
+     */
+    virtual bool opaqueCoverage(SkIRect* coveredPixels) const { return false; }
+
+    /**
+     * Returns true if skipping this op is unobservable when a later op opaquely overwrites the
+     * op's entire bounds, i.e. its only output is color within its bounds. Ops with other side
+     * effects (e.g. stencil writes or semaphore waits) must return false.
+     */
+    virtual bool canBeOccluded() const { return false; }
+
 #ifdef SK_DEBUG
     // All GrOp-derived classes should be allocated in and deleted from a GrMemoryPool
     void* operator new(size_t size);
@@ -21,6 +21,7 @@
 #include "src/gpu/GrResourceProvider.h"
 #include "src/gpu/GrSimpleMesh.h"
 #include "src/gpu/GrStyle.h"
+#include "src/gpu/GrTriangulationCache.h"
 #include "src/gpu/GrTriangulator.h"
 #include "src/gpu/geometry/GrPathUtils.h"
 #include "src/gpu/geometry/GrStyledShape.h"
@@ -273,6 +274,28 @@ private:
             return;
         }
 
+        // Next, check the process-wide CPU-side cache, which survives across contexts and may
+        // have been primed off-thread. On a hit, upload the vertex data and cache the buffer
+        // under the same unique key a freshly computed triangulation would get.
+        GrTriangulationCache::Triangulation triangulation;
+        if (!inverseFill && GrTriangulationCache::Find(getPath(), tol, &triangulation)) {
+            sk_sp<GrGpuBuffer> vb = rp->createBuffer(triangulation.fVertexData->size(),
+                                                     GrGpuBufferType::kVertex,
+                                                     kStatic_GrAccessPattern,
+                                                     triangulation.fVertexData->data());
+            if (vb) {
+                TessInfo info;
+                info.fTolerance = triangulation.fTolerance;
+                info.fCount = triangulation.fVertexCount;
+                fShape.addGenIDChangeListener(
+                        sk_make_sp<UniqueKeyInvalidator>(key, target->contextUniqueID()));
+                key.setCustomData(SkData::MakeWithCopy(&info, sizeof(info)));
+                rp->assignUniqueKeyToResource(key, vb.get());
+                this->createMesh(target, std::move(vb), 0, triangulation.fVertexCount);
+                return;
+            }
+        }
+
         SkRect clipBounds = SkRect::Make(fDevClipBounds);
 
         SkMatrix vmi;
@@ -360,32 +360,34 @@ void GrPathTessellateOp::prepareIndirectOuterCubicsAndTriangles(
     fCubicVertexCount = numTrianglesAtBeginningOfData * 4;
 
     if (resolveLevelCounter.totalCubicInstanceCount()) {
-        GrVectorXform xform(fViewMatrix);
+        // Replay the resolveLevels that were saved off during the counting pass. The curves come
+        // back in the same order we iterate them here, so there is no need to re-evaluate Wang's
+        // formula.
+        int curveIdx = 0;
         for (auto [verb, pts, w] : SkPathPriv::Iterate(fPath)) {
             int level;
             switch (verb) {
                 default:
                     continue;
                 case SkPathVerb::kQuad:
-                    level = GrWangsFormula::quadratic_log2(kLinearizationIntolerance, pts, xform);
+                    level = resolveLevelCounter.savedResolveLevel(curveIdx++);
                     if (level == 0) {
                         continue;
                     }
-                    level = std::min(level, kMaxResolveLevel);
                     quad2cubic(pts, instanceLocations[level]);
                     break;
                 case SkPathVerb::kCubic:
-                    level = GrWangsFormula::cubic_log2(kLinearizationIntolerance, pts, xform);
+                    level = resolveLevelCounter.savedResolveLevel(curveIdx++);
                     if (level == 0) {
                         continue;
                     }
-                    level = std::min(level, kMaxResolveLevel);
                     memcpy(instanceLocations[level], pts, sizeof(SkPoint) * 4);
                     break;
             }
             instanceLocations[level] += 4;
             fCubicVertexCount += 4;
         }
+        SkASSERT(curveIdx == resolveLevelCounter.savedResolveLevelCount());
     }
 
 #ifdef SK_DEBUG
@@ -8,17 +8,21 @@
 #ifndef GrResolveLevelCounter_DEFINED
 #define GrResolveLevelCounter_DEFINED
 
+#include "include/private/SkTDArray.h"
 #include "src/core/SkPathPriv.h"
 #include "src/gpu/tessellate/GrTessellationPathRenderer.h"
 #include "src/gpu/tessellate/GrWangsFormula.h"
 
 // This class helps bin cubics by log2 "resolveLevel" when we don't use hardware tessellation. It is
 // composed of simple counters that track how many cubics we intend to draw at each resolveLevel,
-// and how many resolveLevels there are that have at least one cubic.
+// and how many resolveLevels there are that have at least one cubic. It also remembers each counted
+// curve's resolveLevel, in counting order, so the pass that writes out instance data can replay the
+// levels instead of re-evaluating Wang's formula on every curve.
 class GrResolveLevelCounter {
 public:
     void reset() {
         memset(fInstanceCounts, 0, sizeof(fInstanceCounts));
+        fResolveLevels.rewind();
         SkDEBUGCODE(fHasCalledReset = true;)
     }
 
@@ -45,9 +49,11 @@ public:
         SkASSERT(resolveLevel >= 0);
         if (resolveLevel == 0) {
             // Cubics with 2^0=1 segments are empty (zero area). We ignore them completely.
+            fResolveLevels.push_back(0);
             return;
         }
         resolveLevel = std::min(resolveLevel, GrTessellationPathRenderer::kMaxResolveLevel);
+        fResolveLevels.push_back((int8_t)resolveLevel);
         if (!fInstanceCounts[resolveLevel]++) {
             ++fTotalCubicIndirectDrawCount;
         }
@@ -63,8 +69,17 @@ public:
     int totalCubicInstanceCount() const { return fTotalCubicInstanceCount; }
     int totalCubicIndirectDrawCount() const { return fTotalCubicIndirectDrawCount; }
 
+    // The resolveLevel of the nth counted curve, in counting order. 0 means the curve was empty
+    // and does not get drawn.
+    int savedResolveLevel(int curveIndex) const {
+        SkASSERT(fHasCalledReset);
+        return fResolveLevels[curveIndex];
+    }
+    int savedResolveLevelCount() const { return fResolveLevels.count(); }
+
 private:
     SkDEBUGCODE(bool fHasCalledReset = false;)
+    SkTDArray<int8_t> fResolveLevels;
     int fInstanceCounts[GrTessellationPathRenderer::kMaxResolveLevel + 1];
     int fTotalCubicInstanceCount = 0;
     int fTotalCubicIndirectDrawCount = 0;
@@ -26,8 +26,19 @@ GrTextBlobCache::makeCachedBlob(const SkGlyphRunList& glyphRunList, const GrText
                                 const SkMatrix& viewMatrix) {
     sk_sp<GrTextBlob> cacheBlob(GrTextBlob::Make(glyphRunList, viewMatrix));
     cacheBlob->setupKey(key, blurRec, glyphRunList.paint());
-    SkAutoSpinlock lock{fSpinLock};
-    this->internalAdd(cacheBlob);
+    size_t bytesFreed;
+    PurgeCallback callback;
+    {
+        SkAutoSpinlock lock{fSpinLock};
+        this->internalAdd(cacheBlob);
+        bytesFreed = fBytesFreedByPurge;
+        fBytesFreedByPurge = 0;
+        callback = fPurgeCallback;
+    }
+    if (bytesFreed > 0 && callback) {
+        // Outside the lock so the callback may call back into the cache.
+        callback(bytesFreed);
+    }
     glyphRunList.temporaryShuntBlobNotifyAddedToCache(fMessageBusID);
     return cacheBlob;
 }
@@ -115,6 +126,17 @@ bool GrTextBlobCache::isOverBudget() const {
     return fCurrentSize > fSizeBudget;
 }
 
+void GrTextBlobCache::setBudget(size_t budget) {
+    SkAutoSpinlock lock{fSpinLock};
+    fSizeBudget = budget;
+    this->internalCheckPurge();
+}
+
+void GrTextBlobCache::setPurgeCallback(PurgeCallback callback) {
+    SkAutoSpinlock lock{fSpinLock};
+    fPurgeCallback = std::move(callback);
+}
+
 void GrTextBlobCache::internalCheckPurge(GrTextBlob* blob) {
     // First, purge all stale blob IDs.
     this->internalPurgeStaleBlobs();
@@ -128,6 +150,7 @@ void GrTextBlobCache::internalCheckPurge(GrTextBlob* blob) {
             // Backup the iterator before removing and unrefing the blob
             iter.prev();
 
+            fBytesFreedByPurge += lruBlob->size();
             this->internalRemove(lruBlob);
         }
 
@@ -49,6 +49,16 @@ public:
 
     bool isOverBudget() const SK_EXCLUDES(fSpinLock);
 
+    // Sets the byte budget, evicting least recently used blobs if the cache is
+    // over the new budget.
+    void setBudget(size_t budget) SK_EXCLUDES(fSpinLock);
+
+    // The callback is invoked (outside the cache's lock) after budget-driven
+    // eviction, with the number of bytes freed; a client can use it to feed a
+    // metrics pipeline or react to memory pressure by shrinking the budget.
+    using PurgeCallback = std::function<void(size_t bytesFreed)>;
+    void setPurgeCallback(PurgeCallback callback) SK_EXCLUDES(fSpinLock);
+
 private:
     friend class GrTextBlobTestingPeer;
     using TextBlobList = SkTInternalLList<GrTextBlob>;
@@ -87,6 +97,8 @@ private:
     SkTHashMap<uint32_t, BlobIDCacheEntry> fBlobIDCache SK_GUARDED_BY(fSpinLock);
     size_t fSizeBudget SK_GUARDED_BY(fSpinLock);
     size_t fCurrentSize SK_GUARDED_BY(fSpinLock) {0};
+    size_t fBytesFreedByPurge SK_GUARDED_BY(fSpinLock) {0};
+    PurgeCallback fPurgeCallback SK_GUARDED_BY(fSpinLock);
 
     // In practice 'messageBusID' is always the unique ID of the owning GrContext
     const uint32_t fMessageBusID;
@@ -27,6 +27,7 @@ void GrVkCommandBuffer::invalidateState() {
         boundInputBuffer = VK_NULL_HANDLE;
     }
     fBoundIndexBuffer = VK_NULL_HANDLE;
+    fBoundPipeline = VK_NULL_HANDLE;
 
     memset(&fCachedViewport, 0, sizeof(VkViewport));
     fCachedViewport.width = - 1.0f; // Viewport must have a width greater than 0
@@ -267,10 +268,17 @@ void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
 
 void GrVkCommandBuffer::bindPipeline(const GrVkGpu* gpu, const GrVkPipeline* pipeline) {
     SkASSERT(fIsActive);
-    GR_VK_CALL(gpu->vkInterface(), CmdBindPipeline(fCmdBuffer,
-                                                   VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                   pipeline->pipeline()));
-    this->addResource(pipeline);
+    // Ops that don't chain often rebind the same pipeline back to back. Skipping the redundant
+    // bind also skips re-tracking the pipeline resource; the previous bind's ref keeps the
+    // handle alive until the command buffer is finished, so the cached handle can't be recycled
+    // out from under us.
+    if (pipeline->pipeline() != fBoundPipeline) {
+        GR_VK_CALL(gpu->vkInterface(), CmdBindPipeline(fCmdBuffer,
+                                                       VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                                       pipeline->pipeline()));
+        fBoundPipeline = pipeline->pipeline();
+        this->addResource(pipeline);
+    }
 }
 
 void GrVkCommandBuffer::drawIndexed(const GrVkGpu* gpu,
@@ -171,8 +171,9 @@ private:
 
     static constexpr uint32_t kMaxInputBuffers = 2;
 
-    VkBuffer fBoundInputBuffers[kMaxInputBuffers];
-    VkBuffer fBoundIndexBuffer;
+    VkBuffer   fBoundInputBuffers[kMaxInputBuffers];
+    VkBuffer   fBoundIndexBuffer;
+    VkPipeline fBoundPipeline;
 
     // When resetting the command buffer, we remove the tracked resources from their arrays, and
     // we prefer to not free all the memory every time so usually we just rewind. However, to avoid
@@ -11,7 +11,7 @@
 #include "src/gpu/vk/GrVkCommandBuffer.h"
 #include "src/gpu/vk/GrVkGpu.h"
 
-GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu) {
+GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu, uint32_t queueFamilyIndex) {
     VkCommandPoolCreateFlags cmdPoolCreateFlags =
             VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
             VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
@@ -23,7 +23,7 @@ GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu) {
         VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,  // sType
         nullptr,                                     // pNext
         cmdPoolCreateFlags,                          // CmdPoolCreateFlags
-        gpu->queueIndex(),                           // queueFamilyIndex
+        queueFamilyIndex,                            // queueFamilyIndex
     };
     VkResult result;
     VkCommandPool pool;
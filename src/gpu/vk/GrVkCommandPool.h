@@ -18,7 +18,7 @@ class GrVkGpu;
 
 class GrVkCommandPool : public GrVkManagedResource {
 public:
-    static GrVkCommandPool* Create(GrVkGpu* gpu);
+    static GrVkCommandPool* Create(GrVkGpu* gpu, uint32_t queueFamilyIndex);
 
     VkCommandPool vkCommandPool() const {
         return fCommandPool;
@@ -202,12 +202,19 @@ const GrVkDescriptorSet* GrVkDescriptorSetManager::getDescriptorSet(GrVkGpu* gpu
         ds = fFreeSets[count - 1];
         fFreeSets.removeShuffle(count - 1);
     } else {
-        VkDescriptorSet vkDS;
-        if (!fPoolManager.getNewDescriptorSet(gpu, &vkDS)) {
+        VkDescriptorSet vkSets[DescriptorPoolManager::kAllocBatchCount];
+        uint32_t setCount = DescriptorPoolManager::kAllocBatchCount;
+        if (!fPoolManager.getNewDescriptorSets(gpu, vkSets, &setCount)) {
             return nullptr;
         }
 
-        ds = new GrVkDescriptorSet(gpu, vkDS, fPoolManager.fPool, handle);
+        SkASSERT(setCount >= 1);
+        ds = new GrVkDescriptorSet(gpu, vkSets[0], fPoolManager.fPool, handle);
+        // The rest of the batch goes straight onto the free list so subsequent requests don't
+        // have to touch the driver allocator at all.
+        for (uint32_t i = 1; i < setCount; ++i) {
+            fFreeSets.push_back(new GrVkDescriptorSet(gpu, vkSets[i], fPoolManager.fPool, handle));
+        }
     }
     SkASSERT(ds);
     return ds;
@@ -304,17 +311,30 @@ bool GrVkDescriptorSetManager::DescriptorPoolManager::getNewPool(GrVkGpu* gpu) {
     return SkToBool(fPool);
 }
 
-bool GrVkDescriptorSetManager::DescriptorPoolManager::getNewDescriptorSet(GrVkGpu* gpu,
-                                                                          VkDescriptorSet* ds) {
+bool GrVkDescriptorSetManager::DescriptorPoolManager::getNewDescriptorSets(GrVkGpu* gpu,
+                                                                           VkDescriptorSet* ds,
+                                                                           uint32_t* count) {
+    SkASSERT(*count >= 1 && *count <= kAllocBatchCount);
     if (!fMaxDescriptors) {
         return false;
     }
-    fCurrentDescriptorCount += fDescCountPerSet;
-    if (!fPool || fCurrentDescriptorCount > fMaxDescriptors) {
+    if (!fPool || fCurrentDescriptorCount + fDescCountPerSet > fMaxDescriptors) {
         if (!this->getNewPool(gpu) ) {
             return false;
         }
-        fCurrentDescriptorCount = fDescCountPerSet;
+        fCurrentDescriptorCount = 0;
+    }
+
+    // Clamp the batch to what is left in the current pool so a single allocation never has to
+    // span two pools. Always ask for at least one set, matching the old single-set behavior
+    // when a set's descriptor count oversubscribes the pool.
+    uint32_t setsLeft = (fMaxDescriptors - fCurrentDescriptorCount) / fDescCountPerSet;
+    *count = std::max(1u, std::min(*count, setsLeft));
+    fCurrentDescriptorCount += fDescCountPerSet * (*count);
+
+    VkDescriptorSetLayout layouts[kAllocBatchCount];
+    for (uint32_t i = 0; i < *count; ++i) {
+        layouts[i] = fDescLayout;
     }
 
     VkDescriptorSetAllocateInfo dsAllocateInfo;
@@ -322,8 +342,8 @@ bool GrVkDescriptorSetManager::DescriptorPoolManager::getNewDescriptorSet(GrVkGp
     dsAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     dsAllocateInfo.pNext = nullptr;
     dsAllocateInfo.descriptorPool = fPool->descPool();
-    dsAllocateInfo.descriptorSetCount = 1;
-    dsAllocateInfo.pSetLayouts = &fDescLayout;
+    dsAllocateInfo.descriptorSetCount = *count;
+    dsAllocateInfo.pSetLayouts = layouts;
     VkResult result;
     GR_VK_CALL_RESULT(gpu, result, AllocateDescriptorSets(gpu->device(),
                                                           &dsAllocateInfo,
@@ -57,7 +57,14 @@ private:
             SkASSERT(!fPool);
         }
 
-        bool getNewDescriptorSet(GrVkGpu* gpu, VkDescriptorSet* ds);
+        // Number of descriptor sets requested from the pool per vkAllocateDescriptorSets call.
+        // Allocating in batches keeps the per-draw hot path from hitting the driver allocator;
+        // the extra sets seed the manager's free list.
+        static constexpr uint32_t kAllocBatchCount = 16;
+
+        // Allocates up to '*count' descriptor sets in a single call, clamped to what is left in
+        // the current pool. On success '*count' holds the number actually allocated (at least 1).
+        bool getNewDescriptorSets(GrVkGpu* gpu, VkDescriptorSet* ds, uint32_t* count);
 
         void freeGPUResources(GrVkGpu* gpu);
 
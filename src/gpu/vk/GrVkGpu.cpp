@@ -40,9 +40,11 @@
 #include "src/gpu/vk/GrVkRenderPass.h"
 #include "src/gpu/vk/GrVkResourceProvider.h"
 #include "src/gpu/vk/GrVkSemaphore.h"
+#include "src/gpu/vk/GrVkSubmitThread.h"
 #include "src/gpu/vk/GrVkTexture.h"
 #include "src/gpu/vk/GrVkTextureRenderTarget.h"
 #include "src/gpu/vk/GrVkTransferBuffer.h"
+#include "src/gpu/vk/GrVkTransferQueue.h"
 #include "src/image/SkImage_Gpu.h"
 #include "src/image/SkSurface_Gpu.h"
 #include "src/sksl/SkSLCompiler.h"
@@ -237,9 +239,26 @@ GrVkGpu::GrVkGpu(GrDirectContext* direct, const GrContextOptions& options,
         SkASSERT(this->currentCommandBuffer());
         this->currentCommandBuffer()->begin(this);
     }
+
+    // Protected work must all stay on the protected graphics queue, so we only use a client
+    // supplied transfer queue for unprotected contexts.
+    if (backendContext.fTransferQueue != VK_NULL_HANDLE &&
+        backendContext.fTransferQueueIndex != fQueueIndex &&
+        fProtectedContext == GrProtected::kNo) {
+        fTransferQueue = GrVkTransferQueue::Make(this, backendContext.fTransferQueue,
+                                                 backendContext.fTransferQueueIndex);
+    }
+
+    if (options.fUseDedicatedVulkanSubmitThread) {
+        fSubmitThread = std::make_unique<GrVkSubmitThread>(this, fQueue);
+    }
 }
 
 void GrVkGpu::destroyResources() {
+    // Flush any pipelined submissions and retire the submit thread so the queue can be used on
+    // this thread.
+    fSubmitThread.reset();
+
     if (fMainCmdPool) {
         fMainCmdPool->getPrimaryCommandBuffer()->end(this);
         fMainCmdPool->close();
@@ -271,6 +290,11 @@ void GrVkGpu::destroyResources() {
         fMainCmdPool = nullptr;
     }
 
+    if (fTransferQueue) {
+        fTransferQueue->destroyResources();
+        fTransferQueue.reset();
+    }
+
     for (int i = 0; i < fSemaphoresToWaitOn.count(); ++i) {
         fSemaphoresToWaitOn[i]->unref();
     }
@@ -283,6 +307,12 @@ void GrVkGpu::destroyResources() {
 
     fStagingBufferManager.reset();
 
+    // Save the driver-level pipeline cache so that warm starts can skip pipeline compilation.
+    // Clients can also trigger this explicitly (and earlier) via storeVkPipelineCacheData().
+    if (VK_ERROR_DEVICE_LOST != res) {
+        this->storeVkPipelineCacheData();
+    }
+
     // must call this just before we destroy the command pool and VkDevice
     fResourceProvider.destroyResources(VK_ERROR_DEVICE_LOST == res);
 }
@@ -336,6 +366,15 @@ bool GrVkGpu::submitCommandBuffer(SyncQueue sync) {
     }
     SkASSERT(!fCachedOpsRenderPass || !fCachedOpsRenderPass->isActive());
 
+    // Uploads batched on the dedicated transfer queue must be submitted before the graphics
+    // queue work that reads them. The semaphore signaled by that submit is added to our wait
+    // list so the two submissions are ordered on the GPU.
+    if (fTransferQueue && fTransferQueue->hasPendingWork()) {
+        if (GrVkSemaphore::Resource* transferFinished = fTransferQueue->submit()) {
+            fSemaphoresToWaitOn.push_back(transferFinished);
+        }
+    }
+
     if (!this->currentCommandBuffer()->hasWork() && kForce_SyncQueue != sync &&
         !fSemaphoresToSignal.count() && !fSemaphoresToWaitOn.count()) {
         // We may have added finished procs during the flush call. Since there is no actual work
@@ -344,13 +383,48 @@ bool GrVkGpu::submitCommandBuffer(SyncQueue sync) {
         // finished.
         this->currentCommandBuffer()->callFinishedProcs();
         SkASSERT(fDrawables.empty());
-        fResourceProvider.checkCommandBuffers();
+        this->checkFinishProcs();
         return true;
     }
 
     fMainCmdBuffer->end(this);
     SkASSERT(fMainCmdPool);
     fMainCmdPool->close();
+
+    if (fSubmitThread && kSkip_SyncQueue == sync && !fSemaphoresToSignal.count()) {
+        // Pipeline the vkQueueSubmit behind the client's next frame of recording. Submissions
+        // that signal client-visible semaphores stay synchronous: a binary semaphore may not be
+        // waited on (e.g. by the client's present) before its signal has been submitted.
+        GrVkSubmitThread::SubmitJob job;
+        job.fCmdBuffer = fMainCmdBuffer;
+        job.fSignalSemaphores = std::move(fSemaphoresToSignal);
+        job.fWaitSemaphores = std::move(fSemaphoresToWaitOn);
+        job.fDrawables = std::move(fDrawables);
+        fSemaphoresToSignal.reset();
+        fSemaphoresToWaitOn.reset();
+        fDrawables.reset();
+        fSubmitThread->enqueue(std::move(job));
+
+        // Release old command pool and create a new one. The submitted pool is kept alive by the
+        // resource provider until its work has finished.
+        fMainCmdPool->unref();
+        fMainCmdPool = fResourceProvider.findOrCreateCommandPool();
+        if (fMainCmdPool) {
+            fMainCmdBuffer = fMainCmdPool->getPrimaryCommandBuffer();
+            SkASSERT(fMainCmdBuffer);
+            fMainCmdBuffer->begin(this);
+        } else {
+            fMainCmdBuffer = nullptr;
+        }
+        this->checkFinishProcs();
+        return true;
+    }
+
+    if (fSubmitThread) {
+        // A forced sync defeats pipelining anyway; drain the submit thread so the queue can be
+        // used on this thread and submit synchronously below.
+        fSubmitThread->drain();
+    }
     bool didSubmit = fMainCmdBuffer->submitToQueue(this, fQueue, fSemaphoresToSignal,
                                                    fSemaphoresToWaitOn);
 
@@ -850,13 +924,40 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
         return true;
     }
 
+    // An image that is still in VK_IMAGE_LAYOUT_UNDEFINED has never been read or written, so its
+    // initial data can be uploaded on the dedicated transfer queue and overlap rendering work on
+    // the graphics queue. The RGB_888x fixup below needs a blit or draw, which a transfer-only
+    // queue cannot do, so that case stays on the main command buffer.
+    GrVkPrimaryCommandBuffer* transferCmdBuffer = nullptr;
+    if (fTransferQueue && VK_IMAGE_LAYOUT_UNDEFINED == tex->currentLayout() &&
+        !(dataColorType == GrColorType::kRGB_888x &&
+          tex->imageFormat() == VK_FORMAT_R8G8B8_UNORM)) {
+        transferCmdBuffer = fTransferQueue->commandBuffer();
+    }
+
     // Get a staging buffer slice to hold our mip data.
     // Vulkan requires offsets in the buffer to be aligned to multiple of the texel size and 4
     size_t alignment = SkAlign4(bpp);
-    GrStagingBufferManager::Slice slice =
-            fStagingBufferManager.allocateStagingBufferSlice(combinedBufferSize, alignment);
-    if (!slice.fBuffer) {
-        return false;
+    GrStagingBufferManager::Slice slice;
+    sk_sp<GrGpuBuffer> transferStaging;
+    if (transferCmdBuffer) {
+        // The shared staging buffers are tied to the main command buffer's lifetime, so the
+        // transfer queue gets its own buffer, kept alive by the transfer command buffer.
+        transferStaging = GrVkTransferBuffer::Make(this, combinedBufferSize,
+                                                   GrVkBuffer::kCopyRead_Type);
+        void* mapPtr = transferStaging ? transferStaging->map() : nullptr;
+        if (mapPtr) {
+            slice = {transferStaging.get(), 0, mapPtr};
+        } else {
+            transferCmdBuffer = nullptr;
+            transferStaging.reset();
+        }
+    }
+    if (!transferCmdBuffer) {
+        slice = fStagingBufferManager.allocateStagingBufferSlice(combinedBufferSize, alignment);
+        if (!slice.fBuffer) {
+            return false;
+        }
     }
 
     int uploadLeft = left;
@@ -929,20 +1030,88 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
         layerHeight = currentHeight;
     }
 
-    // Change layout of our target so it can be copied to
-    uploadTexture->setImageLayout(this,
-                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                  VK_ACCESS_TRANSFER_WRITE_BIT,
-                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                  false);
-
-    // Copy the buffer to the image
-    this->currentCommandBuffer()->copyBufferToImage(this,
-                                                    static_cast<GrVkTransferBuffer*>(slice.fBuffer),
-                                                    uploadTexture,
-                                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                                    regions.count(),
-                                                    regions.begin());
+    if (transferCmdBuffer) {
+        SkASSERT(uploadTexture == tex);
+        transferStaging->unmap();
+
+        VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, uploadTexture->mipLevels(),
+                                         0, 1};
+
+        // Get the new image ready to be copied into on the transfer queue.
+        VkImageMemoryBarrier toTransferDst = {
+                VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,  // sType
+                nullptr,                                 // pNext
+                0,                                       // srcAccessMask
+                VK_ACCESS_TRANSFER_WRITE_BIT,            // dstAccessMask
+                VK_IMAGE_LAYOUT_UNDEFINED,               // oldLayout
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,    // newLayout
+                VK_QUEUE_FAMILY_IGNORED,                 // srcQueueFamilyIndex
+                VK_QUEUE_FAMILY_IGNORED,                 // dstQueueFamilyIndex
+                uploadTexture->image(),                  // image
+                range                                    // subresourceRange
+        };
+        transferCmdBuffer->pipelineBarrier(this, uploadTexture->resource(),
+                                           VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                           VK_PIPELINE_STAGE_TRANSFER_BIT, false,
+                                           GrVkCommandBuffer::kImageMemory_BarrierType,
+                                           &toTransferDst);
+
+        transferCmdBuffer->copyBufferToImage(this,
+                                             static_cast<GrVkTransferBuffer*>(slice.fBuffer),
+                                             uploadTexture,
+                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                             regions.count(),
+                                             regions.begin());
+        transferCmdBuffer->addGrBuffer(std::move(transferStaging));
+
+        // Release the image from the transfer family and acquire it on the graphics family. The
+        // execution dependency between the two halves is the semaphore that the transfer submit
+        // signals and the next graphics submit waits on.
+        VkImageMemoryBarrier releaseBarrier = {
+                VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,  // sType
+                nullptr,                                 // pNext
+                VK_ACCESS_TRANSFER_WRITE_BIT,            // srcAccessMask
+                0,                                       // dstAccessMask
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,    // oldLayout
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,    // newLayout
+                fTransferQueue->queueFamilyIndex(),      // srcQueueFamilyIndex
+                fQueueIndex,                             // dstQueueFamilyIndex
+                uploadTexture->image(),                  // image
+                range                                    // subresourceRange
+        };
+        transferCmdBuffer->pipelineBarrier(this, uploadTexture->resource(),
+                                           VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                           VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, false,
+                                           GrVkCommandBuffer::kImageMemory_BarrierType,
+                                           &releaseBarrier);
+
+        VkImageMemoryBarrier acquireBarrier = releaseBarrier;
+        acquireBarrier.srcAccessMask = 0;
+        acquireBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        this->addImageMemoryBarrier(uploadTexture->resource(),
+                                    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                    VK_PIPELINE_STAGE_TRANSFER_BIT, false, &acquireBarrier);
+
+        // Keep the tracked state consistent with what the barriers above leave behind.
+        uploadTexture->updateImageLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        uploadTexture->setQueueFamilyIndex(fQueueIndex);
+    } else {
+        // Change layout of our target so it can be copied to
+        uploadTexture->setImageLayout(this,
+                                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                      VK_ACCESS_TRANSFER_WRITE_BIT,
+                                      VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                      false);
+
+        // Copy the buffer to the image
+        this->currentCommandBuffer()->copyBufferToImage(
+                this,
+                static_cast<GrVkTransferBuffer*>(slice.fBuffer),
+                uploadTexture,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                regions.count(),
+                regions.begin());
+    }
 
     // If we copied the data into a temporary image first, copy that image into our main texture
     // now.
@@ -2052,6 +2221,11 @@ void GrVkGpu::addFinishedProc(GrGpuFinishedProc finishedProc,
 
 void GrVkGpu::addFinishedCallback(sk_sp<GrRefCntedCallback> finishedCallback) {
     SkASSERT(finishedCallback);
+    if (fSubmitThread) {
+        // The proc is added to every active command buffer, including one the submit thread may
+        // be submitting right now; wait for it so the buffers are not mutated concurrently.
+        fSubmitThread->drain();
+    }
     fResourceProvider.addFinishedProcToActiveCommandBuffers(std::move(finishedCallback));
 }
 
@@ -2059,6 +2233,15 @@ void GrVkGpu::takeOwnershipOfBuffer(sk_sp<GrGpuBuffer> buffer) {
     this->currentCommandBuffer()->addGrBuffer(std::move(buffer));
 }
 
+void GrVkGpu::checkFinishProcs() {
+    // Command buffer submit fences are created and submitted on the submit thread; only poll
+    // them once it has gone idle.
+    if (fSubmitThread && !fSubmitThread->idle()) {
+        return;
+    }
+    fResourceProvider.checkCommandBuffers();
+}
+
 bool GrVkGpu::onSubmitToGpu(bool syncCpu) {
     if (syncCpu) {
         return this->submitCommandBuffer(kForce_SyncQueue);
@@ -2538,6 +2721,11 @@ void GrVkGpu::submit(GrOpsRenderPass* renderPass) {
 }
 
 GrFence SK_WARN_UNUSED_RESULT GrVkGpu::insertFence() {
+    if (fSubmitThread) {
+        // Pipelined submissions must reach the queue before the fence so it signals after them,
+        // and the queue may only be used here while the submit thread is idle.
+        fSubmitThread->drain();
+    }
     VkFenceCreateInfo createInfo;
     memset(&createInfo, 0, sizeof(VkFenceCreateInfo));
     createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
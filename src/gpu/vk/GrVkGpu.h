@@ -31,7 +31,9 @@ class GrVkPrimaryCommandBuffer;
 class GrVkOpsRenderPass;
 class GrVkRenderPass;
 class GrVkSecondaryCommandBuffer;
+class GrVkSubmitThread;
 class GrVkTexture;
+class GrVkTransferQueue;
 struct GrVkInterface;
 
 namespace SkSL {
@@ -154,7 +156,7 @@ public:
     // command buffer to the gpu.
     void addDrawable(std::unique_ptr<SkDrawable::GpuDrawHandler> drawable);
 
-    void checkFinishProcs() override { fResourceProvider.checkCommandBuffers(); }
+    void checkFinishProcs() override;
 
     std::unique_ptr<GrSemaphore> prepareTextureForCrossContextUsage(GrTexture*) override;
 
@@ -338,6 +340,14 @@ private:
     // just a raw pointer; object's lifespan is managed by fCmdPool
     GrVkPrimaryCommandBuffer*                             fMainCmdBuffer;
 
+    // Created when the client supplies a dedicated transfer queue. Uploads recorded here overlap
+    // work on fQueue; see GrVkTransferQueue.
+    std::unique_ptr<GrVkTransferQueue>                    fTransferQueue;
+
+    // Created when GrContextOptions::fUseDedicatedVulkanSubmitThread is set. Pipelines
+    // vkQueueSubmit behind the client's next frame of recording; see GrVkSubmitThread.
+    std::unique_ptr<GrVkSubmitThread>                     fSubmitThread;
+
     SkSTArray<1, GrVkSemaphore::Resource*>                fSemaphoresToWaitOn;
     SkSTArray<1, GrVkSemaphore::Resource*>                fSemaphoresToSignal;
 
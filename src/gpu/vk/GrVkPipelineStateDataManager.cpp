@@ -7,6 +7,7 @@
 
 #include "src/gpu/vk/GrVkPipelineStateDataManager.h"
 
+#include "src/core/SkOpts.h"
 #include "src/gpu/vk/GrVkGpu.h"
 #include "src/gpu/vk/GrVkUniformBuffer.h"
 
@@ -34,8 +35,13 @@ bool GrVkPipelineStateDataManager::uploadUniformBuffers(GrVkGpu* gpu,
                                                         GrVkUniformBuffer* buffer) const {
     bool updatedBuffer = false;
     if (buffer && fUniformsDirty) {
-        SkAssertResult(buffer->updateData(gpu, fUniformData.get(),
-                                          fUniformSize, &updatedBuffer));
+        uint32_t hash = SkOpts::hash(fUniformData.get(), fUniformSize);
+        if (!fUploadedToBuffer || hash != fUploadedUniformsHash) {
+            SkAssertResult(buffer->updateData(gpu, fUniformData.get(),
+                                              fUniformSize, &updatedBuffer));
+            fUploadedUniformsHash = hash;
+            fUploadedToBuffer = true;
+        }
         fUniformsDirty = false;
     }
 
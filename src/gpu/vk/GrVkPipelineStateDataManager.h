@@ -28,6 +28,13 @@ public:
     bool uploadUniformBuffers(GrVkGpu* gpu, GrVkUniformBuffer* buffer) const;
 
 private:
+    // Hash of the uniform data most recently uploaded to the buffer. The uniform setters mark the
+    // data dirty without comparing values, so mostly static scenes re-set identical uniforms every
+    // flush. Tracking the uploaded contents lets uploadUniformBuffers skip the rewrite (and the
+    // VkBuffer the buffer would have to recycle to do it) when nothing actually changed.
+    mutable uint32_t fUploadedUniformsHash = 0;
+    mutable bool fUploadedToBuffer = false;
+
     typedef GrUniformDataManager INHERITED;
 };
 
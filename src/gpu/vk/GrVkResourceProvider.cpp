@@ -93,6 +93,7 @@ GrVkPipeline* GrVkResourceProvider::createPipeline(const GrProgramInfo& programI
                                                    int shaderStageCount,
                                                    VkRenderPass compatibleRenderPass,
                                                    VkPipelineLayout layout) {
+    fPipelineCacheDirty = true;
     return GrVkPipeline::Create(fGpu, programInfo, shaderStageInfo,
                                 shaderStageCount, compatibleRenderPass, layout,
                                 this->pipelineCache());
@@ -333,7 +334,7 @@ GrVkCommandPool* GrVkResourceProvider::findOrCreateCommandPool() {
         result = fAvailableCommandPools.back();
         fAvailableCommandPools.pop_back();
     } else {
-        result = GrVkCommandPool::Create(fGpu);
+        result = GrVkCommandPool::Create(fGpu, fGpu->queueIndex());
         if (!result) {
             return nullptr;
         }
@@ -471,6 +472,11 @@ void GrVkResourceProvider::reset(GrVkCommandPool* pool) {
 }
 
 void GrVkResourceProvider::storePipelineCacheData() {
+    // If no pipeline was compiled this run the driver-level cache contents cannot have changed,
+    // so don't re-store the blob (or create a cache just to read it back empty).
+    if (!fPipelineCacheDirty) {
+        return;
+    }
     if (this->pipelineCache() == VK_NULL_HANDLE) {
         return;
     }
@@ -495,6 +501,7 @@ void GrVkResourceProvider::storePipelineCacheData() {
 
     fGpu->getContext()->priv().getPersistentCache()->store(
             *keyData, *SkData::MakeWithoutCopy(data.get(), dataSize));
+    fPipelineCacheDirty = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
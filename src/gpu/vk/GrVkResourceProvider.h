@@ -255,6 +255,10 @@ private:
     // Central cache for creating pipelines
     VkPipelineCache fPipelineCache;
 
+    // Set when a pipeline has been compiled against fPipelineCache this run, so that
+    // storePipelineCacheData() can skip re-storing a blob that cannot have changed.
+    bool fPipelineCacheDirty = false;
+
     SkSTArray<4, CompatibleRenderPassSet> fRenderPassArray;
 
     SkTArray<const GrVkRenderPass*> fExternalRenderPasses;
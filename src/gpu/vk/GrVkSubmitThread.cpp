@@ -0,0 +1,77 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/vk/GrVkSubmitThread.h"
+
+#include "src/gpu/vk/GrVkCommandBuffer.h"
+#include "src/gpu/vk/GrVkGpu.h"
+
+GrVkSubmitThread::GrVkSubmitThread(GrVkGpu* gpu, VkQueue queue)
+        : fGpu(gpu)
+        , fQueue(queue)
+        , fThread([this] { this->threadLoop(); }) {}
+
+GrVkSubmitThread::~GrVkSubmitThread() {
+    {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fShutdown = true;
+    }
+    fCondVar.notify_all();
+    fThread.join();
+    SkASSERT(fJobs.empty());
+}
+
+void GrVkSubmitThread::enqueue(SubmitJob job) {
+    {
+        std::unique_lock<std::mutex> lock(fMutex);
+        SkASSERT(!fShutdown);
+        fJobs.push_back(std::move(job));
+    }
+    fCondVar.notify_all();
+}
+
+void GrVkSubmitThread::drain() {
+    std::unique_lock<std::mutex> lock(fMutex);
+    fCondVar.wait(lock, [this] { return fJobs.empty() && !fExecuting; });
+}
+
+bool GrVkSubmitThread::idle() {
+    std::unique_lock<std::mutex> lock(fMutex);
+    return fJobs.empty() && !fExecuting;
+}
+
+void GrVkSubmitThread::threadLoop() {
+    std::unique_lock<std::mutex> lock(fMutex);
+    while (true) {
+        fCondVar.wait(lock, [this] { return !fJobs.empty() || fShutdown; });
+        if (fJobs.empty()) {
+            SkASSERT(fShutdown);
+            return;
+        }
+        SubmitJob job = std::move(fJobs.front());
+        fJobs.pop_front();
+        fExecuting = true;
+        lock.unlock();
+
+        // If the submit fails the device is almost certainly lost. Unlike the synchronous path we
+        // cannot report that to the caller, so the wait semaphores are dropped along with the
+        // signal semaphores rather than retried on the next submission.
+        job.fCmdBuffer->submitToQueue(fGpu, fQueue, job.fSignalSemaphores, job.fWaitSemaphores);
+        for (GrVkSemaphore::Resource* semaphore : job.fSignalSemaphores) {
+            semaphore->unref();
+        }
+        for (GrVkSemaphore::Resource* semaphore : job.fWaitSemaphores) {
+            semaphore->unref();
+        }
+        // Drawables must outlive the submission of the command buffer that references them.
+        job.fDrawables.reset();
+
+        lock.lock();
+        fExecuting = false;
+        fCondVar.notify_all();
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrVkSubmitThread_DEFINED
+#define GrVkSubmitThread_DEFINED
+
+#include "include/core/SkDrawable.h"
+#include "include/gpu/vk/GrVkTypes.h"
+#include "include/private/SkTArray.h"
+#include "src/gpu/vk/GrVkSemaphore.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class GrVkGpu;
+class GrVkPrimaryCommandBuffer;
+
+/**
+ * Optional dedicated thread that performs graphics queue submission, enabled with
+ * GrContextOptions::fUseDedicatedVulkanSubmitThread. vkQueueSubmit can take a few milliseconds on
+ * some drivers; handing the closed primary command buffer to this thread lets the client start
+ * recording the next frame immediately. While enabled this is the only thread that touches the
+ * queue (callers drain it before any direct queue access), which keeps queue access externally
+ * synchronized, and jobs execute strictly in order so submissions retain their recording order.
+ */
+class GrVkSubmitThread {
+public:
+    GrVkSubmitThread(GrVkGpu*, VkQueue);
+    // Drains remaining jobs and joins the thread.
+    ~GrVkSubmitThread();
+
+    struct SubmitJob {
+        GrVkPrimaryCommandBuffer*                             fCmdBuffer;
+        SkTArray<GrVkSemaphore::Resource*>                    fSignalSemaphores;
+        SkTArray<GrVkSemaphore::Resource*>                    fWaitSemaphores;
+        SkTArray<std::unique_ptr<SkDrawable::GpuDrawHandler>> fDrawables;
+    };
+
+    void enqueue(SubmitJob);
+
+    // Blocks until every enqueued submission has reached the queue.
+    void drain();
+
+    // True when no job is queued or executing. A true result also guarantees the effects of all
+    // prior jobs (e.g. the command buffers' submit fences) are visible to the caller.
+    bool idle();
+
+private:
+    void threadLoop();
+
+    GrVkGpu* fGpu;
+    VkQueue  fQueue;
+
+    std::mutex              fMutex;
+    std::condition_variable fCondVar;
+    std::deque<SubmitJob>   fJobs;              // guarded by fMutex
+    bool                    fExecuting = false; // guarded by fMutex
+    bool                    fShutdown = false;  // guarded by fMutex
+    std::thread             fThread;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/vk/GrVkTransferQueue.h"
+
+#include "src/gpu/vk/GrVkCommandBuffer.h"
+#include "src/gpu/vk/GrVkCommandPool.h"
+#include "src/gpu/vk/GrVkGpu.h"
+
+std::unique_ptr<GrVkTransferQueue> GrVkTransferQueue::Make(GrVkGpu* gpu, VkQueue queue,
+                                                           uint32_t queueFamilyIndex) {
+    SkASSERT(queue != VK_NULL_HANDLE);
+    // Ownership transfers back to the graphics family assume the two families differ.
+    SkASSERT(queueFamilyIndex != gpu->queueIndex());
+    return std::unique_ptr<GrVkTransferQueue>(
+            new GrVkTransferQueue(gpu, queue, queueFamilyIndex));
+}
+
+GrVkTransferQueue::GrVkTransferQueue(GrVkGpu* gpu, VkQueue queue, uint32_t queueFamilyIndex)
+        : fGpu(gpu)
+        , fQueue(queue)
+        , fQueueFamilyIndex(queueFamilyIndex) {}
+
+GrVkTransferQueue::~GrVkTransferQueue() {
+    // destroyResources must have been called.
+    SkASSERT(!fCurrentPool && fInFlightPools.empty());
+}
+
+GrVkCommandPool* GrVkTransferQueue::acquirePool() {
+    for (int i = 0; i < fInFlightPools.count(); ++i) {
+        GrVkCommandPool* pool = fInFlightPools[i];
+        if (pool->getPrimaryCommandBuffer()->finished(fGpu)) {
+            fInFlightPools.removeShuffle(i);
+            pool->releaseResources();
+            pool->reset(fGpu);
+            return pool;
+        }
+    }
+    return GrVkCommandPool::Create(fGpu, fQueueFamilyIndex);
+}
+
+GrVkPrimaryCommandBuffer* GrVkTransferQueue::commandBuffer() {
+    if (!fRecording) {
+        if (!fCurrentPool) {
+            fCurrentPool = this->acquirePool();
+            if (!fCurrentPool) {
+                return nullptr;
+            }
+        }
+        fCurrentPool->getPrimaryCommandBuffer()->begin(fGpu);
+        fRecording = true;
+    }
+    return fCurrentPool->getPrimaryCommandBuffer();
+}
+
+GrVkSemaphore::Resource* GrVkTransferQueue::submit() {
+    if (!fRecording) {
+        return nullptr;
+    }
+    fRecording = false;
+
+    GrVkPrimaryCommandBuffer* cmdBuffer = fCurrentPool->getPrimaryCommandBuffer();
+    cmdBuffer->end(fGpu);
+    fCurrentPool->close();
+
+    std::unique_ptr<GrVkSemaphore> semaphore = GrVkSemaphore::Make(fGpu, /*isOwned=*/true);
+    SkSTArray<1, GrVkSemaphore::Resource*> signal;
+    SkSTArray<1, GrVkSemaphore::Resource*> wait;
+    if (semaphore) {
+        semaphore->getResource()->ref();
+        signal.push_back(semaphore->getResource());
+    }
+
+    bool didSubmit = cmdBuffer->submitToQueue(fGpu, fQueue, signal, wait);
+    fInFlightPools.push_back(fCurrentPool);
+    fCurrentPool = nullptr;
+
+    if (!didSubmit || !semaphore) {
+        for (GrVkSemaphore::Resource* resource : signal) {
+            resource->unref();
+        }
+        return nullptr;
+    }
+    // The semaphore wrapper drops its own ref when it goes out of scope; the ref we took above
+    // passes to the caller.
+    return signal[0];
+}
+
+void GrVkTransferQueue::destroyResources() {
+    if (fRecording) {
+        // Work was recorded but never submitted; just close it out.
+        fCurrentPool->getPrimaryCommandBuffer()->end(fGpu);
+        fCurrentPool->close();
+        fRecording = false;
+    }
+
+    SkDEBUGCODE(VkResult res = ) GR_VK_CALL(fGpu->vkInterface(), QueueWaitIdle(fQueue));
+    SkASSERT(VK_SUCCESS == res || VK_ERROR_DEVICE_LOST == res);
+
+    if (fCurrentPool) {
+        fCurrentPool->unref();
+        fCurrentPool = nullptr;
+    }
+    for (GrVkCommandPool* pool : fInFlightPools) {
+        pool->unref();
+    }
+    fInFlightPools.reset();
+}
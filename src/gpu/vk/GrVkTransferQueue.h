@@ -0,0 +1,68 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrVkTransferQueue_DEFINED
+#define GrVkTransferQueue_DEFINED
+
+#include "include/gpu/vk/GrVkTypes.h"
+#include "include/private/SkTArray.h"
+#include "src/gpu/vk/GrVkSemaphore.h"
+
+#include <memory>
+
+class GrVkCommandPool;
+class GrVkGpu;
+class GrVkPrimaryCommandBuffer;
+
+/**
+ * Owns a client-supplied dedicated transfer queue and the command pools used to record on it.
+ * Texture uploads batched here execute concurrently with draws on the main graphics queue. Each
+ * submit signals a semaphore which the caller adds as a wait to the next graphics submission;
+ * that wait, together with the queue family ownership transfer recorded with the upload, hands
+ * the written images over to the graphics queue.
+ */
+class GrVkTransferQueue {
+public:
+    static std::unique_ptr<GrVkTransferQueue> Make(GrVkGpu*, VkQueue, uint32_t queueFamilyIndex);
+
+    ~GrVkTransferQueue();
+
+    uint32_t queueFamilyIndex() const { return fQueueFamilyIndex; }
+
+    // Returns the command buffer currently collecting transfer work, beginning a new one if
+    // needed. Returns null if a command pool could not be created (e.g. lost device).
+    GrVkPrimaryCommandBuffer* commandBuffer();
+
+    bool hasPendingWork() const { return fRecording; }
+
+    // Ends and submits the pending command buffer. On success returns a ref on a semaphore
+    // Resource that was submitted for signal; the caller must submit it for wait on the queue
+    // that consumes the uploads (and unref it). Returns null if there was nothing to submit or
+    // the submit failed.
+    GrVkSemaphore::Resource* submit();
+
+    // Waits for the queue to idle and drops all command pools. Must be called before the
+    // GrVkGpu tears down its resources.
+    void destroyResources();
+
+private:
+    GrVkTransferQueue(GrVkGpu*, VkQueue, uint32_t queueFamilyIndex);
+
+    // Recycles a submitted pool whose work has finished, or creates a new one.
+    GrVkCommandPool* acquirePool();
+
+    GrVkGpu*                       fGpu;
+    VkQueue                        fQueue;
+    uint32_t                       fQueueFamilyIndex;
+
+    GrVkCommandPool*               fCurrentPool = nullptr;
+    bool                           fRecording = false;
+    // Submitted pools whose primary buffers may still be in flight.
+    SkSTArray<2, GrVkCommandPool*> fInFlightPools;
+};
+
+#endif
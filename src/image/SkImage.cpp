@@ -93,6 +93,13 @@ void SkImage::asyncRescaleAndReadPixelsYUV420(SkYUVColorSpace yuvColorSpace,
                                                    context);
 }
 
+void SkImage::prepareForDrawing(SkExecutor* executor,
+                                PrepareForDrawingCallback callback,
+                                PrepareForDrawingContext context) {
+    SkASSERT(executor);
+    as_IB(this)->onPrepareForDrawing(executor, callback, context);
+}
+
 bool SkImage::scalePixels(const SkPixmap& dst, SkFilterQuality quality, CachingHint chint) const {
     if (this->width() == dst.width() && this->height() == dst.height()) {
         return this->readPixels(dst, 0, 0, chint);
@@ -263,6 +270,44 @@ SkImage_Base::~SkImage_Base() {
     }
 }
 
+sk_sp<const SkMipmap> SkImage_Base::refCachedMipLevel(int levelBucket,
+                                                      SkMipmap::Level* level) const {
+    SkAutoMutexExclusive lock(fMipLevelCacheMutex);
+    for (const CachedMipLevel& entry : fMipLevelCache) {
+        if (entry.fBucket == levelBucket) {
+            *level = entry.fLevel;
+            return fMipLevelCacheMips;
+        }
+    }
+    return nullptr;
+}
+
+void SkImage_Base::cacheMipLevel(int levelBucket, const SkMipmap::Level& level,
+                                 sk_sp<const SkMipmap> mips) const {
+    SkAutoMutexExclusive lock(fMipLevelCacheMutex);
+    if (fMipLevelCacheMips != mips) {
+        // A new (or rebuilt) mipmap; any cached levels point into the old one.
+        for (CachedMipLevel& entry : fMipLevelCache) {
+            entry.fBucket = -1;
+        }
+        fMipLevelCacheNext = 0;
+        fMipLevelCacheMips = std::move(mips);
+    }
+    CachedMipLevel& entry = fMipLevelCache[fMipLevelCacheNext];
+    fMipLevelCacheNext = (fMipLevelCacheNext + 1) % kMipLevelCacheCount;
+    entry.fBucket = levelBucket;
+    entry.fLevel  = level;
+}
+
+void SkImage_Base::onPrepareForDrawing(SkExecutor*,
+                                       PrepareForDrawingCallback callback,
+                                       PrepareForDrawingContext context) {
+    // Non-lazy images already have their pixels.
+    if (callback) {
+        callback(context, true);
+    }
+}
+
 void SkImage_Base::onAsyncRescaleAndReadPixels(const SkImageInfo& info,
                                                const SkIRect& origSrcRect,
                                                RescaleGamma rescaleGamma,
@@ -10,6 +10,7 @@
 
 #include "include/core/SkImage.h"
 #include "include/core/SkSurface.h"
+#include "include/private/SkMutex.h"
 #include "src/core/SkMipmap.h"
 #include <atomic>
 
@@ -49,6 +50,13 @@ public:
         return sk_ref_sp(this->onPeekMips());
     }
 
+    // Memoized medium-quality mip selection. SkBitmapController resolves the same level for
+    // every draw that lands in one integer bucket of the fractional mip level, so we cache the
+    // extracted level (and a ref on the mipmap it points into) per bucket, letting repeat draws
+    // of a scaled image skip the global SkMipmapCache lookup.
+    sk_sp<const SkMipmap> refCachedMipLevel(int levelBucket, SkMipmap::Level*) const;
+    void cacheMipLevel(int levelBucket, const SkMipmap::Level&, sk_sp<const SkMipmap>) const;
+
     /**
      * Default implementation does a rescale/read and then calls the callback.
      */
@@ -70,6 +78,14 @@ public:
                                                    ReadPixelsCallback,
                                                    ReadPixelsContext);
 
+    /**
+     * Default implementation assumes the pixels are already available and just invokes the
+     * callback; SkImage_Lazy overrides this to run its generator decode on the executor.
+     */
+    virtual void onPrepareForDrawing(SkExecutor*,
+                                     PrepareForDrawingCallback,
+                                     PrepareForDrawingContext);
+
     virtual GrContext* context() const { return nullptr; }
 
 #if SK_SUPPORT_GPU
@@ -141,6 +157,16 @@ private:
     // Set true by caches when they cache content that's derived from the current pixels.
     mutable std::atomic<bool> fAddedToRasterCache;
 
+    static constexpr int kMipLevelCacheCount = 4;
+    struct CachedMipLevel {
+        int             fBucket = -1;
+        SkMipmap::Level fLevel;
+    };
+    mutable SkMutex               fMipLevelCacheMutex;
+    mutable sk_sp<const SkMipmap> fMipLevelCacheMips;   // the mipmap the cached levels point into
+    mutable CachedMipLevel        fMipLevelCache[kMipLevelCacheCount];
+    mutable int                   fMipLevelCacheNext = 0;
+
     typedef SkImage INHERITED;
 };
 
@@ -9,6 +9,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageGenerator.h"
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkCachedData.h"
@@ -162,6 +163,40 @@ bool SkImage_Lazy::getROPixels(SkBitmap* bitmap, SkImage::CachingHint chint) con
     return true;
 }
 
+void SkImage_Lazy::onPrepareForDrawing(SkExecutor* executor,
+                                       SkImage::PrepareForDrawingCallback callback,
+                                       SkImage::PrepareForDrawingContext context) {
+    SkASSERT(executor);
+    {
+        SkAutoMutexExclusive lock(fPrepareMutex);
+        if (callback) {
+            fPrepareWaiters.push_back({callback, context});
+        }
+        if (fPrepareInFlight) {
+            // A decode task is already scheduled; it will fire our callback too.
+            return;
+        }
+        fPrepareInFlight = true;
+    }
+    executor->add([self = sk_ref_sp(this)] {
+        // getROPixels() installs the decoded pixels in SkBitmapCache under our unique ID,
+        // where both raster draws and GPU uploads will find them.
+        SkBitmap bm;
+        const bool success = self->getROPixels(&bm, SkImage::kAllow_CachingHint);
+
+        SkTArray<PrepareWaiter> waiters;
+        {
+            SkAutoMutexExclusive lock(self->fPrepareMutex);
+            waiters = std::move(self->fPrepareWaiters);
+            self->fPrepareWaiters.reset();
+            self->fPrepareInFlight = false;
+        }
+        for (const PrepareWaiter& waiter : waiters) {
+            waiter.fCallback(waiter.fContext, success);
+        }
+    });
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool SkImage_Lazy::onReadPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRB,
@@ -258,7 +293,7 @@ GrSurfaceProxyView SkImage_Lazy::textureProxyViewFromPlanes(GrRecordingContext*
     SkYUVASizeInfo yuvSizeInfo;
     SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount];
     SkYUVColorSpace yuvColorSpace;
-    const void* planes[SkYUVASizeInfo::kMaxCount];
+    SkBitmap planes[SkYUVASizeInfo::kMaxCount];
 
     sk_sp<SkCachedData> dataStorage =
             this->getPlanes(&yuvSizeInfo, yuvaIndices, &yuvColorSpace, planes);
@@ -273,38 +308,15 @@ GrSurfaceProxyView SkImage_Lazy::textureProxyViewFromPlanes(GrRecordingContext*
             continue;
         }
 
-        int componentWidth = yuvSizeInfo.fSizes[i].fWidth;
-        int componentHeight = yuvSizeInfo.fSizes[i].fHeight;
-        // If the sizes of the components are not all the same we choose to create exact-match
-        // textures for the smaller ones rather than add a texture domain to the draw.
-        // TODO: revisit this decision to improve texture reuse?
-        SkBackingFit fit =
-                (componentWidth  != yuvSizeInfo.fSizes[0].fWidth) ||
-                (componentHeight != yuvSizeInfo.fSizes[0].fHeight)
-                ? SkBackingFit::kExact : SkBackingFit::kApprox;
-
-        SkImageInfo imageInfo = SkImageInfo::MakeA8(componentWidth, componentHeight);
-        SkCachedData* dataStoragePtr = dataStorage.get();
-        // We grab a ref to cached yuv data. When the SkBitmap we create below goes away it will
-        // call the YUVGen_DataReleaseProc which will release this ref.
+        // The planes cache hands out bitmaps whose generation IDs are stable for the life of
+        // its entry, so kDraw policy lets the proxy provider key each plane texture per context
+        // and reuse it across draws instead of re-uploading the same data. The bitmaps keep the
+        // cached data alive for any lazy proxy's upload.
         // DDL TODO: Currently we end up creating a lazy proxy that will hold onto a ref to the
         // SkImage in its lambda. This means that we'll keep the ref on the YUV data around for the
         // life time of the proxy and not just upload. For non-DDL draws we should look into
         // releasing this SkImage after uploads (by deleting the lambda after instantiation).
-        dataStoragePtr->ref();
-        SkBitmap bitmap;
-        auto releaseProc = [](void*, void* data) {
-            SkCachedData* cachedData = static_cast<SkCachedData*>(data);
-            SkASSERT(cachedData);
-            cachedData->unref();
-        };
-
-        SkAssertResult(bitmap.installPixels(imageInfo, const_cast<void*>(planes[i]),
-                                            yuvSizeInfo.fWidthBytes[i], releaseProc,
-                                            dataStoragePtr));
-        bitmap.setImmutable();
-
-        GrBitmapTextureMaker maker(ctx, bitmap, fit);
+        GrBitmapTextureMaker maker(ctx, planes[i], GrImageTexGenPolicy::kDraw);
         yuvViews[i] = maker.view(GrMipmapped::kNo);
 
         if (!yuvViews[i]) {
@@ -357,79 +369,95 @@ GrSurfaceProxyView SkImage_Lazy::textureProxyViewFromPlanes(GrRecordingContext*
     return renderTargetContext->readSurfaceView();
 }
 
-sk_sp<SkCachedData> SkImage_Lazy::getPlanes(
-        SkYUVASizeInfo* yuvaSizeInfo,
-        SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
-        SkYUVColorSpace* yuvColorSpace,
-        const void* outPlanes[SkYUVASizeInfo::kMaxCount]) const {
-    ScopedGenerator generator(fSharedGenerator);
-
-    sk_sp<SkCachedData> data;
-    SkYUVPlanesCache::Info yuvInfo;
-    data.reset(SkYUVPlanesCache::FindAndRef(generator->uniqueID(), &yuvInfo));
+// Queries the generator's plane layout, obtains plane 0's base address from the allocator
+// (planes are packed contiguously after it), and decodes into that memory. On success,
+// planes[] point into the allocator's memory and yuvInfo describes the layout.
+static bool decode_yuva_planes(SkImageGenerator* generator,
+                               SkYUVPlanesCache::Info* yuvInfo,
+                               const SkImage_Lazy::YUVAPlaneAllocator& alloc,
+                               void* planes[SkYUVASizeInfo::kMaxCount]) {
+    // Fetch yuv plane sizes for memory allocation.
+    if (!generator->queryYUVA8(&yuvInfo->fSizeInfo, yuvInfo->fYUVAIndices,
+                               &yuvInfo->fColorSpace)) {
+        return false;
+    }
 
-    void* planes[SkYUVASizeInfo::kMaxCount];
+    // Allocate the memory for YUVA
+    size_t totalSize(0);
+    for (int i = 0; i < SkYUVASizeInfo::kMaxCount; i++) {
+        SkASSERT((yuvInfo->fSizeInfo.fWidthBytes[i] && yuvInfo->fSizeInfo.fSizes[i].fHeight) ||
+                 (!yuvInfo->fSizeInfo.fWidthBytes[i] && !yuvInfo->fSizeInfo.fSizes[i].fHeight));
 
-    if (data.get()) {
-        planes[0] = (void*)data->data();  // we should always have at least one plane
+        totalSize += yuvInfo->fSizeInfo.fWidthBytes[i] * yuvInfo->fSizeInfo.fSizes[i].fHeight;
+    }
 
-        for (int i = 1; i < SkYUVASizeInfo::kMaxCount; ++i) {
-            if (!yuvInfo.fSizeInfo.fWidthBytes[i]) {
-                SkASSERT(!yuvInfo.fSizeInfo.fWidthBytes[i] && !yuvInfo.fSizeInfo.fSizes[i].fHeight);
-                planes[i] = nullptr;
-                continue;
-            }
+    planes[0] = alloc(totalSize);
+    if (!planes[0]) {
+        return false;
+    }
 
-            planes[i] = (uint8_t*)planes[i - 1] + (yuvInfo.fSizeInfo.fWidthBytes[i - 1] *
-                                                   yuvInfo.fSizeInfo.fSizes[i - 1].fHeight);
-        }
-    } else {
-        // Fetch yuv plane sizes for memory allocation.
-        if (!generator->queryYUVA8(&yuvInfo.fSizeInfo, yuvInfo.fYUVAIndices,
-                                   &yuvInfo.fColorSpace)) {
-            return nullptr;
+    for (int i = 1; i < SkYUVASizeInfo::kMaxCount; ++i) {
+        if (!yuvInfo->fSizeInfo.fWidthBytes[i]) {
+            SkASSERT(!yuvInfo->fSizeInfo.fWidthBytes[i] && !yuvInfo->fSizeInfo.fSizes[i].fHeight);
+            planes[i] = nullptr;
+            continue;
         }
 
-        // Allocate the memory for YUVA
-        size_t totalSize(0);
-        for (int i = 0; i < SkYUVASizeInfo::kMaxCount; i++) {
-            SkASSERT((yuvInfo.fSizeInfo.fWidthBytes[i] && yuvInfo.fSizeInfo.fSizes[i].fHeight) ||
-                     (!yuvInfo.fSizeInfo.fWidthBytes[i] && !yuvInfo.fSizeInfo.fSizes[i].fHeight));
+        planes[i] = (uint8_t*)planes[i-1] + (yuvInfo->fSizeInfo.fWidthBytes[i-1] *
+                                             yuvInfo->fSizeInfo.fSizes[i-1].fHeight);
+    }
 
-            totalSize += yuvInfo.fSizeInfo.fWidthBytes[i] * yuvInfo.fSizeInfo.fSizes[i].fHeight;
-        }
+    // Get the YUV planes.
+    return generator->getYUVA8Planes(yuvInfo->fSizeInfo, yuvInfo->fYUVAIndices, planes);
+}
 
-        data.reset(SkResourceCache::NewCachedData(totalSize));
+bool SkImage_Lazy::readYUVAPlanes(SkYUVASizeInfo* yuvaSizeInfo,
+                                  SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                                  SkYUVColorSpace* yuvColorSpace,
+                                  const YUVAPlaneAllocator& alloc) const {
+    ScopedGenerator generator(fSharedGenerator);
 
-        planes[0] = data->writable_data();
+    SkYUVPlanesCache::Info yuvInfo;
+    void* planes[SkYUVASizeInfo::kMaxCount];
+    if (!decode_yuva_planes(generator, &yuvInfo, alloc, planes)) {
+        return false;
+    }
 
-        for (int i = 1; i < SkYUVASizeInfo::kMaxCount; ++i) {
-            if (!yuvInfo.fSizeInfo.fWidthBytes[i]) {
-                SkASSERT(!yuvInfo.fSizeInfo.fWidthBytes[i] && !yuvInfo.fSizeInfo.fSizes[i].fHeight);
-                planes[i] = nullptr;
-                continue;
-            }
+    *yuvaSizeInfo = yuvInfo.fSizeInfo;
+    memcpy(yuvaIndices, yuvInfo.fYUVAIndices, sizeof(yuvInfo.fYUVAIndices));
+    *yuvColorSpace = yuvInfo.fColorSpace;
+    return true;
+}
 
-            planes[i] = (uint8_t*)planes[i-1] + (yuvInfo.fSizeInfo.fWidthBytes[i-1] *
-                                                 yuvInfo.fSizeInfo.fSizes[i-1].fHeight);
-        }
+sk_sp<SkCachedData> SkImage_Lazy::getPlanes(
+        SkYUVASizeInfo* yuvaSizeInfo,
+        SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+        SkYUVColorSpace* yuvColorSpace,
+        SkBitmap outPlanes[SkYUVASizeInfo::kMaxCount]) const {
+    ScopedGenerator generator(fSharedGenerator);
+
+    sk_sp<SkCachedData> data;
+    SkYUVPlanesCache::Info yuvInfo;
+    data.reset(SkYUVPlanesCache::FindAndRef(generator->uniqueID(), &yuvInfo, outPlanes));
 
-        // Get the YUV planes.
-        if (!generator->getYUVA8Planes(yuvInfo.fSizeInfo, yuvInfo.fYUVAIndices, planes)) {
+    if (!data) {
+        void* planes[SkYUVASizeInfo::kMaxCount];
+        auto cachedAlloc = [&data](size_t totalSize) {
+            data.reset(SkResourceCache::NewCachedData(totalSize));
+            return data->writable_data();
+        };
+        if (!decode_yuva_planes(generator, &yuvInfo, cachedAlloc, planes)) {
             return nullptr;
         }
 
-        // Decoding is done, cache the resulting YUV planes
-        SkYUVPlanesCache::Add(this->uniqueID(), data.get(), &yuvInfo);
+        // Decoding is done, cache the resulting YUV planes. The cache builds the stable
+        // per-plane bitmaps we hand back to the caller.
+        SkYUVPlanesCache::Add(this->uniqueID(), data.get(), &yuvInfo, outPlanes);
     }
 
     *yuvaSizeInfo = yuvInfo.fSizeInfo;
     memcpy(yuvaIndices, yuvInfo.fYUVAIndices, sizeof(yuvInfo.fYUVAIndices));
     *yuvColorSpace = yuvInfo.fColorSpace;
-    outPlanes[0] = planes[0];
-    outPlanes[1] = planes[1];
-    outPlanes[2] = planes[2];
-    outPlanes[3] = planes[3];
     return data;
 }
 
@@ -10,6 +10,7 @@
 
 #include "include/private/SkIDChangeListener.h"
 #include "include/private/SkMutex.h"
+#include "include/private/SkTArray.h"
 #include "src/gpu/SkGr.h"
 #include "src/image/SkImage_Base.h"
 
@@ -17,6 +18,8 @@
 #include "src/gpu/GrTextureMaker.h"
 #endif
 
+#include <functional>
+
 class SharedGenerator;
 
 class SkImage_Lazy : public SkImage_Base {
@@ -43,12 +46,31 @@ public:
     sk_sp<SkImage> onMakeSubset(const SkIRect&, GrDirectContext*) const override;
     bool getROPixels(SkBitmap*, CachingHint) const override;
     bool onIsLazyGenerated() const override { return true; }
+    void onPrepareForDrawing(SkExecutor*,
+                             SkImage::PrepareForDrawingCallback,
+                             SkImage::PrepareForDrawingContext) override;
     sk_sp<SkImage> onMakeColorTypeAndColorSpace(SkColorType, sk_sp<SkColorSpace>,
                                                 GrDirectContext*) const override;
     sk_sp<SkImage> onReinterpretColorSpace(sk_sp<SkColorSpace>) const final;
 
     bool onIsValid(GrRecordingContext*) const override;
 
+#if SK_SUPPORT_GPU
+    // Called with the total byte size of the planes once the final plane layout is known.
+    // Returns the base address for plane 0 -- the remaining planes are packed contiguously
+    // after it, as in getPlanes() -- or null to fail the decode.
+    using YUVAPlaneAllocator = std::function<void*(size_t totalBytes)>;
+
+    // Decodes the generator's YUVA planes directly into memory obtained from the allocator,
+    // e.g. the mapped memory of a GPU transfer buffer, so the caller can skip the CPU-side
+    // copy of the planes that getPlanes() would otherwise make and cache. Always performs a
+    // fresh decode; the result is not stored in (or read from) the SkYUVPlanesCache.
+    bool readYUVAPlanes(SkYUVASizeInfo*,
+                        SkYUVAIndex[4],
+                        SkYUVColorSpace*,
+                        const YUVAPlaneAllocator&) const;
+#endif
+
 #if SK_SUPPORT_GPU
     // Returns the texture proxy. CachingHint refers to whether the generator's output should be
     // cached in CPU memory. We will always cache the generated texture on success.
@@ -69,7 +91,7 @@ private:
     sk_sp<SkCachedData> getPlanes(SkYUVASizeInfo*,
                                   SkYUVAIndex[4],
                                   SkYUVColorSpace*,
-                                  const void* planes[4]) const;
+                                  SkBitmap planes[4]) const;
     GrSurfaceProxyView textureProxyViewFromPlanes(GrRecordingContext*, SkBudgeted) const;
 #endif
 
@@ -85,6 +107,16 @@ private:
     mutable SkMutex             fOnMakeColorTypeAndSpaceMutex;
     mutable sk_sp<SkImage>      fOnMakeColorTypeAndSpaceResult;
 
+    // State for onPrepareForDrawing: at most one decode task is in flight per image; callers
+    // arriving while it runs just queue their callbacks.
+    struct PrepareWaiter {
+        SkImage::PrepareForDrawingCallback* fCallback;
+        SkImage::PrepareForDrawingContext   fContext;
+    };
+    SkMutex                 fPrepareMutex;
+    bool                    fPrepareInFlight = false;
+    SkTArray<PrepareWaiter> fPrepareWaiters;
+
 #if SK_SUPPORT_GPU
     // When the SkImage_Lazy goes away, we will iterate over all the listeners to inform them
     // of the unique ID's demise. This is used to remove cached textures from GrContext.
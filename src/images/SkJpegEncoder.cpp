@@ -14,11 +14,15 @@
 #include "include/private/SkColorData.h"
 #include "include/private/SkImageInfoPriv.h"
 #include "include/private/SkTemplates.h"
+#include "include/private/SkSemaphore.h"
 #include "src/core/SkMSAN.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/images/SkImageEncoderFns.h"
 #include "src/images/SkJPEGWriteUtility.h"
 
+#include <atomic>
 #include <stdio.h>
+#include <vector>
 
 extern "C" {
     #include "jpeglib.h"
@@ -249,7 +253,239 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
     return true;
 }
 
+// Upper bound on the number of bands Encode() splits an image into when Options::fParallel
+// is set; matches the task cap of the parallel decoder in SkJpegCodec.
+static constexpr int kMaxParallelEncodeTasks = 16;
+
+/*
+ * Encodes |band| as a standalone jpeg whose header declares |restartInterval| (in MCUs).
+ * The caller stitches the bands' entropy data together with restart markers, so every band
+ * must produce an identical header; optimized Huffman coding is disabled to that end.
+ */
+static bool encode_band(SkWStream* dst, const SkPixmap& band,
+                        const SkJpegEncoder::Options& options, int restartInterval,
+                        const SkData* iccMarkerData) {
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return false;
+    }
+
+    if (!encoderMgr->setParams(band.info(), options)) {
+        return false;
+    }
+
+    jpeg_set_quality(encoderMgr->cinfo(), options.fQuality, TRUE);
+    encoderMgr->cinfo()->optimize_coding = FALSE;
+    encoderMgr->cinfo()->restart_interval = restartInterval;
+    jpeg_start_compress(encoderMgr->cinfo(), TRUE);
+
+    if (iccMarkerData) {
+        jpeg_write_marker(encoderMgr->cinfo(), kICCMarker, iccMarkerData->bytes(),
+                          iccMarkerData->size());
+    }
+
+    const size_t srcBytes = SkColorTypeBytesPerPixel(band.colorType()) * band.width();
+    const size_t jpegSrcBytes = encoderMgr->cinfo()->input_components * band.width();
+    SkAutoTMalloc<uint8_t> storage(encoderMgr->proc() ? jpegSrcBytes : 0);
+
+    const void* srcRow = band.addr(0, 0);
+    for (int y = 0; y < band.height(); y++) {
+        JSAMPLE* jpegSrcRow = (JSAMPLE*) srcRow;
+        if (encoderMgr->proc()) {
+            sk_msan_assert_initialized(srcRow, SkTAddOffset<const void>(srcRow, srcBytes));
+            encoderMgr->proc()((char*)storage.get(),
+                               (const char*)srcRow,
+                               band.width(),
+                               encoderMgr->cinfo()->input_components);
+            jpegSrcRow = storage.get();
+        }
+        sk_msan_assert_initialized(jpegSrcRow,
+                                   SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
+
+        jpeg_write_scanlines(encoderMgr->cinfo(), &jpegSrcRow, 1);
+        srcRow = SkTAddOffset<const void>(srcRow, band.rowBytes());
+    }
+
+    jpeg_finish_compress(encoderMgr->cinfo());
+    return true;
+}
+
+/*
+ * Returns the offset of the first entropy-coded byte (just past the SOS header) in a jpeg
+ * produced by encode_band(), or 0 on failure.
+ */
+static size_t find_band_entropy_start(const uint8_t* data, size_t len) {
+    size_t pos = 2;  // skip the SOI marker
+    while (pos + 4 <= len) {
+        if (0xFF != data[pos]) {
+            return 0;
+        }
+        const size_t segment = 2 + ((data[pos + 2] << 8) | data[pos + 3]);
+        if (0xDA == data[pos + 1]) {  // SOS
+            return pos + segment;
+        }
+        pos += segment;
+    }
+    return 0;
+}
+
+/*
+ * The first band's header declares that band's height; patch the SOF dimensions field to
+ * cover the full image. Returns false if no SOF marker is found.
+ */
+static bool patch_sof_height(uint8_t* data, size_t len, int height) {
+    size_t pos = 2;  // skip the SOI marker
+    while (pos + 4 <= len) {
+        if (0xFF != data[pos]) {
+            return false;
+        }
+        const uint8_t marker = data[pos + 1];
+        if (0xC0 <= marker && marker <= 0xCF &&
+                0xC4 != marker && 0xC8 != marker && 0xCC != marker) {
+            // FF Cn | length (2) | precision (1) | height (2) | width (2) | ...
+            if (pos + 7 > len) {
+                return false;
+            }
+            data[pos + 5] = height >> 8;
+            data[pos + 6] = height & 0xFF;
+            return true;
+        }
+        pos += 2 + ((data[pos + 2] << 8) | data[pos + 3]);
+    }
+    return false;
+}
+
+enum class ParallelResult {
+    kSuccess,   // the complete jpeg was written to dst
+    kFallback,  // preconditions unmet; nothing was written, use the serial path
+    kFailure,   // a band failed after output had begun; dst does not hold a valid jpeg
+};
+
+/*
+ * Compresses bands of whole MCU rows on SkExecutor::GetDefault() worker threads. Each band
+ * is an independent entropy stream (restart markers reset the DC predictors), so the bands
+ * can be stitched in order behind a single header -- whose declared restart interval is one
+ * band -- and streamed to |dst| as they complete.
+ */
+static ParallelResult encode_parallel(SkWStream* dst, const SkPixmap& src,
+                                      const SkJpegEncoder::Options& options) {
+    if (!SkPixmapIsValid(src)) {
+        return ParallelResult::kFallback;
+    }
+
+    // The sampling factors determine the MCU size; mirror the choices setParams() makes.
+    int hSamp = 1;
+    int vSamp = 1;
+    if (kGray_8_SkColorType != src.colorType()) {
+        switch (options.fDownsample) {
+            case SkJpegEncoder::Downsample::k420: hSamp = 2; vSamp = 2; break;
+            case SkJpegEncoder::Downsample::k422: hSamp = 2;            break;
+            case SkJpegEncoder::Downsample::k444:                       break;
+        }
+    }
+    const int mcuHeight = DCTSIZE * vSamp;
+    const int mcusPerRow = (src.width() + DCTSIZE * hSamp - 1) / (DCTSIZE * hSamp);
+    const int totalMcuRows = (src.height() + mcuHeight - 1) / mcuHeight;
+    const int mcuRowsPerBand = (totalMcuRows + kMaxParallelEncodeTasks - 1)
+                               / kMaxParallelEncodeTasks;
+    const int numBands = (totalMcuRows + mcuRowsPerBand - 1) / mcuRowsPerBand;
+    const int restartInterval = mcuRowsPerBand * mcusPerRow;
+    // The DRI segment holds a 16-bit MCU count.
+    if (numBands < 2 || restartInterval > 65535) {
+        return ParallelResult::kFallback;
+    }
+
+    sk_sp<SkData> iccMarkerData;
+    if (sk_sp<SkData> icc = icc_from_color_space(src.info())) {
+        // Create a contiguous block of memory with the icc signature followed by the profile.
+        iccMarkerData = SkData::MakeUninitialized(kICCMarkerHeaderSize + icc->size());
+        uint8_t* ptr = (uint8_t*) iccMarkerData->writable_data();
+        memcpy(ptr, kICCSig, sizeof(kICCSig));
+        ptr += sizeof(kICCSig);
+        *ptr++ = 1; // This is the first marker.
+        *ptr++ = 1; // Out of one total markers.
+        memcpy(ptr, icc->data(), icc->size());
+    }
+
+    std::vector<SkDynamicMemoryWStream> bandStreams(numBands);
+    std::unique_ptr<std::atomic<bool>[]> bandDone(new std::atomic<bool>[numBands]);
+    for (int i = 0; i < numBands; i++) {
+        bandDone[i] = false;
+    }
+    std::atomic<bool> failed(false);
+    SkSemaphore completions;
+    SkTaskGroup taskGroup;
+
+    for (int i = 0; i < numBands; i++) {
+        const int startRow = i * mcuRowsPerBand * mcuHeight;
+        const int rowCount = std::min(src.height() - startRow, mcuRowsPerBand * mcuHeight);
+        SkPixmap band;
+        SkAssertResult(src.extractSubset(&band,
+                                         SkIRect::MakeXYWH(0, startRow, src.width(), rowCount)));
+        SkWStream* bandStream = &bandStreams[i];
+        const SkData* icc = (0 == i) ? iccMarkerData.get() : nullptr;
+        taskGroup.add([=, &failed, &bandDone, &completions] {
+            if (!encode_band(bandStream, band, options, restartInterval, icc)) {
+                failed = true;
+            }
+            bandDone[i] = true;
+            completions.signal();
+        });
+    }
+
+    // Stream the bands to dst in order as they complete. Each wait consumes one completion
+    // signal; bands may finish out of order, but the done flags are monotonic so the outer
+    // loop consumes at most one signal per band overall.
+    bool ok = true;
+    bool wroteBytes = false;
+    for (int i = 0; ok && i < numBands; i++) {
+        while (!bandDone[i]) {
+            completions.wait();
+        }
+        if (failed) {
+            ok = false;
+            break;
+        }
+
+        sk_sp<SkData> bandData = bandStreams[i].detachAsData();
+        const uint8_t* bytes = bandData->bytes();
+        const size_t len = bandData->size();
+        // Every band ends with an EOI marker, dropped here in favor of the stitched one.
+        if (len < 4 || 0xFF != bytes[len - 2] || 0xD9 != bytes[len - 1]) {
+            ok = false;
+            break;
+        }
+
+        if (0 == i) {
+            uint8_t* header = (uint8_t*) bandData->writable_data();
+            ok = patch_sof_height(header, len, src.height()) && dst->write(header, len - 2);
+        } else {
+            const size_t entropyStart = find_band_entropy_start(bytes, len);
+            const uint8_t rst[] = { 0xFF, (uint8_t) (0xD0 + ((i - 1) & 7)) };
+            ok = 0 != entropyStart && dst->write(rst, sizeof(rst)) &&
+                 dst->write(bytes + entropyStart, len - 2 - entropyStart);
+        }
+        wroteBytes = true;
+    }
+    taskGroup.wait();
+
+    if (!ok) {
+        return wroteBytes ? ParallelResult::kFailure : ParallelResult::kFallback;
+    }
+    const uint8_t eoi[] = { 0xFF, 0xD9 };
+    return dst->write(eoi, sizeof(eoi)) ? ParallelResult::kSuccess : ParallelResult::kFailure;
+}
+
 bool SkJpegEncoder::Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
+    if (options.fParallel) {
+        switch (encode_parallel(dst, src, options)) {
+            case ParallelResult::kSuccess:  return true;
+            case ParallelResult::kFailure:  return false;
+            case ParallelResult::kFallback: break;
+        }
+    }
     auto encoder = SkJpegEncoder::Make(dst, src, options);
     return encoder.get() && encoder->encodeRows(src.height());
 }
@@ -13,13 +13,17 @@
 #include "include/core/SkString.h"
 #include "include/encode/SkPngEncoder.h"
 #include "include/private/SkImageInfoPriv.h"
+#include "include/private/SkSemaphore.h"
 #include "src/codec/SkColorTable.h"
 #include "src/codec/SkPngPriv.h"
 #include "src/core/SkMSAN.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/images/SkImageEncoderFns.h"
+#include <atomic>
 #include <vector>
 
 #include "png.h"
+#include "zlib.h"
 
 static_assert(PNG_FILTER_NONE  == (int)SkPngEncoder::FilterFlag::kNone,  "Skia libpng filter err.");
 static_assert(PNG_FILTER_SUB   == (int)SkPngEncoder::FilterFlag::kSub,   "Skia libpng filter err.");
@@ -454,7 +458,317 @@ bool SkPngEncoder::onEncodeRows(int numRows) {
     return true;
 }
 
+// Upper bound on the number of bands Encode() splits an image into when Options::fParallel
+// is set; matches the task cap of the parallel jpeg encoder.
+static constexpr int kMaxParallelEncodeTasks = 16;
+
+static bool default_deflate_chunk(const void* data, size_t len, int zlibLevel, bool lastChunk,
+                                  SkWStream* dst, uint32_t* adler) {
+    if (len > std::numeric_limits<uInt>::max()) {
+        return false;
+    }
+
+    z_stream zStream;
+    memset(&zStream, 0, sizeof(zStream));
+    // Negative window bits select a raw deflate stream; the caller owns the zlib framing.
+    if (Z_OK != deflateInit2(&zStream, zlibLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY)) {
+        return false;
+    }
+    zStream.next_in = (Bytef*) data;
+    zStream.avail_in = (uInt) len;
+
+    const int flush = lastChunk ? Z_FINISH : Z_FULL_FLUSH;
+    uint8_t buffer[16384];
+    bool success = true;
+    for (;;) {
+        zStream.next_out = buffer;
+        zStream.avail_out = sizeof(buffer);
+        const int rc = deflate(&zStream, flush);
+        if (Z_STREAM_ERROR == rc || !dst->write(buffer, sizeof(buffer) - zStream.avail_out)) {
+            success = false;
+            break;
+        }
+        if (lastChunk ? Z_STREAM_END == rc : (0 == zStream.avail_in && 0 != zStream.avail_out)) {
+            break;
+        }
+    }
+    deflateEnd(&zStream);
+
+    *adler = adler32(adler32(0, nullptr, 0), (const Bytef*) data, len);
+    return success;
+}
+
+static SkPngEncoder::DeflateChunkProc gDeflateChunkProc = nullptr;
+
+void SkPngEncoder::SetDeflateChunkProc(DeflateChunkProc proc) {
+    gDeflateChunkProc = proc;
+}
+
+/*
+ * Applies the png row filter |type| (png spec section 6.2) to |row|, writing rowBytes
+ * filtered bytes to |dst|. |prev| may be null for the first row of the image, which
+ * filters against an implicit row of zeroes.
+ */
+static void apply_row_filter(int type, uint8_t* dst, const uint8_t* row, const uint8_t* prev,
+                             size_t rowBytes, int bpp) {
+    auto paeth = [](int a, int b, int c) {
+        const int p = a + b - c;
+        const int pa = SkTAbs(p - a);
+        const int pb = SkTAbs(p - b);
+        const int pc = SkTAbs(p - c);
+        return (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+    };
+
+    for (size_t i = 0; i < rowBytes; i++) {
+        const int x = row[i];
+        const int a = i >= (size_t) bpp ? row[i - bpp] : 0;
+        const int b = prev ? prev[i] : 0;
+        const int c = (prev && i >= (size_t) bpp) ? prev[i - bpp] : 0;
+        switch (type) {
+            case 0: dst[i] = x;                      break;  // None
+            case 1: dst[i] = x - a;                  break;  // Sub
+            case 2: dst[i] = x - b;                  break;  // Up
+            case 3: dst[i] = x - ((a + b) >> 1);     break;  // Average
+            case 4: dst[i] = x - paeth(a, b, c);     break;  // Paeth
+        }
+    }
+}
+
+/*
+ * Filters |row| with the best of the enabled |filters| (FilterFlag bits), chosen with
+ * libpng's minimum-sum-of-absolute-values heuristic, and returns the filter type byte.
+ * |scratch| must hold 2 * rowBytes.
+ */
+static int filter_row(uint8_t* dst, uint8_t* scratch, const uint8_t* row, const uint8_t* prev,
+                      size_t rowBytes, int bpp, int filters) {
+    static constexpr struct {
+        SkPngEncoder::FilterFlag fFlag;
+        int                      fType;
+    } kFilters[] = {
+        { SkPngEncoder::FilterFlag::kNone,  0 },
+        { SkPngEncoder::FilterFlag::kSub,   1 },
+        { SkPngEncoder::FilterFlag::kUp,    2 },
+        { SkPngEncoder::FilterFlag::kAvg,   3 },
+        { SkPngEncoder::FilterFlag::kPaeth, 4 },
+    };
+
+    int bestType = -1;
+    uint64_t bestSum = 0;
+    uint8_t* bestBuf = scratch;
+    uint8_t* tryBuf = scratch + rowBytes;
+    for (const auto& filter : kFilters) {
+        if (!(filters & (int) filter.fFlag)) {
+            continue;
+        }
+        apply_row_filter(filter.fType, tryBuf, row, prev, rowBytes, bpp);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < rowBytes; i++) {
+            // Treat the filtered bytes as signed and sum their magnitudes, as libpng does.
+            sum += tryBuf[i] < 128 ? tryBuf[i] : 256 - tryBuf[i];
+        }
+        if (bestType < 0 || sum < bestSum) {
+            bestType = filter.fType;
+            bestSum = sum;
+            std::swap(bestBuf, tryBuf);
+        }
+    }
+    SkASSERT(bestType >= 0);
+    memcpy(dst, bestBuf, rowBytes);
+    return bestType;
+}
+
+/*
+ * Writes one png chunk: big-endian length, the tag, the payload, and a CRC covering the
+ * tag and payload.
+ */
+static bool write_png_chunk(SkWStream* dst, const char tag[4], const void* data, size_t len) {
+    uint8_t header[8] = { (uint8_t) (len >> 24), (uint8_t) (len >> 16),
+                          (uint8_t) (len >> 8),  (uint8_t) len };
+    memcpy(header + 4, tag, 4);
+    uLong crc = crc32(crc32(0, nullptr, 0), header + 4, 4);
+    crc = crc32(crc, (const Bytef*) data, len);
+    const uint8_t trailer[4] = { (uint8_t) (crc >> 24), (uint8_t) (crc >> 16),
+                                 (uint8_t) (crc >> 8),  (uint8_t) crc };
+    return dst->write(header, sizeof(header)) &&
+           (0 == len || dst->write(data, len)) &&
+           dst->write(trailer, sizeof(trailer));
+}
+
+enum class ParallelResult {
+    kSuccess,   // the complete png was written to dst
+    kFallback,  // preconditions unmet; nothing was written, use the serial path
+    kFailure,   // a band failed after output had begun; dst does not hold a valid png
+};
+
+/*
+ * Transforms, filters, and deflates bands of rows on SkExecutor::GetDefault() worker
+ * threads. Each band's deflate stream ends on a Z_FULL_FLUSH boundary, so the bands
+ * concatenate into one valid zlib stream behind a single header, carried in IDAT chunks
+ * that are streamed to |dst| as the bands complete.
+ */
+static ParallelResult encode_parallel(SkWStream* dst, const SkPixmap& src,
+                                      const SkPngEncoder::Options& options) {
+    if (!SkPixmapIsValid(src)) {
+        return ParallelResult::kFallback;
+    }
+
+    // Level 0 asks libpng for stored (uncompressed) deflate blocks, and the
+    // 16-bit-per-channel color types lean on libpng's filler stripping; both stay on the
+    // serial path.
+    if (options.fZLibLevel < 1 || options.fZLibLevel > 9) {
+        return ParallelResult::kFallback;
+    }
+    switch (src.colorType()) {
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:
+        case kRGB_888x_SkColorType:
+        case kRGB_565_SkColorType:
+        case kARGB_4444_SkColorType:
+        case kGray_8_SkColorType:
+        case kAlpha_8_SkColorType:
+            break;
+        default:
+            return ParallelResult::kFallback;
+    }
+
+    const int rowsPerBand = (src.height() + kMaxParallelEncodeTasks - 1)
+                            / kMaxParallelEncodeTasks;
+    const int numBands = (src.height() + rowsPerBand - 1) / rowsPerBand;
+    if (numBands < 2) {
+        return ParallelResult::kFallback;
+    }
+
+    // Everything before the IDAT chunks is written through libpng, exactly as Make() does.
+    // libpng does not touch the stream until writeInfo(), so failures before that point
+    // leave dst clean for the serial retry.
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = SkPngEncoderMgr::Make(dst);
+    if (!encoderMgr ||
+            !encoderMgr->setHeader(src.info(), options) ||
+            !encoderMgr->setColorSpace(src.info())) {
+        return ParallelResult::kFallback;
+    }
+    if (!encoderMgr->writeInfo(src.info())) {
+        return ParallelResult::kFailure;
+    }
+    encoderMgr->chooseProc(src.info());
+    SkASSERT(encoderMgr->proc());
+
+    const int pngBpp = encoderMgr->pngBytesPerPixel();
+    const size_t pngRowBytes = (size_t) pngBpp * src.width();
+    int filters = (int) options.fFilterFlags & (int) SkPngEncoder::FilterFlag::kAll;
+    if (0 == filters) {
+        filters = (int) SkPngEncoder::FilterFlag::kNone;
+    }
+    const auto deflateChunk = gDeflateChunkProc ? gDeflateChunkProc : default_deflate_chunk;
+    const transform_scanline_proc proc = encoderMgr->proc();
+    const int srcBpp = SkColorTypeBytesPerPixel(src.colorType());
+
+    std::vector<SkDynamicMemoryWStream> bandStreams(numBands);
+    std::vector<uint32_t> bandAdlers(numBands, 0);
+    std::unique_ptr<std::atomic<bool>[]> bandDone(new std::atomic<bool>[numBands]);
+    for (int i = 0; i < numBands; i++) {
+        bandDone[i] = false;
+    }
+    std::atomic<bool> failed(false);
+    SkSemaphore completions;
+    SkTaskGroup taskGroup;
+
+    for (int i = 0; i < numBands; i++) {
+        const int startRow = i * rowsPerBand;
+        const int rowCount = std::min(src.height() - startRow, rowsPerBand);
+        const bool lastBand = (numBands - 1 == i);
+        taskGroup.add([=, &src, &bandStreams, &bandAdlers, &bandDone, &failed, &completions] {
+            SkAutoTMalloc<uint8_t> filtered((pngRowBytes + 1) * rowCount);
+            SkAutoTMalloc<uint8_t> rows(2 * pngRowBytes);
+            SkAutoTMalloc<uint8_t> scratch(2 * pngRowBytes);
+            uint8_t* currRow = rows.get();
+            uint8_t* prevRow = rows.get() + pngRowBytes;
+            bool havePrev = false;
+
+            auto transform = [&](int y, uint8_t* dstRow) {
+                const void* srcRow = src.addr(0, y);
+                sk_msan_assert_initialized(
+                        srcRow, (const uint8_t*) srcRow + (src.width() << src.shiftPerPixel()));
+                proc((char*) dstRow, (const char*) srcRow, src.width(), srcBpp);
+            };
+
+            // The band's first row filters against the last row of the band above.
+            if (startRow > 0) {
+                transform(startRow - 1, prevRow);
+                havePrev = true;
+            }
+
+            uint8_t* out = filtered.get();
+            for (int y = startRow; y < startRow + rowCount; y++) {
+                transform(y, currRow);
+                out[0] = filter_row(out + 1, scratch.get(), currRow,
+                                    havePrev ? prevRow : nullptr, pngRowBytes, pngBpp,
+                                    filters);
+                out += pngRowBytes + 1;
+                std::swap(currRow, prevRow);
+                havePrev = true;
+            }
+
+            if (!deflateChunk(filtered.get(), (pngRowBytes + 1) * rowCount,
+                              options.fZLibLevel, lastBand, &bandStreams[i],
+                              &bandAdlers[i])) {
+                failed = true;
+            }
+            bandDone[i] = true;
+            completions.signal();
+        });
+    }
+
+    // zlib stream header: deflate with a 32K window, the FLEVEL hint, and check bits.
+    const int level = options.fZLibLevel;
+    const int flevel = level < 2 ? 0 : level < 6 ? 1 : 6 == level ? 2 : 3;
+    uint8_t zlibHeader[2] = { 0x78, (uint8_t) (flevel << 6) };
+    zlibHeader[1] += 31 - (((zlibHeader[0] << 8) | zlibHeader[1]) % 31);
+
+    // Stream the bands to dst in order as they complete, each as its own IDAT chunk (the
+    // zlib stream may be split across IDATs at any byte). Each wait consumes one
+    // completion signal; the done flags are monotonic, so the loop consumes at most one
+    // signal per band overall.
+    bool ok = write_png_chunk(dst, "IDAT", zlibHeader, sizeof(zlibHeader));
+    uLong adler = 0;
+    for (int i = 0; ok && i < numBands; i++) {
+        while (!bandDone[i]) {
+            completions.wait();
+        }
+        if (failed) {
+            ok = false;
+            break;
+        }
+        sk_sp<SkData> bandData = bandStreams[i].detachAsData();
+        ok = write_png_chunk(dst, "IDAT", bandData->data(), bandData->size());
+
+        const int rowCount = std::min(src.height() - i * rowsPerBand, rowsPerBand);
+        adler = 0 == i ? bandAdlers[0]
+                       : adler32_combine(adler, bandAdlers[i], (pngRowBytes + 1) * rowCount);
+    }
+    taskGroup.wait();
+    if (!ok || failed) {
+        return ParallelResult::kFailure;
+    }
+
+    // The zlib trailer (the whole stream's adler-32) and the IEND chunk.
+    const uint8_t trailer[4] = { (uint8_t) (adler >> 24), (uint8_t) (adler >> 16),
+                                 (uint8_t) (adler >> 8),  (uint8_t) adler };
+    if (!write_png_chunk(dst, "IDAT", trailer, sizeof(trailer)) ||
+            !write_png_chunk(dst, "IEND", nullptr, 0)) {
+        return ParallelResult::kFailure;
+    }
+    return ParallelResult::kSuccess;
+}
+
 bool SkPngEncoder::Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
+    if (options.fParallel) {
+        switch (encode_parallel(dst, src, options)) {
+            case ParallelResult::kSuccess:  return true;
+            case ParallelResult::kFailure:  return false;
+            case ParallelResult::kFallback: break;
+        }
+    }
     auto encoder = SkPngEncoder::Make(dst, src, options);
     return encoder.get() && encoder->encodeRows(src.height());
 }
@@ -50,6 +50,19 @@ public:
      *  the pool works.
      */
     static sk_sp<SkDiscardableMemoryPool> Make(size_t size);
+
+    /**
+     *  A pool for cache-heavy server workloads: allocations are backed by
+     *  anonymous mappings (2MB-aligned, with transparent hugepages requested
+     *  for large blocks, reducing dTLB pressure), purging uses MADV_FREE so
+     *  the kernel reclaims pages lazily, and purged ranges are recycled for
+     *  later allocations.  NUMA placement follows the kernel's first-touch
+     *  policy, keeping pages local to the allocating thread's node.
+     *
+     *  On platforms without madvise support, this returns a plain
+     *  malloc-backed pool (same as Make()).
+     */
+    static sk_sp<SkDiscardableMemoryPool> MakeHugePageBacked(size_t size);
 };
 
 /**
@@ -0,0 +1,345 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/private/SkMutex.h"
+#include "include/private/SkTArray.h"
+#include "src/core/SkDiscardableMemory.h"
+#include "src/core/SkTInternalLList.h"
+#include "src/lazy/SkDiscardableMemoryPool.h"
+
+// Note:
+// This is the hugepage-backed sibling of the malloc-backed pool in
+// SkDiscardableMemoryPool.cpp, intended for cache-heavy server workloads.
+//
+// Allocations are backed by anonymous mappings: large ones are 2MB-aligned with
+// transparent hugepages requested (MADV_HUGEPAGE), shrinking dTLB pressure when
+// the resource cache holds many decoded images.  Purging uses MADV_FREE, so the
+// kernel reclaims pages lazily, and the virtual ranges are recycled for later
+// allocations of the same size instead of being unmapped.  NUMA placement
+// follows the kernel's first-touch policy: recycled ranges whose pages were
+// reclaimed fault back in on the node of the thread writing the new contents,
+// so arenas stay node-local without a libnuma dependency.
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// MADV_FREE (lazy reclaim) needs linux 4.5 / glibc 2.24; fall back to the
+// eager MADV_DONTNEED on older systems.
+#if !defined(MADV_FREE)
+    #define MADV_FREE MADV_DONTNEED
+#endif
+
+namespace {
+
+constexpr size_t kHugePageSize = 2u << 20;
+
+struct Mapping {
+    void*  fAddr = nullptr;
+    size_t fSize = 0;
+};
+
+class HugePageDiscardableMemory;
+
+class HugePageDiscardableMemoryPool : public SkDiscardableMemoryPool {
+public:
+    HugePageDiscardableMemoryPool(size_t budget);
+    ~HugePageDiscardableMemoryPool() override;
+
+    std::unique_ptr<SkDiscardableMemory> make(size_t bytes);
+    SkDiscardableMemory* create(size_t bytes) override {
+        return this->make(bytes).release();  // TODO: change API
+    }
+
+    size_t getRAMUsed() override;
+    void setRAMBudget(size_t budget) override;
+    size_t getRAMBudget() override { return fBudget; }
+
+    /** purges all unlocked DMs */
+    void dumpPool() override;
+
+    #if SK_LAZY_CACHE_STATS  // Defined in SkDiscardableMemoryPool.h
+    int getCacheHits() override { return fCacheHits; }
+    int getCacheMisses() override { return fCacheMisses; }
+    void resetCacheHitsAndMisses() override {
+        fCacheHits = fCacheMisses = 0;
+    }
+    int          fCacheHits;
+    int          fCacheMisses;
+    #endif  // SK_LAZY_CACHE_STATS
+
+private:
+    SkMutex           fMutex;
+    size_t            fBudget;
+    size_t            fUsed;
+    SkTArray<Mapping> fFreeMappings;   // purged (MADV_FREE'd) ranges, ready for reuse
+    size_t            fFreeBytes;
+    SkTInternalLList<HugePageDiscardableMemory> fList;
+
+    /** Takes a recycled or freshly mmap'd range of (at least) the rounded size. */
+    Mapping allocate(size_t bytes);
+    /** MADV_FREEs the range and parks it on the freelist (or unmaps, if full). */
+    void recycle(Mapping);
+    /** Function called to free memory if needed */
+    void dumpDownTo(size_t budget);
+    /** called by HugePageDiscardableMemory upon destruction */
+    void removeFromPool(HugePageDiscardableMemory* dm);
+    /** called by HugePageDiscardableMemory::lock() */
+    bool lock(HugePageDiscardableMemory* dm);
+    /** called by HugePageDiscardableMemory::unlock() */
+    void unlock(HugePageDiscardableMemory* dm);
+
+    friend class HugePageDiscardableMemory;
+
+    typedef SkDiscardableMemory::Factory INHERITED;
+};
+
+/**
+ *  A HugePageDiscardableMemory is a SkDiscardableMemory backed by a mapping
+ *  owned and recycled by a HugePageDiscardableMemoryPool.
+ */
+class HugePageDiscardableMemory : public SkDiscardableMemory {
+public:
+    HugePageDiscardableMemory(sk_sp<HugePageDiscardableMemoryPool> pool, Mapping mapping);
+    ~HugePageDiscardableMemory() override;
+    bool lock() override;
+    void* data() override;
+    void unlock() override;
+    friend class HugePageDiscardableMemoryPool;
+private:
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(HugePageDiscardableMemory);
+    sk_sp<HugePageDiscardableMemoryPool> fPool;
+    bool                                 fLocked;
+    Mapping                              fMapping;    // fAddr is null once purged
+};
+
+HugePageDiscardableMemory::HugePageDiscardableMemory(sk_sp<HugePageDiscardableMemoryPool> pool,
+                                                     Mapping mapping)
+        : fPool(std::move(pool)), fLocked(true), fMapping(mapping) {
+    SkASSERT(fPool != nullptr);
+    SkASSERT(fMapping.fAddr != nullptr);
+    SkASSERT(fMapping.fSize > 0);
+}
+
+HugePageDiscardableMemory::~HugePageDiscardableMemory() {
+    SkASSERT(!fLocked); // contract for SkDiscardableMemory
+    fPool->removeFromPool(this);
+}
+
+bool HugePageDiscardableMemory::lock() {
+    SkASSERT(!fLocked); // contract for SkDiscardableMemory
+    return fPool->lock(this);
+}
+
+void* HugePageDiscardableMemory::data() {
+    SkASSERT(fLocked); // contract for SkDiscardableMemory
+    return fMapping.fAddr;
+}
+
+void HugePageDiscardableMemory::unlock() {
+    SkASSERT(fLocked); // contract for SkDiscardableMemory
+    fPool->unlock(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t round_up_mapping_size(size_t bytes) {
+    const size_t granularity = bytes >= kHugePageSize
+            ? kHugePageSize
+            : (size_t)sysconf(_SC_PAGESIZE);
+    return (bytes + granularity - 1) & ~(granularity - 1);
+}
+
+/** mmaps |size| bytes, 2MB-aligned with hugepages requested for large sizes. */
+static Mapping map_range(size_t size) {
+    SkASSERT(size == round_up_mapping_size(size));
+
+    const int prot  = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (size < kHugePageSize) {
+        void* addr = mmap(nullptr, size, prot, flags, -1, 0);
+        return (MAP_FAILED == addr) ? Mapping() : Mapping{addr, size};
+    }
+
+    // mmap only guarantees page alignment, so over-map and trim to get the 2MB
+    // alignment transparent hugepages require.
+    void* raw = mmap(nullptr, size + kHugePageSize, prot, flags, -1, 0);
+    if (MAP_FAILED == raw) {
+        return Mapping();
+    }
+    const uintptr_t base    = (uintptr_t)raw;
+    const uintptr_t aligned = (base + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    if (aligned > base) {
+        munmap(raw, aligned - base);
+    }
+    const uintptr_t tail = kHugePageSize - (aligned - base);
+    if (tail > 0) {
+        munmap((void*)(aligned + size), tail);
+    }
+#if defined(MADV_HUGEPAGE)
+    // Best effort: fails harmlessly when THP is unavailable or disabled.
+    (void)madvise((void*)aligned, size, MADV_HUGEPAGE);
+#endif
+    return Mapping{(void*)aligned, size};
+}
+
+HugePageDiscardableMemoryPool::HugePageDiscardableMemoryPool(size_t budget)
+    : fBudget(budget)
+    , fUsed(0)
+    , fFreeBytes(0) {
+    #if SK_LAZY_CACHE_STATS
+    fCacheHits = 0;
+    fCacheMisses = 0;
+    #endif  // SK_LAZY_CACHE_STATS
+}
+
+HugePageDiscardableMemoryPool::~HugePageDiscardableMemoryPool() {
+    // HugePageDiscardableMemory objects that belong to this pool are always
+    // deleted before deleting this pool since each one has a ref to the pool.
+    SkASSERT(fList.isEmpty());
+    for (const Mapping& m : fFreeMappings) {
+        munmap(m.fAddr, m.fSize);
+    }
+}
+
+Mapping HugePageDiscardableMemoryPool::allocate(size_t bytes) {
+    const size_t size = round_up_mapping_size(bytes);
+    {
+        SkAutoMutexExclusive autoMutexAcquire(fMutex);
+        for (int i = 0; i < fFreeMappings.count(); ++i) {
+            if (fFreeMappings[i].fSize == size) {
+                Mapping m = fFreeMappings[i];
+                fFreeMappings.removeShuffle(i);
+                fFreeBytes -= size;
+                return m;
+            }
+        }
+    }
+    return map_range(size);
+}
+
+void HugePageDiscardableMemoryPool::recycle(Mapping mapping) {
+    fMutex.assertHeld();
+    // Let the kernel reclaim the pages lazily; the range stays mapped so a
+    // later allocation of the same size can reuse it without re-mapping.
+    (void)madvise(mapping.fAddr, mapping.fSize, MADV_FREE);
+    if (fFreeBytes + mapping.fSize > fBudget) {
+        munmap(mapping.fAddr, mapping.fSize);
+        return;
+    }
+    fFreeMappings.push_back(mapping);
+    fFreeBytes += mapping.fSize;
+}
+
+void HugePageDiscardableMemoryPool::dumpDownTo(size_t budget) {
+    fMutex.assertHeld();
+    if (fUsed <= budget) {
+        return;
+    }
+    using Iter = SkTInternalLList<HugePageDiscardableMemory>::Iter;
+    Iter iter;
+    HugePageDiscardableMemory* cur = iter.init(fList, Iter::kTail_IterStart);
+    while ((fUsed > budget) && (cur)) {
+        if (!cur->fLocked) {
+            HugePageDiscardableMemory* dm = cur;
+            SkASSERT(dm->fMapping.fAddr != nullptr);
+            SkASSERT(fUsed >= dm->fMapping.fSize);
+            fUsed -= dm->fMapping.fSize;
+            this->recycle(dm->fMapping);
+            dm->fMapping = Mapping();
+            cur = iter.prev();
+            // Purged DMs are taken out of the list.  This saves times
+            // looking them up.  Purged DMs are NOT deleted.
+            fList.remove(dm);
+        } else {
+            cur = iter.prev();
+        }
+    }
+}
+
+std::unique_ptr<SkDiscardableMemory> HugePageDiscardableMemoryPool::make(size_t bytes) {
+    Mapping mapping = this->allocate(bytes);
+    if (nullptr == mapping.fAddr) {
+        return nullptr;
+    }
+    auto dm = std::make_unique<HugePageDiscardableMemory>(sk_ref_sp(this), mapping);
+    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    fList.addToHead(dm.get());
+    fUsed += mapping.fSize;
+    this->dumpDownTo(fBudget);
+    return std::move(dm);
+}
+
+void HugePageDiscardableMemoryPool::removeFromPool(HugePageDiscardableMemory* dm) {
+    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    // This is called by dm's destructor.
+    if (dm->fMapping.fAddr != nullptr) {
+        SkASSERT(fUsed >= dm->fMapping.fSize);
+        fUsed -= dm->fMapping.fSize;
+        fList.remove(dm);
+        this->recycle(dm->fMapping);
+        dm->fMapping = Mapping();
+    } else {
+        SkASSERT(!fList.isInList(dm));
+    }
+}
+
+bool HugePageDiscardableMemoryPool::lock(HugePageDiscardableMemory* dm) {
+    SkASSERT(dm != nullptr);
+    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    if (nullptr == dm->fMapping.fAddr) {
+        // May have been purged while waiting for lock.
+        #if SK_LAZY_CACHE_STATS
+        ++fCacheMisses;
+        #endif  // SK_LAZY_CACHE_STATS
+        return false;
+    }
+    dm->fLocked = true;
+    fList.remove(dm);
+    fList.addToHead(dm);
+    #if SK_LAZY_CACHE_STATS
+    ++fCacheHits;
+    #endif  // SK_LAZY_CACHE_STATS
+    return true;
+}
+
+void HugePageDiscardableMemoryPool::unlock(HugePageDiscardableMemory* dm) {
+    SkASSERT(dm != nullptr);
+    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    dm->fLocked = false;
+    this->dumpDownTo(fBudget);
+}
+
+size_t HugePageDiscardableMemoryPool::getRAMUsed() {
+    return fUsed;
+}
+void HugePageDiscardableMemoryPool::setRAMBudget(size_t budget) {
+    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    fBudget = budget;
+    this->dumpDownTo(fBudget);
+}
+void HugePageDiscardableMemoryPool::dumpPool() {
+    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    this->dumpDownTo(0);
+}
+
+}  // namespace
+
+sk_sp<SkDiscardableMemoryPool> SkDiscardableMemoryPool::MakeHugePageBacked(size_t size) {
+    return sk_make_sp<HugePageDiscardableMemoryPool>(size);
+}
+
+#else  // !(SK_BUILD_FOR_UNIX || SK_BUILD_FOR_ANDROID)
+
+sk_sp<SkDiscardableMemoryPool> SkDiscardableMemoryPool::MakeHugePageBacked(size_t size) {
+    // No madvise-style purging on this platform; serve a malloc-backed pool.
+    return SkDiscardableMemoryPool::Make(size);
+}
+
+#endif
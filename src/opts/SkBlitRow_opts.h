@@ -150,6 +150,48 @@ inline void blit_row_color32(SkPMColor* dst, const SkPMColor* src, int count, Sk
     }
 }
 
+// Blend a constant, already-premultiplied color over count kRGB_565 pixels.
+inline void blit_row_color565(uint16_t* dst, int count, SkPMColor color) {
+    unsigned invA = 255 - SkGetPackedA32(color);
+    invA += invA >> 7;
+    SkASSERT(0 < invA && invA < 256);  // We handle alpha == 0 or alpha == 255 specially.
+
+    const unsigned sr = SkGetPackedR32(color),
+                   sg = SkGetPackedG32(color),
+                   sb = SkGetPackedB32(color);
+
+    constexpr int N = 8;  // one 128-bit register of 565 pixels
+    using U16 = skvx::Vec<N, uint16_t>;
+
+    auto kernel = [&](U16 d) {
+        // Splay 565 out to its nearest 8-bit channels, blend there, repack.
+        U16 r = (d >> 11) & 31,
+            g = (d >>  5) & 63,
+            b = (d      ) & 31;
+        r = (r << 3) | (r >> 2);
+        g = (g << 2) | (g >> 4);
+        b = (b << 3) | (b >> 2);
+
+        // (dst * invA + (src << 8) + 128) >> 8 stays within 16 bits because
+        // src is premultiplied (src <= alpha while invA ~= 256 - alpha).
+        r = (r * invA + (sr << 8) + 128) >> 8;
+        g = (g * invA + (sg << 8) + 128) >> 8;
+        b = (b * invA + (sb << 8) + 128) >> 8;
+
+        return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+    };
+
+    while (count >= N) {
+        kernel(U16::Load(dst)).store(dst);
+        dst   += N;
+        count -= N;
+    }
+    while (count --> 0) {
+        *dst = kernel(U16(*dst))[0];
+        dst += 1;
+    }
+}
+
 #if defined(SK_ARM_HAS_NEON)
 
 // Return a uint8x8_t value, r, computed as r[i] = SkMulDiv255Round(x[i], y[i]), where r[i], x[i],
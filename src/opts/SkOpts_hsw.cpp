@@ -19,6 +19,7 @@
 namespace SkOpts {
     void Init_hsw() {
         blit_row_color32     = hsw::blit_row_color32;
+        blit_row_color565    = hsw::blit_row_color565;
         blit_row_s32a_opaque = hsw::blit_row_s32a_opaque;
 
         S32_alpha_D32_filter_DX  = hsw::S32_alpha_D32_filter_DX;
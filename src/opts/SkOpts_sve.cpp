@@ -0,0 +1,140 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkOpts.h"
+
+#if defined(__ARM_FEATURE_SVE)
+    #include <arm_sve.h>
+
+namespace sve {
+
+    // Predicated whilelt loops make every kernel here vector-length agnostic:
+    // the same code runs 128-bit on little cores and 256-bit on Graviton3.
+
+    static void memset32(uint32_t buffer[], uint32_t value, int count) {
+        const svuint32_t v = svdup_u32(value);
+        for (int64_t i = 0; i < count; i += svcntw()) {
+            svbool_t pg = svwhilelt_b32((int64_t)i, (int64_t)count);
+            svst1_u32(pg, buffer + i, v);
+        }
+    }
+
+    static void memset64(uint64_t buffer[], uint64_t value, int count) {
+        const svuint64_t v = svdup_u64(value);
+        for (int64_t i = 0; i < count; i += svcntd()) {
+            svbool_t pg = svwhilelt_b64((int64_t)i, (int64_t)count);
+            svst1_u64(pg, buffer + i, v);
+        }
+    }
+
+    // Exact round(x/255) on each 16-bit lane holding x <= 255*255.
+    static inline svuint16_t div255(svbool_t pg, svuint16_t x) {
+        x = svadd_n_u16_x(pg, x, 128);
+        x = svadd_u16_x(pg, x, svlsr_n_u16_x(pg, x, 8));
+        return svlsr_n_u16_x(pg, x, 8);
+    }
+
+    // Shared body for RGBA_to_rgbA / RGBA_to_bgrA: premultiply r,g,b by a,
+    // optionally swapping r and b, using the r/b-in-separate-16-bit-fields
+    // trick so everything stays in full-width lanes.
+    static inline void premul_should_swapRB(bool kSwapRB,
+                                            uint32_t* dst, const uint32_t* src, int count) {
+        for (int64_t i = 0; i < count; i += svcntw()) {
+            svbool_t pg = svwhilelt_b32((int64_t)i, (int64_t)count);
+            svuint32_t px = svld1_u32(pg, src + i);
+
+            svuint32_t a  = svlsr_n_u32_x(pg, px, 24);
+
+            // r and b sit in their own 16-bit halves of each 32-bit lane.
+            svuint16_t rb  = svreinterpret_u16_u32(svand_n_u32_x(pg, px, 0x00FF00FF)),
+                       a16 = svreinterpret_u16_u32(svmul_n_u32_x(pg, a, 0x00010001));
+            rb = div255(svptrue_b16(), svmul_u16_x(svptrue_b16(), rb, a16));
+
+            svuint32_t g = svand_n_u32_x(pg, svlsr_n_u32_x(pg, px, 8), 0x000000FF);
+            g = svreinterpret_u32_u16(
+                    div255(svptrue_b16(),
+                           svmul_u16_x(svptrue_b16(),
+                                       svreinterpret_u16_u32(g),
+                                       svreinterpret_u16_u32(a))));
+
+            svuint32_t rb32 = svreinterpret_u32_u16(rb);
+            if (kSwapRB) {
+                rb32 = svand_n_u32_x(pg, svorr_u32_x(pg, svlsl_n_u32_x(pg, rb32, 16),
+                                                         svlsr_n_u32_x(pg, rb32, 16)),
+                                     0x00FF00FF);
+            }
+
+            svuint32_t out = svorr_u32_x(pg, rb32,
+                             svorr_u32_x(pg, svlsl_n_u32_x(pg, g, 8),
+                                             svlsl_n_u32_x(pg, a, 24)));
+            svst1_u32(pg, dst + i, out);
+        }
+    }
+
+    static void RGBA_to_rgbA(uint32_t* dst, const uint32_t* src, int count) {
+        premul_should_swapRB(false, dst, src, count);
+    }
+
+    static void RGBA_to_bgrA(uint32_t* dst, const uint32_t* src, int count) {
+        premul_should_swapRB(true, dst, src, count);
+    }
+
+    static void RGBA_to_BGRA(uint32_t* dst, const uint32_t* src, int count) {
+        for (int64_t i = 0; i < count; i += svcntw()) {
+            svbool_t pg = svwhilelt_b32((int64_t)i, (int64_t)count);
+            svuint32_t px = svld1_u32(pg, src + i);
+            svuint32_t out = svorr_u32_x(pg, svand_n_u32_x(pg, px, 0xFF00FF00),
+                             svorr_u32_x(pg, svand_n_u32_x(pg, svlsl_n_u32_x(pg, px, 16),
+                                                               0x00FF0000),
+                                             svand_n_u32_x(pg, svlsr_n_u32_x(pg, px, 16),
+                                                               0x000000FF)));
+            svst1_u32(pg, dst + i, out);
+        }
+    }
+
+    static void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len, U8CPU alpha) {
+        SkASSERT(alpha == 0xFF);
+        // Same math as SkPMSrcOver(): dst = src + dst*(256 - srcA) >> 8,
+        // done on the r/b and g/a byte pairs within each 32-bit lane.
+        for (int64_t i = 0; i < len; i += svcntw()) {
+            svbool_t pg = svwhilelt_b32((int64_t)i, (int64_t)len);
+            svuint32_t s = svld1_u32(pg, src + i),
+                       d = svld1_u32(pg, dst + i);
+
+            svuint32_t invA = svsubr_n_u32_x(pg, svlsr_n_u32_x(pg, s, 24), 256);
+
+            svuint32_t rb = svand_n_u32_x(pg, d, 0x00FF00FF),
+                       ga = svand_n_u32_x(pg, svlsr_n_u32_x(pg, d, 8), 0x00FF00FF);
+            rb = svand_n_u32_x(pg, svlsr_n_u32_x(pg, svmul_u32_x(pg, rb, invA), 8), 0x00FF00FF);
+            ga = svand_n_u32_x(pg,                   svmul_u32_x(pg, ga, invA),     0xFF00FF00);
+
+            svst1_u32(pg, dst + i, svadd_u32_x(pg, s, svorr_u32_x(pg, rb, ga)));
+        }
+    }
+
+}  // namespace sve
+
+namespace SkOpts {
+    void Init_sve() {
+        memset32 = sve::memset32;
+        memset64 = sve::memset64;
+
+        RGBA_to_BGRA = sve::RGBA_to_BGRA;
+        RGBA_to_rgbA = sve::RGBA_to_rgbA;
+        RGBA_to_bgrA = sve::RGBA_to_bgrA;
+
+        blit_row_s32a_opaque = sve::blit_row_s32a_opaque;
+    }
+}  // namespace SkOpts
+
+#else  // defined(__ARM_FEATURE_SVE)
+
+namespace SkOpts {
+    void Init_sve() {}
+}
+
+#endif
@@ -1820,6 +1820,42 @@ STAGE(byte_tables, const void* ctx) {  // TODO: rename Tables SkRasterPipeline_B
     a = from_byte(gather(tables->a, to_unorm(a, 255)));
 }
 
+// Trilinear sampling of a 3D rgb lookup table. Only appended for opaque pixels (a == 1, so
+// premul and unpremul agree); alpha passes through untouched.
+STAGE(clut_3d, const SkRasterPipeline_Clut3DCtx* ctx) {
+    const float* lut = ctx->lut;
+    const int N = ctx->gridSize;
+
+    F in[3] = {r, g, b};
+    F frac[3];
+    U32 base[3];
+    for (int i = 0; i < 3; i++) {
+        F v  = min(max(in[i], 0.0f), 1.0f) * (N - 1),
+          lo = min(floor_(v), (float)(N - 2));   // leave room for the +1 corner at v == N-1
+        frac[i] = v - lo;
+        base[i] = trunc_(lo);
+    }
+
+    U32 i000 = ((base[0]*N + base[1])*N + base[2]) * 4,
+        i100 = i000 + N*N*4,
+        i010 = i000 + N*4,
+        i110 = i100 + N*4;
+
+    F out[3];
+    for (int c = 0; c < 3; c++) {
+        auto corner = [&](U32 i) { return gather(lut + c, i); };
+        F x00 = lerp(corner(i000), corner(i000 + 4), frac[2]),
+          x10 = lerp(corner(i100), corner(i100 + 4), frac[2]),
+          x01 = lerp(corner(i010), corner(i010 + 4), frac[2]),
+          x11 = lerp(corner(i110), corner(i110 + 4), frac[2]);
+        out[c] = lerp(lerp(x00, x01, frac[1]),
+                      lerp(x10, x11, frac[1]), frac[0]);
+    }
+    r = out[0];
+    g = out[1];
+    b = out[2];
+}
+
 SI F strip_sign(F x, U32* sign) {
     U32 bits = sk_bit_cast<U32>(x);
     *sign = bits & 0x80000000;
@@ -2455,6 +2491,42 @@ STAGE(evenly_spaced_2_stop_gradient, const void* ctx) {
     a = mad(t, c->f[3], c->b[3]);
 }
 
+// The common two-stop case with dithered output, fused into one stage: lerp, premultiply (when
+// the colors were interpolated unpremultiplied), and the same 8x8 ordered dither as the dither
+// stage, saving two trips through the loop body per pixel.
+STAGE(evenly_spaced_2_stop_gradient_dither,
+      const SkRasterPipeline_EvenlySpaced2StopGradientDitherCtx* c) {
+    auto t = r;
+    r = mad(t, c->f[0], c->b[0]);
+    g = mad(t, c->f[1], c->b[1]);
+    b = mad(t, c->f[2], c->b[2]);
+    a = mad(t, c->f[3], c->b[3]);
+
+    if (c->premul) {
+        r = r * a;
+        g = g * a;
+        b = b * a;
+    }
+
+    // See the dither stage for how this 8x8 ordered dither matrix is derived.
+    uint32_t iota[] = {0,1,2,3,4,5,6,7};
+    U32 X = dx + sk_unaligned_load<U32>(iota),
+        Y = dy;
+    Y ^= X;
+    U32 M = (Y & 1) << 5 | (X & 1) << 4
+          | (Y & 2) << 2 | (X & 2) << 1
+          | (Y & 4) >> 1 | (X & 4) >> 2;
+    F dither = cast(M) * (2/128.0f) - (63/128.0f);
+
+    r += c->rate*dither;
+    g += c->rate*dither;
+    b += c->rate*dither;
+
+    r = max(0, min(r, a));
+    g = max(0, min(g, a));
+    b = max(0, min(b, a));
+}
+
 STAGE(xy_to_unit_angle, Ctx::None) {
     F X = r,
       Y = g;
@@ -2562,6 +2634,30 @@ STAGE(save_xy, SkRasterPipeline_SamplerCtx* c) {
     sk_unaligned_store(c->fy, fy);
 }
 
+// Trilinear filtering: sample the two mip levels bracketing the ideal scale and lerp.
+// init saves the upper level's coordinates, update stashes its color and rescales the
+// coordinates for the lower level, and finish blends the two samples.
+STAGE(mipmap_linear_init, SkRasterPipeline_MipmapCtx* ctx) {
+    sk_unaligned_store(ctx->x, r);
+    sk_unaligned_store(ctx->y, g);
+}
+STAGE(mipmap_linear_update, SkRasterPipeline_MipmapCtx* ctx) {
+    dr = r;
+    dg = g;
+    db = b;
+    da = a;
+
+    r = sk_unaligned_load<F>(ctx->x) * ctx->scaleX;
+    g = sk_unaligned_load<F>(ctx->y) * ctx->scaleY;
+}
+STAGE(mipmap_linear_finish, const SkRasterPipeline_MipmapCtx* ctx) {
+    F w = ctx->lowerWeight;
+    r = lerp(dr, r, w);
+    g = lerp(dg, g, w);
+    b = lerp(db, b, w);
+    a = lerp(da, a, w);
+}
+
 STAGE(accumulate, const SkRasterPipeline_SamplerCtx* c) {
     // Bilinear and bicubic filters are both separable, so we produce independent contributions
     // from x and y, multiplying them together here to get each pixel's total scale factor.
@@ -2677,6 +2773,70 @@ STAGE(gauss_a_to_rgba, Ctx::None) {
     b = a;
 }
 
+STAGE(perlin_noise, const SkRasterPipeline_PerlinNoiseCtx* ctx) {
+    // The legacy shader context quantizes device coordinates before mapping them through a
+    // pure-translate matrix and rounding again; match that exactly so both paths agree.
+    F px = floor_(floor_(r) + ctx->translateX + 0.5f),
+      py = floor_(floor_(g) + ctx->translateY + 0.5f);
+
+    // One 2D noise sample for a whole lane group: the lattice hashes and gradient components
+    // are gathered from flat float tables, everything else stays in registers.
+    auto noise2d = [&](const float* gx, const float* gy, F vx, F vy) {
+        F posX = vx + 4096.0f,  // kPerlinNoise, keeps the lattice coordinates positive.
+          posY = vy + 4096.0f;
+        F floorX = floor_(posX),
+          floorY = floor_(posY);
+        F fx = posX - floorX,
+          fy = posY - floorY;
+        U32 ix0 = trunc_(floorX) & 255,
+            iy0 = trunc_(floorY) & 255,
+            ix1 = (ix0 + 1) & 255,
+            iy1 = (iy0 + 1) & 255;
+
+        U32 i = trunc_(gather(ctx->latticeSelector, ix0)),
+            j = trunc_(gather(ctx->latticeSelector, ix1));
+        U32 b00 = (i + iy0) & 255,
+            b10 = (j + iy0) & 255,
+            b01 = (i + iy1) & 255,
+            b11 = (j + iy1) & 255;
+
+        F sx = fx*fx*(3.0f - 2.0f*fx),
+          sy = fy*fy*(3.0f - 2.0f*fy);
+
+        F u = gather(gx, b00)*fx          + gather(gy, b00)*fy,
+          v = gather(gx, b10)*(fx - 1.0f) + gather(gy, b10)*fy,
+          lo = lerp(u, v, sx);
+        u = gather(gx, b01)*fx          + gather(gy, b01)*(fy - 1.0f);
+        v = gather(gx, b11)*(fx - 1.0f) + gather(gy, b11)*(fy - 1.0f);
+        F hi = lerp(u, v, sx);
+        return lerp(lo, hi, sy);
+    };
+
+    F color[4];
+    for (int channel = 0; channel < 4; channel++) {
+        F sum = 0.0f,
+          vx  = px * ctx->baseFrequencyX,
+          vy  = py * ctx->baseFrequencyY;
+        float amplitude = 1.0f;
+        for (int octave = 0; octave < ctx->numOctaves; octave++) {
+            F noise = noise2d(ctx->gradientX[channel], ctx->gradientY[channel], vx, vy);
+            sum += (ctx->fractal ? noise : abs_(noise)) * amplitude;
+            vx *= 2.0f;
+            vy *= 2.0f;
+            amplitude *= 0.5f;
+        }
+        if (ctx->fractal) {
+            sum = sum * 0.5f + 0.5f;
+        }
+        color[channel] = min(max(sum, 0.0f), 1.0f);
+    }
+
+    a = color[3];
+    r = color[0] * a;
+    g = color[1] * a;
+    b = color[2] * a;
+}
+
 SI F tile(F v, SkTileMode mode, float limit, float invLimit) {
     // The ix_and_ptr() calls in sample() will clamp tile()'s output, so no need to clamp here.
     switch (mode) {
@@ -4171,6 +4331,12 @@ STAGE_PP(swizzle, void* ctx) {
     NOT_IMPLEMENTED(unbounded_uniform_color)
     NOT_IMPLEMENTED(unpremul)
     NOT_IMPLEMENTED(dither)  // TODO
+    NOT_IMPLEMENTED(evenly_spaced_2_stop_gradient_dither)  // dithered pipelines run highp anyway
+    NOT_IMPLEMENTED(clut_3d)
+    NOT_IMPLEMENTED(perlin_noise)
+    NOT_IMPLEMENTED(mipmap_linear_init)
+    NOT_IMPLEMENTED(mipmap_linear_update)
+    NOT_IMPLEMENTED(mipmap_linear_finish)
     NOT_IMPLEMENTED(load_16161616)
     NOT_IMPLEMENTED(load_16161616_dst)
     NOT_IMPLEMENTED(store_16161616)
@@ -10,6 +10,7 @@
 
 #include "include/private/SkColorData.h"
 
+#include <cstring>
 #include <utility>
 
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
@@ -1384,6 +1385,107 @@ static void RGB_to_BGR1_portable(uint32_t dst[], const uint8_t* src, int count)
     }
 #endif
 
+// Expand 1, 2, or 4 bit palette indices, packed big endian within each byte, into 8888
+// pixels through a color table of (1 << bpp) entries.  The color table is expected to
+// already be in destination order, so this is agnostic to the channel layout.
+static void small_index_to_8888_portable(uint32_t dst[], const uint8_t* src, int count,
+                                         int bpp, const uint32_t ctable[]) {
+    const int pixelsPerByte = 8 / bpp;
+    const uint8_t mask = (1 << bpp) - 1;
+    for (int i = 0; i < count; i++) {
+        uint8_t byte = src[i / pixelsPerByte];
+        int shift = 8 - bpp - (i % pixelsPerByte) * bpp;
+        dst[i] = ctable[(byte >> shift) & mask];
+    }
+}
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
+    /*not static*/ inline void small_index_to_8888(uint32_t dst[], const uint8_t* src, int count,
+                                                   int bpp, const uint32_t ctable[]) {
+        // Transpose the (at most 16 entry) color table into four 16-byte shuffle tables,
+        // one per pixel byte, so that each channel of 16 pixels is a single pshufb away.
+        alignas(16) uint8_t lut[4][16] = {};
+        for (int i = 0; i < (1 << bpp); i++) {
+            uint32_t color = ctable[i];
+            lut[0][i] = (color >>  0) & 0xFF;
+            lut[1][i] = (color >>  8) & 0xFF;
+            lut[2][i] = (color >> 16) & 0xFF;
+            lut[3][i] = (color >> 24) & 0xFF;
+        }
+        const __m128i lut0 = _mm_load_si128((const __m128i*) lut[0]),
+                      lut1 = _mm_load_si128((const __m128i*) lut[1]),
+                      lut2 = _mm_load_si128((const __m128i*) lut[2]),
+                      lut3 = _mm_load_si128((const __m128i*) lut[3]);
+
+        while (count >= 16) {
+            // Unpack 16 indices into one byte each, in order, in the low nibbles of idx.
+            __m128i idx;
+            if (4 == bpp) {
+                // Two pixels per byte: interleave the high and low nibbles of 8 bytes.
+                __m128i packed = _mm_loadl_epi64((const __m128i*) src);
+                __m128i nibbleMask = _mm_set1_epi8(0x0F);
+                __m128i hi = _mm_and_si128(_mm_srli_epi16(packed, 4), nibbleMask);
+                __m128i lo = _mm_and_si128(packed, nibbleMask);
+                idx = _mm_unpacklo_epi8(hi, lo);
+                src += 8;
+            } else if (2 == bpp) {
+                // Four pixels per byte: extract each 2-bit field of 4 bytes, then
+                // interleave the four copies back into source order.
+                uint32_t packed;
+                memcpy(&packed, src, 4);
+                __m128i bytes = _mm_cvtsi32_si128(packed);
+                __m128i fieldMask = _mm_set1_epi8(0x03);
+                __m128i s0 = _mm_and_si128(_mm_srli_epi16(bytes, 6), fieldMask),
+                        s1 = _mm_and_si128(_mm_srli_epi16(bytes, 4), fieldMask),
+                        s2 = _mm_and_si128(_mm_srli_epi16(bytes, 2), fieldMask),
+                        s3 = _mm_and_si128(bytes, fieldMask);
+                idx = _mm_unpacklo_epi16(_mm_unpacklo_epi8(s0, s1),
+                                         _mm_unpacklo_epi8(s2, s3));
+                src += 4;
+            } else {
+                // Eight pixels per byte: replicate each of 2 bytes eight times, then
+                // test each pixel's bit.
+                uint16_t packed;
+                memcpy(&packed, src, 2);
+                __m128i bytes = _mm_shuffle_epi8(
+                        _mm_cvtsi32_si128(packed),
+                        _mm_setr_epi8(0,0,0,0,0,0,0,0, 1,1,1,1,1,1,1,1));
+                __m128i bits = _mm_setr_epi8(
+                        (char) 0x80,0x40,0x20,0x10,0x08,0x04,0x02,0x01,
+                        (char) 0x80,0x40,0x20,0x10,0x08,0x04,0x02,0x01);
+                idx = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(bytes, bits), bits),
+                                    _mm_set1_epi8(1));
+                src += 2;
+            }
+
+            // Look up each channel of 16 pixels, then interleave the channels back
+            // into pixels.
+            __m128i c0 = _mm_shuffle_epi8(lut0, idx),
+                    c1 = _mm_shuffle_epi8(lut1, idx),
+                    c2 = _mm_shuffle_epi8(lut2, idx),
+                    c3 = _mm_shuffle_epi8(lut3, idx);
+            __m128i lo01 = _mm_unpacklo_epi8(c0, c1),
+                    hi01 = _mm_unpackhi_epi8(c0, c1),
+                    lo23 = _mm_unpacklo_epi8(c2, c3),
+                    hi23 = _mm_unpackhi_epi8(c2, c3);
+            _mm_storeu_si128((__m128i*) (dst +  0), _mm_unpacklo_epi16(lo01, lo23));
+            _mm_storeu_si128((__m128i*) (dst +  4), _mm_unpackhi_epi16(lo01, lo23));
+            _mm_storeu_si128((__m128i*) (dst +  8), _mm_unpacklo_epi16(hi01, hi23));
+            _mm_storeu_si128((__m128i*) (dst + 12), _mm_unpackhi_epi16(hi01, hi23));
+            dst += 16;
+            count -= 16;
+        }
+
+        // Call portable code to finish up the tail of [0,16) pixels.  src has only
+        // advanced by whole bytes, so the remaining pixels start on a byte boundary.
+        small_index_to_8888_portable(dst, src, count, bpp, ctable);
+    }
+#else
+    /*not static*/ inline void small_index_to_8888(uint32_t dst[], const uint8_t* src, int count,
+                                                   int bpp, const uint32_t ctable[]) {
+        small_index_to_8888_portable(dst, src, count, bpp, ctable);
+    }
+#endif
+
 }
 
 #endif // SkSwizzler_opts_DEFINED
@@ -13,6 +13,10 @@
 #include "src/pathops/SkPathOpsCommon.h"
 #include "src/pathops/SkPathWriter.h"
 
+SkOpContext::SkOpContext() : fStorageSize(0) {}
+
+SkOpContext::~SkOpContext() = default;
+
 const SkOpAngle* AngleWinding(SkOpSpanBase* start, SkOpSpanBase* end, int* windingPtr,
         bool* sortablePtr) {
     // find first angle, initialize winding to computed fWindSum
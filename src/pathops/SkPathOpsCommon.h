@@ -7,13 +7,56 @@
 #ifndef SkPathOpsCommon_DEFINED
 #define SkPathOpsCommon_DEFINED
 
+#include "include/pathops/SkPathOps.h"
 #include "include/private/SkTDArray.h"
+#include "src/core/SkArenaAlloc.h"
+#include "src/core/SkTLazy.h"
 #include "src/pathops/SkOpAngle.h"
 
 class SkOpCoincidence;
 class SkOpContour;
 class SkPathWriter;
 
+/** The scratch arena for one path operation. With no context the arena works out of an
+    inline block, exactly as before. With a context it works out of the context's block,
+    and on destruction grows the context's block to the operation's high-water mark so the
+    next operation through the same context allocates nothing from the heap.
+*/
+class SkOpContextArena {
+public:
+    static constexpr size_t kDefaultStorageSize = 4096;  // FIXME: constant-ize, tune
+
+    explicit SkOpContextArena(SkOpContext* context) : fContext(context) {
+        char* block = fInline;
+        size_t size = sizeof(fInline);
+        if (fContext) {
+            if (!fContext->fStorage) {
+                fContext->fStorageSize = kDefaultStorageSize;
+                fContext->fStorage.reset(new char[fContext->fStorageSize]);
+            }
+            block = fContext->fStorage.get();
+            size = fContext->fStorageSize;
+        }
+        fAlloc.init(block, size, kDefaultStorageSize);
+    }
+
+    ~SkOpContextArena() {
+        size_t spill = fAlloc.get()->totalHeapAllocated();
+        fAlloc.reset();  // run the arena down before replacing the block it sits in
+        if (fContext && spill) {
+            fContext->fStorageSize += spill;
+            fContext->fStorage.reset(new char[fContext->fStorageSize]);
+        }
+    }
+
+    SkArenaAlloc* alloc() { return fAlloc.get(); }
+
+private:
+    SkOpContext* fContext;
+    SkTLazy<SkArenaAlloc> fAlloc;
+    char fInline[kDefaultStorageSize];
+};
+
 const SkOpAngle* AngleWinding(SkOpSpanBase* start, SkOpSpanBase* end, int* windingPtr,
                               bool* sortable);
 SkOpSegment* FindChase(SkTDArray<SkOpSpanBase*>* chase, SkOpSpanBase** startPtr,
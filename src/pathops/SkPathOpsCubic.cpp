@@ -4,6 +4,7 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "include/private/SkVx.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkTSort.h"
 #include "src/pathops/SkLineParameters.h"
@@ -16,6 +17,20 @@
 
 const int SkDCubic::gPrecisionUnit = 256;  // FIXME: test different values in test framework
 
+// Evaluation kernels operate on both point coordinates at once; skvx lowers
+// these to two-lane double vectors (SSE2, NEON, wasm simd128) where available.
+using double2 = skvx::Vec<2, double>;
+
+static inline double2 load_pt(const SkDPoint& pt) {
+    return double2::Load(&pt.fX);
+}
+
+static inline SkDPoint store_pt(const double2& v) {
+    SkDPoint pt;
+    v.store(&pt.fX);
+    return pt;
+}
+
 void SkDCubic::align(int endIndex, int ctrlIndex, SkDPoint* dstPt) const {
     if (fPts[endIndex].fX == fPts[ctrlIndex].fX) {
         dstPt->fX = fPts[endIndex].fX;
@@ -495,7 +510,16 @@ int SkDCubic::RootsReal(double A, double B, double C, double D, double s[3]) {
 
 // OPTIMIZE? compute t^2, t(1-t), and (1-t)^2 and pass them to another version of derivative at t?
 SkDVector SkDCubic::dxdyAtT(double t) const {
-    SkDVector result = { derivative_at_t(&fPts[0].fX, t), derivative_at_t(&fPts[0].fY, t) };
+    // Two-lane version of derivative_at_t(), evaluating x and y together.
+    const double one_t = 1 - t;
+    const double2 p0 = load_pt(fPts[0]),
+                  p1 = load_pt(fPts[1]),
+                  p2 = load_pt(fPts[2]),
+                  p3 = load_pt(fPts[3]);
+    const double2 d = 3 * ((p1 - p0) * one_t * one_t
+                         + 2 * (p2 - p1) * t * one_t
+                         + (p3 - p2) * t * t);
+    SkDVector result = { d[0], d[1] };
     if (result.fX == 0 && result.fY == 0) {
         if (t == 0) {
             result = fPts[2] - fPts[0];
@@ -589,9 +613,8 @@ SkDPoint SkDCubic::ptAtT(double t) const {
     double t2 = t * t;
     double c = 3 * one_t * t2;
     double d = t2 * t;
-    SkDPoint result = {a * fPts[0].fX + b * fPts[1].fX + c * fPts[2].fX + d * fPts[3].fX,
-            a * fPts[0].fY + b * fPts[1].fY + c * fPts[2].fY + d * fPts[3].fY};
-    return result;
+    return store_pt(a * load_pt(fPts[0]) + b * load_pt(fPts[1])
+                  + c * load_pt(fPts[2]) + d * load_pt(fPts[3]));
 }
 
 /*
@@ -4,6 +4,7 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "include/core/SkRRect.h"
 #include "src/pathops/SkAddIntersections.h"
 #include "src/pathops/SkOpCoincidence.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
@@ -236,7 +237,306 @@ extern void (*gVerboseFinalize)();
 
 #endif
 
-bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
+
+// Operand classification for the analytic fast paths below. The operand shapes are taken
+// after the inverse-fill remap, so they always describe non-inverted geometry.
+enum class OpOperand {
+    kRect,
+    kRRect,
+    kConvex,  // a single convex contour that is neither of the above
+    kOther,
+};
+
+static OpOperand classify_operand(const SkPath& path, SkRect* rect, SkRRect* rrect) {
+    if (path.isRect(rect)) {
+        return OpOperand::kRect;
+    }
+    if (path.isRRect(rrect)) {
+        return OpOperand::kRRect;
+    }
+    if (path.isConvex() && !path.isEmpty()) {
+        return OpOperand::kConvex;
+    }
+    return OpOperand::kOther;
+}
+
+// Returns true when 'container' geometrically contains all of 'path'. Only rects and rrects
+// have exact containment tests; for other containers answer false.
+static bool operand_contains(OpOperand type, const SkRect& rect, const SkRRect& rrect,
+        const SkPath& path) {
+    switch (type) {
+        case OpOperand::kRect:
+            return rect.contains(path.getBounds());
+        case OpOperand::kRRect:
+            return rrect.contains(path.getBounds());
+        default:
+            return false;
+    }
+}
+
+// Returns true when the bounds are separated by more than the ULP slop the intersector
+// uses to weld nearly-touching edges, so the operands cannot interact at all.
+static bool bounds_well_separated(const SkRect& a, const SkRect& b) {
+    return !AlmostLessOrEqualUlps(a.fLeft, b.fRight) || !AlmostLessOrEqualUlps(b.fLeft, a.fRight)
+        || !AlmostLessOrEqualUlps(a.fTop, b.fBottom) || !AlmostLessOrEqualUlps(b.fTop, a.fBottom);
+}
+
+static bool convex_polygon_points(const SkPath& path, SkTDArray<SkPoint>* pts) {
+    if (!path.isConvex()) {
+        return false;
+    }
+    SkPath::RawIter iter(path);
+    SkPoint line[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(line)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                if (pts->count()) {
+                    return false;  // multiple contours
+                }
+                *pts->append() = line[0];
+                break;
+            case SkPath::kLine_Verb:
+                *pts->append() = line[1];
+                break;
+            case SkPath::kClose_Verb:
+                break;
+            default:
+                return false;  // curves want the full machinery
+        }
+    }
+    if (pts->count() >= 2 && (*pts)[0] == (*pts)[pts->count() - 1]) {
+        pts->pop();
+    }
+    return pts->count() >= 3;
+}
+
+/* Sutherland-Hodgman: clip the subject polygon by the half planes of the clip polygon's
+   edges. Both polygons are convex, so the result is exactly their convex intersection. */
+static bool clip_convex_polygons(const SkTDArray<SkPoint>& subject, const SkTDArray<SkPoint>& clip,
+        SkPath* result, SkPathFillType fillType) {
+    double area2 = 0;  // twice the signed area, to orient the clip half planes
+    for (int index = 0; index < clip.count(); ++index) {
+        const SkPoint& p = clip[index];
+        const SkPoint& q = clip[(index + 1) % clip.count()];
+        area2 += (double) p.fX * q.fY - (double) q.fX * p.fY;
+    }
+    if (!area2) {
+        return false;  // degenerate clip; let the full machinery decide
+    }
+    const double sign = area2 > 0 ? 1 : -1;
+    SkTDArray<SkDPoint> poly;
+    SkTDArray<SkDPoint> clipped;
+    for (int index = 0; index < subject.count(); ++index) {
+        SkDPoint dPt;
+        dPt.fX = subject[index].fX;
+        dPt.fY = subject[index].fY;
+        *poly.append() = dPt;
+    }
+    for (int edge = 0; edge < clip.count(); ++edge) {
+        const SkPoint& p = clip[edge];
+        const SkPoint& q = clip[(edge + 1) % clip.count()];
+        const double ex = (double) q.fX - p.fX;
+        const double ey = (double) q.fY - p.fY;
+        clipped.reset();
+        for (int index = 0; index < poly.count(); ++index) {
+            const SkDPoint& a = poly[index];
+            const SkDPoint& b = poly[(index + 1) % poly.count()];
+            const double da = sign * (ex * (a.fY - p.fY) - ey * (a.fX - p.fX));
+            const double db = sign * (ex * (b.fY - p.fY) - ey * (b.fX - p.fX));
+            if (da >= 0) {
+                *clipped.append() = a;
+            }
+            if ((da < 0) != (db < 0) && da != 0 && db != 0) {
+                const double s = da / (da - db);
+                SkDPoint crossing;
+                crossing.fX = a.fX + s * (b.fX - a.fX);
+                crossing.fY = a.fY + s * (b.fY - a.fY);
+                *clipped.append() = crossing;
+            }
+        }
+        using std::swap;
+        swap(poly, clipped);
+        if (poly.count() < 3) {
+            result->reset();
+            result->setFillType(fillType);
+            return true;
+        }
+    }
+    SkPath out;
+    bool first = true;
+    SkPoint last = { SK_ScalarNaN, SK_ScalarNaN };
+    for (int index = 0; index < poly.count(); ++index) {
+        SkPoint pt = { SkDoubleToScalar(poly[index].fX), SkDoubleToScalar(poly[index].fY) };
+        if (!first && pt == last) {
+            continue;  // collapse points welded together by the float round trip
+        }
+        if (first) {
+            out.moveTo(pt);
+            first = false;
+        } else {
+            out.lineTo(pt);
+        }
+        last = pt;
+    }
+    out.close();
+    out.setFillType(fillType);
+    *result = out;
+    return true;
+}
+
+/* Resolves operand pairs whose result is directly computable -- rects, rrects, and convex
+   polygons in containment, disjoint, or rectilinear configurations -- without building the
+   intersection machinery. Returns false to fall through to the full path. 'op' has already
+   been remapped for inverse fills, so the operands are treated as non-inverted geometry and
+   'fillType' carries any inversion of the output. */
+static bool analytic_op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+        SkPathFillType fillType) {
+    SkRect rect1, rect2;
+    SkRRect rrect1, rrect2;
+    const OpOperand type1 = classify_operand(one, &rect1, &rrect1);
+    const OpOperand type2 = classify_operand(two, &rect2, &rrect2);
+    if (OpOperand::kOther == type1 || OpOperand::kOther == type2) {
+        return false;
+    }
+    auto makeEmpty = [&]() {
+        result->reset();
+        result->setFillType(fillType);
+        return true;
+    };
+    auto makeShape = [&](const SkPath& shape) {
+        SkPath copy = shape;  // 'result' may alias an operand
+        copy.setFillType(fillType);
+        *result = copy;
+        return true;
+    };
+    // Appending both operands is valid under the even-odd output fill whenever the shapes
+    // are disjoint (both filled) or nested (the inner one becomes a hole).
+    auto makeBoth = [&]() {
+        SkPath both = one;
+        both.addPath(two);
+        both.setFillType(fillType);
+        *result = both;
+        return true;
+    };
+    if (OpOperand::kRect == type1 && OpOperand::kRect == type2) {
+        switch (op) {
+            case kIntersect_SkPathOp: {
+                SkRect sect = rect1;
+                result->reset();
+                result->setFillType(fillType);
+                if (sect.intersect(rect2)) {
+                    result->addRect(sect);
+                }
+                return true;
+            }
+            case kUnion_SkPathOp:
+                // joinable when the rects span the same extent on one axis and overlap or
+                // touch on the other; containment falls out of the generic cases below
+                if (rect1.fTop == rect2.fTop && rect1.fBottom == rect2.fBottom
+                        && rect1.fLeft <= rect2.fRight && rect2.fLeft <= rect1.fRight) {
+                    result->reset();
+                    result->setFillType(fillType);
+                    result->addRect({ std::min(rect1.fLeft, rect2.fLeft), rect1.fTop,
+                                      std::max(rect1.fRight, rect2.fRight), rect1.fBottom });
+                    return true;
+                }
+                if (rect1.fLeft == rect2.fLeft && rect1.fRight == rect2.fRight
+                        && rect1.fTop <= rect2.fBottom && rect2.fTop <= rect1.fBottom) {
+                    result->reset();
+                    result->setFillType(fillType);
+                    result->addRect({ rect1.fLeft, std::min(rect1.fTop, rect2.fTop),
+                                      rect1.fRight, std::max(rect1.fBottom, rect2.fBottom) });
+                    return true;
+                }
+                break;
+            case kDifference_SkPathOp:
+            case kReverseDifference_SkPathOp: {
+                const SkRect& minuend = kDifference_SkPathOp == op ? rect1 : rect2;
+                const SkRect& subtrahend = kDifference_SkPathOp == op ? rect2 : rect1;
+                if (!SkRect::Intersects(minuend, subtrahend)) {
+                    result->reset();
+                    result->setFillType(fillType);
+                    result->addRect(minuend);
+                    return true;
+                }
+                // slab subtraction when the subtrahend spans the minuend on one axis
+                if (subtrahend.fLeft <= minuend.fLeft && subtrahend.fRight >= minuend.fRight) {
+                    result->reset();
+                    result->setFillType(fillType);
+                    if (minuend.fTop < subtrahend.fTop) {
+                        result->addRect({ minuend.fLeft, minuend.fTop,
+                                          minuend.fRight, subtrahend.fTop });
+                    }
+                    if (subtrahend.fBottom < minuend.fBottom) {
+                        result->addRect({ minuend.fLeft, subtrahend.fBottom,
+                                          minuend.fRight, minuend.fBottom });
+                    }
+                    return true;
+                }
+                if (subtrahend.fTop <= minuend.fTop && subtrahend.fBottom >= minuend.fBottom) {
+                    result->reset();
+                    result->setFillType(fillType);
+                    if (minuend.fLeft < subtrahend.fLeft) {
+                        result->addRect({ minuend.fLeft, minuend.fTop,
+                                          subtrahend.fLeft, minuend.fBottom });
+                    }
+                    if (subtrahend.fRight < minuend.fRight) {
+                        result->addRect({ subtrahend.fRight, minuend.fTop,
+                                          minuend.fRight, minuend.fBottom });
+                    }
+                    return true;
+                }
+                break;  // an L-shaped remainder; let the machinery build it
+            }
+            case kXOR_SkPathOp:
+                if (rect1 == rect2) {
+                    return makeEmpty();
+                }
+                break;
+        }
+    }
+    const bool oneContainsTwo = operand_contains(type1, rect1, rrect1, two);
+    const bool twoContainsOne = !oneContainsTwo && operand_contains(type2, rect2, rrect2, one);
+    if (oneContainsTwo || twoContainsOne) {
+        switch (op) {
+            case kIntersect_SkPathOp:
+                return makeShape(oneContainsTwo ? two : one);
+            case kUnion_SkPathOp:
+                return makeShape(oneContainsTwo ? one : two);
+            case kDifference_SkPathOp:
+                return twoContainsOne ? makeEmpty() : makeBoth();
+            case kReverseDifference_SkPathOp:
+                return oneContainsTwo ? makeEmpty() : makeBoth();
+            case kXOR_SkPathOp:
+                return makeBoth();
+        }
+    }
+    if (bounds_well_separated(one.getBounds(), two.getBounds())) {
+        switch (op) {
+            case kIntersect_SkPathOp:
+                return makeEmpty();
+            case kUnion_SkPathOp:
+            case kXOR_SkPathOp:
+                return makeBoth();
+            case kDifference_SkPathOp:
+                return makeShape(one);
+            case kReverseDifference_SkPathOp:
+                return makeShape(two);
+        }
+    }
+    if (kIntersect_SkPathOp == op && OpOperand::kRRect != type1 && OpOperand::kRRect != type2) {
+        SkTDArray<SkPoint> subject;
+        SkTDArray<SkPoint> clip;
+        if (convex_polygon_points(one, &subject) && convex_polygon_points(two, &clip)) {
+            return clip_convex_polygons(subject, clip, result, fillType);
+        }
+    }
+    return false;
+}
+
+static bool op_with_context(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+        SkOpContext* context
         SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
 #if DEBUG_DUMP_VERIFY
 #ifndef SK_DEBUG
@@ -250,13 +550,7 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
     bool inverseFill = gOutInverse[op][one.isInverseFillType()][two.isInverseFillType()];
     SkPathFillType fillType = inverseFill ? SkPathFillType::kInverseEvenOdd :
             SkPathFillType::kEvenOdd;
-    SkRect rect1, rect2;
-    if (kIntersect_SkPathOp == op && one.isRect(&rect1) && two.isRect(&rect2)) {
-        result->reset();
-        result->setFillType(fillType);
-        if (rect1.intersect(rect2)) {
-            result->addRect(rect1);
-        }
+    if (analytic_op(one, two, op, result, fillType)) {
         return true;
     }
     if (one.isEmpty() || two.isEmpty()) {
@@ -284,12 +578,12 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
         if (inverseFill != work.isInverseFillType()) {
             work.toggleInverseFillType();
         }
-        return Simplify(work, result);
+        return Simplify(work, result, context);
     }
-    SkSTArenaAlloc<4096> allocator;  // FIXME: add a constant expression here, tune
+    SkOpContextArena arena(context);
     SkOpContour contour;
     SkOpContourHead* contourList = static_cast<SkOpContourHead*>(&contour);
-    SkOpGlobalState globalState(contourList, &allocator
+    SkOpGlobalState globalState(contourList, arena.alloc()
             SkDEBUGPARAMS(skipAssert) SkDEBUGPARAMS(testName));
     SkOpCoincidence coincidence(&globalState);
     const SkPath* minuend = &one;
@@ -367,7 +661,18 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
     return true;
 }
 
+bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
+        SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
+    return op_with_context(one, two, op, result, nullptr
+            SkDEBUGPARAMS(skipAssert) SkDEBUGPARAMS(testName));
+}
+
 bool Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
+    return Op(one, two, op, result, nullptr);
+}
+
+bool Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+        SkOpContext* context) {
 #if DEBUG_DUMP_VERIFY
     if (SkPathOpsDebug::gVerifyOp) {
         if (!OpDebug(one, two, op, result  SkDEBUGPARAMS(false) SkDEBUGPARAMS(nullptr))) {
@@ -378,5 +683,6 @@ bool Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
         return true;
     }
 #endif
-    return OpDebug(one, two, op, result  SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+    return op_with_context(one, two, op, result, context
+            SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
 }
@@ -4,6 +4,7 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "include/private/SkVx.h"
 #include "src/pathops/SkIntersections.h"
 #include "src/pathops/SkLineParameters.h"
 #include "src/pathops/SkPathOpsCubic.h"
@@ -11,6 +12,19 @@
 #include "src/pathops/SkPathOpsQuad.h"
 #include "src/pathops/SkPathOpsRect.h"
 
+// Two-lane (x, y) vector for the evaluation kernels; see SkPathOpsCubic.cpp.
+using double2 = skvx::Vec<2, double>;
+
+static inline double2 load_pt(const SkDPoint& pt) {
+    return double2::Load(&pt.fX);
+}
+
+static inline SkDPoint store_pt(const double2& v) {
+    SkDPoint pt;
+    v.store(&pt.fX);
+    return pt;
+}
+
 // from blackpawn.com/texts/pointinpoly
 static bool pointInTriangle(const SkDPoint fPts[3], const SkDPoint& test) {
     SkDVector v0 = fPts[2] - fPts[0];
@@ -200,8 +214,8 @@ SkDVector SkDQuad::dxdyAtT(double t) const {
     double a = t - 1;
     double b = 1 - 2 * t;
     double c = t;
-    SkDVector result = { a * fPts[0].fX + b * fPts[1].fX + c * fPts[2].fX,
-            a * fPts[0].fY + b * fPts[1].fY + c * fPts[2].fY };
+    const double2 d = a * load_pt(fPts[0]) + b * load_pt(fPts[1]) + c * load_pt(fPts[2]);
+    SkDVector result = { d[0], d[1] };
     if (result.fX == 0 && result.fY == 0) {
         if (zero_or_one(t)) {
             result = fPts[2] - fPts[0];
@@ -225,9 +239,7 @@ SkDPoint SkDQuad::ptAtT(double t) const {
     double a = one_t * one_t;
     double b = 2 * one_t * t;
     double c = t * t;
-    SkDPoint result = { a * fPts[0].fX + b * fPts[1].fX + c * fPts[2].fX,
-            a * fPts[0].fY + b * fPts[1].fY + c * fPts[2].fY };
-    return result;
+    return store_pt(a * load_pt(fPts[0]) + b * load_pt(fPts[1]) + c * load_pt(fPts[2]));
 }
 
 static double interp_quad_coords(const double* src, double t) {
@@ -4,6 +4,9 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "include/private/SkTArray.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pathops/SkAddIntersections.h"
 #include "src/pathops/SkOpCoincidence.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
@@ -137,7 +140,7 @@ static bool bridgeXor(SkOpContourHead* contourList, SkPathWriter* writer) {
 }
 
 // FIXME : add this as a member of SkPath
-bool SimplifyDebug(const SkPath& path, SkPath* result
+static bool simplify_with_context(const SkPath& path, SkPath* result, SkOpContext* context
         SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
     // returns 1 for evenodd, -1 for winding, regardless of inverse-ness
     SkPathFillType fillType = path.isInverseFillType() ? SkPathFillType::kInverseEvenOdd
@@ -150,10 +153,10 @@ bool SimplifyDebug(const SkPath& path, SkPath* result
         return true;
     }
     // turn path into list of segments
-    SkSTArenaAlloc<4096> allocator;  // FIXME: constant-ize, tune
+    SkOpContextArena arena(context);
     SkOpContour contour;
     SkOpContourHead* contourList = static_cast<SkOpContourHead*>(&contour);
-    SkOpGlobalState globalState(contourList, &allocator
+    SkOpGlobalState globalState(contourList, arena.alloc()
             SkDEBUGPARAMS(skipAssert) SkDEBUGPARAMS(testName));
     SkOpCoincidence coincidence(&globalState);
 #if DEBUG_DUMP_VERIFY
@@ -211,7 +214,127 @@ bool SimplifyDebug(const SkPath& path, SkPath* result
     return true;
 }
 
+bool SimplifyDebug(const SkPath& path, SkPath* result
+        SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
+    return simplify_with_context(path, result, nullptr
+            SkDEBUGPARAMS(skipAssert) SkDEBUGPARAMS(testName));
+}
+
+// Below this many contours the cost of splitting and merging outweighs what clustering saves.
+static constexpr int kMinClusteredContours = 4;
+
+/* If the path's contours fall into more than one group whose bounds neither overlap nor
+   touch, each group can be simplified independently: contours only influence one another
+   when they share area or an edge. Simplifies the groups concurrently on the default
+   executor and appends the results. Returns false without touching 'result' if the contours
+   all land in one group, the fill is inverted, or any group fails to simplify; the caller
+   then falls back to the single pass over the whole path. */
+static bool simplify_clusters(const SkPath& path, SkPath* result) {
+    if (path.isInverseFillType()) {
+        return false;
+    }
+    // split the path into its contours
+    SkTArray<SkPath> contours;
+    SkPath::RawIter iter(path);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                contours.push_back().setFillType(path.getFillType());
+                contours.back().moveTo(pts[0]);
+                break;
+            case SkPath::kLine_Verb:
+                contours.back().lineTo(pts[1]);
+                break;
+            case SkPath::kQuad_Verb:
+                contours.back().quadTo(pts[1], pts[2]);
+                break;
+            case SkPath::kConic_Verb:
+                contours.back().conicTo(pts[1], pts[2], iter.conicWeight());
+                break;
+            case SkPath::kCubic_Verb:
+                contours.back().cubicTo(pts[1], pts[2], pts[3]);
+                break;
+            case SkPath::kClose_Verb:
+                contours.back().close();
+                break;
+            default:
+                SkASSERT(0);
+        }
+    }
+    const int count = contours.count();
+    if (count < kMinClusteredContours) {
+        return false;
+    }
+    // union contours whose bounds overlap or nearly touch; shared edges weld during simplify
+    SkAutoTArray<int> group(count);
+    for (int index = 0; index < count; ++index) {
+        group[index] = index;
+    }
+    auto find = [&group](int index) {
+        while (group[index] != index) {
+            group[index] = group[group[index]];  // path halving
+            index = group[index];
+        }
+        return index;
+    };
+    for (int outer = 0; outer < count; ++outer) {
+        const SkRect& a = contours[outer].getBounds();
+        for (int inner = outer + 1; inner < count; ++inner) {
+            const SkRect& b = contours[inner].getBounds();
+            if (AlmostLessOrEqualUlps(a.fLeft, b.fRight)
+                    && AlmostLessOrEqualUlps(b.fLeft, a.fRight)
+                    && AlmostLessOrEqualUlps(a.fTop, b.fBottom)
+                    && AlmostLessOrEqualUlps(b.fTop, a.fBottom)) {
+                group[find(outer)] = find(inner);
+            }
+        }
+    }
+    // gather the contours of each cluster, ordered by first appearance
+    SkTArray<SkPath> clusters;
+    SkAutoTArray<int> clusterOf(count);
+    for (int index = 0; index < count; ++index) {
+        clusterOf[index] = -1;
+    }
+    for (int index = 0; index < count; ++index) {
+        int root = find(index);
+        if (clusterOf[root] < 0) {
+            clusterOf[root] = clusters.count();
+            clusters.push_back().setFillType(path.getFillType());
+        }
+        clusters[clusterOf[root]].addPath(contours[index]);
+    }
+    const int clusterCount = clusters.count();
+    if (clusterCount < 2) {
+        return false;
+    }
+    SkTArray<SkPath> simplified(clusterCount);
+    simplified.push_back_n(clusterCount);
+    SkAutoTArray<bool> success(clusterCount);
+    SkTaskGroup taskGroup;
+    taskGroup.batch(clusterCount, [&](int index) {
+        success[index] = SimplifyDebug(clusters[index], &simplified[index]
+                SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+    });
+    taskGroup.wait();
+    SkPath merged;
+    merged.setFillType(SkPathFillType::kEvenOdd);
+    for (int index = 0; index < clusterCount; ++index) {
+        if (!success[index]) {
+            return false;
+        }
+        merged.addPath(simplified[index]);
+    }
+    *result = merged;
+    return true;
+}
+
 bool Simplify(const SkPath& path, SkPath* result) {
+    return Simplify(path, result, nullptr);
+}
+
+bool Simplify(const SkPath& path, SkPath* result, SkOpContext* context) {
 #if DEBUG_DUMP_VERIFY
     if (SkPathOpsDebug::gVerifyOp) {
         if (!SimplifyDebug(path, result  SkDEBUGPARAMS(false) SkDEBUGPARAMS(nullptr))) {
@@ -222,5 +345,9 @@ bool Simplify(const SkPath& path, SkPath* result) {
         return true;
     }
 #endif
-    return SimplifyDebug(path, result  SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+    if (simplify_clusters(path, result)) {
+        return true;  // the per-cluster passes use their own arenas; 'context' goes unused
+    }
+    return simplify_with_context(path, result, context
+            SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
 }
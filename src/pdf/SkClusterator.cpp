@@ -25,12 +25,32 @@ static bool is_reversed(const uint32_t* clusters, uint32_t count) {
     return true;
 }
 
+static bool is_non_decreasing(const uint32_t* clusters, uint32_t count) {
+    for (uint32_t i = 0; i + 1 < count; ++i) {
+        if (clusters[i + 1] < clusters[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool is_non_increasing(const uint32_t* clusters, uint32_t count) {
+    for (uint32_t i = 0; i + 1 < count; ++i) {
+        if (clusters[i + 1] > clusters[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 SkClusterator::SkClusterator(const SkGlyphRun& run)
     : fClusters(run.clusters().data())
     , fUtf8Text(run.text().data())
     , fGlyphCount(SkToU32(run.glyphsIDs().size()))
     , fTextByteLength(SkToU32(run.text().size()))
     , fReversedChars(fClusters ? is_reversed(fClusters, fGlyphCount) : false)
+    , fNonDecreasing(fClusters ? is_non_decreasing(fClusters, fGlyphCount) : false)
+    , fNonIncreasing(fClusters ? is_non_increasing(fClusters, fGlyphCount) : false)
 {
     if (fClusters) {
         SkASSERT(fUtf8Text && fTextByteLength > 0 && fGlyphCount > 0);
@@ -52,12 +72,24 @@ SkClusterator::Cluster SkClusterator::next() {
         ++fCurrentGlyphIndex;
     } while (fCurrentGlyphIndex < fGlyphCount && cluster == fClusters[fCurrentGlyphIndex]);
     uint32_t clusterGlyphCount = fCurrentGlyphIndex - clusterGlyphIndex;
-    uint32_t clusterEnd = fTextByteLength;
-    for (unsigned i = 0; i < fGlyphCount; ++i) {
-       uint32_t c = fClusters[i];
-       if (c > cluster && c < clusterEnd) {
-           clusterEnd = c;
-       }
+    // The cluster's text ends where the next-largest cluster value begins.  For
+    // monotonic cluster maps (all LTR text, and RTL text laid out back to
+    // front) that value is adjacent to the current run of equal values, so the
+    // O(glyphCount) search is only needed for non-monotonic maps.
+    uint32_t clusterEnd;
+    if (fNonDecreasing) {
+        clusterEnd = fCurrentGlyphIndex < fGlyphCount ? fClusters[fCurrentGlyphIndex]
+                                                      : fTextByteLength;
+    } else if (fNonIncreasing) {
+        clusterEnd = clusterGlyphIndex > 0 ? fClusters[clusterGlyphIndex - 1] : fTextByteLength;
+    } else {
+        clusterEnd = fTextByteLength;
+        for (unsigned i = 0; i < fGlyphCount; ++i) {
+            uint32_t c = fClusters[i];
+            if (c > cluster && c < clusterEnd) {
+                clusterEnd = c;
+            }
+        }
     }
     uint32_t clusterLen = clusterEnd - cluster;
     return Cluster{fUtf8Text + cluster, clusterLen, clusterGlyphIndex, clusterGlyphCount};
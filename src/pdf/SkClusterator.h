@@ -40,6 +40,8 @@ private:
     uint32_t const fGlyphCount;
     uint32_t const fTextByteLength;
     bool const fReversedChars;
+    bool const fNonDecreasing;
+    bool const fNonIncreasing;
     uint32_t fCurrentGlyphIndex = 0;
 };
 
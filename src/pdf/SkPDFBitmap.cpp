@@ -14,6 +14,7 @@
 #include "include/private/SkColorData.h"
 #include "include/private/SkImageInfoPriv.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkResourceCache.h"
 #include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkJpegInfo.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
@@ -98,9 +99,80 @@ static void emit_image_stream(SkPDFDocument* doc,
     doc->emitStream(pdfDict, std::move(writeStream), ref);
 }
 
-static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
+// The output of encoding one image, independent of any document: the (already filtered) image
+// stream bytes, the soft mask stream bytes if the image has alpha, and how to describe them.
+// This is what gets shared across documents through the process-level cache below.
+struct PDFImageData {
+    sk_sp<SkData> fStream;
+    sk_sp<SkData> fAlphaStream;      // soft mask; null if the image is opaque
+    SkISize       fSize = {0, 0};
+    const char*   fColorSpace = "";  // points to a string literal
+    bool          fIsJpeg = false;
+};
+
+static void emit_image_data(const PDFImageData& image, SkPDFDocument* doc,
+                            SkPDFIndirectReference ref) {
+    SkPDFIndirectReference sMask;
+    if (image.fAlphaStream) {
+        sMask = doc->reserveRef();
+    }
+    sk_sp<SkData> stream = image.fStream;
+    emit_image_stream(doc, ref,
+                      [&stream](SkWStream* dst) { dst->write(stream->data(), stream->size()); },
+                      image.fSize, image.fColorSpace, sMask, SkToInt(stream->size()),
+                      image.fIsJpeg);
+    if (image.fAlphaStream) {
+        sk_sp<SkData> alpha = image.fAlphaStream;
+        emit_image_stream(doc, sMask,
+                          [&alpha](SkWStream* dst) { dst->write(alpha->data(), alpha->size()); },
+                          image.fSize, "DeviceGray", SkPDFIndirectReference(),
+                          SkToInt(alpha->size()), false);
+    }
+}
+
+// This creates a domain of keys in SkResourceCache used by this file.
+static void* kNamespace;
+
+struct ImageKey : public SkResourceCache::Key {
+public:
+    ImageKey(uint32_t imageID, int encodingQuality, int compressionLevel)
+            : fImageID(imageID)
+            , fEncodingQuality(encodingQuality)
+            , fCompressionLevel(compressionLevel) {
+        static const size_t kDataSize = sizeof(*this) - sizeof(SkResourceCache::Key);
+        this->init(&kNamespace, 0, kDataSize);
+    }
+
+    uint32_t fImageID;
+    int32_t  fEncodingQuality;
+    int32_t  fCompressionLevel;
+};
+
+class ImageRec : public SkResourceCache::Rec {
+public:
+    ImageRec(const ImageKey& key, PDFImageData image)
+            : fKey(key), fImage(std::move(image)) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fImage.fStream->size() +
+               (fImage.fAlphaStream ? fImage.fAlphaStream->size() : 0);
+    }
+    const char* getCategory() const override { return "pdf-image"; }
+
+    ImageKey     fKey;
+    PDFImageData fImage;
+};
+
+static bool image_find_visitor(const SkResourceCache::Rec& baseRec, void* ctx) {
+    const auto& rec = static_cast<const ImageRec&>(baseRec);
+    *static_cast<PDFImageData*>(ctx) = rec.fImage;
+    return true;
+}
+
+static sk_sp<SkData> deflate_alpha(const SkPixmap& pm, int compressionLevel) {
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, compressionLevel);
     if (kAlpha_8_SkColorType == pm.colorType()) {
         SkASSERT(pm.rowBytes() == (size_t)pm.width());
         buffer.write(pm.addr8(), pm.width() * pm.height());
@@ -128,29 +200,22 @@ static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndir
     #ifdef SK_PDF_BASE85_BINARY
     SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
     #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), "DeviceGray", SkPDFIndirectReference(),
-                      length, false);
+    return buffer.detachAsData();
 }
 
-static void do_deflated_image(const SkPixmap& pm,
-                              SkPDFDocument* doc,
-                              bool isOpaque,
-                              SkPDFIndirectReference ref) {
-    SkPDFIndirectReference sMask;
-    if (!isOpaque) {
-        sMask = doc->reserveRef();
-    }
+static void make_deflated_image(const SkPixmap& pm,
+                                bool isOpaque,
+                                int compressionLevel,
+                                PDFImageData* out) {
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, compressionLevel);
     const char* colorSpace = "DeviceGray";
     switch (pm.colorType()) {
         case kAlpha_8_SkColorType:
             fill_stream(&deflateWStream, '\x00', pm.width() * pm.height());
             break;
         case kGray_8_SkColorType:
-            SkASSERT(sMask.fValue = -1);
+            SkASSERT(isOpaque);
             SkASSERT(pm.rowBytes() == (size_t)pm.width());
             deflateWStream.write(pm.addr8(), pm.width() * pm.height());
             break;
@@ -185,16 +250,16 @@ static void do_deflated_image(const SkPixmap& pm,
     #ifdef SK_PDF_BASE85_BINARY
     SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
     #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), colorSpace, sMask, length, false);
+    out->fStream = buffer.detachAsData();
+    out->fSize = pm.info().dimensions();
+    out->fColorSpace = colorSpace;
+    out->fIsJpeg = false;
     if (!isOpaque) {
-        do_deflated_alpha(pm, doc, sMask);
+        out->fAlphaStream = deflate_alpha(pm, compressionLevel);
     }
 }
 
-static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
-                    SkPDFIndirectReference ref) {
+static bool make_jpeg_image(sk_sp<SkData> data, SkISize size, PDFImageData* out) {
     SkISize jpegSize;
     SkEncodedInfo::Color jpegColorType;
     SkEncodedOrigin exifOrientation;
@@ -215,10 +280,10 @@ static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
     data = buffer.detachAsData();
     #endif
 
-    emit_image_stream(doc, ref,
-                      [&data](SkWStream* dst) { dst->write(data->data(), data->size()); },
-                      jpegSize, yuv ? "DeviceRGB" : "DeviceGray",
-                      SkPDFIndirectReference(), SkToInt(data->size()), true);
+    out->fStream = std::move(data);
+    out->fSize = jpegSize;
+    out->fColorSpace = yuv ? "DeviceRGB" : "DeviceGray";
+    out->fIsJpeg = true;
     return true;
 }
 
@@ -252,21 +317,38 @@ void serialize_image(const SkImage* img,
     SkASSERT(img);
     SkASSERT(doc);
     SkASSERT(encodingQuality >= 0);
-    SkISize dimensions = img->dimensions();
-    sk_sp<SkData> data = img->refEncodedData();
-    if (data && do_jpeg(std::move(data), doc, dimensions, ref)) {
+    int compressionLevel = doc->metadata().fCompressionLevel;
+
+    // Images are immutable and their uniqueIDs are never recycled, so the encoded streams can
+    // be shared process-wide: a batch of documents embedding the same assets encodes each one
+    // only once. Stale entries simply age out of the cache budget.
+    bool shareResources = doc->metadata().fShareSerializedResources;
+    ImageKey key(img->uniqueID(), encodingQuality, compressionLevel);
+    PDFImageData image;
+    if (shareResources && SkResourceCache::Find(key, image_find_visitor, &image)) {
+        emit_image_data(image, doc, ref);
         return;
     }
-    SkBitmap bm = to_pixels(img);
-    SkPixmap pm = bm.pixmap();
-    bool isOpaque = pm.isOpaque() || pm.computeIsOpaque();
-    if (encodingQuality <= 100 && isOpaque) {
-        sk_sp<SkData> data = img->encodeToData(SkEncodedImageFormat::kJPEG, encodingQuality);
-        if (data && do_jpeg(std::move(data), doc, dimensions, ref)) {
-            return;
+
+    SkISize dimensions = img->dimensions();
+    sk_sp<SkData> data = img->refEncodedData();
+    if (!(data && make_jpeg_image(std::move(data), dimensions, &image))) {
+        SkBitmap bm = to_pixels(img);
+        SkPixmap pm = bm.pixmap();
+        bool isOpaque = pm.isOpaque() || pm.computeIsOpaque();
+        bool encoded = false;
+        if (encodingQuality <= 100 && isOpaque) {
+            sk_sp<SkData> jpeg = img->encodeToData(SkEncodedImageFormat::kJPEG, encodingQuality);
+            encoded = jpeg && make_jpeg_image(std::move(jpeg), dimensions, &image);
         }
+        if (!encoded) {
+            make_deflated_image(pm, isOpaque, compressionLevel, &image);
+        }
+    }
+    if (shareResources) {
+        SkResourceCache::Add(new ImageRec(key, image));
     }
-    do_deflated_image(pm, doc, isOpaque, ref);
+    emit_image_data(image, doc, ref);
 }
 
 SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
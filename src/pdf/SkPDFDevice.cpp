@@ -10,6 +10,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkDrawable.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
 #include "include/core/SkRRect.h"
@@ -341,6 +342,12 @@ void SkPDFDevice::drawAnnotation(const SkRect& rect, const char key[], SkData* v
     pageXform.postConcat(fDocument->currentPageTransform());
     if (rect.isEmpty()) {
         if (!strcmp(key, SkPDFGetNodeIdKey())) {
+            if (!fDocument->metadata().fStructureElementTreeRoot) {
+                // Without a structure tree, marked content would never be
+                // referenced; leaving fNodeId at zero skips that bookkeeping
+                // for every subsequent draw.
+                return;
+            }
             int nodeID;
             if (value->size() != sizeof(nodeID)) { return; }
             memcpy(&nodeID, value->data(), sizeof(nodeID));
@@ -444,6 +451,20 @@ void SkPDFDevice::drawPoints(SkCanvas::PointMode mode,
         }
     }
 
+    // As in internalDrawPath(), cull draws wholly outside the clip so they are
+    // not serialized at all.
+    if (paint->canComputeFastBounds()) {
+        SkRect bounds;
+        bounds.setBounds(points, SkToInt(count));
+        SkRect storage;
+        SkRect deviceBounds = paint->computeFastStrokeBounds(bounds, &storage);
+        this->localToDevice().mapRect(&deviceBounds);
+        deviceBounds.outset(SK_Scalar1, SK_Scalar1);
+        if (!deviceBounds.intersects(this->cs().bounds(this->bounds()))) {
+            return;
+        }
+    }
+
     ScopedContentEntry content(this, *paint);
     if (!content) {
         return;
@@ -573,6 +594,20 @@ void SkPDFDevice::internalDrawPath(const SkClipStack& clipStack,
         return;
     }
     SkTCopyOnFirstWrite<SkPaint> paint(clean_paint(srcPaint));
+    // PDF evaluates clips at view time, not at export time, so a draw whose
+    // device-space bounds lie wholly outside the clip would otherwise still be
+    // serialized into the content stream.  Quick-reject it here instead; the
+    // one-pixel outset matches SkCanvas::quickReject and keeps hairlines with
+    // empty geometric bounds drawable.
+    if (!origPath.isInverseFillType() && paint->canComputeFastBounds()) {
+        SkRect storage;
+        SkRect deviceBounds = paint->computeFastBounds(origPath.getBounds(), &storage);
+        ctm.mapRect(&deviceBounds);
+        deviceBounds.outset(SK_Scalar1, SK_Scalar1);
+        if (!deviceBounds.intersects(clipStack.bounds(this->bounds()))) {
+            return;
+        }
+    }
     SkPath modifiedPath;
     SkPath* pathPtr = const_cast<SkPath*>(&origPath);
 
@@ -1015,6 +1050,52 @@ void SkPDFDevice::drawDevice(SkBaseDevice* device, int x, int y, const SkPaint&
     this->drawFormXObject(pdfDevice->makeFormXObjectFromDevice(), content.stream());
 }
 
+void SkPDFDevice::drawDrawable(SkDrawable* drawable, const SkMatrix* matrix, SkCanvas* canvas) {
+    SkASSERT(drawable);
+    if (this->hasEmptyClip()) {
+        return;
+    }
+    SkRect drawableBounds = drawable->getBounds();
+    SkIRect bbox = drawableBounds.roundOut();
+    if (bbox.isEmpty()) {
+        this->INHERITED::drawDrawable(drawable, matrix, canvas);
+        return;
+    }
+    SkMatrix totalMatrix = this->localToDevice();
+    if (matrix) {
+        totalMatrix.preConcat(*matrix);
+    }
+    SkRect deviceBounds = totalMatrix.mapRect(drawableBounds);
+    deviceBounds.outset(SK_Scalar1, SK_Scalar1);
+    if (!deviceBounds.intersects(this->cs().bounds(this->bounds()))) {
+        return;
+    }
+    // Each distinct drawable snapshot is serialized once per document as a
+    // Form XObject; replaying it again (e.g. a template header drawn on every
+    // page) only emits a reference. The generation ID changes whenever the
+    // drawable's content does, so stale entries are never reused.
+    uint32_t genID = drawable->getGenerationID();
+    SkPDFIndirectReference xObject;
+    if (SkPDFIndirectReference* ref = fDocument->fDrawableXObjectMap.find(genID)) {
+        xObject = *ref;
+    } else {
+        auto drawableDevice = sk_make_sp<SkPDFDevice>(bbox.size(), fDocument);
+        SkCanvas drawableCanvas(drawableDevice);
+        drawableCanvas.translate(-SkIntToScalar(bbox.left()), -SkIntToScalar(bbox.top()));
+        drawable->draw(&drawableCanvas);
+        xObject = drawableDevice->makeFormXObjectFromDevice();
+        fDocument->fDrawableXObjectMap.set(genID, xObject);
+    }
+    // The form's content is in drawable space, offset to the bounds' origin.
+    totalMatrix.preTranslate(SkIntToScalar(bbox.left()), SkIntToScalar(bbox.top()));
+    SkPaint paint;
+    ScopedContentEntry content(this, &this->cs(), totalMatrix, paint);
+    if (!content) {
+        return;
+    }
+    this->drawFormXObject(xObject, content.stream());
+}
+
 sk_sp<SkSurface> SkPDFDevice::makeSurface(const SkImageInfo& info, const SkSurfaceProps& props) {
     return SkSurface::MakeRaster(info, &props);
 }
@@ -87,6 +87,7 @@ public:
     void drawVertices(const SkVertices*, SkBlendMode, const SkPaint&) override;
     void drawDevice(SkBaseDevice*, int x, int y,
                     const SkPaint&) override;
+    void drawDrawable(SkDrawable*, const SkMatrix*, SkCanvas*) override;
 
     // PDF specific methods.
     void drawSprite(const SkBitmap& bitmap, int x, int y,
@@ -8,6 +8,7 @@
 #include "include/docs/SkPDFDocument.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/docs/SkPDFDocument.h"
 #include "include/private/SkTo.h"
@@ -578,8 +579,23 @@ void SkPDFDocument::onClose(SkWStream* stream) {
 
     auto docCatalogRef = this->emit(*docCatalog);
 
+    // Page content streams were already compressed and serialized on fExecutor's threads as each
+    // page ended (see SkPDFStreamOut); font subsetting is the remaining heavy work at close.
+    // Multi-byte subsets only touch the document through the thread-safe emit()/reserveRef(), and
+    // the glyph-usage and metrics tables are read-only by now, so those can be produced in
+    // parallel too. Type1 and Type3 emission mutates shared document state and stays here.
     for (const SkPDFFont* f : get_fonts(*this)) {
-        f->emitSubset(this);
+        bool multiByte = f->getType() == SkAdvancedTypefaceMetrics::kTrueType_Font ||
+                         f->getType() == SkAdvancedTypefaceMetrics::kType1CID_Font;
+        if (fExecutor && multiByte) {
+            this->incrementJobCount();
+            fExecutor->add([f, this] {
+                f->emitSubset(this);
+                this->signalJobComplete();
+            });
+        } else {
+            f->emitSubset(this);
+        }
     }
 
     this->waitForJobs();
@@ -617,5 +633,8 @@ sk_sp<SkDocument> SkPDF::MakeDocument(SkWStream* stream, const SkPDF::Metadata&
     if (meta.fEncodingQuality < 0) {
         meta.fEncodingQuality = 0;
     }
+    if (meta.fCompressionLevel < -1 || meta.fCompressionLevel > 9) {
+        meta.fCompressionLevel = -1;
+    }
     return stream ? sk_make_sp<SkPDFDocument>(stream, std::move(meta)) : nullptr;
 }
@@ -30,6 +30,8 @@
 #include "src/core/SkGlyph.h"
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkMask.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkResourceCache.h"
 #include "src/core/SkScalerCache.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeSpec.h"
@@ -266,6 +268,93 @@ void SkPDFFont::PopulateCommonFontDescriptor(SkPDFDict* descriptor,
 //  Type0Font
 ///////////////////////////////////////////////////////////////////////////////
 
+// This creates a domain of keys in SkResourceCache used by this file.
+static void* kSubsetFontNamespace;
+
+struct SubsetFontKey : public SkResourceCache::Key {
+public:
+    SubsetFontKey(SkFontID typefaceID, int ttcIndex, SkPDF::Metadata::Subsetter subsetter,
+                  uint32_t glyphCount, uint32_t glyphHash)
+            : fTypefaceID(typefaceID)
+            , fTtcIndex(ttcIndex)
+            , fSubsetter(SkToS32(subsetter))
+            , fGlyphCount(glyphCount)
+            , fGlyphHash(glyphHash) {
+        static const size_t kDataSize = sizeof(*this) - sizeof(SkResourceCache::Key);
+        this->init(&kSubsetFontNamespace, 0, kDataSize);
+    }
+
+    uint32_t fTypefaceID;
+    int32_t  fTtcIndex;
+    int32_t  fSubsetter;
+    uint32_t fGlyphCount;
+    uint32_t fGlyphHash;
+};
+
+class SubsetFontRec : public SkResourceCache::Rec {
+public:
+    SubsetFontRec(const SubsetFontKey& key, std::vector<SkGlyphID> glyphIDs,
+                  sk_sp<SkData> subsetData)
+            : fKey(key), fGlyphIDs(std::move(glyphIDs)), fSubsetData(std::move(subsetData)) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fGlyphIDs.size() * sizeof(SkGlyphID) + fSubsetData->size();
+    }
+    const char* getCategory() const override { return "pdf-subset-font"; }
+
+    SubsetFontKey          fKey;
+    std::vector<SkGlyphID> fGlyphIDs;  // resolves key hash collisions exactly
+    sk_sp<SkData>          fSubsetData;
+};
+
+struct SubsetFontFindContext {
+    const std::vector<SkGlyphID>* fGlyphIDs;
+    sk_sp<SkData> fSubsetData;
+};
+
+static bool subset_font_find_visitor(const SkResourceCache::Rec& baseRec, void* ctx) {
+    const auto& rec = static_cast<const SubsetFontRec&>(baseRec);
+    auto* findContext = static_cast<SubsetFontFindContext*>(ctx);
+    if (rec.fGlyphIDs != *findContext->fGlyphIDs) {
+        return false;  // hash collision; treat as a miss
+    }
+    findContext->fSubsetData = rec.fSubsetData;
+    return true;
+}
+
+/// As SkPDFSubsetFont(), but shares results process-wide: templated documents embedding the same
+// typeface with the same set of glyphs subset it only once. Typeface uniqueIDs are never
+// recycled, so no invalidation is needed; entries for dead typefaces age out of the budget.
+static sk_sp<SkData> subset_font_cached(sk_sp<SkData> fontData,
+                                        const SkPDFGlyphUse& glyphUsage,
+                                        SkPDF::Metadata::Subsetter subsetter,
+                                        const char* fontName,
+                                        int ttcIndex,
+                                        SkFontID typefaceID,
+                                        bool shareResources) {
+    if (!shareResources) {
+        return SkPDFSubsetFont(std::move(fontData), glyphUsage, subsetter, fontName, ttcIndex);
+    }
+    std::vector<SkGlyphID> glyphIDs;
+    glyphUsage.getSetValues([&glyphIDs](unsigned gid) {
+        glyphIDs.push_back(SkToU16(gid));
+    });
+    uint32_t glyphHash = SkOpts::hash(glyphIDs.data(), glyphIDs.size() * sizeof(SkGlyphID));
+    SubsetFontKey key(typefaceID, ttcIndex, subsetter, SkToU32(glyphIDs.size()), glyphHash);
+
+    SubsetFontFindContext findContext = {&glyphIDs, nullptr};
+    if (SkResourceCache::Find(key, subset_font_find_visitor, &findContext)) {
+        return std::move(findContext.fSubsetData);
+    }
+    sk_sp<SkData> subsetData = SkPDFSubsetFont(std::move(fontData), glyphUsage, subsetter,
+                                               fontName, ttcIndex);
+    if (subsetData) {
+        SkResourceCache::Add(new SubsetFontRec(key, std::move(glyphIDs), subsetData));
+    }
+    return subsetData;
+}
+
 // if possible, make no copy.
 static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
     SkASSERT(stream);
@@ -308,10 +397,11 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                 if (!SkToBool(metrics.fFlags &
                               SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
                     SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
+                    sk_sp<SkData> subsetFontData = subset_font_cached(
                             stream_to_data(std::move(fontAsset)), font.glyphUsage(),
                             doc->metadata().fSubsetter,
-                            metrics.fFontName.c_str(), ttcIndex);
+                            metrics.fFontName.c_str(), ttcIndex, face->uniqueID(),
+                            doc->metadata().fShareSerializedResources);
                     if (subsetFontData) {
                         std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                         tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
@@ -393,21 +393,11 @@ static void ft_face_setup_axes(SkFaceRec* rec, const SkFontData& data) {
     }
 }
 
-// Will return nullptr on failure
-// Caller must lock f_t_mutex() before calling this function.
-static SkFaceRec* ref_ft_face(const SkTypeface_FreeType* typeface) {
-    f_t_mutex().assertHeld();
-
+// Open the typeface's font data as a new FT_Face on the given library.
+// Will return nullptr on failure. Makes no use of shared state, so any library may be used.
+static std::unique_ptr<SkFaceRec> make_face_rec(FT_Library library,
+                                                const SkTypeface_FreeType* typeface) {
     const SkFontID fontID = typeface->uniqueID();
-    SkFaceRec* cachedRec = gFaceRecHead;
-    while (cachedRec) {
-        if (cachedRec->fFontID == fontID) {
-            SkASSERT(cachedRec->fFace);
-            cachedRec->fRefCnt += 1;
-            return cachedRec;
-        }
-        cachedRec = cachedRec->fNext;
-    }
 
     std::unique_ptr<SkFontData> data = typeface->makeFontData();
     if (nullptr == data || !data->hasStream()) {
@@ -430,7 +420,7 @@ static SkFaceRec* ref_ft_face(const SkTypeface_FreeType* typeface) {
 
     {
         FT_Face rawFace;
-        FT_Error err = FT_Open_Face(gFTLibrary->library(), &args, data->getIndex(), &rawFace);
+        FT_Error err = FT_Open_Face(library, &args, data->getIndex(), &rawFace);
         if (err) {
             SK_TRACEFTR(err, "unable to open font '%x'", fontID);
             return nullptr;
@@ -451,6 +441,30 @@ static SkFaceRec* ref_ft_face(const SkTypeface_FreeType* typeface) {
         FT_Select_Charmap(rec->fFace.get(), FT_ENCODING_MS_SYMBOL);
     }
 
+    return rec;
+}
+
+// Will return nullptr on failure
+// Caller must lock f_t_mutex() before calling this function.
+static SkFaceRec* ref_ft_face(const SkTypeface_FreeType* typeface) {
+    f_t_mutex().assertHeld();
+
+    const SkFontID fontID = typeface->uniqueID();
+    SkFaceRec* cachedRec = gFaceRecHead;
+    while (cachedRec) {
+        if (cachedRec->fFontID == fontID) {
+            SkASSERT(cachedRec->fFace);
+            cachedRec->fRefCnt += 1;
+            return cachedRec;
+        }
+        cachedRec = cachedRec->fNext;
+    }
+
+    std::unique_ptr<SkFaceRec> rec = make_face_rec(gFTLibrary->library(), typeface);
+    if (!rec) {
+        return nullptr;
+    }
+
     rec->fNext = gFaceRecHead;
     gFaceRecHead = rec.get();
     return rec.release();
@@ -526,15 +540,25 @@ protected:
     unsigned generateGlyphCount() override;
     bool generateAdvance(SkGlyph* glyph) override;
     void generateMetrics(SkGlyph* glyph) override;
+    void generateMetricsBatch(SkSpan<SkGlyph*> glyphs) override;
     void generateImage(const SkGlyph& glyph) override;
     bool generatePath(SkGlyphID glyphID, SkPath* path) override;
     void generateFontMetrics(SkFontMetrics*) override;
 
 private:
-    using UnrefFTFace = SkFunctionWrapper<decltype(unref_ft_face), unref_ft_face>;
-    std::unique_ptr<SkFaceRec, UnrefFTFace> fFaceRec;
+    /** This context's private FreeType instance.
+     *
+     *  FreeType is thread safe as long as each FT_Library (and the objects created from it) is
+     *  only used by one thread at a time. The strike cache already serializes all use of a given
+     *  scaler context, but a context may be used from different threads over its lifetime, so the
+     *  library is owned per context rather than per thread. With a private library and face the
+     *  glyph generation methods need no global lock; only the typeface-level face cache
+     *  (gFaceRecHead) remains guarded by f_t_mutex().
+     */
+    std::unique_ptr<FreeTypeLibrary> fLibrary;
+    std::unique_ptr<SkFaceRec> fFaceRec;  // Opened on fLibrary; declared after so destroyed first.
 
-    FT_Face   fFace;  // Borrowed face from gFaceRecHead.
+    FT_Face   fFace;  // Borrowed face from fFaceRec.
     FT_Size   fFTSize;  // The size on the fFace for this scaler.
     FT_Int    fStrikeIndex;
 
@@ -556,9 +580,9 @@ private:
     void getBBoxForCurrentGlyph(const SkGlyph* glyph, FT_BBox* bbox,
                                 bool snapToPixelBoundary = false);
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
-    // Caller must lock f_t_mutex() before calling this function.
     void updateGlyphIfLCD(SkGlyph* glyph);
-    // Caller must lock f_t_mutex() before calling this function.
+    // The body of generateMetrics; requires setupSize done.
+    void internalGenerateMetrics(SkGlyph* glyph);
     // update FreeType2 glyph slot with glyph emboldened
     void emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph, SkGlyphID gid);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -866,10 +890,14 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
     , fFTSize(nullptr)
     , fStrikeIndex(-1)
 {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-    SkASSERT_RELEASE(ref_ft_library());
+    fLibrary = std::make_unique<FreeTypeLibrary>();
+    if (nullptr == fLibrary->library()) {
+        LOG_INFO("Could not create FT_Library.\n");
+        return;
+    }
 
-    fFaceRec.reset(ref_ft_face(static_cast<SkTypeface_FreeType*>(this->getTypeface())));
+    fFaceRec = make_face_rec(fLibrary->library(),
+                             static_cast<SkTypeface_FreeType*>(this->getTypeface()));
 
     // load the font file
     if (nullptr == fFaceRec) {
@@ -899,7 +927,7 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
                 break;
             case SkFontHinting::kSlight:
                 loadFlags = FT_LOAD_TARGET_LIGHT;  // This implies FORCE_AUTOHINT
-                if (gFTLibrary->lightHintingIsYOnly()) {
+                if (fLibrary->lightHintingIsYOnly()) {
                     linearMetrics = true;
                 }
                 break;
@@ -1044,22 +1072,17 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
 }
 
 SkScalerContext_FreeType::~SkScalerContext_FreeType() {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     if (fFTSize != nullptr) {
         FT_Done_Size(fFTSize);
     }
 
-    fFaceRec = nullptr;
-
-    unref_ft_library();
+    // fFaceRec and then fLibrary are torn down by the member destructors, in that order.
 }
 
-/*  We call this before each use of the fFace, since we may be sharing
-    this face with other context (at different sizes).
+/*  We call this before each use of the fFace; the face is private to this context,
+    but FreeType tracks the active size and transform on the face itself.
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    f_t_mutex().assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -1080,8 +1103,6 @@ bool SkScalerContext_FreeType::generateAdvance(SkGlyph* glyph) {
         return false;
     }
 
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     if (this->setupSize()) {
         glyph->zeroMetrics();
         return true;
@@ -1159,11 +1180,11 @@ bool SkScalerContext_FreeType::getCBoxForLetter(char letter, FT_BBox* bbox) {
 void SkScalerContext_FreeType::updateGlyphIfLCD(SkGlyph* glyph) {
     if (glyph->fMaskFormat == SkMask::kLCD16_Format) {
         if (fLCDIsVert) {
-            glyph->fHeight += gFTLibrary->lcdExtra();
-            glyph->fTop -= gFTLibrary->lcdExtra() >> 1;
+            glyph->fHeight += fLibrary->lcdExtra();
+            glyph->fTop -= fLibrary->lcdExtra() >> 1;
         } else {
-            glyph->fWidth += gFTLibrary->lcdExtra();
-            glyph->fLeft -= gFTLibrary->lcdExtra() >> 1;
+            glyph->fWidth += fLibrary->lcdExtra();
+            glyph->fLeft -= fLibrary->lcdExtra() >> 1;
         }
     }
 }
@@ -1185,8 +1206,6 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 }
 
 void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     glyph->fMaskFormat = fRec.fMaskFormat;
 
     if (this->setupSize()) {
@@ -1194,6 +1213,24 @@ void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
         return;
     }
 
+    this->internalGenerateMetrics(glyph);
+}
+
+void SkScalerContext_FreeType::generateMetricsBatch(SkSpan<SkGlyph*> glyphs) {
+    // One size setup for the whole run; the face is private to this context,
+    // so nothing can switch the active FT_Size underneath us.
+    const bool sizeBroken = this->setupSize();
+    for (SkGlyph* glyph : glyphs) {
+        glyph->fMaskFormat = fRec.fMaskFormat;
+        if (sizeBroken) {
+            glyph->zeroMetrics();
+        } else {
+            this->internalGenerateMetrics(glyph);
+        }
+    }
+}
+
+void SkScalerContext_FreeType::internalGenerateMetrics(SkGlyph* glyph) {
     FT_Error    err;
     err = FT_Load_Glyph( fFace, glyph->getGlyphID(),
                          fLoadGlyphFlags | FT_LOAD_BITMAP_METRICS_ONLY );
@@ -1337,8 +1374,6 @@ void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     if (this->setupSize()) {
         sk_bzero(glyph.fImage, glyph.imageSize());
         return;
@@ -1370,8 +1405,6 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
 bool SkScalerContext_FreeType::generatePath(SkGlyphID glyphID, SkPath* path) {
     SkASSERT(path);
 
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
     if (!FT_IS_SCALABLE(fFace) || this->setupSize()) {
         path->reset();
@@ -1411,8 +1444,6 @@ void SkScalerContext_FreeType::generateFontMetrics(SkFontMetrics* metrics) {
         return;
     }
 
-    SkAutoMutexExclusive ac(f_t_mutex());
-
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
         return;
@@ -1601,15 +1632,9 @@ void SkTypeface_FreeType::onCharsToGlyphs(const SkUnichar uni[], int count,
 
     SkAutoMutexExclusive ama(fC2GCacheMutex);
 
-    int i;
-    for (i = 0; i < count; ++i) {
-        int index = fC2GCache.findGlyphIndex(uni[i]);
-        if (index < 0) {
-            break;
-        }
-        glyphs[i] = SkToU16(index);
-    }
-    if (i == count) {
+    SkAutoSTMalloc<64, int> missIndices(count);
+    int missCount = fC2GCache.findGlyphIndices(uni, count, glyphs, missIndices.get());
+    if (missCount == 0) {
         // we're done, no need to access the freetype objects
         return;
     }
@@ -1621,8 +1646,11 @@ void SkTypeface_FreeType::onCharsToGlyphs(const SkUnichar uni[], int count,
         return;
     }
 
-    for (; i < count; ++i) {
+    for (int j = 0; j < missCount; ++j) {
+        const int i = missIndices[j];
         SkUnichar c = uni[i];
+        // Misses come back grouped by unichar, so after the first occurrence is
+        // inserted the duplicates hit the cache.
         int index = fC2GCache.findGlyphIndex(c);
         if (index >= 0) {
             glyphs[i] = SkToU16(index);
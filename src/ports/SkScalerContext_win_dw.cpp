@@ -50,8 +50,8 @@ static SkSharedMutex& get_dwrite_factory_mutex() {
     return mutex;
 }
 
-typedef SkAutoSharedMutexExclusive Exclusive;
-typedef SkAutoSharedMutexShared Shared;
+typedef SkAutoSharedMutexExclusive<SkSharedMutex> Exclusive;
+typedef SkAutoSharedMutexShared<SkSharedMutex> Shared;
 
 static bool isLCD(const SkScalerContextRec& rec) {
     return SkMask::kLCD16_Format == rec.fMaskFormat;
@@ -548,6 +548,60 @@ bool SkImageShader::doStages(const SkStageRec& rec, SkImageStageUpdater* updater
         return false;
     }
 
+    // Medium quality: rather than snapping to a single mip level, sample the two levels
+    // bracketing the ideal scale and lerp between them in the pipeline (trilinear filtering).
+    // Restricted to the common 8888 clamp/clamp configuration; everything else resolves to a
+    // single level through the controller below.
+    if (quality == kMedium_SkFilterQuality && !updater
+        && (fImage->colorType() == kRGBA_8888_SkColorType ||
+            fImage->colorType() == kBGRA_8888_SkColorType)
+        && fTileModeX == SkTileMode::kClamp && fTileModeY == SkTileMode::kClamp) {
+
+        auto* access = alloc->make<SkMipmapAccessor>(as_IB(fImage.get()), matrix,
+                                                     SkMipmapMode::kLinear);
+        const SkPixmap& upper = access->level();
+        const SkPixmap& lower = access->lowerLevel();
+        if (access->mode() == SkMipmapMode::kLinear && access->lowerWeight() > 0
+            && upper.addr() && lower.addr()) {
+
+            SkMatrix upperInv = matrix;
+            upperInv.postScale(upper.width()  / SkIntToScalar(fImage->width()),
+                               upper.height() / SkIntToScalar(fImage->height()));
+
+            p->append(SkRasterPipeline::seed_shader);
+            p->append_matrix(alloc, upperInv);
+
+            auto* mip = alloc->make<SkRasterPipeline_MipmapCtx>();
+            mip->scaleX      = lower.width()  / SkIntToScalar(upper.width());
+            mip->scaleY      = lower.height() / SkIntToScalar(upper.height());
+            mip->lowerWeight = access->lowerWeight();
+
+            auto append_level = [&](const SkPixmap& level) {
+                auto* levelGather = alloc->make<SkRasterPipeline_GatherCtx>();
+                levelGather->pixels = level.addr();
+                levelGather->stride = level.rowBytesAsPixels();
+                levelGather->width  = level.width();
+                levelGather->height = level.height();
+                p->append(SkRasterPipeline::bilerp_clamp_8888, levelGather);
+                if (fImage->colorType() == kBGRA_8888_SkColorType) {
+                    p->append(SkRasterPipeline::swap_rb);
+                }
+            };
+
+            p->append(SkRasterPipeline::mipmap_linear_init, mip);
+            append_level(upper);
+            p->append(SkRasterPipeline::mipmap_linear_update, mip);
+            append_level(lower);
+            p->append(SkRasterPipeline::mipmap_linear_finish, mip);
+
+            // Transform color space and alpha type to match shader convention.
+            alloc->make<SkColorSpaceXformSteps>(upper.colorSpace(), upper.alphaType(),
+                                                rec.fDstCS, kPremul_SkAlphaType)
+                ->apply(p);
+            return true;
+        }
+    }
+
     const auto* state = SkBitmapController::RequestBitmap(as_IB(fImage.get()),
                                                           matrix, quality, alloc);
     if (!state) {
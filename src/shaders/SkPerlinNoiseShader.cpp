@@ -12,7 +12,11 @@
 #include "include/core/SkString.h"
 #include "include/core/SkUnPreMultiply.h"
 #include "src/core/SkArenaAlloc.h"
+#include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkColorSpaceXformSteps.h"
+#include "src/core/SkEffectPriv.h"
 #include "src/core/SkMatrixProvider.h"
+#include "src/core/SkRasterPipeline.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkWriteBuffer.h"
 
@@ -164,6 +168,9 @@ public:
             memcpy(fLatticeSelector, that.fLatticeSelector, sizeof(fLatticeSelector));
             memcpy(fNoise, that.fNoise, sizeof(fNoise));
             memcpy(fGradient, that.fGradient, sizeof(fGradient));
+            memcpy(fLatticeSelectorF, that.fLatticeSelectorF, sizeof(fLatticeSelectorF));
+            memcpy(fGradientX, that.fGradientX, sizeof(fGradientX));
+            memcpy(fGradientY, that.fGradientY, sizeof(fGradientY));
         }
     #endif
 
@@ -171,6 +178,11 @@ public:
         uint8_t     fLatticeSelector[kBlockSize];
         uint16_t    fNoise[4][kBlockSize][2];
         SkPoint     fGradient[4][kBlockSize];
+        // The same tables as flat float arrays, the layout the perlin_noise raster pipeline
+        // stage gathers from.
+        float       fLatticeSelectorF[kBlockSize];
+        float       fGradientX[4][kBlockSize];
+        float       fGradientY[4][kBlockSize];
         SkISize     fTileSize;
         SkVector    fBaseFrequency;
         StitchData  fStitchDataInit;
@@ -262,8 +274,13 @@ public:
                                                    (fGradient[channel][i].fX + 1) * gHalfMax16bits);
                     fNoise[channel][i][1] = SkScalarRoundToInt(
                                                    (fGradient[channel][i].fY + 1) * gHalfMax16bits);
+                    fGradientX[channel][i] = fGradient[channel][i].fX;
+                    fGradientY[channel][i] = fGradient[channel][i].fY;
                 }
             }
+            for (int i = 0; i < kBlockSize; ++i) {
+                fLatticeSelectorF[i] = fLatticeSelector[i];
+            }
         }
 
         // Only called once. Could be part of the constructor.
@@ -371,6 +388,7 @@ public:
 
 protected:
     void flatten(SkWriteBuffer&) const override;
+    bool onAppendStages(const SkStageRec&) const override;
 #ifdef SK_ENABLE_LEGACY_SHADERCONTEXT
     Context* onMakeContext(const ContextRec&, SkArenaAlloc*) const override;
 #endif
@@ -693,6 +711,46 @@ void SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shadeSpan(
     }
 }
 
+bool SkPerlinNoiseShaderImpl::onAppendStages(const SkStageRec& rec) const {
+    // Stitched tiles wrap the lattice coordinates per octave, and improved noise is a different
+    // algorithm entirely; both stay on the legacy shader-context path.
+    if (kImprovedNoise_Type == fType || fStitchTiles) {
+        return this->INHERITED::onAppendStages(rec);
+    }
+
+    SkMatrix totalMatrix = SkMatrix::Concat(rec.fMatrixProvider.localToDevice(),
+                                            this->getLocalMatrix());
+    if (rec.fLocalM) {
+        totalMatrix.preConcat(*rec.fLocalM);
+    }
+
+    auto* paintingData = rec.fAlloc->make<PaintingData>(fTileSize, fSeed, fBaseFrequencyX,
+                                                        fBaseFrequencyY, totalMatrix);
+
+    auto* ctx = rec.fAlloc->make<SkRasterPipeline_PerlinNoiseCtx>();
+    ctx->latticeSelector = paintingData->fLatticeSelectorF;
+    for (int channel = 0; channel < 4; ++channel) {
+        ctx->gradientX[channel] = paintingData->fGradientX[channel];
+        ctx->gradientY[channel] = paintingData->fGradientY[channel];
+    }
+    ctx->baseFrequencyX = paintingData->fBaseFrequency.fX;
+    ctx->baseFrequencyY = paintingData->fBaseFrequency.fY;
+    // The same WebKit-inherited (1,1) translation the legacy shader context applies; only the
+    // translation of the total matrix feeds the noise, the scale is folded into the frequency.
+    ctx->translateX = -totalMatrix.getTranslateX() + SK_Scalar1;
+    ctx->translateY = -totalMatrix.getTranslateY() + SK_Scalar1;
+    ctx->numOctaves = fNumOctaves;
+    ctx->fractal = kFractalNoise_Type == fType;
+
+    rec.fPipeline->append(SkRasterPipeline::seed_shader);
+    rec.fPipeline->append(SkRasterPipeline::perlin_noise, ctx);
+    // The legacy context shades in sRGB; keep that interpretation for the fused stage too.
+    rec.fAlloc->make<SkColorSpaceXformSteps>(sk_srgb_singleton(), kPremul_SkAlphaType,
+                                             rec.fDstCS,          kPremul_SkAlphaType)
+        ->apply(rec.fPipeline);
+    return true;
+}
+
 /////////////////////////////////////////////////////////////////////
 
 #if SK_SUPPORT_GPU
@@ -249,10 +249,10 @@ skvm::Coord SkShaderBase::ApplyMatrix(skvm::Builder* p, const SkMatrix& m,
               y = coord.y;
     if (m.isIdentity()) {
         // That was easy.
-    } else if (m.isTranslate()) {
-        x = p->add(x, p->uniformF(uniforms->pushF(m[2])));
-        y = p->add(y, p->uniformF(uniforms->pushF(m[5])));
     } else if (m.isScaleTranslate()) {
+        // Translate-only matrices take this same two-mad shape (with scale
+        // uniforms of 1.0) so that animating a translation doesn't flip the
+        // program between shapes and miss SkVMBlitter's program cache.
         x = p->mad(x, p->uniformF(uniforms->pushF(m[0])), p->uniformF(uniforms->pushF(m[2])));
         y = p->mad(y, p->uniformF(uniforms->pushF(m[4])), p->uniformF(uniforms->pushF(m[5])));
     } else {  // Affine or perspective.
@@ -323,18 +323,44 @@ bool SkGradientShaderBase::onAppendStages(const SkStageRec& rec) const {
                           : SkPMColor4f{ c.fR, c.fG, c.fB, c.fA };
     };
 
+    bool ditherFused = false;
+
     // The two-stop case with stops at 0 and 1.
     if (fColorCount == 2 && fOrigPos == nullptr) {
         const SkPMColor4f c_l = prepareColor(0),
                           c_r = prepareColor(1);
 
-        // See F and B below.
-        auto ctx = alloc->make<SkRasterPipeline_EvenlySpaced2StopGradientCtx>();
-        (Sk4f::Load(c_r.vec()) - Sk4f::Load(c_l.vec())).store(ctx->f);
-        (                        Sk4f::Load(c_l.vec())).store(ctx->b);
-        ctx->interpolatedInPremul = premulGrad;
+#if !defined(SK_LATE_DITHER)
+        // When this gradient is the paint's shader (so its output feeds the blitter directly,
+        // with no color filter or paint alpha in between), fuse the lerp, premultiply, and
+        // ordered dither into one stage. The blitter notices the fused stage in the pipeline
+        // and skips its own dither. Two-stop dithered gradients are by far the most common
+        // gradient draw, so this saves two full trips through the pipeline loop per pixel.
+        const float ditherRate = rec.fPaint.getShader() == this && rec.fPaint.isDither() &&
+                                 !rec.fPaint.getColorFilter() && rec.fPaint.getAlphaf() == 1.0f
+                                         ? SkDitherRate(rec.fDstColorType)
+                                         : 0.0f;
+#else
+        const float ditherRate = 0.0f;
+#endif
+        if (ditherRate > 0.0f) {
+            auto ctx = alloc->make<SkRasterPipeline_EvenlySpaced2StopGradientDitherCtx>();
+            (Sk4f::Load(c_r.vec()) - Sk4f::Load(c_l.vec())).store(ctx->f);
+            (                        Sk4f::Load(c_l.vec())).store(ctx->b);
+            ctx->rate = ditherRate;
+            ctx->premul = !premulGrad && !this->colorsAreOpaque();
+            ditherFused = true;
+
+            p->append(SkRasterPipeline::evenly_spaced_2_stop_gradient_dither, ctx);
+        } else {
+            // See F and B below.
+            auto ctx = alloc->make<SkRasterPipeline_EvenlySpaced2StopGradientCtx>();
+            (Sk4f::Load(c_r.vec()) - Sk4f::Load(c_l.vec())).store(ctx->f);
+            (                        Sk4f::Load(c_l.vec())).store(ctx->b);
+            ctx->interpolatedInPremul = premulGrad;
 
-        p->append(SkRasterPipeline::evenly_spaced_2_stop_gradient, ctx);
+            p->append(SkRasterPipeline::evenly_spaced_2_stop_gradient, ctx);
+        }
     } else {
         auto* ctx = alloc->make<SkRasterPipeline_GradientCtx>();
         ctx->interpolatedInPremul = premulGrad;
@@ -410,7 +436,7 @@ bool SkGradientShaderBase::onAppendStages(const SkStageRec& rec) const {
         p->append(SkRasterPipeline::check_decal_mask, decal_ctx);
     }
 
-    if (!premulGrad && !this->colorsAreOpaque()) {
+    if (!premulGrad && !this->colorsAreOpaque() && !ditherFused) {
         p->append(SkRasterPipeline::premul);
     }
 
@@ -89,6 +89,7 @@ static const uint8_t* DisassembleInstruction(const uint8_t* ip) {
         DISASSEMBLE_COUNT(kDivideU, "divideu")
         DISASSEMBLE_COUNT(kDup, "dup")
         DISASSEMBLE_COUNT(kFloor, "floor")
+        DISASSEMBLE_COUNT(kFMA, "fma")
         DISASSEMBLE_COUNT(kFract, "fract")
         case ByteCodeInstruction::kInverse2x2: printf("inverse2x2"); break;
         case ByteCodeInstruction::kInverse3x3: printf("inverse3x3"); break;
@@ -492,6 +493,18 @@ static bool InnerRun(const ByteCode* byteCode, const ByteCodeFunction* f, VValue
             } continue;
 
             VECTOR_UNARY_FN(kFloor, skvx::floor, fFloat)
+
+            case ByteCodeInstruction::kFMA: {
+                int count = READ8();
+                VValue* C = sp - count + 1,
+                      * B = C - count,
+                      * A = B - count;
+                for (int i = count; i --> 0; ) {
+                    A[i].fFloat = skvx::fma(A[i].fFloat, B[i].fFloat, C[i].fFloat);
+                }
+                sp -= 2 * count;
+            } continue;
+
             VECTOR_UNARY_FN(kFract, skvx::fract, fFloat)
 
             case ByteCodeInstruction::kInverse2x2:
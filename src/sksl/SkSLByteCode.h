@@ -61,6 +61,8 @@ enum class ByteCodeInstruction : uint16_t {
     // Duplicates the top N stack values
     kDup,    // N
     kFloor,  // N
+    // A1, A2, .., B1, B2, .., C1, C2, .. -> A1*B1+C1, A2*B2+C2, ..
+    kFMA,    // N
     kFract,  // N
     kInverse2x2,
     kInverse3x3,
@@ -392,6 +392,9 @@ int ByteCodeGenerator::StackUsage(ByteCodeInstruction inst, int count_) {
         // kLerp works the same way (producing lerp(A, B, T) for each component)
         case ByteCodeInstruction::kLerp:  return -(2 * count);
 
+        // So does kFMA (producing A*B + C for each component)
+        case ByteCodeInstruction::kFMA:  return -(2 * count);
+
         // kCall is net-zero. Max stack depth is adjusted in writeFunctionCall.
         case ByteCodeInstruction::kCall:             return 0;
         case ByteCodeInstruction::kBranch:           return 0;
@@ -682,6 +685,27 @@ bool ByteCodeGenerator::writeBinaryExpression(const BinaryExpression& b, bool di
     }
     const Type& lType = b.fLeft->fType;
     const Type& rType = b.fRight->fType;
+    // Fuse (a * b) + c into a single kFMA, which the interpreter maps to the vector fma. Only the
+    // simple slot-wise case is handled: every operand must cover the same slots (so no scalar
+    // splatting is needed) and the multiply must not be a matrix product. The multiply must also be
+    // the left operand, so that a, b, c are still evaluated in source order.
+    if (b.fOperator == Token::Kind::TK_PLUS && type_category(b.fType) == TypeCategory::kFloat &&
+        b.fLeft->fKind == Expression::kBinary_Kind) {
+        const BinaryExpression& mul = (const BinaryExpression&) *b.fLeft;
+        int count = SlotCount(b.fType);
+        if (mul.fOperator == Token::Kind::TK_STAR &&
+            mul.fLeft->fType.kind() != Type::kMatrix_Kind &&
+            mul.fRight->fType.kind() != Type::kMatrix_Kind &&
+            SlotCount(mul.fLeft->fType) == count &&
+            SlotCount(mul.fRight->fType) == count &&
+            SlotCount(rType) == count) {
+            this->writeExpression(*mul.fLeft);
+            this->writeExpression(*mul.fRight);
+            this->writeExpression(*b.fRight);
+            this->write(ByteCodeInstruction::kFMA, count);
+            return discard;
+        }
+    }
     bool lVecOrMtx = (lType.kind() == Type::kVector_Kind || lType.kind() == Type::kMatrix_Kind);
     bool rVecOrMtx = (rType.kind() == Type::kVector_Kind || rType.kind() == Type::kMatrix_Kind);
     Token::Kind op;
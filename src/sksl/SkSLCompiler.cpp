@@ -7,6 +7,8 @@
 
 #include "src/sksl/SkSLCompiler.h"
 
+#include <chrono>
+#include <map>
 #include <memory>
 
 #include "src/sksl/SkSLByteCodeGenerator.h"
@@ -37,6 +39,10 @@
 #include "src/gpu/GrShaderCaps.h"
 #endif
 
+#ifndef SKSL_STANDALONE
+#include "src/core/SkTraceEvent.h"
+#endif
+
 #ifdef SK_ENABLE_SPIRV_VALIDATION
 #include "spirv-tools/libspirv.hpp"
 #endif
@@ -81,6 +87,28 @@ static const char* SKSL_PIPELINE_INCLUDE =
 
 namespace SkSL {
 
+// Each cached program pins its IR pool, so keep the program cache bounded; it is simply emptied
+// when full, since hitting the limit at all is rare.
+static constexpr size_t kMaxProgramCacheEntries = 64;
+
+static int64_t now_micros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+namespace {
+// Accumulates the wall-clock lifetime of a scope into a Compiler::Stats field.
+class AutoStatsTimer {
+public:
+    AutoStatsTimer(int64_t* target) : fTarget(target), fStart(now_micros()) {}
+    ~AutoStatsTimer() { *fTarget += now_micros() - fStart; }
+
+private:
+    int64_t* fTarget;
+    int64_t fStart;
+};
+}  // namespace
+
 static void grab_intrinsics(std::vector<std::unique_ptr<ProgramElement>>* src,
                std::map<String, std::pair<std::unique_ptr<ProgramElement>, bool>>* target) {
     for (auto iter = src->begin(); iter != src->end(); ) {
@@ -1532,10 +1560,79 @@ const Symbol* Compiler::takeOwnership(std::unique_ptr<const Symbol> symbol) {
     return fIRGenerator->fRootSymbolTable->takeOwnershipOfSymbol(std::move(symbol));
 }
 
+String Compiler::MakeProgramCacheKey(Program::Kind kind, const String& text,
+                                     const Program::Settings& settings) {
+    String key;
+    key.appendf("%d|%p|%d%d%d%d%d%d|%d|%d|%d|", (int) kind, settings.fCaps,
+                settings.fFlipY, settings.fInverseW, settings.fFragColorIsInOut,
+                settings.fReplaceSettings, settings.fForceHighPrecision,
+                settings.fSharpenTextures, settings.fRTHeightOffset, settings.fRTHeightBinding,
+                settings.fRTHeightSet);
+    key.appendf("%d|", settings.fRemoveDeadFunctions);
+    key.appendf("%d|", settings.fInlineThreshold);
+    // fFunctionHotness is unordered; sort the entries so equal settings produce equal keys.
+    std::map<String, int> sortedHotness(settings.fFunctionHotness.begin(),
+                                        settings.fFunctionHotness.end());
+    for (const auto& pair : sortedHotness) {
+        key += pair.first;
+        key.appendf("=%d;", pair.second);
+    }
+    key += "|";
+    // fArgs is unordered; sort the entries so equal settings produce equal keys.
+    std::map<String, Program::Settings::Value> sortedArgs(settings.fArgs.begin(),
+                                                          settings.fArgs.end());
+    for (const auto& pair : sortedArgs) {
+        key += pair.first;
+        if (pair.second.fKind == Program::Settings::Value::kFloat_Kind) {
+            key.appendf("=%d:%f;", (int) pair.second.fKind, pair.second.fValueF);
+        } else {
+            key.appendf("=%d:%d;", (int) pair.second.fKind, pair.second.fValue);
+        }
+    }
+    key += "|";
+    key += text;
+    return key;
+}
+
+std::unique_ptr<Program> Compiler::cloneProgram(const std::shared_ptr<Program>& original) {
+    std::unique_ptr<Pool> pool = Pool::Create();
+    pool->attachToThread();
+    std::vector<std::unique_ptr<ProgramElement>> elements;
+    elements.reserve(original->fElements.size());
+    for (const auto& element : original->fElements) {
+        elements.push_back(element->clone());
+    }
+    auto result = std::make_unique<Program>(original->fKind,
+                                            std::make_unique<String>(*original->fSource),
+                                            original->fSettings,
+                                            original->fContext,
+                                            original->fInheritedElements,
+                                            std::move(elements),
+                                            original->fSymbols,
+                                            original->fInputs);
+    result->fIsOptimized = original->fIsOptimized;
+    result->fCloneSource = original;
+    result->fPool = std::move(pool);
+    result->fPool->detachFromThread();
+    return result;
+}
+
 std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String text,
                                                   const Program::Settings& settings) {
     fErrorText = "";
     fErrorCount = 0;
+#ifndef SKSL_STANDALONE
+    TRACE_EVENT0("skia.gpu", "SkSL::Compiler::convertProgram");
+#endif
+    // Pipeline-variant churn compiles the same effect many times over; hand out a clone of the
+    // memoized optimized program when we have one, skipping the front end entirely.
+    String cacheKey = MakeProgramCacheKey(kind, text, settings);
+    auto cached = fProgramCache.find(cacheKey);
+    if (cached != fProgramCache.end()) {
+        ++fStats.fCacheHitCount;
+        return this->cloneProgram(cached->second);
+    }
+    int64_t frontEndStart = now_micros();
     std::vector<std::unique_ptr<ProgramElement>>* inherited;
     std::vector<std::unique_ptr<ProgramElement>> elements;
     switch (kind) {
@@ -1596,6 +1693,10 @@ std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String tex
             fIRGenerator->start(&settings, inherited);
             break;
     }
+    // The include modules above are compiled without a pool and live on the heap; only the
+    // user program's IR nodes are pooled.
+    std::unique_ptr<Pool> pool = Pool::Create();
+    pool->attachToThread();
     std::unique_ptr<String> textPtr(new String(std::move(text)));
     fSource = textPtr.get();
     fIRGenerator->convertProgram(kind, textPtr->c_str(), textPtr->size(), &elements);
@@ -1607,6 +1708,87 @@ std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String tex
                                             std::move(elements),
                                             fIRGenerator->fSymbolTable,
                                             fIRGenerator->fInputs);
+    result->fPool = std::move(pool);
+    result->fPool->detachFromThread();
+    // Drop our reference to the program's symbol table; its symbols live in the program's pool,
+    // so it must not outlive the program.
+    fIRGenerator->fSymbolTable = nullptr;
+    fStats.fFrontEndMicros += now_micros() - frontEndStart;
+    ++fStats.fCompileCount;
+    int nodeCount = 0;
+    for (const auto& e : result->ownedElements()) {
+        if (e->fKind == ProgramElement::kFunction_Kind) {
+            nodeCount += ((const FunctionDefinition&) *e).fBody->nodeCount();
+        }
+    }
+    fStats.fPeakNodeCount = std::max(fStats.fPeakNodeCount, nodeCount);
+    if (fErrorCount) {
+        return nullptr;
+    }
+    // Optimize before caching so later cache hits skip that work as well.
+    if (!this->optimize(*result)) {
+        return nullptr;
+    }
+    if (fProgramCache.size() >= kMaxProgramCacheEntries) {
+        fProgramCache.clear();
+    }
+    std::shared_ptr<Program> original(result.release());
+    fProgramCache.insert({std::move(cacheKey), original});
+    return this->cloneProgram(original);
+}
+
+std::unique_ptr<Program> Compiler::rehydrateProgram(Program::Kind kind, const uint8_t* data,
+                                                    size_t length,
+                                                    const Program::Settings& settings) {
+    fErrorText = "";
+    fErrorCount = 0;
+    std::vector<std::unique_ptr<ProgramElement>>* inherited;
+    std::shared_ptr<SymbolTable> base;
+    switch (kind) {
+        case Program::kVertex_Kind:
+            inherited = &fVertexInclude;
+            base = fVertexSymbolTable;
+            break;
+        case Program::kFragment_Kind:
+            inherited = &fFragmentInclude;
+            base = fFragmentSymbolTable;
+            break;
+        case Program::kGeometry_Kind:
+            this->loadGeometryIntrinsics();
+            inherited = &fGeometryInclude;
+            base = fGeometrySymbolTable;
+            break;
+        case Program::kPipelineStage_Kind:
+            this->loadPipelineIntrinsics();
+            inherited = &fPipelineInclude;
+            base = fPipelineSymbolTable;
+            break;
+        case Program::kGeneric_Kind:
+            this->loadInterpreterIntrinsics();
+            inherited = &fInterpreterInclude;
+            base = fInterpreterSymbolTable;
+            break;
+        default:
+            this->error(-1, "unsupported program kind for rehydration");
+            return nullptr;
+    }
+    std::unique_ptr<Pool> pool = Pool::Create();
+    pool->attachToThread();
+    Rehydrator rehydrator(fContext.get(), base, this, data, length);
+    std::shared_ptr<SymbolTable> symbols = rehydrator.symbolTable();
+    std::vector<std::unique_ptr<ProgramElement>> elements = rehydrator.elements();
+    Program::Inputs inputs;
+    inputs.reset();
+    auto result = std::make_unique<Program>(kind,
+                                            nullptr,
+                                            settings,
+                                            fContext,
+                                            inherited,
+                                            std::move(elements),
+                                            std::move(symbols),
+                                            inputs);
+    result->fPool = std::move(pool);
+    result->fPool->detachFromThread();
     if (fErrorCount) {
         return nullptr;
     }
@@ -1616,7 +1798,12 @@ std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String tex
 bool Compiler::optimize(Program& program) {
     SkASSERT(!fErrorCount);
     if (!program.fIsOptimized) {
+        AutoStatsTimer timer(&fStats.fOptimizeMicros);
         program.fIsOptimized = true;
+        // Nodes created (and destroyed) during optimization should use the program's pool.
+        if (program.fPool) {
+            program.fPool->attachToThread();
+        }
         fIRGenerator->fKind = program.fKind;
         fIRGenerator->fSettings = &program.fSettings;
         for (auto& element : program) {
@@ -1658,6 +1845,9 @@ bool Compiler::optimize(Program& program) {
                 ++iter;
             }
         }
+        if (program.fPool) {
+            program.fPool->detachFromThread();
+        }
     }
     return fErrorCount == 0;
 }
@@ -1692,6 +1882,7 @@ bool Compiler::toSPIRV(Program& program, OutputStream& out) {
     if (!this->optimize(program)) {
         return false;
     }
+    AutoStatsTimer timer(&fStats.fCodeGenMicros);
 #ifdef SK_ENABLE_SPIRV_VALIDATION
     StringStream buffer;
     fSource = program.fSource.get();
@@ -1725,6 +1916,7 @@ bool Compiler::toSPIRV(Program& program, String* out) {
     bool result = this->toSPIRV(program, buffer);
     if (result) {
         *out = buffer.str();
+        fStats.fCodeGenBytes += out->size();
     }
     return result;
 }
@@ -1733,6 +1925,7 @@ bool Compiler::toGLSL(Program& program, OutputStream& out) {
     if (!this->optimize(program)) {
         return false;
     }
+    AutoStatsTimer timer(&fStats.fCodeGenMicros);
     fSource = program.fSource.get();
     GLSLCodeGenerator cg(fContext.get(), &program, this, &out);
     bool result = cg.generateCode();
@@ -1745,6 +1938,7 @@ bool Compiler::toGLSL(Program& program, String* out) {
     bool result = this->toGLSL(program, buffer);
     if (result) {
         *out = buffer.str();
+        fStats.fCodeGenBytes += out->size();
     }
     return result;
 }
@@ -1762,6 +1956,7 @@ bool Compiler::toMetal(Program& program, OutputStream& out) {
     if (!this->optimize(program)) {
         return false;
     }
+    AutoStatsTimer timer(&fStats.fCodeGenMicros);
     MetalCodeGenerator cg(fContext.get(), &program, this, &out);
     bool result = cg.generateCode();
     return result;
@@ -1775,6 +1970,7 @@ bool Compiler::toMetal(Program& program, String* out) {
     bool result = this->toMetal(program, buffer);
     if (result) {
         *out = buffer.str();
+        fStats.fCodeGenBytes += out->size();
     }
     return result;
 }
@@ -1783,6 +1979,7 @@ bool Compiler::toCPP(Program& program, String name, OutputStream& out) {
     if (!this->optimize(program)) {
         return false;
     }
+    AutoStatsTimer timer(&fStats.fCodeGenMicros);
     fSource = program.fSource.get();
     CPPCodeGenerator cg(fContext.get(), &program, this, name, &out);
     bool result = cg.generateCode();
@@ -1794,6 +1991,7 @@ bool Compiler::toH(Program& program, String name, OutputStream& out) {
     if (!this->optimize(program)) {
         return false;
     }
+    AutoStatsTimer timer(&fStats.fCodeGenMicros);
     fSource = program.fSource.get();
     HCodeGenerator cg(fContext.get(), &program, this, name, &out);
     bool result = cg.generateCode();
@@ -1806,6 +2004,7 @@ bool Compiler::toH(Program& program, String name, OutputStream& out) {
 #if !defined(SKSL_STANDALONE) && SK_SUPPORT_GPU
 bool Compiler::toPipelineStage(const Program& program, PipelineStageArgs* outArgs) {
     SkASSERT(program.fIsOptimized);
+    AutoStatsTimer timer(&fStats.fCodeGenMicros);
     fSource = program.fSource.get();
     StringStream buffer;
     PipelineStageCodeGenerator cg(fContext.get(), &program, this, &buffer, outArgs);
@@ -1813,6 +2012,7 @@ bool Compiler::toPipelineStage(const Program& program, PipelineStageArgs* outArg
     fSource = nullptr;
     if (result) {
         outArgs->fCode = buffer.str();
+        fStats.fCodeGenBytes += outArgs->fCode.size();
     }
     return result;
 }
@@ -1823,6 +2023,7 @@ std::unique_ptr<ByteCode> Compiler::toByteCode(Program& program) {
     if (!this->optimize(program)) {
         return nullptr;
     }
+    AutoStatsTimer timer(&fStats.fCodeGenMicros);
     fSource = program.fSource.get();
     std::unique_ptr<ByteCode> result(new ByteCode());
     ByteCodeGenerator cg(fContext.get(), &program, this, result.get());
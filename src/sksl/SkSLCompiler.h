@@ -126,6 +126,15 @@ public:
     std::unique_ptr<Program> convertProgram(Program::Kind kind, String text,
                                             const Program::Settings& settings);
 
+    /**
+     * Reconstitutes a program which was dehydrated ahead of time (by skslc; see the '.dehydrated'
+     * output mode in SkSLMain.cpp), skipping parsing and IR generation entirely. data must remain
+     * in memory as long as the returned program does. The program is not yet optimized, so callers
+     * get the same specialize/optimize flexibility as with convertProgram.
+     */
+    std::unique_ptr<Program> rehydrateProgram(Program::Kind kind, const uint8_t* data,
+                                              size_t length, const Program::Settings& settings);
+
     bool optimize(Program& program);
 
     std::unique_ptr<Program> specialize(Program& program,
@@ -155,6 +164,22 @@ public:
     bool toPipelineStage(const Program& program, PipelineStageArgs* outArgs);
 #endif
 
+    /**
+     * Cumulative instrumentation for this compiler instance, for attributing time and memory to
+     * shader compilation in production traces. Times are wall-clock microseconds.
+     */
+    struct Stats {
+        int     fCompileCount = 0;    // programs converted from source (program cache hits excluded)
+        int     fCacheHitCount = 0;   // programs served from the program cache
+        int64_t fFrontEndMicros = 0;  // lex, parse, and IR generation
+        int64_t fOptimizeMicros = 0;
+        int64_t fCodeGenMicros = 0;   // backend code generation, all output formats
+        int     fPeakNodeCount = 0;   // IR size of the largest single program
+        size_t  fCodeGenBytes = 0;    // total size of generated backend code
+    };
+
+    const Stats& stats() const { return fStats; }
+
     /**
      * Takes ownership of the given symbol. It will be destroyed when the compiler is destroyed.
      */
@@ -226,6 +251,18 @@ private:
 
     Position position(int offset);
 
+    /**
+     * Returns a key for the program cache covering everything that affects the generated IR.
+     */
+    static String MakeProgramCacheKey(Program::Kind kind, const String& text,
+                                      const Program::Settings& settings);
+
+    /**
+     * Returns a fresh Program owning clones of the cached program's elements. The clone shares
+     * the original's symbols and keeps the original alive (see Program::fCloneSource).
+     */
+    std::unique_ptr<Program> cloneProgram(const std::shared_ptr<Program>& original);
+
     std::shared_ptr<SymbolTable> fGpuSymbolTable;
     std::map<String, std::pair<std::unique_ptr<ProgramElement>, bool>> fGPUIntrinsics;
     std::map<String, std::pair<std::unique_ptr<ProgramElement>, bool>> fInterpreterIntrinsics;
@@ -251,6 +288,12 @@ private:
     std::shared_ptr<Context> fContext;
     int fErrorCount;
     String fErrorText;
+
+    // Memoizes convertProgram: identical (kind, source, settings) requests get a clone of the
+    // cached optimized program rather than re-running the front end.
+    std::unordered_map<String, std::shared_ptr<Program>> fProgramCache;
+
+    Stats fStats;
 };
 
 #if !defined(SKSL_STANDALONE) && SK_SUPPORT_GPU
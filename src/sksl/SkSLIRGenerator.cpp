@@ -8,6 +8,7 @@
 #include "src/sksl/SkSLIRGenerator.h"
 
 #include "limits.h"
+#include <limits>
 #include <memory>
 #include <unordered_set>
 
@@ -2337,6 +2338,20 @@ void IRGenerator::copyIntrinsicIfNeeded(const FunctionDeclaration& function) {
     }
 }
 
+int IRGenerator::inlineThreshold(const FunctionDeclaration& function) const {
+    int threshold = fSettings->fInlineThreshold;
+    auto hotness = fSettings->fFunctionHotness.find(function.fName);
+    if (hotness != fSettings->fFunctionHotness.end()) {
+        threshold *= hotness->second;
+    }
+    // A call inside a loop pays its overhead on every iteration, so treat it as hot even without
+    // profile data.
+    if (fLoopLevel > 0) {
+        threshold *= 4;
+    }
+    return threshold;
+}
+
 std::unique_ptr<Expression> IRGenerator::call(int offset,
                                               const FunctionDeclaration& function,
                                               std::vector<std::unique_ptr<Expression>> arguments) {
@@ -2390,7 +2405,8 @@ std::unique_ptr<Expression> IRGenerator::call(int offset,
                              VariableReference::kPointer_RefKind);
         }
     }
-    if (fCanInline && function.fDefinition && function.fDefinition->canBeInlined() &&
+    if (fCanInline && function.fDefinition &&
+        function.fDefinition->canBeInlined(this->inlineThreshold(function)) &&
         ((fSettings->fCaps && fSettings->fCaps->canUseDoLoops()) ||
          !has_early_return(*function.fDefinition))) {
         return this->inlineCall(offset, *function.fDefinition, std::move(arguments));
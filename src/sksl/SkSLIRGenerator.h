@@ -99,6 +99,7 @@ private:
                                                const Statement& statement);
     std::unique_ptr<Expression> inlineCall(int offset, const FunctionDefinition& function,
                                            std::vector<std::unique_ptr<Expression>> arguments);
+    int inlineThreshold(const FunctionDeclaration& function) const;
     std::unique_ptr<Expression> call(int offset,
                                      const FunctionDeclaration& function,
                                      std::vector<std::unique_ptr<Expression>> arguments);
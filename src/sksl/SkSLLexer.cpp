@@ -9,6 +9,14 @@
  *****************************************************************************************/
 #include "src/sksl/SkSLLexer.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKSL_LEXER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define SKSL_LEXER_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace SkSL {
 
 static const uint8_t INVALID_CHAR = 18;
@@ -1033,6 +1041,127 @@ static int8_t accepts[310] = {
         43, 43, 43, 28, 48, 63, 88, 67, 91, 49, 66,
 };
 
+static bool is_whitespace_char(uint8_t c) {
+    return ' ' == c || '\t' == c || '\n' == c || '\r' == c;
+}
+
+static bool is_identifier_char(uint8_t c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || '_' == c;
+}
+
+enum class FastScanClass : int8_t {
+    kNone,
+    kWhitespace,
+    kIdentifier,
+};
+
+static bool state_loops_over(int16_t state, bool (*contains)(uint8_t)) {
+    for (int c = 9; c < (int)(sizeof(mappings) / sizeof(mappings[0])); ++c) {
+        if (contains((uint8_t)c) && transitions[mappings[c]][state] != state) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Records, for each DFA state, a character class over which the state always transitions back
+// to itself. A run of such characters cannot change the DFA's state, so next() may consume the
+// run in bulk without consulting the transition table. Whitespace runs and identifier tails
+// account for most of the characters in a typical program.
+struct FastScanTable {
+    FastScanTable() {
+        for (size_t state = 0; state < sizeof(accepts) / sizeof(accepts[0]); ++state) {
+            if (state_loops_over((int16_t)state, is_whitespace_char)) {
+                fClass[state] = FastScanClass::kWhitespace;
+            } else if (state_loops_over((int16_t)state, is_identifier_char)) {
+                fClass[state] = FastScanClass::kIdentifier;
+            } else {
+                fClass[state] = FastScanClass::kNone;
+            }
+        }
+    }
+
+    FastScanClass fClass[sizeof(accepts) / sizeof(accepts[0])];
+};
+
+static const FastScanTable gFastScanTable;
+
+// Consumes whole 16-byte blocks of characters belonging to fastClass and returns the new
+// offset. Any partial block at the end of the run is left for the table-driven loop in next().
+static int32_t skip_fast_scan_run(const char* text, int32_t offset, int32_t length,
+                                  FastScanClass fastClass) {
+#if SKSL_LEXER_SSE2
+    while (length - offset >= 16) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + offset));
+        __m128i inClass;
+        if (FastScanClass::kWhitespace == fastClass) {
+            inClass = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),
+                                 _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')),
+                                 _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r'))));
+        } else {
+            // Characters at or above 0x80 compare as negative and so correctly fail these
+            // signed range checks.
+            __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)),
+                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('z' + 1)));
+            __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)),
+                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+            __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+            __m128i under = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));
+            inClass = _mm_or_si128(_mm_or_si128(lower, upper), _mm_or_si128(digit, under));
+        }
+        if (_mm_movemask_epi8(inClass) != 0xFFFF) {
+            break;
+        }
+        offset += 16;
+    }
+#elif SKSL_LEXER_NEON
+    while (length - offset >= 16) {
+        uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(text + offset));
+        uint8x16_t inClass;
+        if (FastScanClass::kWhitespace == fastClass) {
+            inClass = vorrq_u8(vorrq_u8(vceqq_u8(chars, vdupq_n_u8(' ')),
+                                        vceqq_u8(chars, vdupq_n_u8('\n'))),
+                               vorrq_u8(vceqq_u8(chars, vdupq_n_u8('\t')),
+                                        vceqq_u8(chars, vdupq_n_u8('\r'))));
+        } else {
+            uint8x16_t lower = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('a')),
+                                        vcleq_u8(chars, vdupq_n_u8('z')));
+            uint8x16_t upper = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('A')),
+                                        vcleq_u8(chars, vdupq_n_u8('Z')));
+            uint8x16_t digit = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('0')),
+                                        vcleq_u8(chars, vdupq_n_u8('9')));
+            uint8x16_t under = vceqq_u8(chars, vdupq_n_u8('_'));
+            inClass = vorrq_u8(vorrq_u8(lower, upper), vorrq_u8(digit, under));
+        }
+        uint64x2_t folded = vreinterpretq_u64_u8(inClass);
+        if ((vgetq_lane_u64(folded, 0) & vgetq_lane_u64(folded, 1)) != ~0ULL) {
+            break;
+        }
+        offset += 16;
+    }
+#else
+    while (length - offset >= 16) {
+        bool allInClass = true;
+        for (int i = 0; i < 16; ++i) {
+            uint8_t c = (uint8_t)text[offset + i];
+            if (FastScanClass::kWhitespace == fastClass ? !is_whitespace_char(c)
+                                                        : !is_identifier_char(c)) {
+                allInClass = false;
+                break;
+            }
+        }
+        if (!allInClass) {
+            break;
+        }
+        offset += 16;
+    }
+#endif
+    return offset;
+}
+
 Token Lexer::next() {
     // note that we cheat here: normally a lexer needs to worry about the case
     // where a token has a prefix which is not itself a valid token - for instance,
@@ -1061,6 +1190,10 @@ Token Lexer::next() {
         }
         state = newState;
         ++fOffset;
+        FastScanClass fastClass = gFastScanTable.fClass[state];
+        if (FastScanClass::kNone != fastClass) {
+            fOffset = skip_fast_scan_run(fText, fOffset, fLength, fastClass);
+        }
     }
     Token::Kind kind = (Token::Kind)accepts[state];
     return Token(kind, startOffset, fOffset - startOffset);
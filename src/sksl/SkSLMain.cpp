@@ -187,8 +187,57 @@ int main(int argc, const char** argv) {
             printf("error writing '%s'\n", argv[2]);
             exit(4);
         }
+    } else if (name.endsWith(".dehydrated")) {
+        // Produces a self-contained binary IR form of a complete program, as opposed to the
+        // '.dehydrated.sksl' mode above, which handles the compiler's own include modules. The
+        // binary can be handed back to Compiler::rehydrateProgram (e.g. via SkRuntimeEffect::Make)
+        // to skip parsing and IR generation entirely.
+        SkSL::FileOutputStream out(argv[2]);
+        SkSL::Compiler compiler;
+        if (!out.isValid()) {
+            printf("error writing '%s'\n", argv[2]);
+            exit(4);
+        }
+        settings.fReplaceSettings = false;
+        std::unique_ptr<SkSL::Program> program = compiler.convertProgram(kind, text, settings);
+        if (!program) {
+            printf("%s", compiler.errorText().c_str());
+            exit(3);
+        }
+        // Fold every module table's owned symbols into a single flat table, so that the binary
+        // does not depend on the layout of the compiler's internal module tables. The root table
+        // is excluded: its mappings (the context's built-in types) are written by name and
+        // resolved against the reader's base table instead. The flat table only borrows the
+        // symbols, so it must release them again before it is destroyed.
+        SkSL::SymbolTable flat(&compiler);
+        std::vector<const SkSL::SymbolTable*> chain;
+        for (const SkSL::SymbolTable* t = program->fSymbols.get(); t && t->fParent;
+             t = t->fParent.get()) {
+            chain.push_back(t);
+        }
+        for (auto iter = chain.rbegin(); iter != chain.rend(); ++iter) {
+            for (const std::unique_ptr<const SkSL::Symbol>& s : (*iter)->fOwnedSymbols) {
+                flat.fOwnedSymbols.push_back(std::unique_ptr<const SkSL::Symbol>(s.get()));
+            }
+        }
+        size_t borrowed = flat.fOwnedSymbols.size();
+        for (const auto& p : *program->fSymbols) {
+            flat.addWithoutOwnership(p.first, p.second);
+        }
+        SkSL::Dehydrator dehydrator;
+        dehydrator.write(flat);
+        dehydrator.write(program->ownedElements());
+        dehydrator.finish(out);
+        for (size_t i = 0; i < borrowed; ++i) {
+            flat.fOwnedSymbols[i].release();
+        }
+        if (!out.close()) {
+            printf("error writing '%s'\n", argv[2]);
+            exit(4);
+        }
     } else {
-        printf("expected output filename to end with '.spirv', '.glsl', '.cpp', '.h', or '.metal'");
+        printf("expected output filename to end with '.spirv', '.glsl', '.cpp', '.h', '.metal', "
+               "or '.dehydrated'");
         exit(1);
     }
 }
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/sksl/SkSLPool.h"
+
+#include <cstdlib>
+
+#include "src/sksl/SkSLDefines.h"
+
+namespace SkSL {
+
+// The slot size must fit the largest IR node; anything bigger falls back to the heap. The slot
+// count is sized so that a mid-size program fits entirely in one pool.
+static constexpr size_t kNodeSlotSize = 256;
+static constexpr int kNodeSlots = 1024;
+
+struct PoolData {
+    // Unused slots are threaded onto a free list; each one holds a pointer to the next.
+    void* fFreeListHead = nullptr;
+    char  fNodes[kNodeSlots * kNodeSlotSize];
+
+    bool isInPool(const void* node) const {
+        return node >= fNodes && node < fNodes + sizeof(fNodes);
+    }
+};
+
+static thread_local PoolData* sPoolData = nullptr;
+
+Pool::~Pool() {
+    SkASSERT(sPoolData != fData);
+    delete fData;
+}
+
+std::unique_ptr<Pool> Pool::Create() {
+    auto pool = std::unique_ptr<Pool>(new Pool);
+    pool->fData = new PoolData;
+    void* head = nullptr;
+    for (int i = kNodeSlots - 1; i >= 0; --i) {
+        void* slot = pool->fData->fNodes + i * kNodeSlotSize;
+        *static_cast<void**>(slot) = head;
+        head = slot;
+    }
+    pool->fData->fFreeListHead = head;
+    return pool;
+}
+
+void Pool::attachToThread() {
+    SkASSERT(sPoolData == nullptr);
+    sPoolData = fData;
+}
+
+void Pool::detachFromThread() {
+    SkASSERT(sPoolData == fData);
+    sPoolData = nullptr;
+}
+
+void* Pool::AllocIRNode(size_t size) {
+    PoolData* pool = sPoolData;
+    if (pool && size <= kNodeSlotSize && pool->fFreeListHead) {
+        void* node = pool->fFreeListHead;
+        pool->fFreeListHead = *static_cast<void**>(node);
+        return node;
+    }
+    // No pool is attached, the node is too large for a slot, or the pool is exhausted.
+    return ::operator new(size);
+}
+
+void Pool::FreeIRNode(void* node) {
+    PoolData* pool = sPoolData;
+    if (pool && pool->isInPool(node)) {
+        *static_cast<void**>(node) = pool->fFreeListHead;
+        pool->fFreeListHead = node;
+        return;
+    }
+    // Nodes that do not belong to the attached pool were allocated from the heap. This relies on
+    // a program's nodes being destroyed only while its own pool is attached (see ~Program).
+    ::operator delete(node);
+}
+
+}  // namespace SkSL
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_POOL
+#define SKSL_POOL
+
+#include <cstddef>
+#include <memory>
+
+namespace SkSL {
+
+struct PoolData;
+
+/**
+ * Efficiently allocates memory for IR nodes. Rather than go through the system allocator for
+ * every node, nodes are handed out from a large block of fixed-size slots and recycled through a
+ * free list, so compiling a program performs a handful of large allocations instead of thousands
+ * of small ones. A pool is attached to a single thread at a time; while attached, IRNode's
+ * operator new and operator delete draw from it. Each Program owns the pool its nodes live in and
+ * re-attaches it while the nodes are destroyed.
+ */
+class Pool {
+public:
+    ~Pool();
+
+    // Creates a pool to hold IR nodes during program creation. Call attachToThread() to start
+    // allocating nodes from it.
+    static std::unique_ptr<Pool> Create();
+
+    // Attaches or detaches this pool from the current thread. Only one pool may be attached to a
+    // thread at a time.
+    void attachToThread();
+    void detachFromThread();
+
+    // Returns node storage from the attached pool, or from the heap if no pool is attached, the
+    // node is too large, or the pool is exhausted.
+    static void* AllocIRNode(size_t size);
+
+    // Releases storage that was previously returned by AllocIRNode. Nodes that did not come from
+    // the currently attached pool are passed on to the heap.
+    static void FreeIRNode(void* node);
+
+private:
+    Pool() = default;
+
+    PoolData* fData = nullptr;
+};
+
+}  // namespace SkSL
+
+#endif
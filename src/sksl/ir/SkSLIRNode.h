@@ -9,6 +9,7 @@
 #define SKSL_IRNODE
 
 #include "src/sksl/SkSLLexer.h"
+#include "src/sksl/SkSLPool.h"
 #include "src/sksl/SkSLString.h"
 
 namespace SkSL {
@@ -30,6 +31,16 @@ struct IRNode {
 
     virtual String description() const = 0;
 
+    // Allocate IR nodes from the memory pool attached to the program being compiled, when one
+    // exists; see SkSLPool.h.
+    static void* operator new(const size_t size) {
+        return Pool::AllocIRNode(size);
+    }
+
+    static void operator delete(void* node) {
+        Pool::FreeIRNode(node);
+    }
+
     // character offset of this element within the program being compiled, for error reporting
     // purposes
     int fOffset;
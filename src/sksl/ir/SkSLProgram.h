@@ -11,6 +11,7 @@
 #include <vector>
 #include <memory>
 
+#include "src/sksl/SkSLPool.h"
 #include "src/sksl/ir/SkSLBoolLiteral.h"
 #include "src/sksl/ir/SkSLExpression.h"
 #include "src/sksl/ir/SkSLFloatLiteral.h"
@@ -117,6 +118,14 @@ struct Program {
         // If true, remove any uncalled functions other than main(). Note that a function which
         // starts out being used may end up being uncalled after optimization.
         bool fRemoveDeadFunctions = true;
+        // Maximum size (in IR nodes) of a function body that is eligible for inlining. Calls
+        // inside loops are implicitly treated as hotter and get a larger budget.
+        int fInlineThreshold = 50;
+        // Optional per-function hotness weights, keyed by function name. A function with weight N
+        // may grow to N times fInlineThreshold before inlining is rejected; absent functions get a
+        // weight of 1. Clients that profile their shaders can feed call counts back through this
+        // table on the next compile.
+        std::unordered_map<String, int> fFunctionHotness;
 
         std::unordered_map<String, Value> fArgs;
     };
@@ -255,6 +264,20 @@ struct Program {
     , fInheritedElements(inheritedElements)
     , fElements(std::move(elements)) {}
 
+    ~Program() {
+        // The elements (and generally the owned symbols as well) live in fPool, if we have one;
+        // they must be destroyed while it is attached. The elements are cleared before the
+        // symbols because destroying elements can modify reference counts in symbols.
+        if (fPool) {
+            fPool->attachToThread();
+        }
+        fElements.clear();
+        fSymbols.reset();
+        if (fPool) {
+            fPool->detachFromThread();
+        }
+    }
+
     iterator begin() {
         if (fInheritedElements) {
             return iterator(fInheritedElements->begin(), fInheritedElements->end(),
@@ -287,6 +310,12 @@ struct Program {
         return const_iterator(fElements.end(), fElements.end(), fElements.end(), fElements.end());
     }
 
+    // Returns only the elements belonging to this program itself, excluding any inherited from
+    // include modules.
+    const std::vector<std::unique_ptr<ProgramElement>>& ownedElements() const {
+        return fElements;
+    }
+
     Kind fKind;
     std::unique_ptr<String> fSource;
     Settings fSettings;
@@ -300,6 +329,12 @@ struct Program {
 private:
     std::vector<std::unique_ptr<ProgramElement>>* fInheritedElements;
     std::vector<std::unique_ptr<ProgramElement>> fElements;
+    // The pool most of this program's IR nodes were allocated from, created by
+    // Compiler::convertProgram. Detached except while nodes are being created or destroyed.
+    std::unique_ptr<Pool> fPool;
+    // For programs handed out by the compiler's program cache: keeps the cached original alive,
+    // since our IR references its source text and its pool owns the shared symbols.
+    std::shared_ptr<Program> fCloneSource;
 
     friend class Compiler;
 };
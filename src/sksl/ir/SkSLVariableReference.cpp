@@ -95,9 +95,13 @@ std::unique_ptr<Expression> VariableReference::constantPropagate(const IRGenerat
     }
     if (irGenerator.fKind == Program::kPipelineStage_Kind &&
         fVariable.fStorage == Variable::kGlobal_Storage &&
-        (fVariable.fModifiers.fFlags & Modifiers::kIn_Flag) &&
-        !(fVariable.fModifiers.fFlags & Modifiers::kUniform_Flag)) {
-        return irGenerator.getArg(fOffset, fVariable.fName);
+        (fVariable.fModifiers.fFlags & (Modifiers::kIn_Flag | Modifiers::kUniform_Flag))) {
+        // 'in' variables are always bound via Settings::fArgs; uniforms only when the client has
+        // pinned them for specialization (see SkRuntimeEffect::pinUniform), so getArg may fail.
+        std::unique_ptr<Expression> arg = irGenerator.getArg(fOffset, fVariable.fName);
+        if (arg || !(fVariable.fModifiers.fFlags & Modifiers::kUniform_Flag)) {
+            return arg;
+        }
     }
     if ((fVariable.fModifiers.fFlags & Modifiers::kConst_Flag) && fVariable.fInitialValue &&
         fVariable.fInitialValue->isCompileTimeConstant() && fType.kind() != Type::kArray_Kind) {
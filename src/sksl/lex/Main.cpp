@@ -90,6 +90,14 @@ void writeCPP(const DFA& dfa, const char* lexer, const char* token, const char*
     out << HEADER;
     out << "#include \"" << include << "\"\n";
     out << "\n";
+    out << "#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)\n";
+    out << "#define SKSL_LEXER_SSE2 1\n";
+    out << "#include <emmintrin.h>\n";
+    out << "#elif defined(__ARM_NEON)\n";
+    out << "#define SKSL_LEXER_NEON 1\n";
+    out << "#include <arm_neon.h>\n";
+    out << "#endif\n";
+    out << "\n";
     out << "namespace SkSL {\n";
     out << "\n";
 
@@ -133,6 +141,146 @@ void writeCPP(const DFA& dfa, const char* lexer, const char* token, const char*
     out << " };\n";
     out << "\n";
 
+    out << "static bool is_whitespace_char(uint8_t c) {\n";
+    out << "    return ' ' == c || '\\t' == c || '\\n' == c || '\\r' == c;\n";
+    out << "}\n";
+    out << "\n";
+    out << "static bool is_identifier_char(uint8_t c) {\n";
+    out << "    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && "
+           "c <= '9') || '_' == c;\n";
+    out << "}\n";
+    out << "\n";
+    out << "enum class FastScanClass : int8_t {\n";
+    out << "    kNone,\n";
+    out << "    kWhitespace,\n";
+    out << "    kIdentifier,\n";
+    out << "};\n";
+    out << "\n";
+    out << "static bool state_loops_over(int16_t state, bool (*contains)(uint8_t)) {\n";
+    out << "    for (int c = 9; c < (int)(sizeof(mappings) / sizeof(mappings[0])); ++c) {\n";
+    out << "        if (contains((uint8_t)c) && transitions[mappings[c]][state] != state) {\n";
+    out << "            return false;\n";
+    out << "        }\n";
+    out << "    }\n";
+    out << "    return true;\n";
+    out << "}\n";
+    out << "\n";
+    out << "// Records, for each DFA state, a character class over which the state always "
+           "transitions back\n";
+    out << "// to itself. A run of such characters cannot change the DFA's state, so next() may "
+           "consume the\n";
+    out << "// run in bulk without consulting the transition table. Whitespace runs and "
+           "identifier tails\n";
+    out << "// account for most of the characters in a typical program.\n";
+    out << "struct FastScanTable {\n";
+    out << "    FastScanTable() {\n";
+    out << "        for (size_t state = 0; state < sizeof(accepts) / sizeof(accepts[0]); "
+           "++state) {\n";
+    out << "            if (state_loops_over((int16_t)state, is_whitespace_char)) {\n";
+    out << "                fClass[state] = FastScanClass::kWhitespace;\n";
+    out << "            } else if (state_loops_over((int16_t)state, is_identifier_char)) {\n";
+    out << "                fClass[state] = FastScanClass::kIdentifier;\n";
+    out << "            } else {\n";
+    out << "                fClass[state] = FastScanClass::kNone;\n";
+    out << "            }\n";
+    out << "        }\n";
+    out << "    }\n";
+    out << "\n";
+    out << "    FastScanClass fClass[sizeof(accepts) / sizeof(accepts[0])];\n";
+    out << "};\n";
+    out << "\n";
+    out << "static const FastScanTable gFastScanTable;\n";
+    out << "\n";
+    out << "// Consumes whole 16-byte blocks of characters belonging to fastClass and returns "
+           "the new\n";
+    out << "// offset. Any partial block at the end of the run is left for the table-driven "
+           "loop in next().\n";
+    out << "static int32_t skip_fast_scan_run(const char* text, int32_t offset, int32_t length,\n";
+    out << "                                  FastScanClass fastClass) {\n";
+    out << "#if SKSL_LEXER_SSE2\n";
+    out << "    while (length - offset >= 16) {\n";
+    out << "        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + "
+           "offset));\n";
+    out << "        __m128i inClass;\n";
+    out << "        if (FastScanClass::kWhitespace == fastClass) {\n";
+    out << "            inClass = _mm_or_si128(\n";
+    out << "                    _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),\n";
+    out << "                                 _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\n'))),\n";
+    out << "                    _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\\t')),\n";
+    out << "                                 _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\r'))));\n";
+    out << "        } else {\n";
+    out << "            // Characters at or above 0x80 compare as negative and so correctly "
+           "fail these\n";
+    out << "            // signed range checks.\n";
+    out << "            __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - "
+           "1)),\n";
+    out << "                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('z' + "
+           "1)));\n";
+    out << "            __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - "
+           "1)),\n";
+    out << "                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + "
+           "1)));\n";
+    out << "            __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - "
+           "1)),\n";
+    out << "                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + "
+           "1)));\n";
+    out << "            __m128i under = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));\n";
+    out << "            inClass = _mm_or_si128(_mm_or_si128(lower, upper), _mm_or_si128(digit, "
+           "under));\n";
+    out << "        }\n";
+    out << "        if (_mm_movemask_epi8(inClass) != 0xFFFF) {\n";
+    out << "            break;\n";
+    out << "        }\n";
+    out << "        offset += 16;\n";
+    out << "    }\n";
+    out << "#elif SKSL_LEXER_NEON\n";
+    out << "    while (length - offset >= 16) {\n";
+    out << "        uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(text + "
+           "offset));\n";
+    out << "        uint8x16_t inClass;\n";
+    out << "        if (FastScanClass::kWhitespace == fastClass) {\n";
+    out << "            inClass = vorrq_u8(vorrq_u8(vceqq_u8(chars, vdupq_n_u8(' ')),\n";
+    out << "                                        vceqq_u8(chars, vdupq_n_u8('\\n'))),\n";
+    out << "                               vorrq_u8(vceqq_u8(chars, vdupq_n_u8('\\t')),\n";
+    out << "                                        vceqq_u8(chars, vdupq_n_u8('\\r'))));\n";
+    out << "        } else {\n";
+    out << "            uint8x16_t lower = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('a')),\n";
+    out << "                                        vcleq_u8(chars, vdupq_n_u8('z')));\n";
+    out << "            uint8x16_t upper = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('A')),\n";
+    out << "                                        vcleq_u8(chars, vdupq_n_u8('Z')));\n";
+    out << "            uint8x16_t digit = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('0')),\n";
+    out << "                                        vcleq_u8(chars, vdupq_n_u8('9')));\n";
+    out << "            uint8x16_t under = vceqq_u8(chars, vdupq_n_u8('_'));\n";
+    out << "            inClass = vorrq_u8(vorrq_u8(lower, upper), vorrq_u8(digit, under));\n";
+    out << "        }\n";
+    out << "        uint64x2_t folded = vreinterpretq_u64_u8(inClass);\n";
+    out << "        if ((vgetq_lane_u64(folded, 0) & vgetq_lane_u64(folded, 1)) != ~0ULL) {\n";
+    out << "            break;\n";
+    out << "        }\n";
+    out << "        offset += 16;\n";
+    out << "    }\n";
+    out << "#else\n";
+    out << "    while (length - offset >= 16) {\n";
+    out << "        bool allInClass = true;\n";
+    out << "        for (int i = 0; i < 16; ++i) {\n";
+    out << "            uint8_t c = (uint8_t)text[offset + i];\n";
+    out << "            if (FastScanClass::kWhitespace == fastClass ? !is_whitespace_char(c)\n";
+    out << "                                                        : !is_identifier_char(c)) "
+           "{\n";
+    out << "                allInClass = false;\n";
+    out << "                break;\n";
+    out << "            }\n";
+    out << "        }\n";
+    out << "        if (!allInClass) {\n";
+    out << "            break;\n";
+    out << "        }\n";
+    out << "        offset += 16;\n";
+    out << "    }\n";
+    out << "#endif\n";
+    out << "    return offset;\n";
+    out << "}\n";
+    out << "\n";
+
     out << token << " " << lexer << "::next() {\n";
     out << "    // note that we cheat here: normally a lexer needs to worry about the case\n";
     out << "    // where a token has a prefix which is not itself a valid token - for instance, \n";
@@ -162,6 +310,10 @@ void writeCPP(const DFA& dfa, const char* lexer, const char* token, const char*
     out << "        }\n";
     out << "        state = newState;";
     out << "        ++fOffset;\n";
+    out << "        FastScanClass fastClass = gFastScanTable.fClass[state];\n";
+    out << "        if (FastScanClass::kNone != fastClass) {\n";
+    out << "            fOffset = skip_fast_scan_run(fText, fOffset, fLength, fastClass);\n";
+    out << "        }\n";
     out << "    }\n";
     out << "    Token::Kind kind = (" << token << "::Kind) accepts[state];\n";
     out << "    return " << token << "(kind, startOffset, fOffset - startOffset);\n";
@@ -10,12 +10,15 @@
 #include "include/core/SkImage.h"
 #include "include/utils/SkAnimCodecPlayer.h"
 #include "src/codec/SkCodecImageGenerator.h"
+#include "src/core/SkTaskGroup.h"
 #include <algorithm>
+#include <vector>
 
 SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
     fImageInfo = fCodec->getInfo();
     fFrameInfos = fCodec->getFrameInfo();
     fImages.resize(fFrameInfos.size());
+    fLastUse.resize(fFrameInfos.size(), 0);
 
     // change the interpretation of fDuration to a end-time for that frame
     size_t dur = 0;
@@ -31,50 +34,123 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
         fImages.clear();
         fImages.push_back(SkImage::MakeFromGenerator(
                               SkCodecImageGenerator::MakeFromCodec(std::move(fCodec))));
+    } else {
+        fPrefetchGroup = std::make_unique<SkTaskGroup>();
     }
 }
 
-SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
+SkAnimCodecPlayer::~SkAnimCodecPlayer() {
+    if (fPrefetchGroup) {
+        fPrefetchGroup->wait();
+    }
+}
 
 SkISize SkAnimCodecPlayer::dimensions() {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
+void SkAnimCodecPlayer::cacheFrameAt(int index, sk_sp<SkImage> image) {
+    fMutex.assertHeld();
+    SkASSERT(!fImages[index]);
+
+    fImages[index] = std::move(image);
+    fLastUse[index] = ++fUseCounter;
+    fCachedCount += 1;
+
+    while (fCachedCount > kMaxCachedFrames) {
+        int oldest = -1;
+        for (int i = 0; i < (int)fImages.size(); ++i) {
+            if (fImages[i] && i != index && (oldest < 0 || fLastUse[i] < fLastUse[oldest])) {
+                oldest = i;
+            }
+        }
+        SkASSERT(oldest >= 0);
+        fImages[oldest].reset();
+        fCachedCount -= 1;
+    }
+}
+
 sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
+    fMutex.assertHeld();
     SkASSERT((unsigned)index < fFrameInfos.size());
 
     if (fImages[index]) {
+        fLastUse[index] = ++fUseCounter;
         return fImages[index];
     }
 
-    size_t rb = fImageInfo.minRowBytes();
-    size_t size = fImageInfo.computeByteSize(rb);
-    auto data = SkData::MakeUninitialized(size);
-
-    SkCodec::Options opts;
-    opts.fFrameIndex = index;
+    // Walk the dependency chain back to the first frame we can start from: either an
+    // independent frame or one still in the cache. We then composite forward, caching each
+    // step, so a later seek into the same chain reuses the intermediate frames.
+    std::vector<int> chain;
+    for (int i = index;;) {
+        chain.push_back(i);
+        const int required = fFrameInfos[i].fRequiredFrame;
+        if (required == SkCodec::kNoFrame || fImages[required]) {
+            break;
+        }
+        i = required;
+    }
 
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame) {
-        auto requiredImage = fImages[requiredFrame];
-        SkPixmap requiredPM;
-        if (requiredImage && requiredImage->peekPixels(&requiredPM)) {
-            sk_careful_memcpy(data->writable_data(), requiredPM.addr(), size);
-            opts.fPriorFrame = requiredFrame;
+    const size_t rb = fImageInfo.minRowBytes();
+    const size_t size = fImageInfo.computeByteSize(rb);
+
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        const int i = *it;
+        auto data = SkData::MakeUninitialized(size);
+
+        SkCodec::Options opts;
+        opts.fFrameIndex = i;
+
+        const int requiredFrame = fFrameInfos[i].fRequiredFrame;
+        if (requiredFrame != SkCodec::kNoFrame) {
+            auto requiredImage = fImages[requiredFrame];
+            SkPixmap requiredPM;
+            if (requiredImage && requiredImage->peekPixels(&requiredPM)) {
+                sk_careful_memcpy(data->writable_data(), requiredPM.addr(), size);
+                opts.fPriorFrame = requiredFrame;
+                fLastUse[requiredFrame] = ++fUseCounter;
+            }
         }
+        if (SkCodec::kSuccess != fCodec->getPixels(fImageInfo, data->writable_data(), rb,
+                                                   &opts)) {
+            return nullptr;
+        }
+        this->cacheFrameAt(i, SkImage::MakeRasterData(fImageInfo, std::move(data), rb));
     }
-    if (SkCodec::kSuccess == fCodec->getPixels(fImageInfo, data->writable_data(), rb, &opts)) {
-        return fImages[index] = SkImage::MakeRasterData(fImageInfo, std::move(data), rb);
+    return fImages[index];
+}
+
+void SkAnimCodecPlayer::prefetchFrameAfter(int index) {
+    const int next = (index + 1) % (int)fFrameInfos.size();
+    if (next == index || fPrefetchInFlight.exchange(true)) {
+        return;
     }
-    return nullptr;
+    fPrefetchGroup->add([this, next]() {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            this->getFrameAt(next);
+        }
+        fPrefetchInFlight.store(false);
+    });
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
     SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
 
-    return fTotalDuration > 0
-        ? this->getFrameAt(fCurrIndex)
-        : fImages.front();
+    if (!fTotalDuration) {
+        return fImages.front();
+    }
+
+    sk_sp<SkImage> image;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        image = this->getFrameAt(fCurrIndex);
+    }
+    // Composite the next frame while the caller displays this one; with a threaded
+    // SkExecutor installed this hides the decode behind the frame's display time.
+    this->prefetchFrameAfter(fCurrIndex);
+    return image;
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
@@ -92,5 +168,3 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
     fCurrIndex = lower - fFrameInfos.begin();
     return fCurrIndex != prevIndex;
 }
-
-
@@ -35,10 +35,16 @@ void SkPatch3D::transform(const SkM44& m, SkPatch3D* dst) const {
     if (dst == nullptr) {
         dst = (SkPatch3D*)this;
     }
-    dst->fU = m * fU;
-    dst->fV = m * fV;
-    auto [x,y,z,_] = m.map(fOrigin.x, fOrigin.y, fOrigin.z, 1);
-    dst->fOrigin = {x, y, z};
+    // Batch all three maps so the matrix is only loaded once.
+    SkV4 pts[3] = {
+        {fU.x,      fU.y,      fU.z,      0},
+        {fV.x,      fV.y,      fV.z,      0},
+        {fOrigin.x, fOrigin.y, fOrigin.z, 1},
+    };
+    m.mapPoints(pts, pts, 3);
+    dst->fU      = {pts[0].x, pts[0].y, pts[0].z};
+    dst->fV      = {pts[1].x, pts[1].y, pts[1].z};
+    dst->fOrigin = {pts[2].x, pts[2].y, pts[2].z};
 }
 
 SkScalar SkPatch3D::dotWith(SkScalar dx, SkScalar dy, SkScalar dz) const {
@@ -6,8 +6,11 @@
  */
 
 #include "include/private/SkTFitsIn.h"
+#include "include/private/SkTemplates.h"
 #include "src/utils/SkCharToGlyphCache.h"
 
+#include <algorithm>
+
 SkCharToGlyphCache::SkCharToGlyphCache() {
     this->reset();
 }
@@ -107,6 +110,37 @@ int SkCharToGlyphCache::findGlyphIndex(SkUnichar unichar) const {
     return index;
 }
 
+int SkCharToGlyphCache::findGlyphIndices(const SkUnichar uni[], int count,
+                                         SkGlyphID glyphs[], int missIndices[]) const {
+    SkAutoSTMalloc<64, int> orderStorage(count);
+    int* order = orderStorage.get();
+    for (int i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    std::sort(order, order + count, [uni](int a, int b) { return uni[a] < uni[b]; });
+
+    const SkUnichar* base = fK32.begin();
+    const SkUnichar* cur  = base + 1;           // skip the low sentinel
+    const SkUnichar* stop = fK32.end() - 1;     // the high sentinel terminates every search
+    int missCount = 0;
+    int i = 0;
+    while (i < count) {
+        const SkUnichar c = uni[order[i]];
+        cur = std::lower_bound(cur, stop, c);
+        if (cur < stop && *cur == c) {
+            SkGlyphID glyph = fV16[cur - base];
+            do {
+                glyphs[order[i++]] = glyph;
+            } while (i < count && uni[order[i]] == c);
+        } else {
+            do {
+                missIndices[missCount++] = order[i++];
+            } while (i < count && uni[order[i]] == c);
+        }
+    }
+    return missCount;
+}
+
 void SkCharToGlyphCache::insertCharAndGlyph(int index, SkUnichar unichar, SkGlyphID glyph) {
     SkASSERT(fK32.size() == fV16.size());
     SkASSERT((unsigned)index < fK32.size());
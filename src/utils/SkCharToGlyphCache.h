@@ -37,6 +37,16 @@ public:
      */
     int findGlyphIndex(SkUnichar c) const;
 
+    /**
+     *  Bulk lookup. Sets glyphs[i] for every unichar found in the cache and
+     *  records the original indices of the misses. Returns the number of
+     *  misses. The lookups are processed in sorted unichar order so the cache
+     *  is walked once, and duplicates share a single search; missIndices must
+     *  have room for count entries and comes back grouped by unichar.
+     */
+    int findGlyphIndices(const SkUnichar uni[], int count,
+                         SkGlyphID glyphs[], int missIndices[]) const;
+
     /**
      *  Insert a new char/glyph pair into the cache at the specified index.
      *  See charToGlyph() for how to compute the bit-not of the index.
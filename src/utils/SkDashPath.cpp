@@ -7,6 +7,7 @@
 
 #include "include/core/SkPathMeasure.h"
 #include "include/core/SkStrokeRec.h"
+#include "src/core/SkPathMeasurePriv.h"
 #include "src/core/SkPointPriv.h"
 #include "src/utils/SkDashPathPriv.h"
 
@@ -307,7 +308,9 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         // if rect is closed, starts in a dash, and ends in a dash, add the initial join
         // potentially a better fix is described here: bug.skia.org/7445
         if (src.isRect(nullptr) && src.isLastContourClosed() && is_even(initialDashIndex)) {
-            SkScalar pathLength = SkPathMeasure(src, false, rec->getResScale()).getLength();
+            sk_sp<SkContourMeasureCache::List> measures =
+                    SkContourMeasureCache::Get(src, false, rec->getResScale());
+            SkScalar pathLength = measures->count() ? measures->at(0)->length() : 0;
             SkScalar endPhase = SkScalarMod(pathLength + initialDashLength, intervalLength);
             int index = 0;
             while (endPhase > intervals[index]) {
@@ -356,12 +359,16 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
     bool specialLine = (StrokeRecApplication::kAllow == strokeRecApplication) &&
                        lineRec.init(*srcPtr, dst, rec, count >> 1, intervalLength);
 
-    SkPathMeasure   meas(*srcPtr, false, rec->getResScale());
+    // The measures are cached on the path's genID, so an unchanged path dashed every frame
+    // is only measured once.
+    sk_sp<SkContourMeasureCache::List> measures =
+            SkContourMeasureCache::Get(*srcPtr, false, rec->getResScale());
 
-    do {
-        bool        skipFirstSegment = meas.isClosed();
+    for (int contourIndex = 0; contourIndex < measures->count(); ++contourIndex) {
+        const SkContourMeasure* meas = measures->at(contourIndex);
+        bool        skipFirstSegment = meas->isClosed();
         bool        addedSegment = false;
-        SkScalar    length = meas.getLength();
+        SkScalar    length = meas->length();
         int         index = initialDashIndex;
 
         // Since the path length / dash length ratio may be arbitrarily large, we can exert
@@ -395,9 +402,9 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
                                        SkDoubleToScalar(distance + dlen),
                                        dst);
                 } else {
-                    meas.getSegment(SkDoubleToScalar(distance),
-                                    SkDoubleToScalar(distance + dlen),
-                                    dst, true);
+                    (void) meas->getSegment(SkDoubleToScalar(distance),
+                                            SkDoubleToScalar(distance + dlen),
+                                            dst, true);
                 }
             }
             distance += dlen;
@@ -417,12 +424,12 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         }
 
         // extend if we ended on a segment and we need to join up with the (skipped) initial segment
-        if (meas.isClosed() && is_even(initialDashIndex) &&
+        if (meas->isClosed() && is_even(initialDashIndex) &&
             initialDashLength >= 0) {
-            meas.getSegment(0, initialDashLength, dst, !addedSegment);
+            (void) meas->getSegment(0, initialDashLength, dst, !addedSegment);
             ++segCount;
         }
-    } while (meas.nextContour());
+    }
 
     if (segCount > 1) {
         dst->setConvexityType(SkPathConvexityType::kConcave);
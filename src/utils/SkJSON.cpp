@@ -9,6 +9,7 @@
 
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/private/SkFloatingPoint.h"
 #include "include/private/SkMalloc.h"
 #include "include/utils/SkParse.h"
 #include "src/utils/SkUTF.h"
@@ -184,6 +185,11 @@ private:
 
 } // namespace
 
+StringValue::StringValue() {
+    // Tag::kShortString (0) with an all-zero payload is the empty string.
+    this->init_tagged(Tag::kShortString);
+}
+
 StringValue::StringValue(const char* src, size_t size, SkArenaAlloc& alloc) {
     new (this) FastString(src, size, src, alloc);
 }
@@ -918,8 +924,227 @@ DOM::DOM(const char* data, size_t size)
     fRoot = parser.parse(data, size);
 }
 
+DOM::DOM()
+    : fAlloc(kMinChunkSize) {
+    fRoot = NullValue();
+}
+
 void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+namespace {
+
+// Binary DOM encoding: an 8-byte signature followed by one recursively-encoded
+// value.  Strings/arrays/objects are length-prefixed; numbers keep their
+// int/float storage distinction.
+constexpr char kBinaryMagic[8] = {'s', 'k', 'j', 's', 'o', 'n', 'b', '1'};
+
+enum BinaryTag : uint8_t {
+    kBinaryNull   = 0,
+    kBinaryFalse  = 1,
+    kBinaryTrue   = 2,
+    kBinaryInt    = 3,
+    kBinaryFloat  = 4,
+    kBinaryString = 5,
+    kBinaryArray  = 6,
+    kBinaryObject = 7,
+};
+
+// Guards the decoder against malformed/hostile blobs.
+constexpr int kBinaryMaxDepth = 512;
+
+void write_binary_value(const Value& v, SkWStream* stream) {
+    switch (v.getType()) {
+    case Value::Type::kNull:
+        stream->write8(kBinaryNull);
+        break;
+    case Value::Type::kBool:
+        stream->write8(*v.as<BoolValue>() ? kBinaryTrue : kBinaryFalse);
+        break;
+    case Value::Type::kNumber: {
+        const double d = *v.as<NumberValue>();
+        // Saturate rather than cast directly: out-of-range doubles are UB to convert, and the
+        // clamped value simply fails the round-trip check below and takes the float path.
+        const int32_t i32 = sk_double_saturate2int(d);
+        if (static_cast<double>(i32) == d) {
+            stream->write8(kBinaryInt);
+            stream->write32(static_cast<uint32_t>(i32));
+        } else {
+            const float f = static_cast<float>(d);
+            stream->write8(kBinaryFloat);
+            stream->write(&f, sizeof(f));
+        }
+        break;
+    }
+    case Value::Type::kString: {
+        const auto& s = v.as<StringValue>();
+        stream->write8(kBinaryString);
+        stream->write32(SkToU32(s.size()));
+        stream->write(s.begin(), s.size());
+        break;
+    }
+    case Value::Type::kArray: {
+        const auto& array = v.as<ArrayValue>();
+        stream->write8(kBinaryArray);
+        stream->write32(SkToU32(array.size()));
+        for (const auto& element : array) {
+            write_binary_value(element, stream);
+        }
+        break;
+    }
+    case Value::Type::kObject: {
+        const auto& object = v.as<ObjectValue>();
+        stream->write8(kBinaryObject);
+        stream->write32(SkToU32(object.size()));
+        for (const auto& member : object) {
+            stream->write32(SkToU32(member.fKey.size()));
+            stream->write(member.fKey.begin(), member.fKey.size());
+            write_binary_value(member.fValue, stream);
+        }
+        break;
+    }
+    }
+}
+
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size, SkArenaAlloc* alloc)
+        : fPtr(data), fEnd(data + size), fAlloc(alloc) {}
+
+    bool read(Value* dst, int depth) {
+        if (depth > kBinaryMaxDepth) {
+            return false;
+        }
+        uint8_t tag;
+        if (!this->readPOD(&tag)) {
+            return false;
+        }
+        switch (tag) {
+        case kBinaryNull:
+            *dst = NullValue();
+            return true;
+        case kBinaryFalse:
+            *dst = BoolValue(false);
+            return true;
+        case kBinaryTrue:
+            *dst = BoolValue(true);
+            return true;
+        case kBinaryInt: {
+            int32_t v;
+            if (!this->readPOD(&v)) {
+                return false;
+            }
+            *dst = NumberValue(v);
+            return true;
+        }
+        case kBinaryFloat: {
+            float v;
+            if (!this->readPOD(&v)) {
+                return false;
+            }
+            *dst = NumberValue(v);
+            return true;
+        }
+        case kBinaryString: {
+            StringValue v;
+            if (!this->readString(&v)) {
+                return false;
+            }
+            *dst = v;
+            return true;
+        }
+        case kBinaryArray: {
+            uint32_t count;
+            if (!this->readCount(&count)) {
+                return false;
+            }
+            std::vector<Value> elements(count);
+            for (auto& element : elements) {
+                if (!this->read(&element, depth + 1)) {
+                    return false;
+                }
+            }
+            *dst = ArrayValue(elements.data(), elements.size(), *fAlloc);
+            return true;
+        }
+        case kBinaryObject: {
+            uint32_t count;
+            if (!this->readCount(&count)) {
+                return false;
+            }
+            std::vector<Member> members(count);
+            for (auto& member : members) {
+                if (!this->readString(&member.fKey) || !this->read(&member.fValue, depth + 1)) {
+                    return false;
+                }
+            }
+            *dst = ObjectValue(members.data(), members.size(), *fAlloc);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    bool done() const { return fPtr == fEnd; }
+
+private:
+    template <typename T>
+    bool readPOD(T* dst) {
+        if (sizeof(T) > SkToSizeT(fEnd - fPtr)) {
+            return false;
+        }
+        memcpy(dst, fPtr, sizeof(T));
+        fPtr += sizeof(T);
+        return true;
+    }
+
+    // Every encoded element occupies at least one byte, so counts beyond the
+    // remaining payload are malformed.
+    bool readCount(uint32_t* count) {
+        return this->readPOD(count) && *count <= SkToSizeT(fEnd - fPtr);
+    }
+
+    bool readString(StringValue* dst) {
+        uint32_t size;
+        if (!this->readCount(&size)) {
+            return false;
+        }
+        *dst = StringValue(reinterpret_cast<const char*>(fPtr), size, *fAlloc);
+        fPtr += size;
+        return true;
+    }
+
+    const uint8_t* fPtr;
+    const uint8_t* fEnd;
+    SkArenaAlloc*  fAlloc;
+};
+
+} // namespace
+
+void DOM::writeBinary(SkWStream* stream) const {
+    stream->write(kBinaryMagic, sizeof(kBinaryMagic));
+    write_binary_value(fRoot, stream);
+}
+
+bool DOM::IsBinary(const void* data, size_t size) {
+    return size >= sizeof(kBinaryMagic) && !memcmp(data, kBinaryMagic, sizeof(kBinaryMagic));
+}
+
+std::unique_ptr<DOM> DOM::MakeFromBinary(const void* data, size_t size) {
+    if (!IsBinary(data, size)) {
+        return nullptr;
+    }
+    std::unique_ptr<DOM> dom(new DOM());
+    BinaryReader reader(static_cast<const uint8_t*>(data) + sizeof(kBinaryMagic),
+                        size - sizeof(kBinaryMagic), &dom->fAlloc);
+    Value root = NullValue();
+    if (!reader.read(&root, 0) || !reader.done()) {
+        return nullptr;
+    }
+    dom->fRoot = root;
+    return dom;
+}
+
 } // namespace skjson
@@ -14,6 +14,7 @@
 #include "src/core/SkArenaAlloc.h"
 
 #include <cstring>
+#include <memory>
 
 class SkString;
 class SkWStream;
@@ -340,7 +341,25 @@ public:
 
     void write(SkWStream*) const;
 
+    /**
+     *  Binary (pre-parsed) DOM serialization.
+     *
+     *  writeBinary() flattens the DOM to a compact binary form, and
+     *  MakeFromBinary() reconstructs it without the text parsing step.
+     *  The encoding is little-endian and not guaranteed stable across
+     *  library versions: treat blobs as a cache, not an interchange format.
+     */
+    void writeBinary(SkWStream*) const;
+
+    /** @return  True if the buffer starts with the binary DOM signature. */
+    static bool IsBinary(const void* data, size_t size);
+
+    /** @return  The reconstructed DOM, or nullptr for malformed input. */
+    static std::unique_ptr<DOM> MakeFromBinary(const void* data, size_t size);
+
 private:
+    DOM();
+
     SkArenaAlloc fAlloc;
     Value        fRoot;
 };
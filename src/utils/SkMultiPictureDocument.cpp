@@ -22,13 +22,19 @@
   File format:
       BEGINNING_OF_FILE:
         kMagic
-        uint32_t version_number (==2)
+        uint32_t version_number (==3)
         uint32_t page_count
         {
           float sizeX
           float sizeY
         } * page_count
-        skp file
+        uint64_t page_offset * page_count
+        skp file * page_count
+
+  Version 2 files wrote all pages as a single skp file, separated by
+  end-of-page annotations, and can only be read front to back.  Version 3
+  serializes each page independently and records each page's absolute byte
+  offset, so one page can be deserialized without touching the others.
 */
 
 namespace {
@@ -37,15 +43,10 @@ static constexpr char kMagic[] = "Skia Multi-Picture Doc\n\n";
 
 static constexpr char kEndPage[] = "SkMultiPictureEndPage";
 
-const uint32_t kVersion = 2;
+const uint32_t kVersion = 3;
 
-static SkSize join(const SkTArray<SkSize>& sizes) {
-    SkSize joined = {0, 0};
-    for (SkSize s : sizes) {
-        joined = SkSize{std::max(joined.width(), s.width()), std::max(joined.height(), s.height())};
-    }
-    return joined;
-}
+// Version 2 lacks the per-page offset index and stores all pages in one skp.
+const uint32_t kOnePictureVersion = 2;
 
 struct MultiPictureDocument final : public SkDocument {
     const SkSerialProcs fProcs;
@@ -76,15 +77,20 @@ struct MultiPictureDocument final : public SkDocument {
         for (SkSize s : fSizes) {
             wStream->write(&s, sizeof(s));
         }
-        SkSize bigsize = join(fSizes);
-        SkCanvas* c = fPictureRecorder.beginRecording(SkRect::MakeSize(bigsize));
+        // Serialize each page up front so the offset index can be written
+        // before the page data without requiring a seekable output stream.
+        SkTArray<sk_sp<SkData>> pageData;
         for (const sk_sp<SkPicture>& page : fPages) {
-            c->drawPicture(page);
-            // Annotations must include some data.
-            c->drawAnnotation(SkRect::MakeEmpty(), kEndPage, SkData::MakeWithCString("X"));
+            pageData.push_back(page->serialize(&fProcs));
+        }
+        uint64_t offset = wStream->bytesWritten() + fPages.count() * sizeof(uint64_t);
+        for (const sk_sp<SkData>& data : pageData) {
+            wStream->write(&offset, sizeof(offset));
+            offset += data->size();
+        }
+        for (const sk_sp<SkData>& data : pageData) {
+            wStream->write(data->data(), data->size());
         }
-        sk_sp<SkPicture> p = fPictureRecorder.finishRecordingAsPicture();
-        p->serialize(wStream, &fProcs);
         fPages.reset();
         fSizes.reset();
         return;
@@ -102,7 +108,7 @@ sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* wStream, const SkSerialP
 
 ////////////////////////////////////////////////////////////////////////////////
 
-int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
+static int read_page_count(SkStreamSeekable* stream, uint32_t* versionNumber) {
     if (!stream) {
         return 0;
     }
@@ -113,8 +119,8 @@ int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
         stream = nullptr;
         return 0;
     }
-    uint32_t versionNumber;
-    if (!stream->readU32(&versionNumber) || versionNumber != kVersion) {
+    if (!stream->readU32(versionNumber) ||
+        (*versionNumber != kVersion && *versionNumber != kOnePictureVersion)) {
         return 0;
     }
     uint32_t pageCount;
@@ -125,6 +131,11 @@ int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
     return SkTo<int>(pageCount);
 }
 
+int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
+    uint32_t versionNumber;
+    return read_page_count(stream, &versionNumber);
+}
+
 bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
                                          SkDocumentPage* dstArray,
                                          int dstArrayCount) {
@@ -180,9 +191,24 @@ bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
                                 SkDocumentPage* dstArray,
                                 int dstArrayCount,
                                 const SkDeserialProcs* procs) {
+    uint32_t versionNumber;
+    (void)read_page_count(stream, &versionNumber);
     if (!SkMultiPictureDocumentReadPageSizes(stream, dstArray, dstArrayCount)) {
         return false;
     }
+    if (versionNumber >= kVersion) {
+        // Skip over the offset index; the pages follow it in order.
+        if (!stream->move(dstArrayCount * sizeof(uint64_t))) {
+            return false;
+        }
+        for (int i = 0; i < dstArrayCount; ++i) {
+            dstArray[i].fPicture = SkPicture::MakeFromStream(stream, procs);
+            if (!dstArray[i].fPicture) {
+                return false;
+            }
+        }
+        return true;
+    }
     SkSize joined = {0.0f, 0.0f};
     for (int i = 0; i < dstArrayCount; ++i) {
         joined = SkSize{std::max(joined.width(), dstArray[i].fSize.width()),
@@ -201,3 +227,38 @@ bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
     }
     return true;
 }
+
+bool SkMultiPictureDocumentReadPage(SkStreamSeekable* stream,
+                                    int pageNumber,
+                                    SkDocumentPage* dst,
+                                    const SkDeserialProcs* procs) {
+    if (!dst) {
+        return false;
+    }
+    uint32_t versionNumber;
+    int pageCount = read_page_count(stream, &versionNumber);
+    if (pageNumber < 0 || pageNumber >= pageCount || versionNumber < kVersion) {
+        return false;
+    }
+    // The size table immediately follows the header, and the offset index
+    // immediately follows the size table.
+    if (!stream->move(pageNumber * sizeof(SkSize))) {
+        return false;
+    }
+    if (sizeof(dst->fSize) != stream->read(&dst->fSize, sizeof(dst->fSize))) {
+        return false;
+    }
+    if (!stream->move((pageCount - pageNumber - 1) * sizeof(SkSize) +
+                      pageNumber * sizeof(uint64_t))) {
+        return false;
+    }
+    uint64_t offset;
+    if (sizeof(offset) != stream->read(&offset, sizeof(offset))) {
+        return false;
+    }
+    if (!stream->seek(SkTo<size_t>(offset))) {
+        return false;
+    }
+    dst->fPicture = SkPicture::MakeFromStream(stream, procs);
+    return dst->fPicture != nullptr;
+}
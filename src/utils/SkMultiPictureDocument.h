@@ -41,4 +41,17 @@ SK_SPI bool SkMultiPictureDocumentRead(SkStreamSeekable* src,
                                        int dstArrayCount,
                                        const SkDeserialProcs* = nullptr);
 
+/**
+ *  Read a single page from the SkMultiPictureDocument without deserializing
+ *  the other pages, using the file's per-page offset index.  pageNumber is
+ *  zero-based and must be less than SkMultiPictureDocumentReadPageCount().
+ *  Only files written by the current version of the format carry the index;
+ *  use SkMultiPictureDocumentRead() for older files.
+ *  Return false on error.
+ */
+SK_SPI bool SkMultiPictureDocumentReadPage(SkStreamSeekable* src,
+                                           int pageNumber,
+                                           SkDocumentPage* dst,
+                                           const SkDeserialProcs* = nullptr);
+
 #endif  // SkMultiPictureDocument_DEFINED
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/utils/SkParallelPicturePlayback.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPixmap.h"
+#include "src/core/SkTaskGroup.h"
+
+static void draw_tile(const SkPicture* pic, const SkPixmap& dst,
+                      const SkMatrix& initialMatrix, const SkIRect& bounds) {
+    SkPixmap tile;
+    SkAssertResult(dst.extractSubset(&tile, bounds));
+
+    std::unique_ptr<SkCanvas> canvas =
+            SkCanvas::MakeRasterDirect(tile.info(), tile.writable_addr(), tile.rowBytes());
+    SkASSERT(canvas);
+
+    // The canvas clips to the tile; translate so the tile sees its slice of the
+    // picture and let the picture's BBH cull the ops that land elsewhere.
+    canvas->translate(-SkIntToScalar(bounds.fLeft), -SkIntToScalar(bounds.fTop));
+    canvas->concat(initialMatrix);
+    canvas->drawPicture(pic);
+}
+
+void SkDrawPictureInTiles(const SkPicture* pic,
+                          const SkPixmap& dst,
+                          const SkMatrix& initialMatrix,
+                          int tileDim,
+                          SkExecutor* executor) {
+    SkASSERT(pic);
+    SkASSERT(tileDim > 0);
+
+    if (!executor) {
+        for (int y = 0; y < dst.height(); y += tileDim) {
+            for (int x = 0; x < dst.width(); x += tileDim) {
+                SkIRect bounds = SkIRect::MakeXYWH(x, y, tileDim, tileDim);
+                SkAssertResult(bounds.intersect(dst.bounds()));
+                draw_tile(pic, dst, initialMatrix, bounds);
+            }
+        }
+        return;
+    }
+
+    SkTaskGroup tasks(*executor);
+    for (int y = 0; y < dst.height(); y += tileDim) {
+        for (int x = 0; x < dst.width(); x += tileDim) {
+            SkIRect bounds = SkIRect::MakeXYWH(x, y, tileDim, tileDim);
+            SkAssertResult(bounds.intersect(dst.bounds()));
+            tasks.add([pic, &dst, &initialMatrix, bounds] {
+                draw_tile(pic, dst, initialMatrix, bounds);
+            });
+        }
+    }
+    tasks.wait();
+}
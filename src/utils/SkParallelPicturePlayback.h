@@ -0,0 +1,33 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkParallelPicturePlayback_DEFINED
+#define SkParallelPicturePlayback_DEFINED
+
+#include "include/core/SkMatrix.h"
+
+class SkExecutor;
+class SkPicture;
+class SkPixmap;
+
+/**
+ *  Replays a picture into dst by splitting it into tileDim x tileDim tiles and
+ *  drawing them concurrently on the executor (or serially when executor is
+ *  null). Each tile is an independent canvas over a disjoint subset of dst's
+ *  pixels, so no merge pass or synchronization between tiles is needed.
+ *
+ *  The per-op device-space bounds recorded in the picture's bounding box
+ *  hierarchy restrict each tile's replay to the ops that intersect it, so
+ *  record the picture with SkRTreeFactory for the tiles to scale well.
+ */
+void SkDrawPictureInTiles(const SkPicture* pic,
+                          const SkPixmap& dst,
+                          const SkMatrix& initialMatrix,
+                          int tileDim,
+                          SkExecutor* executor);
+
+#endif  // SkParallelPicturePlayback_DEFINED
@@ -208,25 +208,39 @@ bool SkParsePath::FromSVGString(const char data[], SkPath* result) {
 #include "include/core/SkString.h"
 #include "src/core/SkGeometry.h"
 
-static void write_scalar(SkWStream* stream, SkScalar value) {
-    char buffer[64];
+#include <cmath>
+
+static char* write_scalar(char* buffer, SkScalar value) {
+    // Integer coordinates dominate typical path data; write their digits directly rather than
+    // paying for snprintf on every number. "%g" switches to exponential notation at 1e6 and
+    // prints negative zero as "-0", so those fall through to the general case.
+    if (value == SkScalarFloorToScalar(value) && SkScalarAbs(value) < 1e6f &&
+        !(value == 0 && std::signbit(value))) {
+        return SkStrAppendS32(buffer, (int32_t)value);
+    }
 #ifdef SK_BUILD_FOR_WIN
-    int len = _snprintf(buffer, sizeof(buffer), "%g", value);
+    int len = _snprintf(buffer, kSkStrAppendScalar_MaxSize, "%g", value);
 #else
-    int len = snprintf(buffer, sizeof(buffer), "%g", value);
+    int len = snprintf(buffer, kSkStrAppendScalar_MaxSize, "%g", value);
 #endif
-    char* stop = buffer + len;
-    stream->write(buffer, stop - buffer);
+    return buffer + len;
 }
 
 static void append_scalars(SkWStream* stream, char verb, const SkScalar data[],
                            int count) {
-    stream->write(&verb, 1);
-    write_scalar(stream, data[0]);
+    // Assemble the whole segment on the stack and write it in one call.
+    char buffer[1 + 6 * (kSkStrAppendScalar_MaxSize + 1)];
+    static_assert(SK_ARRAY_COUNT(buffer) >= 1 + 6 * 16, "");
+    SkASSERT(count <= 6);
+    char* stop = buffer;
+    *stop++ = verb;
+    stop = write_scalar(stop, data[0]);
     for (int i = 1; i < count; i++) {
-        stream->write(" ", 1);
-        write_scalar(stream, data[i]);
+        *stop++ = ' ';
+        stop = write_scalar(stop, data[i]);
     }
+    SkASSERT(stop <= buffer + SK_ARRAY_COUNT(buffer));
+    stream->write(buffer, stop - buffer);
 }
 
 void SkParsePath::ToSVGString(const SkPath& path, SkString* str) {
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/utils/SkReusableVerticesBuilder.h"
+
+#include "src/core/SkOpts.h"
+
+#include <cstring>
+
+SkReusableVerticesBuilder::SkReusableVerticesBuilder(uint32_t builderFlags)
+    : fHasTexs(SkToBool(builderFlags & SkVertices::kHasTexCoords_BuilderFlag))
+    , fHasColors(SkToBool(builderFlags & SkVertices::kHasColors_BuilderFlag)) {}
+
+void SkReusableVerticesBuilder::reset() {
+    fPositions.rewind();
+    fTexs.rewind();
+    fColors.rewind();
+    fIndices.rewind();
+    if (fTable.count()) {
+        memset(fTable.begin(), 0, fTable.count() * sizeof(uint32_t));
+    }
+}
+
+uint32_t SkReusableVerticesBuilder::hashOf(const SkPoint& position,
+                                           const SkPoint& texCoord,
+                                           SkColor color) const {
+    struct {
+        SkPoint p, t;
+        SkColor c;
+    } key = {
+        position,
+        fHasTexs   ? texCoord : SkPoint{0, 0},
+        fHasColors ? color    : 0,
+    };
+    return SkOpts::hash(&key, sizeof(key));
+}
+
+bool SkReusableVerticesBuilder::matches(int ix,
+                                        const SkPoint& position,
+                                        const SkPoint& texCoord,
+                                        SkColor color) const {
+    return fPositions[ix] == position
+        && (!fHasTexs   || fTexs[ix]   == texCoord)
+        && (!fHasColors || fColors[ix] == color);
+}
+
+void SkReusableVerticesBuilder::growTableIfNeeded() {
+    // Keep the table under 3/4 full so probe chains stay short.
+    if (4 * (fPositions.count() + 1) <= 3 * fTable.count()) {
+        return;
+    }
+
+    int newSize = fTable.count() ? 2 * fTable.count() : 64;
+    fTable.setCount(newSize);
+    memset(fTable.begin(), 0, newSize * sizeof(uint32_t));
+
+    const uint32_t mask = newSize - 1;
+    for (int ix = 0; ix < fPositions.count(); ++ix) {
+        uint32_t h = this->hashOf(fPositions[ix],
+                                  fHasTexs   ? fTexs[ix]   : SkPoint{0, 0},
+                                  fHasColors ? fColors[ix] : 0);
+        uint32_t slot = h & mask;
+        while (fTable[slot]) {
+            slot = (slot + 1) & mask;
+        }
+        fTable[slot] = ix + 1;
+    }
+}
+
+uint16_t SkReusableVerticesBuilder::append(const SkPoint& position,
+                                           const SkPoint& texCoord,
+                                           SkColor color) {
+    this->growTableIfNeeded();
+
+    const uint32_t mask = fTable.count() - 1;
+    for (uint32_t slot = this->hashOf(position, texCoord, color) & mask;;
+         slot = (slot + 1) & mask) {
+        if (!fTable[slot]) {
+            int ix = fPositions.count();
+            SkASSERT(ix <= UINT16_MAX);
+            fPositions.push_back(position);
+            if (fHasTexs) {
+                fTexs.push_back(texCoord);
+            }
+            if (fHasColors) {
+                fColors.push_back(color);
+            }
+            fTable[slot] = ix + 1;
+            return SkToU16(ix);
+        }
+        int ix = fTable[slot] - 1;
+        if (this->matches(ix, position, texCoord, color)) {
+            return SkToU16(ix);
+        }
+    }
+}
+
+void SkReusableVerticesBuilder::appendTriangle(uint16_t a, uint16_t b, uint16_t c) {
+    SkASSERT(a < fPositions.count() && b < fPositions.count() && c < fPositions.count());
+    fIndices.push_back(a);
+    fIndices.push_back(b);
+    fIndices.push_back(c);
+}
+
+sk_sp<SkVertices> SkReusableVerticesBuilder::detach(SkVertices::VertexMode mode) {
+    uint32_t flags = (fHasTexs   ? SkVertices::kHasTexCoords_BuilderFlag : 0)
+                   | (fHasColors ? SkVertices::kHasColors_BuilderFlag    : 0);
+    SkVertices::Builder builder(mode, fPositions.count(), fIndices.count(), flags);
+    if (!builder.isValid()) {
+        return nullptr;
+    }
+
+    memcpy(builder.positions(), fPositions.begin(), fPositions.count() * sizeof(SkPoint));
+    if (fHasTexs) {
+        memcpy(builder.texCoords(), fTexs.begin(), fTexs.count() * sizeof(SkPoint));
+    }
+    if (fHasColors) {
+        memcpy(builder.colors(), fColors.begin(), fColors.count() * sizeof(SkColor));
+    }
+    if (fIndices.count()) {
+        memcpy(builder.indices(), fIndices.begin(), fIndices.count() * sizeof(uint16_t));
+    }
+
+    this->reset();
+    return builder.detach();
+}
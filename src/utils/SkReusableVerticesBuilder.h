@@ -0,0 +1,63 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkReusableVerticesBuilder_DEFINED
+#define SkReusableVerticesBuilder_DEFINED
+
+#include "include/core/SkVertices.h"
+#include "include/private/SkTDArray.h"
+
+/**
+ *  A mesh builder for clients that rebuild vertex meshes every frame. Unlike
+ *  SkVertices::Builder, which sizes a fresh immutable allocation per mesh, this builder retains
+ *  and grows its scratch storage across detach() calls, and deduplicates appended vertices
+ *  through a spatial hash so shared corners are stored once and referenced by index. After the
+ *  first few frames the only per-mesh allocation left is the immutable SkVertices produced by
+ *  detach(), which is handed by move to the draw.
+ */
+class SkReusableVerticesBuilder {
+public:
+    // builderFlags uses the same bits as SkVertices::BuilderFlags.
+    explicit SkReusableVerticesBuilder(uint32_t builderFlags = 0);
+
+    // Forget the current mesh but keep the backing storage for the next one.
+    void reset();
+
+    // Append one vertex and return its index. A vertex equal to one already in the mesh (same
+    // position and, where enabled, the same texCoord/color) is shared rather than stored again.
+    // texCoord and color are ignored unless the corresponding builder flag was passed.
+    uint16_t append(const SkPoint& position,
+                    const SkPoint& texCoord = {0, 0},
+                    SkColor color = SK_ColorBLACK);
+
+    // Append one triangle to the index array, using indices returned from append().
+    void appendTriangle(uint16_t a, uint16_t b, uint16_t c);
+
+    int vertexCount() const { return fPositions.count(); }
+    int indexCount() const { return fIndices.count(); }
+
+    // Build the immutable vertices for this mesh. The builder is left empty and reusable.
+    sk_sp<SkVertices> detach(SkVertices::VertexMode mode);
+
+private:
+    uint32_t hashOf(const SkPoint& position, const SkPoint& texCoord, SkColor color) const;
+    bool matches(int ix, const SkPoint& position, const SkPoint& texCoord, SkColor color) const;
+    void growTableIfNeeded();
+
+    SkTDArray<SkPoint>  fPositions;
+    SkTDArray<SkPoint>  fTexs;      // unused unless kHasTexCoords_BuilderFlag
+    SkTDArray<SkColor>  fColors;    // unused unless kHasColors_BuilderFlag
+    SkTDArray<uint16_t> fIndices;
+
+    // Open-addressed hash over the appended vertices: vertex index + 1, with 0 meaning empty.
+    SkTDArray<uint32_t> fTable;
+
+    bool fHasTexs;
+    bool fHasColors;
+};
+
+#endif
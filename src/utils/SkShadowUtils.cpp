@@ -103,6 +103,45 @@ uint64_t resource_cache_shared_id() {
     return 0x2020776f64616873llu;  // 'shadow  '
 }
 
+/**
+ * Returns true if the linear portions of 'a' and 'b' are within a small relative tolerance of
+ * each other, so that a tessellation generated under 'b' can be reused for a draw under 'a'.
+ * On success '*correction' is set to the matrix that maps the cached geometry to the new draw
+ * (a's linear portion times the inverse of b's). Without this slop, animated transforms miss
+ * the cache on every frame and retessellate.
+ */
+bool quantized_matrix_match(const SkMatrix& a, const SkMatrix& b, SkMatrix* correction) {
+    static constexpr SkScalar kRelTol = 1 / 32.f;
+    SkScalar maxComponent = std::max(std::max(SkTAbs(a.getScaleX()), SkTAbs(a.getSkewX())),
+                                     std::max(SkTAbs(a.getScaleY()), SkTAbs(a.getSkewY())));
+    SkScalar tol = kRelTol * std::max(maxComponent, SK_Scalar1);
+    if (!SkScalarNearlyEqual(a.getScaleX(), b.getScaleX(), tol) ||
+        !SkScalarNearlyEqual(a.getSkewX(), b.getSkewX(), tol) ||
+        !SkScalarNearlyEqual(a.getSkewY(), b.getSkewY(), tol) ||
+        !SkScalarNearlyEqual(a.getScaleY(), b.getScaleY(), tol)) {
+        return false;
+    }
+    if (a.getScaleX() == b.getScaleX() && a.getSkewX() == b.getSkewX() &&
+        a.getSkewY() == b.getSkewY() && a.getScaleY() == b.getScaleY()) {
+        correction->reset();
+        return true;
+    }
+    SkMatrix bLinear;
+    bLinear.setAll(b.getScaleX(), b.getSkewX(), 0,
+                   b.getSkewY(), b.getScaleY(), 0,
+                   0, 0, 1);
+    SkMatrix bLinearInv;
+    if (!bLinear.invert(&bLinearInv)) {
+        return false;
+    }
+    SkMatrix aLinear;
+    aLinear.setAll(a.getScaleX(), a.getSkewX(), 0,
+                   a.getSkewY(), a.getScaleY(), 0,
+                   0, 0, 1);
+    correction->setConcat(aLinear, bLinearInv);
+    return true;
+}
+
 /** Factory for an ambient shadow mesh with particular shadow properties. */
 struct AmbientVerticesFactory {
     SkScalar fOccluderHeight = SK_ScalarNaN;  // NaN so that isCompatible will fail until init'ed.
@@ -117,6 +156,10 @@ struct AmbientVerticesFactory {
         return true;
     }
 
+    // The tessellation is generated in a translation-free canonical space (see makeVertices),
+    // so a cached mesh can be reused under a nearby linear matrix with a correction applied.
+    bool tessellationIsTranslationFree() const { return true; }
+
     sk_sp<SkVertices> makeVertices(const SkPath& path, const SkMatrix& ctm,
                                    SkVector* translate) const {
         SkPoint3 zParams = SkPoint3::Make(0, 0, fOccluderHeight);
@@ -174,6 +217,12 @@ struct SpotVerticesFactory {
         SK_ABORT("Uninitialized occluder type?");
     }
 
+    // Partial-umbra tessellations bake in the full ctm (including translation), so they cannot
+    // be reused under a corrected linear matrix; see makeVertices.
+    bool tessellationIsTranslationFree() const {
+        return OccluderType::kOpaquePartialUmbra != fOccluderType;
+    }
+
     sk_sp<SkVertices> makeVertices(const SkPath& path, const SkMatrix& ctm,
                                    SkVector* translate) const {
         bool transparent = OccluderType::kTransparent == fOccluderType;
@@ -208,8 +257,8 @@ public:
     size_t size() const { return fAmbientSet.size() + fSpotSet.size(); }
 
     sk_sp<SkVertices> find(const AmbientVerticesFactory& ambient, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fAmbientSet.find(ambient, matrix, translate);
+                           SkVector* translate, SkMatrix* correction) const {
+        return fAmbientSet.find(ambient, matrix, translate, correction);
     }
 
     sk_sp<SkVertices> add(const SkPath& devPath, const AmbientVerticesFactory& ambient,
@@ -218,8 +267,8 @@ public:
     }
 
     sk_sp<SkVertices> find(const SpotVerticesFactory& spot, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fSpotSet.find(spot, matrix, translate);
+                           SkVector* translate, SkMatrix* correction) const {
+        return fSpotSet.find(spot, matrix, translate, correction);
     }
 
     sk_sp<SkVertices> add(const SkPath& devPath, const SpotVerticesFactory& spot,
@@ -234,7 +283,7 @@ private:
         size_t size() const { return fSize; }
 
         sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
-                               SkVector* translate) const {
+                               SkVector* translate, SkMatrix* correction) const {
             for (int i = 0; i < MAX_ENTRIES; ++i) {
                 if (fEntries[i].fFactory.isCompatible(factory, translate)) {
                     const SkMatrix& m = fEntries[i].fMatrix;
@@ -242,10 +291,19 @@ private:
                         if (matrix != fEntries[i].fMatrix) {
                             continue;
                         }
-                    } else if (matrix.getScaleX() != m.getScaleX() ||
-                               matrix.getSkewX() != m.getSkewX() ||
-                               matrix.getScaleY() != m.getScaleY() ||
-                               matrix.getSkewY() != m.getSkewY()) {
+                        correction->reset();
+                    } else if (!fEntries[i].fFactory.tessellationIsTranslationFree()) {
+                        // The cached vertices baked in the ctm's translation, which a linear
+                        // correction would also scale/rotate, displacing the shadow. Require an
+                        // exact linear match instead.
+                        if (matrix.getScaleX() != m.getScaleX() ||
+                            matrix.getSkewX() != m.getSkewX() ||
+                            matrix.getScaleY() != m.getScaleY() ||
+                            matrix.getSkewY() != m.getSkewY()) {
+                            continue;
+                        }
+                        correction->reset();
+                    } else if (!quantized_matrix_match(matrix, m, correction)) {
                         continue;
                     }
                     return fEntries[i].fVertices;
@@ -315,8 +373,8 @@ public:
 
     template <typename FACTORY>
     sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fTessellations->find(factory, matrix, translate);
+                           SkVector* translate, SkMatrix* correction) const {
+        return fTessellations->find(factory, matrix, translate, correction);
     }
 
 private:
@@ -336,9 +394,11 @@ struct FindContext {
             : fViewMatrix(viewMatrix), fFactory(factory) {}
     const SkMatrix* const fViewMatrix;
     // If this is valid after Find is called then we found the vertices and they should be drawn
-    // with fTranslate applied.
+    // with fCorrection followed by fTranslate applied. fCorrection accounts for any (quantized)
+    // difference between the matrix the vertices were tessellated under and fViewMatrix.
     sk_sp<SkVertices> fVertices;
     SkVector fTranslate = {0, 0};
+    SkMatrix fCorrection = SkMatrix::I();
 
     // If this is valid after Find then the caller should add the vertices to the tessellation set
     // and create a new CachedTessellationsRec and insert it into SkResourceCache.
@@ -357,7 +417,8 @@ bool FindVisitor(const SkResourceCache::Rec& baseRec, void* ctx) {
     FindContext<FACTORY>* findContext = (FindContext<FACTORY>*)ctx;
     const CachedTessellationsRec& rec = static_cast<const CachedTessellationsRec&>(baseRec);
     findContext->fVertices =
-            rec.find(*findContext->fFactory, *findContext->fViewMatrix, &findContext->fTranslate);
+            rec.find(*findContext->fFactory, *findContext->fViewMatrix, &findContext->fTranslate,
+                     &findContext->fCorrection);
     if (findContext->fVertices) {
         return true;
     }
@@ -435,7 +496,7 @@ private:
 template <typename FACTORY>
 bool draw_shadow(const FACTORY& factory,
                  std::function<void(const SkVertices*, SkBlendMode, const SkPaint&,
-                 SkScalar tx, SkScalar ty, bool)> drawProc, ShadowedPath& path, SkColor color) {
+                 const SkMatrix& transform, bool)> drawProc, ShadowedPath& path, SkColor color) {
     FindContext<FACTORY> context(&path.viewMatrix(), &factory);
 
     SkResourceCache::Key* key = nullptr;
@@ -487,8 +548,10 @@ bool draw_shadow(const FACTORY& factory,
          SkColorFilters::Blend(color, SkBlendMode::kModulate)->makeComposed(
                                                                 SkColorFilterPriv::MakeGaussian()));
 
-    drawProc(vertices.get(), SkBlendMode::kModulate, paint,
-             context.fTranslate.fX, context.fTranslate.fY, path.viewMatrix().hasPerspective());
+    SkMatrix transform = SkMatrix::Translate(context.fTranslate.fX, context.fTranslate.fY);
+    transform.preConcat(context.fCorrection);
+    drawProc(vertices.get(), SkBlendMode::kModulate, paint, transform,
+             path.viewMatrix().hasPerspective());
 
     return true;
 }
@@ -589,15 +652,15 @@ static bool validate_rec(const SkDrawShadowRec& rec) {
 
 void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
     auto drawVertsProc = [this](const SkVertices* vertices, SkBlendMode mode, const SkPaint& paint,
-                                SkScalar tx, SkScalar ty, bool hasPerspective) {
+                                const SkMatrix& transform, bool hasPerspective) {
         if (vertices->priv().vertexCount()) {
             // For perspective shadows we've already computed the shadow in world space,
             // and we can't translate it without changing it. Otherwise we concat the
-            // change in translation from the cached version.
+            // change in translation (and any quantized-matrix correction) from the
+            // cached version.
             SkAutoDeviceTransformRestore adr(
                     this,
-                    hasPerspective ? SkMatrix::I()
-                                   : this->localToDevice() * SkMatrix::Translate(tx, ty));
+                    hasPerspective ? SkMatrix::I() : this->localToDevice() * transform);
             this->drawVertices(vertices, mode, paint);
         }
     };
@@ -413,6 +413,78 @@ static void test_regressions() {
 //
 // Before the fix, the following code would assert in debug builds.
 //
+// Exercises the row-reusing fast path taken by op(SkIRect, kIntersect) when
+// the rect spans the clip's whole x-range, comparing it against the general
+// builder-based combine.
+static void test_intersect_y_trim(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.addCircle(50, 50, 45);
+    SkAAClip clip;
+    clip.setPath(path, nullptr, true);
+
+    const SkIRect bounds = clip.getBounds();
+    const SkIRect bands[] = {
+        { bounds.fLeft,     bounds.fTop + 10, bounds.fRight,     bounds.fBottom - 10 },
+        { bounds.fLeft - 5, bounds.fTop + 25, bounds.fRight + 5, bounds.fTop + 26 },
+        { bounds.fLeft,     bounds.fTop,      bounds.fRight,     bounds.fTop + 1 },
+    };
+    for (const SkIRect& band : bands) {
+        SkAAClip fast(clip);
+        fast.op(band, SkRegion::kIntersect_Op);
+
+        SkAAClip rectClip;
+        rectClip.setRect(band);
+        SkAAClip slow;
+        slow.op(clip, rectClip, SkRegion::kIntersect_Op);
+
+        REPORTER_ASSERT(reporter, fast.getBounds() == slow.getBounds());
+
+        SkMask maskFast, maskSlow;
+        fast.copyToMask(&maskFast);
+        slow.copyToMask(&maskSlow);
+        SkAutoMaskFreeImage freeFast(maskFast.fImage);
+        SkAutoMaskFreeImage freeSlow(maskSlow.fImage);
+        REPORTER_ASSERT(reporter, maskFast == maskSlow);
+    }
+}
+
+// Draw through an AA clip and check the result against the clip's own mask.
+// This covers the fused path where SkRasterPipelineBlitter ingests the clip
+// as a pipeline stage rather than being wrapped by SkAAClipBlitter.
+static void test_fused_clip_blit(skiatest::Reporter* reporter) {
+    constexpr int kSize = 64;
+
+    SkPath path;
+    path.addCircle(32, 32, 20);
+
+    SkAAClip aaclip;
+    SkRegion deviceRgn(SkIRect::MakeWH(kSize, kSize));
+    aaclip.setPath(path, &deviceRgn, true);
+
+    SkMask mask;
+    aaclip.copyToMask(&mask);
+    SkAutoMaskFreeImage freeMask(mask.fImage);
+
+    SkBitmap bm;
+    bm.allocN32Pixels(kSize, kSize);
+    bm.eraseColor(SK_ColorWHITE);
+
+    SkCanvas canvas(bm);
+    canvas.clipPath(path, true);
+    canvas.drawColor(SK_ColorRED);
+
+    // Over white, opaque red leaves G = 255 - coverage (up to rounding).
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            int coverage = mask.fBounds.contains(x, y)
+                    ? *mask.getAddr8(x, y)
+                    : 0;
+            int g = SkColorGetG(bm.getColor(x, y));
+            REPORTER_ASSERT(reporter, SkAbs32(g - (255 - coverage)) <= 1);
+        }
+    }
+}
+
 static void test_crbug_422693(skiatest::Reporter* reporter) {
     SkRasterClip rc(SkIRect::MakeLTRB(-25000, -25000, 25000, 25000));
     SkPath path;
@@ -438,6 +510,8 @@ DEF_TEST(AAClip, reporter) {
     test_regressions();
     test_nearly_integral(reporter);
     test_really_a_rect(reporter);
+    test_intersect_y_trim(reporter);
+    test_fused_clip_blit(reporter);
     test_crbug_422693(reporter);
     test_huge(reporter);
 }
@@ -181,3 +181,48 @@ DEF_TEST(ArenaAlloc, r) {
     REPORTER_ASSERT(r, destroyed == 128);
 
 }
+
+DEF_TEST(ArenaAllocScratchScope, r) {
+    // A scratch scope serves a working arena and destroys its objects when the scope ends.
+    {
+        created = 0;
+        destroyed = 0;
+        SkScratchArenaScope scratch("test_basic");
+        REPORTER_ASSERT(r, *scratch->make<int>(3) == 3);
+        Foo* foo = scratch->make<Foo>(3, 4.0f);
+        REPORTER_ASSERT(r, foo->x == 3);
+        REPORTER_ASSERT(r, foo->y == 4.0f);
+        REPORTER_ASSERT(r, created == 1);
+        REPORTER_ASSERT(r, destroyed == 0);
+    }
+    REPORTER_ASSERT(r, created == 1);
+    REPORTER_ASSERT(r, destroyed == 1);
+
+    // A scope that overflows to the heap grows the recycled block, so the next scope on this
+    // thread holds the same allocation without going back to the heap.
+    constexpr size_t kBig = 64 * 1024;
+    {
+        SkScratchArenaScope scratch("test_grow");
+        scratch->makeArrayDefault<char>(kBig);
+        REPORTER_ASSERT(r, scratch->totalHeapAllocated() > 0);
+    }
+    {
+        SkScratchArenaScope scratch("test_grow");
+        scratch->makeArrayDefault<char>(kBig);
+        REPORTER_ASSERT(r, scratch->totalHeapAllocated() == 0);
+    }
+
+    // Nested scopes each get a working arena, even past the per-thread block count.
+    {
+        created = 0;
+        destroyed = 0;
+        SkScratchArenaScope a("n1"), b("n2"), c("n3"), d("n4"), e("n5"), f("n6");
+        for (SkScratchArenaScope* scope : {&a, &b, &c, &d, &e, &f}) {
+            Foo* foo = (*scope)->make<Foo>(7, 8.0f);
+            REPORTER_ASSERT(r, foo->x == 7);
+        }
+        REPORTER_ASSERT(r, created == 6);
+        REPORTER_ASSERT(r, destroyed == 0);
+    }
+    REPORTER_ASSERT(r, destroyed == 6);
+}
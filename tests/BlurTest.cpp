@@ -743,3 +743,44 @@ DEF_TEST(zero_blur, reporter) {
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
 
+
+// Very large sigmas take an approximate downscale-blur-upscale path in
+// SkMaskBlurFilter. Check that it reports the same geometry as the exact path
+// and produces a sensible profile: full strength in the middle of a large
+// solid rect, fading to zero at the blur border.
+DEF_TEST(BlurBigSigmaApproximation, reporter) {
+    static constexpr int kW = 120, kH = 90;
+    static constexpr SkScalar kSigma = 40.0f;
+
+    SkMask src;
+    src.fBounds = SkIRect::MakeWH(kW, kH);
+    src.fRowBytes = kW;
+    src.fFormat = SkMask::kA8_Format;
+    src.fImage = SkMask::AllocImage(src.computeImageSize());
+    memset(src.fImage, 0xFF, src.computeImageSize());
+
+    SkMask dst;
+    SkIPoint margin;
+    REPORTER_ASSERT(reporter,
+                    SkBlurMask::BoxBlur(&dst, src, kSigma, kNormal_SkBlurStyle, &margin));
+    SkAutoMaskFreeImage autoFreeDst(dst.fImage);
+    SkMask::FreeImage(src.fImage);
+
+    // The destination is the source outset by the same margin on every side.
+    REPORTER_ASSERT(reporter, margin.x() == margin.y());
+    REPORTER_ASSERT(reporter, dst.fBounds.width() == kW + 2 * margin.x());
+    REPORTER_ASSERT(reporter, dst.fBounds.height() == kH + 2 * margin.y());
+
+    auto value = [&](int x, int y) {
+        return dst.fImage[y * dst.fRowBytes + x];
+    };
+    const int cx = dst.fBounds.width() / 2,
+              cy = dst.fBounds.height() / 2;
+    // With sigma comparable to the rect size the center is well below full
+    // coverage but still substantial; the extreme corner must fade out.
+    REPORTER_ASSERT(reporter, value(cx, cy) > 100);
+    REPORTER_ASSERT(reporter, value(0, 0) < 8);
+    // The profile is monotonically non-trivial: midway out is between the two.
+    REPORTER_ASSERT(reporter, value(cx / 2, cy) < value(cx, cy));
+    REPORTER_ASSERT(reporter, value(cx / 2, cy) > value(0, cy));
+}
@@ -722,3 +722,69 @@ DEF_TEST(canvas_markctm, reporter) {
     // found the previous one
     REPORTER_ASSERT(reporter, canvas.findMarkedCTM(id_a, &m) && m == a1);
 }
+
+DEF_TEST(Canvas_drawImageRectBatch, reporter) {
+    // Build a small sprite sheet with distinct quadrants.
+    SkBitmap sheet;
+    sheet.allocN32Pixels(8, 8);
+    {
+        SkCanvas tmp(sheet);
+        tmp.clear(SK_ColorRED);
+        tmp.save();
+        tmp.clipRect(SkRect::MakeXYWH(4, 0, 4, 4));
+        tmp.clear(SK_ColorGREEN);
+        tmp.restore();
+        tmp.clipRect(SkRect::MakeXYWH(0, 4, 4, 4));
+        tmp.clear(SK_ColorBLUE);
+    }
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(sheet);
+
+    const SkCanvas::ImageRectEntry entries[] = {
+        { image.get(), SkRect::MakeXYWH(0, 0, 4, 4), SkRect::MakeXYWH( 0, 0, 16, 16) },
+        { image.get(), SkRect::MakeXYWH(4, 0, 4, 4), SkRect::MakeXYWH(16, 0, 16, 16) },
+        { image.get(), SkRect::MakeXYWH(0, 4, 4, 4), SkRect::MakeXYWH(32, 0, 16, 16) },
+        { nullptr,     SkRect::MakeXYWH(0, 0, 4, 4), SkRect::MakeXYWH(48, 0, 16, 16) },
+        { image.get(), SkRect::MakeEmpty(),          SkRect::MakeXYWH(48, 0, 16, 16) },
+    };
+
+    SkBitmap batched, individual;
+    batched.allocN32Pixels(64, 16);
+    individual.allocN32Pixels(64, 16);
+
+    {
+        SkCanvas canvas(batched);
+        canvas.clear(SK_ColorWHITE);
+        canvas.drawImageRectBatch(entries, SK_ARRAY_COUNT(entries));
+    }
+    {
+        SkCanvas canvas(individual);
+        canvas.clear(SK_ColorWHITE);
+        for (const auto& entry : entries) {
+            if (entry.fImage) {
+                canvas.drawImageRect(entry.fImage, entry.fSrcRect, entry.fDstRect, nullptr,
+                                     SkCanvas::kFast_SrcRectConstraint);
+            }
+        }
+    }
+
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            REPORTER_ASSERT(reporter, batched.getColor(x, y) == individual.getColor(x, y));
+        }
+    }
+
+    // Batches also record: playing back a picture of the batch must match too.
+    SkPictureRecorder recorder;
+    recorder.beginRecording(64, 16)->drawImageRectBatch(entries, SK_ARRAY_COUNT(entries));
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    {
+        SkCanvas canvas(batched);
+        canvas.clear(SK_ColorWHITE);
+        canvas.drawPicture(picture);
+    }
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            REPORTER_ASSERT(reporter, batched.getColor(x, y) == individual.getColor(x, y));
+        }
+    }
+}
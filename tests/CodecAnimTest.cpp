@@ -488,3 +488,47 @@ DEF_TEST(AnimCodecPlayer, r) {
         REPORTER_ASSERT(r, f1->bounds().size() == test.fSize);
     }
 }
+
+// The player keeps only a handful of composited frames cached; older frames are evicted and
+// recomposited on demand from the nearest cached frame in their dependency chain. Verify that
+// a second pass over an animation long enough to overflow the cache reproduces the first
+// pass's pixels exactly.
+DEF_TEST(AnimCodecPlayer_frameCache, r) {
+    auto data = GetResourceAsData("images/alphabetAnim.gif");
+    if (!data) {
+        return;
+    }
+
+    auto frameInfos = SkCodec::MakeFromData(data)->getFrameInfo();
+    REPORTER_ASSERT(r, frameInfos.size() > 4);
+
+    SkAnimCodecPlayer player(SkCodec::MakeFromData(data));
+
+    auto readPass = [&]() {
+        std::vector<SkBitmap> frames;
+        uint32_t start = 0;
+        for (const auto& info : frameInfos) {
+            player.seek(start + info.fDuration / 2);
+            start += info.fDuration;
+
+            auto image = player.getFrame();
+            REPORTER_ASSERT(r, image);
+
+            SkBitmap bm;
+            bm.allocPixels(image->imageInfo());
+            REPORTER_ASSERT(r, image->readPixels(bm.pixmap(), 0, 0));
+            frames.push_back(bm);
+        }
+        return frames;
+    };
+
+    auto firstPass = readPass();
+    auto secondPass = readPass();
+    REPORTER_ASSERT(r, firstPass.size() == secondPass.size());
+    for (size_t i = 0; i < firstPass.size(); ++i) {
+        const SkBitmap& a = firstPass[i];
+        const SkBitmap& b = secondPass[i];
+        REPORTER_ASSERT(r, a.computeByteSize() == b.computeByteSize());
+        REPORTER_ASSERT(r, !memcmp(a.getPixels(), b.getPixels(), a.computeByteSize()));
+    }
+}
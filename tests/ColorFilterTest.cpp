@@ -90,3 +90,41 @@ DEF_TEST(ColorFilter, reporter) {
         }
     }
 }
+
+DEF_TEST(ColorFilterComposedLUT, reporter) {
+    // Chains of three or more color filters collapse into a baked 3D LUT for opaque pixels.
+    // The LUT is trilinearly interpolated, so results must track the uncollapsed chain to
+    // within a small tolerance (well under one 8-bit step).
+    float brighten[20] = {1.2f, 0, 0, 0, 0.02f,
+                          0, 1.2f, 0, 0, 0.02f,
+                          0, 0, 1.2f, 0, 0.02f,
+                          0, 0, 0, 1, 0};
+    float desaturate[20] = {0.6f, 0.3f, 0.1f, 0, 0,
+                            0.2f, 0.7f, 0.1f, 0, 0,
+                            0.2f, 0.3f, 0.5f, 0, 0,
+                            0,    0,    0,    1, 0};
+    sk_sp<SkColorFilter> chain[] = {
+        SkColorFilters::Matrix(brighten),
+        SkColorFilters::Matrix(desaturate),
+        SkColorFilters::Blend(0xFF201008, SkBlendMode::kScreen),
+    };
+
+    sk_sp<SkColorFilter> composed = chain[2]->makeComposed(chain[1]->makeComposed(chain[0]));
+
+    SkRandom rand;
+    for (int i = 0; i < 100; i++) {
+        SkColor4f c = {rand.nextF(), rand.nextF(), rand.nextF(), 1.0f};
+
+        SkColor4f expected = c;
+        for (const auto& cf : chain) {
+            expected = cf->filterColor4f(expected, nullptr, nullptr);
+        }
+        SkColor4f actual = composed->filterColor4f(c, nullptr, nullptr);
+
+        REPORTER_ASSERT(reporter, actual.fA == 1.0f);
+        for (int ch = 0; ch < 3; ch++) {
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(actual.vec()[ch], expected.vec()[ch],
+                                                          1/255.0f));
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkCounters.h"
+#include "src/core/SkTaskGroup.h"
+#include "tests/Test.h"
+
+static const SkCounters::Value* find_counter(const SkCounters::Value values[], int n,
+                                             const char* name) {
+    for (int i = 0; i < n; i++) {
+        if (0 == strcmp(values[i].fName, name)) {
+            return &values[i];
+        }
+    }
+    return nullptr;
+}
+
+DEF_TEST(Counters, reporter) {
+    // Registering the same name twice returns the same counter.
+    SkCounters::Counter* a = SkCounters::Register("counters_test_a");
+    REPORTER_ASSERT(reporter, a == SkCounters::Register("counters_test_a"));
+
+    // Clear any deltas from earlier in the process before we start counting.
+    SkCounters::Value values[64];
+    SkCounters::Snapshot(values, 64);
+
+    for (int i = 0; i < 10; i++) {
+        SK_COUNTER_INCREMENT("counters_test_a");
+    }
+    SK_COUNTER_ADD("counters_test_b", 5);
+
+    int n = SkCounters::Snapshot(values, 64);
+    const SkCounters::Value* va = find_counter(values, n, "counters_test_a");
+    const SkCounters::Value* vb = find_counter(values, n, "counters_test_b");
+    REPORTER_ASSERT(reporter, va && va->fDelta == 10);
+    REPORTER_ASSERT(reporter, vb && vb->fDelta == 5);
+    REPORTER_ASSERT(reporter, va->fTotal >= va->fDelta);
+
+    // Deltas reset each snapshot; totals don't.
+    n = SkCounters::Snapshot(values, 64);
+    va = find_counter(values, n, "counters_test_a");
+    REPORTER_ASSERT(reporter, va && va->fDelta == 0 && va->fTotal >= 10);
+
+    // Counts from many threads all land, whichever shards they hit.
+    SkTaskGroup::Enabler enabler(4);
+    SkTaskGroup group;
+    group.batch(100, [](int) { SK_COUNTER_INCREMENT("counters_test_mt"); });
+    group.wait();
+
+    n = SkCounters::Snapshot(values, 64);
+    const SkCounters::Value* vmt = find_counter(values, n, "counters_test_mt");
+    REPORTER_ASSERT(reporter, vmt && vmt->fDelta == 100);
+}
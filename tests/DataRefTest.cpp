@@ -204,6 +204,12 @@ DEF_TEST(Data, reporter) {
     tmp = SkData::MakeSubset(r1.get(), 0, 0);
     assert_len(reporter, tmp, 0);
 
+    sk_sp<SkData> r4 = r1->makeSubset(7, 6);
+    assert_len(reporter, r4, 6);
+    assert_data(reporter, r4, "people", 6);
+    // the subset is a view into the parent's storage, not a copy
+    REPORTER_ASSERT(reporter, r4->bytes() == r1->bytes() + 7);
+
     test_cstring(reporter);
     test_files(reporter);
 }
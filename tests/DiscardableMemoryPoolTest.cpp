@@ -36,3 +36,32 @@ DEF_TEST(DiscardableMemoryPool, reporter) {
     REPORTER_ASSERT(reporter, !dm2->lock());
     REPORTER_ASSERT(reporter, 0 == pool->getRAMUsed());
 }
+
+DEF_TEST(HugePageDiscardableMemoryPool, reporter) {
+    sk_sp<SkDiscardableMemoryPool> pool(SkDiscardableMemoryPool::MakeHugePageBacked(1));
+    pool->setRAMBudget(3);
+    REPORTER_ASSERT(reporter, 0 == pool->getRAMUsed());
+
+    std::unique_ptr<SkDiscardableMemory> dm1(pool->create(100));
+    REPORTER_ASSERT(reporter, dm1->data() != nullptr);
+    // sizes round up to whole pages
+    REPORTER_ASSERT(reporter, pool->getRAMUsed() >= 100);
+    dm1->unlock();
+    REPORTER_ASSERT(reporter, 0 == pool->getRAMUsed());
+    REPORTER_ASSERT(reporter, !dm1->lock());
+
+    pool->setRAMBudget(1 << 20);
+    std::unique_ptr<SkDiscardableMemory> dm2(pool->create(200));
+    static_cast<char*>(dm2->data())[0] = 42;
+    const size_t used = pool->getRAMUsed();
+    REPORTER_ASSERT(reporter, used >= 200);
+    dm2->unlock();
+    // within budget: contents survive an unlock/lock cycle
+    REPORTER_ASSERT(reporter, used == pool->getRAMUsed());
+    REPORTER_ASSERT(reporter, dm2->lock());
+    REPORTER_ASSERT(reporter, 42 == static_cast<char*>(dm2->data())[0]);
+    dm2->unlock();
+    pool->dumpPool();
+    REPORTER_ASSERT(reporter, !dm2->lock());
+    REPORTER_ASSERT(reporter, 0 == pool->getRAMUsed());
+}
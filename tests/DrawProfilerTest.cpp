@@ -0,0 +1,95 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkMaskFilter.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "src/core/SkDrawProfiler.h"
+#include "src/utils/SkJSON.h"
+#include "src/utils/SkJSONWriter.h"
+#include "tests/Test.h"
+
+static SkString export_json() {
+    SkDynamicMemoryWStream stream;
+    SkJSONWriter writer(&stream);
+    SkDrawProfiler::ExportJson(&writer);
+    writer.flush();
+    SkString json(stream.bytesWritten());
+    stream.copyTo(json.writable_str());
+    return json;
+}
+
+DEF_TEST(DrawProfiler, r) {
+    auto surface = SkSurface::MakeRasterN32Premul(64, 64);
+    SkCanvas* canvas = surface->getCanvas();
+
+    // Draws made while the profiler is disabled must not be recorded.
+    canvas->drawRect(SkRect::MakeWH(10, 10), SkPaint());
+
+    SkDrawProfiler::Enable(/*samplePeriod=*/1);
+
+    SkPaint blurred;
+    blurred.setAntiAlias(true);
+    blurred.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 2.f));
+    canvas->drawRect(SkRect::MakeXYWH(4, 4, 20, 20), blurred);
+
+    SkPoint pts[] = {{0, 0}, {64, 0}};
+    SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    SkPaint gradient;
+    gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                    SkTileMode::kClamp));
+    canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeWH(30, 30), 5, 5), gradient);
+
+    SkDrawProfiler::Disable();
+
+    SkString json = export_json();
+    skjson::DOM dom(json.c_str(), json.size());
+    const skjson::ObjectValue* root = dom.root();
+    REPORTER_ASSERT(r, root);
+
+    REPORTER_ASSERT(r, *(*root)["samplePeriod"].as<skjson::NumberValue>() == 1);
+    REPORTER_ASSERT(r, *(*root)["drawCount"].as<skjson::NumberValue>() == 2);
+    REPORTER_ASSERT(r, *(*root)["sampleCount"].as<skjson::NumberValue>() == 2);
+
+    const skjson::ArrayValue* samples =
+            static_cast<const skjson::ArrayValue*>((*root)["samples"]);
+    REPORTER_ASSERT(r, samples && samples->size() == 2);
+
+    const skjson::ObjectValue* rect = static_cast<const skjson::ObjectValue*>((*samples)[0]);
+    REPORTER_ASSERT(r, rect);
+    REPORTER_ASSERT(r, 0 == strcmp((*rect)["op"].as<skjson::StringValue>().begin(), "rect"));
+    uint32_t flags = (uint32_t)*(*rect)["flags"].as<skjson::NumberValue>();
+    REPORTER_ASSERT(r, flags & SkDrawProfiler::kAntiAlias_Flag);
+    REPORTER_ASSERT(r, flags & SkDrawProfiler::kMaskFilter_Flag);
+    REPORTER_ASSERT(r, !(flags & SkDrawProfiler::kShader_Flag));
+
+    const skjson::ObjectValue* rrect = static_cast<const skjson::ObjectValue*>((*samples)[1]);
+    REPORTER_ASSERT(r, rrect);
+    REPORTER_ASSERT(r, 0 == strcmp((*rrect)["op"].as<skjson::StringValue>().begin(), "rrect"));
+    REPORTER_ASSERT(r, (uint32_t)*(*rrect)["flags"].as<skjson::NumberValue>() &
+                       SkDrawProfiler::kShader_Flag);
+    REPORTER_ASSERT(r, 0 == strcmp((*rrect)["shader"].as<skjson::StringValue>().begin(),
+                                   "gradient"));
+
+    // A period > 1 only records a subset of draws.
+    SkDrawProfiler::Enable(/*samplePeriod=*/4);
+    for (int i = 0; i < 16; ++i) {
+        canvas->drawRect(SkRect::MakeWH(8, 8), SkPaint());
+    }
+    SkDrawProfiler::Disable();
+
+    json = export_json();
+    skjson::DOM dom2(json.c_str(), json.size());
+    const skjson::ObjectValue* root2 = dom2.root();
+    REPORTER_ASSERT(r, root2);
+    REPORTER_ASSERT(r, *(*root2)["drawCount"].as<skjson::NumberValue>() == 16);
+    REPORTER_ASSERT(r, *(*root2)["sampleCount"].as<skjson::NumberValue>() == 4);
+}
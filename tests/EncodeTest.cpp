@@ -218,6 +218,78 @@ DEF_TEST(Encode_JpegDownsample, r) {
     REPORTER_ASSERT(r, almost_equals(bm1, bm2, 60));
 }
 
+DEF_TEST(Encode_JpegParallel, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/mandrill_128.png", &bitmap)) {
+        return;
+    }
+
+    SkPixmap full;
+    REPORTER_ASSERT(r, bitmap.peekPixels(&full));
+
+    // Also cover a height that is not a multiple of the MCU size, so the last band is
+    // ragged.
+    SkPixmap ragged;
+    REPORTER_ASSERT(r, full.extractSubset(&ragged, SkIRect::MakeWH(full.width(), 100)));
+
+    for (const SkPixmap& src : { full, ragged }) {
+        SkDynamicMemoryWStream serialDst, parallelDst;
+        SkJpegEncoder::Options options;
+        REPORTER_ASSERT(r, SkJpegEncoder::Encode(&serialDst, src, options));
+
+        options.fParallel = true;
+        REPORTER_ASSERT(r, SkJpegEncoder::Encode(&parallelDst, src, options));
+
+        // The parallel encode uses the fixed Huffman tables and adds restart markers, so
+        // the bytes differ, but the quantized coefficients -- and therefore the decoded
+        // pixels -- must match the serial encode exactly.
+        SkBitmap serialBm, parallelBm;
+        REPORTER_ASSERT(r, SkImage::MakeFromEncoded(serialDst.detachAsData())
+                                   ->asLegacyBitmap(&serialBm));
+        REPORTER_ASSERT(r, SkImage::MakeFromEncoded(parallelDst.detachAsData())
+                                   ->asLegacyBitmap(&parallelBm));
+        REPORTER_ASSERT(r, serialBm.dimensions() == parallelBm.dimensions());
+        REPORTER_ASSERT(r, almost_equals(serialBm, parallelBm, 0));
+    }
+}
+
+DEF_TEST(Encode_PngParallel, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/mandrill_128.png", &bitmap)) {
+        return;
+    }
+
+    SkPixmap full;
+    REPORTER_ASSERT(r, bitmap.peekPixels(&full));
+
+    // Also cover a row count that does not divide evenly into bands.
+    SkPixmap ragged;
+    REPORTER_ASSERT(r, full.extractSubset(&ragged, SkIRect::MakeWH(full.width(), 99)));
+
+    for (const SkPixmap& src : { full, ragged }) {
+        for (auto filterFlags : { SkPngEncoder::FilterFlag::kAll,
+                                  SkPngEncoder::FilterFlag::kNone,
+                                  SkPngEncoder::FilterFlag::kUp }) {
+            SkDynamicMemoryWStream dst;
+            SkPngEncoder::Options options;
+            options.fFilterFlags = filterFlags;
+            options.fParallel = true;
+            REPORTER_ASSERT(r, SkPngEncoder::Encode(&dst, src, options));
+
+            // Png is lossless, so the parallel encode must decode back to the source
+            // pixels exactly.
+            SkBitmap decoded;
+            REPORTER_ASSERT(r, SkImage::MakeFromEncoded(dst.detachAsData())
+                                       ->asLegacyBitmap(&decoded));
+            REPORTER_ASSERT(r, decoded.dimensions() == src.dimensions());
+            for (int y = 0; y < src.height(); y++) {
+                REPORTER_ASSERT(r, !memcmp(decoded.getAddr32(0, y), src.addr32(0, y),
+                                           src.width() * sizeof(uint32_t)));
+            }
+        }
+    }
+}
+
 static inline void pushComment(
         std::vector<std::string>& comments, const char* keyword, const char* text) {
     comments.push_back(keyword);
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "include/private/SkSemaphore.h"
+#include "src/core/SkTaskGroup.h"
+#include "tests/Test.h"
+
+#include <atomic>
+#include <vector>
+
+static void run_all_tasks(skiatest::Reporter* reporter, SkExecutor* executor) {
+    static constexpr int kTasks = 1000;
+
+    std::atomic<int> count{0};
+    SkSemaphore done;
+    for (int i = 0; i < kTasks; i++) {
+        executor->addWithPriority([&] {
+            count.fetch_add(1);
+            done.signal();
+        }, (SkExecutor::Priority)(i % 3));
+    }
+    for (int i = 0; i < kTasks; i++) {
+        done.wait();
+    }
+    REPORTER_ASSERT(reporter, count.load() == kTasks);
+}
+
+DEF_TEST(Executor_workStealing, reporter) {
+    // Every task submitted at any priority runs exactly once, whether there are fewer or more
+    // threads than queues being stolen from.
+    for (int threads : {1, 2, 8}) {
+        std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(threads);
+        run_all_tasks(reporter, pool.get());
+    }
+
+    // Executors without priority support fall back to plain add().
+    std::unique_ptr<SkExecutor> fifo = SkExecutor::MakeFIFOThreadPool(2);
+    run_all_tasks(reporter, fifo.get());
+}
+
+DEF_TEST(Executor_workStealingTaskGroup, reporter) {
+    // A work-stealing pool works as the executor backing SkTaskGroup.
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    std::atomic<int> count{0};
+    SkTaskGroup group(*pool);
+    for (int i = 0; i < 100; i++) {
+        group.add([&] { count.fetch_add(1); });
+    }
+    group.wait();
+    REPORTER_ASSERT(reporter, count.load() == 100);
+}
+
+DEF_TEST(TaskGroup_parallelFor, reporter) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(4);
+
+    // Each index in [0,N) runs exactly once, for explicit and automatic grain sizes,
+    // including ranges smaller than one grain.
+    for (int N : {1, 7, 1000}) {
+        for (int grain : {0, 1, 16, 2000}) {
+            std::vector<std::atomic<int>> runs(N);
+            SkTaskGroup group(*pool);
+            group.parallelFor(N, grain, [&](int i) { runs[i].fetch_add(1); });
+            group.wait();
+            for (int i = 0; i < N; i++) {
+                REPORTER_ASSERT(reporter, runs[i].load() == 1);
+            }
+        }
+    }
+
+    // Empty ranges are a no-op.
+    SkTaskGroup group(*pool);
+    group.parallelFor(0, 0, [&](int) { SK_ABORT("should not run"); });
+    group.wait();
+}
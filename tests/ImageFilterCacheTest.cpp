@@ -154,6 +154,41 @@ static void test_explicit_purging(skiatest::Reporter* reporter,
     REPORTER_ASSERT(reporter, !cache->get(key2, &foundImage));
 }
 
+// Content-keyed entries live in a separate namespace from instance-keyed ones, are not purged
+// when a filter instance is destroyed, and are still removed by purge().
+static void test_persistent_entries(skiatest::Reporter* reporter,
+                                    const sk_sp<SkSpecialImage>& image) {
+    static const size_t kCacheSize = 1000000;
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(kCacheSize));
+
+    SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilterCacheKey instanceKey(0, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+    SkImageFilterCacheKey contentKey(0, SkMatrix::I(), clip, image->uniqueID(), image->subset(),
+                                     /*contentKeyed=*/true);
+
+    SkIPoint offset = SkIPoint::Make(3, 4);
+    auto filter = make_filter();
+    cache->set(instanceKey, filter.get(),
+               skif::FilterResult<For::kOutput>(image, skif::LayerSpace<SkIPoint>(offset)));
+
+    // Same numeric id, but the content-keyed namespace is distinct.
+    skif::FilterResult<For::kOutput> foundImage;
+    REPORTER_ASSERT(reporter, !cache->get(contentKey, &foundImage));
+
+    cache->set(contentKey, nullptr,
+               skif::FilterResult<For::kOutput>(image, skif::LayerSpace<SkIPoint>(offset)));
+    REPORTER_ASSERT(reporter, cache->get(contentKey, &foundImage));
+
+    // Purging the filter instance removes only its own entry; the persistent one survives.
+    cache->purgeByImageFilter(filter.get());
+    filter = nullptr;
+    REPORTER_ASSERT(reporter, !cache->get(instanceKey, &foundImage));
+    REPORTER_ASSERT(reporter, cache->get(contentKey, &foundImage));
+
+    cache->purge();
+    REPORTER_ASSERT(reporter, !cache->get(contentKey, &foundImage));
+}
+
 DEF_TEST(ImageFilterCache_RasterBacked, reporter) {
     SkBitmap srcBM = create_bm();
 
@@ -169,6 +204,7 @@ DEF_TEST(ImageFilterCache_RasterBacked, reporter) {
     test_dont_find_if_diff_key(reporter, fullImg, subsetImg);
     test_internal_purge(reporter, fullImg);
     test_explicit_purging(reporter, fullImg, subsetImg);
+    test_persistent_entries(reporter, fullImg);
 }
 
 
@@ -188,6 +224,7 @@ static void test_image_backed(skiatest::Reporter* reporter,
     test_dont_find_if_diff_key(reporter, fullImg, subsetImg);
     test_internal_purge(reporter, fullImg);
     test_explicit_purging(reporter, fullImg, subsetImg);
+    test_persistent_entries(reporter, fullImg);
 }
 
 DEF_TEST(ImageFilterCache_ImageBackedRaster, reporter) {
@@ -1972,3 +1972,53 @@ DEF_TEST(ImageSourceBounds, reporter) {
                                                              &input));
 }
 
+
+DEF_TEST(ImageFilterTiledEvaluation, reporter) {
+    // Evaluating a DAG through filterImageTiled() must match the serial filterImage() result
+    // pixel for pixel, including the overlap each tile's blur needs from its neighbors.
+    static const int kWidth = 600, kHeight = 420;   // spans several 256x256 tiles
+
+    SkBitmap srcBM;
+    srcBM.allocN32Pixels(kWidth, kHeight);
+    SkCanvas srcCanvas(srcBM);
+    srcCanvas.clear(SK_ColorTRANSPARENT);
+    SkPaint paint;
+    paint.setColor(SK_ColorGREEN);
+    srcCanvas.drawCircle(kWidth / 2.0f, kHeight / 2.0f, kHeight / 3.0f, paint);
+    paint.setColor(SK_ColorRED);
+    srcCanvas.drawRect(SkRect::MakeXYWH(30, 40, 200, 100), paint);
+    sk_sp<SkSpecialImage> srcImg(
+            SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(kWidth, kHeight), srcBM));
+
+    sk_sp<SkImageFilter> filter = make_grayscale(SkImageFilters::Blur(5, 5, nullptr), nullptr);
+
+    SkImageFilter_Base::Context ctx(SkMatrix::I(), SkIRect::MakeWH(kWidth, kHeight), nullptr,
+                                    kN32_SkColorType, nullptr, srcImg.get());
+
+    SkIPoint serialOffset, tiledOffset;
+    sk_sp<SkSpecialImage> serialImg(
+            as_IFB(filter)->filterImage(ctx).imageAndOffset(&serialOffset));
+    sk_sp<SkSpecialImage> tiledImg(
+            as_IFB(filter)->filterImageTiled(ctx).imageAndOffset(&tiledOffset));
+    REPORTER_ASSERT(reporter, serialImg && tiledImg);
+    if (!serialImg || !tiledImg) {
+        return;
+    }
+
+    SkBitmap serialBM, tiledBM;
+    REPORTER_ASSERT(reporter, special_image_to_bitmap(serialImg.get(), &serialBM));
+    REPORTER_ASSERT(reporter, special_image_to_bitmap(tiledImg.get(), &tiledBM));
+
+    // Both results cover the clip; compare them over it, accounting for each result's offset.
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            SkColor serial = serialBM.getColor(x - serialOffset.x(), y - serialOffset.y());
+            SkColor tiled = tiledBM.getColor(x - tiledOffset.x(), y - tiledOffset.y());
+            REPORTER_ASSERT(reporter, serial == tiled,
+                            "mismatch at (%d, %d): %08x != %08x", x, y, serial, tiled);
+            if (serial != tiled) {
+                return;
+            }
+        }
+    }
+}
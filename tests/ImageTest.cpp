@@ -12,6 +12,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkPicture.h"
@@ -22,6 +23,7 @@
 #include "include/core/SkSurface.h"
 #include "include/gpu/GrContextThreadSafeProxy.h"
 #include "include/gpu/GrDirectContext.h"
+#include "include/private/SkSemaphore.h"
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkImagePriv.h"
@@ -785,6 +787,44 @@ static void test_peek(skiatest::Reporter* reporter, SkImage* image, bool expectP
         REPORTER_ASSERT(reporter, SkPreMultiplyColor(SK_ColorWHITE) == *pm.addr32(0, 0));
     }
 }
+DEF_TEST(ImagePrepareForDrawing, reporter) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(1);
+
+    // Raster images have their pixels already; the callback fires immediately.
+    {
+        sk_sp<SkImage> image(create_image());
+        bool called = false;
+        image->prepareForDrawing(executor.get(),
+                                 [](SkImage::PrepareForDrawingContext ctx, bool success) {
+                                     *(bool*)ctx = success;
+                                 }, &called);
+        REPORTER_ASSERT(reporter, called);
+    }
+
+    // Lazy images decode on the executor, and the decoded pixels land in the raster cache.
+    {
+        sk_sp<SkImage> image(create_codec_image());
+        REPORTER_ASSERT(reporter, image->isLazyGenerated());
+
+        SkSemaphore done;
+        struct Result {
+            SkSemaphore* fDone;
+            bool         fSuccess = false;
+        } result = { &done };
+        image->prepareForDrawing(executor.get(),
+                                 [](SkImage::PrepareForDrawingContext ctx, bool success) {
+                                     auto* result = (Result*)ctx;
+                                     result->fSuccess = success;
+                                     result->fDone->signal();
+                                 }, &result);
+        done.wait();
+        REPORTER_ASSERT(reporter, result.fSuccess);
+
+        SkBitmap cached;
+        REPORTER_ASSERT(reporter, as_IB(image)->getROPixels(&cached));
+    }
+}
+
 DEF_TEST(ImagePeek, reporter) {
     sk_sp<SkImage> image(create_image());
     test_peek(reporter, image.get(), true);
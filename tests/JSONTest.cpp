@@ -7,6 +7,7 @@
 
 #include "tests/Test.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "src/core/SkArenaAlloc.h"
@@ -415,6 +416,43 @@ DEF_TEST(JSON_DOM_build, reporter) {
                                             "}");
 }
 
+DEF_TEST(JSON_Binary, reporter) {
+    static constexpr char json[] = "{"
+                                       "\"null\": null,"
+                                       "\"bools\": [true, false],"
+                                       "\"int\": 42,"
+                                       "\"float\": 42.75,"
+                                       "\"short_string\": \"foo\","
+                                       "\"long_string\": \" foo bar baz \","
+                                       "\"nested\": { \"array\": [1, [], {}, \"\"] }"
+                                   "}";
+
+    const DOM dom(json, strlen(json));
+    REPORTER_ASSERT(reporter, dom.root().is<ObjectValue>());
+    REPORTER_ASSERT(reporter, !DOM::IsBinary(json, strlen(json)));
+
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+    const auto blob = stream.detachAsData();
+    REPORTER_ASSERT(reporter, DOM::IsBinary(blob->data(), blob->size()));
+
+    const auto bdom = DOM::MakeFromBinary(blob->data(), blob->size());
+    REPORTER_ASSERT(reporter, bdom);
+    REPORTER_ASSERT(reporter, bdom->root().toString().equals(dom.root().toString()));
+
+    // Truncated blobs are rejected.
+    for (size_t len = 0; len < blob->size(); ++len) {
+        REPORTER_ASSERT(reporter, !DOM::MakeFromBinary(blob->data(), len));
+    }
+
+    // ... and so are corrupted tag bytes.
+    {
+        auto corrupt = SkData::MakeWithCopy(blob->data(), blob->size());
+        static_cast<uint8_t*>(corrupt->writable_data())[8] = 0xff;
+        REPORTER_ASSERT(reporter, !DOM::MakeFromBinary(corrupt->data(), corrupt->size()));
+    }
+}
+
 DEF_TEST(JSON_ParseNumber, reporter) {
     static constexpr struct {
         const char* string;
@@ -131,6 +131,33 @@ DEF_TEST(M44_v4, reporter) {
     REPORTER_ASSERT(reporter, (c0 * r0 == SkV4{c0.x*r0.x, c0.y*r0.y, c0.z*r0.z, c0.w*r0.w}));
 }
 
+DEF_TEST(M44_mapPoints, reporter) {
+    SkM44 m( 1,  2,  3,  4,
+             5,  6,  7,  8,
+             9, 10, 11, 12,
+            13, 14, 15, 16);
+
+    SkV4 pts[] = {
+        {0, 0, 0, 1},
+        {1, 2, 3, 4},
+        {-1, 0.5f, 2, 0},
+        {4, 3, 2, 1},
+    };
+    constexpr int kCount = (int)SK_ARRAY_COUNT(pts);
+
+    SkV4 dst[kCount];
+    m.mapPoints(dst, pts, kCount);
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, dst[i] == m * pts[i]);
+    }
+
+    // mapping in place gives the same answers
+    m.mapPoints(pts, pts, kCount);
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, pts[i] == dst[i]);
+    }
+}
+
 DEF_TEST(M44_rotate, reporter) {
     const SkV3 x = {1, 0, 0},
                y = {0, 1, 0},
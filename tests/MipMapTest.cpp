@@ -204,6 +204,36 @@ DEF_TEST(MipMap_ComputeLevelSize, reporter) {
     }
 }
 
+#include "src/core/SkTaskGroup.h"
+
+DEF_TEST(MipMap_Incremental, reporter) {
+    SkBitmap bm;
+    make_bitmap(&bm, 256, 256);
+    bm.eraseColor(SK_ColorRED);
+
+    SkTaskGroup::Enabler enabler(2);
+    SkTaskGroup taskGroup;
+    sk_sp<SkMipmap> mm(SkMipmap::Build(bm, nullptr, &taskGroup));
+    REPORTER_ASSERT(reporter, mm);
+    REPORTER_ASSERT(reporter, mm->countLevels() == 8);
+    // level 1 is always built synchronously
+    REPORTER_ASSERT(reporter, mm->countReadyLevels() >= 1);
+
+    // while the deferred build runs, extractLevel serves the deepest ready level
+    SkMipmap::Level level;
+    REPORTER_ASSERT(reporter, mm->extractLevel(SkSize::Make(0.01f, 0.01f), &level));
+    REPORTER_ASSERT(reporter, level.fPixmap.addr());
+    REPORTER_ASSERT(reporter,
+                    level.fPixmap.width() >= (256 >> mm->countReadyLevels()));
+
+    taskGroup.wait();
+    REPORTER_ASSERT(reporter, mm->countReadyLevels() == mm->countLevels());
+    for (int i = 0; i < mm->countLevels(); ++i) {
+        REPORTER_ASSERT(reporter, mm->getLevel(i, &level));
+        REPORTER_ASSERT(reporter, *level.fPixmap.addr32(0, 0) == SkPreMultiplyColor(SK_ColorRED));
+    }
+}
+
 DEF_TEST(MipMap_F16, reporter) {
     SkBitmap bmp;
     bmp.allocPixels(SkImageInfo::Make(10, 10, kRGBA_F16_SkColorType, kPremul_SkAlphaType));
@@ -19,6 +19,7 @@
 #include "src/core/SkRecorder.h"
 #include "src/utils/SkMultiPictureDocument.h"
 #include "tests/Test.h"
+#include "tools/MultiFrameCapture.h"
 #include "tools/SkSharingProc.h"
 
 namespace {
@@ -218,4 +219,65 @@ DEF_TEST(Serialize_and_deserialize_multi_skp, reporter) {
         compareRecords(record, expectedRecords[i], i, reporter);
         i++;
     }
+
+    // Read one page directly through the offset index and confirm it matches the
+    // sequentially-read copy. (Reuses dprocs so shared images resolve by index.)
+    const int kRandomAccessPage = NUM_FRAMES / 2;
+    SkDocumentPage page;
+    REPORTER_ASSERT(reporter,
+        SkMultiPictureDocumentReadPage(writtenStream.get(), kRandomAccessPage, &page, &dprocs),
+        "Failed while reading single page from MultiPictureDocument");
+    REPORTER_ASSERT(reporter, page.fSize.width() == WIDTH && page.fSize.height() == HEIGHT,
+        "Single-page read returned wrong page size");
+    SkRecord randomAccessRecord;
+    resultRecorder.reset(&randomAccessRecord, page.fPicture->cullRect(),
+                         SkRecorder::PlaybackTop_DrawPictureMode, nullptr);
+    page.fPicture->playback(&resultRecorder);
+    compareRecords(randomAccessRecord, expectedRecords[kRandomAccessPage], kRandomAccessPage,
+                   reporter);
+}
+
+DEF_TEST(Serialize_and_restore_multi_frame_capture, reporter) {
+    static const int WIDTH = 256;
+    static const int HEIGHT = 256;
+
+    // Record three frames through the capture helper, sharing one image between them.
+    auto surf = SkSurface::MakeRaster(SkImageInfo::MakeN32Premul(8, 8));
+    surf->getCanvas()->clear(SK_ColorGREEN);
+    sk_sp<SkImage> image = surf->makeImageSnapshot();
+
+    const int kFrames = 3;
+    MultiFrameCapture capture;
+    for (int i = 0; i < kFrames; i++) {
+        SkCanvas* canvas = capture.beginFrame(WIDTH, HEIGHT);
+        canvas->drawImage(image, SkIntToScalar(i), 0);
+        capture.endFrame();
+    }
+    REPORTER_ASSERT(reporter, capture.frameCount() == kFrames);
+
+    SkDynamicMemoryWStream buffer;
+    REPORTER_ASSERT(reporter, capture.writeTo(&buffer), "Failed to write capture");
+    std::unique_ptr<SkStreamAsset> stream = buffer.detachAsStream();
+
+    REPORTER_ASSERT(reporter,
+        SkMultiPictureDocumentReadPageCount(stream.get()) == kFrames,
+        "Capture has wrong frame count");
+
+    SkSharingDeserialContext deserialContext;
+    SkDeserialProcs dprocs;
+    dprocs.fImageProc = SkSharingDeserialContext::deserializeImage;
+    dprocs.fImageCtx = &deserialContext;
+
+    std::vector<SkDocumentPage> frames(kFrames);
+    REPORTER_ASSERT(reporter,
+        SkMultiPictureDocumentRead(stream.get(), frames.data(), kFrames, &dprocs),
+        "Failed to read capture");
+    for (const SkDocumentPage& frame : frames) {
+        REPORTER_ASSERT(reporter, frame.fPicture);
+        REPORTER_ASSERT(reporter, frame.fSize.width() == WIDTH &&
+                                  frame.fSize.height() == HEIGHT);
+    }
+    // The image was serialized once and referenced by the other two frames.
+    REPORTER_ASSERT(reporter, deserialContext.fImages.size() == 1,
+        "Expected one shared image, got %zu", deserialContext.fImages.size());
 }
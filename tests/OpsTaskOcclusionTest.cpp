@@ -0,0 +1,59 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/gpu/GrDirectContext.h"
+#include "include/private/SkColorData.h"
+#include "src/core/SkBlendModePriv.h"
+#include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrOpsTask.h"
+#include "src/gpu/GrRenderTargetContext.h"
+#include "tests/Test.h"
+
+static void fill_rect(GrRenderTargetContext* rtc, const SkRect& rect, const SkPMColor4f& color,
+                      SkBlendMode blendMode) {
+    GrPaint paint;
+    paint.setColor4f(color);
+    paint.setXPFactory(SkBlendMode_AsXPFactory(blendMode));
+    rtc->fillRectToRect(nullptr, std::move(paint), GrAA::kNo, SkMatrix::I(), rect, rect);
+}
+
+// When an opsTask is closed, chains whose bounds a later op opaquely overwrites should be culled,
+// while draws the occluder only partially covers must survive.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(OpsTaskOcclusionCull, reporter, ctxInfo) {
+    auto dContext = ctxInfo.directContext();
+
+    std::unique_ptr<GrRenderTargetContext> rtc = GrRenderTargetContext::Make(
+            dContext, GrColorType::kRGBA_8888, nullptr, SkBackingFit::kExact, {128, 128});
+
+    // An occludable draw. The non-src-over blend modes used here keep the paints non-trivial so
+    // these draws can neither merge nor chain with the occluder below.
+    fill_rect(rtc.get(), SkRect::MakeLTRB(10, 10, 60, 60), SK_PMColor4fWHITE,
+              SkBlendMode::kDarken);
+
+    // A draw outside the occluder's coverage; it must survive the cull.
+    fill_rect(rtc.get(), SkRect::MakeLTRB(100, 100, 127, 127), SK_PMColor4fWHITE,
+              SkBlendMode::kLighten);
+
+    // The occluder: an opaque, non-AA, unclipped fill. It stops short of the full target so the
+    // draw isn't converted into a fullscreen clear.
+    fill_rect(rtc.get(), SkRect::MakeLTRB(1, 1, 90, 90), {0.f, 0.f, 1.f, 1.f},
+              SkBlendMode::kSrcOver);
+
+    GrOpsTask* opsTask = rtc->testingOnly_PeekLastOpsTask();
+    REPORTER_ASSERT(reporter, opsTask->numOpChains() == 3);
+
+    // Drawing to a second target closes the first opsTask, which runs the occlusion cull.
+    std::unique_ptr<GrRenderTargetContext> rtc2 = GrRenderTargetContext::Make(
+            dContext, GrColorType::kRGBA_8888, nullptr, SkBackingFit::kExact, {128, 128});
+    fill_rect(rtc2.get(), SkRect::MakeLTRB(0, 0, 16, 16), SK_PMColor4fWHITE,
+              SkBlendMode::kSrcOver);
+
+    REPORTER_ASSERT(reporter, opsTask->isClosed());
+    REPORTER_ASSERT(reporter, opsTask->numOpChains() == 2);
+
+    dContext->flushAndSubmit();
+}
@@ -442,6 +442,27 @@ DEF_TEST(SkPDF_Clusterator, reporter) {
             REPORTER_ASSERT(reporter, clusterator.next() == expectation);
         }
     }
+    {
+        // Reversed (RTL) clusters, monotonically decreasing to zero.
+        constexpr unsigned len = 5;
+        const uint32_t clusters[len] = { 6, 4, 4, 2, 0 };
+        const SkGlyphID glyphs[len] = { 21, 22, 23, 24, 25 };
+        SkPoint pos[len] = {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}};
+        const char text[] = "abcdefg";
+        SkGlyphRun run = make_run(len, glyphs, pos, font, clusters, strlen(text), text);
+        SkClusterator clusterator(run);
+        REPORTER_ASSERT(reporter, clusterator.reversedChars());
+        SkClusterator::Cluster expectations[] = {
+            {&text[6], 1, 0, 1},
+            {&text[4], 2, 1, 2},
+            {&text[2], 2, 3, 1},
+            {&text[0], 2, 4, 1},
+            {nullptr, 0, 0, 0},
+        };
+        for (const auto& expectation : expectations) {
+            REPORTER_ASSERT(reporter, clusterator.next() == expectation);
+        }
+    }
 }
 
 DEF_TEST(fuzz875632f0, reporter) {
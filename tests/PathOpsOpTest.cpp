@@ -12542,3 +12542,23 @@ DEF_TEST(PathOpsRepOp, reporter) {
   for (int index = 0; index < 1; ++index)
     RunTestSet(reporter, repTests, SK_ARRAY_COUNT(repTests), nullptr, nullptr, nullptr, false);
 }
+
+DEF_TEST(PathOpsOpContextReuse, reporter) {
+    // Repeated ops through one context must match the context-free results.
+    SkOpContext context;
+    for (int index = 0; index < 8; ++index) {
+        SkPath one, two;
+        one.addRect({0, 0, 60.f + index, 60.f});
+        one.addCircle(30, 30, 20);
+        two.addCircle(40.f + index, 40, 25);
+        two.addRect({20, 20, 80, 80.f + index});
+        for (SkPathOp op : { kIntersect_SkPathOp, kUnion_SkPathOp, kDifference_SkPathOp,
+                             kXOR_SkPathOp }) {
+            SkPath plain, reused;
+            bool plainOk = Op(one, two, op, &plain);
+            bool reusedOk = Op(one, two, op, &reused, &context);
+            REPORTER_ASSERT(reporter, plainOk == reusedOk);
+            REPORTER_ASSERT(reporter, plain == reused);
+        }
+    }
+}
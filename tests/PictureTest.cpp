@@ -11,7 +11,9 @@
 #include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontStyle.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -29,8 +31,11 @@
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkClipOpPriv.h"
 #include "src/core/SkMiniRecorder.h"
+#include "src/core/SkPictureCommon.h"
+#include "src/core/SkPictureData.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRectPriv.h"
+#include "src/utils/SkParallelPicturePlayback.h"
 #include "tests/Test.h"
 
 #include <memory>
@@ -752,6 +757,71 @@ DEF_TEST(MiniRecorderLeftHanging, r) {
     // Don't call rec.detachPicture().  Test succeeds by not asserting or leaking the shader.
 }
 
+DEF_TEST(MiniRecorder_SingleOpPictures, r) {
+    SkBitmap bm;
+    bm.allocN32Pixels(16, 16);
+    bm.eraseColor(SK_ColorGREEN);
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bm);
+    const SkRect dst = SkRect::MakeXYWH(10,10,20,20);
+
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+
+    // A lone drawImageRect should become a mini picture, culled to its dst rect.
+    auto canvas = recorder.beginRecording(SkRectPriv::MakeLargest(), &factory);
+    canvas->drawImageRect(image, dst, nullptr);
+    sk_sp<SkPicture> imagePic = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, imagePic->approximateOpCount() == 1);
+    REPORTER_ASSERT(r, imagePic->cullRect() == dst);
+
+    // So should a lone drawPicture, with its matrix folded into the cull.
+    SkMatrix translate = SkMatrix::Translate(5,5);
+    canvas = recorder.beginRecording(SkRectPriv::MakeLargest(), &factory);
+    canvas->drawPicture(imagePic, &translate, nullptr);
+    sk_sp<SkPicture> picturePic = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, picturePic->approximateOpCount() == 1);
+    REPORTER_ASSERT(r, picturePic->cullRect() == dst.makeOffset(5,5));
+
+    // A second op must flush the mini op back into the full record.
+    canvas = recorder.beginRecording(SkRect::MakeWH(48,48));
+    canvas->drawImageRect(image, dst, nullptr);
+    canvas->drawRect(SkRect::MakeWH(8,8), SkPaint());
+    sk_sp<SkPicture> bigPic = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, bigPic->approximateOpCount() == 2);
+
+    // All three must play back the same pixels as the equivalent direct draws.
+    SkBitmap direct, replayed;
+    direct.allocN32Pixels(48, 48);
+    replayed.allocN32Pixels(48, 48);
+    SkCanvas dc(direct), rc(replayed);
+    auto check = [&](const char* desc) {
+        for (int y = 0; y < 48; y++) {
+            REPORTER_ASSERT(r, 0 == memcmp(direct.getAddr32(0,y), replayed.getAddr32(0,y),
+                                           48 * sizeof(SkPMColor)), desc);
+        }
+        dc.clear(SK_ColorWHITE);
+        rc.clear(SK_ColorWHITE);
+    };
+    dc.clear(SK_ColorWHITE);
+    rc.clear(SK_ColorWHITE);
+
+    dc.drawImageRect(image, dst, nullptr);
+    rc.drawPicture(imagePic);
+    check("drawImageRect");
+
+    dc.save();
+    dc.concat(translate);
+    dc.drawImageRect(image, dst, nullptr);
+    dc.restore();
+    rc.drawPicture(picturePic);
+    check("drawPicture");
+
+    dc.drawImageRect(image, dst, nullptr);
+    dc.drawRect(SkRect::MakeWH(8,8), SkPaint());
+    rc.drawPicture(bigPic);
+    check("flushed");
+}
+
 DEF_TEST(Picture_preserveCullRect, r) {
     SkPictureRecorder recorder;
 
@@ -961,3 +1031,151 @@ DEF_TEST(Picture_fillsBBH, r) {
                         "results.size() == %d, want %d\n", (int)results.size(), n);
     }
 }
+
+DEF_TEST(Picture_ParallelTiledPlayback, r) {
+    // Record a picture with plenty of overlapping draws and an R-tree so each
+    // tile can cull the ops that don't touch it.
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* rc = recorder.beginRecording({0, 0, 128, 96}, factory());
+    SkRandom rand;
+    for (int i = 0; i < 200; ++i) {
+        SkPaint paint;
+        paint.setColor(rand.nextU() | 0xFF000000);
+        SkScalar x = rand.nextRangeScalar(-20, 128);
+        SkScalar y = rand.nextRangeScalar(-20, 96);
+        rc->drawRect(SkRect::MakeXYWH(x, y, rand.nextRangeScalar(1, 60),
+                                            rand.nextRangeScalar(1, 60)), paint);
+    }
+    sk_sp<SkPicture> pic = recorder.finishRecordingAsPicture();
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(128, 96);
+    SkBitmap serial, tiled;
+    serial.allocPixels(info);
+    tiled.allocPixels(info);
+    serial.eraseColor(SK_ColorWHITE);
+    tiled.eraseColor(SK_ColorWHITE);
+
+    SkCanvas serialCanvas(serial);
+    serialCanvas.drawPicture(pic);
+
+    // Tile size chosen to not divide the dimensions evenly.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkDrawPictureInTiles(pic.get(), tiled.pixmap(), SkMatrix::I(), 33, executor.get());
+
+    for (int y = 0; y < info.height(); ++y) {
+        REPORTER_ASSERT(r, 0 == memcmp(serial.getAddr32(0, y), tiled.getAddr32(0, y),
+                                       info.width() * sizeof(uint32_t)));
+    }
+
+    // The serial (null executor) path must produce the same result.
+    tiled.eraseColor(SK_ColorWHITE);
+    SkDrawPictureInTiles(pic.get(), tiled.pixmap(), SkMatrix::I(), 33, nullptr);
+    for (int y = 0; y < info.height(); ++y) {
+        REPORTER_ASSERT(r, 0 == memcmp(serial.getAddr32(0, y), tiled.getAddr32(0, y),
+                                       info.width() * sizeof(uint32_t)));
+    }
+}
+
+DEF_TEST(Picture_ZeroCopyDeserialization, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* rc = recorder.beginRecording({0, 0, 64, 64});
+    SkPaint paint;
+    paint.setColor(SK_ColorGREEN);
+    rc->drawRect({10, 10, 50, 50}, paint);
+    sk_sp<SkPicture> pic = recorder.finishRecordingAsPicture();
+
+    sk_sp<SkData> data = pic->serialize();
+    REPORTER_ASSERT(r, data->unique());
+
+    // Deserializing from a stream that shares ref-counted storage should alias
+    // the op buffer out of that storage rather than copying it.
+    SkMemoryStream stream(data);
+    SkPictInfo info;
+    REPORTER_ASSERT(r, SkPicture_StreamIsSKP(&stream, &info));
+    std::unique_ptr<SkPictureData> pictData(
+            SkPictureData::CreateFromStream(&stream, info, SkDeserialProcs(), nullptr));
+    REPORTER_ASSERT(r, pictData);
+    REPORTER_ASSERT(r, !data->unique());
+    const uint8_t* ops = pictData->opData()->bytes();
+    REPORTER_ASSERT(r, ops >= data->bytes() && ops < data->bytes() + data->size());
+    pictData.reset();
+    REPORTER_ASSERT(r, data->unique());
+
+    // A bare-pointer stream must keep the old copying behavior.
+    SkMemoryStream bareStream(data->data(), data->size());
+    REPORTER_ASSERT(r, SkPicture_StreamIsSKP(&bareStream, &info));
+    pictData.reset(SkPictureData::CreateFromStream(&bareStream, info, SkDeserialProcs(), nullptr));
+    REPORTER_ASSERT(r, pictData);
+    REPORTER_ASSERT(r, data->unique());
+
+    // And the end-to-end result still draws the same.
+    sk_sp<SkPicture> copy = SkPicture::MakeFromData(data.get());
+    REPORTER_ASSERT(r, copy);
+    SkBitmap origBM, copyBM;
+    origBM.allocN32Pixels(64, 64);
+    copyBM.allocN32Pixels(64, 64);
+    origBM.eraseColor(SK_ColorWHITE);
+    copyBM.eraseColor(SK_ColorWHITE);
+    SkCanvas(origBM).drawPicture(pic);
+    SkCanvas(copyBM).drawPicture(copy);
+    for (int y = 0; y < 64; ++y) {
+        REPORTER_ASSERT(r, 0 == memcmp(origBM.getAddr32(0, y), copyBM.getAddr32(0, y),
+                                       64 * sizeof(uint32_t)));
+    }
+}
+
+DEF_TEST(Picture_RecordingArena, r) {
+    SkPictureRecorder::RecordingArena arena;
+    SkPictureRecorder recorder;
+
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(32, 32);
+    actual.allocN32Pixels(32, 32);
+
+    // Steady-state re-recording through the arena must behave exactly like
+    // fresh recordings, whether or not the previous picture is still alive.
+    sk_sp<SkPicture> held;
+    for (int frame = 0; frame < 4; ++frame) {
+        SkCanvas* rc = recorder.beginRecording(SkRect::MakeWH(32, 32), &arena);
+        SkPaint paint;
+        paint.setColor(SkColorSetRGB(50 * frame, 0, 255));
+        rc->drawRect(SkRect::MakeXYWH(SkIntToScalar(frame), 2, 10, 10), paint);
+        sk_sp<SkPicture> pic = recorder.finishRecordingAsPicture();
+        REPORTER_ASSERT(r, pic);
+
+        expected.eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(expected);
+        canvas.drawRect(SkRect::MakeXYWH(SkIntToScalar(frame), 2, 10, 10), paint);
+
+        actual.eraseColor(SK_ColorWHITE);
+        SkCanvas pictureCanvas(actual);
+        pictureCanvas.drawPicture(pic);
+
+        for (int y = 0; y < 32; ++y) {
+            REPORTER_ASSERT(r, 0 == memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                                           32 * sizeof(uint32_t)));
+        }
+
+        // Keep every other picture alive across the next beginRecording to
+        // exercise the fall-back-to-fresh-storage path.
+        held = (frame % 2) ? std::move(pic) : nullptr;
+    }
+}
+
+DEF_TEST(Picture_SerializeInternsPaints, r) {
+    auto serializedSize = [](bool samePaint) {
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+        for (int i = 0; i < 100; ++i) {
+            SkPaint paint;
+            paint.setColor(samePaint ? SK_ColorRED : SkColorSetARGB(0xFF, i, 0, 0));
+            canvas->drawRect(SkRect::MakeXYWH(SkIntToScalar(i), 2, 10, 10), paint);
+        }
+        return recorder.finishRecordingAsPicture()->serialize()->size();
+    };
+
+    // Identical paints are interned at record time, so a picture that repeats one paint
+    // serializes far smaller than one with as many distinct paints.
+    REPORTER_ASSERT(r, serializedSize(true) < serializedSize(false));
+}
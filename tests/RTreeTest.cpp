@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkRTree.h"
 #include "tests/Test.h"
@@ -89,3 +90,53 @@ DEF_TEST(RTree, reporter) {
                                   expectedDepthMax >= rtree.getDepth());
     }
 }
+
+// The tree may be built asynchronously on an executor; queries must join with
+// the build and answer exactly as the serial version does.
+DEF_TEST(RTree_concurrent_build, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkRandom rand;
+    SkAutoTMalloc<SkRect> rects(NUM_RECTS);
+    for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+        sk_sp<SkRTree> rtree = sk_make_sp<SkRTree>(executor.get());
+        for (int j = 0; j < NUM_RECTS; j++) {
+            rects[j] = random_rect(rand);
+        }
+
+        rtree->insert(rects.get(), NUM_RECTS);
+        run_queries(reporter, rand, rects, *rtree);
+        REPORTER_ASSERT(reporter, NUM_RECTS == rtree->getCount());
+    }
+}
+
+DEF_TEST(RTree_batched_search, reporter) {
+    SkRandom rand;
+    SkAutoTMalloc<SkRect> rects(NUM_RECTS);
+    SkRTree rtree;
+    for (int j = 0; j < NUM_RECTS; j++) {
+        rects[j] = random_rect(rand);
+    }
+    rtree.insert(rects.get(), NUM_RECTS);
+
+    static const int kNumBatched = 16;
+    SkRect queries[kNumBatched];
+    for (int i = 0; i < kNumBatched; i++) {
+        queries[i] = random_rect(rand);
+    }
+
+    // One traversal must answer exactly as per-query searches do.
+    std::vector<int> batched[kNumBatched];
+    rtree.search(queries, kNumBatched, batched);
+    for (int i = 0; i < kNumBatched; i++) {
+        std::vector<int> expected;
+        rtree.search(queries[i], &expected);
+        REPORTER_ASSERT(reporter, batched[i] == expected);
+    }
+
+    // Repeating a query hits the memo cache and must answer identically.
+    for (int i = 0; i < kNumBatched; i++) {
+        std::vector<int> again;
+        rtree.search(queries[i], &again);
+        REPORTER_ASSERT(reporter, batched[i] == again);
+    }
+}
@@ -414,3 +414,50 @@ DEF_TEST(savelayer_srcmode_alpha, r) {
     do_savelayer_srcmode(r, 0x80FF0000);
 }
 
+
+DEF_TEST(RecordOpts_MergeAdjacentRects, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    // A long run of identically painted integer rects coalesces into a region.
+    SkPaint opaque;
+    for (int i = 0; i < 8; i++) {
+        recorder.drawRect(SkRect::MakeXYWH(SkIntToScalar(i * 10), 0, 10, 10), opaque);
+    }
+    SkRecordMergeAdjacentRects(&record);
+    record.defrag();
+    REPORTER_ASSERT(r, 1 == record.count());
+    const SkRecords::DrawRegion* region = assert_type<SkRecords::DrawRegion>(r, record, 0);
+    REPORTER_ASSERT(r, region->region.getBounds() == SkIRect::MakeWH(80, 10));
+
+    // Translucent paints must not merge: overlapping rects double-blend.
+    SkRecord translucentRecord;
+    recorder.reset(&translucentRecord, SkRect::MakeWH(W, H), SkRecorder::Record_DrawPictureMode);
+    SkPaint translucent;
+    translucent.setAlpha(0x80);
+    for (int i = 0; i < 8; i++) {
+        recorder.drawRect(SkRect::MakeXYWH(SkIntToScalar(i * 10), 0, 10, 10), translucent);
+    }
+    SkRecordMergeAdjacentRects(&translucentRecord);
+    translucentRecord.defrag();
+    REPORTER_ASSERT(r, 8 == count_instances_of_type<SkRecords::DrawRect>(translucentRecord));
+
+    // Non-integer rects must not merge: regions are integral.
+    SkRecord fractionalRecord;
+    recorder.reset(&fractionalRecord, SkRect::MakeWH(W, H), SkRecorder::Record_DrawPictureMode);
+    for (int i = 0; i < 8; i++) {
+        recorder.drawRect(SkRect::MakeXYWH(i * 10 + 0.5f, 0, 10, 10), opaque);
+    }
+    SkRecordMergeAdjacentRects(&fractionalRecord);
+    fractionalRecord.defrag();
+    REPORTER_ASSERT(r, 8 == count_instances_of_type<SkRecords::DrawRect>(fractionalRecord));
+
+    // Short runs are left alone.
+    SkRecord shortRecord;
+    recorder.reset(&shortRecord, SkRect::MakeWH(W, H), SkRecorder::Record_DrawPictureMode);
+    recorder.drawRect(SkRect::MakeWH(10, 10), opaque);
+    recorder.drawRect(SkRect::MakeWH(20, 20), opaque);
+    SkRecordMergeAdjacentRects(&shortRecord);
+    shortRecord.defrag();
+    REPORTER_ASSERT(r, 2 == count_instances_of_type<SkRecords::DrawRect>(shortRecord));
+}
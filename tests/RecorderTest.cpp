@@ -108,3 +108,41 @@ DEF_TEST(Recorder_drawImage_takeReference, reporter) {
     }
     REPORTER_ASSERT(reporter, image->unique());
 }
+
+DEF_TEST(Recorder_SpliceRecord, r) {
+    // Record a source with a save/restore-balanced span worth reusing.
+    sk_sp<SkRecord> src(new SkRecord);
+    {
+        SkRecorder recorder(src.get(), 100, 100);
+        recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());   // 0
+        recorder.save();                                        // 1
+        recorder.clipRect(SkRect::MakeWH(50, 50));              // 2
+        recorder.drawRect(SkRect::MakeWH(20, 20), SkPaint());   // 3
+        recorder.restore();                                     // 4
+    }
+    REPORTER_ASSERT(r, 5 == src->count());
+
+    SkRecord dst;
+    SkRecorder recorder(&dst, 100, 100);
+    recorder.drawRect(SkRect::MakeWH(5, 5), SkPaint());
+
+    // Unbalanced and out-of-range spans are rejected.
+    REPORTER_ASSERT(r, !recorder.spliceRecord(src, 1, 4));
+    REPORTER_ASSERT(r, !recorder.spliceRecord(src, 0, src->count() + 1));
+    REPORTER_ASSERT(r, !dst.hasBorrowedOps());
+
+    // A balanced span splices in without re-encoding.
+    REPORTER_ASSERT(r, recorder.spliceRecord(src, 1, 5));
+    REPORTER_ASSERT(r, dst.hasBorrowedOps());
+    REPORTER_ASSERT(r, 5 == dst.count());
+
+    // The destination keeps the borrowed ops alive without our ref.
+    src.reset();
+
+    Tally tally;
+    tally.apply(dst);
+    REPORTER_ASSERT(r, 2 == tally.count<SkRecords::DrawRect>());
+    REPORTER_ASSERT(r, 1 == tally.count<SkRecords::Save>());
+    REPORTER_ASSERT(r, 1 == tally.count<SkRecords::ClipRect>());
+    REPORTER_ASSERT(r, 1 == tally.count<SkRecords::Restore>());
+}
@@ -515,3 +515,35 @@ DEF_TEST(region_empty_iter, reporter) {
     REPORTER_ASSERT(reporter, !left);
     REPORTER_ASSERT(reporter, !right);
 }
+
+// Regions with many scanlines answer contains()/findScanline() through a
+// lazily-built per-scanline index.  Build a comb with enough teeth to cross
+// that cutoff and check point membership (and a translate in place, which
+// must invalidate the index) against the obvious predicate.
+DEF_TEST(region_scanline_index, reporter) {
+    constexpr int kTeeth = 300;
+
+    SkRegion comb;
+    for (int i = 0; i < kTeeth; ++i) {
+        Union(&comb, SkIRect::MakeXYWH(i, 2*i, 10, 1));
+    }
+    REPORTER_ASSERT(reporter, comb.computeRegionComplexity() == kTeeth);
+
+    auto in_comb = [=](int x, int y) {
+        int i = y / 2;
+        return i >= 0 && i < kTeeth && !(y & 1) && x >= i && x < i + 10;
+    };
+
+    for (int y = -1; y <= 2*kTeeth; ++y) {
+        for (int x = -1; x <= kTeeth + 10; ++x) {
+            REPORTER_ASSERT(reporter, comb.contains(x, y) == in_comb(x, y));
+        }
+    }
+
+    comb.translate(1, 0, &comb);
+    for (int i = 0; i < kTeeth; ++i) {
+        REPORTER_ASSERT(reporter,  comb.contains(i + 1,  2*i));
+        REPORTER_ASSERT(reporter, !comb.contains(i,      2*i));
+        REPORTER_ASSERT(reporter, !comb.contains(i + 11, 2*i));
+    }
+}
@@ -1263,6 +1263,61 @@ static void test_time_purge(skiatest::Reporter* reporter) {
     }
 }
 
+static void test_time_purge_incremental(skiatest::Reporter* reporter) {
+    Mock mock(1000000);
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = mock.gpu();
+
+    auto nowish = []() {
+        // We sleep so that we ensure we get a value that is greater than the last call to
+        // GrStdSteadyClock::now().
+        std::this_thread::sleep_for(GrStdSteadyClock::duration(5));
+        auto result = GrStdSteadyClock::now();
+        // Also sleep afterwards so we don't get this value again.
+        std::this_thread::sleep_for(GrStdSteadyClock::duration(5));
+        return result;
+    };
+
+    static constexpr int kCnt = 25;
+    static constexpr int kBatch = 10;
+    for (int i = 0; i < kCnt; ++i) {
+        TestResource* r = new TestResource(gpu);
+        GrUniqueKey k;
+        make_unique_key<1>(&k, i);
+        r->resourcePriv().setUniqueKey(k);
+        r->unref();
+    }
+    auto cutoff = nowish();
+
+    // A work-limited purge releases only the batch size; the rest are deferred.
+    cache->purgeResourcesNotUsedSince(cutoff, kBatch);
+    REPORTER_ASSERT(reporter, kCnt - kBatch == cache->getResourceCount());
+
+    // purgeAsNeeded continues the deferred purge a batch at a time until none of the remaining
+    // purgeable resources predate the cutoff.
+    while (cache->getResourceCount() > 0) {
+        int before = cache->getResourceCount();
+        cache->purgeAsNeeded();
+        REPORTER_ASSERT(reporter, cache->getResourceCount() < before);
+    }
+    REPORTER_ASSERT(reporter, 0 == cache->getResourceCount());
+
+    // Resources added after the cutoff are not touched by the deferred purge.
+    for (int i = 0; i < kCnt; ++i) {
+        TestResource* r = new TestResource(gpu);
+        GrUniqueKey k;
+        make_unique_key<1>(&k, i);
+        r->resourcePriv().setUniqueKey(k);
+        r->unref();
+    }
+    cache->purgeResourcesNotUsedSince(cutoff, kBatch);
+    cache->purgeAsNeeded();
+    REPORTER_ASSERT(reporter, kCnt == cache->getResourceCount());
+
+    cache->purgeAllUnlocked();
+    REPORTER_ASSERT(reporter, 0 == cache->getResourceCount());
+}
+
 static void test_partial_purge(skiatest::Reporter* reporter) {
     Mock mock(100);
     auto dContext = mock.dContext();
@@ -1534,6 +1589,7 @@ DEF_GPUTEST(ResourceCacheMisc, reporter, /* options */) {
     test_cache_chained_purge(reporter);
     test_timestamp_wrap(reporter);
     test_time_purge(reporter);
+    test_time_purge_incremental(reporter);
     test_partial_purge(reporter);
     test_custom_data(reporter);
     test_abandoned(reporter);
@@ -1250,6 +1250,42 @@ static void test_conservative_intersection(skiatest::Reporter* reporter) {
     verify_failure(reporter, a, a.makeOffset(r, 0.f));
 }
 
+static void test_intersects_rect(skiatest::Reporter* reporter) {
+    const SkRRect rr = SkRRect::MakeRectXY({0.f, 0.f, 40.f, 40.f}, 10.f, 10.f);
+
+    // Trivially disjoint and trivially overlapping rects.
+    REPORTER_ASSERT(reporter, !SkRRectPriv::IntersectsRect(rr, {50.f, 50.f, 60.f, 60.f}));
+    REPORTER_ASSERT(reporter, SkRRectPriv::IntersectsRect(rr, {15.f, 15.f, 25.f, 25.f}));
+    REPORTER_ASSERT(reporter, SkRRectPriv::IntersectsRect(rr, {-5.f, 15.f, 45.f, 25.f}));
+
+    // Rects overlapping the bounds but tucked entirely into a cut-away corner do not intersect.
+    // The point of the corner bounds (10,10) is sqrt(2)*10 - 10 ~= 4.14 px outside the curve.
+    REPORTER_ASSERT(reporter, !SkRRectPriv::IntersectsRect(rr, {0.f, 0.f, 2.f, 2.f}));
+    REPORTER_ASSERT(reporter, !SkRRectPriv::IntersectsRect(rr, {38.f, 0.f, 40.f, 2.f}));
+    REPORTER_ASSERT(reporter, !SkRRectPriv::IntersectsRect(rr, {38.f, 38.f, 40.f, 40.f}));
+    REPORTER_ASSERT(reporter, !SkRRectPriv::IntersectsRect(rr, {0.f, 38.f, 2.f, 40.f}));
+
+    // The same rects made large enough to reach past the curve do intersect.
+    REPORTER_ASSERT(reporter, SkRRectPriv::IntersectsRect(rr, {0.f, 0.f, 4.f, 4.f}));
+    REPORTER_ASSERT(reporter, SkRRectPriv::IntersectsRect(rr, {36.f, 36.f, 40.f, 40.f}));
+
+    // A rect spanning a corner intersects even though each of its corners is outside the curve.
+    REPORTER_ASSERT(reporter, SkRRectPriv::IntersectsRect(rr, {-2.f, -2.f, 12.f, 1.f}));
+
+    // Edge-only contact has no area, so it does not count as an intersection.
+    REPORTER_ASSERT(reporter, !SkRRectPriv::IntersectsRect(rr, {40.f, 15.f, 50.f, 25.f}));
+
+    // Rect-type rrects degenerate to a plain bounds test.
+    const SkRRect rect = SkRRect::MakeRect({0.f, 0.f, 40.f, 40.f});
+    REPORTER_ASSERT(reporter, SkRRectPriv::IntersectsRect(rect, {0.f, 0.f, 2.f, 2.f}));
+    REPORTER_ASSERT(reporter, !SkRRectPriv::IntersectsRect(rect, {41.f, 0.f, 43.f, 2.f}));
+
+    // Ovals cut the deepest corners.
+    const SkRRect oval = SkRRect::MakeOval({0.f, 0.f, 40.f, 40.f});
+    REPORTER_ASSERT(reporter, !SkRRectPriv::IntersectsRect(oval, {0.f, 0.f, 5.f, 5.f}));
+    REPORTER_ASSERT(reporter, SkRRectPriv::IntersectsRect(oval, {0.f, 0.f, 7.f, 7.f}));
+}
+
 DEF_TEST(RoundRect, reporter) {
     test_round_rect_basic(reporter);
     test_round_rect_rects(reporter);
@@ -1266,4 +1302,5 @@ DEF_TEST(RoundRect, reporter) {
     test_read(reporter);
     test_inner_bounds(reporter);
     test_conservative_intersection(reporter);
+    test_intersects_rect(reporter);
 }
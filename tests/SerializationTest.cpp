@@ -12,6 +12,7 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
+#include "include/effects/SkCornerPathEffect.h"
 #include "include/effects/SkDashPathEffect.h"
 #include "include/effects/SkImageFilters.h"
 #include "include/effects/SkTableColorFilter.h"
@@ -848,6 +849,37 @@ DEF_TEST(WriteBuffer_external_memory_flattenable, reporter) {
     REPORTER_ASSERT(reporter, path_effect->serialize(storage.get(), storage_size) != 0u);
 }
 
+DEF_TEST(ReadBuffer_flattenable_dict, reporter) {
+    // Without a factory array, the writer names each flattenable type once and
+    // refers to repeats by index. Make sure repeated and interleaved types all
+    // resolve through the reader's dictionary.
+    SkScalar intervals[] = {1.f, 1.f};
+    sk_sp<SkPathEffect> dash   = SkDashPathEffect::Make(intervals, 2, 0);
+    sk_sp<SkPathEffect> corner = SkCornerPathEffect::Make(4.f);
+
+    SkBinaryWriteBuffer writer;
+    writer.writeFlattenable(dash.get());
+    writer.writeFlattenable(dash.get());      // repeat: index, not string
+    writer.writeFlattenable(corner.get());
+    writer.writeFlattenable(dash.get());      // repeat after another type
+
+    size_t size = writer.bytesWritten();
+    SkAutoMalloc storage(size);
+    writer.writeToMemory(storage.get());
+
+    SkReadBuffer reader(storage.get(), size);
+    const SkPathEffect* expected[] = { dash.get(), dash.get(), corner.get(), dash.get() };
+    for (const SkPathEffect* orig : expected) {
+        sk_sp<SkPathEffect> back = reader.readPathEffect();
+        REPORTER_ASSERT(reporter, back);
+        if (back) {
+            REPORTER_ASSERT(reporter, back->getFactory() == orig->getFactory());
+            REPORTER_ASSERT(reporter, back->serialize()->equals(orig->serialize().get()));
+        }
+    }
+    REPORTER_ASSERT(reporter, reader.isValid());
+}
+
 DEF_TEST(ReadBuffer_empty, reporter) {
     SkBinaryWriteBuffer writer;
     writer.writeInt(123);
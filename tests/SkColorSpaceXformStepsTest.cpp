@@ -170,3 +170,33 @@ DEF_TEST(SkColorSpaceXformSteps, r) {
                 (t&16) ? " true" : "false");
     }
 }
+
+DEF_TEST(SkColorSpaceXformSteps_cache, r) {
+    auto srgb = SkColorSpace::MakeSRGB(),
+         dp3  = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3);
+
+    // Rebuilding the same steps must reproduce the same decomposition (and shared LUTs).
+    SkColorSpaceXformSteps a(srgb.get(), kPremul_SkAlphaType, dp3.get(), kPremul_SkAlphaType),
+                           b(srgb.get(), kPremul_SkAlphaType, dp3.get(), kPremul_SkAlphaType);
+    REPORTER_ASSERT(r, a.flags.mask() == b.flags.mask());
+    REPORTER_ASSERT(r, a.srcTFLut == b.srcTFLut);
+    REPORTER_ASSERT(r, a.dstTFLut == b.dstTFLut);
+
+    // Whether or not a LUT was baked, apply() must stay within the bake tolerance of the
+    // parametric curves.
+    skcms_TransferFunction tf, tfInv;
+    srgb->transferFn(&tf);
+    dp3->invTransferFn(&tfInv);
+    for (int i = 0; i <= 64; i++) {
+        float v = i / 64.0f;
+        float rgba[4] = { v, v, v, 1.0f };
+        a.apply(rgba);
+
+        float linear = skcms_TransferFunction_eval(&tf, v);
+        // sRGB and Display P3 share a gamut-mapped value we don't recompute here; just check
+        // the linearize step on a gray axis where the gamut transform is identity-ish.
+        float expect = skcms_TransferFunction_eval(&tfInv, linear);
+        REPORTER_ASSERT(r, fabsf(rgba[0] - expect) <= 2/512.0f,
+                        "v=%g got %g want %g", v, rgba[0], expect);
+    }
+}
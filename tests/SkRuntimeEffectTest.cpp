@@ -7,6 +7,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorFilter.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkSurface.h"
 #include "include/effects/SkRuntimeEffect.h"
@@ -263,3 +264,40 @@ DEF_TEST(SkRuntimeEffectSimple, r) {
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRuntimeEffectSimple_GPU, r, ctxInfo) {
     test_RuntimeEffect_Shaders(r, ctxInfo.directContext());
 }
+
+DEF_TEST(SkRuntimeColorFilterOnRaster, r) {
+    // A runtime color filter must evaluate on CPU raster surfaces (and via filterColor4f),
+    // not just on the GPU.
+    auto [effect, errorText] = SkRuntimeEffect::Make(SkString(
+            "uniform half scale;"
+            "void main(inout half4 color) { color.rgb = color.bgr * scale; }"));
+    REPORTER_ASSERT(r, effect);
+
+    float scale = 0.5f;
+    sk_sp<SkColorFilter> filter =
+            effect->makeColorFilter(SkData::MakeWithCopy(&scale, sizeof(scale)));
+    REPORTER_ASSERT(r, filter);
+
+    // filterColor4f: (premul) rgb swapped and halved, alpha untouched.
+    SkColor4f result = filter->filterColor4f({0.8f, 0.4f, 0.2f, 1.0f}, nullptr, nullptr);
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(result.fR, 0.1f, 1/255.f));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(result.fG, 0.2f, 1/255.f));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(result.fB, 0.4f, 1/255.f));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(result.fA, 1.0f, 1/255.f));
+
+    // And the same result through a raster-surface draw.
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(1, 1);
+    SkPaint paint;
+    paint.setColor4f({0.8f, 0.4f, 0.2f, 1.0f}, nullptr);
+    paint.setColorFilter(filter);
+    surface->getCanvas()->drawPaint(paint);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(surface->imageInfo());
+    REPORTER_ASSERT(r, surface->readPixels(bitmap, 0, 0));
+    SkColor4f drawn = SkColor4f::FromColor(bitmap.getColor(0, 0));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(drawn.fR, 0.1f, 2/255.f));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(drawn.fG, 0.2f, 2/255.f));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(drawn.fB, 0.4f, 2/255.f));
+    REPORTER_ASSERT(r, SkScalarNearlyEqual(drawn.fA, 1.0f, 2/255.f));
+}
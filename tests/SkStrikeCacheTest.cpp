@@ -5,6 +5,8 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkGraphics.h"
+#include "src/core/SkSpan.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
 #include "tests/Test.h"
@@ -51,3 +53,52 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
 
 
 }
+
+DEF_TEST(SkStrikeCache_GlyphImageCompression, Reporter) {
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::create_portable_typeface("serif", SkFontStyle::Normal());
+
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setTypeface(typeface);
+    font.setSize(60);
+
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    static constexpr int kGlyphCount = 10;
+    SkPackedGlyphID ids[kGlyphCount];
+    for (int i = 0; i < kGlyphCount; ++i) {
+        ids[i] = SkPackedGlyphID(font.unicharToGlyph('A' + i));
+    }
+
+    // Build the same strike twice, once with compression off and once forced on.
+    size_t oldThreshold = SkGraphics::SetGlyphImageCompressionThreshold(SIZE_MAX);
+    SkStrikeCache rawCache;
+    sk_sp<SkStrike> rawStrike = strikeSpec.findOrCreateStrike(&rawCache);
+    const SkGlyph* rawGlyphs[kGlyphCount];
+    rawStrike->prepareImages(SkMakeSpan(ids, kGlyphCount), rawGlyphs);
+
+    SkGraphics::SetGlyphImageCompressionThreshold(1);
+    SkStrikeCache packedCache;
+    sk_sp<SkStrike> packedStrike = strikeSpec.findOrCreateStrike(&packedCache);
+    const SkGlyph* packedGlyphs[kGlyphCount];
+    packedStrike->prepareImages(SkMakeSpan(ids, kGlyphCount), packedGlyphs);
+    SkGraphics::SetGlyphImageCompressionThreshold(oldThreshold);
+
+    // Compression must be invisible to the consumer: identical bytes either way.
+    for (int i = 0; i < kGlyphCount; ++i) {
+        size_t size = rawGlyphs[i]->imageSize();
+        REPORTER_ASSERT(Reporter, packedGlyphs[i]->imageSize() == size);
+        if (size > 0) {
+            REPORTER_ASSERT(Reporter,
+                            memcmp(packedGlyphs[i]->image(), rawGlyphs[i]->image(), size) == 0);
+        }
+    }
+
+    // The compressed strike should never account for more memory than the raw one.
+    REPORTER_ASSERT(Reporter,
+                    packedCache.getTotalMemoryUsed() <= rawCache.getTotalMemoryUsed());
+}
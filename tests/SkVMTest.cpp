@@ -5,10 +5,17 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkColorPriv.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
 #include "include/private/SkColorData.h"
+#include "src/core/SkArenaAlloc.h"
+#include "src/core/SkBlitter.h"
 #include "src/core/SkCpu.h"
 #include "src/core/SkMSAN.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkMatrixProvider.h"
 #include "src/core/SkVM.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
@@ -217,6 +224,24 @@ DEF_TEST(SkVM_eliminate_dead_code, r) {
     REPORTER_ASSERT(r, program.size() == 0);
 }
 
+DEF_TEST(SkVM_commutative_cse, r) {
+    skvm::Builder b;
+    {
+        skvm::I32 x = b.load32(b.varying<int>()),
+                  y = b.load32(b.varying<int>());
+        b.store32(b.varying<int>(), (x*y) + (y*x));
+    }
+
+    // x*y and y*x should value-number to a single multiply.
+    int muls = 0;
+    for (const skvm::Instruction& inst : b.program()) {
+        if (inst.op == skvm::Op::mul_i32) {
+            muls++;
+        }
+    }
+    REPORTER_ASSERT(r, muls == 1);
+}
+
 DEF_TEST(SkVM_Usage, r) {
     skvm::Builder b;
     {
@@ -275,6 +300,33 @@ DEF_TEST(SkVM_memset, r) {
     });
 }
 
+DEF_TEST(SkVM_serialize, r) {
+    skvm::Builder b;
+    {
+        auto src = b.varying<int>(),
+             dst = b.varying<int>();
+        b.store32(dst, b.add(b.load32(src), b.splat(1)));
+    }
+
+    sk_sp<SkData> blob = b.done().serialize();
+    REPORTER_ASSERT(r, blob);
+
+    skvm::Program p = skvm::Program::Deserialize(blob->data(), blob->size());
+    REPORTER_ASSERT(r, !p.empty());
+    REPORTER_ASSERT(r, p.nargs() == 2);
+
+    int src[] = {1,2,3,4},
+        dst[] = {0,0,0,0};
+    p.eval(SK_ARRAY_COUNT(src), src, dst);
+    for (size_t i = 0; i < SK_ARRAY_COUNT(src); i++) {
+        REPORTER_ASSERT(r, dst[i] == src[i] + 1);
+    }
+
+    // Corrupt or truncated blobs should deserialize to an empty Program.
+    REPORTER_ASSERT(r, skvm::Program::Deserialize(blob->data(), blob->size()-1).empty());
+    REPORTER_ASSERT(r, skvm::Program::Deserialize(blob->data(), 3).empty());
+}
+
 DEF_TEST(SkVM_memcpy, r) {
     skvm::Builder b;
     {
@@ -2339,3 +2391,39 @@ DEF_TEST(SkVM_args, r) {
         }
     });
 }
+
+DEF_TEST(SkVMBlitter_LCD16, r) {
+    // Subpixel (kLCD16_Format) masks should run through SkVMBlitter's fused
+    // coverage program rather than falling back to the legacy blitters.
+    extern bool gUseSkVMBlitter;
+
+    SkBitmap dst;
+    dst.allocPixels(SkImageInfo::Make(3,1, kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+    dst.eraseColor(SK_ColorBLACK);
+
+    // Full coverage, no coverage, and red-only subpixel coverage.
+    uint16_t cov[] = { 0xFFFF, 0x0000, 0xF800 };
+    SkMask mask;
+    mask.fImage    = (uint8_t*)cov;
+    mask.fBounds   = {0,0,3,1};
+    mask.fRowBytes = sizeof(cov);
+    mask.fFormat   = SkMask::kLCD16_Format;
+
+    SkPaint paint;
+    paint.setColor(SK_ColorWHITE);
+
+    bool wasUsingSkVM = gUseSkVMBlitter;
+    gUseSkVMBlitter = true;
+    {
+        SkSimpleMatrixProvider matrixProvider{SkMatrix::I()};
+        SkSTArenaAlloc<256> alloc;
+        SkBlitter* blitter = SkBlitter::Choose(dst.pixmap(), matrixProvider, paint, &alloc,
+                                               /*drawCoverage=*/false, /*clipShader=*/nullptr);
+        blitter->blitMask(mask, mask.fBounds);
+    }
+    gUseSkVMBlitter = wasUsingSkVM;
+
+    REPORTER_ASSERT(r, *dst.getAddr32(0,0) == 0xffffffff);  // full coverage -> white
+    REPORTER_ASSERT(r, *dst.getAddr32(1,0) == 0xff000000);  // no coverage   -> still black
+    REPORTER_ASSERT(r, *dst.getAddr32(2,0) == 0xff0000ff);  // red coverage  -> red only (RGBA)
+}
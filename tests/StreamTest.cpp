@@ -466,6 +466,50 @@ DEF_TEST(DynamicMemoryWStream_detachAsData, r) {
     }
 }
 
+DEF_TEST(DynamicMemoryWStream_detachAsSegments, r) {
+    const char az[] = "abcdefghijklmnopqrstuvwxyz";
+    const unsigned N = 40000;
+    SkDynamicMemoryWStream dmws;
+    for (unsigned i = 0; i < N; ++i) {
+        dmws.writeText(az);
+    }
+    std::vector<sk_sp<SkData>> segments = dmws.detachAsSegments();
+    REPORTER_ASSERT(r, dmws.bytesWritten() == 0);
+    REPORTER_ASSERT(r, segments.size() > 1);
+
+    // Concatenating the segments must reproduce the written bytes exactly.
+    size_t totalSize = 0;
+    for (const sk_sp<SkData>& segment : segments) {
+        totalSize += segment->size();
+    }
+    REPORTER_ASSERT(r, totalSize == N * strlen(az));
+
+    SkAutoTMalloc<char> contents(totalSize);
+    char* ptr = contents.get();
+    for (const sk_sp<SkData>& segment : segments) {
+        memcpy(ptr, segment->data(), segment->size());
+        ptr += segment->size();
+    }
+    for (size_t offset = 0; offset < totalSize; offset += strlen(az)) {
+        if (0 != memcmp(contents.get() + offset, az, strlen(az))) {
+            ERRORF(r, "detachAsSegments() memcmp failed at offset %zu", offset);
+            return;
+        }
+    }
+
+    // A single-block stream detaches with no copy and no segmentation.
+    dmws.writeText(az);
+    segments = dmws.detachAsSegments();
+    REPORTER_ASSERT(r, segments.size() == 1);
+    REPORTER_ASSERT(r, segments[0]->size() == strlen(az));
+    REPORTER_ASSERT(r, 0 == memcmp(segments[0]->data(), az, strlen(az)));
+
+    dmws.writeText(az);
+    sk_sp<SkData> data = dmws.detachAsData();
+    REPORTER_ASSERT(r, data->size() == strlen(az));
+    REPORTER_ASSERT(r, 0 == memcmp(data->data(), az, strlen(az)));
+}
+
 DEF_TEST(StreamCopy, reporter) {
     SkRandom random(123456);
     static const int N = 10000;
@@ -5,9 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkGraphics.h"
+#include "include/core/SkString.h"
 #include "include/core/SkTraceMemoryDump.h"
 #include "include/gpu/GrDirectContext.h"
 
+#include <vector>
+
 #include "tests/Test.h"
 
 #include "src/gpu/GrContextPriv.h"
@@ -158,3 +162,41 @@ DEF_GPUTEST_FOR_GL_RENDERING_CONTEXTS(SkTraceMemoryDump_unownedGLRenderTarget, r
     ValidateMemoryDumps(reporter, dContext, rt->gpuMemorySize(), false /* isOwned */);
 }
 #endif  // SK_GL
+
+namespace {
+
+class NameCollectingDump : public SkTraceMemoryDump {
+public:
+    void dumpNumericValue(const char* dumpName, const char*, const char*, uint64_t) override {
+        fNames.emplace_back(dumpName);
+    }
+    void setMemoryBacking(const char*, const char*, const char*) override {}
+    void setDiscardableMemoryBacking(const char*, const SkDiscardableMemory&) override {}
+    LevelOfDetail getRequestedDetails() const override {
+        return SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail;
+    }
+
+    bool sawDumpWithPrefix(const char* prefix) const {
+        for (const SkString& name : fNames) {
+            if (name.startsWith(prefix)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::vector<SkString> fNames;
+};
+
+}  // namespace
+
+DEF_TEST(SkTraceMemoryDump_cpuCaches, reporter) {
+    NameCollectingDump dump;
+    SkGraphics::DumpMemoryStatistics(&dump);
+
+    // Each core CPU cache reports at least its totals, even when empty.
+    REPORTER_ASSERT(reporter, dump.sawDumpWithPrefix("skia/sk_glyph_cache"));
+    REPORTER_ASSERT(reporter, dump.sawDumpWithPrefix("skia/sk_typeface_cache"));
+    REPORTER_ASSERT(reporter, dump.sawDumpWithPrefix("skia/sk_image_filter_cache"));
+}
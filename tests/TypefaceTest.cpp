@@ -287,14 +287,18 @@ DEF_TEST(TypefaceCache, reporter) {
             sk_sp<SkTypeface> t0(TestEmptyTypeface::Make());
             cache.add(t0);
             REPORTER_ASSERT(reporter, count(reporter, cache) == 1);
+            REPORTER_ASSERT(reporter, cache.findByID(t0->uniqueID()) == t0);
             cache.add(t1);
             REPORTER_ASSERT(reporter, count(reporter, cache) == 2);
+            REPORTER_ASSERT(reporter, cache.findByID(t1->uniqueID()) == t1);
             cache.purgeAll();
             REPORTER_ASSERT(reporter, count(reporter, cache) == 2);
         }
         REPORTER_ASSERT(reporter, count(reporter, cache) == 2);
         cache.purgeAll();
         REPORTER_ASSERT(reporter, count(reporter, cache) == 1);
+        REPORTER_ASSERT(reporter, cache.findByID(t1->uniqueID()) == t1);
+        REPORTER_ASSERT(reporter, cache.findByID(SkTypefaceCache::NewFontID()) == nullptr);
     }
     REPORTER_ASSERT(reporter, t1->unique());
 }
@@ -12,6 +12,7 @@
 #include "src/core/SkTSearch.h"
 #include "src/core/SkTSort.h"
 #include "src/core/SkZip.h"
+#include "src/utils/SkCharToGlyphCache.h"
 #include "tests/Test.h"
 
 #include <array>
@@ -596,3 +597,37 @@ DEF_TEST(SkMakeZip, reporter) {
         REPORTER_ASSERT(reporter, !z.empty());
     }
 }
+
+DEF_TEST(SkCharToGlyphCache_Bulk, reporter) {
+    SkCharToGlyphCache cache;
+    // Pre-seed every even unichar in [0, 200) with a recognizable glyph.
+    for (SkUnichar c = 0; c < 200; c += 2) {
+        cache.addCharAndGlyph(c, SkToU16(c + 1000));
+    }
+
+    // Unsorted input with duplicates, mixing hits (even) and misses (odd).
+    const SkUnichar uni[] = {9, 4, 150, 4, 77, 0, 198, 9, 3};
+    const int count = SK_ARRAY_COUNT(uni);
+    SkGlyphID glyphs[count];
+    int missIndices[count];
+    int missCount = cache.findGlyphIndices(uni, count, glyphs, missIndices);
+
+    REPORTER_ASSERT(reporter, missCount == 4);
+    bool missed[count] = {};
+    for (int j = 0; j < missCount; ++j) {
+        missed[missIndices[j]] = true;
+    }
+    for (int i = 0; i < count; ++i) {
+        if (uni[i] % 2 == 0) {
+            REPORTER_ASSERT(reporter, !missed[i]);
+            REPORTER_ASSERT(reporter, glyphs[i] == uni[i] + 1000);
+        } else {
+            REPORTER_ASSERT(reporter, missed[i]);
+        }
+    }
+
+    // An empty cache misses everything.
+    SkCharToGlyphCache empty;
+    missCount = empty.findGlyphIndices(uni, count, glyphs, missIndices);
+    REPORTER_ASSERT(reporter, missCount == count);
+}
@@ -12,6 +12,7 @@
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkVerticesPriv.h"
 #include "src/core/SkWriteBuffer.h"
+#include "src/utils/SkReusableVerticesBuilder.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
@@ -241,3 +242,51 @@ DEF_TEST(Vertices_clipping, reporter) {
         }
     }
 }
+
+DEF_TEST(Vertices_reusable_builder, reporter) {
+    SkReusableVerticesBuilder builder(SkVertices::kHasColors_BuilderFlag);
+
+    // Two triangles sharing an edge: the shared corners should dedup to 4 vertices.
+    const SkPoint quad[] = {{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+    uint16_t a = builder.append(quad[0], {0, 0}, SK_ColorRED),
+             b = builder.append(quad[1], {0, 0}, SK_ColorRED),
+             c = builder.append(quad[2], {0, 0}, SK_ColorRED),
+             d = builder.append(quad[3], {0, 0}, SK_ColorRED);
+    builder.appendTriangle(a, b, c);
+    builder.appendTriangle(builder.append(quad[0], {0, 0}, SK_ColorRED),
+                           builder.append(quad[2], {0, 0}, SK_ColorRED),
+                           d);
+    REPORTER_ASSERT(reporter, builder.vertexCount() == 4);
+    REPORTER_ASSERT(reporter, builder.indexCount() == 6);
+
+    // Same position with a different color is a different vertex.
+    uint16_t e = builder.append(quad[0], {0, 0}, SK_ColorBLUE);
+    REPORTER_ASSERT(reporter, e != a);
+    REPORTER_ASSERT(reporter, builder.vertexCount() == 5);
+
+    sk_sp<SkVertices> verts = builder.detach(SkVertices::kTriangles_VertexMode);
+    REPORTER_ASSERT(reporter, verts);
+    SkVerticesPriv priv(verts->priv());
+    REPORTER_ASSERT(reporter, priv.vertexCount() == 5);
+    REPORTER_ASSERT(reporter, priv.indexCount() == 6);
+    REPORTER_ASSERT(reporter, priv.hasColors());
+    REPORTER_ASSERT(reporter, !priv.hasTexCoords());
+    REPORTER_ASSERT(reporter, priv.positions()[0] == quad[0]);
+    REPORTER_ASSERT(reporter, priv.indices()[3] == a && priv.indices()[4] == c);
+
+    // detach() leaves the builder empty and reusable.
+    REPORTER_ASSERT(reporter, builder.vertexCount() == 0 && builder.indexCount() == 0);
+    builder.appendTriangle(builder.append(quad[0], {0, 0}, SK_ColorGREEN),
+                           builder.append(quad[1], {0, 0}, SK_ColorGREEN),
+                           builder.append(quad[2], {0, 0}, SK_ColorGREEN));
+    REPORTER_ASSERT(reporter, builder.vertexCount() == 3);
+    REPORTER_ASSERT(reporter, builder.detach(SkVertices::kTriangles_VertexMode));
+
+    // Dedup keeps working once the hash table has grown through a few rehashes.
+    for (int i = 0; i < 1000; ++i) {
+        builder.append({SkIntToScalar(i), 0}, {0, 0}, SK_ColorRED);
+    }
+    REPORTER_ASSERT(reporter, builder.vertexCount() == 1000);
+    REPORTER_ASSERT(reporter, builder.append({500, 0}, {0, 0}, SK_ColorRED) == 500);
+    REPORTER_ASSERT(reporter, builder.vertexCount() == 1000);
+}
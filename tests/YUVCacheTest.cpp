@@ -46,21 +46,29 @@ DEF_TEST(YUVPlanesCache, reporter) {
 
     const uint32_t genID = 12345678;
 
-    SkCachedData* data = SkYUVPlanesCache::FindAndRef(genID, &yuvInfo, &cache);
+    SkCachedData* data = SkYUVPlanesCache::FindAndRef(genID, &yuvInfo, nullptr, &cache);
     REPORTER_ASSERT(reporter, nullptr == data);
 
-    size_t size = 256;
+    size_t size = yuvInfo.fSizeInfo.computeTotalBytes();
     data = cache.newCachedData(size);
     memset(data->writable_data(), 0xff, size);
 
-    SkYUVPlanesCache::Add(genID, data, &yuvInfo, &cache);
-    check_data(reporter, data, 2, kInCache, kLocked);
+    SkBitmap planes[SkYUVASizeInfo::kMaxCount];
+    SkYUVPlanesCache::Add(genID, data, &yuvInfo, planes, &cache);
+    // The cache entry's plane bitmaps each hold a ref, pinning the data (and its address)
+    // while the entry lives, so plane textures keyed off the bitmaps stay valid.
+    check_data(reporter, data, 6, kInCache, kLocked);
+    for (int i = 0; i < SkYUVASizeInfo::kMaxCount; i++) {
+        REPORTER_ASSERT(reporter, planes[i].dimensions() == yuvInfo.fSizeInfo.fSizes[i]);
+        REPORTER_ASSERT(reporter, planes[i].isImmutable());
+    }
 
     data->unref();
-    check_data(reporter, data, 1, kInCache, kUnlocked);
+    check_data(reporter, data, 5, kInCache, kLocked);
 
     SkYUVPlanesCache::Info yuvInfoRead;
-    data = SkYUVPlanesCache::FindAndRef(genID, &yuvInfoRead, &cache);
+    SkBitmap planesRead[SkYUVASizeInfo::kMaxCount];
+    data = SkYUVPlanesCache::FindAndRef(genID, &yuvInfoRead, planesRead, &cache);
 
     REPORTER_ASSERT(reporter, data);
     REPORTER_ASSERT(reporter, data->size() == size);
@@ -72,9 +80,23 @@ DEF_TEST(YUVPlanesCache, reporter) {
 
     REPORTER_ASSERT(reporter, yuvInfo.fColorSpace == yuvInfoRead.fColorSpace);
 
-    check_data(reporter, data, 2, kInCache, kLocked);
+    // Lookups share the entry's pixelRefs, so generation IDs are stable across calls.
+    for (int i = 0; i < SkYUVASizeInfo::kMaxCount; i++) {
+        REPORTER_ASSERT(reporter, planesRead[i].pixelRef() == planes[i].pixelRef());
+        REPORTER_ASSERT(reporter, planesRead[i].getGenerationID() == planes[i].getGenerationID());
+    }
 
+    check_data(reporter, data, 6, kInCache, kLocked);
+
+    planes[0].reset();  // drops nothing: the cache entry still owns the underlying pixelRefs
     cache.purgeAll();
+    // Purging the entry released the cache's ref and the entry's plane bitmaps; our lookup
+    // copies still share the pixelRefs, which hold the remaining 4 data refs.
+    check_data(reporter, data, 5, kNotInCache, kLocked);
+    for (int i = 0; i < SkYUVASizeInfo::kMaxCount; i++) {
+        planesRead[i].reset();
+        planes[i].reset();
+    }
     check_data(reporter, data, 1, kNotInCache, kLocked);
     data->unref();
 }
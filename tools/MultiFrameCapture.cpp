@@ -0,0 +1,50 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tools/MultiFrameCapture.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkSerialProcs.h"
+#include "src/utils/SkMultiPictureDocument.h"
+#include "tools/SkSharingProc.h"
+
+MultiFrameCapture::MultiFrameCapture()
+        : fSerialContext(std::make_unique<SkSharingSerialContext>()) {
+    SkSerialProcs procs;
+    procs.fImageProc = SkSharingSerialContext::serializeImage;
+    procs.fImageCtx = fSerialContext.get();
+    fDocument = SkMakeMultiPictureDocument(&fBuffer, &procs);
+}
+
+MultiFrameCapture::~MultiFrameCapture() {
+    if (fDocument) {
+        fDocument->abort();
+    }
+}
+
+SkCanvas* MultiFrameCapture::beginFrame(SkScalar width, SkScalar height) {
+    SkASSERT(fDocument);
+    return fDocument->beginPage(width, height);
+}
+
+void MultiFrameCapture::endFrame() {
+    SkASSERT(fDocument);
+    fDocument->endPage();
+    fFrameCount++;
+}
+
+bool MultiFrameCapture::writeTo(SkWStream* dst) {
+    SkASSERT(fDocument);
+    fDocument->close();
+    fDocument = nullptr;
+    return fBuffer.writeToStream(dst);
+}
+
+bool MultiFrameCapture::writeToFile(const char path[]) {
+    SkFILEWStream out(path);
+    return out.isValid() && this->writeTo(&out);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef MultiFrameCapture_DEFINED
+#define MultiFrameCapture_DEFINED
+
+#include "include/core/SkDocument.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
+
+#include <memory>
+
+class SkCanvas;
+struct SkSharingSerialContext;
+
+/**
+ * Records a sequence of frames into a multi-picture document (.mskp). Images are serialized
+ * once and shared between frames, so repeated texture content (sprites, glyph atlases rendered
+ * as images, etc.) keeps its identity across the capture - replaying the file reproduces the
+ * original upload-once-draw-many resource lifetime rather than re-uploading per frame.
+ *
+ * Typical use: call beginFrame()/endFrame() around each frame's draws for as many frames as
+ * needed, then writeToFile(). The resulting file can be replayed with mskp_replay or skpbench.
+ */
+class MultiFrameCapture {
+public:
+    MultiFrameCapture();
+    ~MultiFrameCapture();
+
+    /** Begins a new frame and returns the canvas to draw it into. */
+    SkCanvas* beginFrame(SkScalar width, SkScalar height);
+
+    /** Finishes the frame begun by the matching beginFrame(). */
+    void endFrame();
+
+    int frameCount() const { return fFrameCount; }
+
+    /**
+     * Closes the capture and writes it to 'dst'. No further frames may be recorded.
+     * Returns false on I/O failure.
+     */
+    bool writeTo(SkWStream* dst);
+
+    /** As above, writing to a file at 'path'. */
+    bool writeToFile(const char path[]);
+
+private:
+    SkDynamicMemoryWStream                  fBuffer;
+    std::unique_ptr<SkSharingSerialContext> fSerialContext;
+    sk_sp<SkDocument>                       fDocument;
+    int                                     fFrameCount = 0;
+};
+
+#endif
@@ -5,6 +5,8 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkStream.h"
+#include "include/gpu/GrContext.h"
 #include "include/utils/SkBase64.h"
 #include "src/core/SkMD5.h"
 #include "src/gpu/GrPersistentCacheUtils.h"
@@ -108,4 +110,58 @@ void MemoryCache::writeShadersToDisk(const char* path, GrBackendApi api) {
     }
 }
 
+static constexpr uint32_t kCorpusMagic   = SkSetFourByteTag('s', 'k', 's', 'c');
+static constexpr uint32_t kCorpusVersion = 1;
+
+void MemoryCache::writeShaderCorpus(SkWStream* stream) const {
+    stream->write32(kCorpusMagic);
+    stream->write32(kCorpusVersion);
+    stream->write32(SkToU32(fMap.size()));
+    for (const auto& entry : fMap) {
+        stream->write32(SkToU32(entry.first.fKey->size()));
+        stream->write(entry.first.fKey->data(), entry.first.fKey->size());
+        stream->write32(SkToU32(entry.second.fData->size()));
+        stream->write(entry.second.fData->data(), entry.second.fData->size());
+    }
+}
+
+bool MemoryCache::readShaderCorpus(SkStream* stream) {
+    uint32_t magic, version, count;
+    if (!stream->readU32(&magic) || kCorpusMagic != magic ||
+        !stream->readU32(&version) || kCorpusVersion != version ||
+        !stream->readU32(&count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t keySize;
+        if (!stream->readU32(&keySize)) {
+            return false;
+        }
+        sk_sp<SkData> key = SkData::MakeUninitialized(keySize);
+        if (stream->read(key->writable_data(), keySize) != keySize) {
+            return false;
+        }
+        uint32_t dataSize;
+        if (!stream->readU32(&dataSize)) {
+            return false;
+        }
+        sk_sp<SkData> data = SkData::MakeUninitialized(dataSize);
+        if (stream->read(data->writable_data(), dataSize) != dataSize) {
+            return false;
+        }
+        fMap[Key(*key)] = Value(*data);
+    }
+    return true;
+}
+
+int MemoryCache::precompileShaders(GrContext* context) const {
+    int compiled = 0;
+    for (const auto& entry : fMap) {
+        if (context->precompileShader(*entry.first.fKey, *entry.second.fData)) {
+            ++compiled;
+        }
+    }
+    return compiled;
+}
+
 }  // namespace sk_gpu_test
@@ -14,6 +14,10 @@
 
 #include <unordered_map>
 
+class GrContext;
+class SkStream;
+class SkWStream;
+
 namespace sk_gpu_test {
 
 /**
@@ -43,6 +47,23 @@ public:
 
     void writeShadersToDisk(const char* path, GrBackendApi backend);
 
+    /**
+     * Writes the cache's contents to a stream as a corpus that readShaderCorpus can reload,
+     * possibly in another process. Together with GrContext::precompileShader this lets the
+     * shaders captured in one session be compiled before the first frame of a later one.
+     */
+    void writeShaderCorpus(SkWStream*) const;
+
+    /** Merges a corpus written by writeShaderCorpus into this cache. Returns false if the stream
+        does not hold a valid corpus. */
+    bool readShaderCorpus(SkStream*);
+
+    /**
+     * Feeds every entry to GrContext::precompileShader and returns the number that compiled.
+     * Compilation happens on the backend API, so this must be called on the context's thread.
+     */
+    int precompileShaders(GrContext*) const;
+
     template <typename Fn>
     void foreach(Fn&& fn) {
         for (auto it = fMap.begin(); it != fMap.end(); ++it) {
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkDeferredDisplayListRecorder.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceCharacterization.h"
+#include "include/core/SkTime.h"
+#include "include/gpu/GrDirectContext.h"
+#include "src/utils/SkJSONWriter.h"
+#include "src/utils/SkMultiPictureDocument.h"
+#include "tools/SkSharingProc.h"
+#include "tools/Stats.h"
+#include "tools/flags/CommandLineFlags.h"
+#include "tools/gpu/GrContextFactory.h"
+
+#include <algorithm>
+#include <vector>
+
+static DEFINE_string2(src, s, "", ".mskp file to replay (e.g. written by MultiFrameCapture)");
+static DEFINE_int(loops, 16, "times to replay the whole frame sequence");
+static DEFINE_bool(ddl, true, "record each frame into a deferred display list before drawing");
+static DEFINE_bool(cpu, false, "replay on a raster surface instead of the GPU (implies --noddl)");
+static DEFINE_string2(output, o, "", "path for JSON results (stdout if empty)");
+static DEFINE_bool(pretty, true, "human-readable JSON");
+
+// Replays a multi-frame capture and reports wall time per frame index across loops, so
+// regressions in a particular frame of a workload (e.g. the one that first uses a large
+// image) stand out instead of being averaged away. In --ddl mode each frame is recorded
+// into a deferred display list against the destination surface's characterization before
+// being drawn, matching how DDL-based clients submit work.
+
+static void exitf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    exit(1);
+}
+
+static std::vector<SkDocumentPage> read_frames(const char* path) {
+    std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(path);
+    if (!stream) {
+        exitf("Couldn't open %s.\n", path);
+    }
+
+    // Frames captured with a sharing image proc reference each unique image once; replaying
+    // with the matching deserial proc restores that sharing, and plain captures still decode.
+    auto deserialContext = std::make_unique<SkSharingDeserialContext>();
+    SkDeserialProcs procs;
+    procs.fImageProc = SkSharingDeserialContext::deserializeImage;
+    procs.fImageCtx = deserialContext.get();
+
+    int pageCount = SkMultiPictureDocumentReadPageCount(stream.get());
+    if (pageCount <= 0) {
+        exitf("Couldn't parse %s as an .mskp.\n", path);
+    }
+    std::vector<SkDocumentPage> frames(pageCount);
+    if (!SkMultiPictureDocumentRead(stream.get(), frames.data(), pageCount, &procs)) {
+        exitf("Couldn't read all %d frames from %s.\n", pageCount, path);
+    }
+    return frames;
+}
+
+static void write_stats(SkJSONWriter* w, const SkTArray<double>& samplesMs) {
+    Stats stats(samplesMs, /*want_plot=*/false);
+    w->appendDouble("meanMs", stats.mean);
+    w->appendDouble("medianMs", stats.median);
+    w->appendDouble("minMs", stats.min);
+    w->appendDouble("maxMs", stats.max);
+    w->appendDouble("stddevMs", sqrt(stats.var));
+}
+
+int main(int argc, char** argv) {
+    CommandLineFlags::SetUsage("Replays a multi-frame .mskp capture with per-frame statistics.");
+    CommandLineFlags::Parse(argc, argv);
+
+    if (FLAGS_src.isEmpty()) {
+        exitf("Nothing to replay; pass an .mskp file with --src.\n");
+    }
+    const int loops = std::max(1, FLAGS_loops);
+    const bool useDdl = FLAGS_ddl && !FLAGS_cpu;
+
+    std::vector<SkDocumentPage> frames = read_frames(FLAGS_src[0]);
+    const int frameCount = (int)frames.size();
+
+    int width = 1, height = 1;
+    for (const SkDocumentPage& frame : frames) {
+        width  = std::max(width,  SkScalarCeilToInt(frame.fSize.width()));
+        height = std::max(height, SkScalarCeilToInt(frame.fSize.height()));
+    }
+    SkImageInfo info = SkImageInfo::MakeN32Premul(width, height);
+
+    sk_gpu_test::GrContextFactory factory;
+    GrDirectContext* context = nullptr;
+    sk_sp<SkSurface> surface;
+    if (FLAGS_cpu) {
+        surface = SkSurface::MakeRaster(info);
+    } else {
+        context = factory.getContextInfo(sk_gpu_test::GrContextFactory::kGL_ContextType)
+                          .directContext();
+        if (!context) {
+            exitf("Couldn't create a GPU context; rerun with --cpu to replay in software.\n");
+        }
+        surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    }
+    if (!surface) {
+        exitf("Couldn't create a %dx%d surface.\n", width, height);
+    }
+
+    SkSurfaceCharacterization characterization;
+    if (useDdl && !surface->characterize(&characterization)) {
+        exitf("Surface can't be characterized; rerun with --noddl.\n");
+    }
+
+    SkTArray<SkTArray<double>> perFrameMs(frameCount);
+    perFrameMs.push_back_n(frameCount);
+    SkTArray<double> perLoopMs;
+
+    for (int loop = -1; loop < loops; loop++) {
+        double loopStart = SkTime::GetMSecs();
+        for (int f = 0; f < frameCount; f++) {
+            double frameStart = SkTime::GetMSecs();
+            if (useDdl) {
+                SkDeferredDisplayListRecorder recorder(characterization);
+                recorder.getCanvas()->drawPicture(frames[f].fPicture);
+                surface->draw(recorder.detach());
+            } else {
+                surface->getCanvas()->drawPicture(frames[f].fPicture);
+            }
+            if (context) {
+                surface->flush();
+                context->submit(/*syncCpu=*/true);
+            }
+            if (loop >= 0) {
+                perFrameMs[f].push_back(SkTime::GetMSecs() - frameStart);
+            }
+        }
+        if (loop >= 0) {
+            perLoopMs.push_back(SkTime::GetMSecs() - loopStart);
+        }
+        // loop == -1 is an untimed warmup: image decodes, shader compiles, cache fills.
+    }
+
+    SkDynamicMemoryWStream buffer;
+    SkJSONWriter writer(&buffer, FLAGS_pretty ? SkJSONWriter::Mode::kPretty
+                                              : SkJSONWriter::Mode::kFast);
+    writer.beginObject();
+    writer.appendString("file", FLAGS_src[0]);
+    writer.appendS32("frameCount", frameCount);
+    writer.appendS32("loops", loops);
+    writer.appendBool("ddl", useDdl);
+    writer.appendBool("cpu", FLAGS_cpu);
+
+    writer.beginArray("frames");
+    for (int f = 0; f < frameCount; f++) {
+        writer.beginObject();
+        writer.appendS32("frame", f);
+        write_stats(&writer, perFrameMs[f]);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.beginObject("sequence");
+    write_stats(&writer, perLoopMs);
+    writer.endObject();
+
+    writer.endObject();
+    writer.flush();
+
+    sk_sp<SkData> json = buffer.detachAsData();
+    if (!FLAGS_output.isEmpty()) {
+        SkFILEWStream out(FLAGS_output[0]);
+        if (!out.isValid() || !out.write(json->data(), json->size())) {
+            exitf("Couldn't write %s.\n", FLAGS_output[0]);
+        }
+    } else {
+        fwrite(json->data(), 1, json->size(), stdout);
+        fputc('\n', stdout);
+    }
+    return 0;
+}
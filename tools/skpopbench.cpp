@@ -0,0 +1,211 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTime.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecorder.h"
+#include "src/utils/SkJSONWriter.h"
+#include "tools/flags/CommandLineFlags.h"
+
+#include <algorithm>
+
+static DEFINE_string2(skps, s, "", ".skp files to replay");
+static DEFINE_int(loops, 16, "times to replay each picture; op times are averaged over loops");
+static DEFINE_string2(output, o, "", "path for JSON results (stdout if empty)");
+static DEFINE_bool(pretty, true, "human-readable JSON");
+
+// Replays each .skp through SkRecords::Draw with a timestamp around every op
+// visit, and reports time per op type per picture as JSON.  Unlike whole-frame
+// timing this attributes cost to individual record types, so two Skia
+// revisions can be diffed against a captured workload without frame noise.
+
+namespace {
+
+#define COUNT(T) +1
+static const int kRecordTypeCount = 0 SK_RECORD_TYPES(COUNT);
+#undef COUNT
+
+static const char* name_of(int type) {
+#define CASE(T) case SkRecords::T##_Type: return #T;
+    switch (type) { SK_RECORD_TYPES(CASE) }
+#undef CASE
+    return "Unknown";
+}
+
+struct OpTally {
+    double fNs[kRecordTypeCount]    = {0};
+    int    fCounts[kRecordTypeCount] = {0};
+
+    void add(const OpTally& that) {
+        for (int i = 0; i < kRecordTypeCount; i++) {
+            fNs[i]     += that.fNs[i];
+            fCounts[i] += that.fCounts[i];
+        }
+    }
+    double totalNs() const {
+        double total = 0;
+        for (double ns : fNs) { total += ns; }
+        return total;
+    }
+};
+
+// Draws each op through the common Draw visitor, charging the elapsed time to
+// the op's record type.
+class TimedDraw {
+public:
+    TimedDraw(SkCanvas* canvas, OpTally* tally)
+        : fDraw(canvas, nullptr, nullptr, 0, nullptr)
+        , fTally(tally) {}
+
+    template <typename T>
+    void operator()(const T& op) {
+        double start = SkTime::GetNSecs();
+        fDraw(op);
+        fTally->fNs[T::kType] += SkTime::GetNSecs() - start;
+        fTally->fCounts[T::kType] += 1;
+    }
+
+private:
+    SkRecords::Draw fDraw;
+    OpTally*        fTally;
+};
+
+}  // namespace
+
+// Deserialized .skps are normally SkBigPictures whose SkRecord we can replay
+// directly; anything else (e.g. a single-op mini picture) is re-recorded.
+static sk_sp<const SkRecord> record_of(sk_sp<const SkPicture> pic) {
+    if (const SkBigPicture* bp = SkPicturePriv::AsSkBigPicture(pic)) {
+        return sk_ref_sp(bp->record());
+    }
+    sk_sp<SkRecord> record = sk_make_sp<SkRecord>();
+    SkRecorder canvas(record.get(), pic->cullRect());
+    pic->playback(&canvas);
+    return record;
+}
+
+static void write_tally(SkJSONWriter* w, const OpTally& tally, int loops) {
+    // Most expensive op types first, flame style.
+    int order[kRecordTypeCount];
+    for (int i = 0; i < kRecordTypeCount; i++) { order[i] = i; }
+    std::sort(order, order + kRecordTypeCount, [&](int a, int b) {
+        return tally.fNs[a] > tally.fNs[b];
+    });
+
+    w->beginArray("ops");
+    for (int i = 0; i < kRecordTypeCount; i++) {
+        int type = order[i];
+        if (0 == tally.fCounts[type]) {
+            continue;
+        }
+        w->beginObject();
+        w->appendString("op", name_of(type));
+        w->appendS32("count", tally.fCounts[type] / loops);
+        w->appendDouble("ns", tally.fNs[type] / loops);
+        w->appendDouble("ns_per_op", tally.fNs[type] / tally.fCounts[type]);
+        w->endObject();
+    }
+    w->endArray();
+}
+
+int main(int argc, char** argv) {
+    CommandLineFlags::SetUsage(
+            "Replays .skp files, attributing replay time to each record op type.");
+    CommandLineFlags::Parse(argc, argv);
+
+    if (FLAGS_skps.isEmpty()) {
+        SkDebugf("Nothing to time; pass .skp files with --skps.\n");
+        return 1;
+    }
+    const int loops = std::max(1, FLAGS_loops);
+
+    SkDynamicMemoryWStream buffer;
+    SkJSONWriter writer(&buffer, FLAGS_pretty ? SkJSONWriter::Mode::kPretty
+                                              : SkJSONWriter::Mode::kFast);
+    writer.beginObject();
+    writer.appendS32("loops", loops);
+    writer.beginArray("pictures");
+
+    OpTally summary;
+    for (int i = 0; i < FLAGS_skps.count(); i++) {
+        SkFILEStream stream(FLAGS_skps[i]);
+        if (!stream.isValid()) {
+            SkDebugf("Couldn't open %s.\n", FLAGS_skps[i]);
+            return 1;
+        }
+        sk_sp<SkPicture> pic = SkPicture::MakeFromStream(&stream);
+        if (!pic) {
+            SkDebugf("Couldn't parse %s as an .skp.\n", FLAGS_skps[i]);
+            return 1;
+        }
+        sk_sp<const SkRecord> record = record_of(pic);
+
+        SkRect cull = pic->cullRect();
+        SkIRect bounds = cull.roundOut();
+        sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(
+                std::max(bounds.width(), 1), std::max(bounds.height(), 1));
+        SkCanvas* canvas = surface->getCanvas();
+
+        OpTally tally;
+        for (int loop = -1; loop < loops; loop++) {
+            canvas->save();
+            canvas->translate(-cull.left(), -cull.top());
+            if (loop < 0) {
+                // One untimed warmup to decode lazy images and fill caches.
+                OpTally scratch;
+                TimedDraw draw(canvas, &scratch);
+                for (int op = 0; op < record->count(); op++) {
+                    record->visit(op, draw);
+                }
+            } else {
+                TimedDraw draw(canvas, &tally);
+                for (int op = 0; op < record->count(); op++) {
+                    record->visit(op, draw);
+                }
+            }
+            canvas->restore();
+        }
+
+        writer.beginObject();
+        writer.appendString("file", FLAGS_skps[i]);
+        writer.appendS32("opCount", record->count());
+        writer.appendDouble("totalNs", tally.totalNs() / loops);
+        write_tally(&writer, tally, loops);
+        writer.endObject();
+
+        summary.add(tally);
+    }
+    writer.endArray();  // pictures
+
+    writer.beginObject("summary");
+    writer.appendDouble("totalNs", summary.totalNs() / loops);
+    write_tally(&writer, summary, loops);
+    writer.endObject();
+
+    writer.endObject();
+    writer.flush();
+
+    sk_sp<SkData> json = buffer.detachAsData();
+    if (!FLAGS_output.isEmpty()) {
+        SkFILEWStream out(FLAGS_output[0]);
+        if (!out.isValid() || !out.write(json->data(), json->size())) {
+            SkDebugf("Couldn't write %s.\n", FLAGS_output[0]);
+            return 1;
+        }
+    } else {
+        fwrite(json->data(), 1, json->size(), stdout);
+        fputc('\n', stdout);
+    }
+    return 0;
+}